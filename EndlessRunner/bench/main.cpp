@@ -0,0 +1,13 @@
+﻿/**
+ * @file main.cpp
+ * @brief Punkt wejścia programu dino_bench - zestawu testów wydajności bez okna.
+ *
+ * Przyjmuje te same polecenia co gra (--bench, --bench-compare), ale nie potrzebuje ekranu ani GPU,
+ * więc można go zbudować i uruchomić na serwerze CI z Linuksem.
+ */
+
+import BenchmarkModule;
+
+int main(int argc, char* argv[]) {
+    return runBenchmarkCommand(argc, argv);
+}
@@ -0,0 +1,352 @@
+﻿/**
+ * @file Analytics.cpp
+ * @brief Implementacja dziennika zdarzeń rozgrywki i narzędzia do jego analizy.
+ */
+
+module;
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+module AnalyticsModule;
+
+import MappedFileModule;
+
+namespace {
+	/** @brief Sygnatura bloku dziennika. */
+	constexpr char ANALYTICS_MAGIC[4] = { 'D', 'R', 'A', 'B' };
+
+	/** @brief Zwraca nazwę rodzaju przeszkody. */
+	const char* kindName(std::size_t kind) {
+		switch (static_cast<ObstacleKind>(kind)) {
+		case ObstacleKind::BAT: return "bat";
+		case ObstacleKind::PTERODACTYL: return "pterodactyl";
+		case ObstacleKind::STATIC: return "static";
+		}
+		return "unknown";
+	}
+
+	/** @brief Zwraca nazwę tła. */
+	const char* biomeName(std::size_t biome) {
+		switch (static_cast<BackgroundType>(biome)) {
+		case BackgroundType::DESERT_DAY: return "desert_day";
+		case BackgroundType::DESERT_NIGHT: return "desert_night";
+		case BackgroundType::FOREST_DAY: return "forest_day";
+		case BackgroundType::FOREST_NIGHT: return "forest_night";
+		}
+		return "unknown";
+	}
+
+	/** @brief Zwraca przedział histogramu dla chwili od początku rozgrywki (ostatni zbiera dłuższe czasy). */
+	std::size_t bucketOf(float seconds) {
+		if (!(seconds > 0.f)) {
+			return 0;
+		}
+		const float bucket = seconds / Config::ANALYTICS_BUCKET_SECONDS;
+		return bucket >= Config::ANALYTICS_BUCKETS - 1 ? Config::ANALYTICS_BUCKETS - 1 : static_cast<std::size_t>(bucket);
+	}
+
+	/** @brief Czyta element kolumny float (kolumny są wyrównane, memcpy nie narusza reguł aliasowania). */
+	float loadFloat(const std::uint8_t* column, std::size_t index) {
+		float value;
+		std::memcpy(&value, column + index * sizeof(float), sizeof(float));
+		return value;
+	}
+
+	/**
+	 * @brief Dopisuje do statystyk zdarzenia jednego bloku.
+	 * @param columns Początek kolumn (za nagłówkiem bloku).
+	 * @param count Liczba zdarzeń.
+	 * @param out Statystyki.
+	 */
+	void scanBlock(const std::uint8_t* columns, std::size_t count, AnalyticsSummary& out) {
+		const std::uint8_t* timeColumn = columns;
+		const std::uint8_t* valueColumn = timeColumn + count * sizeof(float);
+		const std::uint8_t* types = valueColumn + count * sizeof(float);
+		const std::uint8_t* kinds = types + count;
+		const std::uint8_t* biomes = kinds + 2 * count;
+
+		constexpr std::uint8_t SPAWN = static_cast<std::uint8_t>(AnalyticsEvent::SPAWN);
+		constexpr std::uint8_t JUMP = static_cast<std::uint8_t>(AnalyticsEvent::JUMP);
+		constexpr std::uint8_t DEATH = static_cast<std::uint8_t>(AnalyticsEvent::DEATH);
+		constexpr std::uint8_t SPIKE = static_cast<std::uint8_t>(AnalyticsEvent::FRAME_SPIKE);
+		constexpr std::uint8_t RUN_END = static_cast<std::uint8_t>(AnalyticsEvent::RUN_END);
+
+		// Liczniki po kolumnach bajtów: porównania bez skoków, które kompilator zamienia na instrukcje wektorowe.
+		for (std::size_t kind = 0; kind < ANALYTICS_KINDS; ++kind) {
+			const std::uint8_t code = static_cast<std::uint8_t>(kind);
+			std::uint32_t spawned = 0;
+			std::uint32_t killed = 0;
+			for (std::size_t i = 0; i < count; ++i) {
+				spawned += (types[i] == SPAWN) & (kinds[i] == code);
+				killed += (types[i] == DEATH) & (kinds[i] == code);
+			}
+			out.spawnsByKind[kind] += spawned;
+			out.deathsByKind[kind] += killed;
+		}
+		std::uint32_t jumps = 0;
+		std::uint32_t sparse = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			jumps += types[i] == JUMP;
+			sparse += (types[i] == DEATH) | (types[i] == SPIKE) | (types[i] == RUN_END);
+		}
+		out.jumps += jumps;
+
+		// Zgony, końce rozgrywek i skoki czasu klatki są rzadkie - histogramy liczymy tylko w blokach, które je mają.
+		if (sparse == 0) {
+			return;
+		}
+		for (std::size_t i = 0; i < count; ++i) {
+			const std::uint8_t type = types[i];
+			const std::size_t biome = biomes[i];
+			if ((type != DEATH && type != SPIKE && type != RUN_END) || biome >= ANALYTICS_BIOMES) {
+				continue;
+			}
+			const float time = loadFloat(timeColumn, i);
+			if (type == DEATH) {
+				out.survival[biome][bucketOf(time)]++;
+			}
+			else if (type == RUN_END) {
+				out.runsByBiome[biome]++;
+				out.runSecondsByBiome[biome] += time;
+			}
+			else {
+				out.spikes++;
+				out.worstSpikeMs = std::max(out.worstSpikeMs, loadFloat(valueColumn, i));
+				out.spikesByBiome[biome]++;
+				out.spikesByTime[bucketOf(time)]++;
+			}
+		}
+	}
+}
+
+void AnalyticsColumns::reserve(std::size_t capacity) {
+	times.reserve(capacity);
+	values.reserve(capacity);
+	types.reserve(capacity);
+	kinds.reserve(capacity);
+	players.reserve(capacity);
+	biomes.reserve(capacity);
+}
+
+void AnalyticsColumns::clear() {
+	times.clear();
+	values.clear();
+	types.clear();
+	kinds.clear();
+	players.clear();
+	biomes.clear();
+}
+
+AnalyticsLog::AnalyticsLog(std::string path) : file(std::move(path)) {
+	const std::size_t capacity = static_cast<std::size_t>(Config::ANALYTICS_BLOCK_EVENTS);
+	columns.reserve(capacity);
+	sealed.reserve(capacity);
+	staging.reserve(sizeof(AnalyticsBlockHeader) + capacity * ANALYTICS_RECORD_BYTES);
+}
+
+void AnalyticsLog::setEnabled(bool on) {
+	if (!on) {
+		flush();
+		inRun = false;
+	}
+	enabled = on;
+}
+
+void AnalyticsLog::beginRun(BackgroundType background, std::size_t humanPlayers) {
+	if (!enabled) return;
+	runTime = 0.f;
+	biome = static_cast<std::uint8_t>(background);
+	inRun = true;
+	push(AnalyticsEvent::RUN_START, ANALYTICS_NONE, ANALYTICS_NONE, static_cast<float>(humanPlayers));
+}
+
+void AnalyticsLog::endRun(float score) {
+	if (!inRun) return;
+	push(AnalyticsEvent::RUN_END, ANALYTICS_NONE, ANALYTICS_NONE, score);
+	inRun = false;
+	seal();
+}
+
+void AnalyticsLog::seal() {
+	if (columns.size() == 0) {
+		return;
+	}
+	// Poprzedni blok czeka tylko wtedy, gdy w jednej klatce uzbierał się kolejny pełny blok - zapisujemy go od razu.
+	if (sealed.size() > 0) {
+		writeBlock(sealed);
+	}
+	std::swap(columns, sealed);
+}
+
+bool AnalyticsLog::flushPending() {
+	return writeBlock(sealed);
+}
+
+bool AnalyticsLog::flush() {
+	const bool pendingWritten = flushPending();
+	seal();
+	return flushPending() && pendingWritten;
+}
+
+bool AnalyticsLog::writeBlock(AnalyticsColumns& block) {
+	const std::size_t count = block.size();
+	if (count == 0) {
+		return true;
+	}
+	auto start = std::chrono::steady_clock::now();
+
+	AnalyticsBlockHeader header{};
+	std::memcpy(header.magic, ANALYTICS_MAGIC, sizeof(header.magic));
+	header.version = ANALYTICS_VERSION;
+	header.count = static_cast<std::uint32_t>(count);
+
+	// Kolumny leżą w bloku jedna za drugą, w tej samej postaci co w pamięci - składanie bloku to kilka memcpy.
+	staging.resize(sizeof(header) + count * ANALYTICS_RECORD_BYTES);
+	std::uint8_t* cursor = staging.data();
+	std::memcpy(cursor, &header, sizeof(header));
+	cursor += sizeof(header);
+	auto column = [&cursor](const auto& source) {
+		const std::size_t bytes = source.size() * sizeof(source[0]);
+		std::memcpy(cursor, source.data(), bytes);
+		cursor += bytes;
+	};
+	column(block.times);
+	column(block.values);
+	column(block.types);
+	column(block.kinds);
+	column(block.players);
+	column(block.biomes);
+
+	const bool written = file.appendBytes(std::string_view(reinterpret_cast<const char*>(staging.data()), staging.size())) == AppendResult::WRITTEN;
+	block.clear();
+
+	stats.flushMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (!written) {
+		// Jeden komunikat wystarczy - kolejne nieudane bloki są tylko liczone.
+		if (stats.failed++ == 0) {
+			std::cout << "Failed to append to " << file.getPath() << "\n";
+		}
+		return false;
+	}
+	stats.events += count;
+	stats.blocks++;
+	stats.bytes += staging.size();
+	return true;
+}
+
+void AnalyticsLog::printReport() const {
+	if (stats.blocks == 0 && stats.failed == 0) {
+		return;
+	}
+	std::cout << "Analytics: " << stats.events << " events in " << stats.blocks << " blocks ("
+		<< stats.bytes / 1024.0 << " KiB) appended to " << file.getPath() << ", flush avg "
+		<< (stats.blocks > 0 ? stats.flushMs / stats.blocks : 0.0) << " ms, failed blocks " << stats.failed << "\n";
+}
+
+AnalyticsLog& analytics() {
+	static AnalyticsLog instance(Config::ANALYTICS_FILE);
+	return instance;
+}
+
+bool scanAnalytics(const std::uint8_t* data, std::size_t size, AnalyticsSummary& out) {
+	std::size_t offset = 0;
+	while (offset < size) {
+		AnalyticsBlockHeader header{};
+		const std::size_t left = size - offset;
+		if (left < sizeof(header)) {
+			out.truncated = true;
+			break;
+		}
+		std::memcpy(&header, data + offset, sizeof(header));
+		if (std::memcmp(header.magic, ANALYTICS_MAGIC, sizeof(header.magic)) != 0 || header.version != ANALYTICS_VERSION) {
+			if (offset == 0) {
+				return false;
+			}
+			out.truncated = true;
+			break;
+		}
+		// Przerwany zapis zostawia na końcu niepełny blok - pomijamy go zamiast czytać poza plikiem.
+		if (header.count > (left - sizeof(header)) / ANALYTICS_RECORD_BYTES) {
+			out.truncated = true;
+			break;
+		}
+		scanBlock(data + offset + sizeof(header), header.count, out);
+		out.blocks++;
+		out.events += header.count;
+		offset += sizeof(header) + header.count * ANALYTICS_RECORD_BYTES;
+	}
+	return true;
+}
+
+int runAnalyticsReport(const std::string& path) {
+	MappedFile mapped;
+	if (!mapped.open(path)) {
+		std::cout << "Cannot open analytics log " << path << "\n";
+		return 1;
+	}
+	AnalyticsSummary summary;
+	auto start = std::chrono::steady_clock::now();
+	if (!scanAnalytics(mapped.get(), mapped.getSize(), summary)) {
+		std::cout << path << " is not an analytics log\n";
+		return 1;
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << path << ": " << summary.blocks << " blocks, " << summary.events << " events"
+		<< (summary.truncated ? " (damaged tail skipped)" : "") << ", scanned in " << seconds * 1000.0 << " ms ("
+		<< (seconds > 0.0 ? mapped.getSize() / seconds / 1e6 : 0.0) << " MB/s)\n";
+
+	std::cout << "\nDeaths by obstacle kind\n";
+	std::cout << std::left << std::setw(14) << "kind" << std::right << std::setw(10) << "spawned" << std::setw(10) << "deaths"
+		<< std::setw(12) << "per 100" << "\n";
+	for (std::size_t kind = 0; kind < ANALYTICS_KINDS; ++kind) {
+		const std::uint64_t spawned = summary.spawnsByKind[kind];
+		const std::uint64_t deaths = summary.deathsByKind[kind];
+		std::cout << std::left << std::setw(14) << kindName(kind) << std::right << std::setw(10) << spawned << std::setw(10) << deaths
+			<< std::setw(12) << (spawned > 0 ? 100.0 * deaths / spawned : 0.0) << "\n";
+	}
+
+	std::cout << "\nSurvival by biome (player deaths per " << Config::ANALYTICS_BUCKET_SECONDS << " s of run time)\n";
+	std::cout << std::left << std::setw(14) << "biome" << std::right << std::setw(6) << "runs" << std::setw(10) << "avg (s)";
+	for (int bucket = 0; bucket < Config::ANALYTICS_BUCKETS; ++bucket) {
+		const int from = static_cast<int>(bucket * Config::ANALYTICS_BUCKET_SECONDS);
+		std::cout << std::setw(7) << (std::to_string(from) + (bucket == Config::ANALYTICS_BUCKETS - 1 ? "+" : ""));
+	}
+	std::cout << "\n";
+	for (std::size_t biome = 0; biome < ANALYTICS_BIOMES; ++biome) {
+		const std::uint64_t runs = summary.runsByBiome[biome];
+		std::cout << std::left << std::setw(14) << biomeName(biome) << std::right << std::setw(6) << runs
+			<< std::setw(10) << (runs > 0 ? summary.runSecondsByBiome[biome] / runs : 0.0);
+		for (std::uint64_t deaths : summary.survival[biome]) {
+			std::cout << std::setw(7) << deaths;
+		}
+		std::cout << "\n";
+	}
+
+	std::cout << "\nFrame spikes over " << Config::ANALYTICS_SPIKE_MS << " ms: " << summary.spikes << ", worst "
+		<< summary.worstSpikeMs << " ms, player jumps: " << summary.jumps << "\n";
+	if (summary.spikes > 0) {
+		std::cout << "by biome:";
+		for (std::size_t biome = 0; biome < ANALYTICS_BIOMES; ++biome) {
+			std::cout << " " << biomeName(biome) << " " << summary.spikesByBiome[biome];
+		}
+		std::cout << "\nby run time:";
+		for (int bucket = 0; bucket < Config::ANALYTICS_BUCKETS; ++bucket) {
+			std::cout << " " << static_cast<int>(bucket * Config::ANALYTICS_BUCKET_SECONDS) << "s " << summary.spikesByTime[bucket];
+		}
+		std::cout << "\n";
+	}
+	std::cout.unsetf(std::ios::fixed);
+	return 0;
+}
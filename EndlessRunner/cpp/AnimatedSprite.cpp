@@ -8,6 +8,9 @@ module;
 
 module AnimatedSpriteModule;
 
+import AnimationSystemModule;
+import DrawListModule;
+
 void AnimatedSprite::init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
 	texture = tex;
 	maxFrames = static_cast<float>(frameCount);
@@ -15,23 +18,15 @@ void AnimatedSprite::init(const Texture2D& tex, float startX, float startY, floa
 	height = static_cast<float>(tex.height);
 	screenPos = { startX, startY };
 	scale = scaleFactor;
-	frame = 0;
-	runningTime = 0.f;
 	isActive = true;
-	updateTime = animUpdateTime;
+	clip = makeClip(tex, frameCount, animUpdateTime);
 }
 
-void AnimatedSprite::update(float deltaTime) {
+void AnimatedSprite::draw(DrawList& list) const {
 	if (!isActive) return;
-	updateAnimation(deltaTime);
-}
-
-void AnimatedSprite::draw() const {
-	if (!isActive) return;
-	Rectangle source{ frame * width, 0.f, width, height };
+	Rectangle source{ clip.getFrame() * width, 0.f, width, height };
 	Rectangle dest{ screenPos.x, screenPos.y, width * scale, height * scale };
-	DrawTexturePro(texture, source, dest, { 0.f, 0.f }, 0.f, WHITE);
-
+	list.sprite(texture, source, dest);
 }
 
 Rectangle AnimatedSprite::getCollisionRec() const {
@@ -56,16 +51,11 @@ const Texture2D& AnimatedSprite::getTexture() const {
 }
 
 int AnimatedSprite::getFrame() const { 
-	return frame; 
+	return clip.getFrame(); 
 }
 
-void AnimatedSprite::updateAnimation(float deltaTime) {
-	runningTime += deltaTime;
-	if (runningTime >= updateTime) {
-		runningTime = 0.f;
-		frame++;
-		if (frame >= maxFrames) frame = 0;
-	}
+AnimationClip AnimatedSprite::makeClip(const Texture2D& tex, int frameCount, float animUpdateTime) {
+	return animations().create(frameCount, animUpdateTime);
 }
 
 void AnimatedSprite::setActive(bool active) { 
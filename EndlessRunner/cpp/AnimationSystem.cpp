@@ -0,0 +1,205 @@
+﻿/**
+ * @file AnimationSystem.cpp
+ * @brief Implementacja klas AnimationClip i AnimationSystem.
+ */
+
+module;
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+module AnimationSystemModule;
+
+AnimationClip::AnimationClip(AnimationSystem* owner, std::uint32_t clipId) : system(owner), id(clipId) {
+	if (system != nullptr) {
+		system->addRef(id);
+	}
+}
+
+AnimationClip::AnimationClip(const AnimationClip& other) : AnimationClip(other.system, other.id) {}
+
+AnimationClip::AnimationClip(AnimationClip&& other) noexcept : system(other.system), id(other.id) {
+	other.system = nullptr;
+}
+
+AnimationClip& AnimationClip::operator=(const AnimationClip& other) {
+	if (system != other.system || id != other.id) {
+		AnimationClip copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+AnimationClip& AnimationClip::operator=(AnimationClip&& other) noexcept {
+	if (this != &other) {
+		reset();
+		system = other.system;
+		id = other.id;
+		other.system = nullptr;
+	}
+	return *this;
+}
+
+AnimationClip::~AnimationClip() {
+	reset();
+}
+
+int AnimationClip::getFrame() const {
+	return system != nullptr ? system->getFrame(id) : 0;
+}
+
+float AnimationClip::getFraction() const {
+	return system != nullptr ? system->getFraction(id) : 0.f;
+}
+
+bool AnimationClip::isFinished() const {
+	return system != nullptr && system->isFinished(id);
+}
+
+float AnimationClip::getPhase() const {
+	return system != nullptr ? system->getPhase(id) : 0.f;
+}
+
+void AnimationClip::setPhase(float value) {
+	if (system != nullptr) {
+		system->setPhase(id, value);
+	}
+}
+
+void AnimationClip::restart() {
+	if (system != nullptr) {
+		system->restart(id);
+	}
+}
+
+void AnimationClip::setPlaying(bool playing) {
+	if (system != nullptr) {
+		system->setPlaying(id, playing);
+	}
+}
+
+void AnimationClip::reset() {
+	if (system != nullptr) {
+		system->release(id);
+		system = nullptr;
+	}
+}
+
+AnimationClip AnimationSystem::create(int frames, float secondsPerFrame, bool loop) {
+	return AnimationClip(this, allocate(frames, secondsPerFrame, loop, 0));
+}
+
+AnimationClip AnimationSystem::share(std::uint32_t textureId, int frames, float secondsPerFrame) {
+	if (textureId == 0) {
+		return create(frames, secondsPerFrame);
+	}
+	// Klucz musi odpowiadać wartościom zapisanym przez allocate(), aby release() mógł go odtworzyć.
+	frames = std::max(frames, 1);
+	secondsPerFrame = std::max(secondsPerFrame, 1e-4f);
+	const auto key = std::make_tuple(textureId, frames, secondsPerFrame);
+	auto it = shared.find(key);
+	if (it == shared.end()) {
+		it = shared.emplace(key, allocate(frames, secondsPerFrame, true, textureId)).first;
+	}
+	return AnimationClip(this, it->second);
+}
+
+std::uint32_t AnimationSystem::allocate(int frames, float secondsPerFrame, bool loop, std::uint32_t textureId) {
+	std::uint32_t id;
+	if (!freeSlots.empty()) {
+		id = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		id = static_cast<std::uint32_t>(refs.size());
+		phase.push_back(0.f);
+		speed.push_back(0.f);
+		frameTime.push_back(0.f);
+		frameCount.push_back(0.f);
+		wrapCount.push_back(0.f);
+		inverseWrapCount.push_back(0.f);
+		limit.push_back(0.f);
+		refs.push_back(0);
+		sharedTexture.push_back(0);
+	}
+
+	phase[id] = 0.f;
+	frameTime[id] = std::max(secondsPerFrame, 1e-4f);
+	speed[id] = 1.f / frameTime[id];
+	frameCount[id] = static_cast<float>(std::max(frames, 1));
+	wrapCount[id] = loop ? frameCount[id] : 0.f;
+	inverseWrapCount[id] = loop ? 1.f / frameCount[id] : 0.f;
+	limit[id] = loop ? std::numeric_limits<float>::max() : frameCount[id];
+	refs[id] = 0;
+	sharedTexture[id] = textureId;
+	return id;
+}
+
+void AnimationSystem::release(std::uint32_t id) {
+	if (--refs[id] > 0) {
+		return;
+	}
+	if (sharedTexture[id] != 0) {
+		shared.erase(std::make_tuple(sharedTexture[id], static_cast<int>(frameCount[id]), frameTime[id]));
+	}
+	// Wolne miejsce nadal jest przesuwane przez advance(); zerowa prędkość sprawia, że faza stoi.
+	speed[id] = 0.f;
+	phase[id] = 0.f;
+	freeSlots.push_back(id);
+}
+
+void AnimationSystem::advance(float deltaTime) {
+	const std::size_t count = phase.size();
+	float* const phases = phase.data();
+	const float* const speeds = speed.data();
+	const float* const wraps = wrapCount.data();
+	const float* const inverseWraps = inverseWrapCount.data();
+	const float* const limits = limit.data();
+
+	// Jeden przebieg bez rozgałęzień i wywołań wirtualnych, który kompilator wektoryzuje.
+	// Klipy zapętlone zawijają fazę (limit jest nieosiągalny), jednorazowe nie zawijają (okres 0) i stają na limicie.
+	// Faza jest nieujemna, więc obcięcie do int działa jak floor i ma wektorowy odpowiednik.
+	for (std::size_t i = 0; i < count; ++i) {
+		const float next = phases[i] + deltaTime * speeds[i];
+		const float wrapped = next - wraps[i] * static_cast<float>(static_cast<int>(next * inverseWraps[i]));
+		phases[i] = std::min(wrapped, limits[i]);
+	}
+}
+
+int AnimationSystem::getFrame(std::uint32_t id) const {
+	return std::min(static_cast<int>(phase[id]), static_cast<int>(frameCount[id]) - 1);
+}
+
+float AnimationSystem::getFraction(std::uint32_t id) const {
+	return phase[id] - std::floor(phase[id]);
+}
+
+bool AnimationSystem::isFinished(std::uint32_t id) const {
+	return phase[id] >= limit[id];
+}
+
+void AnimationSystem::setPhase(std::uint32_t id, float value) {
+	// Faza zapętlonego klipu jest zawsze mniejsza od liczby klatek, jednorazowego - nie większa.
+	const float top = wrapCount[id] > 0.f ? std::nextafter(wrapCount[id], 0.f) : limit[id];
+	phase[id] = std::clamp(value, 0.f, top);
+}
+
+void AnimationSystem::restart(std::uint32_t id) {
+	phase[id] = 0.f;
+	speed[id] = 1.f / frameTime[id];
+}
+
+void AnimationSystem::setPlaying(std::uint32_t id, bool playing) {
+	speed[id] = playing ? 1.f / frameTime[id] : 0.f;
+}
+
+AnimationSystem& animations() {
+	static AnimationSystem system;
+	return system;
+}
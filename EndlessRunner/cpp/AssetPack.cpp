@@ -0,0 +1,290 @@
+﻿/**
+ * @file AssetPack.cpp
+ * @brief Implementacja archiwum tekstur i narzędzia do jego budowania.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+module AssetPackModule;
+
+import Lz4Module;
+
+namespace {
+	/** @brief Sygnatura archiwum. */
+	constexpr char PACK_MAGIC[4] = { 'D', 'R', 'P', 'K' };
+
+	std::size_t alignUp(std::size_t value) {
+		return (value + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+	}
+
+	double millisecondsSince(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/**
+	 * @brief Odczytuje rozmiar i czas modyfikacji pliku źródłowego tekstury.
+	 * @return False, jeśli pliku nie ma lub nie da się go odczytać.
+	 */
+	bool sourceStamp(const char* path, std::uint64_t& size, std::int64_t& time) {
+		std::error_code error;
+		size = static_cast<std::uint64_t>(std::filesystem::file_size(path, error));
+		if (error) {
+			return false;
+		}
+		time = static_cast<std::int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+		return !error;
+	}
+}
+
+bool AssetPack::open(const std::string& path, bool checkSources) {
+	close();
+	if (!file.open(path)) {
+		return false;
+	}
+
+	const std::uint8_t* base = file.get();
+	const std::size_t size = file.getSize();
+	PackHeader header;
+	if (size < sizeof(PackHeader)) {
+		std::cout << "Asset pack " << path << " is truncated\n";
+		close();
+		return false;
+	}
+	std::memcpy(&header, base, sizeof(header));
+	if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header.version != PACK_VERSION) {
+		std::cout << "Asset pack " << path << " has unsupported format\n";
+		close();
+		return false;
+	}
+	if (header.entryCount > (size - sizeof(PackHeader)) / sizeof(PackEntry)) {
+		std::cout << "Asset pack " << path << " has a truncated index\n";
+		close();
+		return false;
+	}
+
+	// Indeks leży zaraz za nagłówkiem, wyrównany do 16 bajtów, więc można go czytać wprost ze zmapowanych stron.
+	const PackEntry* entries = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+	std::uint32_t stale = 0;
+	for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+		const PackEntry& entry = entries[i];
+		const bool terminated = std::memchr(entry.path, '\0', PACK_PATH_LENGTH) != nullptr;
+		const std::uint64_t expected = static_cast<std::uint64_t>(GetPixelDataSize(static_cast<int>(entry.width), static_cast<int>(entry.height), entry.format));
+		const bool inside = entry.offset <= size && entry.storedSize <= size - entry.offset;
+		const bool sized = entry.rawSize == expected && (entry.compression != PackCompression::NONE || entry.storedSize == entry.rawSize);
+		const bool known = entry.compression == PackCompression::NONE || entry.compression == PackCompression::LZ4;
+		if (!terminated || !inside || !sized || !known) {
+			std::cout << "Asset pack " << path << " has a corrupt entry " << i << "\n";
+			close();
+			return false;
+		}
+		// Archiwum bez plików PNG obok niego jest w pełni używane; zmieniony PNG ma pierwszeństwo przed archiwum.
+		// Za zmianę uznajemy inny rozmiar albo nowszy czas - kopiowanie zaokrągla czasy, więc równość jest zbyt ostra.
+		std::uint64_t sourceSize = 0;
+		std::int64_t sourceTime = 0;
+		if (checkSources && sourceStamp(entry.path, sourceSize, sourceTime) && (sourceSize != entry.sourceSize || sourceTime > entry.sourceTime)) {
+			++stale;
+			continue;
+		}
+		index[entry.path] = &entry;
+	}
+	if (stale > 0) {
+		std::cout << "Asset pack " << path << ": " << stale
+			<< " textures changed since it was built, loading them from loose files (rebuild with --pack-assets)\n";
+	}
+	return true;
+}
+
+void AssetPack::close() {
+	index.clear();
+	scratch.clear();
+	scratch.shrink_to_fit();
+	file.close();
+}
+
+const PackEntry* AssetPack::find(const std::string& path) const {
+	auto it = index.find(path);
+	return it != index.end() ? it->second : nullptr;
+}
+
+Image AssetPack::view(const PackEntry& entry) {
+	Image image{};
+	image.width = static_cast<int>(entry.width);
+	image.height = static_cast<int>(entry.height);
+	image.mipmaps = 1;
+	image.format = entry.format;
+
+	const std::uint8_t* stored = file.get() + entry.offset;
+	if (entry.compression == PackCompression::NONE) {
+		image.data = const_cast<std::uint8_t*>(stored);
+		return image;
+	}
+	scratch.resize(static_cast<std::size_t>(entry.rawSize));
+	if (!lz4Decompress(stored, static_cast<std::size_t>(entry.storedSize), scratch.data(), scratch.size())) {
+		std::cout << "Asset pack entry " << entry.path << " failed to decompress\n";
+		return Image{};
+	}
+	image.data = scratch.data();
+	return image;
+}
+
+Texture2D AssetPack::loadTexture(const PackEntry& entry) {
+	Image image = view(entry);
+	if (image.data == nullptr) {
+		return Texture2D{};
+	}
+	return LoadTextureFromImage(image);
+}
+
+bool packAssets(const std::string& directory, const std::string& output, bool compress) {
+	std::vector<std::string> paths;
+	std::error_code error;
+	for (const auto& item : std::filesystem::recursive_directory_iterator(directory, error)) {
+		std::string extension = item.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		if (item.is_regular_file() && extension == ".png") {
+			paths.push_back(item.path().lexically_normal().generic_string());
+		}
+	}
+	if (paths.empty()) {
+		std::cout << "No textures found in " << directory << "\n";
+		return false;
+	}
+	// Kolejność zgodna z nazwami daje powtarzalny plik niezależnie od systemu plików.
+	std::sort(paths.begin(), paths.end());
+
+	std::ofstream out(output, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::cout << "Failed to open " << output << " for writing\n";
+		return false;
+	}
+
+	std::vector<PackEntry> entries;
+	entries.reserve(paths.size());
+	for (const std::string& path : paths) {
+		if (path.size() >= PACK_PATH_LENGTH) {
+			std::cout << "Skipping " << path << ": path longer than " << PACK_PATH_LENGTH - 1 << " characters\n";
+			continue;
+		}
+		PackEntry entry{};
+		std::memcpy(entry.path, path.c_str(), path.size() + 1);
+		entries.push_back(entry);
+	}
+
+	// Nagłówek i indeks zapisujemy na końcu, gdy znane są położenia danych.
+	const std::size_t dataStart = alignUp(sizeof(PackHeader) + entries.size() * sizeof(PackEntry));
+	std::size_t position = dataStart;
+	out.seekp(static_cast<std::streamoff>(dataStart));
+
+	double looseMilliseconds = 0.0;
+	std::size_t looseBytes = 0;
+	std::size_t rawBytes = 0;
+	const std::vector<char> padding(PACK_ALIGNMENT, 0);
+	for (PackEntry& entry : entries) {
+		// Znacznik pliku bierzemy przed dekodowaniem - zmiana PNG w trakcie budowania też unieważni wpis.
+		if (!sourceStamp(entry.path, entry.sourceSize, entry.sourceTime)) {
+			std::cout << "Failed to read " << entry.path << "\n";
+			out.close();
+			std::filesystem::remove(output, error);
+			return false;
+		}
+		// Czas wczytania i dekodowania PNG to koszt, który archiwum usuwa ze startu gry.
+		const auto start = std::chrono::steady_clock::now();
+		Image image = LoadImage(entry.path);
+		ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+		looseMilliseconds += millisecondsSince(start);
+
+		if (image.data == nullptr) {
+			std::cout << "Failed to decode " << entry.path << "\n";
+			out.close();
+			std::filesystem::remove(output, error);
+			return false;
+		}
+
+		looseBytes += static_cast<std::size_t>(entry.sourceSize);
+		entry.width = static_cast<std::uint32_t>(image.width);
+		entry.height = static_cast<std::uint32_t>(image.height);
+		entry.format = image.format;
+		entry.rawSize = static_cast<std::uint64_t>(GetPixelDataSize(image.width, image.height, image.format));
+		entry.offset = position;
+
+		const std::uint8_t* pixels = static_cast<const std::uint8_t*>(image.data);
+		std::vector<std::uint8_t> packed;
+		if (compress) {
+			packed = lz4Compress(pixels, static_cast<std::size_t>(entry.rawSize));
+		}
+		// Kompresja, która nic nie daje, tylko spowalnia start - takie tekstury zapisujemy bez niej.
+		if (compress && packed.size() < entry.rawSize) {
+			entry.compression = PackCompression::LZ4;
+			entry.storedSize = packed.size();
+			out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+		}
+		else {
+			entry.compression = PackCompression::NONE;
+			entry.storedSize = entry.rawSize;
+			out.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(entry.rawSize));
+		}
+		UnloadImage(image);
+
+		rawBytes += static_cast<std::size_t>(entry.rawSize);
+		const std::size_t end = position + static_cast<std::size_t>(entry.storedSize);
+		position = alignUp(end);
+		out.write(padding.data(), static_cast<std::streamsize>(position - end));
+	}
+
+	PackHeader header{};
+	std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+	header.version = PACK_VERSION;
+	header.entryCount = static_cast<std::uint32_t>(entries.size());
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+	out.close();
+	if (!out) {
+		std::cout << "Failed to write " << output << "\n";
+		return false;
+	}
+
+	// Pomiar "po": zmapowanie archiwum i dostęp do pikseli wszystkich tekstur (bez wysyłania na GPU, jak w pomiarze "przed").
+	const auto start = std::chrono::steady_clock::now();
+	AssetPack pack;
+	if (!pack.open(output)) {
+		return false;
+	}
+	std::uint64_t checksum = 0;
+	for (const PackEntry& entry : entries) {
+		const PackEntry* packed = pack.find(entry.path);
+		Image image = packed ? pack.view(*packed) : Image{};
+		if (image.data == nullptr) {
+			std::cout << "Failed to read back " << entry.path << "\n";
+			return false;
+		}
+		// Dotykamy każdej strony, żeby system rzeczywiście wczytał dane z dysku.
+		const std::uint8_t* pixels = static_cast<const std::uint8_t*>(image.data);
+		for (std::size_t i = 0; i < packed->rawSize; i += 4096) {
+			checksum += pixels[i];
+		}
+	}
+	const double packMilliseconds = millisecondsSince(start);
+
+	std::cout << std::fixed << std::setprecision(2)
+		<< "Packed " << entries.size() << " textures into " << output << " (" << (compress ? "lz4" : "raw") << ")\n"
+		<< "  loose PNG: " << looseBytes / 1024 << " KiB, " << looseMilliseconds << " ms to open and decode\n"
+		<< "  pack:      " << position / 1024 << " KiB (" << rawBytes / 1024 << " KiB of pixels), "
+		<< packMilliseconds << " ms to map and read (checksum " << checksum << ")\n";
+	std::cout.unsetf(std::ios::fixed);
+	return true;
+}
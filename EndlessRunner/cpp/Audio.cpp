@@ -0,0 +1,361 @@
+﻿/**
+ * @file Audio.cpp
+ * @brief Implementacja klas Mixer i AudioSystem.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+module AudioModule;
+
+namespace {
+	/** @brief Nazwy plików efektów w Config::SOUND_DIRECTORY (w kolejności Sfx). */
+	const char* const SFX_NAMES[] = { "jump", "land", "hit", "click" };
+
+	/**
+	 * @brief Syntetyzuje zastępczy efekt, gdy w katalogu nie ma pliku.
+	 * @param sfx Efekt.
+	 * @return Próbki mono float.
+	 */
+	std::vector<float> synthesize(Sfx sfx) {
+		constexpr float rate = static_cast<float>(Config::AUDIO_SAMPLE_RATE);
+		constexpr float twoPi = 6.2831853f;
+		std::mt19937 gen(static_cast<unsigned>(sfx) + 1);
+		std::uniform_real_distribution<float> noise(-1.f, 1.f);
+
+		float seconds = 0.1f;
+		switch (sfx) {
+		case Sfx::JUMP: seconds = 0.12f; break;
+		case Sfx::LAND: seconds = 0.08f; break;
+		case Sfx::HIT: seconds = 0.35f; break;
+		case Sfx::CLICK: seconds = 0.03f; break;
+		default: break;
+		}
+
+		std::vector<float> samples(static_cast<std::size_t>(seconds * rate));
+		float phase = 0.f;
+		for (std::size_t i = 0; i < samples.size(); ++i) {
+			const float t = static_cast<float>(i) / samples.size();
+			const float envelope = (1.f - t) * (1.f - t);
+			float frequency = 440.f;
+			float value = 0.f;
+			switch (sfx) {
+			case Sfx::JUMP:
+				frequency = 400.f + 500.f * t;
+				value = std::sin(phase);
+				break;
+			case Sfx::LAND:
+				frequency = 120.f;
+				value = 0.7f * std::sin(phase) + 0.3f * noise(gen);
+				break;
+			case Sfx::HIT:
+				frequency = 90.f;
+				value = 0.5f * std::sin(phase) + 0.5f * noise(gen);
+				break;
+			case Sfx::CLICK:
+				frequency = 1500.f;
+				value = std::sin(phase);
+				break;
+			default:
+				break;
+			}
+			phase = std::fmod(phase + twoPi * frequency / rate, twoPi);
+			samples[i] = value * envelope;
+		}
+		return samples;
+	}
+
+	/**
+	 * @brief Dekoduje plik do próbek mono float w częstotliwości miksera.
+	 * @param path Ścieżka pliku.
+	 * @param out Miejsce na próbki.
+	 * @return True, jeśli plik został zdekodowany.
+	 */
+	bool decodeFile(const std::string& path, std::vector<float>& out) {
+		if (!FileExists(path.c_str())) {
+			return false;
+		}
+		Wave wave = LoadWave(path.c_str());
+		if (wave.data == nullptr || wave.frameCount == 0) {
+			std::cout << "Failed to decode sound " << path << "\n";
+			return false;
+		}
+		WaveFormat(&wave, Config::AUDIO_SAMPLE_RATE, 32, 1);
+		float* samples = LoadWaveSamples(wave);
+		out.assign(samples, samples + wave.frameCount);
+		UnloadWaveSamples(samples);
+		UnloadWave(wave);
+		return true;
+	}
+}
+
+bool Mixer::play(Sfx sfx, float gain) {
+	const std::uint32_t head = queueHead.load(std::memory_order_relaxed);
+	if (head - queueTail.load(std::memory_order_acquire) >= QUEUE_SIZE) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	queue[head % QUEUE_SIZE] = PlayCommand{ static_cast<int>(sfx), gain };
+	queueHead.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+void Mixer::start(const PlayCommand& command) {
+	const SoundBank& bank = banks[command.sound];
+	if (bank.samples.empty()) {
+		return;
+	}
+
+	Voice* target = nullptr;
+	for (Voice& voice : voices) {
+		if (voice.sound < 0) {
+			target = &voice;
+			break;
+		}
+	}
+	if (target == nullptr) {
+		// Brak wolnego głosu: ofiarą jest najmniej ważny, a wśród równie ważnych - najstarszy.
+		Voice* victim = &voices[0];
+		for (Voice& voice : voices) {
+			if (voice.priority < victim->priority || (voice.priority == victim->priority && voice.serial < victim->serial)) {
+				victim = &voice;
+			}
+		}
+		if (victim->priority > bank.priority) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		target = victim;
+		stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	*target = Voice{ command.sound, 0, bank.priority, bank.volume * command.gain, ++serial };
+	played.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Mixer::render(float* out, unsigned int frames) {
+	const auto mixStart = std::chrono::steady_clock::now();
+
+	const std::uint32_t head = queueHead.load(std::memory_order_acquire);
+	std::uint32_t tail = queueTail.load(std::memory_order_relaxed);
+	for (; tail != head; ++tail) {
+		start(queue[tail % QUEUE_SIZE]);
+	}
+	queueTail.store(tail, std::memory_order_release);
+
+	std::fill(out, out + frames, 0.f);
+	for (Voice& voice : voices) {
+		if (voice.sound < 0) {
+			continue;
+		}
+		const std::vector<float>& samples = banks[voice.sound].samples;
+		const std::size_t count = std::min<std::size_t>(frames, samples.size() - voice.cursor);
+		const float gain = voice.gain * masterVolume;
+		const float* source = samples.data() + voice.cursor;
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] += source[i] * gain;
+		}
+		voice.cursor += count;
+		if (voice.cursor >= samples.size()) {
+			voice.sound = -1;
+		}
+	}
+	for (unsigned int i = 0; i < frames; ++i) {
+		out[i] = std::clamp(out[i], -1.f, 1.f);
+	}
+
+	mixedFrames.fetch_add(frames, std::memory_order_relaxed);
+	mixNanos.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - mixStart).count()), std::memory_order_relaxed);
+}
+
+int Mixer::getActiveVoices() const {
+	return static_cast<int>(std::count_if(voices.begin(), voices.end(), [](const Voice& voice) { return voice.sound >= 0; }));
+}
+
+std::size_t Mixer::getBankBytes() const {
+	std::size_t bytes = 0;
+	for (const SoundBank& bank : banks) {
+		bytes += bank.samples.capacity() * sizeof(float);
+	}
+	return bytes;
+}
+
+AudioSystem::~AudioSystem() {
+	stop();
+}
+
+bool AudioSystem::start(bool nullOutput, const char* musicPath) {
+	if (started) {
+		return deviceReady;
+	}
+	started = true;
+
+	loadBanks();
+
+	if (!nullOutput) {
+		InitAudioDevice();
+		deviceReady = IsAudioDeviceReady();
+		if (!deviceReady) {
+			std::cout << "Audio device unavailable, using null output\n";
+		}
+	}
+
+	if (deviceReady) {
+		// Mały bufor efektów skraca opóźnienie między zdarzeniem w grze a dźwiękiem.
+		SetAudioStreamBufferSizeDefault(Config::AUDIO_SFX_FRAMES);
+		sfxStream = LoadAudioStream(Config::AUDIO_SAMPLE_RATE, 32, 1);
+		SetAudioStreamCallback(sfxStream, &AudioSystem::mixCallback);
+		PlayAudioStream(sfxStream);
+	}
+
+	running = true;
+	worker = std::thread(&AudioSystem::run, this, std::string(musicPath != nullptr ? musicPath : ""));
+	return deviceReady;
+}
+
+void AudioSystem::stop() {
+	if (!started) {
+		return;
+	}
+	running = false;
+	if (worker.joinable()) {
+		worker.join();
+	}
+	if (deviceReady) {
+		UnloadAudioStream(sfxStream);
+		CloseAudioDevice();
+		deviceReady = false;
+	}
+	started = false;
+}
+
+void AudioSystem::play(Sfx sfx, float gain) {
+	if (started) {
+		mixer.play(sfx, gain);
+	}
+}
+
+void AudioSystem::loadBanks() {
+	struct BankSpec {
+		Sfx sfx;
+		int priority;
+		float volume;
+	};
+	// Zderzenie jest najważniejsze, kliknięcie i skok zabierają głos lądowaniu.
+	const BankSpec specs[] = {
+		{ Sfx::JUMP, 2, 0.6f },
+		{ Sfx::LAND, 1, 0.5f },
+		{ Sfx::HIT, 3, 1.0f },
+		{ Sfx::CLICK, 2, 0.5f },
+	};
+
+	const auto decodeStart = std::chrono::steady_clock::now();
+	for (const BankSpec& spec : specs) {
+		SoundBank bank;
+		bank.priority = spec.priority;
+		bank.volume = spec.volume;
+		const std::string path = std::string(Config::SOUND_DIRECTORY) + "/" + SFX_NAMES[static_cast<int>(spec.sfx)] + ".wav";
+		if (!decodeFile(path, bank.samples)) {
+			bank.samples = synthesize(spec.sfx);
+		}
+		mixer.setBank(spec.sfx, std::move(bank));
+	}
+	bankDecodeNanos = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - decodeStart).count());
+}
+
+void AudioSystem::run(std::string musicPath) {
+	using Clock = std::chrono::steady_clock;
+	const auto interval = std::chrono::milliseconds(Config::AUDIO_FEED_INTERVAL_MS);
+
+	if (!deviceReady) {
+		// Wyjście zerowe: mikser jest pobierany w tempie czasu rzeczywistego, a próbki są odrzucane.
+		std::vector<float> scratch(Config::AUDIO_SFX_FRAMES);
+		const auto begin = Clock::now();
+		std::uint64_t rendered = 0;
+		while (running) {
+			const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+			const std::uint64_t due = static_cast<std::uint64_t>(elapsed * Config::AUDIO_SAMPLE_RATE);
+			while (rendered + scratch.size() <= due) {
+				mixer.render(scratch.data(), static_cast<unsigned int>(scratch.size()));
+				rendered += scratch.size();
+			}
+			std::this_thread::sleep_for(interval);
+		}
+		return;
+	}
+
+	// Wszystkie wywołania muzyki są w tym wątku - pętla gry nigdy nie dekoduje ani nie czeka na dysk.
+	Music music{};
+	if (!musicPath.empty()) {
+		SetAudioStreamBufferSizeDefault(Config::AUDIO_STREAM_FRAMES);
+		music = LoadMusicStream(musicPath.c_str());
+		if (music.stream.buffer == nullptr || music.frameCount == 0) {
+			std::cout << "Failed to open music " << musicPath << "\n";
+		}
+		else {
+			music.looping = true;
+			SetMusicVolume(music, Config::MUSIC_VOLUME);
+			PlayMusicStream(music);
+			musicBufferBytes = static_cast<std::size_t>(2) * Config::AUDIO_STREAM_FRAMES
+				* music.stream.channels * (music.stream.sampleSize / 8);
+			musicPlaying = true;
+		}
+	}
+
+	while (running) {
+		if (musicPlaying) {
+			const auto decodeStart = Clock::now();
+			UpdateMusicStream(music);
+			musicDecodeNanos += static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - decodeStart).count());
+			musicUpdates++;
+		}
+		std::this_thread::sleep_for(interval);
+	}
+
+	if (musicPlaying) {
+		UnloadMusicStream(music);
+		musicPlaying = false;
+	}
+}
+
+void AudioSystem::mixCallback(void* buffer, unsigned int frames) {
+	audio().mixer.render(static_cast<float*>(buffer), frames);
+}
+
+void AudioSystem::printReport() const {
+	const double mixedSeconds = static_cast<double>(mixer.getMixedFrames()) / Config::AUDIO_SAMPLE_RATE;
+	std::cout << std::fixed << std::setprecision(2)
+		<< "Audio: " << (deviceReady ? "device" : "null output")
+		<< ", banks " << static_cast<double>(mixer.getBankBytes()) / 1024.0 << " KiB decoded in "
+		<< static_cast<double>(bankDecodeNanos) / 1e6 << " ms"
+		<< ", music stream buffers " << static_cast<double>(musicBufferBytes.load()) / 1024.0 << " KiB, "
+		<< musicUpdates.load() << " music updates using " << static_cast<double>(musicDecodeNanos.load()) / 1e6 << " ms decode"
+		<< "\nAudio mixer: " << mixer.getPlayed() << " played, " << mixer.getStolen() << " stolen, "
+		<< mixer.getDropped() << " dropped, " << mixedSeconds << " s mixed";
+	if (mixedSeconds > 0.0) {
+		std::cout << " (" << static_cast<double>(mixer.getMixNanos()) / 1e3 / mixedSeconds << " us per second of audio)";
+	}
+	std::cout << "\n";
+	std::cout.unsetf(std::ios::fixed);
+}
+
+AudioSystem& audio() {
+	static AudioSystem system;
+	return system;
+}
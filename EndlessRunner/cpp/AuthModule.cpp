@@ -5,6 +5,7 @@
 
 module;
 #include <string>
+#include <string_view>
 #include <set>
 #include <regex>
 #include <ranges>
@@ -12,6 +13,13 @@ module;
 #include <fstream>
 #include <sstream>
 #include <functional> // std::hash
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
 
 module AuthModule;
 
@@ -21,50 +29,54 @@ std::string Authorization::hashPassword(const std::string& password) {
 }
 
 void Authorization::loadUsers() {
-	std::ifstream file(usersFile);
-	if (!file.is_open()) {
-		return;
-	}
-
-	std::string line;
-	while (std::getline(file, line)) {
-		std::istringstream iss(line);
-		std::string username, hashedPassword;
-		if (std::getline(iss, username, ':') && std::getline(iss, hashedPassword)) {
-			existingUsernames.insert(username);
-			storedPasswords[username] = hashedPassword;
+	auto addUser = [this](std::string_view line) {
+		const std::size_t colon = line.find(':');
+		if (colon == std::string_view::npos || colon == 0) {
+			return;
 		}
+		std::string username(line.substr(0, colon));
+		storedPasswords[username] = std::string(line.substr(colon + 1));
+		existingUsernames.insert(std::move(username));
+	};
+	// Czytane są tylko wiersze dopisane od poprzedniego razu; po podmianie pliku stan budujemy od nowa.
+	if (usersLog.readNew(addUser).restarted) {
+		existingUsernames.clear();
+		storedPasswords.clear();
+		usersLog.readNew(addUser);
 	}
-
-	file.close();
 }
 
-bool Authorization::saveUser(const std::string& username, const std::string& hashedPassword) {
-	std::ofstream file(usersFile, std::ios::app); //Append mode
-	if (!file.is_open()) {
-		return false;
-	}
-	file << username << ":" << hashedPassword << "\n";
-	file.close();
-	return true;
+AppendResult Authorization::saveUser(const std::string& username, const std::string& hashedPassword) {
+	// Sprawdzenie pod blokadą zapisu: dwie instancje rejestrujące tę samą nazwę nie mogą obie jej dopisać.
+	return usersLog.append(username + ":" + hashedPassword, [this, &username] {
+		loadUsers();
+		return !existingUsernames.contains(username);
+	});
 }
 
 SignInResult Authorization::signIn(const std::string& username, const std::string& password) {
-	if (std::ranges::find(existingUsernames, username) != existingUsernames.end()) {
+	loadUsers();
+	if (existingUsernames.contains(username)) {
 		return SignInResult::USERNAME_TAKEN;
 	}
-	std::regex usernameRegex("^[a-zA-Z0-9]{3,20}$");
+	// Wyrażenia są kompilowane raz; inicjalizacja statycznych zmiennych lokalnych jest bezpieczna wątkowo.
+	static const std::regex usernameRegex("^[a-zA-Z0-9]{3,20}$");
 	if (!std::regex_match(username, usernameRegex)) {
 		return SignInResult::INVALID_USERNAME;
 	}
 
-	std::regex passwordRegex("^[A-Za-z\\d]{8,}$");
+	static const std::regex passwordRegex("^[A-Za-z\\d]{8,}$");
 	if (!std::regex_match(password, passwordRegex)) {
 		return SignInResult::INVALID_PASSWORD;
 	}
 
 	std::string hashedPassword = hashPassword(password);
-	if (!saveUser(username, hashedPassword)) {
+	switch (saveUser(username, hashedPassword)) {
+	case AppendResult::WRITTEN:
+		break;
+	case AppendResult::REJECTED:
+		return SignInResult::USERNAME_TAKEN;
+	case AppendResult::FAILED:
 		return SignInResult::INVALID_USERNAME;
 	}
 
@@ -75,15 +87,132 @@ SignInResult Authorization::signIn(const std::string& username, const std::strin
 }
 
 LogInResult	Authorization::logIn(const std::string& username, const std::string& password) {
-	if (std::ranges::find(existingUsernames, username) == existingUsernames.end()) {
+	// Użytkownik mógł się zarejestrować w innej instancji gry.
+	loadUsers();
+	auto stored = storedPasswords.find(username);
+	if (stored == storedPasswords.end()) {
 		return LogInResult::USER_NOT_FOUND;
 	}
 
 	std::string hashedPassword = hashPassword(password);
-	if (storedPasswords.find(username)->second != hashedPassword) {
+	if (stored->second != hashedPassword) {
 		return LogInResult::INCORRECT_PASSWORD;
 	}
 
 	return LogInResult::SUCCESS;
 
-}
\ No newline at end of file
+}
+
+AuthWorker::~AuthWorker() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+bool AuthWorker::admit(Clock::time_point now) {
+	const bool tooSoon = lastSubmit != Clock::time_point{}
+		&& now - lastSubmit < std::chrono::milliseconds(Config::AUTH_MIN_INTERVAL_MS);
+	if (tooSoon || queue.size() >= static_cast<std::size_t>(Config::AUTH_MAX_PENDING)) {
+		++rejected;
+		return false;
+	}
+	lastSubmit = now;
+	if (!worker.joinable()) {
+		worker = std::thread(&AuthWorker::run, this);
+	}
+	return true;
+}
+
+std::future<SignInResult> AuthWorker::signIn(const std::string& username, const std::string& password) {
+	std::future<SignInResult> result;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto now = Clock::now();
+		if (!admit(now)) {
+			return result;
+		}
+		Request& request = queue.emplace_back();
+		request.signIn = true;
+		request.username = username;
+		request.password = password;
+		request.submitted = now;
+		result = request.signInResult.get_future();
+	}
+	wake.notify_one();
+	return result;
+}
+
+std::future<LogInResult> AuthWorker::logIn(const std::string& username, const std::string& password) {
+	std::future<LogInResult> result;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto now = Clock::now();
+		if (!admit(now)) {
+			return result;
+		}
+		Request& request = queue.emplace_back();
+		request.username = username;
+		request.password = password;
+		request.submitted = now;
+		result = request.logInResult.get_future();
+	}
+	wake.notify_one();
+	return result;
+}
+
+void AuthWorker::run() {
+	// Plik użytkowników jest wczytywany raz, już w wątku roboczym.
+	Authorization auth;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait(lock, [this] { return stopping || !queue.empty(); });
+		if (stopping) {
+			break;
+		}
+		Request request = std::move(queue.front());
+		queue.pop_front();
+		lock.unlock();
+
+		if (request.signIn) {
+			request.signInResult.set_value(auth.signIn(request.username, request.password));
+		}
+		else {
+			request.logInResult.set_value(auth.logIn(request.username, request.password));
+		}
+		const double latencyMs = std::chrono::duration<double, std::milli>(Clock::now() - request.submitted).count();
+
+		lock.lock();
+		++completed;
+		totalLatencyMs += latencyMs;
+		maxLatencyMs = std::max(maxLatencyMs, latencyMs);
+		lastLatencyMs = latencyMs;
+	}
+}
+
+double AuthWorker::getLastLatencyMs() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return lastLatencyMs;
+}
+
+void AuthWorker::printReport() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (completed == 0 && rejected == 0) {
+		return;
+	}
+	const double averageMs = completed > 0 ? totalLatencyMs / static_cast<double>(completed) : 0.0;
+	std::cout << std::fixed << std::setprecision(2)
+		<< "Auth: " << completed << " requests, " << rejected << " rate-limited, "
+		<< averageMs << " ms avg, " << maxLatencyMs << " ms max latency\n";
+	std::cout.unsetf(std::ios::fixed);
+}
+
+AuthWorker& authWorker() {
+	static AuthWorker worker;
+	return worker;
+}
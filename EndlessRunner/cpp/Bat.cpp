@@ -8,16 +8,18 @@ module;
 
 module BatModule;
 
+import DrawListModule;
+
 void Bat::init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
-	Obstacle::init(tex, startX, startY - 150, scaleFactor, frameCount, animUpdateTime);
+	Obstacle::init(tex, startX, startY - Config::BAT_ALTITUDE, scaleFactor, frameCount, animUpdateTime);
 }
 
 void Bat::update(float deltaTime) {
 	Obstacle::update(deltaTime);
 }
 
-void Bat::draw() const{
-	AnimatedSprite::draw();
+void Bat::draw(DrawList& list) const {
+	AnimatedSprite::draw(list);
 }
 
 Rectangle Bat::getCollisionRec() const{
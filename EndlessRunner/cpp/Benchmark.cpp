@@ -0,0 +1,701 @@
+﻿/**
+ * @file Benchmark.cpp
+ * @brief Implementacja zestawu testów wydajności i porównania wyników.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module BenchmarkModule;
+
+import AnalyticsModule;
+import AnimationSystemModule;
+import AuthModule;
+import BoardModule;
+import CollisionHandlingModule;
+import GhostModule;
+import MappedFileModule;
+import MenuModule;
+import ObstacleFactoryModule;
+import ObstacleModule;
+import ResourcesModule;
+import SnapshotModule;
+import TextureCacheModule;
+
+namespace {
+	/** @brief Wyniki trafiają tutaj, aby kompilator nie usunął mierzonego kodu. */
+	volatile std::uint64_t sink = 0;
+
+	/**
+	 * @class Suite
+	 * @brief Kalibruje, powtarza i zbiera wyniki testów pasujących do filtra.
+	 */
+	class Suite {
+	private:
+		/** @brief Filtr nazw. */
+		std::string_view filter;
+		/** @brief Zebrane wyniki. */
+		std::vector<BenchmarkResult> results;
+
+	public:
+		explicit Suite(std::string_view nameFilter) : filter(nameFilter) {}
+
+		/**
+		 * @brief Sprawdza, czy test (lub grupa o tym prefiksie) ma być uruchomiony.
+		 * @param name Nazwa testu lub prefiks grupy.
+		 * @return True, jeśli nazwa pasuje do filtra.
+		 */
+		bool selected(std::string_view name) const {
+			return filter.empty() || name.starts_with(filter) || filter.starts_with(name);
+		}
+
+		/**
+		 * @brief Mierzy operację: podwaja liczbę wywołań, aż powtórzenie trwa BENCHMARK_REPEAT_MS, i powtarza pomiar.
+		 * @param name Nazwa testu.
+		 * @param items Rozmiar danych testu.
+		 * @param op Mierzona operacja.
+		 */
+		void run(const std::string& name, std::uint64_t items, const std::function<void()>& op) {
+			if (!name.starts_with(filter)) {
+				return;
+			}
+			using Clock = std::chrono::steady_clock;
+			auto timeBatch = [&op](std::uint64_t count) {
+				const auto start = Clock::now();
+				for (std::uint64_t i = 0; i < count; ++i) {
+					op();
+				}
+				return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+			};
+
+			const double target = Config::BENCHMARK_REPEAT_MS * 1e6;
+			std::uint64_t iterations = 1;
+			double nanos = timeBatch(iterations);
+			while (nanos < target && iterations < (1ull << 40)) {
+				iterations *= 2;
+				nanos = timeBatch(iterations);
+			}
+
+			std::vector<double> samples{ nanos / iterations };
+			for (int r = 1; r < Config::BENCHMARK_REPEATS; ++r) {
+				samples.push_back(timeBatch(iterations) / iterations);
+			}
+			std::sort(samples.begin(), samples.end());
+
+			BenchmarkResult result{ name, samples[samples.size() / 2], samples.front(), iterations, items };
+			std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(16) << result.nsPerOp
+				<< std::setw(16) << result.minNsPerOp
+				<< std::setw(12) << iterations
+				<< std::setw(10) << items << "\n";
+			std::cout.unsetf(std::ios::fixed);
+			results.push_back(std::move(result));
+		}
+
+		/** @brief Zwraca zebrane wyniki. @return Wyniki w kolejności uruchomienia. */
+		const std::vector<BenchmarkResult>& getResults() const { return results; }
+	};
+
+	/**
+	 * @brief Zapisuje plik użytkowników w formacie Authorization (nazwa:hash), z hasłem passwordN dla userN.
+	 * @param path Ścieżka pliku.
+	 * @param count Liczba użytkowników.
+	 */
+	void writeUsersFile(const std::filesystem::path& path, std::uint64_t count) {
+		std::ofstream file(path, std::ios::trunc);
+		std::hash<std::string> hasher;
+		for (std::uint64_t i = 0; i < count; ++i) {
+			file << "user" << i << ":" << hasher("password" + std::to_string(i)) << "\n";
+		}
+	}
+
+	/**
+	 * @brief Zapisuje plik wyników w formacie scores.txt (nazwa:wynik), średnio cztery wyniki na gracza.
+	 * @param path Ścieżka pliku.
+	 * @param count Liczba wierszy.
+	 */
+	void writeScoresFile(const std::filesystem::path& path, std::uint64_t count) {
+		std::ofstream file(path, std::ios::trunc);
+		std::mt19937 gen(7);
+		std::uniform_int_distribution<int> score(0, 100000);
+		const std::uint64_t players = std::max<std::uint64_t>(count / 4, 1);
+		for (std::uint64_t i = 0; i < count; ++i) {
+			file << "user" << (i % players) << ":" << score(gen) << "\n";
+		}
+	}
+
+	/**
+	 * @brief Zapisuje dziennik zdarzeń z rozgrywek o losowej długości: przeszkoda i skok co pół sekundy,
+	 * co pięćdziesiąta klatka za długa, na końcu zderzenie.
+	 * @param path Ścieżka pliku (dotychczasowa zawartość jest usuwana).
+	 * @param events Przybliżona liczba zdarzeń.
+	 * @return Liczba zapisanych zdarzeń.
+	 */
+	std::uint64_t writeAnalyticsFile(const std::filesystem::path& path, std::uint64_t events) {
+		std::filesystem::remove(path);
+		AnalyticsLog log(path.string());
+		std::mt19937 gen(13);
+		std::uniform_int_distribution<int> length(20, 400);
+		for (std::uint64_t run = 0; log.getStats().events < events; ++run) {
+			log.beginRun(static_cast<BackgroundType>(run % ANALYTICS_BIOMES), 1);
+			const int steps = length(gen);
+			for (int step = 0; step < steps; ++step) {
+				log.advance(0.5f);
+				log.recordSpawn(static_cast<ObstacleKind>(step % ANALYTICS_KINDS), 400.0f);
+				log.recordJump(0, 0.004f);
+				log.recordFrame(step % 50 == 0 ? 0.05f : 0.016f);
+			}
+			log.recordDeath(0, static_cast<ObstacleKind>(run % ANALYTICS_KINDS), 400.0f);
+			log.endRun(steps * 0.5f);
+		}
+		log.flush();
+		return log.getStats().events;
+	}
+
+	/**
+	 * @struct GhostTrace
+	 * @brief Przebieg gracza krok po kroku (wysokość i licznik skoków po każdym kroku).
+	 */
+	struct GhostTrace {
+		std::vector<float> heights;
+		std::vector<std::uint32_t> jumps;
+	};
+
+	/**
+	 * @brief Symuluje skoki gracza (ta sama całka co Player) z losowymi odstępami i co trzecim skokiem podwójnym.
+	 * @param seconds Czas przebiegu.
+	 * @param deltaTime Krok symulacji.
+	 * @return Przebieg.
+	 */
+	GhostTrace makeGhostTrace(float seconds, float deltaTime) {
+		GhostTrace trace;
+		std::mt19937 gen(11);
+		std::uniform_real_distribution<float> interval(0.8f, 2.0f);
+		float height = 0.f;
+		float velocity = 0.f;
+		float nextJump = interval(gen);
+		float doubleJumpAt = -1.f;
+		std::uint32_t jumps = 0;
+		for (float time = 0.f; time < seconds; time += deltaTime) {
+			if (time >= nextJump && height == 0.f) {
+				velocity = -Config::JUMP_VELOCITY;
+				++jumps;
+				doubleJumpAt = jumps % 3 == 0 ? time + 0.25f : -1.f;
+				nextJump = time + interval(gen);
+			}
+			else if (doubleJumpAt >= 0.f && time >= doubleJumpAt) {
+				velocity += -Config::JUMP_VELOCITY;
+				++jumps;
+				doubleJumpAt = -1.f;
+			}
+			if (height > 0.f || velocity > 0.f) {
+				velocity -= Config::GRAVITY * deltaTime;
+			}
+			height = std::max(height + velocity * deltaTime, 0.f);
+			if (height == 0.f) {
+				velocity = 0.f;
+			}
+			trace.heights.push_back(height);
+			trace.jumps.push_back(jumps);
+		}
+		return trace;
+	}
+
+	/**
+	 * @brief Zwraca nazwę tła używaną w nazwach testów.
+	 * @param type Typ tła.
+	 * @return Nazwa tła.
+	 */
+	const char* biomeName(BackgroundType type) {
+		switch (type) {
+		case BackgroundType::DESERT_DAY: return "desert_day";
+		case BackgroundType::DESERT_NIGHT: return "desert_night";
+		case BackgroundType::FOREST_DAY: return "forest_day";
+		case BackgroundType::FOREST_NIGHT: return "forest_night";
+		}
+		return "unknown";
+	}
+
+	/**
+	 * @brief Odczytuje wartość liczbową pola JSON "key": liczba, szukając od pozycji from do to.
+	 * @param text Treść pliku.
+	 * @param key Nazwa pola.
+	 * @param from Początek obiektu.
+	 * @param to Koniec obiektu.
+	 * @param out Miejsce na wartość.
+	 * @return True, jeśli pole istnieje.
+	 */
+	bool readNumber(const std::string& text, const std::string& key, std::size_t from, std::size_t to, double& out) {
+		const std::size_t pos = text.find("\"" + key + "\"", from);
+		if (pos == std::string::npos || pos > to) {
+			return false;
+		}
+		const std::size_t colon = text.find(':', pos);
+		if (colon == std::string::npos || colon > to) {
+			return false;
+		}
+		char* end = nullptr;
+		out = std::strtod(text.c_str() + colon + 1, &end);
+		return end != text.c_str() + colon + 1;
+	}
+}
+
+int runBenchmarkSuite(const std::string& outputPath, std::string_view filter) {
+	SetTraceLogLevel(LOG_WARNING);
+	// Bez okna tekstury zostają w RAM; wymiary i maski kolizji są takie same jak w grze.
+	textureCache().setHeadless(true);
+	Suite suite(filter);
+
+	std::cout << "benchmark                          median (ns/op)    min (ns/op)  iterations     items\n";
+
+	if (suite.selected("anim.")) {
+		for (std::uint64_t clips : { 1000ull, 10000ull }) {
+			AnimationSystem system;
+			std::vector<AnimationClip> handles;
+			handles.reserve(clips);
+			for (std::uint64_t i = 0; i < clips; ++i) {
+				handles.push_back(system.create(6, Config::ANIMATION_UPDATE_TIME));
+			}
+			suite.run("anim.advance/" + std::to_string(clips), clips, [&] {
+				system.advance(1.0f / 60.0f);
+				sink = sink + handles.back().getFrame();
+			});
+		}
+	}
+
+	if (suite.selected("board.") || suite.selected("collision.") || suite.selected("factory.")) {
+		Resources resources;
+		resources.loadTextures();
+		const int windowHeight = Config::DEFAULT_WINDOW_HEIGHT;
+
+		// Szersza plansza mieści więcej przeszkód przed marginesem spawnu.
+		for (int windowWidth : { 1280, 5120, 20480 }) {
+			const std::string name = "board.update/w" + std::to_string(windowWidth);
+			if (!suite.selected(name)) {
+				continue;
+			}
+			Board board(resources);
+			board.setBackgroundType(BackgroundType::DESERT_DAY);
+			board.init(resources.getGreenDinoRun(), windowWidth, windowHeight);
+			// Rozgrzewka trwa tyle, ile przeszkoda potrzebuje na przejście całej planszy - potem jest ich stała liczba.
+			// Stały wynik trzyma prędkość świata w miejscu, więc liczba przeszkód nie zmienia się w trakcie pomiaru.
+			const float span = windowWidth + Config::OBSTACLE_SPAWN_MARGIN - Config::OBSTACLE_DESPAWN_X;
+			const int warmupTicks = static_cast<int>(span / std::max(board.getWorldSpeed(), 1.0f) * 60.0f) + 60;
+			for (int i = 0; i < warmupTicks; ++i) {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			}
+			suite.run(name, board.getObstacles().size(), [&] {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			});
+		}
+
+		// Same boty na wspólnym strumieniu przeszkód - czas na gracza powinien maleć razem z ich liczbą.
+		for (int players : { 1, 8, 64, 1000 }) {
+			const std::string name = "board.players/" + std::to_string(players);
+			if (!suite.selected(name)) {
+				continue;
+			}
+			Board board(resources);
+			board.setPlayers(0, players);
+			board.setBackgroundType(BackgroundType::DESERT_DAY);
+			board.init(resources.getGreenDinoRun(), Config::DEFAULT_WINDOW_WIDTH, windowHeight);
+			for (int i = 0; i < 60; ++i) {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			}
+			suite.run(name, static_cast<std::uint64_t>(players), [&] {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			});
+			// Zderzone boty nie są już aktualizowane - liczba żywych mówi, jaki tłum naprawdę zmierzono.
+			std::cout << name << ": " << board.getAliveCount() << " of " << players << " bots still running\n";
+		}
+
+		// Zapis stanu do gotowego bufora i kopia planszy (zapis + odczyt bez wątku generatora) - bez alokacji.
+		for (int players : { 1, 1000 }) {
+			const std::string suffix = "/" + std::to_string(players);
+			if (!suite.selected("board.snapshot" + suffix) && !suite.selected("board.fork" + suffix)) {
+				continue;
+			}
+			Board board(resources);
+			board.setPlayers(0, players);
+			board.setBackgroundType(BackgroundType::DESERT_DAY);
+			board.init(resources.getGreenDinoRun(), Config::DEFAULT_WINDOW_WIDTH, windowHeight);
+			for (int i = 0; i < 120; ++i) {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			}
+			std::vector<std::uint8_t> buffer(board.getStateBytes());
+			suite.run("board.snapshot" + suffix, 1, [&] {
+				SnapshotWriter out(buffer);
+				sink = sink + static_cast<std::uint64_t>(board.saveState(out));
+			});
+			Board copy(resources);
+			suite.run("board.fork" + suffix, 1, [&] {
+				board.fork(copy);
+				sink = sink + copy.getObstacles().size();
+			});
+			std::cout << "board.snapshot" << suffix << ": " << board.getStateBytes() << " bytes\n";
+		}
+
+		// Tysiąc kopii jednej planszy, np. do przeszukiwania ruchów bota.
+		if (suite.selected("board.clone/1000")) {
+			Board board(resources);
+			board.setBackgroundType(BackgroundType::DESERT_DAY);
+			board.init(resources.getGreenDinoRun(), Config::DEFAULT_WINDOW_WIDTH, windowHeight);
+			for (int i = 0; i < 120; ++i) {
+				board.update(1.0f / 60.0f, windowHeight, 0.0f);
+			}
+			std::vector<std::unique_ptr<Board>> copies;
+			for (int i = 0; i < 1000; ++i) {
+				copies.push_back(std::make_unique<Board>(resources));
+			}
+			suite.run("board.clone/1000", copies.size(), [&] {
+				for (auto& copy : copies) {
+					board.fork(*copy);
+					sink = sink + copy->getObstacles().size();
+				}
+			});
+		}
+
+		if (suite.selected("collision.")) {
+			Board board(resources);
+			board.init(resources.getGreenDinoRun(), Config::DEFAULT_WINDOW_WIDTH, windowHeight);
+			ObstacleFactory factory(resources);
+			std::vector<std::unique_ptr<Obstacle>> obstacles;
+			// Połowa przeszkód nachodzi na gracza, połowa stoi daleko - obie gałęzie testu są mierzone.
+			const float playerX = board.getPlayer().getCollisionRec().x;
+			for (int i = 0; i < 64; ++i) {
+				const float x = i % 2 == 0 ? playerX : playerX + 2000.0f + i * 100.0f;
+				obstacles.push_back(factory.createObstacle(x, static_cast<float>(windowHeight - 65), BackgroundType::DESERT_DAY));
+			}
+			suite.run("collision.obstacle/64", obstacles.size(), [&] {
+				std::uint64_t hits = 0;
+				for (const auto& obstacle : obstacles) {
+					hits += obstacleCollision(*obstacle, board.getPlayer());
+				}
+				sink = sink + hits;
+			});
+		}
+
+		ObstacleFactory factory(resources);
+		for (BackgroundType type : { BackgroundType::DESERT_DAY, BackgroundType::DESERT_NIGHT,
+			BackgroundType::FOREST_DAY, BackgroundType::FOREST_NIGHT }) {
+			suite.run(std::string("factory.create/") + biomeName(type), 1, [&] {
+				auto obstacle = factory.createObstacle(1400.0f, static_cast<float>(windowHeight - 65), type);
+				sink = sink + obstacle->getTexture().id;
+			});
+		}
+
+		resources.unloadTextures();
+	}
+
+	const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+	if (suite.selected("auth.")) {
+		for (std::uint64_t users : { 1000ull, 100000ull }) {
+			const std::filesystem::path path = tempDirectory / ("dino_bench_users_" + std::to_string(users) + ".txt");
+			writeUsersFile(path, users);
+			suite.run("auth.load/" + std::to_string(users), users, [&] {
+				Authorization auth(path.string());
+				sink = sink + 1;
+			});
+			Authorization auth(path.string());
+			const std::string username = "user" + std::to_string(users / 2);
+			const std::string password = "password" + std::to_string(users / 2);
+			suite.run("auth.login/" + std::to_string(users), users, [&] {
+				sink = sink + static_cast<std::uint64_t>(auth.logIn(username, password));
+			});
+			std::filesystem::remove(path);
+		}
+	}
+
+	if (suite.selected("leaderboard.")) {
+		Resources resources;
+		Leaderboard leaderboard(resources);
+		for (std::uint64_t lines : { 1000ull, 100000ull }) {
+			const std::filesystem::path path = tempDirectory / ("dino_bench_scores_" + std::to_string(lines) + ".txt");
+			writeScoresFile(path, lines);
+			suite.run("leaderboard.load/" + std::to_string(lines), lines, [&] {
+				leaderboard.loadScores(path.string());
+				sink = sink + leaderboard.getScoreCount();
+			});
+			std::filesystem::remove(path);
+		}
+	}
+
+	if (suite.selected("ghost.")) {
+		const float deltaTime = 1.0f / 60.0f;
+		const GhostTrace trace = makeGhostTrace(60.0f, deltaTime);
+		GhostRecorder recorder;
+		auto encode = [&] {
+			recorder.begin(1);
+			for (std::size_t i = 0; i < trace.heights.size(); ++i) {
+				recorder.record(deltaTime, trace.heights[i], trace.jumps[i]);
+			}
+			return recorder.finish(0);
+		};
+		const GhostRun run = encode();
+		const std::uint64_t samples = run.getHeader().sampleCount;
+		std::cout << "ghost: " << samples << " samples, " << run.getHeader().jumpCount << " jumps per minute, "
+			<< run.getEncodedSize() << " bytes (raw " << run.getRawSize() << ", per frame "
+			<< trace.heights.size() * sizeof(float) << "), ratio " << std::fixed << std::setprecision(1)
+			<< static_cast<double>(run.getRawSize()) / run.getEncodedSize() << ":1\n";
+		std::cout.unsetf(std::ios::fixed);
+
+		suite.run("ghost.encode/60s", samples, [&] {
+			sink = sink + encode().getEncodedSize();
+		});
+
+		GhostPlayer player;
+		suite.run("ghost.decode/60s", samples, [&] {
+			player.start(run);
+			float sum = 0.f;
+			for (std::size_t i = 0; i < trace.heights.size(); ++i) {
+				sum += player.advance(deltaTime).height;
+			}
+			sink = sink + static_cast<std::uint64_t>(sum);
+		});
+		if (!suite.getResults().empty() && suite.getResults().back().name == "ghost.decode/60s") {
+			const double seconds = suite.getResults().back().nsPerOp * 1e-9;
+			std::cout << "ghost decode: " << std::fixed << std::setprecision(1) << samples / seconds / 1e6 << " Msamples/s, "
+				<< run.getEncodedSize() / seconds / 1e6 << " MB/s, " << std::setprecision(0) << 60.0 / seconds << "x real time\n";
+			std::cout.unsetf(std::ios::fixed);
+		}
+
+		const std::filesystem::path path = tempDirectory / "dino_bench.ghost";
+		if (run.save(path.string())) {
+			suite.run("ghost.load/60s", samples, [&] {
+				GhostRun loaded;
+				sink = sink + static_cast<std::uint64_t>(loaded.load(path.string()));
+			});
+			std::filesystem::remove(path);
+		}
+	}
+
+	if (suite.selected("analytics.")) {
+		const std::filesystem::path path = tempDirectory / "dino_bench_analytics.bin";
+		if (suite.selected("analytics.record")) {
+			// Pełny blok na operację, więc wynik obejmuje też dopisanie bloku do pliku.
+			const std::uint64_t events = static_cast<std::uint64_t>(Config::ANALYTICS_BLOCK_EVENTS);
+			std::filesystem::remove(path);
+			AnalyticsLog log(path.string());
+			log.beginRun(BackgroundType::DESERT_DAY, 1);
+			suite.run("analytics.record/" + std::to_string(events), events, [&] {
+				for (std::uint64_t i = 0; i < events; ++i) {
+					log.recordSpawn(ObstacleKind::STATIC, 400.0f);
+				}
+				log.flushPending();
+				sink = sink + log.getStats().blocks;
+				std::filesystem::resize_file(path, 0);
+			});
+			log.endRun(0.f);
+		}
+		if (suite.selected("analytics.scan")) {
+			const std::uint64_t events = writeAnalyticsFile(path, 1000000);
+			MappedFile mapped;
+			if (mapped.open(path.string())) {
+				suite.run("analytics.scan/1M", events, [&] {
+					AnalyticsSummary summary;
+					scanAnalytics(mapped.get(), mapped.getSize(), summary);
+					sink = sink + summary.deathsByKind[0] + summary.spikes;
+				});
+				if (!suite.getResults().empty() && suite.getResults().back().name == "analytics.scan/1M") {
+					const double seconds = suite.getResults().back().nsPerOp * 1e-9;
+					std::cout << "analytics scan: " << std::fixed << std::setprecision(1) << events / seconds / 1e6 << " Mevents/s, "
+						<< mapped.getSize() / seconds / 1e9 << " GB/s (" << mapped.getSize() / 1e6 << " MB)\n";
+					std::cout.unsetf(std::ios::fixed);
+				}
+				mapped.close();
+			}
+		}
+		std::filesystem::remove(path);
+	}
+
+	if (suite.getResults().empty()) {
+		std::cout << "No benchmark matches filter \"" << filter << "\"\n";
+		return 1;
+	}
+	if (!outputPath.empty()) {
+		if (!writeBenchmarkResults(outputPath, suite.getResults())) {
+			std::cout << "Failed to write " << outputPath << "\n";
+			return 1;
+		}
+		std::cout << "Results written to " << outputPath << "\n";
+	}
+	return 0;
+}
+
+bool writeBenchmarkResults(const std::string& path, const std::vector<BenchmarkResult>& results) {
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	// Jeden wynik w wierszu - pliki dobrze się porównują w systemie kontroli wersji.
+	file << "{\n  \"version\": 1,\n  \"benchmarks\": [\n" << std::setprecision(17);
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const BenchmarkResult& result = results[i];
+		file << "    { \"name\": \"" << result.name << "\""
+			<< ", \"ns_per_op\": " << result.nsPerOp
+			<< ", \"min_ns_per_op\": " << result.minNsPerOp
+			<< ", \"iterations\": " << result.iterations
+			<< ", \"items\": " << result.items << " }"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	file << "  ]\n}\n";
+	return static_cast<bool>(file);
+}
+
+bool readBenchmarkResults(const std::string& path, std::vector<BenchmarkResult>& results) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	const std::string text = buffer.str();
+
+	results.clear();
+	std::size_t pos = 0;
+	while ((pos = text.find("\"name\"", pos)) != std::string::npos) {
+		const std::size_t open = text.find('"', text.find(':', pos) + 1);
+		const std::size_t close = open == std::string::npos ? std::string::npos : text.find('"', open + 1);
+		if (close == std::string::npos) {
+			break;
+		}
+		const std::size_t end = std::min(text.find('}', close), text.size());
+
+		BenchmarkResult result;
+		result.name = text.substr(open + 1, close - open - 1);
+		double value = 0.0;
+		if (readNumber(text, "ns_per_op", close, end, value)) {
+			result.nsPerOp = value;
+			result.minNsPerOp = readNumber(text, "min_ns_per_op", close, end, value) ? value : result.nsPerOp;
+			result.iterations = readNumber(text, "iterations", close, end, value) ? static_cast<std::uint64_t>(value) : 0;
+			result.items = readNumber(text, "items", close, end, value) ? static_cast<std::uint64_t>(value) : 0;
+			results.push_back(std::move(result));
+		}
+		pos = end;
+	}
+	return !results.empty();
+}
+
+bool parseBenchmarkThreshold(std::string_view text, BenchmarkThreshold& out) {
+	const std::size_t equals = text.rfind('=');
+	const std::string prefix(equals == std::string_view::npos ? std::string_view{} : text.substr(0, equals));
+	const std::string number(equals == std::string_view::npos ? text : text.substr(equals + 1));
+	char* end = nullptr;
+	const double percent = std::strtod(number.c_str(), &end);
+	if (number.empty() || end != number.c_str() + number.size() || percent < 0.0) {
+		return false;
+	}
+	out = BenchmarkThreshold{ prefix, percent };
+	return true;
+}
+
+int compareBenchmarks(const std::string& baselinePath, const std::string& currentPath,
+	const std::vector<BenchmarkThreshold>& thresholds) {
+	std::vector<BenchmarkResult> baseline;
+	std::vector<BenchmarkResult> current;
+	if (!readBenchmarkResults(baselinePath, baseline)) {
+		std::cout << "Failed to read benchmark results from " << baselinePath << "\n";
+		return 2;
+	}
+	if (!readBenchmarkResults(currentPath, current)) {
+		std::cout << "Failed to read benchmark results from " << currentPath << "\n";
+		return 2;
+	}
+
+	std::map<std::string, const BenchmarkResult*> baselineByName;
+	for (const BenchmarkResult& result : baseline) {
+		baselineByName[result.name] = &result;
+	}
+
+	int regressions = 0;
+	std::cout << "benchmark                          baseline (ns)    current (ns)   change  limit  status\n";
+	for (const BenchmarkResult& result : current) {
+		// Najdłuższy pasujący prefiks wygrywa, więc "board." może mieć inny próg niż reszta zestawu.
+		double limit = Config::BENCHMARK_THRESHOLD_PERCENT;
+		std::size_t bestPrefix = 0;
+		bool matched = false;
+		for (const BenchmarkThreshold& threshold : thresholds) {
+			if (result.name.starts_with(threshold.prefix) && (!matched || threshold.prefix.size() >= bestPrefix)) {
+				limit = threshold.percent;
+				bestPrefix = threshold.prefix.size();
+				matched = true;
+			}
+		}
+
+		std::cout << std::left << std::setw(34) << result.name << std::right << std::fixed << std::setprecision(1);
+		auto it = baselineByName.find(result.name);
+		if (it == baselineByName.end() || it->second->nsPerOp <= 0.0) {
+			std::cout << std::setw(14) << "-" << std::setw(16) << result.nsPerOp << std::setw(9) << "-"
+				<< std::setw(7) << limit << "  new\n";
+			continue;
+		}
+		const double change = (result.nsPerOp - it->second->nsPerOp) * 100.0 / it->second->nsPerOp;
+		const bool regressed = change > limit;
+		regressions += regressed ? 1 : 0;
+		std::cout << std::setw(14) << it->second->nsPerOp
+			<< std::setw(16) << result.nsPerOp
+			<< std::setw(8) << std::showpos << change << std::noshowpos << "%"
+			<< std::setw(7) << limit
+			<< (regressed ? "  REGRESSION\n" : (change < -limit ? "  faster\n" : "  ok\n"));
+		baselineByName.erase(it);
+	}
+	for (const auto& [name, result] : baselineByName) {
+		std::cout << std::left << std::setw(34) << name << std::right << std::setw(14) << result->nsPerOp << "  missing\n";
+	}
+	std::cout.unsetf(std::ios::fixed);
+
+	std::cout << regressions << " regression(s) in " << current.size() << " benchmark(s)\n";
+	return regressions > 0 ? 1 : 0;
+}
+
+int runBenchmarkCommand(int argc, char* argv[]) {
+	const std::string_view command = argc > 1 ? std::string_view(argv[1]) : std::string_view{};
+	if (command == "--bench") {
+		std::string output = Config::BENCHMARK_FILE;
+		std::string_view filter;
+		for (int i = 2; i < argc; ++i) {
+			std::string_view arg(argv[i]);
+			if (arg.starts_with("--out=")) output = arg.substr(6);
+			else if (arg.starts_with("--filter=")) filter = arg.substr(9);
+			else {
+				std::cout << "Unknown option: " << arg << " (--out=FILE, --filter=PREFIX)\n";
+				return 2;
+			}
+		}
+		return runBenchmarkSuite(output, filter);
+	}
+	if (command == "--bench-compare" && argc > 3) {
+		std::vector<BenchmarkThreshold> thresholds;
+		for (int i = 4; i < argc; ++i) {
+			std::string_view arg(argv[i]);
+			BenchmarkThreshold threshold;
+			if (arg.starts_with("--threshold=") && parseBenchmarkThreshold(arg.substr(12), threshold)) {
+				thresholds.push_back(threshold);
+			}
+			else {
+				std::cout << "Unknown option: " << arg << " (--threshold=PERCENT or --threshold=PREFIX=PERCENT)\n";
+				return 2;
+			}
+		}
+		return compareBenchmarks(argv[2], argv[3], thresholds);
+	}
+	std::cout << "Usage: " << (argc > 0 ? argv[0] : "dino_bench") << " --bench [--out=FILE] [--filter=PREFIX]\n"
+		<< "       " << (argc > 0 ? argv[0] : "dino_bench") << " --bench-compare BASELINE CURRENT [--threshold=[PREFIX=]PERCENT ...]\n";
+	return 2;
+}
@@ -5,14 +5,20 @@
 
 module;
 #include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
 
 module BoardModule;
-import <array>;
-import <vector>;
-import <memory>;
-import <random>;
 import PlayerModule;
-import DustModule;
+import ParticlesModule;
+import AudioModule;
 import BatModule;
 import PterodactylModule;
 import ResourcesModule;
@@ -21,6 +27,65 @@ import ObstacleModule;
 import ObstacleFactoryModule;
 import ConfigModule;
 import ObstacleFactoryModule;
+import DifficultyModule;
+import CollisionMaskModule;
+import ChunkGeneratorModule;
+import DrawListModule;
+import AnalyticsModule;
+import SnapshotModule;
+
+namespace {
+	/**
+	 * @struct BoardStateHeader
+	 * @brief Początek stanu planszy; za nim leżą rekordy graczy, przeszkód, reszta fragmentu trasy i cząsteczki.
+	 */
+	struct BoardStateHeader {
+		std::uint32_t players;
+		std::uint32_t humans;
+		std::uint32_t obstacles;
+		std::uint32_t chunkObstacles;
+		std::uint32_t courseSeed;
+		std::uint32_t background;
+		std::int32_t windowWidth;
+		std::int32_t windowHeight;
+		float lastObstacleX;
+		float chunkMaxSpeed;
+		ChunkCursor chunkNext;
+		DifficultyState difficulty;
+	};
+
+	/**
+	 * @struct PlayerRecord
+	 * @brief Stan gracza na planszy.
+	 */
+	struct PlayerRecord {
+		PlayerState state;
+		float botLead;
+		float dustSpawnTimer;
+		std::uint8_t alive;
+		std::uint8_t wasInAir;
+		std::uint8_t reserved[2];
+	};
+
+	/**
+	 * @struct ObstacleRecord
+	 * @brief Stan przeszkody na planszy.
+	 */
+	struct ObstacleRecord {
+		ObstacleState state;
+		ObstacleSpec spec;
+		std::uint8_t reserved[2];
+	};
+
+	/** @brief Rozszerza obrys tak, by obejmował też drugi obrys. */
+	void coverShape(ObstacleShape& shape, const ObstacleShape& other) {
+		const float right = std::max(shape.left + shape.width, other.left + other.width);
+		shape.left = std::min(shape.left, other.left);
+		shape.width = right - shape.left;
+		shape.top = std::max(shape.top, other.top);
+		shape.bottom = std::min(shape.bottom, other.bottom);
+	}
+}
 
 void Board::setDinoTex(const Texture2D& dinoTex) {
 	selectedDinoTex = dinoTex;
@@ -43,79 +108,572 @@ void Board::init(const Texture2D& dinoTex, int windowWidth, int windowHeight) {
 	this->windowHeight = windowHeight;
 	this->windowWidth = windowWidth;
 
+	humanCount = static_cast<std::size_t>(nextHumans);
+	const std::size_t count = humanCount + static_cast<std::size_t>(nextBots);
+
+	// Jeden gracz biegnie na środku, jak dotąd; kolejne tory rozchodzą się symetrycznie i mieszczą w połowie okna.
 	float playerWidth = (static_cast<float>(selectedDinoTex.width) / selectedDinoFrameCount) * Config::PLAYER_SCALE;
 	float startX = static_cast<float>(windowWidth - playerWidth) / 2.f;
+	const float spacing = count > 1 ? std::min(Config::PLAYER_LANE_SPACING, windowWidth * 0.5f / (count - 1)) : 0.f;
+	const float firstX = startX - spacing * (count - 1) / 2.f;
+
+	players.clear();
+	players.resize(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		players[i].init(selectedDinoTex, firstX + spacing * i, static_cast<float>(windowHeight), Config::PLAYER_SCALE, selectedDinoFrameCount, Config::ANIMATION_UPDATE_TIME);
+		players[i].setSilent(i >= humanCount);
+	}
+	alive.assign(count, 1);
+	impacts.assign(count, NO_IMPACT);
+	impactKinds.assign(count, ObstacleKind::STATIC);
+	playerStartRecs.resize(count);
+	botLeads.assign(count, 0.f);
+	wasInAir.assign(humanCount, 0);
+	dustSpawnTimers.assign(humanCount, 0.f);
+	aliveCount = count;
+	aliveHumans = humanCount;
 
-	player.init(selectedDinoTex, startX, static_cast<float>(windowHeight), Config::PLAYER_SCALE, selectedDinoFrameCount, Config::ANIMATION_UPDATE_TIME);
-	dust.init(resources.getDustRun(), static_cast<float>(windowWidth), static_cast<float>(windowWidth), Config::OBSTACLE_SCALE, Config::DUST_FRAME_COUNT, Config::ANIMATION_UPDATE_TIME); //inicjalizacja w niewidocznym miejscu
+	particles.clear();
+	particles.setTexture(resources.getDustRun(), Config::DUST_FRAME_COUNT, Config::OBSTACLE_SCALE);
+	particles.loadEmitters(Config::PARTICLE_CONFIG_FILE);
 
+	difficulty.reset();
 	lastObstacleX = static_cast<float>(windowWidth);
 	obstacles.clear();
-	spawnObstacle(windowHeight);
+	obstacleSpecs.clear();
+	detached = false;
+	courseSeed = nextCourseSeed != 0 ? nextCourseSeed : std::random_device{}();
+	nextCourseSeed = 0;
+	startChunkGenerator(ChunkCursor{});
+	spawnObstacles(windowHeight);
+
+	// Czas reakcji botów zależy od ziarna trasy, więc ta sama trasa daje ten sam wyścig.
+	std::mt19937 rng(courseSeed);
+	std::uniform_real_distribution<float> lead(Config::BOT_MIN_LEAD, Config::BOT_MAX_LEAD);
+	for (std::size_t i = humanCount; i < count; ++i) {
+		botLeads[i] = lead(rng);
+	}
+}
+
+void Board::setPlayers(int humans, int bots) {
+	nextHumans = std::clamp(humans, 0, Config::MAX_LOCAL_PLAYERS);
+	nextBots = std::clamp(bots, 0, Config::MAX_BOARD_PLAYERS - nextHumans);
+	if (nextHumans + nextBots == 0) {
+		nextHumans = 1;
+	}
 }
 
-void Board::update(float deltaTime, int windowHeight) {
+void Board::update(float deltaTime, int windowHeight, float score) {
 	this->windowHeight = windowHeight;
-	player.update(deltaTime, windowHeight);
+	difficulty.update(deltaTime, score);
+
+	for (std::size_t i = 0; i < players.size(); ++i) {
+		playerStartRecs[i] = players[i].getCollisionRec();
+	}
+	obstacleStartRecs.clear();
+	for (const auto& obstacle : obstacles) {
+		obstacleStartRecs.push_back(obstacle->getCollisionRec());
+	}
+
+	steerBots();
+	for (std::size_t i = 0; i < players.size(); ++i) {
+		if (alive[i]) {
+			players[i].update(deltaTime, windowHeight);
+		}
+	}
 	updateObstacles<Obstacle>(deltaTime);
-	obstacles.erase(
-		std::remove_if(obstacles.begin(), obstacles.end(),
-			[](const auto& obs) {return obs->getPositionX() < -200.f; }),
-		obstacles.end()
-	);
 
-	if (obstacles.empty() || obstacles.back()->getPositionX() < lastObstacleX - getRandomDistance()) {
-		spawnObstacle(windowHeight);
+	detectCollisions();
+
+	lastObstacleX -= difficulty.getWorldSpeed() * deltaTime;
+	// Rodzaje przeszkód są przesuwane razem z nimi, więc usuwanie idzie jedną pętlą po obu wektorach.
+	std::size_t kept = 0;
+	for (std::size_t k = 0; k < obstacles.size(); ++k) {
+		if (obstacles[k]->getPositionX() >= Config::OBSTACLE_DESPAWN_X) {
+			obstacles[kept] = std::move(obstacles[k]);
+			obstacleSpecs[kept] = obstacleSpecs[k];
+			kept++;
+		}
 	}
+	obstacles.resize(kept);
+	obstacleSpecs.resize(kept);
+
+	spawnObstacles(windowHeight);
 
-	dust.update(deltaTime);
+	particles.update(deltaTime);
 
-	if (player.isOnGround(windowHeight)) {
-		dustSpawnTimer += deltaTime;
-		if (dustSpawnTimer >= dustSpawnInterval) {
-			spawnDust(windowHeight);
-			dustSpawnTimer = 0.f;
+	// Pył i dźwięki lądowania tylko dla graczy z klawiatury - setki botów zasypałyby pulę cząsteczek.
+	for (std::size_t i = 0; i < humanCount; ++i) {
+		if (!alive[i]) {
+			continue;
+		}
+		const bool onGround = players[i].isOnGround(windowHeight);
+		if (onGround) {
+			if (wasInAir[i]) {
+				emitAtFeet(EmitterKind::LANDING, windowHeight, i);
+				if (!detached) {
+					audio().play(Sfx::LAND);
+				}
+			}
+			dustSpawnTimers[i] += deltaTime;
+			if (dustSpawnTimers[i] >= dustSpawnInterval) {
+				emitAtFeet(EmitterKind::RUN_DUST, windowHeight, i);
+				dustSpawnTimers[i] = 0.f;
+			}
+		}
+		wasInAir[i] = !onGround;
+	}
+
+	// Gracz, który zderzył się w tym kroku, schodzi z planszy; pozostali biegną dalej.
+	for (std::size_t i = 0; i < players.size(); ++i) {
+		if (!alive[i] || impacts[i] > 1.0f) {
+			continue;
+		}
+		alive[i] = 0;
+		aliveCount--;
+		Rectangle rec = players[i].getCollisionRec();
+		particles.emit(EmitterKind::HIT, rec.x + rec.width, rec.y + rec.height / 2.f);
+		if (i < humanCount) {
+			aliveHumans--;
+			if (!detached) {
+				audio().play(Sfx::HIT);
+				analytics().recordDeath(i, impactKinds[i], difficulty.getWorldSpeed());
+			}
 		}
 	}
 }
 
-void Board::draw() const {
-	drawObstacles<Obstacle>();
-	player.draw();
-	dust.draw();
+void Board::draw(DrawList& list) const {
+	drawObstacles<Obstacle>(list);
+	// Boty pod spodem, gracze z klawiatury na wierzchu.
+	for (std::size_t i = players.size(); i-- > 0;) {
+		if (alive[i]) {
+			players[i].draw(list);
+		}
+	}
+	particles.draw(list);
+}
+
+void Board::updateEffects(float deltaTime) {
+	particles.update(deltaTime);
+}
+
+void Board::drawEffects(DrawList& list) const {
+	particles.draw(list);
+}
 
+ParticleSystem& Board::getParticles() {
+	return particles;
 }
 
 bool Board::checkLoss() const {
-	for (const auto& obstacle : obstacles) {
-		if (obstacleCollision(*obstacle, player)) {
-			return true;
+	return humanCount > 0 ? aliveHumans == 0 : aliveCount == 0;
+}
+
+const Player& Board::getPlayer(std::size_t index) const {
+	return players[index];
+}
+
+const std::vector<std::unique_ptr<Obstacle>>& Board::getObstacles() const {
+	return obstacles;
+}
+
+float Board::getWorldSpeed() const {
+	return difficulty.getWorldSpeed();
+}
+
+void Board::requestJump(std::size_t index, float offset) {
+	if (index < players.size() && alive[index]) {
+		players[index].requestJump(offset);
+	}
+}
+
+void Board::setDifficultyCurve(const DifficultyCurve& curve) {
+	difficulty.setCurve(curve);
+}
+
+std::size_t Board::getStateBytes() const {
+	return sizeof(BoardStateHeader) + players.size() * sizeof(PlayerRecord) + obstacles.size() * sizeof(ObstacleRecord)
+		+ (chunk.obstacles.size() - chunkCursor) * sizeof(ChunkObstacle) + particles.getStateBytes();
+}
+
+bool Board::saveState(SnapshotWriter& out) const {
+	BoardStateHeader header{};
+	header.players = static_cast<std::uint32_t>(players.size());
+	header.humans = static_cast<std::uint32_t>(humanCount);
+	header.obstacles = static_cast<std::uint32_t>(obstacles.size());
+	header.chunkObstacles = static_cast<std::uint32_t>(chunk.obstacles.size() - chunkCursor);
+	header.courseSeed = courseSeed;
+	header.background = static_cast<std::uint32_t>(currentBgType);
+	header.windowWidth = windowWidth;
+	header.windowHeight = windowHeight;
+	header.lastObstacleX = lastObstacleX;
+	header.chunkMaxSpeed = chunk.maxSpeed;
+	header.chunkNext = chunk.next;
+	header.difficulty = difficulty.getState();
+	out.write(header);
+
+	for (std::size_t i = 0; i < players.size(); ++i) {
+		PlayerRecord record{};
+		record.state = players[i].getState();
+		record.botLead = botLeads[i];
+		record.alive = alive[i];
+		if (i < humanCount) {
+			record.dustSpawnTimer = dustSpawnTimers[i];
+			record.wasInAir = wasInAir[i];
 		}
+		out.write(record);
+	}
+	for (std::size_t k = 0; k < obstacles.size(); ++k) {
+		ObstacleRecord record{};
+		record.state = obstacles[k]->getState();
+		record.spec = obstacleSpecs[k];
+		out.write(record);
 	}
-	return false;
+	// Zużyta część fragmentu jest już na planszy, więc zapisujemy tylko przeszkody, które mają się dopiero pojawić.
+	out.writeArray(chunk.obstacles.data() + chunkCursor, header.chunkObstacles);
+	particles.saveState(out);
+	return out.ok();
 }
 
-const Player& Board::getPlayer() const {
-	return player;
+bool Board::restoreState(SnapshotReader& in) {
+	return readState(in, false);
 }
 
-void Board::spawnDust(int windowHeight) {
-	if (!dust.getIsActive()) {
-		Vector2 playerPos = player.getPosition();
-		float dustX = playerPos.x - 20;
-		float dustY = (windowHeight - 65.f) - (dust.getTexture().height * Config::OBSTACLE_SCALE);
-		dust.init(dust.getTexture(), dustX, dustY, Config::OBSTACLE_SCALE, Config::DUST_FRAME_COUNT, Config::ANIMATION_UPDATE_TIME);
+bool Board::fork(Board& target) const {
+	// Bufor należy do kopii, więc tysiące kopii można odświeżać z jednej planszy bez alokacji.
+	const std::size_t bytes = getStateBytes();
+	if (target.forkBuffer.size() < bytes) {
+		target.forkBuffer.resize(bytes);
 	}
+	SnapshotWriter out(target.forkBuffer);
+	if (!saveState(out)) {
+		target.discardState();
+		return false;
+	}
+	target.selectedDinoTex = selectedDinoTex;
+	target.selectedDinoFrameCount = selectedDinoFrameCount;
+	target.dustSpawnInterval = dustSpawnInterval;
+	// Kopia gra według krzywej źródła - także własnej, ustawionej przez setDifficultyCurve().
+	target.difficulty.shareCurve(difficulty);
+	SnapshotReader in(std::span<const std::uint8_t>(target.forkBuffer.data(), out.size()));
+	if (!target.readState(in, true)) {
+		// Odrzucony przed pierwszą zmianą stan zostawiłby w kopii poprzednią planszę - też ją czyścimy.
+		target.discardState();
+		return false;
+	}
+	return true;
 }
 
-void Board::spawnObstacle(int windowHeight) {
-	float startX = lastObstacleX + getRandomDistance();
+bool Board::readState(SnapshotReader& in, bool detach) {
+	BoardStateHeader header{};
+	if (!in.read(header)) {
+		return false;
+	}
+	// Rozmiary sprawdzamy przed pierwszą zmianą planszy - ucięty zapis zostawia ją nietkniętą.
+	const std::size_t needed = header.players * sizeof(PlayerRecord) + header.obstacles * sizeof(ObstacleRecord)
+		+ header.chunkObstacles * sizeof(ChunkObstacle);
+	if (header.players == 0 || header.players > static_cast<std::uint32_t>(Config::MAX_BOARD_PLAYERS)
+		|| header.humans > header.players || header.background > static_cast<std::uint32_t>(BackgroundType::FOREST_NIGHT)
+		|| needed > in.remaining()) {
+		return false;
+	}
+	// Stan trudności odtwarzamy razem ze sprawdzaniem - uszkodzony (np. NaN w czasie) też zostawia planszę nietkniętą.
+	if (!difficulty.setState(header.difficulty)) {
+		return false;
+	}
+
+	const BackgroundType background = static_cast<BackgroundType>(header.background);
+	if (background != currentBgType) {
+		// Przeszkody z innego tła mają inne tekstury - nie nadają się do ponownego użycia.
+		obstacles.clear();
+		currentBgType = background;
+	}
+	windowWidth = header.windowWidth;
+	windowHeight = header.windowHeight;
+	lastObstacleX = header.lastObstacleX;
+	courseSeed = header.courseSeed;
+	detached = detach;
+
+	const std::size_t count = header.players;
+	humanCount = header.humans;
+	if (players.size() != count) {
+		players.clear();
+		players.resize(count);
+		for (Player& player : players) {
+			player.init(selectedDinoTex, 0.f, static_cast<float>(windowHeight), Config::PLAYER_SCALE, selectedDinoFrameCount, Config::ANIMATION_UPDATE_TIME);
+		}
+	}
+	alive.resize(count);
+	impacts.assign(count, NO_IMPACT);
+	impactKinds.assign(count, ObstacleKind::STATIC);
+	playerStartRecs.resize(count);
+	botLeads.resize(count);
+	wasInAir.resize(humanCount);
+	dustSpawnTimers.resize(humanCount);
+	aliveCount = 0;
+	aliveHumans = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		PlayerRecord record{};
+		in.read(record);
+		players[i].setState(record.state);
+		players[i].setSilent(detach || record.state.silent != 0);
+		botLeads[i] = record.botLead;
+		alive[i] = record.alive != 0 ? 1 : 0;
+		aliveCount += alive[i];
+		if (i < humanCount) {
+			dustSpawnTimers[i] = record.dustSpawnTimer;
+			wasInAir[i] = record.wasInAir;
+			aliveHumans += alive[i];
+		}
+	}
+
+	// Przeszkoda tego samego rodzaju na tym samym miejscu dostaje tylko nowy stan - nowe powstają z fabryki.
+	obstacles.resize(header.obstacles);
+	obstacleSpecs.resize(header.obstacles);
+	for (std::size_t k = 0; k < obstacles.size(); ++k) {
+		ObstacleRecord record{};
+		in.read(record);
+		if (record.spec.kind > ObstacleKind::STATIC) {
+			record.spec = ObstacleSpec{};
+		}
+		if (!obstacles[k] || obstacleSpecs[k].kind != record.spec.kind || obstacleSpecs[k].variant != record.spec.variant) {
+			obstacles[k] = obstacleFactory.createObstacle(record.spec, record.state.x, record.state.y, currentBgType);
+		}
+		obstacles[k]->setState(record.state);
+		obstacleSpecs[k] = record.spec;
+	}
+
+	// Fragment zależy tylko od ziarna, numeru i stanu za poprzednim fragmentem, więc generator wznowiony
+	// za zapisanym fragmentem daje dalej tę samą trasę.
+	if (detach) {
+		chunkGenerator.stop();
+	}
+	else {
+		startChunkGenerator(header.chunkNext);
+	}
+	chunk.obstacles.resize(header.chunkObstacles);
+	in.readArray(chunk.obstacles.data(), chunk.obstacles.size());
+	chunk.maxSpeed = header.chunkMaxSpeed;
+	chunk.next = header.chunkNext;
+	chunkCursor = 0;
+
+	if (!particles.restoreState(in) || !in.ok()) {
+		discardState();
+		return false;
+	}
+	return true;
+}
+
+void Board::discardState() {
+	obstacles.clear();
+	obstacleSpecs.clear();
+	chunk.obstacles.clear();
+	chunkCursor = 0;
+	particles.clear();
+	std::fill(alive.begin(), alive.end(), std::uint8_t{ 0 });
+	aliveCount = 0;
+	aliveHumans = 0;
+}
+
+void Board::emitAtFeet(EmitterKind kind, int windowHeight, std::size_t index) {
+	// Pył jest unoszony w lewo razem ze światem, więc zostaje za biegnącym graczem.
+	Rectangle rec = players[index].getCollisionRec();
+	const float halfHeight = resources.getDustRun().height * Config::OBSTACLE_SCALE / 2.f;
+	particles.emit(kind, rec.x + rec.width / 2.f, windowHeight - 65.f - halfHeight, -difficulty.getWorldSpeed());
+}
+
+void Board::steerBots() {
+	const float worldSpeed = difficulty.getWorldSpeed();
+	std::size_t next = 0;
+	for (std::size_t i = humanCount; i < players.size(); ++i) {
+		if (!alive[i]) {
+			continue;
+		}
+		const Rectangle& rec = playerStartRecs[i];
+		// Przeszkoda minięta przez bota jest minięta także przez boty na torach dalej w prawo.
+		while (next < obstacleStartRecs.size() && obstacleStartRecs[next].x + obstacleStartRecs[next].width < rec.x) {
+			++next;
+		}
+		if (next == obstacleStartRecs.size()) {
+			break;
+		}
+		if (obstacleStartRecs[next].x - (rec.x + rec.width) > worldSpeed * botLeads[i]) {
+			continue;
+		}
+		// Pierwszy skok z ziemi, drugi w szczycie pierwszego, tak jak zakłada walidator fragmentów trasy.
+		const Player& bot = players[i];
+		if (bot.isOnGround(windowHeight) || bot.getVerticalVelocity() >= 0.f) {
+			players[i].requestJump();
+		}
+	}
+}
+
+void Board::detectCollisions() {
+	std::fill(impacts.begin(), impacts.end(), NO_IMPACT);
+	playerBatch.clear();
+	batchPlayers.clear();
+	for (std::size_t i = 0; i < players.size(); ++i) {
+		if (alive[i]) {
+			playerBatch.push(playerStartRecs[i], players[i].getCollisionRec());
+			batchPlayers.push_back(static_cast<std::uint32_t>(i));
+		}
+	}
+	if (playerBatch.size() == 0) {
+		return;
+	}
+
+	// Faza szeroka: pełne prostokąty sprite'ów, faza wąska: maski pikseli tylko dla trafionych par.
+	// Przeszkód jest kilka, a graczy może być tysiąc - pętla po przeszkodach sprawdza naraz całą paczkę graczy.
+	for (std::size_t k = 0; k < obstacles.size(); ++k) {
+		if (sweptCollisionBatch(obstacleStartRecs[k], obstacles[k]->getCollisionRec(), playerBatch, 0.f) > 1.0f) {
+			continue;
+		}
+		for (std::size_t j = 0; j < playerBatch.size(); ++j) {
+			if (playerBatch.impact[j] <= 1.0f) {
+				const std::size_t index = batchPlayers[j];
+				const float impact = confirmImpact(k, index, playerBatch.impact[j]);
+				if (impact < impacts[index]) {
+					impacts[index] = impact;
+					impactKinds[index] = obstacleSpecs[k].kind;
+				}
+			}
+		}
+	}
+}
+
+void Board::startChunkGenerator(const ChunkCursor& from) {
+	ChunkSettings settings;
+
+	// Generator sprawdza skoki na obrysach nieprzezroczystych pikseli, tak jak wąska faza kolizji.
+	// Wszyscy gracze mają tę samą teksturę, więc wystarcza kształt pierwszego.
+	const Player& player = players.front();
+	const Rectangle playerRec = player.getCollisionRec();
+	settings.player = { 0.f, playerRec.width, playerRec.height, 0.f };
+	bool masked = false;
+	auto coverPlayer = [&](const Texture2D& texture) {
+		const CollisionMask* playerMask = resources.getCollisionMask(texture);
+		if (playerMask == nullptr || playerMask->isEmpty()) return;
+		const MaskBounds bounds = playerMask->opaqueBounds(playerMask->getWidth() / selectedDinoFrameCount);
+		if (bounds.isEmpty()) return;
+		const float height = static_cast<float>(playerMask->getHeight());
+		const ObstacleShape shape{ static_cast<float>(bounds.left), static_cast<float>(bounds.right - bounds.left),
+			height - bounds.top, height - bounds.bottom };
+		if (masked) {
+			coverShape(settings.player, shape);
+		}
+		else {
+			settings.player = shape;
+			masked = true;
+		}
+	};
+	// Trasa nie może zależeć od skórki gracza ani od tła - duch odtwarza ją z samego ziarna, także
+	// po zmianie skórki lub tła. Fragmenty są więc sprawdzane na obrysach obejmujących wszystkie warianty.
+	coverPlayer(player.getTexture());
+	coverPlayer(resources.getGreenDinoRun());
+	coverPlayer(resources.getBlueDinoRun());
+	coverPlayer(resources.getYellowDinoRun());
+	coverPlayer(resources.getRedDinoRun());
+
+	constexpr BackgroundType BACKGROUNDS[] = { BackgroundType::DESERT_DAY, BackgroundType::DESERT_NIGHT,
+		BackgroundType::FOREST_DAY, BackgroundType::FOREST_NIGHT };
+	auto coverObstacle = [&](const ObstacleSpec& spec) {
+		ObstacleShape& shape = settings.shapes[ChunkSettings::shapeIndex(spec)];
+		shape = obstacleFactory.getShape(spec, BACKGROUNDS[0]);
+		for (BackgroundType background : BACKGROUNDS) {
+			coverShape(shape, obstacleFactory.getShape(spec, background));
+		}
+	};
+	coverObstacle({ ObstacleKind::BAT, 0 });
+	coverObstacle({ ObstacleKind::PTERODACTYL, 0 });
+	for (int variant = 0; variant < Config::STATIC_OBSTACLE_VARIANTS; ++variant) {
+		coverObstacle({ ObstacleKind::STATIC, static_cast<std::uint8_t>(variant) });
+	}
+	// Prędkość i odstępy fragmentu wynikają z krzywej w miejscu trasy, a nie z chwili generowania,
+	// więc to samo ziarno daje te same przeszkody (trasa ducha).
+	settings.seed = courseSeed;
+	settings.curve = difficulty.getCurve();
+
+	chunk = ObstacleChunk{};
+	chunk.next = from;
+	chunkCursor = 0;
+	chunkGenerator.start(settings, from);
+}
+
+void Board::spawnObstacles(int windowHeight) {
+	// Kolejka przeszkód jest wypełniana tylko do marginesu za ekranem, a odstęp nie może spaść
+	// poniżej MIN_OBSTACLE_GAP_FLOOR - liczba przeszkód (i koszt ticku) jest więc ograniczona
+	// niezależnie od prędkości i gęstości.
+	while (lastObstacleX < windowWidth + Config::OBSTACLE_SPAWN_MARGIN) {
+		if (chunkCursor == chunk.obstacles.size()) {
+			// Bez gotowego fragmentu nie czekamy - przeszkoda pojawi się w następnym ticku, z większym odstępem.
+			// Kopia planszy nie ma generatora - po reszcie skopiowanego fragmentu przeszkody się kończą.
+			if (detached || !chunkGenerator.pop(chunk)) {
+				starvedTicks++;
+				return;
+			}
+			chunkCursor = 0;
+			if (difficulty.getWorldSpeed() > chunk.maxSpeed) {
+				staleChunks++;
+			}
+		}
+		spawnObstacle(chunk.obstacles[chunkCursor++], windowHeight);
+	}
+}
+
+void Board::spawnObstacle(const ChunkObstacle& next, int windowHeight) {
+	// Po długiej klatce ostatnia przeszkoda może być już za lewą krawędzią - nowe nigdy nie pojawiają się na ekranie.
+	float startX = std::max(lastObstacleX, static_cast<float>(windowWidth)) + next.gap;
 	float startY = static_cast<float>(windowHeight - 65);
-	obstacles.push_back(obstacleFactory.createObstacle(startX, startY, currentBgType));
+	obstacles.push_back(obstacleFactory.createObstacle(next.spec, startX, startY, currentBgType));
+	obstacleSpecs.push_back(next.spec);
 	lastObstacleX = startX;
+	if (!detached) {
+		analytics().recordSpawn(next.spec.kind, difficulty.getWorldSpeed());
+	}
 }
 
-float Board::getRandomDistance() {
-	std::uniform_real_distribution<float> dis(minObstacleDistance, maxObstacleDistance);
-	return dis(gen);
-}
\ No newline at end of file
+float Board::confirmImpact(std::size_t index, std::size_t playerIndex, float start) const {
+	const Obstacle& obstacle = *obstacles[index];
+	const Player& player = players[playerIndex];
+	const Rectangle playerStart = playerStartRecs[playerIndex];
+	const Rectangle playerEnd = player.getCollisionRec();
+	const Rectangle obstacleStart = obstacleStartRecs[index];
+	const Rectangle obstacleEnd = obstacle.getCollisionRec();
+	const CollisionMask* obstacleMask = resources.getCollisionMask(obstacle.getTexture());
+	const CollisionMask* playerMask = resources.getCollisionMask(player.getTexture());
+
+	if (obstacleMask == nullptr || playerMask == nullptr) {
+		const float padding = 55.0f;
+		auto pad = [padding](Rectangle rec) {
+			return Rectangle{ rec.x + padding, rec.y + padding, rec.width - 2 * padding, rec.height - 2 * padding };
+		};
+		return sweptTimeOfImpact(pad(obstacleStart), pad(obstacleEnd), playerStart, playerEnd);
+	}
+
+	const float relativeX = (obstacleEnd.x - obstacleStart.x) - (playerEnd.x - playerStart.x);
+	const float relativeY = (obstacleEnd.y - obstacleStart.y) - (playerEnd.y - playerStart.y);
+	const float distance = (1.0f - start) * std::sqrt(relativeX * relativeX + relativeY * relativeY);
+	const int steps = std::max(1, static_cast<int>(std::ceil(distance / Config::MASK_SWEEP_STEP)));
+
+	const int obstacleWidth = static_cast<int>(std::lround(obstacleEnd.width));
+	const int obstacleHeight = static_cast<int>(std::lround(obstacleEnd.height));
+	const int playerWidth = static_cast<int>(std::lround(playerEnd.width));
+	const int playerHeight = static_cast<int>(std::lround(playerEnd.height));
+
+	for (int step = 0; step <= steps; ++step) {
+		const float t = start + (1.0f - start) * static_cast<float>(step) / static_cast<float>(steps);
+		MaskView obstacleView{ obstacleMask,
+			static_cast<int>(std::lround(obstacleStart.x + (obstacleEnd.x - obstacleStart.x) * t)),
+			static_cast<int>(std::lround(obstacleStart.y + (obstacleEnd.y - obstacleStart.y) * t)),
+			obstacle.getFrame() * obstacleWidth, obstacleWidth, obstacleHeight };
+		MaskView playerView{ playerMask,
+			static_cast<int>(std::lround(playerStart.x + (playerEnd.x - playerStart.x) * t)),
+			static_cast<int>(std::lround(playerStart.y + (playerEnd.y - playerStart.y) * t)),
+			player.getFrame() * playerWidth, playerWidth, playerHeight };
+		if (masksOverlap(obstacleView, playerView)) {
+			return t;
+		}
+	}
+	return NO_IMPACT;
+}
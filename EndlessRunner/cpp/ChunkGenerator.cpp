@@ -0,0 +1,282 @@
+﻿/**
+ * @file ChunkGenerator.cpp
+ * @brief Implementacja walidatora skoków i generatora fragmentów trasy.
+ */
+
+module;
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+module ChunkGeneratorModule;
+
+namespace {
+	/** @brief Liczba prędkości z przedziału [v, v * (1 + CHUNK_SPEED_HEADROOM)], dla których sprawdzany jest fragment. */
+	constexpr int SPEED_SAMPLES = 3;
+
+	/** @brief Wysokość pojedynczego skoku z ziemi. */
+	constexpr double singleJumpHeight() {
+		return static_cast<double>(Config::JUMP_VELOCITY) * Config::JUMP_VELOCITY / (2.0 * Config::GRAVITY);
+	}
+
+	/** @brief Czas wznoszenia pojedynczego skoku. */
+	constexpr double riseTime() {
+		return -static_cast<double>(Config::JUMP_VELOCITY) / Config::GRAVITY;
+	}
+}
+
+JumpValidator::JumpValidator(const ObstacleShape& playerShape, float worldSpeed)
+	: player(playerShape), speed(std::max(static_cast<double>(worldSpeed), 1.0)) {}
+
+bool JumpValidator::clearInterval(int jumps, double height, double& enter, double& leave) {
+	const double jumpHeight = singleJumpHeight();
+	const double peak = jumps * jumpHeight;
+	if (height > peak) {
+		return false;
+	}
+	if (height <= 0.0) {
+		enter = 0.0;
+		leave = flightTime(jumps);
+		return true;
+	}
+	// Skok k+1 zaczyna się w szczycie skoku k, na wysokości k * jumpHeight, z pełną prędkością wybicia.
+	const int stage = std::min(static_cast<int>(height / jumpHeight), jumps - 1);
+	const double rest = height - stage * jumpHeight;
+	const double velocity = -static_cast<double>(Config::JUMP_VELOCITY);
+	const double root = std::sqrt(std::max(0.0, velocity * velocity - 2.0 * Config::GRAVITY * rest));
+	enter = stage * riseTime() + (velocity - root) / Config::GRAVITY;
+	leave = jumps * riseTime() + std::sqrt(2.0 * (peak - height) / Config::GRAVITY);
+	return true;
+}
+
+double JumpValidator::flightTime(int jumps) {
+	return jumps * riseTime() + std::sqrt(2.0 * jumps * singleJumpHeight() / Config::GRAVITY);
+}
+
+double JumpValidator::landing() const {
+	double earliest = std::numeric_limits<double>::max();
+	for (int j = 0; j < Config::MAX_JUMPS; ++j) {
+		if (flight[j].lo <= flight[j].hi) {
+			earliest = std::min(earliest, flight[j].lo + flightTime(j + 1));
+		}
+	}
+	return earliest + Config::CHUNK_LANDING_SLACK;
+}
+
+bool JumpValidator::append(double x, const ObstacleShape& shape) {
+	// Przedział, w którym obrys przeszkody zachodzi na kolumnę gracza.
+	const double enter = (x + shape.left - player.width) / speed;
+	const double leave = (x + shape.left + shape.width) / speed;
+
+	if (shape.bottom >= player.top + Config::CHUNK_HEIGHT_MARGIN) {
+		// Gracz mija przeszkodę po ziemi: musi wylądować, zanim przeszkoda nadleci, i poczekać, aż minie.
+		const double ready = open ? landing() : readyAt;
+		if (ready > enter) {
+			return false;
+		}
+		readyAt = std::max(ready, leave);
+		open = false;
+		return true;
+	}
+
+	const double height = shape.top + Config::CHUNK_HEIGHT_MARGIN - player.bottom;
+	if (height <= 0.0 || shape.width <= 0.f) {
+		return true;
+	}
+
+	std::array<Window, Config::MAX_JUMPS> windows{};
+	for (int j = 0; j < Config::MAX_JUMPS; ++j) {
+		double above = 0.0;
+		double below = 0.0;
+		if (clearInterval(j + 1, height, above, below) && leave - enter <= below - above) {
+			windows[j] = { leave - below, enter - above };
+		}
+	}
+
+	auto anyOpen = [](const std::array<Window, Config::MAX_JUMPS>& candidate) {
+		return std::any_of(candidate.begin(), candidate.end(), [](const Window& w) { return w.lo <= w.hi; });
+	};
+
+	if (open) {
+		std::array<Window, Config::MAX_JUMPS> merged{};
+		for (int j = 0; j < Config::MAX_JUMPS; ++j) {
+			merged[j] = { std::max(flight[j].lo, windows[j].lo), std::min(flight[j].hi, windows[j].hi) };
+		}
+		if (anyOpen(merged)) {
+			flight = merged;
+			return true;
+		}
+	}
+
+	// Nowy lot: wybicie nie wcześniej niż po wylądowaniu z poprzedniego.
+	const double ready = open ? landing() : readyAt;
+	for (Window& window : windows) {
+		window.lo = std::max(window.lo, ready);
+	}
+	if (!anyOpen(windows)) {
+		return false;
+	}
+	readyAt = ready;
+	flight = windows;
+	open = true;
+	return true;
+}
+
+double JumpValidator::closeFlight() {
+	if (open) {
+		readyAt = landing();
+		open = false;
+	}
+	return readyAt * speed;
+}
+
+void JumpValidator::restartAt(double readyX) {
+	readyAt = readyX / speed;
+	open = false;
+}
+
+ChunkGenerator::~ChunkGenerator() {
+	stop();
+}
+
+void ChunkGenerator::start(const ChunkSettings& runSettings, const ChunkCursor& from) {
+	stop();
+	settings = runSettings;
+	if (!settings.curve) {
+		settings.curve = std::make_shared<const DifficultyCurve>();
+	}
+	cursor = from;
+	for (ObstacleChunk& chunk : queue) {
+		chunk = ObstacleChunk{};
+	}
+	queueHead.store(0, std::memory_order_relaxed);
+	queueTail.store(0, std::memory_order_relaxed);
+	stopping.store(false, std::memory_order_relaxed);
+	worker = std::thread(&ChunkGenerator::run, this);
+}
+
+void ChunkGenerator::stop() {
+	if (!worker.joinable()) {
+		return;
+	}
+	stopping.store(true, std::memory_order_relaxed);
+	wakeups.fetch_add(1, std::memory_order_release);
+	wakeups.notify_one();
+	worker.join();
+}
+
+bool ChunkGenerator::pop(ObstacleChunk& out) {
+	const std::uint32_t tail = queueTail.load(std::memory_order_relaxed);
+	if (tail == queueHead.load(std::memory_order_acquire)) {
+		return false;
+	}
+	out = std::move(queue[tail % QUEUE_SIZE]);
+	queueTail.store(tail + 1, std::memory_order_release);
+	wakeups.fetch_add(1, std::memory_order_release);
+	wakeups.notify_one();
+	return true;
+}
+
+void ChunkGenerator::run() {
+	while (!stopping.load(std::memory_order_relaxed)) {
+		// Licznik czytamy przed sprawdzeniem kolejki - zdjęcie fragmentu w międzyczasie zmieni go i wait() nie zaśnie.
+		const std::uint32_t seen = wakeups.load(std::memory_order_acquire);
+		const std::uint32_t head = queueHead.load(std::memory_order_relaxed);
+		if (head - queueTail.load(std::memory_order_acquire) >= QUEUE_SIZE) {
+			wakeups.wait(seen, std::memory_order_acquire);
+			continue;
+		}
+		queue[head % QUEUE_SIZE] = generate();
+		queueHead.store(head + 1, std::memory_order_release);
+	}
+}
+
+ObstacleChunk ChunkGenerator::generate() {
+	// Trudność w miejscu trasy, w którym zaczyna się fragment - gracz dobiega tam nieco później, przy prędkości
+	// pokrytej zapasem CHUNK_SPEED_HEADROOM. Własne ziarno fragmentu sprawia, że odrzucone losowania
+	// nie przesuwają losowań kolejnych fragmentów.
+	const DifficultyKey level = settings.curve->sampleAtDistance(cursor.x);
+	const float worldSpeed = std::max(level.speed, 1.0f);
+	const float gapMin = level.minGap;
+	const float gapMax = std::max(level.maxGap, gapMin);
+	std::seed_seq chunkSeed{ settings.seed, static_cast<std::uint32_t>(cursor.index), static_cast<std::uint32_t>(cursor.index >> 32) };
+	gen.seed(chunkSeed);
+	double x = cursor.x;
+
+	ObstacleChunk chunk;
+	chunk.maxSpeed = worldSpeed * (1.0f + Config::CHUNK_SPEED_HEADROOM);
+	chunk.obstacles.reserve(Config::CHUNK_OBSTACLES);
+
+	// Prędkość w chwili, gdy gracz dobiegnie do fragmentu, jest nieznana - fragment musi przejść przy kilku z zapasem.
+	std::vector<JumpValidator> lanes;
+	for (int i = 0; i < SPEED_SAMPLES; ++i) {
+		const float sample = worldSpeed * (1.0f + Config::CHUNK_SPEED_HEADROOM * i / (SPEED_SAMPLES - 1));
+		lanes.emplace_back(settings.player, sample);
+		lanes.back().restartAt(cursor.readyX);
+	}
+
+	// Odstęp, po którym gracz na pewno zdąży wylądować po najdłuższym locie i wybić się ponownie.
+	float widest = 0.f;
+	for (const ObstacleShape& shape : settings.shapes) {
+		widest = std::max(widest, shape.left + shape.width);
+	}
+	const float safeGap = std::max(gapMax, static_cast<float>(chunk.maxSpeed
+		* (2.0 * JumpValidator::flightTime(Config::MAX_JUMPS) + Config::CHUNK_LANDING_SLACK)) + settings.player.width + widest);
+
+	std::uniform_real_distribution<float> gapDis(gapMin, gapMax);
+	for (int n = 0; n < Config::CHUNK_OBSTACLES; ++n) {
+		bool placed = false;
+		for (int attempt = 0; attempt < Config::CHUNK_MAX_ATTEMPTS && !placed; ++attempt) {
+			const ObstacleSpec spec = rollObstacleSpec(gen);
+			// Druga połowa prób rozsuwa przeszkody tak, by każdą dało się pokonać osobnym skokiem.
+			const float gap = attempt < Config::CHUNK_MAX_ATTEMPTS / 2 ? gapDis(gen) : safeGap + (gapDis(gen) - gapMin);
+			const double candidate = x + gap;
+			const ObstacleShape& shape = settings.shapes[ChunkSettings::shapeIndex(spec)];
+
+			std::vector<JumpValidator> trial = lanes;
+			placed = std::all_of(trial.begin(), trial.end(), [&](JumpValidator& lane) { return lane.append(candidate, shape); });
+			if (placed) {
+				lanes = std::move(trial);
+				chunk.obstacles.push_back({ spec, gap });
+				x = candidate;
+			}
+			else {
+				chunk.rejected++;
+			}
+		}
+		if (!placed) {
+			// Żaden kształt nie przechodzi (np. skrajne parametry krzywej) - wstawiamy przeszkodę rozsuniętą
+			// na bezpieczny odstęp i zaczynamy sprawdzanie za nią od nowa.
+			const ObstacleSpec spec = rollObstacleSpec(gen);
+			const ObstacleShape& shape = settings.shapes[ChunkSettings::shapeIndex(spec)];
+			x += safeGap;
+			chunk.obstacles.push_back({ spec, safeGap });
+			for (JumpValidator& lane : lanes) {
+				lane.restartAt(x + shape.left + shape.width);
+			}
+			chunk.unsolved++;
+		}
+	}
+
+	// Lot nie przechodzi przez granicę fragmentów - następny zaczyna się po najpóźniejszym lądowaniu.
+	double readyX = std::numeric_limits<double>::lowest();
+	for (JumpValidator& lane : lanes) {
+		readyX = std::max(readyX, lane.closeFlight());
+	}
+	cursor = { cursor.index + 1, x, readyX };
+	chunk.next = cursor;
+
+	chunks.fetch_add(1, std::memory_order_relaxed);
+	rejected.fetch_add(chunk.rejected, std::memory_order_relaxed);
+	unsolved.fetch_add(chunk.unsolved, std::memory_order_relaxed);
+	return chunk;
+}
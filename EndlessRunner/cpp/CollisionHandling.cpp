@@ -0,0 +1,106 @@
+﻿/**
+ * @file CollisionHandling.cpp
+ * @brief Implementacja ciągłego wykrywania kolizji (swept AABB).
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+module CollisionHandlingModule;
+
+/**
+ * @brief Wyznacza przedział czasu, w którym rzuty dwóch prostokątów na jedną oś się pokrywają.
+ *
+ * Prostokąt A porusza się względem B: offset(t) = offset + t * motion. Rzuty pokrywają się, gdy
+ * -extentA < offset(t) < extentB.
+ *
+ * @param offset Różnica pozycji A - B na początku kroku.
+ * @param motion Przesunięcie A względem B w trakcie kroku.
+ * @param extentA Rozmiar A na tej osi.
+ * @param extentB Rozmiar B na tej osi.
+ * @param enter Zwraca początek przedziału.
+ * @param exit Zwraca koniec przedziału.
+ */
+static inline void sweepAxis(float offset, float motion, float extentA, float extentB, float& enter, float& exit) {
+	// Zamiast dzielenia przez zero przy braku ruchu względnego używamy minimalnego przesunięcia o tym samym znaku.
+	// Przedział staje się wtedy (-inf, inf) albo pusty, a pętla nie zawiera rozgałęzień i daje się zwektoryzować.
+	const float divisor = std::copysign(std::max(std::abs(motion), 1e-6f), motion);
+	// Przedział liczony od środka: przy ujemnej sumie rozmiarów (np. duży padding) wychodzi pusty, tak jak w CheckCollisionRecs.
+	const float center = ((extentB - extentA) * 0.5f - offset) / divisor;
+	const float halfLength = (extentA + extentB) * 0.5f / std::abs(divisor);
+	enter = center - halfLength;
+	exit = center + halfLength;
+}
+
+/**
+ * @brief Łączy przedziały obu osi z krokiem [0, 1].
+ * @return Moment wejścia w kolizję lub NO_IMPACT.
+ */
+static inline float resolveImpact(float enterX, float exitX, float enterY, float exitY) {
+	const float enter = std::max(std::max(enterX, enterY), 0.0f);
+	const float exit = std::min(std::min(exitX, exitY), 1.0f);
+	return enter < exit ? enter : NO_IMPACT;
+}
+
+float sweptTimeOfImpact(const Rectangle& startA, const Rectangle& endA, const Rectangle& startB, const Rectangle& endB) {
+	float enterX, exitX, enterY, exitY;
+	sweepAxis(startA.x - startB.x, (endA.x - startA.x) - (endB.x - startB.x), endA.width, endB.width, enterX, exitX);
+	sweepAxis(startA.y - startB.y, (endA.y - startA.y) - (endB.y - startB.y), endA.height, endB.height, enterY, exitY);
+	return resolveImpact(enterX, exitX, enterY, exitY);
+}
+
+void SweptBatch::clear() {
+	startX.clear();
+	startY.clear();
+	endX.clear();
+	endY.clear();
+	width.clear();
+	height.clear();
+	impact.clear();
+}
+
+void SweptBatch::push(const Rectangle& start, const Rectangle& end) {
+	startX.push_back(start.x);
+	startY.push_back(start.y);
+	endX.push_back(end.x);
+	endY.push_back(end.y);
+	width.push_back(end.width);
+	height.push_back(end.height);
+	impact.push_back(NO_IMPACT);
+}
+
+float sweptCollisionBatch(const Rectangle& playerStart, const Rectangle& playerEnd, SweptBatch& batch, float padding) {
+	const std::size_t count = batch.size();
+	const float* __restrict sx = batch.startX.data();
+	const float* __restrict sy = batch.startY.data();
+	const float* __restrict ex = batch.endX.data();
+	const float* __restrict ey = batch.endY.data();
+	const float* __restrict w = batch.width.data();
+	const float* __restrict h = batch.height.data();
+	float* __restrict out = batch.impact.data();
+
+	// Kopie lokalne - inaczej kompilator musi zakładać, że zapis do out może zmienić dane gracza.
+	const float playerX = playerStart.x;
+	const float playerY = playerStart.y;
+	const float playerMoveX = playerEnd.x - playerStart.x;
+	const float playerMoveY = playerEnd.y - playerStart.y;
+	const float playerWidth = playerEnd.width;
+	const float playerHeight = playerEnd.height;
+
+	for (std::size_t i = 0; i < count; ++i) {
+		float enterX, exitX, enterY, exitY;
+		sweepAxis(sx[i] + padding - playerX, (ex[i] - sx[i]) - playerMoveX, w[i] - 2 * padding, playerWidth, enterX, exitX);
+		sweepAxis(sy[i] + padding - playerY, (ey[i] - sy[i]) - playerMoveY, h[i] - 2 * padding, playerHeight, enterY, exitY);
+		out[i] = resolveImpact(enterX, exitX, enterY, exitY);
+	}
+
+	float earliest = NO_IMPACT;
+	for (std::size_t i = 0; i < count; ++i) {
+		earliest = std::min(earliest, out[i]);
+	}
+	return earliest;
+}
@@ -0,0 +1,118 @@
+﻿/**
+ * @file CollisionMask.cpp
+ * @brief Implementacja bitowych masek kolizji.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+module CollisionMaskModule;
+
+CollisionMask CollisionMask::fromImage(const Image& image, int scale, unsigned char alphaThreshold) {
+	CollisionMask mask;
+	if (image.data == nullptr || image.width <= 0 || image.height <= 0 || scale <= 0) {
+		return mask;
+	}
+
+	Color* pixels = LoadImageColors(image);
+	if (pixels == nullptr) {
+		return mask;
+	}
+
+	mask.width = image.width * scale;
+	mask.height = image.height * scale;
+	mask.wordsPerRow = (mask.width + 63) / 64;
+	mask.rows.assign(static_cast<std::size_t>(mask.wordsPerRow) * mask.height, 0);
+
+	for (int y = 0; y < image.height; ++y) {
+		// Budujemy jeden przeskalowany wiersz i kopiujemy go scale razy w pionie.
+		std::uint64_t* row = &mask.rows[static_cast<std::size_t>(y) * scale * mask.wordsPerRow];
+		for (int x = 0; x < image.width; ++x) {
+			if (pixels[y * image.width + x].a < alphaThreshold) continue;
+			for (int bit = x * scale; bit < (x + 1) * scale; ++bit) {
+				row[bit >> 6] |= std::uint64_t{ 1 } << (bit & 63);
+			}
+		}
+		for (int copy = 1; copy < scale; ++copy) {
+			std::copy(row, row + mask.wordsPerRow, row + copy * mask.wordsPerRow);
+		}
+	}
+
+	UnloadImageColors(pixels);
+	return mask;
+}
+
+std::uint64_t CollisionMask::extractWord(int row, int column) const {
+	if (row < 0 || row >= height || column >= width || column <= -64) {
+		return 0;
+	}
+	const std::uint64_t* words = &rows[static_cast<std::size_t>(row) * wordsPerRow];
+
+	if (column < 0) {
+		return words[0] << -column;
+	}
+	const int index = column >> 6;
+	const int shift = column & 63;
+	std::uint64_t word = words[index] >> shift;
+	if (shift != 0 && index + 1 < wordsPerRow) {
+		word |= words[index + 1] << (64 - shift);
+	}
+	return word;
+}
+
+MaskBounds CollisionMask::opaqueBounds(int frameWidth) const {
+	if (frameWidth <= 0 || frameWidth > width) {
+		frameWidth = width;
+	}
+	MaskBounds bounds{ frameWidth, height, 0, 0 };
+	for (int y = 0; y < height; ++y) {
+		const std::uint64_t* words = &rows[static_cast<std::size_t>(y) * wordsPerRow];
+		for (int w = 0; w < wordsPerRow; ++w) {
+			std::uint64_t word = words[w];
+			while (word != 0) {
+				const int column = (w << 6) + std::countr_zero(word);
+				word &= word - 1;
+				const int local = column % frameWidth;
+				bounds.left = std::min(bounds.left, local);
+				bounds.right = std::max(bounds.right, local + 1);
+				bounds.top = std::min(bounds.top, y);
+				bounds.bottom = std::max(bounds.bottom, y + 1);
+			}
+		}
+	}
+	return bounds.isEmpty() ? MaskBounds{} : bounds;
+}
+
+bool masksOverlap(const MaskView& a, const MaskView& b) {
+	if (a.mask == nullptr || b.mask == nullptr) {
+		return false;
+	}
+
+	const int left = std::max(a.x, b.x);
+	const int right = std::min(a.x + a.width, b.x + b.width);
+	const int top = std::max(a.y, b.y);
+	const int bottom = std::min(a.y + a.height, b.y + b.height);
+	if (left >= right || top >= bottom) {
+		return false;
+	}
+
+	const int columnA = a.sourceX + (left - a.x);
+	const int columnB = b.sourceX + (left - b.x);
+	for (int y = top; y < bottom; ++y) {
+		const int rowA = y - a.y;
+		const int rowB = y - b.y;
+		for (int offset = 0; offset < right - left; offset += 64) {
+			const int remaining = right - left - offset;
+			// Bity spoza części wspólnej należą do sąsiedniej klatki arkusza - trzeba je wyciąć.
+			const std::uint64_t valid = remaining >= 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << remaining) - 1;
+			if (a.mask->extractWord(rowA, columnA + offset) & b.mask->extractWord(rowB, columnB + offset) & valid) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
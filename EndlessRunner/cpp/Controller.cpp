@@ -5,33 +5,159 @@
 
 module;
 #include "raylib.h"
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <filesystem>
 #include <fstream>
 #include <random>
+#include <span>
 #include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 module ControllerModule;
 
+import PresenterModule;
+import AnalyticsModule;
+import DrawListModule;
+import FramePipelineModule;
+import GhostModule;
+import InputModule;
+import PlayerModule;
+import RecordLogModule;
+import ScoreServiceModule;
+import SnapshotModule;
+
+namespace {
+	/** @brief Sygnatura zapisanego stanu gry. */
+	constexpr char SNAPSHOT_MAGIC[4] = { 'D', 'R', 'S', 'N' };
+
+	/** @brief Flaga wznowienia zapisanej rozgrywki przy najbliższym wejściu do gry. */
+	bool resumeRequested = false;
+
+	/**
+	 * @struct ControllerState
+	 * @brief Stan sceny gry w zapisie; za nim leżą wyniki graczy i stan planszy.
+	 */
+	struct ControllerState {
+		float score;
+		float bgX;
+		float mgX;
+		float fgX;
+		float groundX;
+		std::uint32_t playerScores;
+		std::uint32_t background;
+		std::uint8_t gameOver;
+		std::uint8_t reserved[3];
+	};
+
+	/**
+	 * @brief Czyta nagłówek i stan sceny z zapisu.
+	 * @param data Zapisany stan.
+	 * @param header Miejsce na nagłówek.
+	 * @param state Miejsce na stan sceny.
+	 * @param in Odczyt ustawiony za stanem sceny.
+	 * @return False, jeśli zapis ma inny format lub rozmiar.
+	 */
+	bool readControllerState(std::span<const std::uint8_t> data, SnapshotHeader& header, ControllerState& state, SnapshotReader& in) {
+		return in.read(header) && std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+			&& header.version == SNAPSHOT_VERSION && header.bytes == data.size() && in.read(state)
+			&& state.playerScores <= static_cast<std::uint32_t>(Config::MAX_LOCAL_PLAYERS)
+			&& state.background <= static_cast<std::uint32_t>(BackgroundType::FOREST_NIGHT);
+	}
+
+	/**
+	 * @brief Wczytuje zapisany stan gry.
+	 * @param path Ścieżka pliku.
+	 * @param out Bufor na zawartość pliku.
+	 * @return False, jeśli pliku nie ma lub nie da się go przeczytać.
+	 */
+	bool loadSnapshotFile(const std::string& path, std::vector<std::uint8_t>& out) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) {
+			std::cout << "No saved game in " << path << "\n";
+			return false;
+		}
+		out.resize(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0);
+		if (!file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+			std::cout << "Cannot read saved game " << path << "\n";
+			return false;
+		}
+		return true;
+	}
+}
+
 void Controller::saveScore() {
-	if (username.empty() || savedScore) return;
-	std::ofstream file("scores.txt", std::ios::app);
-	if (file.is_open()) {
-		file << username << ":" << static_cast<int>(score) << "\n";
-		file.close();
+	if (username.empty() || savedScore || playerScores.empty()) return;
+	// Zalogowany użytkownik gra jako pierwszy gracz; pozostali gracze na wspólnej klawiaturze nie mają kont.
+	const int playerScore = static_cast<int>(playerScores.front());
+	// Działający demon wyników sam dopisuje wynik do pliku i od razu uwzględnia go w rankingu.
+	ScoreClient client;
+	switch (client.submit(username, playerScore)) {
+	case SubmitResult::STORED:
+		savedScore = true;
+		return;
+	case SubmitResult::UNKNOWN:
+		// Demon dostał wynik, ale nie zdążył odpowiedzieć - mógł go już zapisać, więc dopisanie go tutaj
+		// groziłoby podwójnym wpisem. Wolimy ewentualnie stracić ten jeden wynik.
+		std::cout << "Score daemon did not answer in time, the score may not have been saved\n";
+		savedScore = true;
+		return;
+	case SubmitResult::REJECTED:
+	case SubmitResult::UNSENT:
+		break;
+	}
+	// Bez demona rekord jest dopisywany jednym zapisem pod blokadą, więc inne instancje gry nie przerwą wiersza.
+	if (RecordLog(Config::SCORES_FILE).append(username + ":" + std::to_string(playerScore)) == AppendResult::WRITTEN) {
 		savedScore = true;
 	}
 	else {
-		std::cout << "Failed to open scores.txt for writing\n";
+		std::cout << "Failed to append to " << Config::SCORES_FILE << "\n";
 	}
 }
 
+void Controller::saveGhost() {
+	savedGhost = true;
+	if (!recordGhost) return;
+	// Każdy gracz ma jeden plik z najlepszym przebiegiem - nagłówek wystarcza, żeby porównać wyniki.
+	GhostRun run = ghostRecorder.finish(static_cast<int>(score));
+	const std::string path = ghostPath(username);
+	GhostHeader best{};
+	if (readGhostHeader(path, best) && best.score >= run.getScore()) return;
+	if (run.save(path)) {
+		std::cout << "New ghost for " << username << ": " << run.getEncodedSize() << " bytes for "
+			<< run.getDuration() << " s\n";
+	}
+}
 
-void Controller::run() {
+void Controller::enter(SceneManager& scenes) {
 	std::random_device rd;
 	std::mt19937 gen(rd());
 	std::uniform_int_distribution<> dis(0, 3);
 	int backgroundChoice = dis(gen);
 
+	// Wznowiona rozgrywka wraca do tła z zapisu; plansza jest przywracana po init().
+	bool resuming = false;
+	if (persistent && resumeRequested) {
+		resumeRequested = false;
+		if (loadSnapshotFile(Config::SNAPSHOT_FILE, snapshotBuffer)) {
+			SnapshotReader in(snapshotBuffer);
+			SnapshotHeader header{};
+			ControllerState state{};
+			resuming = readControllerState(snapshotBuffer, header, state, in);
+			if (resuming) {
+				backgroundChoice = static_cast<int>(state.background);
+			}
+			else {
+				std::cout << "Saved game " << Config::SNAPSHOT_FILE << " has unsupported format\n";
+			}
+		}
+	}
+
 	BackgroundType bgType;
 	switch (backgroundChoice) {
 	case 0: // Pustynia dzienna
@@ -41,7 +167,7 @@ void Controller::run() {
 		groundTexture = resources.getDesertGround();
 		bgType = BackgroundType::DESERT_DAY;
 		break;
-	case 1: // Pustynia noc
+	case 1: // Pustynia nocą
 		bgTexture = resources.getDesertNightBackground();
 		mgTexture = resources.getDesertNightMidground();
 		fgTexture = resources.getDesertNightForeground();
@@ -55,7 +181,7 @@ void Controller::run() {
 		groundTexture = resources.getForestGround();
 		bgType = BackgroundType::FOREST_DAY;
 		break;
-	case 3: // Las noc
+	case 3: // Las nocą
 		bgTexture = resources.getForestNightBackground();
 		mgTexture = resources.getForestNightMidground();
 		fgTexture = resources.getForestNightForeground();
@@ -70,59 +196,314 @@ void Controller::run() {
 		break;
 	}
 
-	board.setBackgroundType(bgType);
-	board.init(resources.getGreenDinoRun(), GetScreenWidth(), GetScreenHeight());
-	SetTargetFPS(60);
+	// W trybie stałej rozdzielczości świat ma zawsze ten sam rozmiar logiczny, niezależnie od okna.
+	windowWidth = presenter().getWorldWidth();
+	windowHeight = presenter().getWorldHeight();
 
-	while (!WindowShouldClose()) {
-		float dt = GetFrameTime();
+	// Symulacja czyta tekstury tylko z pól sceny - mapa zasobów nie jest dotykana z wątku symulacji.
+	heartIcon = resources.getHeartIcon();
+	lifeLostIcon = resources.getLifeLostIcon();
+	numbersTexture = resources.getNumbersTexture();
 
-		BeginDrawing();
-		ClearBackground(BLACK);
+	// Duch biegnie po trasie swojego przebiegu, więc plansza dostaje jego ziarno.
+	// Duch to najlepszy przebieg jednego gracza - w grze wieloosobowej nie jest ani odtwarzany, ani nagrywany.
+	// Wznowiona rozgrywka nie zaczyna się od startu trasy, więc też nie.
+	ghostPlayer.stop();
+	ghostHeight = 0.f;
+	savedGhost = false;
+	recordGhost = !resuming && ghostsEnabled() && !username.empty() && board.getNextPlayerCount() == 1;
+	const bool hasGhost = recordGhost && ghost.load(ghostPath(username)) && !ghost.isEmpty();
+	if (hasGhost) {
+		board.setCourseSeed(ghost.getSeed());
+	}
 
-		scrollBackground(dt, GetScreenWidth(), GetScreenHeight());
+	board.setBackgroundType(bgType);
+	// Rozgrywka w dzienniku zaczyna się przed init(), bo init() tworzy już pierwsze przeszkody.
+	if (persistent) {
+		analytics().beginRun(bgType, board.getNextHumanCount());
+	}
+	board.init(resources.getGreenDinoRun(), windowWidth, windowHeight);
+	playerScores.assign(board.getHumanCount(), 0.f);
+	if (resuming) {
+		if (restoreSnapshot(snapshotBuffer)) {
+			std::cout << "Resumed game from " << Config::SNAPSHOT_FILE << " at score " << static_cast<int>(score) << "\n";
+		}
+		else {
+			std::cout << "Cannot resume from " << Config::SNAPSHOT_FILE << ", starting a new game\n";
+			board.init(resources.getGreenDinoRun(), windowWidth, windowHeight);
+			playerScores.assign(board.getHumanCount(), 0.f);
+		}
+	}
+	snapshotTimer = 0.f;
+	telemetry.open();
+	ghostRecorder.begin(board.getCourseSeed());
+	if (hasGhost) {
+		ghostPlayer.start(ghost);
+	}
+
+	pipeline.start(getPipelineMode(), [this](DrawList& list) { simulate(list); });
+	input().setCapturing(true);
+	// Pierwsza klatka z zerowym czasem, żeby już pierwszy render() miał gotową listę.
+	frameInput = FrameInput{ 0.0f, windowWidth, GetTime(), 0.0f };
+	pipeline.kick();
+	pipeline.sync();
+}
 
-		if (!gameOver) {
-			board.update(dt, windowHeight);
-			gameOver = board.checkLoss();
-			score += dt;
+void Controller::update(SceneManager& scenes, float deltaTime) {
+	// Symulacja poprzedniej klatki jest skończona (sync()), więc stan gry można tu czytać i zmieniać.
+	// Blok dziennika zamknięty w kroku symulacji trafia do pliku tutaj, a nie w środku klatki.
+	analytics().flushPending();
+	if (gameOver) {
+		if (!savedScore) {
+			saveScore();
+		}
+		if (!savedGhost) {
+			saveGhost();
+		}
+	}
+	else if (persistent) {
+		// Stan na wypadek awarii zapisujemy między klatkami, gdy symulacja stoi.
+		snapshotTimer += deltaTime;
+		if (snapshotTimer >= Config::SNAPSHOT_INTERVAL) {
+			snapshotTimer = 0.f;
+			writeSnapshot();
+		}
+	}
+	// Krok symulacji kończy się teraz i trwa deltaTime; skok trafia w chwilę wciśnięcia wewnątrz kroku.
+	const double now = InputSystem::now();
+	InputEvent event;
+	while (input().poll(event)) {
+		// Skoki graczy, których nie ma na planszy (np. klawisz drugiego gracza w grze jednoosobowej), są pomijane.
+		const int jumper = jumpActionPlayer(event.action);
+		if (event.action == InputAction::CONFIRM && gameOver) {
+			scenes.pop();
+		}
+		else if (jumper >= 0 && static_cast<std::size_t>(jumper) < board.getHumanCount() && !gameOver) {
+			// Wciśnięcia z granicy klatki (bez dokładnego czasu) idą na początek kroku, jak dotąd.
+			const float offset = event.precise
+				? std::clamp(deltaTime - static_cast<float>(now - event.time), 0.0f, deltaTime)
+				: 0.0f;
+			board.requestJump(static_cast<std::size_t>(jumper), offset);
+			analytics().recordJump(static_cast<std::size_t>(jumper), offset);
+			input().recordLatency(event, now, offset);
 		}
+	}
 
-		if (gameOver) {
-			std::string gameOverText = "Game Over! Score: " + std::to_string(static_cast<int>(score));
-			DrawText(gameOverText.c_str(), windowWidth / 2 - MeasureText(gameOverText.c_str(), 40) / 2, windowHeight / 2, 40, RED);
-			if (!savedScore) {
-				saveScore();
-			}
-			DrawText("Press ENTER to return to menu", windowWidth / 2 - MeasureText("Press ENTER to return to menu", 20) / 2, windowHeight / 2 + 50, 20, WHITE);
-			if (IsKeyPressed(KEY_ENTER)) {
-				gameOver = false;
-				break;
+	// Tło i licznik wyniku sięgają do prawej krawędzi okna także po zmianie jego rozmiaru (w trybie natywnym).
+	frameInput = FrameInput{ deltaTime, presenter().getWorldWidth(), GetTime(), drawTime };
+	pipeline.kick();
+}
+
+void Controller::simulate(DrawList& list) {
+	frameTime = frameInput.deltaTime;
+	windowWidth = frameInput.worldWidth;
+	scrollBackground(frameInput.deltaTime);
+
+	auto updateStart = std::chrono::steady_clock::now();
+	if (!gameOver) {
+		// Krok liczy się każdemu, kto go zaczął - także graczowi, który zderzy się w jego trakcie.
+		for (std::size_t i = 0; i < playerScores.size(); ++i) {
+			if (board.isAlive(i)) {
+				playerScores[i] += frameInput.deltaTime;
 			}
 		}
-		else {
-			board.draw();
+		analytics().recordFrame(frameInput.deltaTime);
+		board.update(frameInput.deltaTime, windowHeight, score);
+		analytics().advance(frameInput.deltaTime);
+		gameOver = board.checkLoss();
+		score += frameInput.deltaTime;
+		if (gameOver && persistent) {
+			analytics().endRun(score);
+			// Skończonej rozgrywki nie da się wznowić.
+			std::error_code error;
+			std::filesystem::remove(Config::SNAPSHOT_FILE, error);
 		}
+		if (recordGhost) {
+			const Player& player = board.getPlayer();
+			ghostRecorder.record(frameInput.deltaTime, player.getHeightAboveGround(), player.getJumpsTaken());
+			ghostHeight = ghostPlayer.advance(frameInput.deltaTime).height;
+		}
+	}
+	else {
+		board.updateEffects(frameInput.deltaTime);
+	}
+	updateTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - updateStart).count();
 
-		drawUI();
+	drawBackground(list);
+	if (gameOver) {
+		std::string gameOverText = "Game Over! Score: " + std::to_string(static_cast<int>(score));
+		if (playerScores.size() > 1) {
+			const auto best = std::max_element(playerScores.begin(), playerScores.end());
+			gameOverText = "Game Over! Winner: P" + std::to_string(best - playerScores.begin() + 1)
+				+ ", score: " + std::to_string(static_cast<int>(*best));
+		}
+		list.text(gameOverText, static_cast<float>(windowWidth / 2 - MeasureText(gameOverText.c_str(), 40) / 2), static_cast<float>(windowHeight / 2), 40, RED);
+		list.text("Press ENTER to return to menu", static_cast<float>(windowWidth / 2 - MeasureText("Press ENTER to return to menu", 20) / 2), static_cast<float>(windowHeight / 2 + 50), 20, WHITE);
+		board.drawEffects(list);
+	}
+	else {
+		// Duch kończy się tam, gdzie skończył się najlepszy przebieg - dalej gracz bije rekord.
+		if (ghostPlayer.isActive()) {
+			board.getPlayer().drawGhost(list, ghostHeight, ghostPlayer.getTime(), Color{ 255, 255, 255, Config::GHOST_ALPHA });
+		}
+		board.draw(list);
+	}
+	drawUI(list);
+
+	publishTelemetry(frameTime, updateTime, frameInput.drawTime);
+}
+
+void Controller::render() {
+	auto drawStart = std::chrono::steady_clock::now();
+	presenter().begin();
+	ClearBackground(BLACK);
+	if (const DrawList* list = pipeline.getPresented()) {
+		list->submit();
+	}
+	presenter().end();
+	drawTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - drawStart).count();
+}
+
+void Controller::sync() {
+	pipeline.sync();
+}
+
+void Controller::exit() {
+	input().setCapturing(false);
+	pipeline.stop();
+	if (!persistent) return;
+	// Przerwana rozgrywka też trafia do dziennika (po końcu gry endRun() nic już nie robi).
+	analytics().endRun(score);
+	analytics().flushPending();
+	// Wyjście w trakcie gry działa jak pauza - --resume wznowi ją od tego miejsca.
+	if (!gameOver) {
+		writeSnapshot();
+	}
+}
+
+std::size_t Controller::saveSnapshot(std::span<std::uint8_t> buffer) const {
+	SnapshotWriter out(buffer);
+	SnapshotHeader header{};
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	out.write(header);
+
+	ControllerState state{};
+	state.score = score;
+	state.bgX = bgX;
+	state.mgX = mgX;
+	state.fgX = fgX;
+	state.groundX = groundX;
+	state.playerScores = static_cast<std::uint32_t>(playerScores.size());
+	state.background = static_cast<std::uint32_t>(board.getBackgroundType());
+	state.gameOver = gameOver ? 1 : 0;
+	out.write(state);
+	out.writeArray(playerScores.data(), playerScores.size());
+	if (!board.saveState(out)) {
+		return 0;
+	}
+	// Rozmiar jest znany dopiero po zapisie planszy.
+	header.bytes = static_cast<std::uint32_t>(out.size());
+	std::memcpy(out.at(0), &header, sizeof(header));
+	return out.size();
+}
+
+bool Controller::restoreSnapshot(std::span<const std::uint8_t> data) {
+	SnapshotReader in(data);
+	SnapshotHeader header{};
+	ControllerState state{};
+	std::array<float, Config::MAX_LOCAL_PLAYERS> scores{};
+	if (!readControllerState(data, header, state, in) || !in.readArray(scores.data(), state.playerScores)
+		|| !board.restoreState(in) || state.playerScores != board.getHumanCount()) {
+		return false;
+	}
+	score = state.score;
+	bgX = state.bgX;
+	mgX = state.mgX;
+	fgX = state.fgX;
+	groundX = state.groundX;
+	gameOver = state.gameOver != 0;
+	playerScores.assign(scores.begin(), scores.begin() + state.playerScores);
+	return true;
+}
+
+void Controller::writeSnapshot() {
+	// Bufor rośnie tylko, gdy na planszy przybyło przeszkód lub cząsteczek - zwykle zapis nie alokuje.
+	const std::size_t needed = sizeof(SnapshotHeader) + sizeof(ControllerState) + playerScores.size() * sizeof(float) + board.getStateBytes();
+	if (snapshotBuffer.size() < needed) {
+		snapshotBuffer.resize(needed);
+	}
+	const std::size_t bytes = saveSnapshot(snapshotBuffer);
+	if (bytes == 0) {
+		return;
+	}
+
+	// Zapis do pliku obok i podmiana: awaria w trakcie zapisu nie uszkodzi poprzedniego stanu.
+	const std::string temporary = std::string(Config::SNAPSHOT_FILE) + ".tmp";
+	std::error_code error;
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.is_open() || !file.write(reinterpret_cast<const char*>(snapshotBuffer.data()), static_cast<std::streamsize>(bytes))) {
+			std::cout << "Cannot write saved game " << temporary << "\n";
+			file.close();
+			std::filesystem::remove(temporary, error);
+			return;
+		}
+	}
+	std::filesystem::rename(temporary, Config::SNAPSHOT_FILE, error);
+	if (error) {
+		std::cout << "Cannot replace saved game " << Config::SNAPSHOT_FILE << ": " << error.message() << "\n";
+		std::filesystem::remove(temporary, error);
+	}
+}
+
+void requestResume() {
+	resumeRequested = true;
+}
+
+void Controller::publishTelemetry(float frameTime, float updateTime, float drawTime) {
+	if (!telemetry.isOpen()) return;
+
+	TelemetryFrame frame{};
+	frame.tick = tick++;
+	frame.time = frameInput.time;
+	frame.score = score;
+	frame.lives = lives;
+	frame.gameOver = gameOver ? 1 : 0;
+	Vector2 playerPos = board.getPlayer().getPosition();
+	frame.playerX = playerPos.x;
+	frame.playerY = playerPos.y;
+	frame.frameTime = frameTime;
+	frame.updateTime = updateTime;
+	frame.drawTime = drawTime;
 
-		EndDrawing();
+	for (const auto& obstacle : board.getObstacles()) {
+		if (frame.obstacleCount == TelemetryConfig::MAX_OBSTACLES) break;
+		Rectangle rec = obstacle->getCollisionRec();
+		frame.obstacles[frame.obstacleCount++] = { rec.x, rec.y, rec.width, rec.height };
 	}
+
+	telemetry.publish(frame);
 }
 
-void Controller::scrollBackground(float dt, int windowWidth, int widnowHeight) {
+float Controller::backgroundScale() const {
 	float avgHeight = (bgTexture.height + mgTexture.height + fgTexture.height) / 3.0f;
-	float universalScale = static_cast<float>(windowHeight) / avgHeight;
+	return static_cast<float>(windowHeight) / avgHeight;
+}
+
+void Controller::scrollBackground(float dt) {
+	float universalScale = backgroundScale();
 
 	float bgScaledWidth = bgTexture.width * universalScale;
 	float mgScaledWidth = mgTexture.width * universalScale;
 	float fgScaledWidth = fgTexture.width * universalScale;
 	float groundScaledWidth = groundTexture.width * universalScale;
 
-	bgX -= 20 * dt;
-	mgX -= 40 * dt;
-	fgX -= 60 * dt;
-	groundX -= 200 * dt;
+	float worldSpeed = board.getWorldSpeed();
+	bgX -= worldSpeed * Config::PARALLAX_BG_FACTOR * dt;
+	mgX -= worldSpeed * Config::PARALLAX_MG_FACTOR * dt;
+	fgX -= worldSpeed * Config::PARALLAX_FG_FACTOR * dt;
+	groundX -= worldSpeed * dt;
 
 	bgX = fmod(bgX, bgScaledWidth);
 	if (bgX > 0) bgX -= bgScaledWidth;
@@ -132,63 +513,84 @@ void Controller::scrollBackground(float dt, int windowWidth, int widnowHeight) {
 	if (fgX > 0) fgX -= fgScaledWidth;
 	groundX = fmod(groundX, groundScaledWidth);
 	if (groundX > 0) groundX -= groundScaledWidth;
+}
+
+void Controller::drawBackground(DrawList& list) const {
+	float universalScale = backgroundScale();
+	int screenWidth = windowWidth;
 
-	auto drawTileableLayer = [&](Texture2D texture, float xPos, float scaledWidth) {
-		int numInstances = static_cast<int>(windowWidth / scaledWidth) + 2;
+	auto drawTileableLayer = [&](Texture2D texture, float xPos) {
+		float scaledWidth = texture.width * universalScale;
+		int numInstances = static_cast<int>(screenWidth / scaledWidth) + 2;
 		float startX = xPos;
 		for (int i = 0; i < numInstances; ++i) {
 			float drawX = startX + i * scaledWidth;
-			DrawTextureEx(texture, { drawX, 0.f }, 0.0f, universalScale, WHITE);
+			list.sprite(texture, { 0.f, 0.f, static_cast<float>(texture.width), static_cast<float>(texture.height) },
+				{ drawX, 0.f, scaledWidth, texture.height * universalScale });
 		}
 		};
 
-	auto drawForegroundLayer = [&](Texture2D texture, float xPos, float scaledWidth) {
-		int numInstances = static_cast<int>(windowWidth / scaledWidth) + 2;
+	auto drawForegroundLayer = [&](Texture2D texture, float xPos) {
+		float scaledWidth = texture.width * universalScale;
+		int numInstances = static_cast<int>(screenWidth / scaledWidth) + 2;
 		float startX = xPos;
 		for (int i = 0; i < numInstances; ++i) {
 			float drawX = startX + i * scaledWidth;
 			float textureHeight = texture.height * universalScale;
 			float drawY = windowHeight - textureHeight;
-			DrawTextureEx(texture, { drawX, drawY }, 0.0f, universalScale, WHITE);
+			list.sprite(texture, { 0.f, 0.f, static_cast<float>(texture.width), static_cast<float>(texture.height) },
+				{ drawX, drawY, scaledWidth, textureHeight });
 		}
 		};
 
-	drawTileableLayer(bgTexture, bgX, bgScaledWidth);
-	drawTileableLayer(mgTexture, mgX, mgScaledWidth);
-	drawForegroundLayer(fgTexture, fgX, fgScaledWidth);
-	drawTileableLayer(groundTexture, groundX, groundScaledWidth);
+	drawTileableLayer(bgTexture, bgX);
+	drawTileableLayer(mgTexture, mgX);
+	drawForegroundLayer(fgTexture, fgX);
+	drawTileableLayer(groundTexture, groundX);
 }
 
-void Controller::drawUI() {
-	Texture2D lifeFull = resources.getHeartIcon();
-	Texture2D lifeEmpty = resources.getLifeLostIcon();
+void Controller::drawUI(DrawList& list) const {
+	const Texture2D& numbers = numbersTexture;
+	int digitWidth = numbers.width / 10;
+	int digitHeight = numbers.height;
+	float scaledWidth = digitWidth * numbScale;
+	const float rowHeight = std::max(heartIcon.height, digitHeight) * numbScale + 10.0f;
+	const bool multiplayer = playerScores.size() > 1;
 
-	Texture2D icon = (!gameOver) ? lifeFull : lifeEmpty;
-	float x = 10;
+	// Każdy gracz z klawiatury ma własny wiersz: ikona życia po lewej, wynik po prawej.
 	float y = 10;
-	DrawTextureEx(icon, { x, y }, 0.f, numbScale, WHITE);
-
-
-	Texture2D numbers = resources.getNumbersTexture();
-	int s = static_cast<int>(score);
-	std::string scoreText = std::to_string(s);
+	for (std::size_t player = 0; player < playerScores.size(); ++player) {
+		const Texture2D& icon = board.isAlive(player) ? heartIcon : lifeLostIcon;
+		float x = 10;
+		list.sprite(icon, { 0.f, 0.f, static_cast<float>(icon.width), static_cast<float>(icon.height) },
+			{ x, y, icon.width * numbScale, icon.height * numbScale });
+		if (multiplayer) {
+			list.text("P" + std::to_string(player + 1), x + icon.width * numbScale + 8.0f, y, 20, WHITE);
+		}
 
-	int digitWidth = numbers.width / 10;
-	int digitHeight = numbers.height;
+		int s = static_cast<int>(playerScores[player]);
+		std::string scoreText = std::to_string(s);
+		float totalWidth = scaledWidth * scoreText.length();
+		for (int i = 0; i < scoreText.length(); ++i) {
+			int digit = scoreText[i] - '0';
+			Rectangle src = { static_cast<float>(digit * digitWidth), 0, static_cast<float>(digitWidth), static_cast<float>(digitHeight) };
+			Rectangle dest = {
+				static_cast<float>(windowWidth - totalWidth - 10 + i * scaledWidth),
+				y,
+				static_cast<float>(scaledWidth),
+				static_cast<float>(digitHeight * numbScale)
+			};
+			list.sprite(numbers, src, dest);
+		}
+		y += rowHeight;
+	}
 
-	float scaledWidth = digitWidth * numbScale;
-	float totalWidth = scaledWidth * scoreText.length();
-	windowWidth = GetScreenWidth();
-
-	for (int i = 0; i < scoreText.length(); ++i) {
-		int digit = scoreText[i] - '0';
-		Rectangle src = { static_cast<float>(digit * digitWidth), 0, static_cast<float>(digitWidth), static_cast<float>(digitHeight) };
-		Rectangle dest = {
-			static_cast<float>(windowWidth - totalWidth - 10 + i * scaledWidth),
-			10.0f,
-			static_cast<float>(scaledWidth),
-			static_cast<float>(digitHeight * numbScale)
-		};
-		DrawTexturePro(numbers, src, dest, { 0, 0 }, 0.0f, WHITE);
+	const std::size_t bots = board.getPlayerCount() - board.getHumanCount();
+	if (bots > 0) {
+		std::size_t aliveHumans = 0;
+		for (std::size_t player = 0; player < board.getHumanCount(); ++player) {
+			aliveHumans += board.isAlive(player) ? 1 : 0;
+		}
+		list.text("Bots: " + std::to_string(board.getAliveCount() - aliveHumans) + " / " + std::to_string(bots), 10.0f, y, 20, WHITE);
 	}
 }
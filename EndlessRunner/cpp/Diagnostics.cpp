@@ -0,0 +1,671 @@
+﻿/**
+ * @file Diagnostics.cpp
+ * @brief Implementacja trybów diagnostycznych.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+module DiagnosticsModule;
+
+import BoardModule;
+import ResourcesModule;
+import DifficultyModule;
+import ObstacleFactoryModule;
+import ConfigModule;
+import FramePacerModule;
+import AnimationSystemModule;
+import ParticlesModule;
+import ControllerModule;
+import SceneModule;
+import PresenterModule;
+import RecordLogModule;
+import ScoreServiceModule;
+import ChunkGeneratorModule;
+import FramePipelineModule;
+
+int runDifficultyStress(std::uint32_t ticks) {
+	const int windowWidth = Config::DEFAULT_WINDOW_WIDTH;
+	const int windowHeight = Config::DEFAULT_WINDOW_HEIGHT;
+
+	SetTraceLogLevel(LOG_WARNING);
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(windowWidth, windowHeight, "Dino Rush - difficulty stress");
+
+	Resources resources;
+	resources.loadTextures();
+	Board board(resources);
+
+	// Krzywa dochodząca do maksymalnej prędkości przy minimalnych odstępach.
+	DifficultyCurve curve;
+	curve.clear();
+	curve.addKey({ 0.0f, Config::BASE_WORLD_SPEED, Config::MIN_OBSTACLE_DISTANCE, Config::MAX_OBSTACLE_DISTANCE });
+	curve.addKey({ 10.0f, 2000.0f, Config::MIN_OBSTACLE_GAP_FLOOR, 300.0f });
+	curve.addKey({ 30.0f, Config::MAX_WORLD_SPEED, Config::MIN_OBSTACLE_GAP_FLOOR, Config::MIN_OBSTACLE_GAP_FLOOR });
+	board.setDifficultyCurve(curve);
+	board.setBackgroundType(BackgroundType::DESERT_DAY);
+	board.init(resources.getGreenDinoRun(), windowWidth, windowHeight);
+
+	// Górne ograniczenie liczby przeszkód wynikające z marginesu spawnu i minimalnego odstępu.
+	const float span = windowWidth + Config::OBSTACLE_SPAWN_MARGIN - Config::OBSTACLE_DESPAWN_X;
+	const std::size_t obstacleLimit = static_cast<std::size_t>(span / Config::MIN_OBSTACLE_GAP_FLOOR) + 2;
+
+	std::mt19937 gen(12345);
+	std::uniform_int_distribution<int> spike(0, 99);
+
+	const std::uint32_t bucketCount = 10;
+	const std::uint32_t bucketSize = std::max<std::uint32_t>(ticks / bucketCount, 1);
+	double bucketNanos = 0.0;
+	double maxTickNanos = 0.0;
+	std::size_t maxObstacles = 0;
+	std::uint32_t violations = 0;
+	float score = 0.0f;
+	std::uint64_t starved = 0;
+
+	std::cout << "tick range        speed(px/s)  obstacles  avg tick (us)\n";
+	for (std::uint32_t tick = 1; tick <= ticks; ++tick) {
+		int roll = spike(gen);
+		float dt = roll < 2 ? 0.25f : (roll < 10 ? 1.0f / 240.0f : 1.0f / 60.0f);
+
+		auto start = std::chrono::steady_clock::now();
+		animations().advance(dt);
+		board.update(dt, windowHeight, score);
+		double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		score += dt;
+		if (board.getStarvedTicks() != starved) {
+			// Symulacja biegnie szybciej niż czas rzeczywisty - dajemy generatorowi fragmentów dogonić planszę
+			// (poza pomiarem), inaczej przy jednym rdzeniu sprawdzalibyśmy pustą trasę.
+			starved = board.getStarvedTicks();
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+
+		bucketNanos += nanos;
+		maxTickNanos = std::max(maxTickNanos, nanos);
+
+		const auto& obstacles = board.getObstacles();
+		maxObstacles = std::max(maxObstacles, obstacles.size());
+		if (obstacles.size() > obstacleLimit) {
+			std::cout << "tick " << tick << ": " << obstacles.size() << " obstacles exceeds limit " << obstacleLimit << "\n";
+			++violations;
+		}
+		for (std::size_t i = 0; i < obstacles.size(); ++i) {
+			float x = obstacles[i]->getPositionX();
+			if (!std::isfinite(x)) {
+				std::cout << "tick " << tick << ": non-finite obstacle position\n";
+				++violations;
+			}
+			if (i > 0 && x - obstacles[i - 1]->getPositionX() < Config::MIN_OBSTACLE_GAP_FLOOR - 0.01f) {
+				std::cout << "tick " << tick << ": obstacle gap " << x - obstacles[i - 1]->getPositionX() << " below floor\n";
+				++violations;
+			}
+		}
+		Vector2 playerPos = board.getPlayer().getPosition();
+		if (!std::isfinite(playerPos.x) || !std::isfinite(playerPos.y)) {
+			std::cout << "tick " << tick << ": non-finite player position\n";
+			++violations;
+		}
+
+		if (tick % bucketSize == 0) {
+			std::cout << (tick - bucketSize + 1) << "-" << tick
+				<< "\t" << board.getWorldSpeed()
+				<< "\t" << obstacles.size()
+				<< "\t" << bucketNanos / bucketSize / 1000.0 << "\n";
+			bucketNanos = 0.0;
+		}
+		if (violations > 20) {
+			std::cout << "Too many violations, aborting\n";
+			break;
+		}
+	}
+
+	std::cout << "max obstacles: " << maxObstacles << " (limit " << obstacleLimit << ")"
+		<< ", worst tick: " << maxTickNanos / 1000.0 << " us"
+		<< ", violations: " << violations << "\n";
+	const ChunkGenerator& chunks = board.getChunkGenerator();
+	std::cout << "chunks: " << chunks.getChunkCount()
+		<< ", rejected rolls: " << chunks.getRejectedCount()
+		<< ", unsolved: " << chunks.getUnsolvedCount()
+		<< ", stale: " << board.getStaleChunks()
+		<< ", starved ticks: " << board.getStarvedTicks() << "\n";
+
+	resources.unloadTextures();
+	CloseWindow();
+	return violations == 0 ? 0 : 1;
+}
+
+int runPacingBenchmark(float secondsPerMode) {
+	InitWindow(Config::DEFAULT_WINDOW_WIDTH, Config::DEFAULT_WINDOW_HEIGHT, "Dino Rush - pacing benchmark");
+	FramePacer& pacer = framePacer();
+	pacer.resetStats();
+
+	struct Phase {
+		PacingMode mode;
+		FrameKind kind;
+		float seconds;
+	};
+	// Ostatnia faza to menu bez wejścia: najpierw pełne tempo, po IDLE_THROTTLE_DELAY tryb oszczędny.
+	const Phase phases[] = {
+		{ PacingMode::VSYNC, FrameKind::GAMEPLAY, secondsPerMode },
+		{ PacingMode::CAPPED, FrameKind::GAMEPLAY, secondsPerMode },
+		{ PacingMode::UNCAPPED, FrameKind::GAMEPLAY, secondsPerMode },
+		{ PacingMode::CAPPED, FrameKind::MENU, secondsPerMode + Config::IDLE_THROTTLE_DELAY },
+	};
+
+	float x = 0.0f;
+	for (const Phase& phase : phases) {
+		pacer.setMode(phase.mode);
+		std::cout << "Measuring " << pacingModeName(phase.mode) << (phase.kind == FrameKind::MENU ? " (idle menu)" : "") << "...\n";
+		double start = GetTime();
+		while (GetTime() - start < phase.seconds && !WindowShouldClose()) {
+			x += 300.0f * GetFrameTime();
+			if (x > GetScreenWidth()) x = 0.0f;
+			BeginDrawing();
+			ClearBackground(BLACK);
+			DrawRectangle(static_cast<int>(x), GetScreenHeight() / 2 - 25, 50, 50, RAYWHITE);
+			DrawFPS(10, 10);
+			EndDrawing();
+			pacer.endFrame(phase.kind);
+		}
+	}
+
+	pacer.printReport();
+	CloseWindow();
+	return 0;
+}
+
+namespace {
+	/**
+	 * @brief Dawny sposób animacji: licznik w każdym obiekcie i wirtualne update(), zerowanie zamiast reszty.
+	 */
+	struct LegacySprite {
+		virtual ~LegacySprite() = default;
+		virtual void update(float deltaTime) {
+			runningTime += deltaTime;
+			if (runningTime >= updateTime) {
+				runningTime = 0.f;
+				frame++;
+				if (frame >= maxFrames) frame = 0;
+			}
+		}
+		int frame{ 0 };
+		float maxFrames{ 6.f };
+		float updateTime{ Config::ANIMATION_UPDATE_TIME };
+		float runningTime{ 0.f };
+	};
+
+	/**
+	 * @brief Wariant z licznikiem zmian klatki, używany tylko do pomiaru dryfu tempa.
+	 */
+	struct CountingLegacySprite : LegacySprite {
+		void update(float deltaTime) override {
+			int before = frame;
+			LegacySprite::update(deltaTime);
+			if (frame != before) steps++;
+		}
+		/** @brief Licznik wszystkich zmian klatki. */
+		std::uint64_t steps{ 0 };
+	};
+
+	/**
+	 * @brief Mierzy czas wywołania funkcji w nanosekundach.
+	 * @param work Mierzona praca.
+	 * @return Czas w nanosekundach.
+	 */
+	template <typename Work>
+	double measureNanos(Work&& work) {
+		auto start = std::chrono::steady_clock::now();
+		work();
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int runAnimationBenchmark(std::uint32_t spriteCount, std::uint32_t frames) {
+	constexpr float dt = 1.0f / 60.0f;
+	constexpr std::uint32_t sharedClips = 16;
+	long long checksum = 0;
+
+	std::cout << "sprites     legacy (ns/sprite)  soa private (ns/sprite)  soa shared (ns/sprite)\n";
+	for (std::uint32_t count : { spriteCount, spriteCount * 10 }) {
+		std::vector<std::unique_ptr<LegacySprite>> legacy;
+		legacy.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			legacy.push_back(std::make_unique<LegacySprite>());
+		}
+		double legacyNanos = measureNanos([&] {
+			for (std::uint32_t f = 0; f < frames; ++f) {
+				for (auto& sprite : legacy) sprite->update(dt);
+			}
+		});
+		for (auto& sprite : legacy) checksum += sprite->frame;
+
+		AnimationSystem privateSystem;
+		std::vector<AnimationClip> privateClips;
+		privateClips.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			privateClips.push_back(privateSystem.create(6, Config::ANIMATION_UPDATE_TIME));
+		}
+		double privateNanos = measureNanos([&] {
+			for (std::uint32_t f = 0; f < frames; ++f) privateSystem.advance(dt);
+		});
+		for (auto& clip : privateClips) checksum += clip.getFrame();
+
+		AnimationSystem sharedSystem;
+		std::vector<AnimationClip> sharedHandles;
+		sharedHandles.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			sharedHandles.push_back(sharedSystem.share(1 + i % sharedClips, 6, Config::ANIMATION_UPDATE_TIME));
+		}
+		double sharedNanos = measureNanos([&] {
+			for (std::uint32_t f = 0; f < frames; ++f) sharedSystem.advance(dt);
+		});
+		for (auto& clip : sharedHandles) checksum += clip.getFrame();
+
+		const double perSprite = static_cast<double>(count) * frames;
+		std::cout << std::left << std::setw(12) << count << std::right << std::fixed << std::setprecision(3)
+			<< std::setw(18) << legacyNanos / perSprite
+			<< std::setw(25) << privateNanos / perSprite
+			<< std::setw(24) << sharedNanos / perSprite << "\n";
+	}
+
+	// Dryf tempa: ok. 10 sekund animacji przy różnych FPS (z dala od granicy klatki, aby nie mierzyć zaokrągleń).
+	constexpr float seconds = 10.04f;
+	const int expected = static_cast<int>(seconds / Config::ANIMATION_UPDATE_TIME);
+	std::cout << "fps     expected steps  legacy steps  soa steps\n";
+	for (float fps : { 30.0f, 60.0f, 144.0f, 240.0f }) {
+		const int ticks = static_cast<int>(seconds * fps);
+		CountingLegacySprite legacySprite;
+		AnimationSystem system;
+		AnimationClip clip = system.create(6, Config::ANIMATION_UPDATE_TIME);
+		std::uint64_t steps = 0;
+		for (int i = 0; i < ticks; ++i) {
+			legacySprite.update(1.0f / fps);
+			int before = clip.getFrame();
+			system.advance(1.0f / fps);
+			steps += (clip.getFrame() - before + 6) % 6;
+		}
+		std::cout << std::setprecision(0) << std::setw(3) << fps
+			<< std::setw(18) << expected
+			<< std::setw(14) << legacySprite.steps
+			<< std::setw(11) << steps << "\n";
+	}
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << "checksum " << checksum << "\n";
+	return 0;
+}
+
+int runParticleBenchmark(std::uint32_t particleCount, std::uint32_t frames) {
+	constexpr float dt = 1.0f / 60.0f;
+
+	std::cout << "target live  avg live  update (ns/particle)  update (ms/frame)  spawn scale\n";
+	for (std::uint32_t target : { particleCount, particleCount * 2, particleCount * 4 }) {
+		ParticleSystem particles(static_cast<std::size_t>(target) * 2);
+		EmitterConfig& hit = particles.getEmitter(EmitterKind::HIT);
+		hit.lifetime = 1.0f;
+		// Przy stałym czasie życia w puli jest średnio count * (lifetime / dt) cząsteczek.
+		hit.count = std::max(1, static_cast<int>(target * dt / hit.lifetime));
+
+		double totalMs = 0.0;
+		std::uint64_t liveSum = 0;
+		for (std::uint32_t f = 0; f < frames; ++f) {
+			particles.emit(EmitterKind::HIT, 640.f, 360.f);
+			particles.update(dt);
+			totalMs += particles.getLastUpdateMs();
+			liveSum += particles.getLiveCount();
+		}
+
+		const double avgLive = static_cast<double>(liveSum) / frames;
+		std::cout << std::left << std::setw(13) << target << std::right << std::fixed << std::setprecision(0)
+			<< std::setw(8) << avgLive << std::setprecision(3)
+			<< std::setw(22) << totalMs * 1e6 / std::max(1.0, static_cast<double>(liveSum))
+			<< std::setw(19) << totalMs / frames
+			<< std::setw(13) << particles.getSpawnScale() << "\n";
+	}
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << "budget " << Config::PARTICLE_BUDGET_MS << " ms/frame\n";
+	return 0;
+}
+
+namespace {
+	/**
+	 * @brief Prowadzi rozgrywki sceny gry przez zadany czas i mierzy czas każdej klatki (logika, rysowanie, prezentacja).
+	 *
+	 * Po przegranej plansza przestaje być rysowana - nowa gra utrzymuje stałe obciążenie. Rozgrywki testu
+	 * nie nadpisują zapisu gry gracza ani dziennika zdarzeń.
+	 *
+	 * @param resources Wczytane zasoby.
+	 * @param board Plansza rozgrywek.
+	 * @param scenes Stos scen (wymagany przez enter()).
+	 * @param seconds Czas pomiaru (sekundy).
+	 * @return Czasy kolejnych klatek (sekundy).
+	 */
+	std::vector<double> measureControllerFrames(Resources& resources, Board& board, SceneManager& scenes, float seconds) {
+		auto startGame = [&] {
+			auto controller = std::make_unique<Controller>(resources, board, "", GetScreenWidth(), GetScreenHeight());
+			controller->setPersistent(false);
+			controller->enter(scenes);
+			return controller;
+		};
+
+		auto controller = startGame();
+		std::vector<double> frameTimes;
+		double start = GetTime();
+		double last = start;
+		while (GetTime() - start < seconds && !WindowShouldClose()) {
+			controller->sync();
+			if (board.checkLoss()) {
+				controller->exit();
+				controller = startGame();
+			}
+			animations().advance(1.0f / Config::TARGET_FPS);
+			controller->update(scenes, 1.0f / Config::TARGET_FPS);
+			BeginDrawing();
+			controller->render();
+			EndDrawing();
+			framePacer().endFrame(FrameKind::GAMEPLAY);
+
+			double now = GetTime();
+			frameTimes.push_back(now - last);
+			last = now;
+		}
+		controller->exit();
+		return frameTimes;
+	}
+}
+
+int runPresentationBenchmark(float secondsPerSize) {
+	SetTraceLogLevel(LOG_WARNING);
+	SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+	InitWindow(Config::DEFAULT_WINDOW_WIDTH, Config::DEFAULT_WINDOW_HEIGHT, "Dino Rush - presentation benchmark");
+	framePacer().setMode(PacingMode::UNCAPPED);
+
+	Resources resources;
+	resources.loadTextures();
+	Board board(resources);
+	SceneManager scenes;
+
+	struct WindowSize {
+		const char* name;
+		int width;
+		int height;
+	};
+	const WindowSize sizes[] = { { "720p", 1280, 720 }, { "1080p", 1920, 1080 }, { "4K", 3840, 2160 } };
+
+	std::cout << "mode     size   window       avg (ms)  max (ms)  frames\n";
+	for (RenderMode mode : { RenderMode::NATIVE, RenderMode::FIXED }) {
+		presenter().setMode(mode);
+		for (const WindowSize& size : sizes) {
+			SetWindowSize(size.width, size.height);
+			// Kilka klatek na dostosowanie okna i bufora przez system, zanim zacznie się pomiar.
+			for (int i = 0; i < 5; ++i) {
+				BeginDrawing();
+				EndDrawing();
+			}
+
+			const std::vector<double> frameTimes = measureControllerFrames(resources, board, scenes, secondsPerSize);
+			double total = 0.0;
+			double worst = 0.0;
+			for (double frameTime : frameTimes) {
+				total += frameTime;
+				worst = std::max(worst, frameTime);
+			}
+
+			std::cout << std::left << std::setw(9) << renderModeName(mode) << std::setw(7) << size.name
+				<< std::setw(13) << (std::to_string(GetScreenWidth()) + "x" + std::to_string(GetScreenHeight()))
+				<< std::right << std::fixed << std::setprecision(3)
+				<< std::setw(8) << (frameTimes.empty() ? 0.0 : total * 1000.0 / frameTimes.size())
+				<< std::setw(10) << worst * 1000.0
+				<< std::setw(8) << frameTimes.size() << "\n";
+			std::cout.unsetf(std::ios::fixed);
+		}
+	}
+
+	presenter().setMode(RenderMode::NATIVE);
+	resources.unloadTextures();
+	CloseWindow();
+	return 0;
+}
+
+int runPipelineBenchmark(float secondsPerMode) {
+	SetTraceLogLevel(LOG_WARNING);
+	InitWindow(Config::DEFAULT_WINDOW_WIDTH, Config::DEFAULT_WINDOW_HEIGHT, "Dino Rush - pipeline benchmark");
+	framePacer().setMode(PacingMode::UNCAPPED);
+	const PipelineMode previousMode = getPipelineMode();
+
+	Resources resources;
+	resources.loadTextures();
+	Board board(resources);
+	SceneManager scenes;
+
+	const unsigned cores = std::thread::hardware_concurrency();
+	std::cout << "hardware threads: " << cores << "\n";
+	if (cores < 2) {
+		std::cout << "Single core: the simulation thread cannot overlap with rendering, expect no gain\n";
+	}
+
+	std::cout << "mode      avg (ms)  p99 (ms)  max (ms)  frames\n";
+	for (PipelineMode mode : { PipelineMode::SERIAL, PipelineMode::THREADED }) {
+		setPipelineMode(mode);
+		std::vector<double> frameTimes = measureControllerFrames(resources, board, scenes, secondsPerMode);
+
+		double total = 0.0;
+		for (double frameTime : frameTimes) {
+			total += frameTime;
+		}
+		std::sort(frameTimes.begin(), frameTimes.end());
+		auto percentile = [&](double p) {
+			return frameTimes.empty() ? 0.0 : frameTimes[static_cast<std::size_t>(p * (frameTimes.size() - 1))];
+		};
+		std::cout << std::left << std::setw(10) << pipelineModeName(mode)
+			<< std::right << std::fixed << std::setprecision(3)
+			<< std::setw(8) << (frameTimes.empty() ? 0.0 : total * 1000.0 / frameTimes.size())
+			<< std::setw(10) << percentile(0.99) * 1000.0
+			<< std::setw(10) << percentile(1.0) * 1000.0
+			<< std::setw(8) << frameTimes.size() << "\n";
+		std::cout.unsetf(std::ios::fixed);
+	}
+
+	setPipelineMode(previousMode);
+	resources.unloadTextures();
+	CloseWindow();
+	return 0;
+}
+
+namespace {
+	/**
+	 * @brief Zwraca treść rekordu testu zapisu - długą, aby rozerwanie wiersza było widoczne.
+	 * @param writerId Numer procesu.
+	 * @return Ciąg znaków zależny od procesu.
+	 */
+	std::string stressPayload(int writerId) {
+		return std::string(200, static_cast<char>('a' + writerId % 26));
+	}
+}
+
+int runStorageWriter(const std::string& path, int writerId, int records) {
+	RecordLog log(path);
+	const std::string payload = stressPayload(writerId);
+	for (int i = 0; i < records; ++i) {
+		if (log.append("w" + std::to_string(writerId) + ":" + std::to_string(i) + ":" + payload) != AppendResult::WRITTEN) {
+			std::cout << "writer " << writerId << ": append " << i << " failed\n";
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int runStorageStress(const std::string& executable, int writers, int recordsPerWriter) {
+	const std::string path = (std::filesystem::temp_directory_path() / "dino_storage_stress.txt").string();
+	std::filesystem::remove(path);
+
+	std::vector<int> nextSeq(writers, 0);
+	std::uint64_t torn = 0;
+	std::uint64_t outOfOrder = 0;
+	std::uint64_t polls = 0;
+	std::uint64_t records = 0;
+	RecordLog reader(path);
+	auto check = [&](std::string_view line) {
+		++records;
+		// Format: w<numer>:<kolejny>:<treść>.
+		const std::size_t first = line.find(':');
+		const std::size_t second = first == std::string_view::npos ? first : line.find(':', first + 1);
+		if (line.size() < 2 || line[0] != 'w' || second == std::string_view::npos) {
+			++torn;
+			return;
+		}
+		const int id = std::atoi(std::string(line.substr(1, first - 1)).c_str());
+		const int seq = std::atoi(std::string(line.substr(first + 1, second - first - 1)).c_str());
+		if (id < 0 || id >= writers || line.substr(second + 1) != stressPayload(id)) {
+			++torn;
+			return;
+		}
+		if (seq != nextSeq[id]) {
+			++outOfOrder;
+		}
+		nextSeq[id] = seq + 1;
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> processes;
+	std::vector<int> exitCodes(writers, 0);
+	for (int id = 0; id < writers; ++id) {
+		std::string command = "\"" + executable + "\" --storage-writer \"" + path + "\" "
+			+ std::to_string(id) + " " + std::to_string(recordsPerWriter);
+#ifdef _WIN32
+		// cmd.exe zdejmuje zewnętrzne cudzysłowy, więc całe polecenie trzeba objąć jeszcze jedną parą.
+		command = "\"" + command + "\"";
+#endif
+		processes.emplace_back([command, &exitCodes, id] { exitCodes[id] = std::system(command.c_str()); });
+	}
+
+	// Czytelnik nie bierze blokady i w trakcie zapisu widzi tylko pełne wiersze.
+	std::uint64_t expected = static_cast<std::uint64_t>(writers) * recordsPerWriter;
+	while (records < expected && std::chrono::steady_clock::now() - start < std::chrono::seconds(60)) {
+		reader.readNew(check);
+		++polls;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	for (std::thread& process : processes) {
+		process.join();
+	}
+	reader.readNew(check);
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::uint64_t missing = 0;
+	int failedWriters = 0;
+	for (int id = 0; id < writers; ++id) {
+		missing += static_cast<std::uint64_t>(std::max(0, recordsPerWriter - nextSeq[id]));
+		failedWriters += exitCodes[id] != 0 ? 1 : 0;
+	}
+
+	std::cout << writers << " writer processes x " << recordsPerWriter << " records: "
+		<< records << " read in " << polls << " incremental polls (" << reader.getOffset() << " bytes), "
+		<< std::fixed << std::setprecision(0) << records / std::max(seconds, 1e-9) << " appends/s\n";
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << "torn lines: " << torn << ", out of order: " << outOfOrder << ", missing: " << missing
+		<< ", failed writers: " << failedWriters << "\n";
+
+	std::filesystem::remove(path);
+	return torn == 0 && outOfOrder == 0 && missing == 0 && failedWriters == 0 ? 0 : 1;
+}
+
+int runScoreLoad(int clients, float seconds, int batch) {
+	clients = std::max(clients, 1);
+	batch = std::max(batch, 2);
+	constexpr int players = 100000;
+
+	// Test zawsze mierzy własnego demona z osobnym plikiem wyników - tysiące fikcyjnych graczy
+	// nie mogą trafić do prawdziwej tablicy wyników.
+	const std::string socketPath = (std::filesystem::temp_directory_path() / "dino_score_load.sock").string();
+	const std::string scoresPath = (std::filesystem::temp_directory_path() / "dino_score_load.txt").string();
+	std::filesystem::remove(scoresPath);
+	ScoreServer server(scoresPath);
+	if (!server.start(socketPath)) {
+		return 1;
+	}
+	std::atomic<bool> serving{ true };
+	std::thread serverThread([&server, &serving] { server.serve(serving); });
+	std::cout << "Score daemon for the load test on " << socketPath << "\n";
+
+	std::vector<std::vector<std::uint32_t>> latencies(clients);
+	std::vector<std::uint64_t> failures(clients, 0);
+	std::atomic<bool> go{ false };
+	const auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(seconds));
+	std::vector<std::thread> workers;
+	for (int id = 0; id < clients; ++id) {
+		workers.emplace_back([&, id] {
+			ScoreClient client(socketPath);
+			std::mt19937 rng(static_cast<std::uint32_t>(id) * 7919u + 1u);
+			std::uniform_int_distribution<int> player(0, players - 1);
+			std::uniform_int_distribution<int> points(0, 5000);
+			std::vector<ScoreResponse> responses;
+			while (!go) {
+				std::this_thread::yield();
+			}
+			const auto end = std::chrono::steady_clock::now() + duration;
+			while (std::chrono::steady_clock::now() < end) {
+				client.queueSubmit("p" + std::to_string(player(rng)), points(rng));
+				client.queueTop(static_cast<std::uint16_t>(Config::LEADERBOARD_ROWS));
+				for (int i = 2; i < batch; ++i) {
+					client.queueRank("p" + std::to_string(player(rng)));
+				}
+				const auto start = std::chrono::steady_clock::now();
+				if (!client.flush(responses)) {
+					failures[id]++;
+					continue;
+				}
+				latencies[id].push_back(static_cast<std::uint32_t>(
+					std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+			}
+		});
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	go = true;
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<std::uint32_t> all;
+	std::uint64_t failed = 0;
+	for (int id = 0; id < clients; ++id) {
+		all.insert(all.end(), latencies[id].begin(), latencies[id].end());
+		failed += failures[id];
+	}
+	std::sort(all.begin(), all.end());
+	auto percentile = [&all](double p) -> std::uint32_t {
+		return all.empty() ? 0 : all[std::min(all.size() - 1, static_cast<std::size_t>(p * all.size()))];
+	};
+	const double requests = static_cast<double>(all.size()) * batch;
+
+	std::cout << clients << " clients x " << batch << " requests per batch for " << std::fixed << std::setprecision(1)
+		<< elapsed << " s: " << std::setprecision(0) << requests / std::max(elapsed, 1e-9) << " requests/s, "
+		<< all.size() / std::max(elapsed, 1e-9) << " batches/s\n";
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << "batch latency (us): p50 " << percentile(0.50) << ", p99 " << percentile(0.99) << ", p99.9 "
+		<< percentile(0.999) << ", max " << (all.empty() ? 0 : all.back()) << "; failed batches: " << failed << "\n";
+
+	serving = false;
+	serverThread.join();
+	std::cout << "daemon: " << server.getAccepted() << " connections, " << server.getRequests() << " requests in "
+		<< server.getBatches() << " reads, " << server.getIndex().size() << " players\n";
+	server.stop();
+	std::filesystem::remove(scoresPath);
+	return failed == 0 && !all.empty() ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+﻿/**
+ * @file Difficulty.cpp
+ * @brief Implementacja sterownika poziomu trudności.
+ */
+
+module;
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+module DifficultyModule;
+
+DifficultyCurve::DifficultyCurve() {
+	// Prędkość rośnie szybciej niż odstępy, więc liczba przeszkód na sekundę stopniowo się zwiększa.
+	addKey({ 0.0f, Config::BASE_WORLD_SPEED, Config::MIN_OBSTACLE_DISTANCE, Config::MAX_OBSTACLE_DISTANCE });
+	addKey({ 60.0f, 320.0f, 220.0f, 420.0f });
+	addKey({ 180.0f, 480.0f, 260.0f, 460.0f });
+	addKey({ 400.0f, 700.0f, 300.0f, 520.0f });
+}
+
+bool DifficultyCurve::loadFromFile(const std::string& path) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	DifficultyCurve loaded;
+	loaded.clear();
+
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line)) {
+		++lineNumber;
+		line = line.substr(0, line.find('#'));
+		std::istringstream stream(line);
+		std::string directive;
+		if (!(stream >> directive)) continue;
+
+		if (directive == "key") {
+			DifficultyKey key{};
+			if (stream >> key.progress >> key.speed >> key.minGap >> key.maxGap) {
+				loaded.addKey(key);
+				continue;
+			}
+		}
+		else if (directive == "time_weight") {
+			if (stream >> loaded.timeWeight) continue;
+		}
+		else if (directive == "score_weight") {
+			if (stream >> loaded.scoreWeight) continue;
+		}
+		std::cout << "Ignoring invalid line " << lineNumber << " in " << path << "\n";
+	}
+
+	if (loaded.keys.empty()) {
+		std::cout << "No difficulty keys in " << path << ", using default curve\n";
+		return false;
+	}
+	loaded.setWeights(loaded.timeWeight, loaded.scoreWeight);
+	*this = std::move(loaded);
+	return true;
+}
+
+void DifficultyCurve::addKey(DifficultyKey key) {
+	if (!std::isfinite(key.progress) || !std::isfinite(key.speed) || !std::isfinite(key.minGap) || !std::isfinite(key.maxGap)) {
+		return;
+	}
+	key.speed = std::clamp(key.speed, 0.0f, Config::MAX_WORLD_SPEED);
+	key.minGap = std::max(key.minGap, Config::MIN_OBSTACLE_GAP_FLOOR);
+	key.maxGap = std::max(key.maxGap, key.minGap);
+
+	auto position = std::upper_bound(keys.begin(), keys.end(), key.progress,
+		[](float progress, const DifficultyKey& other) { return progress < other.progress; });
+	keys.insert(position, key);
+}
+
+void DifficultyCurve::clear() {
+	keys.clear();
+}
+
+void DifficultyCurve::setWeights(float time, float score) {
+	timeWeight = std::isfinite(time) ? std::max(time, 0.0f) : 0.0f;
+	scoreWeight = std::isfinite(score) ? std::max(score, 0.0f) : 0.0f;
+}
+
+float DifficultyCurve::getProgress(float elapsed, float score) const {
+	return elapsed * timeWeight + score * scoreWeight;
+}
+
+DifficultyKey DifficultyCurve::sampleAtDistance(double distance) const {
+	if (keys.empty()) {
+		return { 0.0f, Config::BASE_WORLD_SPEED, Config::MIN_OBSTACLE_DISTANCE, Config::MAX_OBSTACLE_DISTANCE };
+	}
+	const double rate = static_cast<double>(timeWeight) + scoreWeight;
+
+	// Do pierwszego punktu obowiązują jego wartości (jak w Difficulty::update()), dalej odcinki między punktami.
+	DifficultyKey from = keys.front();
+	double travelled = 0.0;
+	if (rate > 0.0 && from.progress > 0.0f) {
+		travelled = from.progress / rate * from.speed;
+		if (distance < travelled) {
+			from.progress = static_cast<float>(distance / from.speed * rate);
+			return from;
+		}
+	}
+	for (std::size_t i = 1; i < keys.size() && rate > 0.0; ++i) {
+		const DifficultyKey& to = keys[i];
+		if (to.progress > from.progress) {
+			const double duration = (static_cast<double>(to.progress) - from.progress) / rate;
+			const double length = duration * (static_cast<double>(from.speed) + to.speed) / 2.0;
+			if (distance - travelled < length) {
+				const double rest = std::max(distance - travelled, 0.0);
+				const double acceleration = (static_cast<double>(to.speed) - from.speed) / duration;
+				const double time = std::abs(acceleration) < 1e-9 ? rest / from.speed
+					: (std::sqrt(static_cast<double>(from.speed) * from.speed + 2.0 * acceleration * rest) - from.speed) / acceleration;
+				const float t = static_cast<float>(std::clamp(time / duration, 0.0, 1.0));
+				return { from.progress + (to.progress - from.progress) * t, from.speed + (to.speed - from.speed) * t,
+					from.minGap + (to.minGap - from.minGap) * t, from.maxGap + (to.maxGap - from.maxGap) * t };
+			}
+			travelled += length;
+		}
+		from = to;
+	}
+	return from;
+}
+
+namespace {
+	/**
+	 * @brief Zwraca krzywą z Config::DIFFICULTY_CURVE_FILE (lub domyślną), wczytaną przy pierwszym wywołaniu.
+	 * @return Krzywa współdzielona przez sterowniki.
+	 */
+	const std::shared_ptr<const DifficultyCurve>& configuredCurve() {
+		static const std::shared_ptr<const DifficultyCurve> shared = [] {
+			auto loaded = std::make_shared<DifficultyCurve>();
+			loaded->loadFromFile(Config::DIFFICULTY_CURVE_FILE);
+			return loaded;
+		}();
+		return shared;
+	}
+}
+
+Difficulty::Difficulty() : curve(configuredCurve()) {
+	reset();
+}
+
+void Difficulty::setCurve(const DifficultyCurve& newCurve) {
+	curve = std::make_shared<const DifficultyCurve>(newCurve);
+	reset();
+}
+
+void Difficulty::reset() {
+	cursor = 0;
+	elapsed = 0.0f;
+	const auto& keys = curve->getKeys();
+	if (!keys.empty()) {
+		current = keys.front();
+		current.progress = 0.0f;
+	}
+}
+
+bool Difficulty::setState(const DifficultyState& state) {
+	// Postęp nie jest ułamkiem - rośnie z czasem i wynikiem bez górnej granicy, więc sprawdzamy tylko znak.
+	auto valid = [](float value) { return std::isfinite(value) && value >= 0.0f; };
+	const DifficultyKey& key = state.current;
+	if (!valid(state.elapsed) || !valid(key.progress) || !valid(key.minGap) || !valid(key.maxGap)
+		|| !valid(key.speed) || key.speed > Config::MAX_WORLD_SPEED) {
+		return false;
+	}
+	const std::size_t keyCount = curve->getKeys().size();
+	cursor = keyCount > 0 ? std::min<std::size_t>(state.cursor, keyCount - 1) : 0;
+	elapsed = state.elapsed;
+	current = key;
+	return true;
+}
+
+void Difficulty::update(float deltaTime, float score) {
+	elapsed += deltaTime;
+	const auto& keys = curve->getKeys();
+	if (keys.empty()) return;
+
+	float progress = std::max(curve->getProgress(elapsed, score), current.progress);
+	if (!std::isfinite(progress)) return;
+	current.progress = progress;
+
+	// Postęp nie maleje, więc kursor przesuwa się tylko do przodu (zamortyzowane O(1)).
+	while (cursor + 1 < keys.size() && keys[cursor + 1].progress <= progress) {
+		++cursor;
+	}
+
+	const DifficultyKey& from = keys[cursor];
+	if (cursor + 1 >= keys.size() || progress <= from.progress) {
+		current.speed = from.speed;
+		current.minGap = from.minGap;
+		current.maxGap = from.maxGap;
+		return;
+	}
+
+	const DifficultyKey& to = keys[cursor + 1];
+	float t = (progress - from.progress) / (to.progress - from.progress);
+	current.speed = from.speed + (to.speed - from.speed) * t;
+	current.minGap = from.minGap + (to.minGap - from.minGap) * t;
+	current.maxGap = from.maxGap + (to.maxGap - from.maxGap) * t;
+}
@@ -0,0 +1,91 @@
+﻿/**
+ * @file DrawList.cpp
+ * @brief Implementacja listy poleceń rysowania.
+ */
+
+module;
+#include "raylib.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module DrawListModule;
+
+namespace {
+	/** @brief Największa liczba quadów wysyłana między sprawdzeniami miejsca w buforze rlgl. */
+	constexpr std::size_t QUADS_PER_BATCH = 1024;
+}
+
+void DrawList::clear() {
+	commands.clear();
+	texts.clear();
+}
+
+void DrawList::sprite(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint) {
+	commands.push_back({ texture, source, dest, tint, DrawKind::SPRITE, 0 });
+}
+
+void DrawList::text(std::string_view value, float x, float y, int fontSize, Color tint) {
+	const std::uint32_t offset = static_cast<std::uint32_t>(texts.size());
+	texts.append(value);
+	texts.push_back('\0');
+	commands.push_back({ Texture2D{}, Rectangle{}, Rectangle{ x, y, 0.f, static_cast<float>(fontSize) }, tint, DrawKind::TEXT, offset });
+}
+
+void DrawList::submit() const {
+	std::size_t i = 0;
+	while (i < commands.size()) {
+		const DrawCommand& first = commands[i];
+		if (first.kind == DrawKind::TEXT) {
+			DrawText(texts.c_str() + first.textOffset, static_cast<int>(first.dest.x), static_cast<int>(first.dest.y),
+				static_cast<int>(first.dest.height), first.tint);
+			++i;
+			continue;
+		}
+
+		std::size_t end = i + 1;
+		while (end < commands.size() && commands[end].kind == DrawKind::SPRITE && commands[end].texture.id == first.texture.id) {
+			++end;
+		}
+		// Tak jak DrawTexturePro pomijamy teksturę zastępczą bez danych.
+		if (first.texture.id == 0 || first.texture.width <= 0 || first.texture.height <= 0) {
+			i = end;
+			continue;
+		}
+
+		const float invWidth = 1.f / first.texture.width;
+		const float invHeight = 1.f / first.texture.height;
+		while (i < end) {
+			const std::size_t batchEnd = std::min(end, i + QUADS_PER_BATCH);
+			rlCheckRenderBatchLimit(static_cast<int>(batchEnd - i) * 4);
+			rlSetTexture(first.texture.id);
+			rlBegin(RL_QUADS);
+			rlNormal3f(0.f, 0.f, 1.f);
+			for (; i < batchEnd; ++i) {
+				const DrawCommand& command = commands[i];
+				const Rectangle& s = command.source;
+				const Rectangle& d = command.dest;
+				const float u0 = s.x * invWidth;
+				const float u1 = (s.x + s.width) * invWidth;
+				const float v0 = s.y * invHeight;
+				const float v1 = (s.y + s.height) * invHeight;
+				rlColor4ub(command.tint.r, command.tint.g, command.tint.b, command.tint.a);
+
+				rlTexCoord2f(u0, v0);
+				rlVertex2f(d.x, d.y);
+				rlTexCoord2f(u0, v1);
+				rlVertex2f(d.x, d.y + d.height);
+				rlTexCoord2f(u1, v1);
+				rlVertex2f(d.x + d.width, d.y + d.height);
+				rlTexCoord2f(u1, v0);
+				rlVertex2f(d.x + d.width, d.y);
+			}
+			rlEnd();
+			rlSetTexture(0);
+		}
+	}
+}
@@ -0,0 +1,198 @@
+﻿/**
+ * @file FramePacer.cpp
+ * @brief Implementacja klasy FramePacer.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+module FramePacerModule;
+
+import InputModule;
+import PlatformModule;
+
+void FramePacer::setMode(PacingMode newMode) {
+	if (newMode != mode) {
+		mode = newMode;
+		modeDirty = true;
+	}
+}
+
+void FramePacer::endFrame(FrameKind kind) {
+	if (modeDirty) {
+		// Oczekiwanie raylib jest aktywne (zajmuje rdzeń) - wyłączamy je i czekamy sami.
+		SetTargetFPS(0);
+		if (mode == PacingMode::VSYNC) {
+			SetWindowState(FLAG_VSYNC_HINT);
+		}
+		else {
+			ClearWindowState(FLAG_VSYNC_HINT);
+		}
+		modeDirty = false;
+		lastFrameEnd = Clock::now();
+		deadline = lastFrameEnd;
+		lastCpuSeconds = processCpuSeconds();
+	}
+
+	if (kind == FrameKind::MENU) {
+		idleTime = hasInput() ? 0.0f : idleTime + GetFrameTime();
+	}
+	else {
+		idleTime = 0.0f;
+	}
+	idle = kind == FrameKind::MENU && idleTime >= Config::IDLE_THROTTLE_DELAY;
+
+	const Clock::time_point now = Clock::now();
+	if (idle) {
+		// W trybie oszczędnym dokładność nie ma znaczenia - sam sen, bez aktywnego czekania.
+		deadline = lastFrameEnd + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / Config::IDLE_FPS));
+		std::this_thread::sleep_until(deadline);
+	}
+	else if (mode == PacingMode::CAPPED) {
+		const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / Config::TARGET_FPS));
+		deadline += period;
+		// Po dłuższym przestoju nie nadrabiamy klatek seriami - zaczynamy odliczanie od teraz.
+		if (deadline + period < now) {
+			deadline = now;
+		}
+		waitUntil(deadline);
+	}
+	else {
+		deadline = now;
+	}
+
+	const Clock::time_point end = Clock::now();
+	const double cpuSeconds = processCpuSeconds();
+	record(idle ? idleAccumulator : accumulators[static_cast<std::size_t>(mode)],
+		std::chrono::duration<double>(end - lastFrameEnd).count(), cpuSeconds - lastCpuSeconds);
+	lastFrameEnd = end;
+	lastCpuSeconds = cpuSeconds;
+}
+
+void FramePacer::waitUntil(Clock::time_point target) {
+	const auto margin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spinMargin));
+	const Clock::time_point sleepTarget = target - margin;
+	if (Clock::now() < sleepTarget) {
+		// W trakcie rozgrywki śpimy krótkimi odcinkami i między nimi próbkujemy klawiaturę,
+		// żeby wciśnięcie dostało dokładny czas zamiast czasu następnej klatki.
+		const auto slice = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Config::INPUT_SAMPLE_INTERVAL));
+		Clock::time_point sliceStart = Clock::now();
+		while (input().isCapturing() && sliceStart + slice < sleepTarget) {
+			std::this_thread::sleep_until(sliceStart + slice);
+			input().sample();
+			sliceStart = Clock::now();
+		}
+		if (sliceStart < sleepTarget) {
+			std::this_thread::sleep_until(sleepTarget);
+		}
+		// Margines dopasowuje się do tego, jak bardzo system spóźnia się z wybudzeniem.
+		const double oversleep = std::chrono::duration<double>(Clock::now() - sleepTarget).count();
+		spinMargin = std::clamp(spinMargin * 0.9 + (oversleep * 2.0 + 0.0002) * 0.1, 0.0002, 0.004);
+	}
+	while (Clock::now() < target) {
+		std::this_thread::yield();
+	}
+	input().sample();
+}
+
+bool FramePacer::hasInput() const {
+	Vector2 mouseDelta = GetMouseDelta();
+	if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f || GetMouseWheelMove() != 0.0f || IsWindowResized()) {
+		return true;
+	}
+	for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; ++button) {
+		if (IsMouseButtonDown(button)) return true;
+	}
+	// GetKeyPressed() opróżnia kolejkę klawiszy, z której korzystają ekrany - sprawdzamy tylko stan klawiszy.
+	for (int key = KEY_SPACE; key <= KEY_KB_MENU; ++key) {
+		if (IsKeyDown(key)) return true;
+	}
+	return IsGamepadAvailable(0) && GetGamepadButtonPressed() != GAMEPAD_BUTTON_UNKNOWN;
+}
+
+void FramePacer::record(Accumulator& accumulator, double frameSeconds, double cpuSeconds) {
+	accumulator.frames++;
+	accumulator.sum += frameSeconds;
+	accumulator.sumSquares += frameSeconds * frameSeconds;
+	accumulator.max = std::max(accumulator.max, frameSeconds);
+	accumulator.cpuSeconds += cpuSeconds;
+}
+
+FrameStats FramePacer::summarize(const Accumulator& accumulator) {
+	FrameStats stats;
+	stats.frames = accumulator.frames;
+	if (accumulator.frames == 0) {
+		return stats;
+	}
+	const double average = accumulator.sum / static_cast<double>(accumulator.frames);
+	const double variance = std::max(accumulator.sumSquares / static_cast<double>(accumulator.frames) - average * average, 0.0);
+	stats.averageMs = average * 1000.0;
+	stats.jitterMs = std::sqrt(variance) * 1000.0;
+	stats.maxMs = accumulator.max * 1000.0;
+	stats.cpuPercent = accumulator.sum > 0.0 ? accumulator.cpuSeconds / accumulator.sum * 100.0 : 0.0;
+	return stats;
+}
+
+FrameStats FramePacer::getStats(PacingMode statsMode) const {
+	return summarize(accumulators[static_cast<std::size_t>(statsMode)]);
+}
+
+FrameStats FramePacer::getIdleStats() const {
+	return summarize(idleAccumulator);
+}
+
+void FramePacer::resetStats() {
+	accumulators = {};
+	idleAccumulator = {};
+	lastFrameEnd = Clock::now();
+	lastCpuSeconds = processCpuSeconds();
+}
+
+void FramePacer::printReport() const {
+	std::cout << "mode        frames    avg(ms)  jitter(ms)  max(ms)   cpu(%)\n";
+	auto printRow = [](const char* name, const FrameStats& stats) {
+		if (stats.frames == 0) return;
+		std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(8) << stats.frames
+			<< std::setw(11) << stats.averageMs
+			<< std::setw(12) << stats.jitterMs
+			<< std::setw(9) << stats.maxMs
+			<< std::setw(9) << stats.cpuPercent << "\n";
+	};
+	for (PacingMode statsMode : { PacingMode::VSYNC, PacingMode::CAPPED, PacingMode::UNCAPPED }) {
+		printRow(pacingModeName(statsMode), getStats(statsMode));
+	}
+	printRow("menu-idle", getIdleStats());
+	std::cout.unsetf(std::ios::fixed);
+}
+
+FramePacer& framePacer() {
+	static FramePacer pacer;
+	return pacer;
+}
+
+bool parsePacingMode(std::string_view name, PacingMode& out) {
+	if (name == "vsync") out = PacingMode::VSYNC;
+	else if (name == "capped") out = PacingMode::CAPPED;
+	else if (name == "uncapped") out = PacingMode::UNCAPPED;
+	else return false;
+	return true;
+}
+
+const char* pacingModeName(PacingMode pacingMode) {
+	switch (pacingMode) {
+	case PacingMode::VSYNC: return "vsync";
+	case PacingMode::CAPPED: return "capped";
+	case PacingMode::UNCAPPED: return "uncapped";
+	}
+	return "unknown";
+}
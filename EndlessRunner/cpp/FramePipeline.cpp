@@ -0,0 +1,127 @@
+﻿/**
+ * @file FramePipeline.cpp
+ * @brief Implementacja potoku klatki.
+ */
+
+module;
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+module FramePipelineModule;
+
+namespace {
+	/** @brief Tryb dla kolejnych rozgrywek; na jednym rdzeniu wątek symulacji tylko dokłada przełączeń. */
+	PipelineMode selectedMode = std::thread::hardware_concurrency() > 1 ? PipelineMode::THREADED : PipelineMode::SERIAL;
+}
+
+FramePipeline::~FramePipeline() {
+	stop();
+}
+
+void FramePipeline::start(PipelineMode pipelineMode, Simulation simulation) {
+	stop();
+	mode = pipelineMode;
+	simulate = std::move(simulation);
+	presented = nullptr;
+	simulationTime = 0.0f;
+	for (DrawList& list : lists) {
+		list.clear();
+	}
+	requested.store(0, std::memory_order_relaxed);
+	completed.store(0, std::memory_order_relaxed);
+	stopping.store(false, std::memory_order_relaxed);
+	if (mode == PipelineMode::THREADED) {
+		worker = std::thread(&FramePipeline::run, this);
+	}
+}
+
+void FramePipeline::stop() {
+	sync();
+	if (!worker.joinable()) {
+		return;
+	}
+	stopping.store(true, std::memory_order_relaxed);
+	// Zmiana licznika budzi wątek czekający na kolejną klatkę; numer klatki nie ma już znaczenia.
+	requested.fetch_add(1, std::memory_order_release);
+	requested.notify_one();
+	worker.join();
+	requested.store(completed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void FramePipeline::kick() {
+	// Najwyżej jedna klatka w locie - inaczej symulacja pisałaby do listy, którą właśnie wysyłamy.
+	sync();
+	const std::uint32_t frame = requested.load(std::memory_order_relaxed) + 1;
+	DrawList& target = lists[frame & 1];
+
+	if (!worker.joinable()) {
+		simulateInto(target);
+		requested.store(frame, std::memory_order_relaxed);
+		completed.store(frame, std::memory_order_relaxed);
+		presented = &target;
+		return;
+	}
+
+	presented = frame > 1 ? &lists[(frame - 1) & 1] : nullptr;
+	requested.store(frame, std::memory_order_release);
+	requested.notify_one();
+}
+
+void FramePipeline::sync() {
+	const std::uint32_t target = requested.load(std::memory_order_relaxed);
+	std::uint32_t done = completed.load(std::memory_order_acquire);
+	while (done != target) {
+		completed.wait(done, std::memory_order_acquire);
+		done = completed.load(std::memory_order_acquire);
+	}
+}
+
+void FramePipeline::run() {
+	std::uint32_t done = 0;
+	while (true) {
+		requested.wait(done, std::memory_order_acquire);
+		if (stopping.load(std::memory_order_relaxed)) {
+			return;
+		}
+		const std::uint32_t frame = requested.load(std::memory_order_acquire);
+		simulateInto(lists[frame & 1]);
+		done = frame;
+		completed.store(frame, std::memory_order_release);
+		completed.notify_one();
+	}
+}
+
+void FramePipeline::simulateInto(DrawList& list) {
+	const auto start = std::chrono::steady_clock::now();
+	list.clear();
+	simulate(list);
+	simulationTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setPipelineMode(PipelineMode mode) {
+	selectedMode = mode;
+}
+
+PipelineMode getPipelineMode() {
+	return selectedMode;
+}
+
+bool parsePipelineMode(std::string_view name, PipelineMode& out) {
+	if (name == "serial") out = PipelineMode::SERIAL;
+	else if (name == "threaded") out = PipelineMode::THREADED;
+	else return false;
+	return true;
+}
+
+const char* pipelineModeName(PipelineMode pipelineMode) {
+	switch (pipelineMode) {
+	case PipelineMode::SERIAL: return "serial";
+	case PipelineMode::THREADED: return "threaded";
+	}
+	return "unknown";
+}
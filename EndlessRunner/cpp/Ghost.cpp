@@ -0,0 +1,349 @@
+﻿/**
+ * @file Ghost.cpp
+ * @brief Implementacja zapisu i odtwarzania duchów.
+ */
+
+module;
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+module GhostModule;
+
+namespace {
+	/** @brief Sygnatura pliku ducha. */
+	constexpr char GHOST_MAGIC[4] = { 'D', 'R', 'G', 'H' };
+	/** @brief Górna granica rozmiaru danych w pliku (chroni przed alokacją według uszkodzonego nagłówka). */
+	constexpr std::uint32_t MAX_GHOST_BYTES = 16u << 20;
+	/** @brief Górna granica skwantyzowanej wysokości (wpis zigzag przesunięty o bit musi zmieścić się w 32 bitach). */
+	constexpr std::int32_t MAX_QUANTIZED_HEIGHT = 1 << 24;
+
+	/** @brief Włączenie duchów dla kolejnych rozgrywek. */
+	bool enabled = true;
+
+	void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<std::uint8_t>(value));
+	}
+
+	bool readVarint(const std::uint8_t*& cursor, const std::uint8_t* end, std::uint32_t& out) {
+		out = 0;
+		for (int shift = 0; shift < 35 && cursor < end; shift += 7) {
+			const std::uint8_t byte = *cursor++;
+			out |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::uint32_t zigzag(std::int32_t value) {
+		return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+	}
+
+	std::int32_t unzigzag(std::uint32_t value) {
+		return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+	}
+
+	/**
+	 * @brief Przewiduje kolejną próbkę: na ziemi gracz zostaje na ziemi, w powietrzu leci po paraboli.
+	 * Koder i dekoder muszą używać tej samej funkcji.
+	 */
+	std::int32_t predict(std::int32_t previous, std::int32_t beforePrevious, std::int32_t gravityStep) {
+		if (previous <= 0) {
+			return 0;
+		}
+		return std::max(0, 2 * previous - beforePrevious - gravityStep);
+	}
+
+	/** @brief Przyrost prędkości opadania na próbkę przy bieżących ustawieniach (w krokach wysokości). */
+	std::int32_t gravityStep() {
+		return static_cast<std::int32_t>(std::lround(Config::GRAVITY * Config::GHOST_SAMPLE_INTERVAL
+			* Config::GHOST_SAMPLE_INTERVAL / Config::GHOST_HEIGHT_STEP));
+	}
+
+	bool validHeader(const GhostHeader& header) {
+		return std::memcmp(header.magic, GHOST_MAGIC, sizeof(GHOST_MAGIC)) == 0 && header.version == GHOST_VERSION
+			&& header.sampleInterval > 0.f && header.heightStep > 0.f
+			&& header.trajectoryBytes <= MAX_GHOST_BYTES && header.jumpBytes <= MAX_GHOST_BYTES;
+	}
+}
+
+GhostRun::GhostRun(const GhostHeader& runHeader, std::vector<std::uint8_t> encoded)
+	: header(runHeader), data(std::move(encoded)) {
+}
+
+bool GhostRun::load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+	GhostHeader loaded{};
+	if (!file.read(reinterpret_cast<char*>(&loaded), sizeof(loaded)) || !validHeader(loaded)) {
+		std::cout << "Ghost file " << path << " has unsupported format\n";
+		return false;
+	}
+	std::vector<std::uint8_t> encoded(static_cast<std::size_t>(loaded.trajectoryBytes) + loaded.jumpBytes);
+	if (!file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()))) {
+		std::cout << "Ghost file " << path << " is truncated\n";
+		return false;
+	}
+	header = loaded;
+	data = std::move(encoded);
+	return true;
+}
+
+bool GhostRun::save(const std::string& path) const {
+	const std::filesystem::path target(path);
+	std::error_code error;
+	if (target.has_parent_path()) {
+		std::filesystem::create_directories(target.parent_path(), error);
+	}
+
+	// Zapis do pliku obok i podmiana: przerwany zapis nie zostawi uszkodzonego ducha.
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			std::cout << "Cannot write ghost file " << temporary << "\n";
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!file) {
+			std::cout << "Cannot write ghost file " << temporary << "\n";
+			file.close();
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+	}
+	std::filesystem::rename(temporary, target, error);
+	if (error) {
+		std::cout << "Cannot replace ghost file " << path << ": " << error.message() << "\n";
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
+void GhostRecorder::begin(std::uint32_t courseSeed) {
+	trajectory.clear();
+	jumps.clear();
+	trajectory.reserve(Config::GHOST_RESERVE_BYTES);
+	jumps.reserve(Config::GHOST_RESERVE_BYTES / 4);
+	seed = courseSeed;
+	elapsed = 0.f;
+	nextSample = 0.f;
+	lastHeight = 0.f;
+	previous = 0;
+	beforePrevious = 0;
+	zeroRun = 0;
+	samples = 0;
+	jumpCount = 0;
+	lastJumpMs = 0;
+}
+
+void GhostRecorder::record(float deltaTime, float height, std::uint32_t totalJumps) {
+	if (deltaTime > 0.f) {
+		const float stepStart = elapsed;
+		elapsed += deltaTime;
+		// Próbki leżą w stałych odstępach; między końcami kroków symulacji wysokość jest interpolowana liniowo.
+		while (nextSample <= elapsed) {
+			const float t = (nextSample - stepStart) / deltaTime;
+			pushSample(lastHeight + (height - lastHeight) * t);
+			nextSample = samples * Config::GHOST_SAMPLE_INTERVAL;
+		}
+	}
+	lastHeight = height;
+
+	const std::uint32_t nowMs = static_cast<std::uint32_t>(std::lround(elapsed * 1000.f));
+	while (jumpCount < totalJumps) {
+		writeVarint(jumps, nowMs - lastJumpMs);
+		lastJumpMs = nowMs;
+		++jumpCount;
+	}
+}
+
+void GhostRecorder::pushSample(float height) {
+	const std::int32_t value = std::clamp(static_cast<std::int32_t>(std::lround(height / Config::GHOST_HEIGHT_STEP)),
+		0, MAX_QUANTIZED_HEIGHT);
+	const std::int32_t residual = value - predict(previous, beforePrevious, gravityStep());
+	if (residual == 0) {
+		++zeroRun;
+	}
+	else {
+		flushRun();
+		writeVarint(trajectory, zigzag(residual) << 1);
+	}
+	beforePrevious = previous;
+	previous = value;
+	++samples;
+}
+
+void GhostRecorder::flushRun() {
+	if (zeroRun > 0) {
+		writeVarint(trajectory, (zeroRun << 1) | 1);
+		zeroRun = 0;
+	}
+}
+
+GhostRun GhostRecorder::finish(int score) {
+	flushRun();
+	GhostHeader header{};
+	std::memcpy(header.magic, GHOST_MAGIC, sizeof(GHOST_MAGIC));
+	header.version = GHOST_VERSION;
+	header.seed = seed;
+	header.score = score;
+	header.sampleCount = samples;
+	header.jumpCount = jumpCount;
+	header.trajectoryBytes = static_cast<std::uint32_t>(trajectory.size());
+	header.jumpBytes = static_cast<std::uint32_t>(jumps.size());
+	header.sampleInterval = Config::GHOST_SAMPLE_INTERVAL;
+	header.heightStep = Config::GHOST_HEIGHT_STEP;
+	header.gravityStep = gravityStep();
+
+	std::vector<std::uint8_t> encoded;
+	encoded.reserve(trajectory.size() + jumps.size());
+	encoded.insert(encoded.end(), trajectory.begin(), trajectory.end());
+	encoded.insert(encoded.end(), jumps.begin(), jumps.end());
+	return GhostRun(header, std::move(encoded));
+}
+
+void GhostPlayer::start(const GhostRun& ghost) {
+	stop();
+	if (ghost.isEmpty()) {
+		return;
+	}
+	const GhostHeader& header = ghost.getHeader();
+	run = &ghost;
+	cursor = ghost.getData().data();
+	trajectoryEnd = cursor + header.trajectoryBytes;
+	jumpCursor = trajectoryEnd;
+	jumpEnd = jumpCursor + header.jumpBytes;
+	jumpsLeft = header.jumpCount;
+	readNextJump();
+}
+
+void GhostPlayer::stop() {
+	run = nullptr;
+	cursor = trajectoryEnd = jumpCursor = jumpEnd = nullptr;
+	previous = 0;
+	beforePrevious = 0;
+	zeroRun = 0;
+	decoded = 0;
+	elapsed = 0.f;
+	nextJumpMs = 0;
+	jumpsLeft = 0;
+}
+
+bool GhostPlayer::decodeNext() {
+	const GhostHeader& header = run->getHeader();
+	if (decoded == header.sampleCount) {
+		return false;
+	}
+	std::int32_t residual = 0;
+	if (zeroRun > 0) {
+		--zeroRun;
+	}
+	else {
+		std::uint32_t token = 0;
+		if (!readVarint(cursor, trajectoryEnd, token)) {
+			return false;
+		}
+		if (token & 1) {
+			zeroRun = token >> 1;
+			if (zeroRun == 0) {
+				return false;
+			}
+			--zeroRun;
+		}
+		else {
+			residual = unzigzag(token >> 1);
+		}
+	}
+	const std::int32_t value = predict(previous, beforePrevious, header.gravityStep) + residual;
+	beforePrevious = previous;
+	previous = value;
+	++decoded;
+	return true;
+}
+
+void GhostPlayer::readNextJump() {
+	std::uint32_t delta = 0;
+	if (jumpsLeft == 0 || !readVarint(jumpCursor, jumpEnd, delta)) {
+		jumpsLeft = 0;
+		return;
+	}
+	nextJumpMs += delta;
+}
+
+GhostFrame GhostPlayer::advance(float deltaTime) {
+	GhostFrame frame;
+	if (run == nullptr) {
+		return frame;
+	}
+	const GhostHeader& header = run->getHeader();
+	elapsed += deltaTime;
+
+	// Dekodujemy tylko tyle, żeby ostatnia próbka nie leżała przed bieżącą chwilą.
+	while (decoded == 0 || (decoded - 1) * header.sampleInterval < elapsed) {
+		if (!decodeNext()) {
+			stop();
+			return frame;
+		}
+	}
+	const float sampleTime = (decoded - 1) * header.sampleInterval;
+	const float t = decoded > 1 ? std::clamp(1.f - (sampleTime - elapsed) / header.sampleInterval, 0.f, 1.f) : 1.f;
+	frame.height = (beforePrevious + (previous - beforePrevious) * t) * header.heightStep;
+
+	const std::uint32_t elapsedMs = static_cast<std::uint32_t>(std::lround(elapsed * 1000.f));
+	while (jumpsLeft > 0 && nextJumpMs <= elapsedMs) {
+		++frame.jumps;
+		--jumpsLeft;
+		readNextJump();
+	}
+	frame.active = true;
+	return frame;
+}
+
+std::string ghostPath(const std::string& username) {
+	std::string name = username;
+	for (char& c : name) {
+		const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+		if (!safe) {
+			c = '_';
+		}
+	}
+	return (std::filesystem::path(Config::GHOST_DIRECTORY) / (name + ".ghost")).string();
+}
+
+bool readGhostHeader(const std::string& path, GhostHeader& out) {
+	std::ifstream file(path, std::ios::binary);
+	GhostHeader header{};
+	if (!file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !validHeader(header)) {
+		return false;
+	}
+	out = header;
+	return true;
+}
+
+void setGhostsEnabled(bool value) {
+	enabled = value;
+}
+
+bool ghostsEnabled() {
+	return enabled;
+}
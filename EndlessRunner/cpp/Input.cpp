@@ -0,0 +1,388 @@
+﻿/**
+ * @file Input.cpp
+ * @brief Implementacja warstwy wejścia.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module InputModule;
+
+import PlatformModule;
+
+namespace {
+	/** @brief Nazwy akcji w kolejności InputAction. */
+	constexpr const char* ACTION_NAMES[] = { "jump", "confirm", "back", "jump2", "jump3", "jump4" };
+
+	/** @brief Po tylu klatkach wciśnięcie złapane przez próbkowanie przestaje czekać na zgłoszenie raylib. */
+	constexpr std::uint64_t UNMATCHED_FRAMES = 2;
+
+	/**
+	 * @struct NamedInput
+	 * @brief Nazwa klawisza lub przycisku używana w pliku przypisań.
+	 */
+	struct NamedInput {
+		const char* name;
+		InputDevice device;
+		int code;
+	};
+
+	/** @brief Nazwy klawiszy innych niż litery i cyfry oraz przycisków pada. */
+	constexpr NamedInput INPUT_NAMES[] = {
+		{ "SPACE", InputDevice::KEYBOARD, KEY_SPACE },
+		{ "ENTER", InputDevice::KEYBOARD, KEY_ENTER },
+		{ "ESCAPE", InputDevice::KEYBOARD, KEY_ESCAPE },
+		{ "TAB", InputDevice::KEYBOARD, KEY_TAB },
+		{ "BACKSPACE", InputDevice::KEYBOARD, KEY_BACKSPACE },
+		{ "UP", InputDevice::KEYBOARD, KEY_UP },
+		{ "DOWN", InputDevice::KEYBOARD, KEY_DOWN },
+		{ "LEFT", InputDevice::KEYBOARD, KEY_LEFT },
+		{ "RIGHT", InputDevice::KEYBOARD, KEY_RIGHT },
+		{ "LEFT_SHIFT", InputDevice::KEYBOARD, KEY_LEFT_SHIFT },
+		{ "RIGHT_SHIFT", InputDevice::KEYBOARD, KEY_RIGHT_SHIFT },
+		{ "LEFT_CONTROL", InputDevice::KEYBOARD, KEY_LEFT_CONTROL },
+		{ "RIGHT_CONTROL", InputDevice::KEYBOARD, KEY_RIGHT_CONTROL },
+		{ "PAD_A", InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_DOWN },
+		{ "PAD_B", InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT },
+		{ "PAD_X", InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_LEFT },
+		{ "PAD_Y", InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_UP },
+		{ "PAD_UP", InputDevice::GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_UP },
+		{ "PAD_DOWN", InputDevice::GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_DOWN },
+		{ "PAD_LEFT", InputDevice::GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_LEFT },
+		{ "PAD_RIGHT", InputDevice::GAMEPAD, GAMEPAD_BUTTON_LEFT_FACE_RIGHT },
+		{ "PAD_START", InputDevice::GAMEPAD, GAMEPAD_BUTTON_MIDDLE_RIGHT },
+		{ "PAD_SELECT", InputDevice::GAMEPAD, GAMEPAD_BUTTON_MIDDLE_LEFT },
+		{ "PAD_LB", InputDevice::GAMEPAD, GAMEPAD_BUTTON_LEFT_TRIGGER_1 },
+		{ "PAD_RB", InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_TRIGGER_1 },
+	};
+
+	/** @brief Pierwszy pad (raylib numeruje pady od zera). */
+	constexpr int GAMEPAD_INDEX = 0;
+}
+
+InputSystem::InputSystem() {
+	resetBindings();
+}
+
+double InputSystem::now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputSystem::resetBindings() {
+	setBindings(InputAction::JUMP, { { InputDevice::KEYBOARD, KEY_SPACE }, { InputDevice::KEYBOARD, KEY_UP },
+		{ InputDevice::KEYBOARD, KEY_W }, { InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_DOWN } });
+	setBindings(InputAction::CONFIRM, { { InputDevice::KEYBOARD, KEY_ENTER }, { InputDevice::GAMEPAD, GAMEPAD_BUTTON_MIDDLE_RIGHT } });
+	setBindings(InputAction::BACK, { { InputDevice::KEYBOARD, KEY_ESCAPE }, { InputDevice::GAMEPAD, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT } });
+	// Kolejni gracze dzielą klawiaturę, więc ich klawisze nie pokrywają się z klawiszami pierwszego.
+	setBindings(InputAction::JUMP_2, { { InputDevice::KEYBOARD, KEY_RIGHT_SHIFT }, { InputDevice::KEYBOARD, KEY_RIGHT_CONTROL } });
+	setBindings(InputAction::JUMP_3, { { InputDevice::KEYBOARD, KEY_L } });
+	setBindings(InputAction::JUMP_4, { { InputDevice::KEYBOARD, KEY_B } });
+}
+
+bool InputSystem::loadBindings(const std::string& path) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		std::cout << "Controls file " << path << " not found, using defaults\n";
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::istringstream iss(line);
+		std::string name;
+		InputAction action;
+		if (!(iss >> name) || !parseInputAction(name, action)) {
+			std::cout << "Controls: unknown action in line \"" << line << "\"\n";
+			continue;
+		}
+		std::vector<InputBinding> actionBindings;
+		std::string key;
+		while (iss >> key) {
+			InputBinding binding;
+			if (!parseInputBinding(key, binding)) {
+				std::cout << "Controls: unknown key " << key << " for " << name << "\n";
+				continue;
+			}
+			actionBindings.push_back(binding);
+		}
+		if (actionBindings.empty()) {
+			std::cout << "Controls: no valid keys for " << name << ", keeping defaults\n";
+			continue;
+		}
+		setBindings(action, actionBindings);
+	}
+	return true;
+}
+
+bool InputSystem::saveBindings(const std::string& path) const {
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		std::cout << "Cannot write controls file " << path << "\n";
+		return false;
+	}
+	file << "# akcja klawisze... (np. SPACE, UP, W, 7, PAD_A)\n";
+	for (std::size_t i = 0; i < bindings.size(); ++i) {
+		file << ACTION_NAMES[i];
+		for (const InputBinding& binding : bindings[i]) {
+			file << ' ' << inputBindingName(binding);
+		}
+		file << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+void InputSystem::setBindings(InputAction action, const std::vector<InputBinding>& actionBindings) {
+	std::vector<InputBinding>& target = bindings[static_cast<std::size_t>(action)];
+	target.clear();
+	for (const InputBinding& binding : actionBindings) {
+		if (target.size() == MAX_BINDINGS) {
+			break;
+		}
+		const bool validKey = binding.device == InputDevice::KEYBOARD && binding.code > 0 && binding.code < static_cast<int>(KEY_CODES);
+		if (validKey || binding.device == InputDevice::GAMEPAD) {
+			target.push_back(binding);
+		}
+	}
+	rebuildKeys();
+}
+
+void InputSystem::rebuildKeys() {
+	boundKeys.clear();
+	for (const auto& actionBindings : bindings) {
+		for (const InputBinding& binding : actionBindings) {
+			if (binding.device == InputDevice::KEYBOARD && !isBound(binding.code)) {
+				boundKeys.push_back(binding.code);
+			}
+		}
+	}
+}
+
+bool InputSystem::isBound(int key) const {
+	return std::find(boundKeys.begin(), boundKeys.end(), key) != boundKeys.end();
+}
+
+void InputSystem::setCapturing(bool enabled) {
+	capturing = enabled;
+	queueHead = 0;
+	queueTail = 0;
+	keys = {};
+	if (enabled) {
+		// Wciśnięcia sprzed rozgrywki (np. kliknięcie w menu) nie mogą trafić do kolejki.
+		while (GetKeyPressed() != 0) {}
+		readKeys(now(), false);
+	}
+}
+
+void InputSystem::readKeys(double time, bool record) {
+	const std::intptr_t window = reinterpret_cast<std::intptr_t>(GetWindowHandle());
+	for (int key : boundKeys) {
+		bool down = false;
+		if (!readKeyAsync(key, window, down)) {
+			continue;
+		}
+		KeyState& state = keys[static_cast<std::size_t>(key)];
+		if (record && down && !state.down) {
+			pushKey(key, time, true);
+			++state.unmatched;
+			state.unmatchedFrame = frame;
+		}
+		state.down = down;
+	}
+}
+
+void InputSystem::sample() {
+	if (capturing) {
+		readKeys(now(), true);
+	}
+}
+
+void InputSystem::beginFrame() {
+	++frame;
+	if (!capturing) {
+		return;
+	}
+	const double time = now();
+
+	// raylib zgłasza każde wciśnięcie raz; te, które próbkowanie już zapisało, tylko odliczamy.
+	int key = 0;
+	while ((key = GetKeyPressed()) != 0) {
+		if (key < 0 || key >= static_cast<int>(KEY_CODES) || !isBound(key)) {
+			continue;
+		}
+		KeyState& state = keys[static_cast<std::size_t>(key)];
+		if (state.unmatched > 0) {
+			--state.unmatched;
+			continue;
+		}
+		pushKey(key, time, false);
+	}
+	for (int boundKey : boundKeys) {
+		KeyState& state = keys[static_cast<std::size_t>(boundKey)];
+		if (state.unmatched > 0 && frame - state.unmatchedFrame > UNMATCHED_FRAMES) {
+			state.unmatched = 0;
+		}
+	}
+
+	if (!IsGamepadAvailable(GAMEPAD_INDEX)) {
+		return;
+	}
+	for (std::size_t i = 0; i < bindings.size(); ++i) {
+		for (const InputBinding& binding : bindings[i]) {
+			if (binding.device == InputDevice::GAMEPAD && IsGamepadButtonPressed(GAMEPAD_INDEX, binding.code)) {
+				push({ static_cast<InputAction>(i), time, false });
+				break;
+			}
+		}
+	}
+}
+
+void InputSystem::pushKey(int key, double time, bool precise) {
+	for (std::size_t i = 0; i < bindings.size(); ++i) {
+		for (const InputBinding& binding : bindings[i]) {
+			if (binding.device == InputDevice::KEYBOARD && binding.code == key) {
+				push({ static_cast<InputAction>(i), time, precise });
+				break;
+			}
+		}
+	}
+}
+
+void InputSystem::push(const InputEvent& event) {
+	if (queueHead - queueTail >= QUEUE_SIZE) {
+		++dropped;
+		return;
+	}
+	queue[queueHead & (QUEUE_SIZE - 1)] = event;
+	++queueHead;
+}
+
+bool InputSystem::poll(InputEvent& out) {
+	if (queueTail == queueHead) {
+		return false;
+	}
+	out = queue[queueTail & (QUEUE_SIZE - 1)];
+	++queueTail;
+	return true;
+}
+
+bool InputSystem::wasPressed(InputAction action) const {
+	for (const InputBinding& binding : bindings[static_cast<std::size_t>(action)]) {
+		if (binding.device == InputDevice::KEYBOARD) {
+			if (IsKeyPressed(binding.code)) {
+				return true;
+			}
+		}
+		else if (IsGamepadAvailable(GAMEPAD_INDEX) && IsGamepadButtonPressed(GAMEPAD_INDEX, binding.code)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void InputSystem::recordLatency(const InputEvent& event, double simulationTime, double correction) {
+	++latencyEvents;
+	// Czas zdarzenia z granicy klatki to beginFrame(), a nie chwila wciśnięcia - nie mierzy opóźnienia.
+	if (!event.precise) {
+		return;
+	}
+	const double latency = std::max(0.0, simulationTime - event.time);
+	latencySum += latency;
+	latencyMax = std::max(latencyMax, latency);
+	correctionSum += correction;
+	++latencyPrecise;
+}
+
+InputLatencyStats InputSystem::getLatencyStats() const {
+	InputLatencyStats stats;
+	stats.events = latencyEvents;
+	stats.precise = latencyPrecise;
+	if (latencyPrecise > 0) {
+		stats.averageMs = latencySum / latencyPrecise * 1000.0;
+		stats.maxMs = latencyMax * 1000.0;
+		stats.averageCorrectionMs = correctionSum / latencyPrecise * 1000.0;
+	}
+	return stats;
+}
+
+void InputSystem::printReport() const {
+	const InputLatencyStats stats = getLatencyStats();
+	if (stats.events == 0 && dropped == 0) {
+		return;
+	}
+	std::cout << "Input: " << stats.events << " events, " << stats.events - stats.precise
+		<< " at frame boundaries (no latency measured), " << stats.precise << " sampled between frames: latency avg "
+		<< stats.averageMs << " ms, max " << stats.maxMs << " ms, sub-frame correction avg "
+		<< stats.averageCorrectionMs << " ms; dropped " << dropped << "\n";
+}
+
+InputSystem& input() {
+	static InputSystem instance;
+	return instance;
+}
+
+bool parseInputAction(std::string_view name, InputAction& out) {
+	for (std::size_t i = 0; i < std::size(ACTION_NAMES); ++i) {
+		if (name == ACTION_NAMES[i]) {
+			out = static_cast<InputAction>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* inputActionName(InputAction action) {
+	const std::size_t index = static_cast<std::size_t>(action);
+	return index < std::size(ACTION_NAMES) ? ACTION_NAMES[index] : "unknown";
+}
+
+int jumpActionPlayer(InputAction action) {
+	switch (action) {
+	case InputAction::JUMP: return 0;
+	case InputAction::JUMP_2: return 1;
+	case InputAction::JUMP_3: return 2;
+	case InputAction::JUMP_4: return 3;
+	default: return -1;
+	}
+}
+
+bool parseInputBinding(std::string_view name, InputBinding& out) {
+	if (name.size() == 1 && ((name[0] >= 'A' && name[0] <= 'Z') || (name[0] >= '0' && name[0] <= '9'))) {
+		// Kody raylib liter i cyfr to ich kody ASCII.
+		out = { InputDevice::KEYBOARD, name[0] };
+		return true;
+	}
+	for (const NamedInput& named : INPUT_NAMES) {
+		if (name == named.name) {
+			out = { named.device, named.code };
+			return true;
+		}
+	}
+	return false;
+}
+
+std::string inputBindingName(const InputBinding& binding) {
+	if (binding.device == InputDevice::KEYBOARD
+		&& ((binding.code >= 'A' && binding.code <= 'Z') || (binding.code >= '0' && binding.code <= '9'))) {
+		return std::string(1, static_cast<char>(binding.code));
+	}
+	for (const NamedInput& named : INPUT_NAMES) {
+		if (named.device == binding.device && named.code == binding.code) {
+			return named.name;
+		}
+	}
+	return {};
+}
@@ -0,0 +1,75 @@
+﻿/**
+ * @file Layout.cpp
+ * @brief Implementacja klasy Layout.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+module LayoutModule;
+
+int Layout::add(const LayoutSpec& spec, int parent) {
+	nodes.push_back(Node{ spec, parent, Rectangle{ 0, 0, 0, 0 } });
+	// Nowy element nie ma jeszcze prostokąta - wymusza przeliczenie przy najbliższym refresh().
+	width = -1;
+	return static_cast<int>(nodes.size()) - 1;
+}
+
+bool Layout::refresh() {
+	// Rozmiar jest porównywany także poza klatką zmiany - ekran mógł być przykryty inną sceną, gdy okno zmieniało rozmiar.
+	if (!IsWindowResized() && GetScreenWidth() == width && GetScreenHeight() == height) {
+		return false;
+	}
+	return refresh(GetScreenWidth(), GetScreenHeight());
+}
+
+bool Layout::refresh(int screenWidth, int screenHeight) {
+	if (screenWidth == width && screenHeight == height) {
+		return false;
+	}
+	width = screenWidth;
+	height = screenHeight;
+
+	const Rectangle screen{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) };
+	for (Node& node : nodes) {
+		const Rectangle& parent = node.parent == ROOT ? screen : nodes[node.parent].rect;
+		const LayoutSpec& spec = node.spec;
+
+		float w = spec.size.x + spec.relativeSize.x * parent.width;
+		float h = spec.size.y + spec.relativeSize.y * parent.height;
+		if (spec.aspect > 0.f && w > 0.f && h > 0.f) {
+			// Dopasowanie do proporcji: element mieści się w wyznaczonym polu i zachowuje kształt tekstury.
+			w = std::min(w, h * spec.aspect);
+			h = w / spec.aspect;
+		}
+
+		node.rect = Rectangle{
+			parent.x + spec.anchor.x * parent.width - spec.pivot.x * w + spec.offset.x,
+			parent.y + spec.anchor.y * parent.height - spec.pivot.y * h + spec.offset.y,
+			w,
+			h
+		};
+	}
+	hoverValid = false;
+	return true;
+}
+
+int Layout::hover(Vector2 mouse) {
+	if (hoverValid && mouse.x == lastMouse.x && mouse.y == lastMouse.y) {
+		return lastHover;
+	}
+	lastMouse = mouse;
+	lastHover = -1;
+	// Elementy dodane później leżą wyżej, więc wygrywa ostatni trafiony.
+	for (std::size_t i = nodes.size(); i-- > 0;) {
+		if (nodes[i].spec.interactive && CheckCollisionPointRec(mouse, nodes[i].rect)) {
+			lastHover = static_cast<int>(i);
+			break;
+		}
+	}
+	hoverValid = true;
+	return lastHover;
+}
@@ -1,367 +1,305 @@
 /**
  * @file LoadingScreen.cpp
- * @brief Implementacja klasy LoadingScreen.
+ * @brief Implementacja scen ekranu ładowania i uwierzytelniania.
  */
 
 module;
 #include "raylib.h"
 #include <string>
 #include <chrono>
+#include <memory>
+#include <algorithm>
+#include <future>
 
 module LoadingScreenModule;
 
+import MenuModule;
+import AudioModule;
 
-std::string LoadingScreen::show(int screenWidth, int screenHeight, Resources& resources, Board& board, Shop& shop) {
-	auto startTime = std::chrono::high_resolution_clock::now();
-	const int loadingDuration = Config::LOADING_DURATION_MS;
 
-	resources.loadTextures();
+void LoadingScreen::enter(SceneManager& scenes) {
+	startTime = std::chrono::steady_clock::now();
+
+	resources.beginLoading();
 
 	barEmpty = resources.getBarEmpty();
 	barFill = resources.getBarFill();
 
-	shop.init(resources, screenWidth, screenHeight);
-
-	while (!loadingFinished && !WindowShouldClose()) {
-		screenWidth = GetScreenWidth();
-		screenHeight = GetScreenHeight();
+	scenes.addTask([&res = resources](double budgetSeconds) { return res.loadNext(budgetSeconds); });
+}
 
-		auto now = std::chrono::high_resolution_clock::now();
-		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
-		float loadingProgress = static_cast<float>(duration.count()) / loadingDuration;
+void LoadingScreen::update(SceneManager& scenes, float deltaTime) {
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	float timeProgress = static_cast<float>(duration.count()) / Config::LOADING_DURATION_MS;
 
-		if (loadingProgress > 1.f) {
-			loadingProgress = 1.f;
-			loadingFinished = true;
-		}
+	// Pasek nie wyprzedza ani faktycznego wczytywania, ani minimalnego czasu wyświetlania ekranu.
+	loadingProgress = std::min({ resources.getLoadingProgress(), timeProgress, 1.0f });
 
-		BeginDrawing();
-		DrawTexturePro(
-			resources.getLoadingScreenBackground(),
-			Rectangle{ 0,0, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
-			Rectangle{ 0,0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0,0 },
-			0.0f,
-			WHITE
-		);
+	if (loadingProgress >= 1.0f) {
+		shop.init(resources, GetScreenWidth(), GetScreenHeight());
+		scenes.replace(std::make_unique<AuthScreen>(resources, board, shop));
+	}
+}
 
-		int barX = screenWidth / 2 - barEmpty.width / 2;
-		int barY = screenHeight / 2 + 230;
+void LoadingScreen::render() {
+	int screenWidth = GetScreenWidth();
+	int screenHeight = GetScreenHeight();
 
-		DrawText("Loading...", screenWidth / 2 - MeasureText("Loading...", 20) / 2, barY - 30, 20, BLACK);
-		DrawTexture(barEmpty, barX, barY, BLACK);
+	DrawTexturePro(
+		resources.getLoadingScreenBackground(),
+		Rectangle{ 0,0, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
+		Rectangle{ 0,0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
+		Vector2{ 0,0 },
+		0.0f,
+		WHITE
+	);
 
-		Rectangle source = { 0,0, barFill.width * loadingProgress, static_cast<float>(barFill.height) };
-		Rectangle dest = { static_cast<float>(barX), static_cast<float>(barY), barFill.width * loadingProgress, static_cast<float>(barFill.height) };
-		DrawTexturePro(barFill, source, dest, { 0,0 }, 0.0f, WHITE);
+	int barX = screenWidth / 2 - barEmpty.width / 2;
+	int barY = screenHeight / 2 + 230;
 
-		EndDrawing();
-	}
+	DrawText("Loading...", screenWidth / 2 - MeasureText("Loading...", 20) / 2, barY - 30, 20, BLACK);
+	DrawTexture(barEmpty, barX, barY, BLACK);
 
-	//UnloadTexture(barEmpty);
-	//UnloadTexture(barFill);
+	Rectangle source = { 0,0, barFill.width * loadingProgress, static_cast<float>(barFill.height) };
+	Rectangle dest = { static_cast<float>(barX), static_cast<float>(barY), barFill.width * loadingProgress, static_cast<float>(barFill.height) };
+	DrawTexturePro(barFill, source, dest, { 0,0 }, 0.0f, WHITE);
+}
 
-	if (loadingFinished) {
-		return showAuthTiles(screenWidth, screenHeight, resources, board, shop);
-	}
-	return "";
+AuthScreen::AuthScreen(Resources& res, Board& b, Shop& s) : resources(res), board(b), shop(s) {
+	const Vector2 buttonSize{ Config::AUTH_BUTTON_WIDTH, Config::AUTH_BUTTON_HEIGHT };
+	signInNode = layout.add(LayoutSpec{
+		.anchor = { 0.25f, 0.85f }, .pivot = { 0.5f, 0.5f }, .size = buttonSize, .interactive = true });
+	logInNode = layout.add(LayoutSpec{
+		.anchor = { 0.75f, 0.85f }, .pivot = { 0.5f, 0.5f }, .size = buttonSize, .interactive = true });
 }
 
-std::string LoadingScreen::showAuthTiles(int screenWidth, int screenHeight, Resources& resources, Board& board, Shop& shop) {
-	constexpr float btnW = Config::AUTH_BUTTON_WIDTH;
-	constexpr float btnH = Config::AUTH_BUTTON_HEIGHT;
-
-	float xLeft = screenWidth * 0.25f - btnW * 0.5f;
-	float xRight = screenWidth * 0.75f - btnW * 0.5f;
-
-	float btnY = screenHeight * 0.85f - btnH * 0.5f;
-
-	Rectangle signInButton = { xLeft, btnY, btnW, btnH };
-	Rectangle logInButton = { xRight, btnY, btnW, btnH };
-
-	while (!WindowShouldClose()) {
-		Vector2 mouse = GetMousePosition();
-
-		BeginDrawing();
-		ClearBackground(RAYWHITE);
-		DrawTexturePro(
-			resources.getLoadingScreenBackground(),
-			Rectangle{ 0.f,0.f, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
-			Rectangle{ 0.f,0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0.f,0.f },
-			0.0f,
-			WHITE
-		);
-
-		Texture2D buttonTex = resources.getButtonTexture();
-		Color signInColor = CheckCollisionPointRec(mouse, signInButton) ? GRAY : WHITE;
-		DrawTexturePro(
-			buttonTex,
-			Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-			signInButton,
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			signInColor
-		);
-		DrawText("Sign In", static_cast<int>(signInButton.x + (signInButton.width - MeasureText("Sign In", 20)) / 2), static_cast<int>(signInButton.y + 30), 20, BLACK);
-
-		Color logInColor = CheckCollisionPointRec(mouse, logInButton) ? GRAY : WHITE;
-		DrawTexturePro(
-			buttonTex,
-			Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-			logInButton,
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			logInColor
-		);
-		DrawText("Log In", static_cast<int>(logInButton.x + (logInButton.width - MeasureText("Log In", 20)) / 2), static_cast<int>(logInButton.y + 30), 20, BLACK);
-
-		if (CheckCollisionPointRec(mouse, signInButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-			std::string username = handleSignIn(screenWidth, screenHeight, resources);
-			if (!username.empty()) {
-				return username;
-			}
-		}
-		if (CheckCollisionPointRec(mouse, logInButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-			std::string username = handleLogIn(screenWidth, screenHeight, resources);
-			if (!username.empty()) {
-				return username;
-			}
-		}
+void AuthScreen::update(SceneManager& scenes, float deltaTime) {
+	layout.refresh();
 
-		EndDrawing();
+	const int hovered = layout.hover(GetMousePosition());
+	if (hovered == signInNode && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+		audio().play(Sfx::CLICK);
+		scenes.push(std::make_unique<CredentialsScreen>(CredentialsScreen::Mode::SIGN_IN, resources, board, shop));
+	}
+	if (hovered == logInNode && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+		audio().play(Sfx::CLICK);
+		scenes.push(std::make_unique<CredentialsScreen>(CredentialsScreen::Mode::LOG_IN, resources, board, shop));
 	}
-	return "";
 }
 
+void AuthScreen::render() {
+	int screenWidth = GetScreenWidth();
+	int screenHeight = GetScreenHeight();
+	const int hovered = layout.hover(GetMousePosition());
+	const Rectangle& signInButton = layout.rect(signInNode);
+	const Rectangle& logInButton = layout.rect(logInNode);
+
+	ClearBackground(RAYWHITE);
+	DrawTexturePro(
+		resources.getLoadingScreenBackground(),
+		Rectangle{ 0.f,0.f, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
+		Rectangle{ 0.f,0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
+		Vector2{ 0.f,0.f },
+		0.0f,
+		WHITE
+	);
+
+	Texture2D buttonTex = resources.getButtonTexture();
+	Color signInColor = hovered == signInNode ? GRAY : WHITE;
+	DrawTexturePro(
+		buttonTex,
+		Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
+		signInButton,
+		Vector2{ 0.f, 0.f },
+		0.0f,
+		signInColor
+	);
+	DrawText("Sign In", static_cast<int>(signInButton.x + (signInButton.width - MeasureText("Sign In", 20)) / 2), static_cast<int>(signInButton.y + 30), 20, BLACK);
+
+	Color logInColor = hovered == logInNode ? GRAY : WHITE;
+	DrawTexturePro(
+		buttonTex,
+		Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
+		logInButton,
+		Vector2{ 0.f, 0.f },
+		0.0f,
+		logInColor
+	);
+	DrawText("Log In", static_cast<int>(logInButton.x + (logInButton.width - MeasureText("Log In", 20)) / 2), static_cast<int>(logInButton.y + 30), 20, BLACK);
+}
 
-std::string LoadingScreen::handleSignIn(int screenWidth, int screenHeight, Resources& resources) {
-	Authorization auth;
-	std::string username, password;
-	std::string errorMessage;
-	bool usernameError = false;
-	bool passwordError = false;
-	bool validInput = false;
-	bool enteringUsername = true;
-	Rectangle submitButton = { static_cast<float>(screenWidth / 2 - 100), static_cast<float>(screenHeight / 2 + 200), 200, 60 };
-
-	while (!WindowShouldClose() && !validInput) {
-		BeginDrawing();
-		DrawTexturePro(
-			resources.getRegistrationBackground(),
-			Rectangle{ 0.f, 0.f, static_cast<float>(resources.getRegistrationBackground().width), static_cast<float>(resources.getRegistrationBackground().height) },
-			Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			WHITE
-		);
-
-		Color usernameBorder = usernameError ? RED : (enteringUsername ? GREEN : BLACK);
-		DrawText("Enter Username (3-20 chars, alphanumeric):", screenWidth / 2 - 220, screenHeight / 2 - 60, 20, usernameBorder);
-		DrawText(username.c_str(), screenWidth / 2 - 150, screenHeight / 2 - 40, 20, BLACK);
-		DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 - 40, 400, 30, usernameBorder);
-
-		Color passwordBorder = passwordError ? RED : (!enteringUsername ? GREEN : BLACK);
-		DrawText("Enter Password (8+ chars, letters and numbers):", screenWidth / 2 - 220, screenHeight / 2 + 10, 20, passwordBorder);
-		std::string maskedPassword(password.length(), '*');
-		DrawText(maskedPassword.c_str(), screenWidth / 2 - 150, screenHeight / 2 + 40, 20, BLACK);
-		DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 + 40, 400, 30, passwordBorder);
-
-		Texture2D buttonTex = resources.getButtonTexture();
-		Vector2 mouse = GetMousePosition();
-		Color submitColor = CheckCollisionPointRec(mouse, submitButton) ? GRAY : WHITE;
-		DrawTexturePro(
-			buttonTex,
-			Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-			submitButton,
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			submitColor
-		);
-		DrawText("Submit", static_cast<int>(submitButton.x + (submitButton.width - MeasureText("Submit", 20)) / 2), static_cast<int>(submitButton.y + 20), 20, BLACK);
-
-		if (!errorMessage.empty()) {
-			DrawText(errorMessage.c_str(), screenWidth / 2 - MeasureText(errorMessage.c_str(), 20) / 2, screenHeight / 2 + 90, 20, RED);
+CredentialsScreen::CredentialsScreen(Mode formMode, Resources& res, Board& b, Shop& s)
+	: mode(formMode), resources(res), board(b), shop(s) {
+	// Pola i przycisk są zaczepione w środku okna, więc formularz zostaje wyśrodkowany po zmianie rozmiaru.
+	usernameNode = layout.add(LayoutSpec{ .anchor = { 0.5f, 0.5f }, .offset = { -200.f, -40.f }, .size = { 400.f, 30.f } });
+	passwordNode = layout.add(LayoutSpec{ .anchor = { 0.5f, 0.5f }, .offset = { -200.f, 40.f }, .size = { 400.f, 30.f } });
+	submitNode = layout.add(LayoutSpec{
+		.anchor = { 0.5f, 0.5f }, .pivot = { 0.5f, 0.f }, .offset = { 0.f, 200.f }, .size = { 200.f, 60.f }, .interactive = true });
+}
 
-		}
+void CredentialsScreen::update(SceneManager& scenes, float deltaTime) {
+	layout.refresh();
 
-		mouse = GetMousePosition();
-		int key = GetCharPressed();
-		while (key > 0) {
-			if ((key >= 32) && (key <= 125)) {
-				if (enteringUsername && username.length() < 20) {
-					username += static_cast<char>(key);
-					usernameError = false;
-					errorMessage = "";
-				}
-				else if (!enteringUsername && password.length() < 20) {
-					password += static_cast<char>(key);
-					passwordError = false;
-					errorMessage = "";
-				}
-			}
-			key = GetCharPressed();
+	if (isWaiting()) {
+		spinnerAngle += deltaTime * 360.0f;
+		if (poll()) {
+			// Menu zastępuje formularz, więc wylogowanie wraca prosto do ekranu uwierzytelniania.
+			scenes.replace(std::make_unique<Menu>(resources, board, shop, username));
 		}
+		return;
+	}
 
-		if (IsKeyPressed(KEY_BACKSPACE)) {
-			if (enteringUsername && !username.empty()) {
-				username.pop_back();
+	int key = GetCharPressed();
+	while (key > 0) {
+		if ((key >= 32) && (key <= 125)) {
+			if (enteringUsername && username.length() < 20) {
+				username += static_cast<char>(key);
 				usernameError = false;
 				errorMessage = "";
 			}
-			else if (!enteringUsername && !password.empty()) {
-				password.pop_back();
+			else if (!enteringUsername && password.length() < 20) {
+				password += static_cast<char>(key);
 				passwordError = false;
 				errorMessage = "";
 			}
 		}
+		key = GetCharPressed();
+	}
 
-		if (IsKeyPressed(KEY_TAB)) {
-			enteringUsername = !enteringUsername;
+	if (IsKeyPressed(KEY_BACKSPACE)) {
+		if (enteringUsername && !username.empty()) {
+			username.pop_back();
+			usernameError = false;
+			errorMessage = "";
 		}
-
-		if (IsKeyPressed(KEY_ENTER) || (CheckCollisionPointRec(mouse, submitButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))) {
-			SignInResult result = auth.signIn(username, password);
-			if (result == SignInResult::SUCCESS) {
-				validInput = true;
-			}
-			else {
-				usernameError = false;
-				passwordError = false;
-				switch (result) {
-				case SignInResult::USERNAME_TAKEN:
-					errorMessage = "Nazwa uzytkownika zajeta";
-					usernameError = true;
-					break;
-				case SignInResult::INVALID_USERNAME:
-					errorMessage = "Niepoprawna nazwa uzytkownika";
-					usernameError = true;
-					break;
-				case SignInResult::INVALID_PASSWORD:
-					errorMessage = "Niepoprawne haslo";
-					passwordError = true;
-					break;
-				}
-			}
+		else if (!enteringUsername && !password.empty()) {
+			password.pop_back();
+			passwordError = false;
+			errorMessage = "";
 		}
-		DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-		EndDrawing();
 	}
-	return validInput ? username : "";
-}
 
-std::string LoadingScreen::handleLogIn(int screenWidth, int screenHeight, Resources& resources) {
-	Authorization auth;
-	std::string username, password;
-	std::string errorMessage;
-	bool usernameError = false;
-	bool passwordError = false;
-	bool loggedIn = false;
-	bool enteringUsername = true;
-	Rectangle submitButton = { static_cast<float>(screenWidth / 2 - 100), static_cast<float>(screenHeight / 2 + 200), 200, 60 };
-
-	while (!WindowShouldClose() && !loggedIn) {
-		BeginDrawing();
-		ClearBackground(RAYWHITE);
-
-		DrawTexturePro(
-			resources.getRegistrationBackground(),
-			Rectangle{ 0.f, 0.f, static_cast<float>(resources.getRegistrationBackground().width), static_cast<float>(resources.getRegistrationBackground().height) },
-			Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			WHITE
-		);
-
-		Color usernameBorder = usernameError ? RED : (enteringUsername ? GREEN : BLACK);
-		DrawText("Enter Username:", screenWidth / 2 - 100, screenHeight / 2 - 60, 20, usernameBorder);
-		DrawText(username.c_str(), screenWidth / 2 - 150, screenHeight / 2 - 40, 20, BLACK);
-		DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 - 40, 400, 30, usernameBorder);
-
-
-		Color passwordBorder = passwordError ? RED : (!enteringUsername ? GREEN : BLACK);
-		DrawText("Enter Password:", screenWidth / 2 - 100, screenHeight / 2 + 10, 20, passwordBorder);
-		std::string maskedPassword(password.length(), '*');
-		DrawText(maskedPassword.c_str(), screenWidth / 2 - 150, screenHeight / 2 + 40, 20, BLACK);
-		DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 + 40, 400, 30, passwordBorder);
-
-		Texture2D buttonTex = resources.getButtonTexture();
-		Vector2 mouse = GetMousePosition();
-		Color submitColor = CheckCollisionPointRec(mouse, submitButton) ? GRAY : WHITE;
-		DrawTexturePro(
-			buttonTex,
-			Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-			submitButton,
-			Vector2{ 0.f, 0.f },
-			0.0f,
-			submitColor
-		);
-		DrawText("Submit", static_cast<int>(submitButton.x + (submitButton.width - MeasureText("Submit", 20)) / 2), static_cast<int>(submitButton.y + 20), 20, BLACK);
+	if (IsKeyPressed(KEY_TAB)) {
+		enteringUsername = !enteringUsername;
+	}
 
-		if (!errorMessage.empty()) {
-			DrawText(errorMessage.c_str(), screenWidth / 2 - MeasureText(errorMessage.c_str(), 20) / 2, screenHeight / 2 + 90, 20, RED);
-		}
+	if (IsKeyPressed(KEY_ENTER) || (layout.hover(GetMousePosition()) == submitNode && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))) {
+		submit();
+	}
+}
 
-		Vector2 mousePos = GetMousePosition();
-
-		int key = GetCharPressed();
-		while (key > 0) {
-			if ((key >= 32) && (key <= 125)) {
-				if (enteringUsername && username.length() < 20) {
-					username += static_cast<char>(key);
-					usernameError = false;
-					errorMessage = "";
-				}
-				else if (!enteringUsername && password.length() < 20) {
-					password += static_cast<char>(key);
-					passwordError = false;
-					errorMessage = "";
-				}
-			}
-			key = GetCharPressed();
-		}
+void CredentialsScreen::submit() {
+	usernameError = false;
+	passwordError = false;
+	errorMessage = "";
 
-		if (IsKeyPressed(KEY_BACKSPACE)) {
-			if (enteringUsername && !username.empty()) {
-				username.pop_back();
-				usernameError = false;
-				errorMessage = "";
-			}
-			else if (!enteringUsername && !password.empty()) {
-				password.pop_back();
-				passwordError = false;
-				errorMessage = "";
-			}
-		}
+	if (mode == Mode::SIGN_IN) {
+		pendingSignIn = authWorker().signIn(username, password);
+	}
+	else {
+		pendingLogIn = authWorker().logIn(username, password);
+	}
+	if (!isWaiting()) {
+		errorMessage = "Zbyt wiele prob, sprobuj za chwile";
+	}
+}
 
-		if (IsKeyPressed(KEY_TAB)) {
-			enteringUsername = !enteringUsername;
+bool CredentialsScreen::poll() {
+	if (pendingSignIn.valid()) {
+		if (pendingSignIn.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return false;
 		}
-
-		if (IsKeyPressed(KEY_ENTER) || (CheckCollisionPointRec(mousePos, submitButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))) {
-			LogInResult result = auth.logIn(username, password);
-			if (result == LogInResult::SUCCESS) {
-				loggedIn = true;
-			}
-			else {
-				usernameError = false;
-				passwordError = false;
-				switch (result) {
-				case LogInResult::USER_NOT_FOUND:
-					errorMessage = "Uzytkownik nieznaleziony";
-					usernameError = true;
-					break;
-				case LogInResult::INCORRECT_PASSWORD:
-					errorMessage = "Niepoprawne haslo";
-					passwordError = true;
-					break;
-				}
-			}
+		switch (pendingSignIn.get()) {
+		case SignInResult::SUCCESS:
+			return true;
+		case SignInResult::USERNAME_TAKEN:
+			errorMessage = "Nazwa uzytkownika zajeta";
+			usernameError = true;
+			break;
+		case SignInResult::INVALID_USERNAME:
+			errorMessage = "Niepoprawna nazwa uzytkownika";
+			usernameError = true;
+			break;
+		case SignInResult::INVALID_PASSWORD:
+			errorMessage = "Niepoprawne haslo";
+			passwordError = true;
+			break;
 		}
+		return false;
+	}
 
-		DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-		EndDrawing();
+	if (pendingLogIn.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return false;
+	}
+	switch (pendingLogIn.get()) {
+	case LogInResult::SUCCESS:
+		return true;
+	case LogInResult::USER_NOT_FOUND:
+		errorMessage = "Uzytkownik nieznaleziony";
+		usernameError = true;
+		break;
+	case LogInResult::INCORRECT_PASSWORD:
+		errorMessage = "Niepoprawne haslo";
+		passwordError = true;
+		break;
 	}
-	return loggedIn ? username : "";
+	return false;
 }
 
+void CredentialsScreen::render() {
+	int screenWidth = GetScreenWidth();
+	int screenHeight = GetScreenHeight();
+
+	ClearBackground(RAYWHITE);
+	DrawTexturePro(
+		resources.getRegistrationBackground(),
+		Rectangle{ 0.f, 0.f, static_cast<float>(resources.getRegistrationBackground().width), static_cast<float>(resources.getRegistrationBackground().height) },
+		Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
+		Vector2{ 0.f, 0.f },
+		0.0f,
+		WHITE
+	);
+
+	const bool signIn = mode == Mode::SIGN_IN;
+	const char* usernameLabel = signIn ? "Enter Username (3-20 chars, alphanumeric):" : "Enter Username:";
+	const char* passwordLabel = signIn ? "Enter Password (8+ chars, letters and numbers):" : "Enter Password:";
+	const int labelX = signIn ? screenWidth / 2 - 220 : screenWidth / 2 - 100;
+
+	const Rectangle& usernameBox = layout.rect(usernameNode);
+	Color usernameBorder = usernameError ? RED : (enteringUsername ? GREEN : BLACK);
+	DrawText(usernameLabel, labelX, static_cast<int>(usernameBox.y) - 20, 20, usernameBorder);
+	DrawText(username.c_str(), static_cast<int>(usernameBox.x) + 50, static_cast<int>(usernameBox.y), 20, BLACK);
+	DrawRectangleLinesEx(usernameBox, 1.0f, usernameBorder);
+
+	const Rectangle& passwordBox = layout.rect(passwordNode);
+	Color passwordBorder = passwordError ? RED : (!enteringUsername ? GREEN : BLACK);
+	DrawText(passwordLabel, labelX, static_cast<int>(passwordBox.y) - 30, 20, passwordBorder);
+	std::string maskedPassword(password.length(), '*');
+	DrawText(maskedPassword.c_str(), static_cast<int>(passwordBox.x) + 50, static_cast<int>(passwordBox.y), 20, BLACK);
+	DrawRectangleLinesEx(passwordBox, 1.0f, passwordBorder);
+
+	Texture2D buttonTex = resources.getButtonTexture();
+	const Rectangle& submitButton = layout.rect(submitNode);
+	Color submitColor = (isWaiting() || layout.hover(GetMousePosition()) == submitNode) ? GRAY : WHITE;
+	DrawTexturePro(
+		buttonTex,
+		Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
+		submitButton,
+		Vector2{ 0.f, 0.f },
+		0.0f,
+		submitColor
+	);
+	if (isWaiting()) {
+		Vector2 center = { submitButton.x + submitButton.width / 2, submitButton.y + submitButton.height / 2 - 8 };
+		DrawRing(center, 8.0f, 12.0f, spinnerAngle, spinnerAngle + 270.0f, 24, BLACK);
+	}
+	else {
+		DrawText("Submit", static_cast<int>(submitButton.x + (submitButton.width - MeasureText("Submit", 20)) / 2), static_cast<int>(submitButton.y + 20), 20, BLACK);
+	}
+
+	if (!errorMessage.empty()) {
+		DrawText(errorMessage.c_str(), screenWidth / 2 - MeasureText(errorMessage.c_str(), 20) / 2, screenHeight / 2 + 90, 20, RED);
+	}
+
+	DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
+}
@@ -0,0 +1,178 @@
+﻿/**
+ * @file Lz4.cpp
+ * @brief Implementacja kompresji i dekompresji bloków LZ4.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+module Lz4Module;
+
+namespace {
+	/** @brief Minimalna długość dopasowania w formacie LZ4. */
+	constexpr std::size_t MIN_MATCH = 4;
+	/** @brief Ostatnie bajty bloku muszą być literałami (wymóg formatu). */
+	constexpr std::size_t LAST_LITERALS = 5;
+	/** @brief Dopasowanie nie może zaczynać się bliżej niż tyle bajtów od końca bloku (wymóg formatu). */
+	constexpr std::size_t MATCH_SAFE_DISTANCE = 12;
+	/** @brief Największe przesunięcie dopasowania (16 bitów). */
+	constexpr std::size_t MAX_OFFSET = 65535;
+	/** @brief Liczba bitów indeksu tablicy mieszającej. */
+	constexpr int HASH_BITS = 14;
+
+	std::uint32_t read32(const std::uint8_t* p) {
+		std::uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	std::uint32_t hash4(std::uint32_t sequence) {
+		return (sequence * 2654435761u) >> (32 - HASH_BITS);
+	}
+
+	/** @brief Dopisuje długość w kodowaniu LZ4: kolejne bajty 255, a na końcu reszta. */
+	void writeLength(std::vector<std::uint8_t>& out, std::size_t length) {
+		while (length >= 255) {
+			out.push_back(255);
+			length -= 255;
+		}
+		out.push_back(static_cast<std::uint8_t>(length));
+	}
+
+	/** @brief Dopisuje sekwencję: token, literały i (jeśli matchLength > 0) dopasowanie. */
+	void writeSequence(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t literalLength,
+		std::size_t offset, std::size_t matchLength) {
+		const std::size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+		out.push_back(static_cast<std::uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+		if (literalLength >= 15) {
+			writeLength(out, literalLength - 15);
+		}
+		out.insert(out.end(), literals, literals + literalLength);
+		if (matchLength == 0) {
+			return;
+		}
+		out.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+		out.push_back(static_cast<std::uint8_t>(offset >> 8));
+		if (matchCode >= 15) {
+			writeLength(out, matchCode - 15);
+		}
+	}
+
+	/** @brief Odczytuje dodatkowe bajty długości; zwraca false, jeśli blok się skończył. */
+	bool readLength(const std::uint8_t*& in, const std::uint8_t* end, std::size_t& length) {
+		std::uint8_t byte;
+		do {
+			if (in >= end) return false;
+			byte = *in++;
+			length += byte;
+		} while (byte == 255);
+		return true;
+	}
+}
+
+std::vector<std::uint8_t> lz4Compress(const std::uint8_t* source, std::size_t sourceSize) {
+	std::vector<std::uint8_t> out;
+	out.reserve(sourceSize / 2 + 16);
+
+	const std::uint8_t* anchor = source;
+	if (sourceSize > MATCH_SAFE_DISTANCE) {
+		// Pozycje zapisujemy jako przesunięcie + 1, żeby 0 oznaczało pustą komórkę.
+		std::vector<std::uint32_t> table(std::size_t{ 1 } << HASH_BITS, 0);
+		const std::uint8_t* matchLimit = source + sourceSize - LAST_LITERALS;
+		const std::uint8_t* searchLimit = source + sourceSize - MATCH_SAFE_DISTANCE;
+		const std::uint8_t* in = source;
+
+		while (in < searchLimit) {
+			const std::uint32_t sequence = read32(in);
+			std::uint32_t& slot = table[hash4(sequence)];
+			const std::uint8_t* candidate = slot != 0 ? source + (slot - 1) : nullptr;
+			slot = static_cast<std::uint32_t>(in - source) + 1;
+
+			if (candidate == nullptr || static_cast<std::size_t>(in - candidate) > MAX_OFFSET || read32(candidate) != sequence) {
+				++in;
+				continue;
+			}
+
+			// Rozszerzamy dopasowanie wstecz (w obrębie literałów) i wprzód (do granicy ostatnich literałów).
+			while (in > anchor && candidate > source && in[-1] == candidate[-1]) {
+				--in;
+				--candidate;
+			}
+			const std::uint8_t* matchEnd = in + MIN_MATCH;
+			const std::uint8_t* candidateEnd = candidate + MIN_MATCH;
+			while (matchEnd < matchLimit && *matchEnd == *candidateEnd) {
+				++matchEnd;
+				++candidateEnd;
+			}
+
+			writeSequence(out, anchor, static_cast<std::size_t>(in - anchor), static_cast<std::size_t>(in - candidate),
+				static_cast<std::size_t>(matchEnd - in));
+			in = matchEnd;
+			anchor = in;
+		}
+	}
+
+	writeSequence(out, anchor, static_cast<std::size_t>(source + sourceSize - anchor), 0, 0);
+	return out;
+}
+
+bool lz4Decompress(const std::uint8_t* source, std::size_t sourceSize, std::uint8_t* destination, std::size_t destinationSize) {
+	const std::uint8_t* in = source;
+	const std::uint8_t* inEnd = source + sourceSize;
+	std::uint8_t* out = destination;
+	std::uint8_t* outEnd = destination + destinationSize;
+
+	while (in < inEnd) {
+		const std::uint8_t token = *in++;
+
+		std::size_t literalLength = token >> 4;
+		if (literalLength == 15 && !readLength(in, inEnd, literalLength)) {
+			return false;
+		}
+		if (literalLength > static_cast<std::size_t>(inEnd - in) || literalLength > static_cast<std::size_t>(outEnd - out)) {
+			return false;
+		}
+		std::memcpy(out, in, literalLength);
+		in += literalLength;
+		out += literalLength;
+
+		// Ostatnia sekwencja składa się z samych literałów.
+		if (in == inEnd) {
+			break;
+		}
+
+		if (inEnd - in < 2) {
+			return false;
+		}
+		const std::size_t offset = static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8);
+		in += 2;
+		if (offset == 0 || offset > static_cast<std::size_t>(out - destination)) {
+			return false;
+		}
+
+		std::size_t matchLength = token & 0x0F;
+		if (matchLength == 15 && !readLength(in, inEnd, matchLength)) {
+			return false;
+		}
+		matchLength += MIN_MATCH;
+		if (matchLength > static_cast<std::size_t>(outEnd - out)) {
+			return false;
+		}
+
+		// Dopasowanie może nachodzić na właśnie zapisywane bajty (offset < długość), więc kopiujemy bajt po bajcie.
+		const std::uint8_t* match = out - offset;
+		if (offset >= matchLength) {
+			std::memcpy(out, match, matchLength);
+			out += matchLength;
+		}
+		else {
+			for (std::size_t i = 0; i < matchLength; ++i) {
+				*out++ = match[i];
+			}
+		}
+	}
+	return out == outEnd;
+}
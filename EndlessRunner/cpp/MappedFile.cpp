@@ -0,0 +1,118 @@
+﻿/**
+ * @file MappedFile.cpp
+ * @brief Implementacja klasy MappedFile.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+module MappedFileModule;
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	data = static_cast<const std::uint8_t*>(view);
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+	fileHandle = reinterpret_cast<std::intptr_t>(file);
+	mappingHandle = reinterpret_cast<std::intptr_t>(mapping);
+
+	// Prosimy system o wczytanie całego pliku z wyprzedzeniem zamiast pojedynczych stron przy pierwszym dostępie.
+	WIN32_MEMORY_RANGE_ENTRY range{ view, size };
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	return true;
+}
+
+void MappedFile::close() {
+	if (data) {
+		UnmapViewOfFile(data);
+		data = nullptr;
+	}
+	if (mappingHandle != -1) {
+		CloseHandle(reinterpret_cast<HANDLE>(mappingHandle));
+		mappingHandle = -1;
+	}
+	if (fileHandle != -1) {
+		CloseHandle(reinterpret_cast<HANDLE>(fileHandle));
+		fileHandle = -1;
+	}
+	size = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info {};
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) {
+		::close(fd);
+		return false;
+	}
+	// Prosimy system o wczytanie całego pliku z wyprzedzeniem zamiast pojedynczych stron przy pierwszym dostępie.
+	madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+	madvise(view, static_cast<std::size_t>(info.st_size), MADV_WILLNEED);
+	data = static_cast<const std::uint8_t*>(view);
+	size = static_cast<std::size_t>(info.st_size);
+	fileHandle = fd;
+	return true;
+}
+
+void MappedFile::close() {
+	if (data) {
+		munmap(const_cast<std::uint8_t*>(data), size);
+		data = nullptr;
+	}
+	if (fileHandle != -1) {
+		::close(static_cast<int>(fileHandle));
+		fileHandle = -1;
+	}
+	size = 0;
+}
+
+#endif
@@ -4,200 +4,279 @@
  */
 module;
 #include "raylib.h"
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <map>
 #include <array>
+#include <memory>
 #include <vector>
 
 module MenuModule;
 
-void Menu::setContext(Resources& res, Board& b, Shop& s) {
-	resources = &res;
-	board = &b;
-	shop = &s;
-}
-
-void Menu::setUsername(const std::string& user) {
-	username = user;
-}
+import AudioModule;
 
-void Menu::showMenu(int screenWidth, int screenHeight) {
-	bool menuRunning = true;
+void Menu::buildLayout() {
+	const Texture2D& banner = resources.getBanner();
+	bannerNode = layout.add(LayoutSpec{
+		.anchor = { 0.5f, 0.f }, .pivot = { 0.5f, 0.f }, .offset = { 0.f, Config::BANNER_Y },
+		.size = { banner.width * Config::BANNER_SCALE, banner.height * Config::BANNER_SCALE } });
 
-	while (!WindowShouldClose() && menuRunning) {
-		screenWidth = GetScreenWidth();
-		screenHeight = GetScreenHeight();
-
-		for (int i = 0; i < buttonCount; ++i) {
-			buttons[i] = {
-				static_cast<float>(screenWidth / 2 - 100),
-				static_cast<float>(screenHeight / 2 - ((buttonCount * 80) / 2) + i * 80),
-				200.0f,
-				60.0f
-			};
-		}
+	// Kolumna przycisków jest wyśrodkowana w oknie, przyciski co 80 pikseli.
+	const int column = layout.add(LayoutSpec{
+		.anchor = { 0.5f, 0.5f }, .pivot = { 0.5f, 0.5f }, .size = { 200.f, buttonCount * 80.f } });
+	for (int i = 0; i < buttonCount; ++i) {
+		buttonNodes[i] = layout.add(LayoutSpec{
+			.offset = { 0.f, i * 80.f }, .size = { 200.f, 60.f }, .interactive = true }, column);
+	}
+}
 
-		Vector2 mouse = GetMousePosition();
-		selected = -1;
-		for (int i = 0; i < buttonCount; ++i) {
-			if (CheckCollisionPointRec(mouse, buttons[i])) {
-				selected = i;
-				if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-					handleClick(i, menuRunning);
-				}
+void Menu::update(SceneManager& scenes, float deltaTime) {
+	layout.refresh();
+
+	const int hovered = layout.hover(GetMousePosition());
+	selected = -1;
+	for (int i = 0; i < buttonCount; ++i) {
+		if (buttonNodes[i] == hovered) {
+			selected = i;
+			if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+				audio().play(Sfx::CLICK);
+				handleClick(scenes, i);
 			}
+			break;
 		}
+	}
+}
 
-		BeginDrawing();
-		ClearBackground(RAYWHITE);
+void Menu::render() {
+	// Menu zmienia się tylko po zmianie rozmiaru okna i podświetlonego przycisku.
+	ClearBackground(RAYWHITE);
+	layer.render(GetScreenWidth(), GetScreenHeight(), static_cast<std::uint64_t>(selected + 1),
+		[this] { return drawStatic(); });
+}
+
+int Menu::drawStatic() const {
+	int screenWidth = GetScreenWidth();
+	int screenHeight = GetScreenHeight();
+	int drawCalls = 0;
+
+	ClearBackground(RAYWHITE);
+
+	DrawTexturePro(
+		resources.getMenuBackground(),
+		Rectangle{ 0, 0, static_cast<float>(resources.getMenuBackground().width), static_cast<float>(resources.getMenuBackground().height) },
+		Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
+		Vector2{ 0, 0 },
+		0.0f,
+		WHITE
+	);
+	drawCalls++;
+
+
+	const Rectangle& bannerRec = layout.rect(bannerNode);
+	float bannerHeight = bannerRec.height;
+	float bannerY = bannerRec.y;
+	DrawTextureEx(resources.getBanner(), { bannerRec.x, bannerRec.y }, 0.0f, Config::BANNER_SCALE, WHITE);
+
+	std::string welcomeText = username.empty() ? "Welcome Guest" : "Welcome " + username;
+	int textWidth = MeasureText(welcomeText.c_str(), 30);
+	float textX = (screenWidth - textWidth) / 2.0f;
+	DrawText(welcomeText.c_str(), static_cast<int>(textX), static_cast<int>(bannerY + (bannerHeight - 45) / 2), 30, BLACK);
+	drawCalls += 2;
+
+	int fontSize = 20;
+	for (int i = 0; i < buttonCount; ++i) {
+		Texture2D buttonTex = resources.getButtonTexture();
+		Color color = (i == selected) ? GRAY : WHITE;
+		const Rectangle& button = layout.rect(buttonNodes[i]);
 
 		DrawTexturePro(
-			resources->getMenuBackground(),
-			Rectangle{ 0, 0, static_cast<float>(resources->getMenuBackground().width), static_cast<float>(resources->getMenuBackground().height) },
-			Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0, 0 },
+			buttonTex,
+			Rectangle{ 0, 0, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
+			button,
+			Vector2{ 0,0 },
 			0.0f,
-			WHITE
+			color
 		);
 
+		int textWidth = MeasureText(labels[i], fontSize);
+		int textX = static_cast<int>(button.x + (button.width - textWidth) / 2);
+		int textY = static_cast<int>(button.y + (button.height - fontSize) / 2);
+		DrawText(labels[i], textX, textY, fontSize, BLACK);
+		drawCalls += 2;
+	}
+	return drawCalls;
+}
+
+void Menu::newGame(SceneManager& scenes) {
+	int selectedDino = shop.getSelectedDino();
+	int frameCount = shop.getSelectedDinoFrameCount();
+
+	Texture2D selectedDinoTex;
+	switch (selectedDino) {
+	case 0: selectedDinoTex = resources.getGreenDinoRun(); break;
+	case 1: selectedDinoTex = resources.getBlueDinoRun(); break;
+	case 2: selectedDinoTex = resources.getYellowDinoRun(); break;
+	case 3: selectedDinoTex = resources.getRedDinoRun(); break;
+	default: selectedDinoTex = resources.getGreenDinoRun(); break;
+	}
 
-		Texture2D banner = resources->getBanner();
-		float bannerScale = Config::BANNER_SCALE;
-		float bannerHeight = banner.height * bannerScale;
-		float bannerX = screenWidth / 2 - ((banner.width * bannerScale) / 2);
-		float bannerY = Config::BANNER_Y;
-		DrawTextureEx(banner, { bannerX, bannerY }, 0.0f, bannerScale, WHITE);
-
-		std::string welcomeText = username.empty() ? "Welcome Guest" : "Welcome " + username;
-		int textWidth = MeasureText(welcomeText.c_str(), 30);
-		float textX = (screenWidth - textWidth) / 2.0f;
-		DrawText(welcomeText.c_str(), static_cast<int>(textX), static_cast<int>(bannerY + (bannerHeight - 45) / 2), 30, BLACK);
-
-		int fontSize = 20;
-		for (int i = 0; i < buttonCount; ++i) {
-			Texture2D buttonTex = resources->getButtonTexture();
-			Color color = (i == selected) ? GRAY : WHITE;
-
-			DrawTexturePro(
-				buttonTex,
-				Rectangle{ 0, 0, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-				buttons[i],
-				Vector2{ 0,0 },
-				0.0f,
-				color
-			);
-
-			int textWidth = MeasureText(labels[i], fontSize);
-			int textX = static_cast<int>(buttons[i].x + (buttons[i].width - textWidth) / 2);
-			int textY = static_cast<int>(buttons[i].y + (buttons[i].height - fontSize) / 2);
-			DrawText(labels[i], textX, textY, fontSize, BLACK);
-		}
+	board.setDinoTex(selectedDinoTex);
+	board.setDinoFrameCount(frameCount);
+	auto game = std::make_unique<Controller>(resources, board, username, GetScreenWidth(), GetScreenHeight());
+	game->setPersistent(true);
+	scenes.push(std::move(game));
+}
 
-		EndDrawing();
+void Menu::handleClick(SceneManager& scenes, int index) {
+	switch (index) {
+	case 0: newGame(scenes); break;
+	case 1: scenes.push(leaderboard); break;
+	case 2: scenes.push(shop); break;
+	case 3: scenes.pop(); break;
+	case 4: scenes.clear(); break;
 	}
 }
 
-void Menu::newGame() {
-	if (resources && board && shop) {
-		int selectedDino = shop->getSelectedDino();
-		int frameCount = shop->getSelectedDinoFrameCount();
-
-		Texture2D selectedDinoTex;
-		switch (selectedDino) {
-		case 0: selectedDinoTex = resources->getGreenDinoRun(); break;
-		case 1: selectedDinoTex = resources->getBlueDinoRun(); break;
-		case 2: selectedDinoTex = resources->getYellowDinoRun(); break;
-		case 3: selectedDinoTex = resources->getRedDinoRun(); break;
-		default: selectedDinoTex = resources->getGreenDinoRun(); break;
-		}
+Leaderboard::Leaderboard(Resources& res) : resources(res) {
+	// Ramka zajmuje 80% okna w krótszym wymiarze i zachowuje proporcje tekstury.
+	const Texture2D& frame = resources.getLeaderboard();
+	frameNode = layout.add(LayoutSpec{
+		.anchor = { 0.5f, 0.5f }, .pivot = { 0.5f, 0.5f }, .relativeSize = { 0.8f, 0.8f },
+		.aspect = static_cast<float>(frame.width) / std::max(frame.height, 1) });
+}
 
-		board->setDinoTex(selectedDinoTex);
-		board->setDinoFrameCount(frameCount);
-		//board->init(selectedDinoTex, GetScreenWidth(), GetScreenHeight());
-		Controller controller(*resources, *board, username, GetScreenWidth(), GetScreenHeight());
-		controller.run();
+void Leaderboard::enter(SceneManager& scenes) {
+	if (refreshScores()) {
+		layer.invalidate();
 	}
 }
 
+bool Leaderboard::loadScores(const std::string& path) {
+	scoresLog = RecordLog(path);
+	bestScores.clear();
+	scores.clear();
+	daemonScores = false;
+	refreshFromLog();
+	layer.invalidate();
+	return !scores.empty();
+}
 
+bool Leaderboard::refreshScores() {
+	// Demon trzyma ranking w pamięci, więc wystarczy jedna wymiana o czołówkę zamiast czytania pliku.
+	std::vector<RankedScore> top;
+	if (!scoreClient.top(static_cast<std::uint16_t>(Config::LEADERBOARD_ROWS), top)) {
+		return refreshFromLog();
+	}
+	std::vector<ScoreEntry> fresh;
+	fresh.reserve(top.size());
+	for (RankedScore& entry : top) {
+		fresh.push_back({ std::move(entry.username), entry.score });
+	}
+	const bool changed = !daemonScores || fresh.size() != scores.size()
+		|| !std::equal(fresh.begin(), fresh.end(), scores.begin(),
+			[](const ScoreEntry& a, const ScoreEntry& b) { return a.username == b.username && a.score == b.score; });
+	scores = std::move(fresh);
+	daemonScores = true;
+	return changed;
+}
 
-void Menu::showLeaderboard(int screenWidth, int screenHeight) {
-	std::map<std::string, int> bestScores;
-	std::ifstream file("scores.txt");
-	if (file.is_open()) {
-		std::string line;
-		while (std::getline(file, line)) {
-			std::istringstream iss(line);
-			std::string user;
-			int score;
-			if (std::getline(iss, user, ':') && (iss >> score)) {
-				if (bestScores.find(user) == bestScores.end() || score > bestScores[user]) {
-					bestScores[user] = score;
-				}
-			}
+bool Leaderboard::refreshFromLog() {
+	// Po przejściu z demona na plik tablicę trzeba zbudować od nowa, nawet jeśli w pliku nic nie przybyło.
+	bool changed = daemonScores;
+	daemonScores = false;
+	auto addScore = [this, &changed](std::string_view line) {
+		const std::size_t colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			return;
 		}
-		file.close();
+		const char* first = line.data() + colon + 1;
+		const char* last = line.data() + line.size();
+		while (first != last && (*first == ' ' || *first == '\t')) {
+			++first;
+		}
+		int score = 0;
+		if (std::from_chars(first, last, score).ec != std::errc()) {
+			return;
+		}
+		auto [it, inserted] = bestScores.try_emplace(std::string(line.substr(0, colon)), score);
+		if (inserted || score > it->second) {
+			it->second = score;
+			changed = true;
+		}
+	};
+	// Czytane są tylko wiersze dopisane od poprzedniego razu; po podmianie pliku ranking budujemy od nowa.
+	if (scoresLog.readNew(addScore).restarted) {
+		bestScores.clear();
+		changed = true;
+		scoresLog.readNew(addScore);
+	}
+	if (!changed) {
+		return false;
 	}
 
-	std::vector<ScoreEntry> scores;
+	scores.clear();
 	for (const auto& entry : bestScores) {
 		scores.push_back({ entry.first, entry.second });
 	}
-
 	std::sort(scores.begin(), scores.end(),
 		[](const ScoreEntry& a, const ScoreEntry& b) { return a.score > b.score; });
+	return true;
+}
 
-	bool leaderboardRunning = true;
-	while (!WindowShouldClose() && leaderboardRunning) {
-		screenWidth = GetScreenWidth();
-		screenHeight = GetScreenHeight();
-
-		if (IsKeyPressed(KEY_ESCAPE)) {
-			leaderboardRunning = false;
-		}
-
-		BeginDrawing();
-		ClearBackground(RAYWHITE);
-
-		DrawTexturePro(
-			resources->getMenuBackground(),
-			Rectangle{ 0, 0, static_cast<float>(resources->getMenuBackground().width), static_cast<float>(resources->getMenuBackground().height) },
-			Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0, 0 },
-			0.0f,
-			WHITE
-		);
-
-
-		Texture2D leaderboardFrame = resources->getLeaderboard();
-		float frameScale = std::min(
-			static_cast<float>(screenWidth) / leaderboardFrame.width,
-			static_cast<float>(screenHeight) / leaderboardFrame.height
-		) * 0.8f;
-		float frameWidth = leaderboardFrame.width * frameScale;
-		float frameHeight = leaderboardFrame.height * frameScale;
-		float frameX = (screenWidth - frameWidth) / 2;
-		float frameY = (screenHeight - frameHeight) / 2;
-
-		DrawTextureEx(leaderboardFrame, { frameX, frameY }, 0.0f, frameScale, WHITE);
-
-		DrawText("Leaderboard", static_cast<int>(frameX + (frameWidth - MeasureText("Leaderboard", 40)) / 2),
-			static_cast<int>(frameY + 70), 40, BLACK);
-
-		size_t maxScores = std::min(static_cast<size_t>(10), scores.size());
-		float textY = frameY + 120;
-		for (size_t i = 0; i < maxScores; i++) {
-			std::string entry = std::to_string(i + 1) + ". " + scores[i].username + ": " + std::to_string(scores[i].score);
-			DrawText(entry.c_str(), static_cast<int>(frameX + (frameWidth - MeasureText(entry.c_str(), 30)) / 2),
-				static_cast<int>(textY + i * 40), 30, BLACK);
-		}
-
-		DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2,
-			screenHeight - 30, 20, BLACK);
+void Leaderboard::render() {
+	// Wyniki są wczytywane raz w enter(), więc warstwa zmienia się tylko razem z rozmiarem okna.
+	ClearBackground(RAYWHITE);
+	layer.render(GetScreenWidth(), GetScreenHeight(), 0, [this] { return drawStatic(); });
+}
 
-		EndDrawing();
+int Leaderboard::drawStatic() const {
+	int screenWidth = GetScreenWidth();
+	int screenHeight = GetScreenHeight();
+	int drawCalls = 0;
+
+	ClearBackground(RAYWHITE);
+
+	DrawTexturePro(
+		resources.getMenuBackground(),
+		Rectangle{ 0, 0, static_cast<float>(resources.getMenuBackground().width), static_cast<float>(resources.getMenuBackground().height) },
+		Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
+		Vector2{ 0, 0 },
+		0.0f,
+		WHITE
+	);
+
+
+	Texture2D leaderboardFrame = resources.getLeaderboard();
+	const Rectangle& frameRec = layout.rect(frameNode);
+	float frameWidth = frameRec.width;
+	float frameX = frameRec.x;
+	float frameY = frameRec.y;
+
+	DrawTexturePro(leaderboardFrame,
+		Rectangle{ 0, 0, static_cast<float>(leaderboardFrame.width), static_cast<float>(leaderboardFrame.height) },
+		frameRec, Vector2{ 0, 0 }, 0.0f, WHITE);
+	drawCalls += 2;
+
+	DrawText("Leaderboard", static_cast<int>(frameX + (frameWidth - MeasureText("Leaderboard", 40)) / 2),
+		static_cast<int>(frameY + 70), 40, BLACK);
+
+	size_t maxScores = std::min(static_cast<size_t>(Config::LEADERBOARD_ROWS), scores.size());
+	float textY = frameY + 120;
+	for (size_t i = 0; i < maxScores; i++) {
+		std::string entry = std::to_string(i + 1) + ". " + scores[i].username + ": " + std::to_string(scores[i].score);
+		DrawText(entry.c_str(), static_cast<int>(frameX + (frameWidth - MeasureText(entry.c_str(), 30)) / 2),
+			static_cast<int>(textY + i * 40), 30, BLACK);
 	}
-}
\ No newline at end of file
+
+	DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2,
+		screenHeight - 30, 20, BLACK);
+	drawCalls += 2 + static_cast<int>(maxScores);
+	return drawCalls;
+}
@@ -9,16 +9,24 @@ module;
 
 module ObstacleModule;
 import AnimatedSpriteModule;
+import AnimationSystemModule;
 
 void Obstacle::init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
 	AnimatedSprite::init(tex, startX, startY, scaleFactor, frameCount, animUpdateTime);
 }
 
 void Obstacle::update(float deltaTime){
-	AnimatedSprite::update(deltaTime);
 	screenPos.x += velocity * deltaTime;
 }
 
 float Obstacle::getPositionX() const{
 	return screenPos.x;
+}
+
+void Obstacle::setVelocity(float newVelocity) {
+	velocity = newVelocity;
+}
+
+AnimationClip Obstacle::makeClip(const Texture2D& tex, int frameCount, float animUpdateTime) {
+	return animations().share(tex.id, frameCount, animUpdateTime);
 }
\ No newline at end of file
@@ -5,6 +5,12 @@
 
 module;
 #include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
 
 module ObstacleFactoryModule;
 import BatModule;
@@ -13,68 +19,111 @@ import StaticObstacleModule;
 import ObstacleModule;
 import ConfigModule;
 import ResourcesModule;
-import <memory>;
-import <random>;
-import <vector>;
+import CollisionMaskModule;
 
 
-std::unique_ptr<Obstacle> ObstacleFactory::createObstacle(float startX, float startY, BackgroundType bgType) {
+ObstacleSpec rollObstacleSpec(std::mt19937& gen) {
+    std::uniform_int_distribution<> probabilityDis(0, 99);
+    std::uniform_int_distribution<> variantDis(0, Config::STATIC_OBSTACLE_VARIANTS - 1);
     int roll = probabilityDis(gen);
 
     if (roll > 0 and roll <= 20) {
-        return createSpecificObstacle<Bat>(startX, startY, resources.getBat(), Config::BAT_FRAME_COUNT);
+        return { ObstacleKind::BAT, 0 };
     }
     else if (roll > 20 && roll <= 40) {
+        return { ObstacleKind::PTERODACTYL, 0 };
+    }
+    return { ObstacleKind::STATIC, static_cast<std::uint8_t>(variantDis(gen)) };
+}
+
+std::unique_ptr<Obstacle> ObstacleFactory::createObstacle(float startX, float startY, BackgroundType bgType) {
+    return createObstacle(rollObstacleSpec(gen), startX, startY, bgType);
+}
+
+std::unique_ptr<Obstacle> ObstacleFactory::createObstacle(const ObstacleSpec& spec, float startX, float startY, BackgroundType bgType) {
+    switch (spec.kind) {
+    case ObstacleKind::BAT:
+        return createSpecificObstacle<Bat>(startX, startY, resources.getBat(), Config::BAT_FRAME_COUNT);
+    case ObstacleKind::PTERODACTYL:
         return createSpecificObstacle<Pterodactyl>(startX, startY, resources.getPtero(), Config::PTERODACTYL_FRAME_COUNT);
+    default:
+        return createSpecificObstacle<StaticObstacle>(startX, startY, getTexture(spec, bgType), 1);
     }
-    else {
-        std::vector<Texture2D*> staticObstacles;
-        switch (bgType) {
-        case BackgroundType::DESERT_DAY:
-            staticObstacles = {
-                &resources.getSmallCactus(),
-                &resources.getBigCactus(),
-                &resources.getSkulls(),
-                &resources.getSkulls2(),
-                &resources.getRockDust(),
-                &resources.getBigRockDust()
-            };
-            break;
-        case BackgroundType::DESERT_NIGHT:
-            staticObstacles = {
-                &resources.getSmallCactus(),
-                &resources.getBigCactus(),
-                &resources.getSkulls(),
-                &resources.getSkulls2(),
-                &resources.getRockDustNight(),
-                &resources.getBigRockDustNight()
-            };
-            break;
-        case BackgroundType::FOREST_DAY:
-            staticObstacles = {
-                &resources.getRockForest(),
-                &resources.getBigRockForest(),
-                &resources.getSmallTree(),
-                &resources.getBigTree(),
-                &resources.getLog(),
-                &resources.getSpikes()
-            };
-            break;
-        case BackgroundType::FOREST_NIGHT:
-            staticObstacles = {
-                &resources.getRockForest(),
-                &resources.getBigRockForest(),
-                &resources.getSmallTreeNight(),
-                &resources.getBigTreeNight(),
-                &resources.getLogNight(),
-                &resources.getSpikesNight()
-            };
-            break;
-        }
+}
 
-        std::uniform_int_distribution<> dis(0, static_cast<int>(staticObstacles.size() - 1));
-        Texture2D* selectedTex = staticObstacles[dis(gen)];
+const Texture2D& ObstacleFactory::getTexture(const ObstacleSpec& spec, BackgroundType bgType) {
+    if (spec.kind == ObstacleKind::BAT) {
+        return resources.getBat();
+    }
+    if (spec.kind == ObstacleKind::PTERODACTYL) {
+        return resources.getPtero();
+    }
 
-        return createSpecificObstacle<StaticObstacle>(startX, startY, *selectedTex, 1);
+    std::array<const Texture2D*, Config::STATIC_OBSTACLE_VARIANTS> staticObstacles{};
+    switch (bgType) {
+    case BackgroundType::DESERT_DAY:
+        staticObstacles = {
+            &resources.getSmallCactus(),
+            &resources.getBigCactus(),
+            &resources.getSkulls(),
+            &resources.getSkulls2(),
+            &resources.getRockDust(),
+            &resources.getBigRockDust()
+        };
+        break;
+    case BackgroundType::DESERT_NIGHT:
+        staticObstacles = {
+            &resources.getSmallCactus(),
+            &resources.getBigCactus(),
+            &resources.getSkulls(),
+            &resources.getSkulls2(),
+            &resources.getRockDustNight(),
+            &resources.getBigRockDustNight()
+        };
+        break;
+    case BackgroundType::FOREST_DAY:
+        staticObstacles = {
+            &resources.getRockForest(),
+            &resources.getBigRockForest(),
+            &resources.getSmallTree(),
+            &resources.getBigTree(),
+            &resources.getLog(),
+            &resources.getSpikes()
+        };
+        break;
+    case BackgroundType::FOREST_NIGHT:
+        staticObstacles = {
+            &resources.getRockForest(),
+            &resources.getBigRockForest(),
+            &resources.getSmallTreeNight(),
+            &resources.getBigTreeNight(),
+            &resources.getLogNight(),
+            &resources.getSpikesNight()
+        };
+        break;
+    }
+    return *staticObstacles[spec.variant % Config::STATIC_OBSTACLE_VARIANTS];
+}
+
+ObstacleShape ObstacleFactory::getShape(const ObstacleSpec& spec, BackgroundType bgType) {
+    const Texture2D& tex = getTexture(spec, bgType);
+    const int frameCount = spec.kind == ObstacleKind::BAT ? Config::BAT_FRAME_COUNT
+        : spec.kind == ObstacleKind::PTERODACTYL ? Config::PTERODACTYL_FRAME_COUNT : 1;
+    const float frameWidth = static_cast<float>(tex.width) / frameCount * Config::OBSTACLE_SCALE;
+    const float height = tex.height * Config::OBSTACLE_SCALE;
+    // Latające przeszkody wiszą na stałej wysokości, statyczne stoją na ziemi.
+    const float altitude = spec.kind == ObstacleKind::BAT ? Config::BAT_ALTITUDE
+        : spec.kind == ObstacleKind::PTERODACTYL ? Config::PTERODACTYL_ALTITUDE : height;
+
+    ObstacleShape shape{ 0.f, frameWidth, altitude, altitude - height };
+    const CollisionMask* mask = resources.getCollisionMask(tex);
+    if (mask != nullptr && !mask->isEmpty()) {
+        const MaskBounds bounds = mask->opaqueBounds(mask->getWidth() / frameCount);
+        if (!bounds.isEmpty()) {
+            shape = { static_cast<float>(bounds.left), static_cast<float>(bounds.right - bounds.left),
+                altitude - bounds.top, altitude - bounds.bottom };
+        }
     }
-}
\ No newline at end of file
+    shape.bottom = std::max(shape.bottom, 0.f);
+    return shape;
+}
@@ -0,0 +1,206 @@
+﻿/**
+ * @file Particles.cpp
+ * @brief Implementacja klasy ParticleSystem.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+module ParticlesModule;
+
+import DrawListModule;
+import SnapshotModule;
+
+namespace {
+	/** @brief Nazwy emiterów w pliku konfiguracyjnym (w kolejności EmitterKind). */
+	const char* const EMITTER_NAMES[] = { "run_dust", "landing", "hit" };
+
+	/** @brief Najmniejszy mnożnik emisji po przekroczeniu budżetu. */
+	constexpr float MIN_SPAWN_SCALE = 0.1f;
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+	: posX(capacity), posY(capacity), velX(capacity), velY(capacity), gravity(capacity), age(capacity),
+	inverseLifetime(capacity), sizeStart(capacity), sizeDelta(capacity), color(capacity) {
+	// Wartości domyślne odpowiadają dostarczanemu plikowi particles.txt.
+	getEmitter(EmitterKind::RUN_DUST) = { 3, 0.45f, 20.f, 60.f, 150.f, 200.f, -40.f, 1.0f, 1.6f, Color{ 255, 255, 255, 220 } };
+	getEmitter(EmitterKind::LANDING) = { 12, 0.5f, 60.f, 180.f, 100.f, 260.f, 300.f, 0.8f, 1.4f, Color{ 235, 215, 180, 255 } };
+	getEmitter(EmitterKind::HIT) = { 40, 0.7f, 150.f, 420.f, 0.f, 360.f, 600.f, 0.5f, 1.0f, Color{ 255, 140, 70, 255 } };
+}
+
+void ParticleSystem::setTexture(const Texture2D& tex, int frames, float scale) {
+	texture = tex;
+	textureFrames = std::max(frames, 1);
+	textureScale = scale;
+}
+
+bool ParticleSystem::loadEmitters(const std::string& path) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		std::cout << "Particle config " << path << " not found, using defaults\n";
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::istringstream iss(line);
+		std::string name;
+		EmitterConfig config;
+		int r, g, b, a;
+		if (!(iss >> name >> config.count >> config.lifetime >> config.speedMin >> config.speedMax
+			>> config.angleMin >> config.angleMax >> config.gravity >> config.sizeStart >> config.sizeEnd
+			>> r >> g >> b >> a)) {
+			std::cout << "Particle config: malformed line \"" << line << "\"\n";
+			continue;
+		}
+		auto it = std::find_if(std::begin(EMITTER_NAMES), std::end(EMITTER_NAMES),
+			[&name](const char* emitterName) { return name == emitterName; });
+		if (it == std::end(EMITTER_NAMES)) {
+			std::cout << "Particle config: unknown emitter " << name << "\n";
+			continue;
+		}
+		config.lifetime = std::max(config.lifetime, 0.01f);
+		config.color = Color{ static_cast<unsigned char>(r), static_cast<unsigned char>(g),
+			static_cast<unsigned char>(b), static_cast<unsigned char>(a) };
+		emitters[static_cast<std::size_t>(it - std::begin(EMITTER_NAMES))] = config;
+	}
+	return true;
+}
+
+void ParticleSystem::emit(EmitterKind kind, float x, float y, float carryX) {
+	const EmitterConfig& config = getEmitter(kind);
+	std::uniform_real_distribution<float> speed(config.speedMin, config.speedMax);
+	std::uniform_real_distribution<float> angle(config.angleMin * DEG2RAD, config.angleMax * DEG2RAD);
+
+	// Przy obciętym budżecie emiter z małą liczbą cząsteczek może nie dać żadnej (tak samo emiter z count 0).
+	const int requested = std::max(0, static_cast<int>(std::lround(config.count * spawnScale)));
+	const std::size_t count = std::min(static_cast<std::size_t>(requested), getCapacity() - live);
+	for (std::size_t n = 0; n < count; ++n) {
+		const std::size_t i = live++;
+		const float v = speed(gen);
+		const float a = angle(gen);
+		posX[i] = x;
+		posY[i] = y;
+		velX[i] = std::cos(a) * v + carryX;
+		velY[i] = -std::sin(a) * v;
+		gravity[i] = config.gravity;
+		age[i] = 0.f;
+		inverseLifetime[i] = 1.f / config.lifetime;
+		sizeStart[i] = config.sizeStart;
+		sizeDelta[i] = config.sizeEnd - config.sizeStart;
+		color[i] = config.color;
+	}
+}
+
+void ParticleSystem::update(float deltaTime) {
+	const auto start = std::chrono::steady_clock::now();
+
+	// Jeden przebieg bez rozgałęzień po ciągłych tablicach - kompilator wektoryzuje go w całości.
+	for (std::size_t i = 0; i < live; ++i) {
+		velY[i] += gravity[i] * deltaTime;
+		posX[i] += velX[i] * deltaTime;
+		posY[i] += velY[i] * deltaTime;
+		age[i] += inverseLifetime[i] * deltaTime;
+	}
+
+	// Martwe cząsteczki są zastępowane ostatnią żywą, więc żywe zawsze zajmują początek tablic.
+	for (std::size_t i = 0; i < live;) {
+		if (age[i] < 1.f) {
+			++i;
+			continue;
+		}
+		--live;
+		posX[i] = posX[live];
+		posY[i] = posY[live];
+		velX[i] = velX[live];
+		velY[i] = velY[live];
+		gravity[i] = gravity[live];
+		age[i] = age[live];
+		inverseLifetime[i] = inverseLifetime[live];
+		sizeStart[i] = sizeStart[live];
+		sizeDelta[i] = sizeDelta[live];
+		color[i] = color[live];
+	}
+
+	lastUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// Po przekroczeniu budżetu emisja szybko spada, a potem powoli wraca do pełnej.
+	if (lastUpdateMs + lastDrawMs > Config::PARTICLE_BUDGET_MS) {
+		spawnScale = std::max(spawnScale * 0.5f, MIN_SPAWN_SCALE);
+	}
+	else {
+		spawnScale = std::min(spawnScale + 0.02f, 1.f);
+	}
+}
+
+void ParticleSystem::draw(DrawList& list) const {
+	if (live == 0 || texture.id == 0) {
+		return;
+	}
+	const auto start = std::chrono::steady_clock::now();
+
+	const float frameWidth = static_cast<float>(texture.width) / textureFrames;
+	const float frameHeight = static_cast<float>(texture.height);
+
+	// Wszystkie cząsteczki mają tę samą teksturę, więc DrawList::submit wyśle je jedną paczką.
+	for (std::size_t i = 0; i < live; ++i) {
+		const float size = (sizeStart[i] + sizeDelta[i] * age[i]) * textureScale;
+		const float halfW = frameWidth * size * 0.5f;
+		const float halfH = frameHeight * size * 0.5f;
+		const int frame = std::min(static_cast<int>(age[i] * textureFrames), textureFrames - 1);
+		Color c = color[i];
+		c.a = static_cast<unsigned char>(c.a * (1.f - age[i]));
+		list.sprite(texture, { frame * frameWidth, 0.f, frameWidth, frameHeight },
+			{ posX[i] - halfW, posY[i] - halfH, halfW * 2.f, halfH * 2.f }, c);
+	}
+
+	lastDrawMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParticleSystem::clear() {
+	live = 0;
+	spawnScale = 1.f;
+}
+
+bool ParticleSystem::saveState(SnapshotWriter& out) const {
+	out.write(static_cast<std::uint32_t>(live));
+	out.write(spawnScale);
+	// Tylko żywe cząsteczki - zajmują początek każdej kolumny.
+	for (const std::vector<float>* column : { &posX, &posY, &velX, &velY, &gravity, &age, &inverseLifetime, &sizeStart, &sizeDelta }) {
+		out.writeArray(column->data(), live);
+	}
+	return out.writeArray(color.data(), live);
+}
+
+bool ParticleSystem::restoreState(SnapshotReader& in) {
+	std::uint32_t count = 0;
+	float scale = 1.f;
+	if (!in.read(count) || !in.read(scale) || count > getCapacity()) {
+		return false;
+	}
+	for (std::vector<float>* column : { &posX, &posY, &velX, &velY, &gravity, &age, &inverseLifetime, &sizeStart, &sizeDelta }) {
+		in.readArray(column->data(), count);
+	}
+	if (!in.readArray(color.data(), count)) {
+		live = 0;
+		return false;
+	}
+	live = count;
+	spawnScale = scale;
+	return true;
+}
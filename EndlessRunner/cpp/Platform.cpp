@@ -0,0 +1,76 @@
+﻿/**
+ * @file Platform.cpp
+ * @brief Implementacja funkcji zależnych od systemu operacyjnego.
+ */
+
+module;
+#include <cstdint>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+module PlatformModule;
+
+#ifdef _WIN32
+
+double processCpuSeconds() {
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+		return 0.0;
+	}
+	auto toTicks = [](const FILETIME& time) {
+		return (static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+	};
+	// FILETIME liczy w jednostkach po 100 ns.
+	return static_cast<double>(toTicks(kernel) + toTicks(user)) * 1e-7;
+}
+
+bool readKeyAsync(int keyCode, std::intptr_t window, bool& down) {
+	if (window == 0 || GetForegroundWindow() != reinterpret_cast<HWND>(window)) {
+		return false;
+	}
+	// Kody raylib (GLFW) dla spacji, cyfr i liter to kody ASCII, tak jak kody wirtualne Windows.
+	int virtualKey = 0;
+	if (keyCode == 32 || (keyCode >= '0' && keyCode <= '9') || (keyCode >= 'A' && keyCode <= 'Z')) {
+		virtualKey = keyCode;
+	}
+	else {
+		switch (keyCode) {
+		case 256: virtualKey = VK_ESCAPE; break;    // KEY_ESCAPE
+		case 257: virtualKey = VK_RETURN; break;    // KEY_ENTER
+		case 258: virtualKey = VK_TAB; break;       // KEY_TAB
+		case 259: virtualKey = VK_BACK; break;      // KEY_BACKSPACE
+		case 262: virtualKey = VK_RIGHT; break;     // KEY_RIGHT
+		case 263: virtualKey = VK_LEFT; break;      // KEY_LEFT
+		case 264: virtualKey = VK_DOWN; break;      // KEY_DOWN
+		case 265: virtualKey = VK_UP; break;        // KEY_UP
+		case 340: virtualKey = VK_LSHIFT; break;    // KEY_LEFT_SHIFT
+		case 341: virtualKey = VK_LCONTROL; break;  // KEY_LEFT_CONTROL
+		case 344: virtualKey = VK_RSHIFT; break;    // KEY_RIGHT_SHIFT
+		case 345: virtualKey = VK_RCONTROL; break;  // KEY_RIGHT_CONTROL
+		default: return false;
+		}
+	}
+	down = (GetAsyncKeyState(virtualKey) & 0x8000) != 0;
+	return true;
+}
+
+#else
+
+double processCpuSeconds() {
+	timespec time{};
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+		return 0.0;
+	}
+	return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+}
+
+bool readKeyAsync(int, std::intptr_t, bool&) {
+	return false;
+}
+
+#endif
@@ -5,23 +5,90 @@
 
 module;
 #include "raylib.h"
+#include <algorithm>
 #include <iostream>
 
 module PlayerModule;
 
+import AnimationSystemModule;
+import AudioModule;
+
 void Player::init(const Texture2D& dinoTex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
 	AnimatedSprite::init(dinoTex, startX, startY, scaleFactor, frameCount, animUpdateTime);
 	groundLevel = startY - 65.f;
 	screenPos.y = groundLevel - height * scale;
+	jumpsTaken = 0;
 	if (texture.id == 0 || texture.width == 0 || texture.height == 0) {
 		std::cout << "Error: Invalid texture dimensions!\n";
 	}
 }
 
+void Player::requestJump(float offset) {
+	if (pendingJumps < static_cast<int>(jumpOffsets.size())) {
+		jumpOffsets[pendingJumps++] = offset;
+	}
+}
+
+PlayerState Player::getState() const {
+	PlayerState state;
+	state.x = screenPos.x;
+	state.y = screenPos.y;
+	state.velocity = velocity;
+	state.groundLevel = groundLevel;
+	state.jumpOffsets = jumpOffsets;
+	state.jumpCount = jumpCount;
+	state.pendingJumps = pendingJumps;
+	state.jumpsTaken = jumpsTaken;
+	state.animationPhase = clip.getPhase();
+	state.inAir = isInAir ? 1 : 0;
+	state.silent = silent ? 1 : 0;
+	return state;
+}
+
+void Player::setState(const PlayerState& state) {
+	screenPos = { state.x, state.y };
+	velocity = state.velocity;
+	groundLevel = state.groundLevel;
+	jumpOffsets = state.jumpOffsets;
+	jumpCount = std::clamp(state.jumpCount, 0, maxJumps);
+	pendingJumps = std::clamp(state.pendingJumps, 0, static_cast<int>(jumpOffsets.size()));
+	jumpsTaken = state.jumpsTaken;
+	isInAir = state.inAir != 0;
+	silent = state.silent != 0;
+	clip.setPhase(state.animationPhase);
+	clip.setPlaying(!isInAir);
+}
+
 void Player::update(float deltaTime, int windowHeight) {
 	groundLevel = windowHeight - 65.f;
 
-	if (isOnGround(windowHeight)) {
+	// Krok dzielimy w chwilach wciśnięć: skok zaczyna się tam, gdzie nastąpił, a nie na granicy klatki.
+	float elapsed = 0.f;
+	for (int i = 0; i < pendingJumps; ++i) {
+		const float offset = std::clamp(jumpOffsets[i], elapsed, deltaTime);
+		integrate(offset - elapsed);
+		elapsed = offset;
+		if (jumpCount < maxJumps) {
+			velocity += jumpVelocity;
+			jumpCount++;
+			jumpsTaken++;
+			isInAir = true;
+			if (!silent) {
+				audio().play(Sfx::JUMP);
+			}
+		}
+	}
+	pendingJumps = 0;
+	integrate(deltaTime - elapsed);
+
+	// Klip gracza jest przesuwany przez AnimationSystem; w powietrzu animacja biegu stoi.
+	clip.setPlaying(!isInAir);
+
+}
+
+void Player::integrate(float deltaTime) {
+	// Gracz na ziemi z prędkością w górę właśnie skoczył - nie zerujemy skoku.
+	if (screenPos.y >= groundLevel - height * scale && velocity >= 0.f) {
 		velocity = 0.f;
 		isInAir = false;
 		jumpCount = 0;
@@ -31,11 +98,6 @@ void Player::update(float deltaTime, int windowHeight) {
 		isInAir = true;
 	}
 
-	if (IsKeyPressed(KEY_SPACE) && jumpCount < maxJumps) {
-		velocity += jumpVelocity;
-		jumpCount++;
-	}
-
 	screenPos.y += velocity * deltaTime;
 	if (screenPos.y > groundLevel - height * scale) {
 		screenPos.y = groundLevel - height * scale;
@@ -43,11 +105,15 @@ void Player::update(float deltaTime, int windowHeight) {
 		isInAir = false;
 		jumpCount = 0;
 	}
+}
 
-	if (!isInAir) {
-		updateAnimation(deltaTime);
-	}
-
+void Player::drawGhost(DrawList& list, float heightAboveGround, float time, Color tint) const {
+	// W powietrzu duch stoi w pierwszej klatce, tak jak zatrzymany klip gracza.
+	const int frames = std::max(static_cast<int>(maxFrames), 1);
+	const int frame = heightAboveGround > 0.f ? 0 : static_cast<int>(time / Config::ANIMATION_UPDATE_TIME) % frames;
+	Rectangle source{ frame * width, 0.f, width, height };
+	Rectangle dest{ screenPos.x, groundLevel - height * scale - heightAboveGround, width * scale, height * scale };
+	list.sprite(texture, source, dest, tint);
 }
 
 bool Player::isOnGround(int windowHeight) const {
@@ -0,0 +1,92 @@
+﻿/**
+ * @file Presenter.cpp
+ * @brief Implementacja klasy Presenter.
+ */
+
+module;
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+module PresenterModule;
+
+Presenter::~Presenter() {
+	if (target.id != 0 && IsWindowReady()) {
+		UnloadRenderTexture(target);
+	}
+}
+
+int Presenter::getWorldWidth() const {
+	return mode == RenderMode::FIXED ? Config::DEFAULT_WINDOW_WIDTH : GetScreenWidth();
+}
+
+int Presenter::getWorldHeight() const {
+	return mode == RenderMode::FIXED ? Config::DEFAULT_WINDOW_HEIGHT : GetScreenHeight();
+}
+
+void Presenter::begin() {
+	if (mode != RenderMode::FIXED) {
+		return;
+	}
+	if (target.id == 0) {
+		target = LoadRenderTexture(Config::INTERNAL_RENDER_WIDTH, Config::INTERNAL_RENDER_HEIGHT);
+		// Piksele tekstury mają pozostać ostrymi kwadratami po powiększeniu.
+		SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);
+	}
+
+	Camera2D camera{};
+	camera.zoom = static_cast<float>(Config::INTERNAL_RENDER_HEIGHT) / Config::DEFAULT_WINDOW_HEIGHT;
+	BeginTextureMode(target);
+	BeginMode2D(camera);
+}
+
+void Presenter::end() {
+	if (mode != RenderMode::FIXED) {
+		return;
+	}
+	EndMode2D();
+	EndTextureMode();
+
+	ClearBackground(BLACK);
+	// Tekstury docelowe OpenGL mają oś Y skierowaną w górę - ujemna wysokość źródła odwraca obraz.
+	DrawTexturePro(target.texture,
+		Rectangle{ 0, 0, static_cast<float>(Config::INTERNAL_RENDER_WIDTH), -static_cast<float>(Config::INTERNAL_RENDER_HEIGHT) },
+		viewport(GetScreenWidth(), GetScreenHeight()), Vector2{ 0, 0 }, 0.0f, WHITE);
+}
+
+Rectangle Presenter::viewport(int screenWidth, int screenHeight) {
+	const float fitScale = std::min(
+		static_cast<float>(screenWidth) / Config::INTERNAL_RENDER_WIDTH,
+		static_cast<float>(screenHeight) / Config::INTERNAL_RENDER_HEIGHT);
+	const float scale = fitScale >= 1.0f ? std::floor(fitScale) : fitScale;
+
+	const float width = Config::INTERNAL_RENDER_WIDTH * scale;
+	const float height = Config::INTERNAL_RENDER_HEIGHT * scale;
+	return Rectangle{
+		std::floor((screenWidth - width) / 2.0f),
+		std::floor((screenHeight - height) / 2.0f),
+		width,
+		height
+	};
+}
+
+Presenter& presenter() {
+	static Presenter instance;
+	return instance;
+}
+
+bool parseRenderMode(std::string_view name, RenderMode& out) {
+	if (name == "native") out = RenderMode::NATIVE;
+	else if (name == "fixed") out = RenderMode::FIXED;
+	else return false;
+	return true;
+}
+
+const char* renderModeName(RenderMode renderMode) {
+	switch (renderMode) {
+	case RenderMode::NATIVE: return "native";
+	case RenderMode::FIXED: return "fixed";
+	}
+	return "unknown";
+}
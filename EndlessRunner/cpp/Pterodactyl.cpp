@@ -8,16 +8,18 @@ module;
 
 module PterodactylModule;
 
+import DrawListModule;
+
 void Pterodactyl::init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
-	Obstacle::init(tex, startX, startY - 260.f, scaleFactor, frameCount, animUpdateTime);
+	Obstacle::init(tex, startX, startY - Config::PTERODACTYL_ALTITUDE, scaleFactor, frameCount, animUpdateTime);
 }
 
 void Pterodactyl::update(float deltaTime) {
 	Obstacle::update(deltaTime);
 }
 
-void Pterodactyl::draw() const {
-	AnimatedSprite::draw();
+void Pterodactyl::draw(DrawList& list) const {
+	AnimatedSprite::draw(list);
 }
 
 Rectangle Pterodactyl::getCollisionRec() const {
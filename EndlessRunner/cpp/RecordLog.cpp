@@ -0,0 +1,202 @@
+﻿/**
+ * @file RecordLog.cpp
+ * @brief Implementacja klasy RecordLog.
+ */
+
+module;
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+module RecordLogModule;
+
+RecordLog::RecordLog(std::string filePath) : path(std::move(filePath)) {}
+
+AppendResult RecordLog::append(std::string_view record, const std::function<bool()>& precondition) {
+	if (record.find('\n') != std::string_view::npos) {
+		return AppendResult::FAILED;
+	}
+	std::string line(record);
+	line += '\n';
+	return writeLocked(line, precondition);
+}
+
+AppendResult RecordLog::appendBatch(const std::vector<std::string>& records) {
+	if (records.empty()) {
+		return AppendResult::WRITTEN;
+	}
+	std::string text;
+	for (const std::string& record : records) {
+		if (record.find('\n') != std::string::npos) {
+			return AppendResult::FAILED;
+		}
+		text += record;
+		text += '\n';
+	}
+	return writeLocked(text, {});
+}
+
+AppendResult RecordLog::appendBytes(std::string_view bytes) {
+	if (bytes.empty()) {
+		return AppendResult::WRITTEN;
+	}
+	return writeLocked(bytes, {});
+}
+
+#ifdef _WIN32
+
+AppendResult RecordLog::writeLocked(std::string_view text, const std::function<bool()>& precondition) {
+	// FILE_APPEND_DATA bez FILE_WRITE_DATA sprawia, że każdy zapis trafia na aktualny koniec pliku.
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | FILE_APPEND_DATA,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return AppendResult::FAILED;
+	}
+	// Blokady w Windows są obowiązkowe dla zablokowanych bajtów, dlatego blokujemy bajt daleko za końcem pliku:
+	// zapisujący czekają na siebie nawzajem, a czytelnicy nigdy go nie dotykają.
+	OVERLAPPED lockRange{};
+	lockRange.OffsetHigh = 0x7FFFFFFF;
+	if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &lockRange)) {
+		CloseHandle(file);
+		return AppendResult::FAILED;
+	}
+
+	AppendResult result = AppendResult::WRITTEN;
+	if (precondition && !precondition()) {
+		result = AppendResult::REJECTED;
+	}
+	else {
+		DWORD written = 0;
+		if (!WriteFile(file, text.data(), static_cast<DWORD>(text.size()), &written, nullptr) || written != text.size()) {
+			result = AppendResult::FAILED;
+		}
+	}
+
+	UnlockFileEx(file, 0, 1, 0, &lockRange);
+	CloseHandle(file);
+	return result;
+}
+
+#else
+
+AppendResult RecordLog::writeLocked(std::string_view text, const std::function<bool()>& precondition) {
+	// O_APPEND przesuwa pozycję na koniec pliku atomowo z każdym zapisem.
+	int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		return AppendResult::FAILED;
+	}
+	int locked;
+	while ((locked = ::flock(fd, LOCK_EX)) != 0 && errno == EINTR) {
+	}
+	if (locked != 0) {
+		::close(fd);
+		return AppendResult::FAILED;
+	}
+
+	AppendResult result = AppendResult::WRITTEN;
+	if (precondition && !precondition()) {
+		result = AppendResult::REJECTED;
+	}
+	else {
+		// Zapis może zostać przerwany w połowie - blokada gwarantuje, że nikt nie wpisze się pomiędzy fragmenty.
+		std::size_t done = 0;
+		while (done < text.size()) {
+			const ssize_t count = ::write(fd, text.data() + done, text.size() - done);
+			if (count < 0 && errno == EINTR) {
+				continue;
+			}
+			if (count <= 0) {
+				result = AppendResult::FAILED;
+				break;
+			}
+			done += static_cast<std::size_t>(count);
+		}
+	}
+
+	::flock(fd, LOCK_UN);
+	::close(fd);
+	return result;
+}
+
+#endif
+
+ReadResult RecordLog::readNew(const std::function<void(std::string_view)>& onRecord) {
+	ReadResult result;
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		// Brak pliku to pusty dziennik; jeśli wcześniej coś przeczytano, plik został usunięty.
+		result.restarted = offset != 0;
+		offset = 0;
+		return result;
+	}
+	file.seekg(0, std::ios::end);
+	const std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+	if (size < offset) {
+		// Plik skrócono lub podmieniono - zapamiętana pozycja nic już nie znaczy.
+		result.restarted = true;
+		offset = 0;
+		return result;
+	}
+	if (size == offset) {
+		return result;
+	}
+
+	file.seekg(static_cast<std::streamoff>(offset));
+	std::vector<char> chunk(Config::RECORD_READ_CHUNK);
+	std::string carry;
+	std::uint64_t position = offset;
+	std::uint64_t remaining = size - offset;
+	while (remaining > 0 && file) {
+		const std::size_t wanted = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, chunk.size()));
+		file.read(chunk.data(), static_cast<std::streamsize>(wanted));
+		const std::size_t got = static_cast<std::size_t>(file.gcount());
+		if (got == 0) {
+			break;
+		}
+		remaining -= got;
+
+		std::size_t lineStart = 0;
+		for (std::size_t i = 0; i < got; ++i) {
+			if (chunk[i] != '\n') {
+				continue;
+			}
+			std::string_view line;
+			if (carry.empty()) {
+				line = std::string_view(chunk.data() + lineStart, i - lineStart);
+			}
+			else {
+				carry.append(chunk.data() + lineStart, i - lineStart);
+				line = carry;
+			}
+			// Starsze wersje gry zapisywały plik w trybie tekstowym, więc w Windows wiersze kończą się \r\n.
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+			onRecord(line);
+			result.records++;
+			carry.clear();
+			lineStart = i + 1;
+		}
+		carry.append(chunk.data() + lineStart, got - lineStart);
+		position += got;
+	}
+	// Niedokończony wiersz (zapis w toku) zostanie przeczytany w całości przy następnym wywołaniu.
+	offset = position - carry.size();
+	return result;
+}
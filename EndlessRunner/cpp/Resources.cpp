@@ -5,75 +5,184 @@
 
 module;
 #include "raylib.h"
+#include <chrono>
+#include <cmath>
 #include <filesystem>
-#include <ranges>
+#include <iostream>
+#include <limits>
+#include <vector>
 
 module ResourcesModule;
 
+import TextureCacheModule;
+
+const std::vector<Resources::TextureSource>& Resources::manifest() {
+	// Pierwsze są tekstury ekranu ładowania - beginLoading() wczytuje je od razu, bo są rysowane już w pierwszej klatce.
+	static const std::vector<TextureSource> sources = {
+		{ &TextureKeys::UI::LOADING_SCREEN_BG, "textures/loading_screen.png" },
+		{ &TextureKeys::UI::BAR_EMPTY, "textures/barempty.png" },
+		{ &TextureKeys::UI::BAR_FULL, "textures/barfill.png" },
+		{ &TextureKeys::UI::MENU_BG, "textures/main_menu_background.png" },
+		{ &TextureKeys::UI::REGISTRATION_BG, "textures/registration_with_table.png" },
+		{ &TextureKeys::UI::SHOP_BG, "textures/shop.png" },
+		{ &TextureKeys::UI::LEADERBOARD, "textures/leaderboard.png" },
+		{ &TextureKeys::UI::HEART_ICON, "textures/life_icon.png" },
+		{ &TextureKeys::UI::LIFE_LOST_ICON, "textures/life_lost_icon.png" },
+		{ &TextureKeys::UI::NUMBERS, "textures/numbers.png" },
+		{ &TextureKeys::UI::BUTTON, "textures/button.png" },
+		{ &TextureKeys::UI::BANNER, "textures/banner4.png" },
+		{ &TextureKeys::Characters::DINO_SHADOW, "textures/Characters/shadow_2.png" },
+		{ &TextureKeys::Characters::DUST_RUN, "textures/Characters/dust.png" },
+		{ &TextureKeys::Characters::GREEN_DINO_IDLE, "textures/Characters/Player 1/p1_idle.png" },
+		{ &TextureKeys::Characters::BLUE_DINO_IDLE, "textures/Characters/Player 2/p2_idle.png" },
+		{ &TextureKeys::Characters::YELLOW_DINO_IDLE, "textures/Characters/Player 3/p3_idle.png" },
+		{ &TextureKeys::Characters::RED_DINO_IDLE, "textures/Characters/Player 4/p4_idle.png" },
+		{ &TextureKeys::Characters::GREEN_DINO_RUN, "textures/Characters/Player 1/p1_run.png" },
+		{ &TextureKeys::Characters::BLUE_DINO_RUN, "textures/Characters/Player 2/p2_run.png" },
+		{ &TextureKeys::Characters::YELLOW_DINO_RUN, "textures/Characters/Player 3/p3_run.png" },
+		{ &TextureKeys::Characters::RED_DINO_RUN, "textures/Characters/Player 4/p4_run.png" },
+		{ &TextureKeys::Characters::NEBULA, "textures/12_nebula_spritesheet.png" },
+		{ &TextureKeys::Characters::PTERO, "textures/pterosaur_spritesheet.png" },
+		{ &TextureKeys::Characters::BAT, "textures/BatIdleMoving.png" },
+		{ &TextureKeys::Backgrounds::DESERT_BG, "textures/Desert/bg_1.png" },
+		{ &TextureKeys::Backgrounds::DESERT_MG, "textures/Desert/bg_2.png" },
+		{ &TextureKeys::Backgrounds::DESERT_FG, "textures/Desert/bg_3.png" },
+		{ &TextureKeys::Backgrounds::DESERT_GR, "textures/Desert/ground.png" },
+		{ &TextureKeys::Backgrounds::DESERT_NIGHT_BG, "textures/Desert/night_bg_1.png" },
+		{ &TextureKeys::Backgrounds::DESERT_NIGHT_MG, "textures/Desert/night_bg_2.png" },
+		{ &TextureKeys::Backgrounds::DESERT_NIGHT_FG, "textures/Desert/night_bg_3.png" },
+		{ &TextureKeys::Backgrounds::DESERT_NIGHT_GR, "textures/Desert/night_ground.png" },
+		{ &TextureKeys::Backgrounds::FOREST_BG, "textures/Forest/bg_1.png" },
+		{ &TextureKeys::Backgrounds::FOREST_MG, "textures/Forest/bg_2.png" },
+		{ &TextureKeys::Backgrounds::FOREST_FG, "textures/Forest/bg_3.png" },
+		{ &TextureKeys::Backgrounds::FOREST_GR, "textures/Forest/ground.png" },
+		{ &TextureKeys::Backgrounds::FOREST_NIGHT_BG, "textures/Forest/night_bg_1.png" },
+		{ &TextureKeys::Backgrounds::FOREST_NIGHT_MG, "textures/Forest/night_bg_2.png" },
+		{ &TextureKeys::Backgrounds::FOREST_NIGHT_FG, "textures/Forest/night_bg_3.png" },
+		{ &TextureKeys::Backgrounds::FOREST_NIGHT_GR, "textures/Forest/night_ground.png" },
+		{ &TextureKeys::Obstacles::SMALL_CACTUS, "textures/Desert/small_cactus.png" },
+		{ &TextureKeys::Obstacles::BIG_CACTUS, "textures/Desert/big_cactus.png" },
+		{ &TextureKeys::Obstacles::SKULLS, "textures/Desert/skulls.png" },
+		{ &TextureKeys::Obstacles::SKULLS2, "textures/Desert/skulls2.png" },
+		{ &TextureKeys::Obstacles::ROCK_D, "textures/Desert/rock.png" },
+		{ &TextureKeys::Obstacles::BIG_ROCK_D, "textures/Desert/big_rock.png" },
+		{ &TextureKeys::Obstacles::ROCK_D_N, "textures/Desert/rock_n.png" },
+		{ &TextureKeys::Obstacles::BIG_ROCK_D_N, "textures/Desert/big_rock_n.png" },
+		{ &TextureKeys::Obstacles::ROCK_F, "textures/Forest/rock_f.png" },
+		{ &TextureKeys::Obstacles::BIG_ROCK_F, "textures/Forest/big_rock_f.png" },
+		{ &TextureKeys::Obstacles::SMALL_TREE, "textures/Forest/small_tree.png" },
+		{ &TextureKeys::Obstacles::BIG_TREE, "textures/Forest/big_tree.png" },
+		{ &TextureKeys::Obstacles::LOG, "textures/Forest/log.png" },
+		{ &TextureKeys::Obstacles::SPIKES, "textures/Forest/spikes.png" },
+		{ &TextureKeys::Obstacles::SMALL_TREE_N, "textures/Forest/small_tree_n.png" },
+		{ &TextureKeys::Obstacles::BIG_TREE_N, "textures/Forest/big_tree_n.png" },
+		{ &TextureKeys::Obstacles::LOG_N, "textures/Forest/log_n.png" },
+		{ &TextureKeys::Obstacles::SPIKES_N, "textures/Forest/spikes_n.png" },
+	};
+	return sources;
+}
+
 void Resources::loadTextures() {
-	loadTexture<Texture2D>(TextureKeys::UI::MENU_BG, "textures/main_menu_background.png");
-	loadTexture<Texture2D>(TextureKeys::UI::LOADING_SCREEN_BG, "textures/loading_screen.png");
-	loadTexture<Texture2D>(TextureKeys::UI::BAR_EMPTY, "textures/barempty.png");
-	loadTexture<Texture2D>(TextureKeys::UI::BAR_FULL, "textures/barfill.png");
-	loadTexture<Texture2D>(TextureKeys::UI::REGISTRATION_BG, "textures/registration_with_table.png");
-	loadTexture<Texture2D>(TextureKeys::UI::SHOP_BG, "textures/shop.png");
-	loadTexture<Texture2D>(TextureKeys::UI::LEADERBOARD, "textures/leaderboard.png");
-	loadTexture<Texture2D>(TextureKeys::UI::HEART_ICON, "textures/life_icon.png");
-	loadTexture<Texture2D>(TextureKeys::UI::LIFE_LOST_ICON, "textures/life_lost_icon.png");
-	loadTexture<Texture2D>(TextureKeys::UI::NUMBERS, "textures/numbers.png");
-	loadTexture<Texture2D>(TextureKeys::UI::BUTTON, "textures/button.png");
-	loadTexture<Texture2D>(TextureKeys::UI::BANNER, "textures/banner4.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::DINO_SHADOW, "textures/Characters/shadow_2.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::DUST_RUN, "textures/Characters/dust.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_IDLE, "textures/Characters/Player 1/p1_idle.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_IDLE, "textures/Characters/Player 2/p2_idle.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_IDLE, "textures/Characters/Player 3/p3_idle.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::RED_DINO_IDLE, "textures/Characters/Player 4/p4_idle.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_RUN, "textures/Characters/Player 1/p1_run.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_RUN, "textures/Characters/Player 2/p2_run.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_RUN, "textures/Characters/Player 3/p3_run.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::RED_DINO_RUN, "textures/Characters/Player 4/p4_run.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::NEBULA, "textures/12_nebula_spritesheet.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::PTERO, "textures/pterosaur_spritesheet.png");
-	loadTexture<Texture2D>(TextureKeys::Characters::BAT, "textures/BatIdleMoving.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_BG, "textures/Desert/bg_1.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_MG, "textures/Desert/bg_2.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_FG, "textures/Desert/bg_3.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_GR, "textures/Desert/ground.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_BG, "textures/Desert/night_bg_1.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_MG, "textures/Desert/night_bg_2.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_FG, "textures/Desert/night_bg_3.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_GR, "textures/Desert/night_ground.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_BG, "textures/Forest/bg_1.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_MG, "textures/Forest/bg_2.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_FG, "textures/Forest/bg_3.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_GR, "textures/Forest/ground.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_BG, "textures/Forest/night_bg_1.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_MG, "textures/Forest/night_bg_2.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_FG, "textures/Forest/night_bg_3.png");
-	loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_GR, "textures/Forest/night_ground.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_CACTUS, "textures/Desert/small_cactus.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_CACTUS, "textures/Desert/big_cactus.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SKULLS, "textures/Desert/skulls.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SKULLS2, "textures/Desert/skulls2.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D, "textures/Desert/rock.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D, "textures/Desert/big_rock.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D_N, "textures/Desert/rock_n.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D_N, "textures/Desert/big_rock_n.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_F, "textures/Forest/rock_f.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_F, "textures/Forest/big_rock_f.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE, "textures/Forest/small_tree.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE, "textures/Forest/big_tree.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::LOG, "textures/Forest/log.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SPIKES, "textures/Forest/spikes.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE_N, "textures/Forest/small_tree_n.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE_N, "textures/Forest/big_tree_n.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::LOG_N, "textures/Forest/log_n.png");
-	loadTexture<Texture2D>(TextureKeys::Obstacles::SPIKES_N, "textures/Forest/spikes_n.png");
+	beginLoading();
+	while (!loadNext(std::numeric_limits<double>::infinity())) {
+	}
+}
+
+void Resources::beginLoading() {
+	loadStart = std::chrono::steady_clock::now();
+	textureCache().mountPack(Config::ASSET_PACK_FILE);
+	loadCursor = 0;
+	loading = true;
+	while (loadCursor < LOADING_SCREEN_TEXTURES) {
+		const TextureSource& source = manifest()[loadCursor++];
+		loadTexture<Texture2D>(*source.key, source.path);
+	}
+}
+
+bool Resources::loadNext(double budgetSeconds) {
+	if (!loading) {
+		return true;
+	}
+	const std::vector<TextureSource>& sources = manifest();
+	const auto start = std::chrono::steady_clock::now();
+	// Co najmniej jedna tekstura na wywołanie, żeby wczytywanie postępowało nawet przy zerowym budżecie.
+	do {
+		if (loadCursor == sources.size()) break;
+		const TextureSource& source = sources[loadCursor++];
+		loadTexture<Texture2D>(*source.key, source.path);
+	} while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < budgetSeconds);
+
+	if (loadCursor < sources.size()) {
+		return false;
+	}
+	buildCollisionMasks();
+	loading = false;
+	std::cout << "Textures ready in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count()
+		<< " ms (" << (textureCache().hasPack() ? "asset pack" : "loose files") << ")\n";
+	textureCache().printReport();
+	return true;
+}
+
+float Resources::getLoadingProgress() const {
+	if (!loading) {
+		return 1.0f;
+	}
+	return static_cast<float>(loadCursor) / static_cast<float>(manifest().size());
 }
 
 void Resources::unloadTextures() {
-	for (auto& texture : textures | std::ranges::views::values) {
-		UnloadTexture(texture);
+	textures.clear();
+	collisionMasks.clear();
+}
+
+const CollisionMask* Resources::getCollisionMask(const Texture2D& tex) const {
+	auto it = collisionMasks.find(tex.id);
+	return it != collisionMasks.end() ? &it->second : nullptr;
+}
+
+void Resources::buildCollisionMasks() {
+	for (const std::string* key : { &TextureKeys::Characters::GREEN_DINO_RUN, &TextureKeys::Characters::BLUE_DINO_RUN,
+		&TextureKeys::Characters::YELLOW_DINO_RUN, &TextureKeys::Characters::RED_DINO_RUN }) {
+		buildCollisionMask(*key, Config::PLAYER_SCALE);
+	}
+	for (const std::string* key : { &TextureKeys::Characters::PTERO, &TextureKeys::Characters::BAT,
+		&TextureKeys::Obstacles::SMALL_CACTUS, &TextureKeys::Obstacles::BIG_CACTUS,
+		&TextureKeys::Obstacles::SKULLS, &TextureKeys::Obstacles::SKULLS2,
+		&TextureKeys::Obstacles::ROCK_D, &TextureKeys::Obstacles::BIG_ROCK_D,
+		&TextureKeys::Obstacles::ROCK_D_N, &TextureKeys::Obstacles::BIG_ROCK_D_N,
+		&TextureKeys::Obstacles::ROCK_F, &TextureKeys::Obstacles::BIG_ROCK_F,
+		&TextureKeys::Obstacles::SMALL_TREE, &TextureKeys::Obstacles::BIG_TREE,
+		&TextureKeys::Obstacles::LOG, &TextureKeys::Obstacles::SPIKES,
+		&TextureKeys::Obstacles::SMALL_TREE_N, &TextureKeys::Obstacles::BIG_TREE_N,
+		&TextureKeys::Obstacles::LOG_N, &TextureKeys::Obstacles::SPIKES_N }) {
+		buildCollisionMask(*key, Config::OBSTACLE_SCALE);
+	}
+}
+
+void Resources::buildCollisionMask(const std::string& key, float scale) {
+	auto it = textures.find(key);
+	if (it == textures.end() || it->second.isFallback() || it->second.get().id == 0) {
+		return;
+	}
+	// Po ponownym loadTextures() tekstura ma ten sam identyfikator, więc maska jest nadal aktualna.
+	const Texture2D& texture = it->second.get();
+	if (collisionMasks.contains(texture.id)) {
+		return;
+	}
+	// Maska ma rozdzielczość ekranu, więc wymaga całkowitej skali sprite'a; w innym wypadku zostaje test prostokątów.
+	int integerScale = static_cast<int>(std::lround(scale));
+	if (integerScale <= 0 || static_cast<float>(integerScale) != scale) {
+		std::cout << "Collision mask skipped for " << key << ": non-integer scale\n";
+		return;
+	}
+
+	// W trybie bez okna obraz jest już w RAM; w przeciwnym razie trzeba go pobrać z GPU.
+	Image image = textureCache().isHeadless() ? ImageCopy(it->second.getImage()) : LoadImageFromTexture(texture);
+	CollisionMask mask = CollisionMask::fromImage(image, integerScale);
+	UnloadImage(image);
+	if (mask.isEmpty()) {
+		std::cout << "Collision mask failed for " << key << "\n";
+		return;
 	}
+	collisionMasks[texture.id] = std::move(mask);
 }
\ No newline at end of file
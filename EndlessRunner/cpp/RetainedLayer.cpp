@@ -0,0 +1,75 @@
+﻿/**
+ * @file RetainedLayer.cpp
+ * @brief Implementacja klas RetainedLayer i LayerReport.
+ */
+
+module;
+#include "raylib.h"
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+module RetainedLayerModule;
+
+RetainedLayer::~RetainedLayer() {
+	// Sklep należy do main i jest niszczony po CloseWindow() - wtedy kontekstu GL już nie ma.
+	if (target.id != 0 && IsWindowReady()) {
+		UnloadRenderTexture(target);
+	}
+}
+
+void RetainedLayer::beginRebuild(int screenWidth, int screenHeight) {
+	if (target.id == 0 || screenWidth != width || screenHeight != height) {
+		if (target.id != 0) {
+			UnloadRenderTexture(target);
+		}
+		target = LoadRenderTexture(screenWidth, screenHeight);
+		width = screenWidth;
+		height = screenHeight;
+	}
+	BeginTextureMode(target);
+	ClearBackground(BLANK);
+}
+
+void RetainedLayer::endRebuild(std::uint64_t key) {
+	EndTextureMode();
+	stateKey = key;
+	valid = true;
+	stats->rebuilds++;
+	stats->cachedDrawCalls += staticDrawCalls;
+}
+
+void RetainedLayer::composite() {
+	// Tekstury docelowe OpenGL mają oś Y skierowaną w górę - ujemna wysokość źródła odwraca obraz.
+	DrawTextureRec(target.texture,
+		Rectangle{ 0, 0, static_cast<float>(width), -static_cast<float>(height) },
+		Vector2{ 0, 0 }, WHITE);
+	stats->frames++;
+	stats->uncachedDrawCalls += staticDrawCalls;
+	stats->cachedDrawCalls++;
+}
+
+void LayerReport::printReport() const {
+	for (const auto& [name, layer] : layers) {
+		if (layer.frames == 0) {
+			continue;
+		}
+		const double frames = static_cast<double>(layer.frames);
+		std::cout << name << " layer: " << layer.frames << " frames, " << layer.rebuilds << " rebuilds, "
+			<< std::fixed << std::setprecision(2) << static_cast<double>(layer.uncachedDrawCalls) / frames << " -> "
+			<< static_cast<double>(layer.cachedDrawCalls) / frames << " draw calls per frame";
+		if (layer.uncachedDrawCalls > 0) {
+			std::cout << " (" << 100.0 - static_cast<double>(layer.cachedDrawCalls) * 100.0 / static_cast<double>(layer.uncachedDrawCalls)
+				<< "% fewer)";
+		}
+		std::cout << "\n";
+		std::cout.unsetf(std::ios::fixed);
+	}
+}
+
+LayerReport& layerReport() {
+	static LayerReport report;
+	return report;
+}
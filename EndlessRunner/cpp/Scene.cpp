@@ -0,0 +1,146 @@
+﻿/**
+ * @file Scene.cpp
+ * @brief Implementacja stosu scen i głównej pętli gry.
+ */
+
+module;
+#include "raylib.h"
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+module SceneModule;
+
+import AnimationSystemModule;
+import InputModule;
+
+void Scene::back(SceneManager& scenes) {
+	scenes.pop();
+}
+
+SceneManager::~SceneManager() {
+	pending.clear();
+	while (!stack.empty()) {
+		popNow();
+	}
+}
+
+void SceneManager::push(std::unique_ptr<Scene> scene) {
+	Scene* raw = scene.get();
+	pending.push_back({ Operation::PUSH, Entry{ raw, std::move(scene) } });
+}
+
+void SceneManager::push(Scene& scene) {
+	pending.push_back({ Operation::PUSH, Entry{ &scene, nullptr } });
+}
+
+void SceneManager::pop() {
+	pending.push_back({ Operation::POP, Entry{} });
+}
+
+void SceneManager::replace(std::unique_ptr<Scene> scene) {
+	Scene* raw = scene.get();
+	pending.push_back({ Operation::REPLACE, Entry{ raw, std::move(scene) } });
+}
+
+void SceneManager::clear() {
+	pending.push_back({ Operation::CLEAR, Entry{} });
+}
+
+void SceneManager::addTask(Task task) {
+	tasks.push_back(std::move(task));
+}
+
+void SceneManager::run() {
+	// Sceny stosu same obsługują ESC (powrót), więc raylib nie może zamykać nim okna.
+	SetExitKey(KEY_NULL);
+	while (!isEmpty()) {
+		if (WindowShouldClose()) {
+			clear();
+			applyPending();
+			break;
+		}
+		frame();
+	}
+}
+
+void SceneManager::frame() {
+	if (!stack.empty()) {
+		stack.back().scene->sync();
+	}
+	applyPending();
+	if (stack.empty()) {
+		return;
+	}
+	Scene& scene = *stack.back().scene;
+
+	input().beginFrame();
+	if (input().wasPressed(InputAction::BACK)) {
+		scene.back(*this);
+	}
+	const float deltaTime = GetFrameTime();
+	animations().advance(deltaTime);
+	scene.update(*this, deltaTime);
+	runTasks();
+
+	BeginDrawing();
+	scene.render();
+	EndDrawing();
+	framePacer().endFrame(scene.getFrameKind());
+}
+
+void SceneManager::runTasks() {
+	if (tasks.empty()) {
+		return;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < tasks.size();) {
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const double budget = Config::SCENE_TASK_BUDGET - elapsed;
+		if (budget <= 0.0) {
+			break;
+		}
+		if (tasks[i](budget)) {
+			tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(i));
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+void SceneManager::applyPending() {
+	// Scena wywołana w enter() może zgłosić kolejne zmiany - przetwarzamy je w tej samej pętli.
+	for (std::size_t i = 0; i < pending.size(); ++i) {
+		Pending change = std::move(pending[i]);
+		switch (change.operation) {
+		case Operation::REPLACE:
+			if (!stack.empty()) {
+				popNow();
+			}
+			[[fallthrough]];
+		case Operation::PUSH:
+			stack.push_back(std::move(change.entry));
+			stack.back().scene->enter(*this);
+			break;
+		case Operation::POP:
+			if (!stack.empty()) {
+				popNow();
+			}
+			break;
+		case Operation::CLEAR:
+			while (!stack.empty()) {
+				popNow();
+			}
+			break;
+		}
+	}
+	pending.clear();
+}
+
+void SceneManager::popNow() {
+	Entry entry = std::move(stack.back());
+	stack.pop_back();
+	entry.scene->exit();
+}
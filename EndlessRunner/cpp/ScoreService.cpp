@@ -0,0 +1,802 @@
+﻿/**
+ * @file ScoreService.cpp
+ * @brief Implementacja indeksu wyników, demona i klienta usługi wyników.
+ */
+
+module;
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+module ScoreServiceModule;
+
+namespace {
+#ifdef _WIN32
+	using NativeSocket = SOCKET;
+	const NativeSocket INVALID_NATIVE = INVALID_SOCKET;
+	/** @brief Flagi send() (Windows nie wysyła SIGPIPE). */
+	constexpr int SEND_FLAGS = 0;
+
+	/** @brief Inicjalizuje Winsock (raz na proces). @return True, jeśli gniazda są dostępne. */
+	bool socketsReady() {
+		static const bool ready = [] {
+			WSADATA data;
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		return ready;
+	}
+
+	void closeNative(NativeSocket socket) { closesocket(socket); }
+
+	bool setNonBlocking(NativeSocket socket) {
+		u_long enabled = 1;
+		return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+	}
+
+	bool setReceiveTimeout(NativeSocket socket, int milliseconds) {
+		DWORD timeout = static_cast<DWORD>(milliseconds);
+		return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) == 0;
+	}
+
+	int pollNative(pollfd* fds, std::size_t count, int timeoutMs) {
+		return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+	}
+
+	/** @brief Sprawdza, czy ostatnia operacja nie powiodła się tylko dlatego, że gniazdo nie jest gotowe. */
+	bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+	/** @brief Sprawdza, czy ostatnia operacja została przerwana sygnałem. */
+	bool interrupted() { return WSAGetLastError() == WSAEINTR; }
+#else
+	using NativeSocket = int;
+	const NativeSocket INVALID_NATIVE = -1;
+	/** @brief Flagi send() (zerwane połączenie ma zwrócić błąd zamiast zabijać proces sygnałem SIGPIPE). */
+	constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+
+	bool socketsReady() { return true; }
+
+	void closeNative(NativeSocket socket) { ::close(socket); }
+
+	bool setNonBlocking(NativeSocket socket) {
+		const int flags = ::fcntl(socket, F_GETFL, 0);
+		return flags >= 0 && ::fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+	}
+
+	bool setReceiveTimeout(NativeSocket socket, int milliseconds) {
+		timeval timeout{};
+		timeout.tv_sec = milliseconds / 1000;
+		timeout.tv_usec = (milliseconds % 1000) * 1000;
+		return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+	}
+
+	int pollNative(pollfd* fds, std::size_t count, int timeoutMs) {
+		return ::poll(fds, static_cast<nfds_t>(count), timeoutMs);
+	}
+
+	bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+	bool interrupted() { return errno == EINTR; }
+#endif
+
+	NativeSocket native(std::intptr_t socket) { return static_cast<NativeSocket>(socket); }
+
+	/**
+	 * @brief Wypełnia adres gniazda domeny Unix.
+	 * @param path Ścieżka gniazda.
+	 * @param address Miejsce na adres.
+	 * @return False, jeśli ścieżka jest za długa.
+	 */
+	bool makeAddress(const std::string& path, sockaddr_un& address) {
+		address = {};
+		address.sun_family = AF_UNIX;
+		if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+			return false;
+		}
+		std::memcpy(address.sun_path, path.data(), path.size());
+		return true;
+	}
+
+	/** @brief Kod odpowiedzi: sukces. */
+	constexpr std::uint8_t STATUS_OK = 0;
+	/** @brief Kod odpowiedzi: błędne żądanie. */
+	constexpr std::uint8_t STATUS_BAD_REQUEST = 1;
+	/** @brief Kod odpowiedzi: zgłoszenia nie udało się zapisać w pliku wyników. */
+	constexpr std::uint8_t STATUS_NOT_STORED = 2;
+	/** @brief Rozmiar nagłówka ramki (długość). */
+	constexpr std::size_t FRAME_HEADER = 2;
+
+	void putU8(std::string& out, std::uint8_t value) {
+		out.push_back(static_cast<char>(value));
+	}
+
+	void putU16(std::string& out, std::uint16_t value) {
+		out.push_back(static_cast<char>(value & 0xFF));
+		out.push_back(static_cast<char>(value >> 8));
+	}
+
+	void putU32(std::string& out, std::uint32_t value) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			out.push_back(static_cast<char>((value >> shift) & 0xFF));
+		}
+	}
+
+	void putName(std::string& out, std::string_view name) {
+		putU8(out, static_cast<std::uint8_t>(name.size()));
+		out.append(name);
+	}
+
+	/** @brief Wpisuje długość ramki zaczynającej się na pozycji start (po dopisaniu jej treści). */
+	void closeFrame(std::string& out, std::size_t start) {
+		const std::size_t length = out.size() - start - FRAME_HEADER;
+		out[start] = static_cast<char>(length & 0xFF);
+		out[start + 1] = static_cast<char>(length >> 8);
+	}
+
+	std::uint16_t peekU16(std::string_view data, std::size_t at) {
+		return static_cast<std::uint16_t>(static_cast<unsigned char>(data[at]) | (static_cast<unsigned char>(data[at + 1]) << 8));
+	}
+
+	/**
+	 * @struct FrameReader
+	 * @brief Czytnik pól ramki z kontrolą granic (po pierwszym błędzie wszystkie odczyty zwracają zera).
+	 */
+	struct FrameReader {
+		std::string_view data;
+		std::size_t position{ 0 };
+		bool ok{ true };
+
+		bool need(std::size_t bytes) {
+			ok = ok && data.size() - position >= bytes;
+			return ok;
+		}
+
+		std::uint8_t u8() {
+			return need(1) ? static_cast<std::uint8_t>(data[position++]) : 0;
+		}
+
+		std::uint16_t u16() {
+			if (!need(2)) return 0;
+			const std::uint16_t value = peekU16(data, position);
+			position += 2;
+			return value;
+		}
+
+		std::uint32_t u32() {
+			if (!need(4)) return 0;
+			std::uint32_t value = 0;
+			for (int i = 0; i < 4; ++i) {
+				value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[position + i])) << (8 * i);
+			}
+			position += 4;
+			return value;
+		}
+
+		std::string_view name() {
+			const std::size_t length = u8();
+			if (!need(length)) return {};
+			std::string_view value = data.substr(position, length);
+			position += length;
+			return value;
+		}
+
+		bool finished() const { return ok && position == data.size(); }
+	};
+
+	/**
+	 * @brief Zamienia wiersz pliku wyników (nazwa:wynik) na parę.
+	 * @return False, jeśli wiersz jest niepoprawny.
+	 */
+	bool parseScoreLine(std::string_view line, std::string_view& username, int& score) {
+		const std::size_t colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			return false;
+		}
+		const char* first = line.data() + colon + 1;
+		const char* last = line.data() + line.size();
+		while (first != last && (*first == ' ' || *first == '\t')) {
+			++first;
+		}
+		if (std::from_chars(first, last, score).ec != std::errc()) {
+			return false;
+		}
+		username = line.substr(0, colon);
+		return true;
+	}
+}
+
+ScoreIndex::ScoreIndex(int limit) : counts(static_cast<std::size_t>(std::max(limit, 1)) + 1, 0) {}
+
+std::size_t ScoreIndex::bucket(int score) const {
+	// Drzewo Fenwicka liczy od 1, a wynik 0 zajmuje pierwszy przedział.
+	return static_cast<std::size_t>(std::clamp(score, 0, static_cast<int>(counts.size()) - 2)) + 1;
+}
+
+void ScoreIndex::addCount(int score, int delta) {
+	for (std::size_t i = bucket(score); i < counts.size(); i += i & (~i + 1)) {
+		counts[i] += static_cast<std::uint32_t>(delta);
+	}
+}
+
+std::uint32_t ScoreIndex::countUpTo(int score) const {
+	std::uint32_t total = 0;
+	for (std::size_t i = bucket(score); i > 0; i -= i & (~i + 1)) {
+		total += counts[i];
+	}
+	return total;
+}
+
+bool ScoreIndex::submit(const std::string& username, int score) {
+	auto [it, inserted] = best.try_emplace(username, score);
+	if (!inserted) {
+		if (score <= it->second) {
+			return false;
+		}
+		ordered.erase({ it->second, username });
+		addCount(it->second, -1);
+		it->second = score;
+	}
+	ordered.insert({ score, username });
+	addCount(score, 1);
+	return true;
+}
+
+bool ScoreIndex::erase(const std::string& username) {
+	auto it = best.find(username);
+	if (it == best.end()) {
+		return false;
+	}
+	ordered.erase({ it->second, username });
+	addCount(it->second, -1);
+	best.erase(it);
+	return true;
+}
+
+std::vector<RankedScore> ScoreIndex::top(std::size_t k) const {
+	std::vector<RankedScore> entries;
+	entries.reserve(std::min(k, ordered.size()));
+	for (auto it = ordered.begin(); it != ordered.end() && entries.size() < k; ++it) {
+		entries.push_back({ it->second, it->first });
+	}
+	return entries;
+}
+
+std::uint32_t ScoreIndex::rank(const std::string& username, int* score) const {
+	auto it = best.find(username);
+	if (it == best.end()) {
+		return 0;
+	}
+	if (score != nullptr) {
+		*score = it->second;
+	}
+	return static_cast<std::uint32_t>(best.size()) - countUpTo(it->second) + 1;
+}
+
+ScoreServer::ScoreServer(std::string scoresPath) : log(std::move(scoresPath)) {}
+
+ScoreServer::~ScoreServer() {
+	stop();
+}
+
+bool ScoreServer::start(const std::string& path) {
+	stop();
+	sockaddr_un address;
+	if (!socketsReady() || !makeAddress(path, address)) {
+		std::cout << "Invalid score socket path: " << path << "\n";
+		return false;
+	}
+
+	// Plik gniazda zostaje po zakończonym demonie; usuwamy go tylko wtedy, gdy nikt na nim nie nasłuchuje.
+	if (std::filesystem::exists(path)) {
+		ScoreClient probe(path);
+		if (probe.connect()) {
+			std::cout << "Score daemon already running on " << path << "\n";
+			return false;
+		}
+		std::error_code error;
+		std::filesystem::remove(path, error);
+	}
+
+	NativeSocket socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (socket == INVALID_NATIVE) {
+		std::cout << "Failed to create score socket\n";
+		return false;
+	}
+	if (::bind(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+		|| ::listen(socket, SOMAXCONN) != 0 || !setNonBlocking(socket)) {
+		std::cout << "Failed to listen on " << path << "\n";
+		closeNative(socket);
+		return false;
+	}
+	listener = static_cast<std::intptr_t>(socket);
+	socketPath = path;
+
+	log.rewind();
+	index = ScoreIndex();
+	readLog();
+	return true;
+}
+
+void ScoreServer::stop() {
+	for (Connection& connection : connections) {
+		closeNative(native(connection.socket));
+	}
+	connections.clear();
+	if (listener != -1) {
+		closeNative(native(listener));
+		listener = -1;
+		std::error_code error;
+		std::filesystem::remove(socketPath, error);
+	}
+}
+
+void ScoreServer::readLog() {
+	auto apply = [this](std::string_view line) {
+		std::string_view username;
+		int score = 0;
+		if (parseScoreLine(line, username, score)) {
+			index.submit(std::string(username), score);
+		}
+	};
+	// Własne zgłoszenia demona wracają tu z pliku, ale ponowne zgłoszenie wyniku nie lepszego od najlepszego niczego nie zmienia.
+	if (log.readNew(apply).restarted) {
+		index = ScoreIndex();
+		log.readNew(apply);
+	}
+}
+
+void ScoreServer::serve(const std::atomic<bool>& running) {
+	std::vector<pollfd> fds;
+	while (running && listener != -1) {
+		fds.clear();
+		fds.push_back({ native(listener), POLLIN, 0 });
+		for (const Connection& connection : connections) {
+			const short events = static_cast<short>(POLLIN | (connection.out.empty() ? 0 : POLLOUT));
+			fds.push_back({ native(connection.socket), events, 0 });
+		}
+		if (pollNative(fds.data(), fds.size(), Config::SCORE_POLL_MS) < 0 && !interrupted()) {
+			std::cout << "Score daemon: poll failed\n";
+			break;
+		}
+
+		// Połączenia przyjęte w tym obiegu dołączają do poll() w następnym.
+		const std::size_t polled = fds.size() - 1;
+		for (std::size_t i = 0; i < polled; ++i) {
+			if (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) {
+				receive(connections[i]);
+			}
+		}
+		if (fds[0].revents & POLLIN) {
+			acceptClients();
+		}
+		for (Connection& connection : connections) {
+			answer(connection, true);
+		}
+
+		// Zgłoszenia trafiają do pliku przed wysłaniem odpowiedzi, więc potwierdzony wynik przetrwa awarię demona.
+		// Po nieudanym zapisie odpowiedzi z tego obiegu są budowane od nowa, z odmową dla zgłoszeń.
+		if (!pendingRecords.empty() && log.appendBatch(pendingRecords) != AppendResult::WRITTEN) {
+			std::cout << "Score daemon: failed to append to " << log.getPath() << "\n";
+			rollback();
+			for (Connection& connection : connections) {
+				connection.out.resize(connection.answeredOut);
+				answer(connection, false);
+			}
+		}
+		pendingRecords.clear();
+		pendingUndo.clear();
+		for (Connection& connection : connections) {
+			connection.in.erase(0, connection.answeredIn);
+			connection.answeredIn = 0;
+			if (!connection.closed && !connection.out.empty()) {
+				transmit(connection);
+			}
+		}
+		std::erase_if(connections, [](const Connection& connection) {
+			if (connection.closed) {
+				closeNative(native(connection.socket));
+			}
+			return connection.closed;
+		});
+		readLog();
+	}
+}
+
+void ScoreServer::acceptClients() {
+	while (true) {
+		NativeSocket socket = ::accept(native(listener), nullptr, nullptr);
+		if (socket == INVALID_NATIVE) {
+			return;
+		}
+		if (!setNonBlocking(socket)) {
+			closeNative(socket);
+			continue;
+		}
+		connections.push_back({ static_cast<std::intptr_t>(socket) });
+		accepted++;
+	}
+}
+
+void ScoreServer::receive(Connection& connection) {
+	char buffer[16 * 1024];
+	while (true) {
+		const auto count = ::recv(native(connection.socket), buffer, static_cast<int>(sizeof(buffer)), 0);
+		if (count > 0) {
+			connection.in.append(buffer, static_cast<std::size_t>(count));
+			// Klient, który przysyła szybciej, niż odpowiadamy (albo nie kończy ramek), zająłby pamięć demona
+			// bez ograniczeń - rozłączamy go bez odpowiedzi na resztę danych.
+			if (connection.in.size() > static_cast<std::size_t>(Config::SCORE_CLIENT_BUFFER)) {
+				connection.in.clear();
+				connection.closed = true;
+				dropped++;
+				break;
+			}
+			continue;
+		}
+		if (count < 0 && interrupted()) {
+			continue;
+		}
+		if (count == 0 || !wouldBlock()) {
+			connection.closed = true;
+		}
+		break;
+	}
+}
+
+void ScoreServer::answer(Connection& connection, bool stored) {
+	// Odpowiadamy na wszystkie pełne ramki; niepełna czeka na resztę danych.
+	connection.answeredOut = connection.out.size();
+	std::string_view data(connection.in);
+	std::size_t position = 0;
+	std::uint64_t answered = 0;
+	while (data.size() - position >= FRAME_HEADER) {
+		const std::size_t length = peekU16(data, position);
+		if (data.size() - position - FRAME_HEADER < length) {
+			break;
+		}
+		respond(data.substr(position + FRAME_HEADER, length), connection.out, stored);
+		position += FRAME_HEADER + length;
+		answered++;
+	}
+	connection.answeredIn = position;
+	// Powtórne odpowiedzi po nieudanym zapisie dotyczą tych samych żądań.
+	if (stored) {
+		requests += answered;
+		batches += answered > 0 ? 1 : 0;
+	}
+}
+
+void ScoreServer::rollback() {
+	for (auto it = pendingUndo.rbegin(); it != pendingUndo.rend(); ++it) {
+		index.erase(it->username);
+		if (it->known) {
+			index.submit(it->username, it->score);
+		}
+	}
+}
+
+void ScoreServer::transmit(Connection& connection) {
+	std::size_t sent = 0;
+	while (sent < connection.out.size()) {
+		const auto count = ::send(native(connection.socket), connection.out.data() + sent,
+			static_cast<int>(connection.out.size() - sent), SEND_FLAGS);
+		if (count > 0) {
+			sent += static_cast<std::size_t>(count);
+			continue;
+		}
+		if (count < 0 && interrupted()) {
+			continue;
+		}
+		if (count == 0 || !wouldBlock()) {
+			connection.closed = true;
+		}
+		break;
+	}
+	connection.out.erase(0, sent);
+	// To samo dotyczy klienta, który wysyła żądania, ale nie odbiera odpowiedzi.
+	if (!connection.closed && connection.out.size() > static_cast<std::size_t>(Config::SCORE_CLIENT_BUFFER)) {
+		connection.closed = true;
+		dropped++;
+	}
+}
+
+void ScoreServer::respond(std::string_view frame, std::string& out, bool stored) {
+	FrameReader reader{ frame };
+	const ScoreOp op = static_cast<ScoreOp>(reader.u8());
+	const std::size_t start = out.size();
+	putU16(out, 0);
+	putU8(out, static_cast<std::uint8_t>(op));
+	putU8(out, STATUS_OK);
+	const std::size_t payload = out.size();
+
+	bool valid = false;
+	std::uint8_t failure = STATUS_BAD_REQUEST;
+	switch (op) {
+	case ScoreOp::SUBMIT: {
+		const std::string_view name = reader.name();
+		const int score = static_cast<int>(reader.u32());
+		if (reader.finished() && !name.empty() && name.find_first_of(":\r\n") == std::string_view::npos) {
+			const std::string username(name);
+			if (!stored) {
+				failure = STATUS_NOT_STORED;
+				break;
+			}
+			// Do pliku trafia każda gra, jak przy zapisie bez demona; indeks trzyma tylko najlepszy wynik gracza.
+			pendingRecords.push_back(username + ":" + std::to_string(score));
+			IndexUndo undo{ username };
+			undo.known = index.rank(username, &undo.score) != 0;
+			if (index.submit(username, score)) {
+				pendingUndo.push_back(std::move(undo));
+			}
+			putU32(out, index.rank(username));
+			valid = true;
+		}
+		break;
+	}
+	case ScoreOp::TOP: {
+		const std::size_t k = std::min<std::size_t>(reader.u16(), Config::SCORE_TOP_MAX);
+		if (reader.finished()) {
+			const std::vector<RankedScore> entries = index.top(k);
+			putU16(out, static_cast<std::uint16_t>(entries.size()));
+			for (const RankedScore& entry : entries) {
+				putName(out, std::string_view(entry.username).substr(0, 255));
+				putU32(out, static_cast<std::uint32_t>(entry.score));
+			}
+			valid = true;
+		}
+		break;
+	}
+	case ScoreOp::RANK: {
+		const std::string_view name = reader.name();
+		if (reader.finished()) {
+			int score = 0;
+			const std::uint32_t rank = index.rank(std::string(name), &score);
+			putU32(out, rank);
+			putU32(out, static_cast<std::uint32_t>(score));
+			valid = true;
+		}
+		break;
+	}
+	}
+	if (!valid) {
+		out.resize(payload);
+		out[payload - 1] = static_cast<char>(failure);
+	}
+	closeFrame(out, start);
+}
+
+ScoreClient::ScoreClient(std::string path) : socketPath(std::move(path)) {}
+
+ScoreClient::~ScoreClient() {
+	close();
+}
+
+bool ScoreClient::connect() {
+	if (socket != -1) {
+		return true;
+	}
+	sockaddr_un address;
+	if (!socketsReady() || !makeAddress(socketPath, address)) {
+		return false;
+	}
+	NativeSocket handle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (handle == INVALID_NATIVE) {
+		return false;
+	}
+	if (::connect(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+		|| !setReceiveTimeout(handle, Config::SCORE_CLIENT_TIMEOUT_MS)) {
+		closeNative(handle);
+		return false;
+	}
+	socket = static_cast<std::intptr_t>(handle);
+	return true;
+}
+
+void ScoreClient::close() {
+	if (socket != -1) {
+		closeNative(native(socket));
+		socket = -1;
+	}
+	out.clear();
+	pending.clear();
+}
+
+bool ScoreClient::queueSubmit(std::string_view username, int score) {
+	if (username.size() > 255) {
+		return false;
+	}
+	const std::size_t start = out.size();
+	putU16(out, 0);
+	putU8(out, static_cast<std::uint8_t>(ScoreOp::SUBMIT));
+	putName(out, username);
+	putU32(out, static_cast<std::uint32_t>(score));
+	closeFrame(out, start);
+	pending.push_back(ScoreOp::SUBMIT);
+	return true;
+}
+
+void ScoreClient::queueTop(std::uint16_t k) {
+	const std::size_t start = out.size();
+	putU16(out, 0);
+	putU8(out, static_cast<std::uint8_t>(ScoreOp::TOP));
+	putU16(out, k);
+	closeFrame(out, start);
+	pending.push_back(ScoreOp::TOP);
+}
+
+bool ScoreClient::queueRank(std::string_view username) {
+	if (username.size() > 255) {
+		return false;
+	}
+	const std::size_t start = out.size();
+	putU16(out, 0);
+	putU8(out, static_cast<std::uint8_t>(ScoreOp::RANK));
+	putName(out, username);
+	closeFrame(out, start);
+	pending.push_back(ScoreOp::RANK);
+	return true;
+}
+
+bool ScoreClient::flush(std::vector<ScoreResponse>& responses) {
+	responses.clear();
+	sent = false;
+	if (pending.empty()) {
+		return true;
+	}
+	if (!connect()) {
+		close();
+		return false;
+	}
+
+	// Cała porcja idzie jednym ciągiem; demon odpowiada na nią, zanim klient przeczyta pierwszą odpowiedź.
+	std::size_t written = 0;
+	while (written < out.size()) {
+		const auto count = ::send(native(socket), out.data() + written, static_cast<int>(out.size() - written), SEND_FLAGS);
+		if (count < 0 && interrupted()) {
+			continue;
+		}
+		if (count <= 0) {
+			close();
+			return false;
+		}
+		written += static_cast<std::size_t>(count);
+	}
+	sent = true;
+
+	std::string in;
+	std::size_t position = 0;
+	char buffer[16 * 1024];
+	while (responses.size() < pending.size()) {
+		if (in.size() - position >= FRAME_HEADER && in.size() - position - FRAME_HEADER >= peekU16(in, position)) {
+			const std::size_t length = peekU16(in, position);
+			FrameReader reader{ std::string_view(in).substr(position + FRAME_HEADER, length) };
+			position += FRAME_HEADER + length;
+
+			ScoreResponse response;
+			response.op = static_cast<ScoreOp>(reader.u8());
+			response.ok = reader.u8() == STATUS_OK;
+			if (response.op != pending[responses.size()]) {
+				close();
+				return false;
+			}
+			if (response.ok) {
+				switch (response.op) {
+				case ScoreOp::SUBMIT:
+					response.rank = reader.u32();
+					break;
+				case ScoreOp::TOP: {
+					const std::uint16_t count = reader.u16();
+					for (std::uint16_t i = 0; i < count && reader.ok; ++i) {
+						RankedScore entry;
+						entry.username = std::string(reader.name());
+						entry.score = static_cast<int>(reader.u32());
+						response.entries.push_back(std::move(entry));
+					}
+					break;
+				}
+				case ScoreOp::RANK:
+					response.rank = reader.u32();
+					response.score = static_cast<int>(reader.u32());
+					break;
+				}
+				response.ok = reader.finished();
+			}
+			responses.push_back(std::move(response));
+			continue;
+		}
+
+		const auto count = ::recv(native(socket), buffer, static_cast<int>(sizeof(buffer)), 0);
+		if (count < 0 && interrupted()) {
+			continue;
+		}
+		if (count <= 0) {
+			// Koniec połączenia albo upływ limitu czasu - reszta porcji przepada.
+			close();
+			return false;
+		}
+		in.append(buffer, static_cast<std::size_t>(count));
+	}
+	out.clear();
+	pending.clear();
+	return true;
+}
+
+SubmitResult ScoreClient::submit(std::string_view username, int score, std::uint32_t* rank) {
+	std::vector<ScoreResponse> responses;
+	if (!queueSubmit(username, score)) {
+		return SubmitResult::UNSENT;
+	}
+	if (!flush(responses)) {
+		return sent ? SubmitResult::UNKNOWN : SubmitResult::UNSENT;
+	}
+	if (!responses[0].ok) {
+		return SubmitResult::REJECTED;
+	}
+	if (rank != nullptr) {
+		*rank = responses[0].rank;
+	}
+	return SubmitResult::STORED;
+}
+
+bool ScoreClient::top(std::uint16_t k, std::vector<RankedScore>& entries) {
+	std::vector<ScoreResponse> responses;
+	queueTop(k);
+	if (!flush(responses) || !responses[0].ok) {
+		return false;
+	}
+	entries = std::move(responses[0].entries);
+	return true;
+}
+
+namespace {
+	/** @brief Flaga pracy demona, zdejmowana przez Ctrl+C. */
+	std::atomic<bool> daemonRunning{ true };
+
+	void stopDaemon(int) {
+		daemonRunning = false;
+	}
+}
+
+int runScoreDaemon(const std::string& socketPath, const std::string& scoresPath) {
+	ScoreServer server(scoresPath);
+	if (!server.start(socketPath)) {
+		return 1;
+	}
+	std::cout << "Score daemon listening on " << socketPath << " (" << server.getIndex().size()
+		<< " players from " << scoresPath << "), Ctrl+C to stop\n";
+
+	std::signal(SIGINT, stopDaemon);
+	std::signal(SIGTERM, stopDaemon);
+	const auto start = std::chrono::steady_clock::now();
+	server.serve(daemonRunning);
+	server.stop();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Score daemon stopped after " << static_cast<int>(seconds) << " s: " << server.getAccepted()
+		<< " connections (" << server.getDropped() << " dropped for flooding), " << server.getRequests() << " requests in "
+		<< server.getBatches() << " batches, " << server.getIndex().size() << " players\n";
+	return 0;
+}
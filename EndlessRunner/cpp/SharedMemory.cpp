@@ -0,0 +1,170 @@
+/**
+ * @file SharedMemory.cpp
+ * @brief Implementacja klasy SharedMemory.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+module SharedMemoryModule;
+
+SharedMemory::~SharedMemory() {
+	close();
+}
+
+bool SharedMemory::create(const std::string& segmentName, std::size_t bytes) {
+	return map(segmentName, bytes, true);
+}
+
+bool SharedMemory::open(const std::string& segmentName, std::size_t bytes) {
+	return map(segmentName, bytes, false);
+}
+
+#ifdef _WIN32
+
+bool SharedMemory::map(const std::string& segmentName, std::size_t bytes, bool createNew) {
+	close();
+	std::string systemName = "Local\\" + segmentName;
+	HANDLE mapping = createNew
+		? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(static_cast<std::uint64_t>(bytes) >> 32), static_cast<DWORD>(bytes & 0xFFFFFFFFu), systemName.c_str())
+		: OpenFileMappingA(FILE_MAP_READ, FALSE, systemName.c_str());
+	if (mapping == nullptr) {
+		return false;
+	}
+	// Istniejący segment ma już piszącego (inną instancję gry) - drugi zapisujący zepsułby blokadę sekwencyjną.
+	if (createNew && GetLastError() == ERROR_ALREADY_EXISTS) {
+		CloseHandle(mapping);
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, createNew ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		return false;
+	}
+	name = segmentName;
+	data = view;
+	size = bytes;
+	owner = createNew;
+	handle = reinterpret_cast<std::intptr_t>(mapping);
+	return true;
+}
+
+void SharedMemory::close() {
+	if (data) {
+		UnmapViewOfFile(data);
+		data = nullptr;
+	}
+	if (handle != -1) {
+		CloseHandle(reinterpret_cast<HANDLE>(handle));
+		handle = -1;
+	}
+	size = 0;
+	owner = false;
+}
+
+#else
+
+namespace {
+	/**
+	 * @brief Usuwa segment, którego twórca zakończył się bez close() (np. po awarii gry).
+	 *
+	 * Twórca bierze blokadę przed nadaniem segmentowi rozmiaru, więc segment o zerowym rozmiarze jest właśnie
+	 * tworzony, a niezerowy bez blokady - porzucony.
+	 * @param systemName Nazwa segmentu z prefiksem '/'.
+	 * @return True, jeśli segment usunięto (lub zniknął w międzyczasie) i można go utworzyć od nowa.
+	 */
+	bool removeAbandoned(const std::string& systemName) {
+		const int fd = shm_open(systemName.c_str(), O_RDONLY, 0);
+		if (fd < 0) {
+			return errno == ENOENT;
+		}
+		struct stat info {};
+		const bool abandoned = fstat(fd, &info) == 0 && info.st_size > 0 && flock(fd, LOCK_EX | LOCK_NB) == 0;
+		if (abandoned) {
+			shm_unlink(systemName.c_str());
+		}
+		::close(fd);
+		return abandoned;
+	}
+}
+
+bool SharedMemory::map(const std::string& segmentName, std::size_t bytes, bool createNew) {
+	close();
+	std::string systemName = "/" + segmentName;
+	// O_EXCL: istniejący segment ma już piszącego (inną instancję gry) - drugi zapisujący zepsułby
+	// blokadę sekwencyjną, a jego close() usunąłby nazwę spod nóg pierwszego. Wyjątkiem jest segment
+	// porzucony po awarii - bez tego telemetria zostałaby wyłączona do ręcznego usunięcia segmentu.
+	int fd = -1;
+	if (createNew) {
+		fd = shm_open(systemName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (fd < 0 && errno == EEXIST && removeAbandoned(systemName)) {
+			fd = shm_open(systemName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		}
+	}
+	else {
+		fd = shm_open(systemName.c_str(), O_RDONLY, 0);
+	}
+	if (fd < 0) {
+		return false;
+	}
+	auto fail = [&] {
+		if (createNew) {
+			shm_unlink(systemName.c_str());
+		}
+		::close(fd);
+		return false;
+	};
+	// Blokada trwa do zamknięcia deskryptora, także gdy proces zginie - po niej inni poznają żywego twórcę.
+	if (createNew && (flock(fd, LOCK_EX | LOCK_NB) != 0 || ftruncate(fd, static_cast<off_t>(bytes)) != 0)) {
+		return fail();
+	}
+	struct stat info {};
+	if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < bytes) {
+		return fail();
+	}
+	void* view = mmap(nullptr, bytes, createNew ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	if (view == MAP_FAILED) {
+		return fail();
+	}
+	name = segmentName;
+	data = view;
+	size = bytes;
+	owner = createNew;
+	handle = fd;
+	return true;
+}
+
+void SharedMemory::close() {
+	if (data) {
+		munmap(data, size);
+		data = nullptr;
+	}
+	// Nazwę usuwamy, dopóki trzymamy blokadę - inaczej nowa instancja mogłaby uznać segment za porzucony,
+	// utworzyć własny, a ten shm_unlink usunąłby jej nazwę.
+	if (owner) {
+		shm_unlink(("/" + name).c_str());
+	}
+	if (handle != -1) {
+		::close(static_cast<int>(handle));
+		handle = -1;
+	}
+	size = 0;
+	owner = false;
+}
+
+#endif
@@ -5,15 +5,19 @@
 
 module;
 #include "raylib.h"
+#include <cstdint>
 
 module ShopModule;
 
+import AnimationSystemModule;
+import AudioModule;
+
 void Shop::init(Resources& res, int screenWidth, int screenHeight) {
-	resources = res;
-	dinos[0] = resources.getGreenIdle();
-	dinos[1] = resources.getBlueIdle();
-	dinos[2] = resources.getYellowIdle();
-	dinos[3] = resources.getRedIdle();
+	resources = &res;
+	dinos[0] = resources->getGreenIdle();
+	dinos[1] = resources->getBlueIdle();
+	dinos[2] = resources->getYellowIdle();
+	dinos[3] = resources->getRedIdle();
 
 	initialScreenWidth = screenWidth;
 	initialScreenHeight = screenHeight;
@@ -22,84 +26,88 @@ void Shop::init(Resources& res, int screenWidth, int screenHeight) {
 		frameWidths[i] = static_cast<float>(dinos[i].width / 4);
 		frameHeights[i] = static_cast<float>(dinos[i].height);
 	}
-}
-
-void Shop::show(int screenWidth, int screenHeight) {
-	runningTime = 0;
-	frame = 0;
-
-	while (!WindowShouldClose()) {
-		float deltaTime = GetFrameTime();
-		runningTime += deltaTime;
-		if (runningTime >= updateTime) {
-			runningTime = 0;
-			frame++;
-			if (frame > 3) frame = 0;
-		}
-
-		if (IsKeyPressed(KEY_ESCAPE)) return;
 
-		screenWidth = GetScreenWidth();
-		screenHeight = GetScreenHeight();
+	clip = animations().create(4, Config::SHOP_ANIMATION_UPDATE_TIME);
 
-		float widthScale = static_cast<float>(screenWidth) / initialScreenWidth;
-		float heightScale = static_cast<float>(screenHeight) / initialScreenHeight;
+	// Każdy dinozaur ma kolumnę o szerokości 1/DinoCount okna, wyśrodkowaną na 65% wysokości.
+	// Wysokość 220 pikseli odnosi się do początkowego rozmiaru okna i skaluje razem z nim.
+	for (int i{ 0 }; i < DinoCount && layout.getNodeCount() < DinoCount; i++) {
+		dinoNodes[i] = layout.add(LayoutSpec{
+			.anchor = { static_cast<float>(i) / DinoCount, 0.65f }, .pivot = { 0.f, 0.5f },
+			.relativeSize = { 1.f / DinoCount, 220.f / initialScreenHeight }, .interactive = true });
+	}
+}
 
+void Shop::enter(SceneManager& scenes) {
+	clip.restart();
+}
 
-		for (int i{ 0 }; i < DinoCount; i++) {
-			dinoRecs[i] = Rectangle{
-				static_cast<float>(i * screenWidth / DinoCount),
-				static_cast<float>(screenHeight * 0.65f - 110.f * heightScale),
-				static_cast<float>(screenWidth / DinoCount),
-				220.f * heightScale
-			};
-		}
+void Shop::update(SceneManager& scenes, float deltaTime) {
+	if (layout.refresh()) {
+		applyLayout();
+	}
 
-		Vector2 mouse = GetMousePosition();
+	const int hovered = layout.hover(GetMousePosition());
+	if (hovered >= 0 && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
 		for (int i{ 0 }; i < DinoCount; i++) {
-			if (CheckCollisionPointRec(mouse, dinoRecs[i])) {
-				if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-					selectedDinoIndex = i;
-				}
+			if (dinoNodes[i] == hovered) {
+				selectedDinoIndex = i;
+				audio().play(Sfx::CLICK);
 			}
 		}
+	}
+}
 
-		BeginDrawing();
-		ClearBackground(RAYWHITE);
+void Shop::applyLayout() {
+	currentScreenWidth = GetScreenWidth();
+	currentScreenHeight = GetScreenHeight();
 
-		DrawTexturePro(
-			resources.getShopBackground(),
-			Rectangle{ 0, 0, static_cast<float>(resources.getShopBackground().width), static_cast<float>(resources.getShopBackground().height) },
-			Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-			Vector2{ 0, 0 },
-			0.0f,
-			WHITE
-		);
+	widthScale = static_cast<float>(currentScreenWidth) / initialScreenWidth;
+	heightScale = static_cast<float>(currentScreenHeight) / initialScreenHeight;
 
-		for (int i = 0; i < DinoCount; i++) {
-			float currentScale = baseScales[i] * (widthScale + heightScale) / 2.0f;
+	for (int i{ 0 }; i < DinoCount; i++) {
+		dinoRecs[i] = layout.rect(dinoNodes[i]);
+
+		float currentScale = baseScales[i] * (widthScale + heightScale) / 2.0f;
+		dinoDests[i] = Rectangle{
+			dinoRecs[i].x + (dinoRecs[i].width - frameWidths[i] * currentScale) / 2,
+			currentScreenHeight * 0.85f - frameHeights[i] * currentScale,
+			frameWidths[i] * currentScale,
+			frameHeights[i] * currentScale
+		};
+	}
+}
 
-			Rectangle dest = {
-				dinoRecs[i].x + (dinoRecs[i].width - frameWidths[i] * currentScale) / 2,
-				screenHeight * 0.85f - frameHeights[i] * currentScale,
-				frameWidths[i] * currentScale,
-				frameHeights[i] * currentScale
-			};
+void Shop::render() {
+	// Tło i ramka wyboru zmieniają się tylko po zmianie rozmiaru okna lub wybranego dinozaura.
+	ClearBackground(RAYWHITE);
+	layer.render(currentScreenWidth, currentScreenHeight, static_cast<std::uint64_t>(selectedDinoIndex),
+		[this] { return drawStatic(); });
 
-			Rectangle source = { frame * frameWidths[i], 0.0f, frameWidths[i], frameHeights[i] };
+	for (int i = 0; i < DinoCount; i++) {
+		Rectangle source = { clip.getFrame() * frameWidths[i], 0.0f, frameWidths[i], frameHeights[i] };
+		DrawTexturePro(dinos[i], source, dinoDests[i], Vector2{ 0, 0 }, 0.0f, WHITE);
+	}
+}
 
-			DrawTexturePro(dinos[i], source, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
+int Shop::drawStatic() const {
+	ClearBackground(RAYWHITE);
 
-			if (i == selectedDinoIndex) {
-				Rectangle selectionFrame = dinoRecs[i];
-				selectionFrame.y += 50.f * heightScale;
-				DrawRectangleLinesEx(selectionFrame, 4.f * widthScale, GREEN);
-			}
-		}
+	DrawTexturePro(
+		resources->getShopBackground(),
+		Rectangle{ 0, 0, static_cast<float>(resources->getShopBackground().width), static_cast<float>(resources->getShopBackground().height) },
+		Rectangle{ 0, 0, static_cast<float>(currentScreenWidth), static_cast<float>(currentScreenHeight) },
+		Vector2{ 0, 0 },
+		0.0f,
+		WHITE
+	);
 
-		DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-		EndDrawing();
-	}
+	Rectangle selectionFrame = dinoRecs[selectedDinoIndex];
+	selectionFrame.y += 50.f * heightScale;
+	DrawRectangleLinesEx(selectionFrame, 4.f * widthScale, GREEN);
+
+	DrawText("Press ESC to return", currentScreenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, currentScreenHeight - 30, 20, BLACK);
+	return 3;
 }
 
 int Shop::getSelectedDino() const {
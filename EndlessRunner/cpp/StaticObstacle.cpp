@@ -8,6 +8,8 @@ module;
 
 module StaticObstacleModule;
 
+import DrawListModule;
+
 void StaticObstacle::init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime) {
 	Obstacle::init(tex, startX, startY - tex.height * scaleFactor, scaleFactor, 1, animUpdateTime);
 }
@@ -16,10 +18,10 @@ void StaticObstacle::update(float deltaTime) {
 	screenPos.x += velocity * deltaTime;
 }
 
-void StaticObstacle::draw() const {
+void StaticObstacle::draw(DrawList& list) const {
 	Rectangle soucre{ 0.f, 0.f, width, height };
 	Rectangle dest{ screenPos.x, screenPos.y, width * scale, height * scale };
-	DrawTexturePro(texture, soucre, dest, { 0.f,0.f }, 0.f, WHITE);
+	list.sprite(texture, soucre, dest);
 }
 
 Rectangle StaticObstacle::getCollisionRec() const
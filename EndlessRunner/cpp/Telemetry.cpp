@@ -0,0 +1,169 @@
+﻿/**
+ * @file Telemetry.cpp
+ * @brief Implementacja publikacji i odczytu telemetrii.
+ */
+
+module;
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+module TelemetryModule;
+
+bool TelemetryPublisher::open() {
+	if (!memory.create(TelemetryConfig::SEGMENT_NAME, sizeof(TelemetryLayout))) {
+		// Segment istnieje, gdy publikuje już inna instancja gry (segment po jej awarii create() zastępuje).
+		std::cout << "Telemetry disabled: cannot create shared memory segment " << TelemetryConfig::SEGMENT_NAME
+			<< " (another game instance may be publishing)\n";
+		return false;
+	}
+	layout = new (memory.get()) TelemetryLayout{};
+	layout->header.magic = TelemetryConfig::MAGIC;
+	layout->header.version = TelemetryConfig::VERSION;
+	layout->header.slotCount = TelemetryConfig::SLOT_COUNT;
+	layout->header.slotSize = sizeof(TelemetrySlot);
+	return true;
+}
+
+void TelemetryPublisher::publish(const TelemetryFrame& frame) {
+	if (!layout) return;
+	auto start = std::chrono::steady_clock::now();
+
+	TelemetryHeader& header = layout->header;
+	std::uint64_t index = header.writeIndex.load(std::memory_order_relaxed);
+	TelemetrySlot& slot = layout->slots[index & (TelemetryConfig::SLOT_COUNT - 1)];
+
+	std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.index = index;
+	std::memcpy(&slot.frame, &frame, sizeof(TelemetryFrame));
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+	header.writeIndex.store(index + 1, std::memory_order_release);
+
+	auto nanos = static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	header.publishNanos.fetch_add(nanos, std::memory_order_relaxed);
+	if (nanos > header.publishNanosMax.load(std::memory_order_relaxed)) {
+		header.publishNanosMax.store(nanos, std::memory_order_relaxed);
+	}
+}
+
+bool TelemetryReader::open() {
+	layout = nullptr;
+	if (!memory.open(TelemetryConfig::SEGMENT_NAME, sizeof(TelemetryLayout))) {
+		return false;
+	}
+	const auto* mapped = static_cast<const TelemetryLayout*>(memory.get());
+	if (mapped->header.magic != TelemetryConfig::MAGIC || mapped->header.version != TelemetryConfig::VERSION) {
+		memory.close();
+		return false;
+	}
+	layout = mapped;
+	cursor = layout->header.writeIndex.load(std::memory_order_acquire);
+	return true;
+}
+
+bool TelemetryReader::poll(TelemetryFrame& out) {
+	if (!layout) return false;
+
+	std::uint64_t written = layout->header.writeIndex.load(std::memory_order_acquire);
+	if (written < cursor) {
+		cursor = written; // gra rozpoczęła nową sesję w tym samym segmencie
+	}
+	if (cursor == written) return false;
+	if (written - cursor > TelemetryConfig::SLOT_COUNT) {
+		dropped += written - cursor - TelemetryConfig::SLOT_COUNT;
+		cursor = written - TelemetryConfig::SLOT_COUNT;
+	}
+
+	const TelemetrySlot& slot = layout->slots[cursor & (TelemetryConfig::SLOT_COUNT - 1)];
+	for (int attempt = 0; attempt < 4; ++attempt) {
+		std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before & 1u) continue;
+		std::uint64_t index = slot.index;
+		std::memcpy(&out, &slot.frame, sizeof(TelemetryFrame));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		std::uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+		if (before != after) continue;
+		if (index != cursor) {
+			// Spójna, ale nowsza klatka: piszący okrążył czytnik między odczytem writeIndex a slotu.
+			// Liczby sekwencji tego nie wykażą (zapis się zakończył), więc wracamy na najstarszą zachowaną klatkę.
+			written = layout->header.writeIndex.load(std::memory_order_acquire);
+			std::uint64_t oldest = written - TelemetryConfig::SLOT_COUNT;
+			dropped += oldest - cursor;
+			cursor = oldest;
+			return false;
+		}
+		++cursor;
+		return true;
+	}
+	// Slot jest nadpisywany szybciej, niż go czytamy - pomijamy go zamiast czekać.
+	++dropped;
+	++cursor;
+	return false;
+}
+
+double TelemetryReader::getAveragePublishNanos() const {
+	if (!layout) return 0.0;
+	std::uint64_t count = layout->header.writeIndex.load(std::memory_order_relaxed);
+	if (count == 0) return 0.0;
+	return static_cast<double>(layout->header.publishNanos.load(std::memory_order_relaxed)) / static_cast<double>(count);
+}
+
+std::uint64_t TelemetryReader::getMaxPublishNanos() const {
+	if (!layout) return 0;
+	return layout->header.publishNanosMax.load(std::memory_order_relaxed);
+}
+
+int runTelemetryReader() {
+	TelemetryReader reader;
+	TelemetryFrame frame{};
+	auto lastFrameAt = std::chrono::steady_clock::now();
+	auto lastReportAt = lastFrameAt;
+
+	std::cout << "Waiting for game telemetry...\n";
+	while (true) {
+		auto now = std::chrono::steady_clock::now();
+		if (!reader.isOpen() || now - lastFrameAt > std::chrono::seconds(2)) {
+			if (reader.open()) {
+				lastFrameAt = now;
+			}
+			else {
+				std::this_thread::sleep_for(std::chrono::milliseconds(250));
+				continue;
+			}
+		}
+
+		bool received = false;
+		while (reader.poll(frame)) {
+			received = true;
+			std::cout << "tick " << frame.tick
+				<< " t=" << frame.time
+				<< " score=" << static_cast<int>(frame.score)
+				<< " lives=" << frame.lives
+				<< (frame.gameOver ? " GAME OVER" : "")
+				<< " player=(" << frame.playerX << ", " << frame.playerY << ")"
+				<< " obstacles=" << frame.obstacleCount
+				<< " frame=" << frame.frameTime * 1000.f << "ms"
+				<< " update=" << frame.updateTime * 1000.f << "ms"
+				<< " draw=" << frame.drawTime * 1000.f << "ms\n";
+		}
+		if (received) {
+			lastFrameAt = now;
+		}
+
+		if (now - lastReportAt > std::chrono::seconds(1)) {
+			lastReportAt = now;
+			std::cout << "-- publish overhead: avg " << reader.getAveragePublishNanos()
+				<< " ns, max " << reader.getMaxPublishNanos()
+				<< " ns, dropped frames: " << reader.getDropped() << "\n";
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+}
@@ -0,0 +1,230 @@
+﻿/**
+ * @file TextureCache.cpp
+ * @brief Implementacja klas TextureHandle i TextureCache.
+ */
+
+module;
+#include "raylib.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+module TextureCacheModule;
+
+namespace {
+	/** @brief Ścieżka tekstury zastępczej. */
+	const std::string FALLBACK_PATH = "textures/missing_texture.png";
+
+	/**
+	 * @brief Sprowadza ścieżkę do jednej postaci, aby "textures/./a.png" i "textures\\a.png" trafiały do tego samego wpisu.
+	 * @param path Ścieżka pliku.
+	 * @return Znormalizowana ścieżka.
+	 */
+	std::string normalizePath(const std::string& path) {
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+}
+
+TextureHandle::TextureHandle(TextureEntry* textureEntry) : entry(textureEntry) {
+	if (entry != nullptr) {
+		entry->refs++;
+	}
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other) : TextureHandle(other.entry) {}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : entry(other.entry) {
+	other.entry = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(const TextureHandle& other) {
+	if (entry != other.entry) {
+		TextureHandle copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept {
+	if (this != &other) {
+		reset();
+		entry = other.entry;
+		other.entry = nullptr;
+	}
+	return *this;
+}
+
+TextureHandle::~TextureHandle() {
+	reset();
+}
+
+const Texture2D& TextureHandle::get() const {
+	static const Texture2D empty{};
+	return entry != nullptr ? entry->texture : empty;
+}
+
+const Image& TextureHandle::getImage() const {
+	static const Image empty{};
+	return entry != nullptr ? entry->image : empty;
+}
+
+void TextureHandle::reset() {
+	if (entry != nullptr) {
+		textureCache().release(entry);
+		entry = nullptr;
+	}
+}
+
+TextureHandle TextureCache::acquire(const std::string& path) {
+	const std::string key = normalizePath(path);
+	auto it = entries.find(key);
+	if (it != entries.end()) {
+		hits++;
+		return TextureHandle(&it->second);
+	}
+
+	if (!isAvailable(key)) {
+		std::cout << "Texture not found: " << path << ", using missing_texture.png\n";
+		return fallback();
+	}
+	TextureEntry* entry = load(key, false);
+	if (entry == nullptr) {
+		std::cout << "Warning: Texture " << path << " has invalid dimensions, loading fallback!\n";
+		return fallback();
+	}
+	return TextureHandle(entry);
+}
+
+TextureHandle TextureCache::fallback() {
+	auto it = entries.find(FALLBACK_PATH);
+	if (it != entries.end()) {
+		hits++;
+		return TextureHandle(&it->second);
+	}
+
+	TextureEntry* entry = isAvailable(FALLBACK_PATH) ? load(FALLBACK_PATH, true) : nullptr;
+	if (entry == nullptr) {
+		// Bez pliku zastępczego generujemy szachownicę, żeby brakujące tekstury nadal były widoczne.
+		std::cout << "Error: Fallback missing_texture.png failed!\n";
+		Image checked = GenImageChecked(64, 64, 8, 8, MAGENTA, BLACK);
+		entry = &entries[FALLBACK_PATH];
+		if (headless) {
+			entry->image = checked;
+			entry->texture = Texture2D{ ++headlessIds, checked.width, checked.height, 1, checked.format };
+		}
+		else {
+			entry->texture = LoadTextureFromImage(checked);
+			UnloadImage(checked);
+		}
+		entry->path = FALLBACK_PATH;
+		entry->fallback = true;
+		entry->bytes = static_cast<std::size_t>(GetPixelDataSize(entry->texture.width, entry->texture.height, entry->texture.format));
+		gpuBytes += entry->bytes;
+	}
+	return TextureHandle(entry);
+}
+
+bool TextureCache::mountPack(const std::string& path) {
+	if (pack.isOpen()) {
+		return true;
+	}
+	if (!std::filesystem::exists(path)) {
+		return false;
+	}
+	if (!pack.open(path, checkPackSources)) {
+		std::cout << "Asset pack " << path << " ignored, loading loose textures\n";
+		return false;
+	}
+	std::cout << "Mounted asset pack " << path << " with " << pack.getEntryCount() << " textures\n";
+	return true;
+}
+
+bool TextureCache::isAvailable(const std::string& key) const {
+	// Tekstura z archiwum nie wymaga sprawdzania systemu plików.
+	return (pack.isOpen() && pack.find(key) != nullptr) || std::filesystem::exists(key);
+}
+
+TextureEntry* TextureCache::load(const std::string& key, bool isFallback) {
+	const PackEntry* packed = pack.isOpen() ? pack.find(key) : nullptr;
+	const auto start = std::chrono::steady_clock::now();
+	Texture2D texture{};
+	Image image{};
+	if (headless) {
+		// Bez kontekstu OpenGL tekstura jest tylko opisem obrazu, który zostaje w RAM.
+		image = packed ? ImageCopy(pack.view(*packed)) : LoadImage(key.c_str());
+		if (image.data != nullptr) {
+			texture = Texture2D{ ++headlessIds, image.width, image.height, 1, image.format };
+		}
+	}
+	else {
+		texture = packed ? pack.loadTexture(*packed) : LoadTexture(key.c_str());
+	}
+	loadSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	misses++;
+
+	if (texture.id == 0 || texture.width == 0 || texture.height == 0) {
+		if (image.data != nullptr) {
+			UnloadImage(image);
+		}
+		else if (texture.id != 0) {
+			UnloadTexture(texture);
+		}
+		return nullptr;
+	}
+	if (packed) {
+		packLoads++;
+	}
+	else {
+		std::cout << "Loaded texture: " << key
+			<< ", ID: " << texture.id
+			<< ", Width: " << texture.width
+			<< ", Height: " << texture.height << "\n";
+	}
+
+	TextureEntry& entry = entries[key];
+	entry.path = key;
+	entry.texture = texture;
+	entry.image = image;
+	entry.fallback = isFallback;
+	entry.bytes = static_cast<std::size_t>(GetPixelDataSize(texture.width, texture.height, texture.format));
+	gpuBytes += entry.bytes;
+	return &entry;
+}
+
+void TextureCache::release(TextureEntry* entry) {
+	if (entry == nullptr || entry->refs == 0 || --entry->refs > 0) {
+		return;
+	}
+	// Po zamknięciu okna kontekst OpenGL już nie istnieje - sterownik zwolnił tekstury razem z nim.
+	if (entry->image.data != nullptr) {
+		UnloadImage(entry->image);
+	}
+	else if (IsWindowReady()) {
+		UnloadTexture(entry->texture);
+	}
+	gpuBytes -= entry->bytes;
+	// Klucz mieszka w usuwanym węźle - usuwamy po iteratorze, a nie po referencji do własnego klucza.
+	entries.erase(entries.find(entry->path));
+}
+
+void TextureCache::printReport() const {
+	const std::uint64_t requests = hits + misses;
+	std::cout << "Texture cache: " << entries.size() << " resident, "
+		<< std::fixed << std::setprecision(2) << static_cast<double>(gpuBytes) / (1024.0 * 1024.0) << " MiB on GPU, "
+		<< hits << " hits / " << misses << " loads, " << packLoads << " from pack";
+	if (requests > 0) {
+		std::cout << " (" << static_cast<double>(hits) * 100.0 / static_cast<double>(requests) << "% hit rate)";
+	}
+	std::cout << ", " << loadSeconds * 1000.0 << " ms loading\n";
+	std::cout.unsetf(std::ios::fixed);
+}
+
+TextureCache& textureCache() {
+	static TextureCache cache;
+	return cache;
+}
@@ -0,0 +1,304 @@
+﻿/**
+ * @file Analytics.ixx
+ * @brief Moduł dziennika zdarzeń rozgrywki (pojawienia przeszkód, skoki, zderzenia, skoki czasu klatki) i jego analizy.
+ *
+ * Każde zdarzenie ma stały rozmiar i trafia do osobnych kolumn w pamięci (czas, wartość, rodzaj zdarzenia,
+ * rodzaj przeszkody, gracz, tło). Pełny blok kolumn jest zamieniany z drugim kompletem kolumn, a scena dopisuje
+ * go do pliku jednym zapisem pod blokadą poza krokiem symulacji, więc zapis zdarzenia w trakcie gry to kilka
+ * przypisań, a plik może rosnąć równocześnie z kilku instancji gry.
+ * Narzędzie --analytics-report mapuje plik do pamięci i liczy statystyki pętlami po kolumnach bajtów,
+ * które kompilator wektoryzuje.
+ */
+
+module;
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+export module AnalyticsModule;
+
+import ConfigModule;
+import ObstacleFactoryModule;
+import RecordLogModule;
+
+
+/** @brief Wersja formatu bloku dziennika. */
+export inline constexpr std::uint32_t ANALYTICS_VERSION = 1;
+
+/** @brief Wartość kolumny rodzaju przeszkody lub gracza, gdy zdarzenie ich nie dotyczy. */
+export inline constexpr std::uint8_t ANALYTICS_NONE = 0xFF;
+
+/** @brief Liczba rodzajów przeszkód w statystykach. */
+export inline constexpr std::size_t ANALYTICS_KINDS = static_cast<std::size_t>(ObstacleKind::STATIC) + 1;
+
+/** @brief Liczba teł w statystykach. */
+export inline constexpr std::size_t ANALYTICS_BIOMES = static_cast<std::size_t>(BackgroundType::FOREST_NIGHT) + 1;
+
+/**
+ * @enum AnalyticsEvent
+ * @brief Rodzaj zdarzenia w dzienniku.
+ */
+export enum class AnalyticsEvent : std::uint8_t {
+    RUN_START,   /**< Początek rozgrywki (wartość: liczba graczy z klawiatury). */
+    SPAWN,       /**< Pojawienie się przeszkody (rodzaj przeszkody; wartość: prędkość świata). */
+    JUMP,        /**< Skok gracza z klawiatury (gracz; wartość: chwila skoku wewnątrz kroku w sekundach). */
+    DEATH,       /**< Zderzenie gracza z przeszkodą (rodzaj przeszkody i gracz; wartość: prędkość świata). */
+    FRAME_SPIKE, /**< Klatka dłuższa niż Config::ANALYTICS_SPIKE_MS (wartość: czas klatki w milisekundach). */
+    RUN_END      /**< Koniec rozgrywki (wartość: wynik). */
+};
+
+/**
+ * @struct AnalyticsBlockHeader
+ * @brief Nagłówek bloku; za nim leżą kolumny: float czas[count], float wartość[count], a potem po count bajtów
+ * rodzaju zdarzenia, rodzaju przeszkody, gracza i tła. Rozmiar bloku jest wielokrotnością 4, więc kolumny
+ * float w zmapowanym pliku są wyrównane.
+ */
+export struct AnalyticsBlockHeader {
+    char magic[4];           /**< Sygnatura "DRAB". */
+    std::uint32_t version;   /**< Wersja formatu (ANALYTICS_VERSION). */
+    std::uint32_t count;     /**< Liczba zdarzeń w bloku. */
+    std::uint32_t reserved;  /**< Zarezerwowane (0). */
+};
+
+/** @brief Rozmiar jednego zdarzenia we wszystkich kolumnach (w bajtach). */
+export inline constexpr std::size_t ANALYTICS_RECORD_BYTES = 2 * sizeof(float) + 4 * sizeof(std::uint8_t);
+
+/**
+ * @struct AnalyticsStats
+ * @brief Statystyki zapisu dziennika.
+ */
+export struct AnalyticsStats {
+    std::uint64_t events{ 0 };     /**< Liczba zapisanych zdarzeń. */
+    std::uint64_t blocks{ 0 };     /**< Liczba dopisanych bloków. */
+    std::uint64_t bytes{ 0 };      /**< Liczba dopisanych bajtów. */
+    std::uint64_t failed{ 0 };     /**< Liczba bloków, których nie udało się zapisać. */
+    double flushMs{ 0.0 };         /**< Łączny czas dopisywania bloków (ms). */
+};
+
+/**
+ * @struct AnalyticsColumns
+ * @brief Kolumny jednego bloku zdarzeń.
+ */
+struct AnalyticsColumns {
+    /** @brief Kolumna czasu od początku rozgrywki (sekundy). */
+    std::vector<float> times;
+    /** @brief Kolumna wartości (znaczenie zależy od rodzaju zdarzenia). */
+    std::vector<float> values;
+    /** @brief Kolumna rodzaju zdarzenia. */
+    std::vector<std::uint8_t> types;
+    /** @brief Kolumna rodzaju przeszkody. */
+    std::vector<std::uint8_t> kinds;
+    /** @brief Kolumna gracza. */
+    std::vector<std::uint8_t> players;
+    /** @brief Kolumna tła. */
+    std::vector<std::uint8_t> biomes;
+
+    /** @brief Zwraca liczbę zdarzeń w kolumnach. @return Liczba zdarzeń. */
+    std::size_t size() const { return times.size(); }
+
+    /** @brief Rezerwuje pamięć wszystkich kolumn. @param capacity Liczba zdarzeń. */
+    void reserve(std::size_t capacity);
+
+    /** @brief Usuwa zdarzenia, zachowując pamięć kolumn. */
+    void clear();
+};
+
+/**
+ * @class AnalyticsLog
+ * @brief Dziennik zdarzeń rozgrywki buforowany kolumnami.
+ *
+ * Zdarzenia są zapisywane z wątku symulacji (plansza, klatka) i z wątku okna (skoki, początek i koniec gry),
+ * ale nigdy jednocześnie - potok klatki kończy symulację (sync()), zanim scena obsłuży wejście. Pełny blok
+ * i blok zamknięty końcem rozgrywki czekają w drugim komplecie kolumn, a do pliku trafiają dopiero
+ * w flushPending() lub flush(), wywoływanych z wątku okna, gdy symulacja stoi.
+ */
+export class AnalyticsLog {
+private:
+    /** @brief Plik dziennika. */
+    RecordLog file;
+    /** @brief Kolumny, do których trafiają nowe zdarzenia. */
+    AnalyticsColumns columns;
+    /** @brief Kolumny zamkniętego bloku czekającego na zapis (puste - brak bloku). */
+    AnalyticsColumns sealed;
+    /** @brief Bufor składanego bloku (zachowuje pamięć między zapisami). */
+    std::vector<std::uint8_t> staging;
+    /** @brief Czas od początku bieżącej rozgrywki (sekundy). */
+    float runTime{ 0.f };
+    /** @brief Tło bieżącej rozgrywki. */
+    std::uint8_t biome{ 0 };
+    /** @brief Flaga trwającej rozgrywki (zdarzenia poza rozgrywką są pomijane). */
+    bool inRun{ false };
+    /** @brief Flaga zapisu dziennika. */
+    bool enabled{ true };
+    /** @brief Statystyki zapisu. */
+    AnalyticsStats stats;
+
+    /**
+     * @brief Dopisuje zdarzenie do kolumn; pełny blok czeka na zapis w drugim komplecie kolumn.
+     * @param type Rodzaj zdarzenia.
+     * @param kind Rodzaj przeszkody (ANALYTICS_NONE - brak).
+     * @param player Gracz (ANALYTICS_NONE - brak).
+     * @param value Wartość.
+     */
+    void push(AnalyticsEvent type, std::uint8_t kind, std::uint8_t player, float value) {
+        if (!inRun) return;
+        columns.times.push_back(runTime);
+        columns.values.push_back(value);
+        columns.types.push_back(static_cast<std::uint8_t>(type));
+        columns.kinds.push_back(kind);
+        columns.players.push_back(player);
+        columns.biomes.push_back(biome);
+        if (columns.size() == static_cast<std::size_t>(Config::ANALYTICS_BLOCK_EVENTS)) {
+            seal();
+        }
+    }
+
+    /**
+     * @brief Zamyka bieżący blok: zamienia kolumny z kompletem czekającym na zapis (bez kopiowania i alokacji).
+     * Jeśli poprzedni blok wciąż czeka, jest najpierw dopisywany do pliku.
+     */
+    void seal();
+
+    /**
+     * @brief Dopisuje blok do pliku jednym zapisem i czyści jego kolumny.
+     * @param block Kolumny bloku.
+     * @return False, jeśli zapis się nie powiódł (zdarzenia są wtedy porzucane).
+     */
+    bool writeBlock(AnalyticsColumns& block);
+
+public:
+    /**
+     * @brief Tworzy dziennik dla pliku (plik powstaje przy pierwszym zapisie) i rezerwuje pamięć jednego bloku.
+     * @param path Ścieżka pliku.
+     */
+    explicit AnalyticsLog(std::string path);
+
+    /**
+     * @brief Włącza lub wyłącza dziennik (wyłączenie zapisuje zebrane zdarzenia).
+     * @param on Nowy stan.
+     */
+    void setEnabled(bool on);
+
+    /** @brief Sprawdza, czy dziennik jest włączony. @return True domyślnie. */
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Zaczyna rozgrywkę: zeruje zegar i zapisuje zdarzenie RUN_START.
+     * @param background Tło rozgrywki (zapisywane przy każdym zdarzeniu).
+     * @param humanPlayers Liczba graczy z klawiatury.
+     */
+    void beginRun(BackgroundType background, std::size_t humanPlayers);
+
+    /**
+     * @brief Kończy rozgrywkę zdarzeniem RUN_END i zamyka blok (zapis robi flushPending()); bez trwającej
+     * rozgrywki nic nie robi.
+     * @param score Wynik rozgrywki.
+     */
+    void endRun(float score);
+
+    /** @brief Przesuwa zegar rozgrywki. @param deltaTime Długość kroku symulacji (sekundy). */
+    void advance(float deltaTime) { runTime += deltaTime; }
+
+    /** @brief Zapisuje pojawienie się przeszkody. @param kind Rodzaj przeszkody. @param worldSpeed Prędkość świata. */
+    void recordSpawn(ObstacleKind kind, float worldSpeed) { push(AnalyticsEvent::SPAWN, static_cast<std::uint8_t>(kind), ANALYTICS_NONE, worldSpeed); }
+
+    /** @brief Zapisuje skok gracza. @param player Indeks gracza. @param offset Chwila skoku wewnątrz kroku (sekundy). */
+    void recordJump(std::size_t player, float offset) { push(AnalyticsEvent::JUMP, ANALYTICS_NONE, static_cast<std::uint8_t>(player), offset); }
+
+    /**
+     * @brief Zapisuje zderzenie gracza z przeszkodą.
+     * @param player Indeks gracza.
+     * @param kind Rodzaj przeszkody.
+     * @param worldSpeed Prędkość świata.
+     */
+    void recordDeath(std::size_t player, ObstacleKind kind, float worldSpeed) {
+        push(AnalyticsEvent::DEATH, static_cast<std::uint8_t>(kind), static_cast<std::uint8_t>(player), worldSpeed);
+    }
+
+    /**
+     * @brief Zapisuje klatkę, jeśli trwała dłużej niż Config::ANALYTICS_SPIKE_MS.
+     * @param frameSeconds Czas klatki (sekundy).
+     */
+    void recordFrame(float frameSeconds) {
+        if (frameSeconds * 1000.f > Config::ANALYTICS_SPIKE_MS) {
+            push(AnalyticsEvent::FRAME_SPIKE, ANALYTICS_NONE, ANALYTICS_NONE, frameSeconds * 1000.f);
+        }
+    }
+
+    /**
+     * @brief Dopisuje do pliku zamknięty blok, jeśli czeka na zapis. Wywoływana z wątku okna poza krokiem symulacji.
+     * @return False, jeśli zapis się nie powiódł (zdarzenia są wtedy porzucane).
+     */
+    bool flushPending();
+
+    /**
+     * @brief Dopisuje do pliku zamknięty blok i wszystkie zebrane zdarzenia.
+     * @return False, jeśli któryś zapis się nie powiódł (zdarzenia są wtedy porzucane).
+     */
+    bool flush();
+
+    /** @brief Zwraca statystyki zapisu. @return Statystyki. */
+    const AnalyticsStats& getStats() const { return stats; }
+
+    /**
+     * @brief Wypisuje statystyki zapisu na konsolę.
+     */
+    void printReport() const;
+};
+
+/**
+ * @brief Zwraca globalny dziennik gry (plik Config::ANALYTICS_FILE).
+ * @return Referencja do dziennika.
+ */
+export AnalyticsLog& analytics();
+
+/**
+ * @struct AnalyticsSummary
+ * @brief Zbiorcze statystyki dziennika.
+ */
+export struct AnalyticsSummary {
+    /** @brief Liczba przeczytanych bloków. */
+    std::uint64_t blocks{ 0 };
+    /** @brief Liczba przeczytanych zdarzeń. */
+    std::uint64_t events{ 0 };
+    /** @brief True, jeśli plik kończy się niepełnym lub uszkodzonym blokiem (pominiętym). */
+    bool truncated{ false };
+    /** @brief Liczba pojawień przeszkód każdego rodzaju. */
+    std::array<std::uint64_t, ANALYTICS_KINDS> spawnsByKind{};
+    /** @brief Liczba zderzeń z przeszkodami każdego rodzaju. */
+    std::array<std::uint64_t, ANALYTICS_KINDS> deathsByKind{};
+    /** @brief Liczba skończonych rozgrywek w każdym tle. */
+    std::array<std::uint64_t, ANALYTICS_BIOMES> runsByBiome{};
+    /** @brief Łączny czas skończonych rozgrywek w każdym tle (sekundy). */
+    std::array<double, ANALYTICS_BIOMES> runSecondsByBiome{};
+    /** @brief Histogram czasu przeżycia graczy w każdym tle (przedziały Config::ANALYTICS_BUCKET_SECONDS). */
+    std::array<std::array<std::uint64_t, Config::ANALYTICS_BUCKETS>, ANALYTICS_BIOMES> survival{};
+    /** @brief Liczba skoków gracza. */
+    std::uint64_t jumps{ 0 };
+    /** @brief Liczba skoków czasu klatki. */
+    std::uint64_t spikes{ 0 };
+    /** @brief Najdłuższa klatka (ms). */
+    float worstSpikeMs{ 0.f };
+    /** @brief Skoki czasu klatki w każdym tle. */
+    std::array<std::uint64_t, ANALYTICS_BIOMES> spikesByBiome{};
+    /** @brief Histogram chwil skoków czasu klatki od początku rozgrywki. */
+    std::array<std::uint64_t, Config::ANALYTICS_BUCKETS> spikesByTime{};
+};
+
+/**
+ * @brief Liczy statystyki dziennika z danych w pamięci (np. zmapowanego pliku).
+ * @param data Początek danych (wyrównany do 4 bajtów).
+ * @param size Rozmiar danych w bajtach.
+ * @param out Statystyki (dopisywane do istniejących wartości).
+ * @return False, jeśli dane nie zaczynają się poprawnym blokiem.
+ */
+export bool scanAnalytics(const std::uint8_t* data, std::size_t size, AnalyticsSummary& out);
+
+/**
+ * @brief Narzędzie --analytics-report: mapuje dziennik i wypisuje zgony według rodzaju przeszkody,
+ * histogramy przeżycia dla każdego tła i rozkład skoków czasu klatki.
+ * @param path Ścieżka dziennika.
+ * @return Kod wyjścia procesu (0 - sukces).
+ */
+export int runAnalyticsReport(const std::string& path);
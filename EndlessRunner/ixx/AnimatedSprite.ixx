@@ -1,9 +1,9 @@
 /**
  * @file AnimatedSprite.ixx
- * @brief Modu definiujcy klas bazow dla animowanych sprite'w w grze.
+ * @brief Moduł definiujący klasę bazową dla animowanych sprite'ów w grze.
  *
- * Zawiera klas AnimatedSprite, ktra zarzdza animacj, pozycj i renderowaniem sprite'w.
- * Jest klas bazow dla gracza, przeszkd i efektw wizualnych (np. pyu).
+ * Zawiera klasę AnimatedSprite, która zarządza animacją, pozycją i renderowaniem sprite'ów.
+ * Jest klasą bazową dla gracza, przeszkód i efektów wizualnych (np. pyłu).
  */
 
 module;
@@ -11,39 +11,38 @@ module;
 export module AnimatedSpriteModule;
 
 import ConfigModule;
+import AnimationSystemModule;
+import DrawListModule;
 
 /**
  * @class AnimatedSprite
- * @brief Klasa bazowa dla animowanych sprite'w w grze.
+ * @brief Klasa bazowa dla animowanych sprite'ów w grze.
  *
- * Odpowiada za zarzdzanie pozycj, skal, animacj i renderowaniem sprite'w.
+ * Odpowiada za zarządzanie pozycją, skalą, animacją i renderowaniem sprite'ów.
  * Klasa jest abstrakcyjna i wymaga nadpisywania metod wirtualnych w klasach pochodnych.
+ * Klatka animacji pochodzi z klipu AnimationSystem, przesuwanego raz na klatkę dla wszystkich sprite'ów.
  */
 export class AnimatedSprite {
 protected:
     
     /** @brief Pozycja sprite'a na ekranie (w pikselach). */
     Vector2 screenPos{ 0.f, 0.f };
-    /** @brief Skala sprite'a (mnonik rozmiaru). */
+    /** @brief Skala sprite'a (mnożnik rozmiaru). */
     float scale{ 1.f };
 
     /** @brief Tekstura sprite'a. */
     Texture2D texture{};
-    /** @brief Szeroko pojedynczej klatki animacji (w pikselach). */
+    /** @brief Szerokość pojedynczej klatki animacji (w pikselach). */
     float width{ 0.f };
-    /** @brief Wysoko sprite'a (w pikselach). */
+    /** @brief Wysokość sprite'a (w pikselach). */
     float height{ 0.f };
 
-    /** @brief Aktualna klatka animacji (indeks). */
-    int frame{ 0 };
     /** @brief Maksymalna liczba klatek w animacji. */
     float maxFrames{ 1.f };
-    /** @brief Czas midzy zmianami klatek animacji (w sekundach). */
-    float updateTime{ Config::ANIMATION_UPDATE_TIME };
-    /** @brief Czas od ostatniej zmiany klatki (w sekundach). */
-    float runningTime{ 0.f };
+    /** @brief Klip animacji sprite'a. */
+    AnimationClip clip;
 
-    /** @brief Flaga okrelajca, czy sprite jest aktywny (widoczny i aktualizowany). */
+    /** @brief Flaga określająca, czy sprite jest aktywny (widoczny i aktualizowany). */
     bool isActive{ true };
 
 public:
@@ -51,42 +50,21 @@ public:
     virtual ~AnimatedSprite() = default;
 
     /**
-    * @brief Inicjalizuje sprite'a z podan tekstur i parametrami.
+    * @brief Inicjalizuje sprite'a z podaną teksturą i parametrami.
     * @param tex Tekstura sprite'a.
-    * @param startX Pocztkowa pozycja X na ekranie.
-    * @param startY Pocztkowa pozycja Y na ekranie.
+    * @param startX Początkowa pozycja X na ekranie.
+    * @param startY Początkowa pozycja Y na ekranie.
     * @param scaleFactor Skala sprite'a.
     * @param frameCount Liczba klatek w animacji.
-    * @param animUpdateTime Czas midzy zmianami klatek (domylnie Config::ANIMATION_UPDATE_TIME).
+    * @param animUpdateTime Czas między zmianami klatek (domyślnie Config::ANIMATION_UPDATE_TIME).
     */
-    virtual void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME); 
-        /*{texture = tex;
-        maxFrames = static_cast<float>(frameCount);
-        width = static_cast<float>(tex.width) / maxFrames;
-        height = static_cast<float>(tex.height);
-        screenPos = { startX, startY };
-        scale = scaleFactor;
-        frame = 0;
-        runningTime = 0.f;
-        isActive = true;
-        updateTime = animUpdateTime;
-    
-    }*/
-
-    /**
-     * @brief Aktualizuje stan sprite'a (np. animacj).
-     * @param deltaTime Czas od ostatniej klatki (w sekundach).
-     */
-    virtual void update(float deltaTime); 
-    /*{
-        if (!isActive) return;
-        updateAnimation(deltaTime);
-    }*/
+    virtual void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME);
 
     /**
-    * @brief Rysuje sprite'a na ekranie.
+    * @brief Zapisuje sprite'a do listy poleceń rysowania.
+    * @param list Lista poleceń klatki.
     */
-    virtual void draw() const; /*{
+    virtual void draw(DrawList& list) const; /*{
         if (!isActive) return;
         Rectangle source{ frame * width, 0.f, width, height };
         Rectangle dest{ screenPos.x, screenPos.y, width * scale, height * scale };
@@ -94,8 +72,8 @@ public:
     }*/
 
     /**
-     * @brief Zwraca prostokt kolizji sprite'a.
-     * @return Prostokt kolizji w przestrzeni ekranu.
+     * @brief Zwraca prostokąt kolizji sprite'a.
+     * @return Prostokąt kolizji w przestrzeni ekranu.
      */
     virtual Rectangle getCollisionRec() const; /*{
         return Rectangle{
@@ -107,46 +85,42 @@ public:
     }*/
 
     /**
-    * @brief Zwraca aktualn pozycj sprite'a.
-    * @return Wektor z wsprzdnymi X i Y.
+    * @brief Zwraca aktualną pozycję sprite'a.
+    * @return Wektor z współrzędnymi X i Y.
     */
     Vector2 getPosition() const; /*{ return screenPos; }*/
 
     /**
      * @brief Sprawdza, czy sprite jest aktywny.
-     * @return True, jeli sprite jest aktywny.
+     * @return True, jeśli sprite jest aktywny.
      */
     bool getIsActive() const; /*{ return isActive; }*/
 
     /**
-    * @brief Zwraca tekstur sprite'a.
+    * @brief Zwraca teksturę sprite'a.
     * @return Referencja do tekstury.
     */
     const Texture2D& getTexture() const; /*{ return texture; }*/
 
     /**
-    * @brief Zwraca aktualn klatk animacji.
+    * @brief Zwraca aktualną klatkę animacji.
     * @return Indeks aktualnej klatki.
     */
     int getFrame() const; /*{ return frame; }*/
 
 protected:
     /**
-     * @brief Aktualizuje animacj sprite'a.
-     * @param deltaTime Czas od ostatniej klatki (w sekundach).
+     * @brief Tworzy klip animacji dla init(); domyślnie prywatny i zapętlony.
+     * @param tex Tekstura sprite'a.
+     * @param frameCount Liczba klatek w animacji.
+     * @param animUpdateTime Czas między zmianami klatek (w sekundach).
+     * @return Uchwyt do klipu.
      */
-    void updateAnimation(float deltaTime); /*{
-        runningTime += deltaTime;
-        if (runningTime >= updateTime) {
-            runningTime = 0.f;
-            frame++;
-            if (frame >= maxFrames) frame = 0;
-        }
-    }*/
+    virtual AnimationClip makeClip(const Texture2D& tex, int frameCount, float animUpdateTime);
 
     /**
-    * @brief Ustawia aktywno sprite'a.
-    * @param active True, aby aktywowa sprite; false, aby dezaktywowa.
+    * @brief Ustawia aktywność sprite'a.
+    * @param active True, aby aktywować sprite; false, aby dezaktywować.
     */
     void setActive(bool active); /*{ isActive = active; }*/
 };
\ No newline at end of file
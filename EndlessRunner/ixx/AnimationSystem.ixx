@@ -0,0 +1,170 @@
+﻿/**
+ * @file AnimationSystem.ixx
+ * @brief Moduł odpowiedzialny za animacje poklatkowe wszystkich sprite'ów.
+ *
+ * Stan klipów (faza, tempo, liczba klatek) jest przechowywany w ciągłych tablicach i aktualizowany jednym
+ * przebiegiem na klatkę zamiast osobnego licznika w każdym sprite'cie. Faza jest liczona w klatkach
+ * z częścią ułamkową, więc reszta czasu przechodzi na następną klatkę i tempo animacji nie zależy od FPS.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+export module AnimationSystemModule;
+
+
+export class AnimationSystem;
+
+/**
+ * @class AnimationClip
+ * @brief Uchwyt do klipu animacji; kopiowanie zwiększa licznik referencji.
+ *
+ * Kopie uchwytu (podobnie jak uchwyty do klipu współdzielonego) mają wspólną fazę.
+ * Gdy zniknie ostatni uchwyt, miejsce klipu wraca do puli.
+ */
+export class AnimationClip {
+private:
+    /** @brief System, do którego należy klip (nullptr dla pustego uchwytu). */
+    AnimationSystem* system{ nullptr };
+    /** @brief Indeks klipu w tablicach systemu. */
+    std::uint32_t id{ 0 };
+
+public:
+    AnimationClip() = default;
+
+    /**
+     * @brief Tworzy uchwyt i zwiększa licznik referencji klipu.
+     * @param owner System animacji.
+     * @param clipId Indeks klipu.
+     */
+    AnimationClip(AnimationSystem* owner, std::uint32_t clipId);
+
+    AnimationClip(const AnimationClip& other);
+    AnimationClip(AnimationClip&& other) noexcept;
+    AnimationClip& operator=(const AnimationClip& other);
+    AnimationClip& operator=(AnimationClip&& other) noexcept;
+    ~AnimationClip();
+
+    /** @brief Zwraca bieżącą klatkę. @return Indeks klatki (0 dla pustego uchwytu). */
+    int getFrame() const;
+    /** @brief Zwraca postęp bieżącej klatki. @return Wartość z zakresu [0, 1). */
+    float getFraction() const;
+    /** @brief Sprawdza, czy klip jednorazowy doszedł do końca. @return True po ostatniej klatce. */
+    bool isFinished() const;
+    /** @brief Zwraca fazę klipu (np. do zapisu stanu). @return Indeks klatki z częścią ułamkową (0 dla pustego uchwytu). */
+    float getPhase() const;
+
+    /**
+     * @brief Ustawia fazę klipu (np. przy odtwarzaniu zapisanego stanu).
+     * @param value Indeks klatki z częścią ułamkową (przycinany do zakresu klipu).
+     */
+    void setPhase(float value);
+
+    /**
+     * @brief Wraca do pierwszej klatki i wznawia odtwarzanie.
+     */
+    void restart();
+
+    /**
+     * @brief Wstrzymuje lub wznawia odtwarzanie (faza zostaje zachowana).
+     * @param playing True, aby odtwarzać.
+     */
+    void setPlaying(bool playing);
+
+    /** @brief Sprawdza, czy uchwyt wskazuje klip. @return True, jeśli uchwyt nie jest pusty. */
+    bool isValid() const { return system != nullptr; }
+
+    /**
+     * @brief Zwalnia uchwyt.
+     */
+    void reset();
+};
+
+/**
+ * @class AnimationSystem
+ * @brief Przechowuje klipy animacji w układzie struktura-tablic i przesuwa je wszystkie jednym przebiegiem.
+ */
+export class AnimationSystem {
+private:
+    /** @brief Faza klipu w klatkach (indeks klatki z częścią ułamkową). */
+    std::vector<float> phase;
+    /** @brief Prędkość fazy w klatkach na sekundę (0, gdy klip jest wstrzymany). */
+    std::vector<float> speed;
+    /** @brief Czas jednej klatki (w sekundach). */
+    std::vector<float> frameTime;
+    /** @brief Liczba klatek klipu. */
+    std::vector<float> frameCount;
+    /** @brief Okres zawijania fazy (liczba klatek dla klipów zapętlonych, 0 dla jednorazowych). */
+    std::vector<float> wrapCount;
+    /** @brief Odwrotność okresu zawijania (mnożenie zamiast dzielenia w advance(); 0 - bez zawijania). */
+    std::vector<float> inverseWrapCount;
+    /** @brief Górna granica fazy (liczba klatek dla klipów jednorazowych, FLT_MAX dla zapętlonych). */
+    std::vector<float> limit;
+    /** @brief Liczba uchwytów wskazujących klip (0 - miejsce wolne). */
+    std::vector<std::uint32_t> refs;
+    /** @brief Identyfikator tekstury klipu współdzielonego (0 dla klipów prywatnych). */
+    std::vector<std::uint32_t> sharedTexture;
+    /** @brief Wolne miejsca w tablicach. */
+    std::vector<std::uint32_t> freeSlots;
+    /** @brief Klipy współdzielone według (tekstura, liczba klatek, czas klatki). */
+    std::map<std::tuple<std::uint32_t, int, float>, std::uint32_t> shared;
+
+public:
+    AnimationSystem() = default;
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+    /**
+     * @brief Tworzy prywatny klip.
+     * @param frames Liczba klatek.
+     * @param secondsPerFrame Czas jednej klatki (w sekundach).
+     * @param loop True dla animacji zapętlonej; klip jednorazowy zatrzymuje się po ostatniej klatce.
+     * @return Uchwyt do nowego klipu.
+     */
+    AnimationClip create(int frames, float secondsPerFrame, bool loop = true);
+
+    /**
+     * @brief Zwraca klip współdzielony przez wszystkie sprite'y z tą samą teksturą i tempem.
+     * @param textureId Identyfikator tekstury (0 tworzy klip prywatny).
+     * @param frames Liczba klatek.
+     * @param secondsPerFrame Czas jednej klatki (w sekundach).
+     * @return Uchwyt do klipu.
+     */
+    AnimationClip share(std::uint32_t textureId, int frames, float secondsPerFrame);
+
+    /**
+     * @brief Przesuwa wszystkie klipy o czas klatki.
+     * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+     */
+    void advance(float deltaTime);
+
+    /** @brief Zwraca liczbę żywych klipów. @return Liczba klipów. */
+    std::size_t getClipCount() const { return refs.size() - freeSlots.size(); }
+
+private:
+    friend class AnimationClip;
+
+    /** @brief Tworzy klip w wolnym miejscu. @return Indeks klipu. */
+    std::uint32_t allocate(int frames, float secondsPerFrame, bool loop, std::uint32_t textureId);
+    /** @brief Zwiększa licznik referencji klipu. */
+    void addRef(std::uint32_t id) { refs[id]++; }
+    /** @brief Zmniejsza licznik referencji i zwalnia klip, gdy spadnie do zera. */
+    void release(std::uint32_t id);
+
+    int getFrame(std::uint32_t id) const;
+    float getFraction(std::uint32_t id) const;
+    bool isFinished(std::uint32_t id) const;
+    float getPhase(std::uint32_t id) const { return phase[id]; }
+    void setPhase(std::uint32_t id, float value);
+    void restart(std::uint32_t id);
+    void setPlaying(std::uint32_t id, bool playing);
+};
+
+/**
+ * @brief Zwraca wspólny system animacji gry (przesuwany przez SceneManager raz na klatkę).
+ * @return Referencja do obiektu AnimationSystem.
+ */
+export AnimationSystem& animations();
@@ -0,0 +1,134 @@
+﻿/**
+ * @file AssetPack.ixx
+ * @brief Moduł definiujący archiwum tekstur z gotowymi do wysłania na GPU pikselami RGBA.
+ *
+ * Archiwum zastępuje kilkadziesiąt osobnych plików PNG: zawiera indeks oraz zdekodowane (opcjonalnie
+ * skompresowane LZ4) dane pikseli. Gra mapuje plik do pamięci i wysyła tekstury prosto ze zmapowanych stron,
+ * więc przy starcie system wykonuje jeden sekwencyjny odczyt zamiast otwierania i dekodowania każdego PNG.
+ *
+ * Układ pliku: PackHeader, tablica PackEntry, a dalej dane tekstur wyrównane do PACK_ALIGNMENT bajtów.
+ * Każdy wpis pamięta rozmiar i czas modyfikacji pliku PNG, z którego powstał. W trybie deweloperskim
+ * (--dev-assets) tekstura, której PNG zmieniono po zbudowaniu archiwum, jest wczytywana z luźnego pliku;
+ * zwykły start ufa archiwum i nie sprawdza plików źródłowych.
+ */
+
+module;
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+export module AssetPackModule;
+
+import MappedFileModule;
+
+
+/** @brief Wersja formatu archiwum. */
+export constexpr std::uint32_t PACK_VERSION = 2;
+/** @brief Wyrównanie danych tekstur w pliku (w bajtach). */
+export constexpr std::size_t PACK_ALIGNMENT = 64;
+/** @brief Maksymalna długość ścieżki tekstury zapisanej w indeksie (z kończącym zerem). */
+export constexpr std::size_t PACK_PATH_LENGTH = 104;
+
+/**
+ * @enum PackCompression
+ * @brief Sposób zapisu danych tekstury.
+ */
+export enum class PackCompression : std::uint32_t {
+    NONE = 0, /**< Surowe piksele - wysyłane na GPU bezpośrednio ze zmapowanego pliku. */
+    LZ4 = 1   /**< Blok LZ4 - dekompresowany do bufora przed wysłaniem. */
+};
+
+/**
+ * @struct PackHeader
+ * @brief Nagłówek archiwum.
+ */
+export struct PackHeader {
+    char magic[4];             /**< Sygnatura "DRPK". */
+    std::uint32_t version;     /**< Wersja formatu (PACK_VERSION). */
+    std::uint32_t entryCount;  /**< Liczba tekstur w indeksie. */
+    std::uint32_t reserved;    /**< Zarezerwowane (0). */
+};
+
+/**
+ * @struct PackEntry
+ * @brief Wpis indeksu opisujący jedną teksturę.
+ */
+export struct PackEntry {
+    char path[PACK_PATH_LENGTH]; /**< Znormalizowana ścieżka pliku źródłowego (klucz w TextureCache). */
+    std::uint32_t width;         /**< Szerokość tekstury w pikselach. */
+    std::uint32_t height;        /**< Wysokość tekstury w pikselach. */
+    std::int32_t format;         /**< Format pikseli raylib (PixelFormat). */
+    PackCompression compression; /**< Sposób zapisu danych. */
+    std::uint64_t offset;        /**< Położenie danych od początku pliku. */
+    std::uint64_t storedSize;    /**< Rozmiar danych w pliku. */
+    std::uint64_t rawSize;       /**< Rozmiar pikseli po dekompresji. */
+    std::uint64_t sourceSize;    /**< Rozmiar pliku źródłowego w chwili budowania archiwum. */
+    std::int64_t sourceTime;     /**< Czas modyfikacji pliku źródłowego (std::filesystem::file_time_type, w tikach zegara). */
+};
+
+/**
+ * @class AssetPack
+ * @brief Zmapowane do pamięci archiwum tekstur.
+ */
+export class AssetPack {
+private:
+    /** @brief Zmapowany plik archiwum. */
+    MappedFile file;
+    /** @brief Wpisy indeksu według ścieżki (wskazują na zmapowany plik). */
+    std::unordered_map<std::string, const PackEntry*> index;
+    /** @brief Bufor na zdekompresowane piksele. */
+    std::vector<std::uint8_t> scratch;
+
+public:
+    /**
+     * @brief Mapuje archiwum i sprawdza jego indeks.
+     * @param path Ścieżka do archiwum.
+     * @param checkSources True, aby pominąć wpisy, których plik źródłowy istnieje i zmienił się od zbudowania
+     *        archiwum (te tekstury trafiają do gry z luźnych plików). Kosztuje odczyt metadanych każdego pliku.
+     * @return True, jeśli archiwum jest poprawne.
+     */
+    bool open(const std::string& path, bool checkSources = false);
+
+    /**
+     * @brief Zamyka archiwum.
+     */
+    void close();
+
+    /** @brief Sprawdza, czy archiwum jest otwarte. @return True, jeśli archiwum jest zmapowane. */
+    bool isOpen() const { return file.isOpen(); }
+    /** @brief Zwraca liczbę tekstur w archiwum. @return Liczba wpisów. */
+    std::size_t getEntryCount() const { return index.size(); }
+
+    /**
+     * @brief Szuka tekstury w indeksie.
+     * @param path Znormalizowana ścieżka tekstury.
+     * @return Wpis lub nullptr, jeśli archiwum nie zawiera tekstury.
+     */
+    const PackEntry* find(const std::string& path) const;
+
+    /**
+     * @brief Zwraca piksele tekstury (dla danych bez kompresji - wprost ze zmapowanego pliku).
+     * @param entry Wpis indeksu.
+     * @return Obraz wskazujący na piksele; image.data == nullptr, jeśli danych nie da się odczytać.
+     *         Obrazu nie wolno zwalniać przez UnloadImage, a dane są ważne do następnego wywołania.
+     */
+    Image view(const PackEntry& entry);
+
+    /**
+     * @brief Wysyła teksturę na GPU.
+     * @param entry Wpis indeksu.
+     * @return Tekstura (id == 0, jeśli danych nie da się odczytać).
+     */
+    Texture2D loadTexture(const PackEntry& entry);
+};
+
+/**
+ * @brief Dekoduje wszystkie pliki PNG z katalogu i zapisuje je w archiwum, a następnie porównuje czas wczytania obu wersji.
+ * @param directory Katalog z teksturami.
+ * @param output Ścieżka archiwum.
+ * @param compress True, aby kompresować dane LZ4.
+ * @return True, jeśli archiwum zostało zapisane.
+ */
+export bool packAssets(const std::string& directory, const std::string& output, bool compress);
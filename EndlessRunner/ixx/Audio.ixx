@@ -0,0 +1,256 @@
+﻿/**
+ * @file Audio.ixx
+ * @brief Moduł dźwięku: strumieniowana muzyka i efekty z wcześniej zdekodowanych banków PCM.
+ *
+ * Muzyka jest dekodowana z dysku małymi porcjami przez wątek audio (nigdy w całości do pamięci).
+ * Efekty są dekodowane raz przy starcie do banków PCM i miksowane w wywołaniu zwrotnym strumienia
+ * raylib, czyli w wątku urządzenia audio. Pętla gry tylko wrzuca polecenia do kolejki bez blokad,
+ * więc dźwięk nie zależy od tempa klatek. Bez urządzenia (lub z --audio=null) mikser jest pobierany
+ * przez wątek w tempie czasu rzeczywistego, a próbki są odrzucane.
+ */
+
+module;
+#include "raylib.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+export module AudioModule;
+
+import ConfigModule;
+
+
+/**
+ * @enum Sfx
+ * @brief Efekt dźwiękowy.
+ */
+export enum class Sfx {
+    JUMP,  /**< Skok. */
+    LAND,  /**< Lądowanie. */
+    HIT,   /**< Zderzenie z przeszkodą. */
+    CLICK, /**< Kliknięcie przycisku w menu. */
+    COUNT  /**< Liczba efektów. */
+};
+
+/**
+ * @struct SoundBank
+ * @brief Zdekodowany efekt: próbki mono float w częstotliwości Config::AUDIO_SAMPLE_RATE.
+ */
+export struct SoundBank {
+    /** @brief Próbki PCM. */
+    std::vector<float> samples;
+    /** @brief Priorytet przy braku wolnego głosu (wyższy zabiera głos niższemu). */
+    int priority{ 0 };
+    /** @brief Głośność efektu (0-1). */
+    float volume{ 1.0f };
+};
+
+/**
+ * @class Mixer
+ * @brief Mikser efektów z pulą głosów i podbieraniem głosów według priorytetu.
+ *
+ * play() wywołuje w danej chwili jeden wątek gry (wątek okna albo, w trakcie rozgrywki, wątek symulacji
+ * FramePipeline - przekazanie między nimi jest zsynchronizowane), a render() wyłącznie wątek audio; łączy je kolejka
+ * jeden-producent/jeden-konsument bez blokad. Banki trzeba ustawić przed uruchomieniem wątku audio.
+ */
+export class Mixer {
+private:
+    /**
+     * @struct Voice
+     * @brief Głos miksera odtwarzający jeden efekt.
+     */
+    struct Voice {
+        /** @brief Odtwarzany efekt (-1 - głos wolny). */
+        int sound{ -1 };
+        /** @brief Pozycja w próbkach banku. */
+        std::size_t cursor{ 0 };
+        /** @brief Priorytet efektu. */
+        int priority{ 0 };
+        /** @brief Głośność (bank * polecenie). */
+        float gain{ 0.f };
+        /** @brief Numer kolejny uruchomienia (starszy głos jest podbierany wcześniej). */
+        std::uint64_t serial{ 0 };
+    };
+
+    /**
+     * @struct PlayCommand
+     * @brief Polecenie odtworzenia przekazywane z wątku gry do wątku audio.
+     */
+    struct PlayCommand {
+        /** @brief Efekt. */
+        int sound;
+        /** @brief Głośność polecenia. */
+        float gain;
+    };
+
+    /** @brief Pojemność kolejki poleceń (potęga dwójki). */
+    static constexpr std::uint32_t QUEUE_SIZE = 64;
+
+    /** @brief Banki efektów. */
+    std::array<SoundBank, static_cast<std::size_t>(Sfx::COUNT)> banks;
+    /** @brief Pula głosów. */
+    std::array<Voice, Config::AUDIO_VOICES> voices;
+    /** @brief Kolejka poleceń. */
+    std::array<PlayCommand, QUEUE_SIZE> queue{};
+    /** @brief Indeks zapisu (wątek gry). */
+    std::atomic<std::uint32_t> queueHead{ 0 };
+    /** @brief Indeks odczytu (wątek audio). */
+    std::atomic<std::uint32_t> queueTail{ 0 };
+    /** @brief Licznik uruchomień głosów. */
+    std::uint64_t serial{ 0 };
+    /** @brief Głośność całego miksera. */
+    float masterVolume{ Config::SFX_VOLUME };
+
+    /** @brief Liczba uruchomionych efektów. */
+    std::atomic<std::uint64_t> played{ 0 };
+    /** @brief Liczba efektów, które zabrały głos innemu. */
+    std::atomic<std::uint64_t> stolen{ 0 };
+    /** @brief Liczba efektów odrzuconych (pełna kolejka albo same ważniejsze głosy). */
+    std::atomic<std::uint64_t> dropped{ 0 };
+    /** @brief Liczba zmiksowanych ramek. */
+    std::atomic<std::uint64_t> mixedFrames{ 0 };
+    /** @brief Łączny czas miksowania (ns). */
+    std::atomic<std::uint64_t> mixNanos{ 0 };
+
+public:
+    /**
+     * @brief Ustawia bank efektu.
+     * @param sfx Efekt.
+     * @param bank Zdekodowane próbki, priorytet i głośność.
+     */
+    void setBank(Sfx sfx, SoundBank bank) { banks[static_cast<std::size_t>(sfx)] = std::move(bank); }
+
+    /** @brief Zwraca bank efektu. @param sfx Efekt. @return Referencja do banku. */
+    const SoundBank& getBank(Sfx sfx) const { return banks[static_cast<std::size_t>(sfx)]; }
+
+    /**
+     * @brief Zleca odtworzenie efektu (wątek gry, bez blokad).
+     * @param sfx Efekt.
+     * @param gain Głośność (mnożona przez głośność banku).
+     * @return False, jeśli kolejka jest pełna.
+     */
+    bool play(Sfx sfx, float gain = 1.0f);
+
+    /**
+     * @brief Miksuje kolejne ramki (wątek audio).
+     * @param out Bufor wyjściowy mono float.
+     * @param frames Liczba ramek.
+     */
+    void render(float* out, unsigned int frames);
+
+    /** @brief Zwraca liczbę aktywnych głosów (wątek audio). @return Liczba głosów. */
+    int getActiveVoices() const;
+    /** @brief Zwraca pamięć zajmowaną przez banki. @return Liczba bajtów. */
+    std::size_t getBankBytes() const;
+    /** @brief Zwraca liczbę uruchomionych efektów. @return Licznik. */
+    std::uint64_t getPlayed() const { return played.load(std::memory_order_relaxed); }
+    /** @brief Zwraca liczbę podebranych głosów. @return Licznik. */
+    std::uint64_t getStolen() const { return stolen.load(std::memory_order_relaxed); }
+    /** @brief Zwraca liczbę odrzuconych efektów. @return Licznik. */
+    std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    /** @brief Zwraca liczbę zmiksowanych ramek. @return Licznik. */
+    std::uint64_t getMixedFrames() const { return mixedFrames.load(std::memory_order_relaxed); }
+    /** @brief Zwraca łączny czas miksowania. @return Czas w ns. */
+    std::uint64_t getMixNanos() const { return mixNanos.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Przydziela głos efektowi: wolny, a jeśli brak - najstarszy o najniższym priorytecie nie wyższym niż efekt.
+     * @param command Polecenie odtworzenia.
+     */
+    void start(const PlayCommand& command);
+};
+
+/**
+ * @class AudioSystem
+ * @brief Urządzenie audio, strumień muzyki i mikser efektów.
+ */
+export class AudioSystem {
+private:
+    /** @brief Mikser efektów. */
+    Mixer mixer;
+    /** @brief Strumień raylib, którego wywołanie zwrotne miksuje efekty. */
+    AudioStream sfxStream{};
+    /** @brief Czy urządzenie audio działa (false - wyjście zerowe). */
+    bool deviceReady{ false };
+    /** @brief Czy system został uruchomiony. */
+    bool started{ false };
+    /** @brief Wątek dekodujący muzykę (lub pobierający mikser przy wyjściu zerowym). */
+    std::thread worker;
+    /** @brief Flaga pracy wątku. */
+    std::atomic<bool> running{ false };
+
+    /** @brief Czas dekodowania banków efektów (ns). */
+    std::uint64_t bankDecodeNanos{ 0 };
+    /** @brief Czas dekodowania muzyki w wątku audio (ns). */
+    std::atomic<std::uint64_t> musicDecodeNanos{ 0 };
+    /** @brief Liczba porcji muzyki zdekodowanych w wątku audio. */
+    std::atomic<std::uint64_t> musicUpdates{ 0 };
+    /** @brief Pamięć buforów strumienia muzyki (bajty, bez stanu dekodera). */
+    std::atomic<std::size_t> musicBufferBytes{ 0 };
+    /** @brief Czy muzyka gra. */
+    std::atomic<bool> musicPlaying{ false };
+
+public:
+    AudioSystem() = default;
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+    ~AudioSystem();
+
+    /**
+     * @brief Otwiera urządzenie, dekoduje banki efektów i uruchamia wątek audio.
+     * @param nullOutput True, aby nie otwierać urządzenia (testy, serwery bez dźwięku).
+     * @param musicPath Ścieżka muzyki (nullptr - bez muzyki).
+     * @return True, jeśli działa prawdziwe urządzenie; false przy wyjściu zerowym.
+     */
+    bool start(bool nullOutput, const char* musicPath = Config::MUSIC_FILE);
+
+    /**
+     * @brief Zatrzymuje wątek audio, zwalnia strumienie i zamyka urządzenie.
+     */
+    void stop();
+
+    /**
+     * @brief Zleca odtworzenie efektu.
+     * @param sfx Efekt.
+     * @param gain Głośność.
+     */
+    void play(Sfx sfx, float gain = 1.0f);
+
+    /** @brief Zwraca mikser (np. do testów). @return Referencja do miksera. */
+    Mixer& getMixer() { return mixer; }
+
+    /**
+     * @brief Wypisuje czas dekodowania, pamięć audio i statystyki głosów.
+     */
+    void printReport() const;
+
+private:
+    /**
+     * @brief Dekoduje banki efektów z Config::SOUND_DIRECTORY albo je syntetyzuje.
+     */
+    void loadBanks();
+
+    /**
+     * @brief Pętla wątku audio: dekoduje porcje muzyki albo pobiera mikser przy wyjściu zerowym.
+     * @param musicPath Ścieżka muzyki.
+     */
+    void run(std::string musicPath);
+
+    /**
+     * @brief Wywołanie zwrotne strumienia efektów (wątek urządzenia audio).
+     * @param buffer Bufor ramek float.
+     * @param frames Liczba ramek.
+     */
+    static void mixCallback(void* buffer, unsigned int frames);
+};
+
+/**
+ * @brief Zwraca wspólny dla całego procesu system dźwięku.
+ * @return Referencja do obiektu AudioSystem.
+ */
+export AudioSystem& audio();
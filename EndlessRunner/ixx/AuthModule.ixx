@@ -1,8 +1,9 @@
 /**
  * @file AuthModule.ixx
- * @brief Modu odpowiedzialny za uwierzytelnianie uytkownika.
+ * @brief Moduł odpowiedzialny za uwierzytelnianie użytkownika.
  *
- * Zawiera klas Authorization oraz enumeracje do obsugi rejestracji i logowania.
+ * Zawiera klasę Authorization, enumeracje do obsługi rejestracji i logowania oraz wątek roboczy AuthWorker,
+ * który wykonuje uwierzytelnianie poza pętlą gry.
  */
 
 
@@ -11,52 +12,63 @@ module;
 #include <set>
 #include <regex>
 #include <map>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 export module AuthModule;
 
+import ConfigModule;
+import RecordLogModule;
+
 /**
  * @enum SignInResult
- * @brief Wyniki operacji rejestracji uytkownika.
+ * @brief Wyniki operacji rejestracji użytkownika.
  */
 export enum class SignInResult {
-	SUCCESS,           /**< Rejestracja zakoczona sukcesem. */
-	USERNAME_TAKEN,    /**< Nazwa uytkownika ju istnieje. */
-	INVALID_USERNAME,  /**< Nieprawidowa nazwa uytkownika. */
-	INVALID_PASSWORD   /**< Nieprawidowe haso. */
+	SUCCESS,           /**< Rejestracja zakończona sukcesem. */
+	USERNAME_TAKEN,    /**< Nazwa użytkownika już istnieje. */
+	INVALID_USERNAME,  /**< Nieprawidłowa nazwa użytkownika. */
+	INVALID_PASSWORD   /**< Nieprawidłowe hasło. */
 };
 
 
 /**
  * @enum LogInResult
- * @brief Wyniki operacji logowania uytkownika.
+ * @brief Wyniki operacji logowania użytkownika.
  */
 export enum class LogInResult {
-	SUCCESS,           /**< Logowanie zakoczone sukcesem. */
-	USER_NOT_FOUND,    /**< Uytkownik nie znaleziony. */
-	INCORRECT_PASSWORD /**< Nieprawidowe haso. */
+	SUCCESS,           /**< Logowanie zakończone sukcesem. */
+	USER_NOT_FOUND,    /**< Użytkownik nie znaleziony. */
+	INCORRECT_PASSWORD /**< Nieprawidłowe hasło. */
 };
 
 
 /**
  * @class Authorization
- * @brief Klasa zarzdzajca uwierzytelnianiem uytkownika.
+ * @brief Klasa zarządzająca uwierzytelnianiem użytkownika.
  *
- * Obsuguje rejestracj i logowanie, zapisujc dane uytkownikw do pliku.
+ * Obsługuje rejestrację i logowanie, zapisując dane użytkowników do pliku.
  */
 export class Authorization {
 private:
-	/** @brief Zbir istniejcych nazw uytkownikw. */
+	/** @brief Zbiór istniejących nazw użytkowników. */
 	std::set<std::string> existingUsernames;
-	/** @brief Mapa przechowujca hashe hase dla uytkownikw. */
+	/** @brief Mapa przechowująca hashe haseł dla użytkowników. */
 	std::map<std::string, std::string> storedPasswords;
-	/** @brief Nazwa pliku przechowujcego dane uytkownikw. */
-	const std::string usersFile = "users.txt";
+	/** @brief Plik przechowujący dane użytkowników (współdzielony przez wszystkie instancje gry). */
+	RecordLog usersLog;
 
 	/**
-	 * @brief Hashuje haso uytkownika.
-	 * @param password Haso do zahashowania.
-	 * @return Zahashowane haso jako cig znakw.
-	 * @note Uywa std::hash; w produkcji naley uy bezpiecznego algorytmu.
+	 * @brief Hashuje hasło użytkownika.
+	 * @param password Hasło do zahashowania.
+	 * @return Zahashowane hasło jako ciąg znaków.
+	 * @note Używa std::hash; w produkcji należy użyć bezpiecznego algorytmu.
 	 */
 	std::string hashPassword(const std::string& password);/* {
 		std::hash<std::string> hasher;
@@ -64,55 +76,32 @@ private:
 	}*/
 
 	/**
-	 * @brief Wczytuje dane uytkownikw z pliku.
+	 * @brief Dociąga z pliku użytkowników dopisanych od poprzedniego wywołania (także przez inne instancje gry).
 	 */
-	void loadUsers(); /*{
-		std::ifstream file(usersFile);
-		if (!file.is_open()) {
-			return;
-		}
-
-		std::string line;
-		while (std::getline(file, line)) {
-			std::istringstream iss(line);
-			std::string username, hashedPassword;
-			if (std::getline(iss, username, ':') && std::getline(iss, hashedPassword)) {
-				existingUsernames.insert(username);
-				storedPasswords[username] = hashedPassword;
-			}
-		}
-		file.close();
-	}*/
+	void loadUsers();
 
 	/**
-	 * @brief Zapisuje nowego uytkownika do pliku.
-	 * @param username Nazwa uytkownika.
-	 * @param hashedPassword Zahashowane haso.
-	 * @return True, jeli zapis si powid.
+	 * @brief Dopisuje nowego użytkownika do pliku, o ile żadna inna instancja nie zajęła już tej nazwy.
+	 * @param username Nazwa użytkownika.
+	 * @param hashedPassword Zahashowane hasło.
+	 * @return WRITTEN po zapisie, REJECTED, jeśli nazwa jest zajęta, FAILED przy błędzie pliku.
 	 */
-	bool saveUser(const std::string& username, const std::string& hashedPassword);//{
-	//	std::ofstream file(usersFile, std::ios::app); // Append mode
-	//	if (!file.is_open()) {
-	//		return false;
-	//	}
-	//	file << username << ":" << hashedPassword << "\n";
-	//	file.close();
-	//	return true;
-	//}
+	AppendResult saveUser(const std::string& username, const std::string& hashedPassword);
 
 public:
 	/**
 	* @brief Konstruktor klasy Authorization.
-	* @note Wczytuje istniejcych uytkownikw przy inicjalizacji.
+	* @param path Plik z danymi użytkowników (domyślnie users.txt).
+	* @note Wczytuje istniejących użytkowników przy inicjalizacji.
 	*/
-	Authorization() {
+	explicit Authorization(std::string path = Config::USERS_FILE) : usersLog(std::move(path)) {
 		loadUsers();
 	}
 
 	/**
-	 * @brief Rejestruje nowego uytkownika.
-	 * @param username Nazwa uytkownika (3-20 znakw alfanumerycznych).
-	 * @param password Haso (min. 8 znakw, litery i cyfry).
+	 * @brief Rejestruje nowego użytkownika.
+	 * @param username Nazwa użytkownika (3-20 znaków alfanumerycznych).
+	 * @param password Hasło (min. 8 znaków, litery i cyfry).
 	 * @return Wynik operacji rejestracji.
 	 */
 	SignInResult signIn(const std::string& username, const std::string& password); /*{
@@ -140,9 +129,9 @@ public:
 	}*/
 
 	/**
-	 * @brief Loguje istniejcego uytkownika.
-	 * @param username Nazwa uytkownika.
-	 * @param password Haso.
+	 * @brief Loguje istniejącego użytkownika.
+	 * @param username Nazwa użytkownika.
+	 * @param password Hasło.
 	 * @return Wynik operacji logowania.
 	 */
 	LogInResult logIn(const std::string& username, const std::string& password); /*{
@@ -155,4 +144,105 @@ public:
 		}
 		return LogInResult::SUCCESS;
 	}*/
-};
\ No newline at end of file
+};
+
+
+/**
+ * @class AuthWorker
+ * @brief Wątek roboczy wykonujący rejestrację i logowanie w tle.
+ *
+ * Wczytanie pliku użytkowników, sprawdzenie wyrażeń regularnych i hashowanie haseł odbywają się poza pętlą gry;
+ * ekran formularza odpytuje zwrócony std::future w każdej klatce. Jedyny obiekt Authorization należy do wątku
+ * roboczego, więc żądania są wykonywane po kolei bez dodatkowej synchronizacji.
+ */
+export class AuthWorker {
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @struct Request
+	 * @brief Żądanie czekające w kolejce wątku roboczego.
+	 */
+	struct Request {
+		bool signIn{ false };                         /**< True dla rejestracji, false dla logowania. */
+		std::string username;                         /**< Nazwa użytkownika. */
+		std::string password;                         /**< Hasło. */
+		Clock::time_point submitted;                  /**< Chwila zgłoszenia żądania. */
+		std::promise<SignInResult> signInResult;      /**< Wynik rejestracji. */
+		std::promise<LogInResult> logInResult;        /**< Wynik logowania. */
+	};
+
+	/** @brief Wątek roboczy (uruchamiany przy pierwszym żądaniu). */
+	std::thread worker;
+	/** @brief Chroni kolejkę i statystyki. */
+	mutable std::mutex mutex;
+	/** @brief Budzi wątek roboczy po dodaniu żądania lub przy zamykaniu. */
+	std::condition_variable wake;
+	/** @brief Kolejka żądań. */
+	std::deque<Request> queue;
+	/** @brief Flaga zakończenia pracy wątku. */
+	bool stopping{ false };
+	/** @brief Chwila przyjęcia ostatniego żądania. */
+	Clock::time_point lastSubmit{};
+
+	/** @brief Liczba wykonanych żądań. */
+	std::uint64_t completed{ 0 };
+	/** @brief Liczba żądań odrzuconych przez limit. */
+	std::uint64_t rejected{ 0 };
+	/** @brief Suma opóźnień żądań (ms). */
+	double totalLatencyMs{ 0.0 };
+	/** @brief Największe opóźnienie żądania (ms). */
+	double maxLatencyMs{ 0.0 };
+	/** @brief Opóźnienie ostatniego żądania (ms). */
+	double lastLatencyMs{ 0.0 };
+
+public:
+	AuthWorker() = default;
+	~AuthWorker();
+
+	AuthWorker(const AuthWorker&) = delete;
+	AuthWorker& operator=(const AuthWorker&) = delete;
+
+	/**
+	 * @brief Zleca rejestrację użytkownika.
+	 * @param username Nazwa użytkownika.
+	 * @param password Hasło.
+	 * @return Przyszły wynik rejestracji; nieważny (valid() == false), jeśli żądanie odrzucił limit.
+	 */
+	std::future<SignInResult> signIn(const std::string& username, const std::string& password);
+
+	/**
+	 * @brief Zleca logowanie użytkownika.
+	 * @param username Nazwa użytkownika.
+	 * @param password Hasło.
+	 * @return Przyszły wynik logowania; nieważny (valid() == false), jeśli żądanie odrzucił limit.
+	 */
+	std::future<LogInResult> logIn(const std::string& username, const std::string& password);
+
+	/** @brief Zwraca opóźnienie ostatniego żądania (od zgłoszenia do wyniku). @return Opóźnienie w ms. */
+	double getLastLatencyMs() const;
+
+	/**
+	 * @brief Wypisuje liczbę żądań i ich opóźnienia.
+	 */
+	void printReport() const;
+
+private:
+	/**
+	 * @brief Sprawdza limit żądań i uruchamia wątek roboczy (wywoływana pod blokadą).
+	 * @param now Bieżąca chwila.
+	 * @return True, jeśli żądanie może trafić do kolejki.
+	 */
+	bool admit(Clock::time_point now);
+
+	/**
+	 * @brief Pętla wątku roboczego.
+	 */
+	void run();
+};
+
+/**
+ * @brief Zwraca wspólny wątek uwierzytelniania gry.
+ * @return Referencja do obiektu AuthWorker.
+ */
+export AuthWorker& authWorker();
@@ -1,6 +1,6 @@
 /**
  * @file Bat.ixx
- * @brief Modu definiujcy klas Bat, reprezentujc animowan przeszkod typu nietoperz.
+ * @brief Moduł definiujący klasę Bat, reprezentującą animowaną przeszkodę typu nietoperz.
  *
  * Klasa Bat dziedziczy po Obstacle i specjalizuje zachowanie dla nietoperza.
  */
@@ -10,25 +10,26 @@ module;
 export module BatModule;
 
 import ObstacleModule;
+import DrawListModule;
 import ConfigModule;
 
 /**
  * @class Bat
- * @brief Klasa reprezentujca przeszkod typu nietoperz.
+ * @brief Klasa reprezentująca przeszkodę typu nietoperz.
  *
- * Nietoperz jest animowan przeszkod, ktra porusza si w lewo i pojawia si na okrelonej wysokoci.
+ * Nietoperz jest animowaną przeszkodą, która porusza się w lewo i pojawia się na określonej wysokości.
  */
 export class Bat : public Obstacle {
 public:
 
     /**
-     * @brief Inicjalizuje nietoperza z podan tekstur i parametrami.
+     * @brief Inicjalizuje nietoperza z podaną teksturą i parametrami.
      * @param tex Tekstura nietoperza.
-     * @param startX Pocztkowa pozycja X.
-     * @param startY Pocztkowa pozycja Y (przesunita o 150 pikseli w gr).
+     * @param startX Początkowa pozycja X.
+     * @param startY Początkowa pozycja Y (przesunięta w górę o Config::BAT_ALTITUDE).
      * @param scaleFactor Skala nietoperza.
      * @param frameCount Liczba klatek animacji.
-     * @param animUpdateTime Czas midzy zmianami klatek.
+     * @param animUpdateTime Czas między zmianami klatek.
      */
     void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME) override; /*{
         Obstacle::init(tex, startX, startY - 150.f, scaleFactor, frameCount, animUpdateTime);
@@ -45,15 +46,16 @@ public:
 
 
     /**
-    * @brief Rysuje nietoperza na ekranie.
+    * @brief Zapisuje nietoperza do listy poleceń rysowania.
+    * @param list Lista poleceń klatki.
     */
-    void draw() const override; /*{
-        AnimatedSprite::draw();
+    void draw(DrawList& list) const override; /*{
+        AnimatedSprite::draw(list);
     }*/
 
     /**
-    * @brief Zwraca prostokt kolizji nietoperza.
-    * @return Prostokt kolizji w przestrzeni ekranu.
+    * @brief Zwraca prostokąt kolizji nietoperza.
+    * @return Prostokąt kolizji w przestrzeni ekranu.
     */
     Rectangle getCollisionRec() const override; /*{
         return AnimatedSprite::getCollisionRec();
@@ -0,0 +1,112 @@
+﻿/**
+ * @file Benchmark.ixx
+ * @brief Moduł zestawu testów wydajności gorących fragmentów gry z porównaniem z wynikami bazowymi.
+ *
+ * Zestaw nie otwiera okna (tekstury zostają w RAM, patrz TextureCache::setHeadless), więc działa również
+ * na serwerze bez ekranu. Wyniki są zapisywane jako JSON; tryb porównania wczytuje dwa takie pliki
+ * i zgłasza spowolnienia większe niż zadany próg.
+ */
+
+module;
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+export module BenchmarkModule;
+
+import ConfigModule;
+
+
+/**
+ * @struct BenchmarkResult
+ * @brief Wynik jednego testu wydajności.
+ */
+export struct BenchmarkResult {
+    /** @brief Nazwa testu (grupa.funkcja/wariant). */
+    std::string name;
+    /** @brief Mediana czasu jednej operacji z wszystkich powtórzeń (ns). */
+    double nsPerOp{ 0.0 };
+    /** @brief Najkrótszy czas jednej operacji spośród powtórzeń (ns). */
+    double minNsPerOp{ 0.0 };
+    /** @brief Liczba operacji w jednym powtórzeniu. */
+    std::uint64_t iterations{ 0 };
+    /** @brief Rozmiar danych testu (np. liczba przeszkód lub wierszy pliku), tylko informacyjnie. */
+    std::uint64_t items{ 0 };
+};
+
+/**
+ * @struct BenchmarkThreshold
+ * @brief Dopuszczalne spowolnienie testów o nazwach zaczynających się od prefiksu.
+ */
+export struct BenchmarkThreshold {
+    /** @brief Prefiks nazwy (pusty - wszystkie testy). */
+    std::string prefix;
+    /** @brief Dopuszczalny wzrost czasu operacji (w procentach). */
+    double percent{ Config::BENCHMARK_THRESHOLD_PERCENT };
+};
+
+/**
+ * @brief Uruchamia zestaw testów wydajności.
+ *
+ * Obejmuje: AnimationSystem::advance (następcę AnimatedSprite::updateAnimation), Board::update dla różnych
+ * liczb przeszkód i dla planszy z 1-1000 botami, zapis stanu i kopię planszy (Board::saveState, Board::fork), obstacleCollision, ObstacleFactory::createObstacle dla każdego tła, wczytywanie
+ * użytkowników i Authorization::logIn dla dużych plików, wczytywanie tablicy wyników z dużych plików oraz
+ * kodowanie, dekodowanie i wczytywanie ducha z minuty gry (z wypisaniem stopnia kompresji i przepustowości) oraz
+ * zapis bloku dziennika zdarzeń i analizę zmapowanego dziennika z miliona zdarzeń.
+ * Każdy test jest kalibrowany do Config::BENCHMARK_REPEAT_MS na powtórzenie i powtarzany Config::BENCHMARK_REPEATS razy.
+ *
+ * @param outputPath Plik JSON z wynikami (pusty - bez zapisu).
+ * @param filter Uruchamiane są tylko testy, których nazwa zaczyna się od tego tekstu (pusty - wszystkie).
+ * @return Kod wyjścia procesu (0 - sukces).
+ */
+export int runBenchmarkSuite(const std::string& outputPath = Config::BENCHMARK_FILE, std::string_view filter = {});
+
+/**
+ * @brief Porównuje wyniki z wynikami bazowymi.
+ *
+ * Dla każdego testu obecnego w obu plikach wypisuje zmianę mediany czasu operacji. Próg testu to próg
+ * o najdłuższym pasującym prefiksie (domyślnie Config::BENCHMARK_THRESHOLD_PERCENT).
+ *
+ * @param baselinePath Plik JSON z wynikami bazowymi.
+ * @param currentPath Plik JSON z bieżącymi wynikami.
+ * @param thresholds Progi dla prefiksów nazw.
+ * @return Kod wyjścia procesu (0 - brak regresji, 1 - regresja, 2 - błąd odczytu).
+ */
+export int compareBenchmarks(const std::string& baselinePath, const std::string& currentPath,
+    const std::vector<BenchmarkThreshold>& thresholds);
+
+/**
+ * @brief Zamienia argument progu (PROCENT albo PREFIKS=PROCENT) na strukturę.
+ * @param text Tekst argumentu.
+ * @param out Miejsce na próg.
+ * @return True, jeśli argument jest poprawny.
+ */
+export bool parseBenchmarkThreshold(std::string_view text, BenchmarkThreshold& out);
+
+/**
+ * @brief Wykonuje polecenie zestawu z wiersza poleceń (wspólne dla gry i programu dino_bench).
+ *
+ * --bench [--out=PLIK] [--filter=PREFIKS] uruchamia zestaw, a --bench-compare BAZOWY BIEŻĄCY
+ * [--threshold=PROCENT | --threshold=PREFIKS=PROCENT ...] porównuje dwa pliki wyników.
+ *
+ * @param argc Liczba argumentów programu.
+ * @param argv Argumenty programu; argv[1] to polecenie.
+ * @return Kod wyjścia procesu (2 - nieznane polecenie lub opcja).
+ */
+export int runBenchmarkCommand(int argc, char* argv[]);
+
+/**
+ * @brief Zapisuje wyniki do pliku JSON.
+ * @param path Ścieżka pliku.
+ * @param results Wyniki.
+ * @return True, jeśli zapis się powiódł.
+ */
+export bool writeBenchmarkResults(const std::string& path, const std::vector<BenchmarkResult>& results);
+
+/**
+ * @brief Wczytuje wyniki z pliku JSON zapisanego przez writeBenchmarkResults.
+ * @param path Ścieżka pliku.
+ * @param results Miejsce na wyniki.
+ * @return True, jeśli plik udało się otworzyć i zawiera co najmniej jeden wynik.
+ */
+export bool readBenchmarkResults(const std::string& path, std::vector<BenchmarkResult>& results);
@@ -1,21 +1,29 @@
 /**
  * @file Board.ixx
- * @brief Modu definiujcy klas Board, zarzdzajc rozgrywk.
+ * @brief Moduł definiujący klasę Board, zarządzającą rozgrywką.
  *
- * Klasa Board integruje gracza, przeszkody, py i losowe generowanie przeszkd.
+ * Klasa Board integruje graczy, przeszkody i pył. Przeszkody są losowane i sprawdzane w tle przez ChunkGenerator,
+ * a plansza tylko tworzy je z gotowych fragmentów trasy.
+ *
+ * Na jednej planszy może biec wielu graczy (ludzie na wspólnej klawiaturze i boty), każdy na własnym torze
+ * przesuniętym w poziomie, ale ze wspólnym strumieniem przeszkód. Stan graczy jest trzymany w równoległych
+ * tablicach, a test kolizji idzie po przeszkodach i dla każdej sprawdza naraz wszystkich żywych graczy,
+ * więc koszt kroku rośnie z liczbą graczy liniowo i z małą stałą.
  */
 
 module;
 #include "raylib.h"
+#include <array>
 #include <concepts> 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
 export module BoardModule;
 
-import <array>;
-import <vector>;
-import <memory>;
-import <random>;
 import PlayerModule;
-import DustModule;
+import ParticlesModule;
 import BatModule;
 import PterodactylModule;
 import ResourcesModule;
@@ -24,79 +32,130 @@ import ObstacleModule;
 import ObstacleFactoryModule;
 import ConfigModule;
 import ObstacleFactoryModule;
+import DifficultyModule;
+import CollisionMaskModule;
+import ChunkGeneratorModule;
+import DrawListModule;
+import AnalyticsModule;
+import SnapshotModule;
 
 
 /**
  * @class Board
- * @brief Klasa zarzdzajca gwn logik rozgrywki.
+ * @brief Klasa zarządzająca główną logiką rozgrywki.
  *
- * Odpowiada za aktualizacj i renderowanie gracza, przeszkd, pyu oraz sprawdzanie kolizji.
+ * Odpowiada za aktualizację i renderowanie gracza, przeszkód, pyłu oraz sprawdzanie kolizji.
  */
 export class Board {
 private:
-    /** @brief Obiekt gracza. */
-    Player player{};
-    /** @brief Wektor przechowujcy aktywne przeszkody. */
+    /** @brief Gracze: najpierw sterowani z klawiatury, potem boty (tory rosną w prawo razem z indeksem). */
+    std::vector<Player> players;
+    /** @brief Flagi graczy, którzy jeszcze nie zderzyli się z przeszkodą. */
+    std::vector<std::uint8_t> alive;
+    /** @brief Czas zderzenia każdego gracza wyznaczony w ostatnim kroku (NO_IMPACT, jeśli nie było kolizji). */
+    std::vector<float> impacts;
+    /** @brief Rodzaj przeszkody, z którą gracz zderzył się najwcześniej w ostatnim kroku. */
+    std::vector<ObstacleKind> impactKinds;
+    /** @brief Prostokąty kolizji graczy z początku bieżącego kroku. */
+    std::vector<Rectangle> playerStartRecs;
+    /** @brief Czas do zetknięcia z przeszkodą, przy którym skacze bot (0 dla graczy sterowanych z klawiatury). */
+    std::vector<float> botLeads;
+    /** @brief Czy gracz był w powietrzu w poprzednim kroku (wykrywanie lądowania; tylko gracze z klawiatury). */
+    std::vector<std::uint8_t> wasInAir;
+    /** @brief Liczniki czasu do spawnu pyłu (tylko gracze z klawiatury). */
+    std::vector<float> dustSpawnTimers;
+    /** @brief Liczba graczy sterowanych z klawiatury w bieżącej rozgrywce. */
+    std::size_t humanCount{ 1 };
+    /** @brief Liczba graczy, którzy jeszcze biegną. */
+    std::size_t aliveCount{ 0 };
+    /** @brief Liczba graczy sterowanych z klawiatury, którzy jeszcze biegną. */
+    std::size_t aliveHumans{ 0 };
+    /** @brief Liczba graczy z klawiatury zamówiona na następną rozgrywkę. */
+    int nextHumans{ 1 };
+    /** @brief Liczba botów zamówiona na następną rozgrywkę. */
+    int nextBots{ 0 };
+    /** @brief Wektor przechowujący aktywne przeszkody. */
     std::vector<std::unique_ptr<Obstacle>> obstacles;
-    /** @brief Pozycja X ostatniej przeszkody. */
+    /** @brief Opisy aktywnych przeszkód (równolegle do obstacles; dla dziennika zdarzeń i zapisu stanu). */
+    std::vector<ObstacleSpec> obstacleSpecs;
+    /** @brief Pozycja X ostatniej przeszkody (przesuwana razem ze światem). */
     float lastObstacleX{ 0.f };
-    /** @brief Minimalna odlego midzy przeszkodami. */
-    float minObstacleDistance{ Config::MIN_OBSTACLE_DISTANCE };
-    /** @brief Maksymalna odlego midzy przeszkodami. */
-    float maxObstacleDistance{ Config::MAX_OBSTACLE_DISTANCE };
+    /** @brief Sterownik trudności (prędkość świata i odstępy między przeszkodami). */
+    Difficulty difficulty;
+    /** @brief Prostokąty kolizji przeszkód z początku bieżącego kroku. */
+    std::vector<Rectangle> obstacleStartRecs;
+    /** @brief Paczka żywych graczy do ciągłego testu kolizji. */
+    SweptBatch playerBatch;
+    /** @brief Indeksy graczy w kolejności paczki playerBatch. */
+    std::vector<std::uint32_t> batchPlayers;
 
     /** @brief Tekstura wybranego dinozaura. */
     Texture2D selectedDinoTex{};
     /** @brief Liczba klatek animacji dinozaura. */
     int selectedDinoFrameCount{ 6 };
 
-    /** @brief Obiekt pyu (efekt wizualny). */
-    Dust dust{};
-    /** @brief Licznik czasu do spawnu pyu. */
-    float dustSpawnTimer{ 0.0f };
-    /** @brief Interwa spawnu pyu. */
+    /** @brief Pula cząsteczek (pył biegu, lądowanie, zderzenie). */
+    ParticleSystem particles;
+    /** @brief Interwał spawnu pyłu. */
     float dustSpawnInterval{ Config::DUST_SPAWN_INTERVAL };
 
-    /** @brief Generator liczb losowych. */
-    std::random_device rd;
-    /** @brief Silnik losujcy. */
-    std::mt19937 gen{ rd() };
-
-    /** @brief Szeroko okna gry. */
+    /** @brief Generator fragmentów trasy (wątek roboczy). */
+    ChunkGenerator chunkGenerator;
+    /** @brief Bieżący fragment trasy. */
+    ObstacleChunk chunk;
+    /** @brief Indeks następnej przeszkody bieżącego fragmentu. */
+    std::size_t chunkCursor{ 0 };
+    /** @brief Liczba ticków, w których zabrakło gotowego fragmentu. */
+    std::uint64_t starvedTicks{ 0 };
+    /** @brief Liczba fragmentów użytych przy prędkości większej niż ta, dla której je sprawdzono. */
+    std::uint64_t staleChunks{ 0 };
+    /** @brief Ziarno generatora przeszkód bieżącej rozgrywki. */
+    std::uint32_t courseSeed{ 0 };
+    /** @brief Ziarno zamówione na następną rozgrywkę (0 - losowe). */
+    std::uint32_t nextCourseSeed{ 0 };
+    /** @brief Flaga kopii planszy (fork): bez wątku generatora, dźwięków i dziennika zdarzeń. */
+    bool detached{ false };
+    /** @brief Bufor stanu przekazywanego przez fork() do tej planszy (rośnie tylko przy większym stanie). */
+    std::vector<std::uint8_t> forkBuffer;
+
+    /** @brief Szerokość okna gry. */
     int windowWidth{};
-    /** @brief Wysoko okna gry. */
+    /** @brief Wysokość okna gry. */
     int windowHeight{};
 
-    /** @brief Referencja do zasobw gry (tekstury). */
+    /** @brief Referencja do zasobów gry (tekstury). */
     Resources& resources;
-    /** @brief Fabryka przeszkd. */
+    /** @brief Fabryka przeszkód. */
     ObstacleFactory obstacleFactory;
-    /** @brief Aktualny typ ta gry. */
+    /** @brief Aktualny typ tła gry. */
     BackgroundType currentBgType;
 
     /**
-    * @brief Generyczna metoda aktualizujca przeszkody okrelonego typu.
-    * @tparam T Typ przeszkody (musi dziedziczy po Obstacle).
+    * @brief Generyczna metoda aktualizująca przeszkody określonego typu.
+    * @tparam T Typ przeszkody (musi dziedziczyć po Obstacle).
     * @param deltaTime Czas od ostatniej klatki (w sekundach).
     */
     template<ObstacleType T>
     void updateObstacles(float deltaTime) {
+        const float velocity = -difficulty.getWorldSpeed();
         for (auto& obstacle : obstacles) {
             if constexpr (std::is_base_of_v<Obstacle, T>) {
+                obstacle->setVelocity(velocity);
                 obstacle->update(deltaTime);
             }
         }
     }
 
     /**
-    * @brief Generyczna metoda rysujca przeszkody okrelonego typu.
-    * @tparam T Typ przeszkody (musi dziedziczy po Obstacle).
+    * @brief Generyczna metoda zapisująca do listy rysowania przeszkody określonego typu.
+    * @tparam T Typ przeszkody (musi dziedziczyć po Obstacle).
+    * @param list Lista poleceń klatki.
     */
     template<ObstacleType T>
-    void drawObstacles() const {
+    void drawObstacles(DrawList& list) const {
         for (const auto& obstacle : obstacles) {
             if constexpr (std::is_base_of_v<Obstacle, T>) {
-                obstacle->draw();
+                obstacle->draw(list);
             }
         }
     }
@@ -105,13 +164,13 @@ public:
 
     /**
      * @brief Konstruktor klasy Board.
-     * @param res Referencja do zasobw gry.
+     * @param res Referencja do zasobów gry.
      */
     Board(Resources& res) : resources(res), obstacleFactory(res) {}
 
 
     /**
-    * @brief Ustawia tekstur dinozaura dla gracza.
+    * @brief Ustawia teksturę dinozaura dla gracza.
     * @param dinoTex Tekstura dinozaura.
     */
     void setDinoTex(const Texture2D& dinoTex);/* {
@@ -119,7 +178,7 @@ public:
     }*/
 
     /**
-     * @brief Ustawia liczb klatek animacji dinozaura.
+     * @brief Ustawia liczbę klatek animacji dinozaura.
      * @param frameCount Liczba klatek animacji.
      */
     void setDinoFrameCount(int frameCount); /*{
@@ -127,18 +186,21 @@ public:
     }*/
 
     /**
-     * @brief Ustawia typ ta gry.
-     * @param bgType Typ ta (np. DESERT_DAY, FOREST_NIGHT).
+     * @brief Ustawia typ tła gry.
+     * @param bgType Typ tła (np. DESERT_DAY, FOREST_NIGHT).
      */
     void setBackgroundType(BackgroundType bgType);/* {
         currentBgType = bgType;
     }*/
 
+    /** @brief Zwraca typ tła gry. @return Typ tła. */
+    BackgroundType getBackgroundType() const { return currentBgType; }
+
     /**
-    * @brief Inicjalizuje plansz gry.
+    * @brief Inicjalizuje planszę gry.
     * @param dinoTex Tekstura dinozaura.
-    * @param windowWidth Szeroko okna gry (w pikselach).
-    * @param windowHeight Wysoko okna gry (w pikselach).
+    * @param windowWidth Szerokość okna gry (w pikselach).
+    * @param windowHeight Wysokość okna gry (w pikselach).
     */
     void init(const Texture2D& dinoTex, int windowWidth, int windowHeight); /* {
         if (selectedDinoTex.id == 0) {
@@ -153,7 +215,7 @@ public:
         float startX = (windowWidth - playerWidth) / 2.f;
         player.init(selectedDinoTex, startX, static_cast<float>(windowHeight), Config::PLAYER_SCALE, selectedDinoFrameCount, Config::ANIMATION_UPDATE_TIME);
 
-        dust.init(resources.getDustRun(), 0, 0, Config::OBSTACLE_SCALE, Config::DUST_FRAME_COUNT, Config::ANIMATION_UPDATE_TIME);
+        particles.setTexture(resources.getDustRun(), Config::DUST_FRAME_COUNT, Config::OBSTACLE_SCALE);
 
         lastObstacleX = static_cast<float>(windowWidth);
         obstacles.clear();
@@ -163,9 +225,10 @@ public:
     /**
      * @brief Aktualizuje stan gry.
      * @param deltaTime Czas od ostatniej klatki (w sekundach).
-     * @param windowHeight Aktualna wysoko okna gry (w pikselach).
+     * @param windowHeight Aktualna wysokość okna gry (w pikselach).
+     * @param score Aktualny wynik gracza (wpływa na poziom trudności).
      */
-    void update(float deltaTime, int windowHeight);/*{
+    void update(float deltaTime, int windowHeight, float score);/*{
         this->windowHeight = windowHeight;
         player.update(deltaTime, windowHeight);
         updateObstacles<Obstacle>(deltaTime); 
@@ -180,29 +243,53 @@ public:
             spawnObstacle(windowWidth, windowHeight);
         }
 
-        dust.update(deltaTime);
+        particles.update(deltaTime);
 
         if (player.isOnGround(windowHeight)) {
             dustSpawnTimer += deltaTime;
             if (dustSpawnTimer >= dustSpawnInterval) {
-                spawnDust();
+                emitAtFeet(EmitterKind::RUN_DUST, windowHeight);
                 dustSpawnTimer = 0.f;
             }
         }
     }*/
 
     /**
-     * @brief Rysuje wszystkie elementy gry.
+     * @brief Zapisuje wszystkie elementy gry do listy rysowania.
+     * @param list Lista poleceń klatki.
      */
-    void draw() const;/* {
+    void draw(DrawList& list) const;/* {
         drawObstacles<Obstacle>();
-        dust.draw();
+        particles.draw();
         player.draw();
     }*/
 
     /**
-     * @brief Sprawdza, czy gracz przegra (kolizja z przeszkod).
-     * @return True, jeli wykryto kolizj z przeszkod.
+     * @brief Aktualizuje tylko efekty cząsteczkowe (np. odłamki po zderzeniu na ekranie końca gry).
+     * @param deltaTime Czas od ostatniej klatki (w sekundach).
+     */
+    void updateEffects(float deltaTime);
+
+    /**
+     * @brief Zapisuje tylko efekty cząsteczkowe do listy rysowania.
+     * @param list Lista poleceń klatki.
+     */
+    void drawEffects(DrawList& list) const;
+
+    /**
+     * @brief Zwraca pulę cząsteczek planszy.
+     * @return Referencja do obiektu ParticleSystem.
+     */
+    ParticleSystem& getParticles();
+
+    /**
+     * @brief Sprawdza, czy rozgrywka się skończyła (wszyscy gracze z klawiatury zderzyli się z przeszkodą).
+     *
+     * Kolizja jest wyznaczana w update() testem ciągłym na całej drodze przebytej w kroku,
+     * więc cienka przeszkoda nie przeleci przez gracza nawet przy dużej prędkości lub długiej klatce.
+     * Bez graczy z klawiatury (np. w teście obciążeniowym) rozgrywka kończy się razem z ostatnim botem.
+     *
+     * @return True, jeśli nie biegnie już żaden gracz z klawiatury.
      */
     bool checkLoss() const; /*{
         for (const auto& obstacle : obstacles) {
@@ -214,31 +301,181 @@ public:
     }*/
 
     /**
-     * @brief Zwraca referencj do obiektu gracza.
-     * @return Staa referencja do gracza.
+     * @brief Zwraca referencję do obiektu gracza.
+     * @param index Indeks gracza (0 - pierwszy gracz z klawiatury).
+     * @return Stała referencja do gracza.
+     */
+    const Player& getPlayer(std::size_t index = 0) const; /*{ return player; }*/
+
+    /**
+     * @brief Ustawia liczbę graczy dla następnego init().
+     * @param humans Liczba graczy z klawiatury (0..Config::MAX_LOCAL_PLAYERS).
+     * @param bots Liczba botów (razem z graczami z klawiatury najwyżej Config::MAX_BOARD_PLAYERS).
+     */
+    void setPlayers(int humans, int bots);
+
+    /** @brief Zwraca liczbę graczy zamówioną na następne init(). @return Liczba graczy. */
+    std::size_t getNextPlayerCount() const { return static_cast<std::size_t>(nextHumans + nextBots); }
+
+    /** @brief Zwraca liczbę graczy z klawiatury zamówioną na następne init(). @return Liczba graczy. */
+    std::size_t getNextHumanCount() const { return static_cast<std::size_t>(nextHumans); }
+
+    /** @brief Zwraca liczbę wszystkich graczy bieżącej rozgrywki. @return Liczba graczy. */
+    std::size_t getPlayerCount() const { return players.size(); }
+
+    /** @brief Zwraca liczbę graczy z klawiatury bieżącej rozgrywki. @return Liczba graczy. */
+    std::size_t getHumanCount() const { return humanCount; }
+
+    /** @brief Zwraca liczbę graczy, którzy jeszcze biegną. @return Liczba graczy. */
+    std::size_t getAliveCount() const { return aliveCount; }
+
+    /**
+     * @brief Sprawdza, czy gracz jeszcze biegnie.
+     * @param index Indeks gracza.
+     * @return True, jeśli gracz nie zderzył się z przeszkodą.
+     */
+    bool isAlive(std::size_t index) const { return alive[index] != 0; }
+
+    /**
+     * @brief Zwraca listę aktywnych przeszkód.
+     * @return Stała referencja do wektora przeszkód.
+     */
+    const std::vector<std::unique_ptr<Obstacle>>& getObstacles() const;
+
+    /**
+     * @brief Zwraca wspólną prędkość świata (przeszkody, ziemia i warstwy tła).
+     * @return Prędkość w pikselach na sekundę.
      */
-    const Player& getPlayer() const; /*{ return player; }*/
+    float getWorldSpeed() const;
+
+    /**
+     * @brief Zgłasza wciśnięcie skoku gracza (obsłużone w najbliższej aktualizacji).
+     * @param index Indeks gracza (zgłoszenia dla nieistniejących lub przegranych graczy są pomijane).
+     * @param offset Chwila skoku liczona od początku kroku (w sekundach).
+     */
+    void requestJump(std::size_t index, float offset = 0.f);
+
+    /**
+     * @brief Zastępuje krzywą trudności (np. w teście obciążeniowym); trasa korzysta z niej od następnego init().
+     * @param curve Nowa krzywa trudności.
+     */
+    void setDifficultyCurve(const DifficultyCurve& curve);
+
+    /**
+     * @brief Zwraca generator fragmentów trasy (statystyki).
+     * @return Stała referencja do generatora.
+     */
+    const ChunkGenerator& getChunkGenerator() const { return chunkGenerator; }
+
+    /** @brief Zwraca liczbę ticków, w których zabrakło gotowego fragmentu. @return Liczba ticków. */
+    std::uint64_t getStarvedTicks() const { return starvedTicks; }
+
+    /** @brief Zwraca liczbę fragmentów użytych przy zbyt dużej prędkości. @return Liczba fragmentów. */
+    std::uint64_t getStaleChunks() const { return staleChunks; }
+
+    /**
+     * @brief Ustawia ziarno generatora przeszkód dla następnego init() (np. trasa ducha); dotyczy jednej rozgrywki.
+     * @param seed Ziarno (0 - losowe).
+     */
+    void setCourseSeed(std::uint32_t seed) { nextCourseSeed = seed; }
+
+    /** @brief Zwraca ziarno generatora przeszkód bieżącej rozgrywki. @return Ziarno. */
+    std::uint32_t getCourseSeed() const { return courseSeed; }
+
+    /**
+     * @brief Zapisuje pełny stan rozgrywki: graczy (fizyka i animacja), przeszkody, resztę bieżącego fragmentu
+     * trasy, trudność, cząsteczki i pozycję ostatniej przeszkody.
+     * @param out Zapis do bufora wywołującego (bez alokacji).
+     * @return False, jeśli zabrakło miejsca (rozmiar podaje getStateBytes()).
+     */
+    bool saveState(SnapshotWriter& out) const;
+
+    /**
+     * @brief Przywraca stan zapisany przez saveState() na zainicjalizowanej planszy (te same zasoby).
+     *
+     * Gracze i przeszkody są tworzone tylko wtedy, gdy ich liczba lub rodzaj różni się od bieżących,
+     * więc wielokrotne przywracanie podobnych stanów nie alokuje pamięci. Generator trasy startuje od nowa
+     * za zapisanym fragmentem i buduje dokładnie te fragmenty, które powstałyby bez zapisu.
+     *
+     * @param in Odczyt stanu.
+     * @return False, jeśli dane są niepełne lub niepoprawne. Błąd wykryty przed pierwszą zmianą zostawia planszę
+     * nietkniętą; późniejszy zostawia ją pustą i przegraną (checkLoss()) - trzeba ją wtedy zainicjalizować od nowa.
+     */
+    bool restoreState(SnapshotReader& in);
+
+    /**
+     * @brief Kopiuje stan planszy do innej planszy (np. do przeszukiwania ruchów bota).
+     *
+     * Kopia nie ma wątku generatora - używa tylko przeszkód i reszty fragmentu trasy z chwili kopiowania
+     * (zwykle kilka ekranów do przodu), jej gracze są wyciszeni, a zdarzenia nie trafiają do dziennika.
+     * Tak jak update(), działa na wątku symulacji (uchwyty animacji nie są bezpieczne wątkowo).
+     *
+     * @param target Plansza docelowa utworzona z tymi samymi zasobami.
+     * @return False, jeśli kopiowanie się nie udało - kopia jest wtedy pusta i przegrana (checkLoss()).
+     */
+    bool fork(Board& target) const;
+
+    /** @brief Zwraca rozmiar bieżącego stanu zapisywanego przez saveState(). @return Rozmiar w bajtach. */
+    std::size_t getStateBytes() const;
+
+    /** @brief Sprawdza, czy plansza jest kopią utworzoną przez fork(). @return True dla kopii. */
+    bool isDetached() const { return detached; }
 
 private:
 
     /**
-     * @brief Spawnuje efekt pyu, gdy gracz jest na ziemi.
+     * @brief Wypuszcza cząsteczki emitera spod nóg gracza.
+     * @param kind Rodzaj emitera.
+     * @param windowHeight Wysokość okna.
+     * @param index Indeks gracza.
      */
-    void spawnDust(int windowHeight); /*{
-        if (!dust.getIsActive()) {
-            Vector2 playerPos = player.getPosition();
-            float dustX = playerPos.x - 20;
-            float dustY = (windowHeight - 65.f) - (dust.getTexture().height * Config::OBSTACLE_SCALE);
-            dust.init(dust.getTexture(), dustX, dustY, Config::OBSTACLE_SCALE, Config::DUST_FRAME_COUNT, Config::ANIMATION_UPDATE_TIME);
-        }
-    }*/
+    void emitAtFeet(EmitterKind kind, int windowHeight, std::size_t index);
 
     /**
-     * @brief Spawnuje now przeszkod.
-     * @param windowWidth Szeroko okna.
-     * @param windowHeight Wysoko okna.
+     * @brief Zgłasza skoki botów: bot skacze, gdy najbliższa nieminięta przeszkoda jest bliżej niż jego czas reakcji,
+     * a drugi raz - w szczycie skoku, jeśli przeszkoda wciąż jest przed nim.
+     *
+     * Przeszkody i tory botów są uporządkowane rosnąco w poziomie, więc najbliższą przeszkodę wszystkich botów
+     * wyznacza jedno przejście po obu listach.
      */
-    void spawnObstacle(int windowHeight);/* {
+    void steerBots();
+
+    /**
+     * @brief Ciągły test kolizji wszystkich żywych graczy ze wszystkimi przeszkodami (wypełnia impacts).
+     */
+    void detectCollisions();
+
+    /**
+     * @brief Uruchamia generator fragmentów trasy courseSeed dla bieżącego tła, gracza i krzywej trudności.
+     * @param from Stan, od którego generator kontynuuje trasę.
+     */
+    void startChunkGenerator(const ChunkCursor& from);
+
+    /**
+     * @brief Wspólna część restoreState() i fork().
+     * @param in Odczyt stanu.
+     * @param detach True dla kopii bez generatora, dźwięków i dziennika.
+     * @return False, jeśli dane są niepełne lub niepoprawne.
+     */
+    bool readState(SnapshotReader& in, bool detach);
+
+    /**
+     * @brief Zostawia planszę pustą i przegraną po nieudanym odczycie stanu, zamiast w połowie przywróconej.
+     */
+    void discardState();
+
+    /**
+     * @brief Tworzy przeszkody z gotowych fragmentów aż do marginesu za prawą krawędzią okna.
+     * @param windowHeight Wysokość okna.
+     */
+    void spawnObstacles(int windowHeight);
+
+    /**
+     * @brief Spawnuje nową przeszkodę.
+     * @param next Przeszkoda fragmentu trasy (opis i odstęp od poprzedniej).
+     * @param windowHeight Wysokość okna.
+     */
+    void spawnObstacle(const ChunkObstacle& next, int windowHeight);/* {
         float startX = lastObstacleX + getRandomDistance();
         float startY = static_cast<float>(windowHeight - 65);
         obstacles.push_back(obstacleFactory.createObstacle(startX, startY, currentBgType));
@@ -246,11 +483,16 @@ private:
     }*/
 
     /**
-    * @brief Generuje losow odlego midzy przeszkodami.
-    * @return Losowa odlego w pikselach.
-    */
-    float getRandomDistance(); /*{
-        std::uniform_real_distribution<float> dis(minObstacleDistance, maxObstacleDistance);
-        return dis(gen);
-    }*/
+     * @brief Wąska faza kolizji: sprawdza maski pikseli gracza i przeszkody na drodze przebytej w kroku.
+     *
+     * Wywoływana tylko dla przeszkód, których prostokąty zetknęły się w teście ciągłym. Pozycje są
+     * próbkowane od chwili zetknięcia prostokątów do końca kroku co najwyżej co Config::MASK_SWEEP_STEP pikseli.
+     * Jeśli któraś z tekstur nie ma maski, używany jest dawny test prostokątów z paddingiem.
+     *
+     * @param index Indeks przeszkody w wektorze obstacles.
+     * @param playerIndex Indeks gracza.
+     * @param start Czas zetknięcia prostokątów z testu ciągłego.
+     * @return Czas zderzenia z przedziału [0, 1] lub NO_IMPACT.
+     */
+    float confirmImpact(std::size_t index, std::size_t playerIndex, float start) const;
 };
\ No newline at end of file
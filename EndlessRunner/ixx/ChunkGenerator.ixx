@@ -0,0 +1,260 @@
+﻿/**
+ * @file ChunkGenerator.ixx
+ * @brief Moduł generatora fragmentów trasy: przeszkody losowane w tle i sprawdzane pod kątem przeskoczenia.
+ *
+ * Wątek roboczy buduje fragmenty po kilka przeszkód z wyprzedzeniem i każdą przeszkodę sprawdza analitycznie
+ * (JumpValidator) względem łuku skoku gracza wynikającego z Config::GRAVITY, Config::JUMP_VELOCITY
+ * i Config::MAX_JUMPS. Gotowe fragmenty trafiają do kolejki bez blokad (jeden producent, jeden konsument),
+ * więc wątek gry tylko zdejmuje fragment i tworzy opisane w nim przeszkody.
+ *
+ * Fragment zależy tylko od ziarna, swojego numeru, krzywej trudności i stanu za poprzednim fragmentem
+ * (ChunkCursor), a nie od chwili, w której wątek go zbudował - to samo ziarno daje tę samą trasę (duchy).
+ */
+
+module;
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+export module ChunkGeneratorModule;
+
+import ConfigModule;
+import DifficultyModule;
+import ObstacleFactoryModule;
+
+
+/**
+ * @struct ChunkObstacle
+ * @brief Przeszkoda fragmentu trasy.
+ */
+export struct ChunkObstacle {
+    /** @brief Opis przeszkody. */
+    ObstacleSpec spec;
+    /** @brief Odstęp od lewej krawędzi poprzedniej przeszkody (w pikselach). */
+    float gap{ 0.f };
+};
+
+/**
+ * @struct ChunkCursor
+ * @brief Stan generatora na granicy fragmentów; z niego i z ziarna powstaje następny fragment.
+ */
+export struct ChunkCursor {
+    /** @brief Numer następnego fragmentu. */
+    std::uint64_t index{ 0 };
+    /** @brief Lewa krawędź ostatniej przeszkody w układzie trasy (droga od początku gry). */
+    double x{ 0.0 };
+    /** @brief Pozycja, od której gracz może się wybić po ostatnim fragmencie. */
+    double readyX{ std::numeric_limits<double>::lowest() };
+};
+
+/**
+ * @struct ObstacleChunk
+ * @brief Fragment trasy: kolejne przeszkody z odstępami.
+ */
+export struct ObstacleChunk {
+    /** @brief Przeszkody w kolejności pojawiania się. */
+    std::vector<ChunkObstacle> obstacles;
+    /** @brief Największa prędkość świata, dla której fragment sprawdzono (w pikselach na sekundę). */
+    float maxSpeed{ 0.f };
+    /** @brief Liczba odrzuconych losowań przeszkód. */
+    std::uint32_t rejected{ 0 };
+    /** @brief Liczba przeszkód wstawionych bez dowodu, że da się je przeskoczyć (po wyczerpaniu prób). */
+    std::uint32_t unsolved{ 0 };
+    /** @brief Stan generatora za tym fragmentem (wznowienie tej samej trasy po odczycie zapisu). */
+    ChunkCursor next;
+};
+
+/**
+ * @struct ChunkSettings
+ * @brief Stałe parametry generatora na czas jednego biegu.
+ */
+export struct ChunkSettings {
+    /** @brief Liczba kształtów: nietoperz, pterodaktyl i warianty statycznych przeszkód. */
+    static constexpr std::size_t SHAPE_COUNT = 2 + Config::STATIC_OBSTACLE_VARIANTS;
+
+    /** @brief Obrys gracza stojącego na ziemi (left pomijane). */
+    ObstacleShape player;
+    /** @brief Obrysy przeszkód (indeks z shapeIndex). */
+    std::array<ObstacleShape, SHAPE_COUNT> shapes{};
+    /** @brief Ziarno losowania. */
+    std::uint32_t seed{ 0 };
+    /** @brief Krzywa trudności, z której wynikają prędkość i odstępy w danym miejscu trasy (nullptr - domyślna). */
+    std::shared_ptr<const DifficultyCurve> curve;
+
+    /**
+     * @brief Zwraca indeks kształtu przeszkody.
+     * @param spec Opis przeszkody.
+     * @return Indeks w tablicy shapes.
+     */
+    static std::size_t shapeIndex(const ObstacleSpec& spec) {
+        return spec.kind == ObstacleKind::BAT ? 0 : spec.kind == ObstacleKind::PTERODACTYL ? 1
+            : 2 + spec.variant % Config::STATIC_OBSTACLE_VARIANTS;
+    }
+};
+
+/**
+ * @class JumpValidator
+ * @brief Analityczne sprawdzenie, czy ciąg przeszkód da się pokonać przy stałej prędkości świata.
+ *
+ * Gracz stoi w miejscu, a przeszkoda zasłania jego kolumnę w przedziale czasu [a, b]. Skok j-krotny
+ * (każdy kolejny skok w szczycie poprzedniego) daje łuk, który rośnie, a potem opada, więc przebywa ponad
+ * wysokością h w jednym przedziale [t1, t2] - dla przeszkody dopuszczalne chwile wybicia tworzą przedział
+ * [b - t2, a - t1]. Kolejne przeszkody dołączają do bieżącego lotu, dopóki przecięcie tych przedziałów
+ * jest niepuste; w przeciwnym razie gracz ląduje najwcześniej, jak może, i wybija się ponownie.
+ * Przeszkody wiszące wyżej niż gracz są mijane po ziemi. Sprawdzenie jest zachowawcze: jeśli przyjmie ciąg,
+ * istnieje sekwencja skoków, która go pokonuje (z dokładnością do zapasu Config::CHUNK_HEIGHT_MARGIN).
+ */
+export class JumpValidator {
+private:
+    /**
+     * @struct Window
+     * @brief Przedział dopuszczalnych chwil wybicia (pusty, jeśli lo > hi).
+     */
+    struct Window {
+        double lo{ 1.0 };
+        double hi{ 0.0 };
+    };
+
+    /** @brief Obrys gracza stojącego na ziemi. */
+    ObstacleShape player;
+    /** @brief Prędkość świata (w pikselach na sekundę). */
+    double speed{ 1.0 };
+    /** @brief Najwcześniejsza chwila, w której gracz może się wybić. */
+    double readyAt{ std::numeric_limits<double>::lowest() };
+    /** @brief Flaga wskazująca, że trwa lot, do którego mogą dołączyć kolejne przeszkody. */
+    bool open{ false };
+    /** @brief Chwile wybicia bieżącego lotu dla skoku 1..MAX_JUMPS-krotnego. */
+    std::array<Window, Config::MAX_JUMPS> flight{};
+
+    /** @brief Najwcześniejsze lądowanie bieżącego lotu (z zapasem na ponowne wybicie). @return Chwila. */
+    double landing() const;
+
+public:
+    /**
+     * @brief Tworzy walidator dla gracza i prędkości.
+     * @param playerShape Obrys gracza stojącego na ziemi.
+     * @param worldSpeed Prędkość świata.
+     */
+    JumpValidator(const ObstacleShape& playerShape, float worldSpeed);
+
+    /**
+     * @brief Wyznacza przedział czasu, w którym łuk skoku jest nie niżej niż height.
+     * @param jumps Liczba skoków (każdy w szczycie poprzedniego).
+     * @param height Wysokość (w pikselach nad ziemią).
+     * @param enter Miejsce na chwilę osiągnięcia wysokości.
+     * @param leave Miejsce na chwilę zejścia poniżej wysokości.
+     * @return False, jeśli łuk nie sięga tej wysokości.
+     */
+    static bool clearInterval(int jumps, double height, double& enter, double& leave);
+
+    /**
+     * @brief Zwraca czas lotu skoku j-krotnego (od wybicia do lądowania).
+     * @param jumps Liczba skoków.
+     * @return Czas w sekundach.
+     */
+    static double flightTime(int jumps);
+
+    /**
+     * @brief Dołącza przeszkodę na końcu ciągu.
+     * @param x Lewa krawędź sprite'a przeszkody w układzie trasy (rosnąco dla kolejnych przeszkód).
+     * @param shape Obrys przeszkody.
+     * @return True, jeśli ciąg nadal da się pokonać; przy false stan się nie zmienia.
+     */
+    bool append(double x, const ObstacleShape& shape);
+
+    /**
+     * @brief Kończy bieżący lot najwcześniejszym lądowaniem.
+     * @return Pozycja na trasie, od której gracz może się znów wybić.
+     */
+    double closeFlight();
+
+    /**
+     * @brief Zaczyna sprawdzanie od stanu, w którym gracz może się wybić od podanej pozycji.
+     * @param readyX Pozycja na trasie.
+     */
+    void restartAt(double readyX);
+};
+
+/**
+ * @class ChunkGenerator
+ * @brief Wątek roboczy generujący fragmenty trasy z wyprzedzeniem.
+ *
+ * Wątek gry tylko zdejmuje gotowe fragmenty (pop); nie czeka ani nie bierze blokad. Pełna kolejka usypia
+ * wątek roboczy do czasu zdjęcia fragmentu.
+ */
+export class ChunkGenerator {
+private:
+    /** @brief Pojemność kolejki fragmentów. */
+    static constexpr std::uint32_t QUEUE_SIZE = Config::CHUNK_QUEUE_CAPACITY;
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "CHUNK_QUEUE_CAPACITY must be a power of two");
+
+    /** @brief Kolejka gotowych fragmentów. */
+    std::array<ObstacleChunk, QUEUE_SIZE> queue{};
+    /** @brief Indeks zapisu (wątek roboczy). */
+    std::atomic<std::uint32_t> queueHead{ 0 };
+    /** @brief Indeks odczytu (wątek gry). */
+    std::atomic<std::uint32_t> queueTail{ 0 };
+    /** @brief Licznik zdarzeń budzących wątek roboczy (zdjęcie fragmentu, zatrzymanie). */
+    std::atomic<std::uint32_t> wakeups{ 0 };
+    /** @brief Flaga zakończenia pracy wątku. */
+    std::atomic<bool> stopping{ false };
+    /** @brief Wątek roboczy. */
+    std::thread worker;
+
+    /** @brief Parametry biegu (zmieniane tylko przy zatrzymanym wątku). */
+    ChunkSettings settings;
+    /** @brief Silnik losujący wątku roboczego (ziarno ustawiane od nowa dla każdego fragmentu). */
+    std::mt19937 gen;
+    /** @brief Stan za ostatnim wygenerowanym fragmentem. */
+    ChunkCursor cursor;
+
+    /** @brief Liczba wygenerowanych fragmentów. */
+    std::atomic<std::uint64_t> chunks{ 0 };
+    /** @brief Liczba odrzuconych losowań. */
+    std::atomic<std::uint64_t> rejected{ 0 };
+    /** @brief Liczba przeszkód wstawionych bez dowodu. */
+    std::atomic<std::uint64_t> unsolved{ 0 };
+
+    /** @brief Pętla wątku roboczego. */
+    void run();
+    /** @brief Buduje i sprawdza jeden fragment. @return Fragment. */
+    ObstacleChunk generate();
+
+public:
+    ChunkGenerator() = default;
+    ~ChunkGenerator();
+
+    ChunkGenerator(const ChunkGenerator&) = delete;
+    ChunkGenerator& operator=(const ChunkGenerator&) = delete;
+
+    /**
+     * @brief Zatrzymuje poprzedni bieg, czyści kolejkę i uruchamia wątek dla nowych parametrów.
+     * @param runSettings Parametry biegu.
+     * @param from Stan, od którego generator kontynuuje trasę (domyślny - początek trasy).
+     */
+    void start(const ChunkSettings& runSettings, const ChunkCursor& from = {});
+
+    /**
+     * @brief Zatrzymuje wątek roboczy.
+     */
+    void stop();
+
+    /**
+     * @brief Zdejmuje gotowy fragment (wątek gry).
+     * @param out Miejsce na fragment.
+     * @return False, jeśli kolejka jest pusta.
+     */
+    bool pop(ObstacleChunk& out);
+
+    /** @brief Zwraca liczbę wygenerowanych fragmentów. @return Liczba fragmentów. */
+    std::uint64_t getChunkCount() const { return chunks.load(std::memory_order_relaxed); }
+    /** @brief Zwraca liczbę odrzuconych losowań. @return Liczba losowań. */
+    std::uint64_t getRejectedCount() const { return rejected.load(std::memory_order_relaxed); }
+    /** @brief Zwraca liczbę przeszkód wstawionych bez dowodu. @return Liczba przeszkód. */
+    std::uint64_t getUnsolvedCount() const { return unsolved.load(std::memory_order_relaxed); }
+};
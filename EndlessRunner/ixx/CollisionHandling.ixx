@@ -1,20 +1,23 @@
 /**
  * @file CollisionHandling.ixx
- * @brief Modu obsugujcy wykrywanie kolizji w grze.
+ * @brief Moduł obsługujący wykrywanie kolizji w grze.
  *
- * Zawiera generyczn funkcj do sprawdzania kolizji midzy prostoktami z opcjonalnym paddingiem oraz koncept dla obiektw kolizyjnych.
+ * Zawiera generyczną funkcję do sprawdzania kolizji między prostokątami z opcjonalnym paddingiem, koncept dla obiektów kolizyjnych
+ * oraz kolizje ciągłe (swept AABB) liczone na podstawie poprzednich i bieżących pozycji obiektów.
  */
 
 module;
 #include "raylib.h"
 #include <concepts>
+#include <cstddef>
+#include <vector>
 export module CollisionHandlingModule;
 
 /**
  * @concept Collidable
- * @brief Koncept dla obiektw, ktre dostarczaj prostokt kolizji.
+ * @brief Koncept dla obiektów, które dostarczają prostokąt kolizji.
  *
- * Obiekty speniajce ten koncept musz posiada metod `getCollisionRec`, ktra zwraca prostokt (`Rectangle`) reprezentujcy obszar kolizji.
+ * Obiekty spełniające ten koncept muszą posiadać metodę `getCollisionRec`, która zwraca prostokąt (`Rectangle`) reprezentujący obszar kolizji.
  * @tparam T Typ obiektu do sprawdzenia.
  */
 export template<typename T>
@@ -23,13 +26,13 @@ concept Collidable = requires(T t) {
 };
 
 /**
- * @brief Sprawdza kolizj midzy dwoma obiektami kolizyjnymi z opcjonalnym paddingiem.
- * @tparam T Pierwszy typ obiektu (musi spenia koncept Collidable).
- * @tparam U Drugi typ obiektu (musi spenia koncept Collidable).
+ * @brief Sprawdza kolizję między dwoma obiektami kolizyjnymi z opcjonalnym paddingiem.
+ * @tparam T Pierwszy typ obiektu (musi spełniać koncept Collidable).
+ * @tparam U Drugi typ obiektu (musi spełniać koncept Collidable).
  * @param a Pierwszy obiekt kolizyjny (np. przeszkoda).
  * @param b Drugi obiekt kolizyjny (np. gracz).
- * @param padding Odstp (padding) zmniejszajcy obszar kolizji prostokta pierwszego obiektu (domylnie 55.0f pikseli).
- * @return True, jeli prostokty kolizji (z uwzgldnieniem paddingu) si pokrywaj; false w przeciwnym razie.
+ * @param padding Odstęp (padding) zmniejszający obszar kolizji prostokąta pierwszego obiektu (domyślnie 55.0f pikseli).
+ * @return True, jeśli prostokąty kolizji (z uwzględnieniem paddingu) się pokrywają; false w przeciwnym razie.
  */
 export template<Collidable T, Collidable U>
 bool obstacleCollision(const T& a, const U& b, float padding = 55.0f) {
@@ -40,4 +43,69 @@ bool obstacleCollision(const T& a, const U& b, float padding = 55.0f) {
     rectA.width -= 2 * padding;
     rectA.height -= 2 * padding;
     return CheckCollisionRecs(rectA, rectB);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Wartość czasu zderzenia oznaczająca brak kolizji w danym kroku.
+ */
+export inline constexpr float NO_IMPACT = 2.0f;
+
+/**
+ * @brief Wyznacza moment pierwszego zetknięcia dwóch prostokątów poruszających się ruchem jednostajnym w trakcie kroku.
+ *
+ * Pozycje są interpolowane liniowo między początkiem (t = 0) a końcem kroku (t = 1), a rozmiary brane z końca kroku.
+ * Dla t = 1 wynik jest zgodny z CheckCollisionRecs, ale kolizja nie zostanie pominięta nawet wtedy,
+ * gdy w jednym kroku obiekty przeleciały przez siebie na wylot.
+ *
+ * @param startA Prostokąt pierwszego obiektu na początku kroku.
+ * @param endA Prostokąt pierwszego obiektu na końcu kroku.
+ * @param startB Prostokąt drugiego obiektu na początku kroku.
+ * @param endB Prostokąt drugiego obiektu na końcu kroku.
+ * @return Czas zderzenia z przedziału [0, 1] lub NO_IMPACT, jeśli obiekty się nie spotkały.
+ */
+export float sweptTimeOfImpact(const Rectangle& startA, const Rectangle& endA, const Rectangle& startB, const Rectangle& endB);
+
+/**
+ * @struct SweptBatch
+ * @brief Paczka przeszkód do ciągłego testu kolizji w układzie struktury tablic (SoA).
+ *
+ * Osobne, ciągłe tablice współrzędnych pozwalają kompilatorowi zwektoryzować pętlę testu.
+ * Wektory są czyszczone, ale nie zwalniane, więc w trakcie gry paczka nie alokuje pamięci.
+ */
+export struct SweptBatch {
+    std::vector<float> startX; /**< Pozycja X na początku kroku. */
+    std::vector<float> startY; /**< Pozycja Y na początku kroku. */
+    std::vector<float> endX;   /**< Pozycja X na końcu kroku. */
+    std::vector<float> endY;   /**< Pozycja Y na końcu kroku. */
+    std::vector<float> width;  /**< Szerokość na końcu kroku. */
+    std::vector<float> height; /**< Wysokość na końcu kroku. */
+    std::vector<float> impact; /**< Wynik testu - czas zderzenia lub NO_IMPACT. */
+
+    /** @brief Usuwa wszystkie elementy, zachowując zaalokowaną pamięć. */
+    void clear();
+
+    /**
+     * @brief Dodaje obiekt do paczki.
+     * @param start Prostokąt kolizji na początku kroku.
+     * @param end Prostokąt kolizji na końcu kroku.
+     */
+    void push(const Rectangle& start, const Rectangle& end);
+
+    /** @brief Zwraca liczbę obiektów w paczce. @return Liczba obiektów. */
+    std::size_t size() const { return endX.size(); }
+};
+
+/**
+ * @brief Ciągły test kolizji gracza ze wszystkimi przeszkodami z paczki.
+ *
+ * Padding jest odejmowany od prostokątów przeszkód, tak jak w obstacleCollision.
+ * Czasy zderzeń poszczególnych przeszkód trafiają do batch.impact.
+ * Bez paddingu test jest symetryczny - paczka może też zawierać graczy, a pierwszy obiekt być przeszkodą.
+ *
+ * @param playerStart Prostokąt gracza na początku kroku.
+ * @param playerEnd Prostokąt gracza na końcu kroku.
+ * @param batch Paczka przeszkód.
+ * @param padding Odstęp zmniejszający prostokąty przeszkód (domyślnie 55.0f pikseli).
+ * @return Najwcześniejszy czas zderzenia lub NO_IMPACT.
+ */
+export float sweptCollisionBatch(const Rectangle& playerStart, const Rectangle& playerEnd, SweptBatch& batch, float padding = 55.0f);
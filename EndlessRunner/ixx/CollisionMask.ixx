@@ -0,0 +1,113 @@
+﻿/**
+ * @file CollisionMask.ixx
+ * @brief Moduł definiujący bitowe maski kolizji generowane z kanału alfa tekstur.
+ *
+ * Maska przechowuje jeden bit na piksel ekranu (po przeskalowaniu sprite'a), upakowany w wiersze
+ * 64-bitowych słów. Dzięki temu test kolizji dwóch sprite'ów sprowadza się do operacji AND na całych słowach.
+ */
+
+module;
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+export module CollisionMaskModule;
+
+import ConfigModule;
+
+
+/**
+ * @struct MaskBounds
+ * @brief Prostokąt obejmujący nieprzezroczyste piksele (prawa i dolna krawędź nie należą do prostokąta).
+ */
+export struct MaskBounds {
+    int left{ 0 };   /**< Pierwsza kolumna. */
+    int top{ 0 };    /**< Pierwszy wiersz. */
+    int right{ 0 };  /**< Kolumna za ostatnią. */
+    int bottom{ 0 }; /**< Wiersz za ostatnim. */
+
+    /** @brief Sprawdza, czy prostokąt jest pusty. @return True, jeśli nie ma nieprzezroczystych pikseli. */
+    bool isEmpty() const { return right <= left || bottom <= top; }
+};
+
+/**
+ * @class CollisionMask
+ * @brief Bitowa maska nieprzezroczystych pikseli całego arkusza sprite'ów.
+ *
+ * Klatki animacji leżą w arkuszu obok siebie, więc klatka f zajmuje kolumny maski
+ * [f * szerokośćKlatki, (f + 1) * szerokośćKlatki) - maskę można zbudować bez znajomości liczby klatek.
+ */
+export class CollisionMask {
+private:
+    /** @brief Szerokość maski w pikselach (po skalowaniu). */
+    int width{ 0 };
+    /** @brief Wysokość maski w pikselach (po skalowaniu). */
+    int height{ 0 };
+    /** @brief Liczba 64-bitowych słów w wierszu. */
+    int wordsPerRow{ 0 };
+    /** @brief Wiersze maski; bit i słowa w odpowiada pikselowi w * 64 + i. Bity poza szerokością są zerowe. */
+    std::vector<std::uint64_t> rows;
+
+public:
+    CollisionMask() = default;
+
+    /**
+     * @brief Buduje maskę z kanału alfa obrazu.
+     * @param image Obraz arkusza sprite'ów.
+     * @param scale Całkowita skala, z jaką sprite jest rysowany (każdy piksel obrazu daje scale x scale bitów).
+     * @param alphaThreshold Minimalna wartość alfa piksela uznawanego za pełny.
+     * @return Zbudowana maska (pusta, jeśli obrazu nie da się odczytać).
+     */
+    static CollisionMask fromImage(const Image& image, int scale, unsigned char alphaThreshold = Config::COLLISION_ALPHA_THRESHOLD);
+
+    /**
+     * @brief Zwraca 64 kolejne bity wiersza, zaczynając od podanej kolumny.
+     * @param row Indeks wiersza.
+     * @param column Kolumna pierwszego bitu (może nie być wyrównana do słowa).
+     * @return Słowo z bitami [column, column + 64); bity poza maską są zerowe.
+     */
+    std::uint64_t extractWord(int row, int column) const;
+
+    /**
+     * @brief Wyznacza obrys nieprzezroczystych pikseli wspólny dla wszystkich klatek.
+     *
+     * Kolumny są liczone względem początku klatki, więc wynik obejmuje sprite niezależnie od bieżącej klatki.
+     *
+     * @param frameWidth Szerokość klatki w pikselach maski (0 - cały arkusz jako jedna klatka).
+     * @return Obrys (pusty dla pustej maski).
+     */
+    MaskBounds opaqueBounds(int frameWidth = 0) const;
+
+    /** @brief Sprawdza, czy maska jest pusta. @return True, jeśli maska nie zawiera danych. */
+    bool isEmpty() const { return rows.empty(); }
+    /** @brief Zwraca szerokość maski. @return Szerokość w pikselach. */
+    int getWidth() const { return width; }
+    /** @brief Zwraca wysokość maski. @return Wysokość w pikselach. */
+    int getHeight() const { return height; }
+    /** @brief Zwraca rozmiar danych maski. @return Rozmiar w bajtach. */
+    std::size_t getByteSize() const { return rows.size() * sizeof(std::uint64_t); }
+};
+
+/**
+ * @struct MaskView
+ * @brief Fragment maski (jedna klatka) umieszczony w przestrzeni ekranu.
+ */
+export struct MaskView {
+    const CollisionMask* mask; /**< Maska arkusza. */
+    int x;                     /**< Pozycja X lewego górnego rogu na ekranie. */
+    int y;                     /**< Pozycja Y lewego górnego rogu na ekranie. */
+    int sourceX;               /**< Pierwsza kolumna klatki w masce. */
+    int width;                 /**< Szerokość klatki w pikselach. */
+    int height;                /**< Wysokość klatki w pikselach. */
+};
+
+/**
+ * @brief Dokładny (co do piksela) test kolizji dwóch klatek.
+ *
+ * Porównuje tylko część wspólną prostokątów, po 64 piksele w jednej operacji AND.
+ *
+ * @param a Pierwsza klatka.
+ * @param b Druga klatka.
+ * @return True, jeśli choć jeden nieprzezroczysty piksel obu klatek się pokrywa.
+ */
+export bool masksOverlap(const MaskView& a, const MaskView& b);
@@ -18,6 +18,10 @@ export namespace Config {
     inline constexpr int DEFAULT_WINDOW_WIDTH = 1280;
     /** @brief Domyślna wysokość okna gry (w pikselach). */
     inline constexpr int DEFAULT_WINDOW_HEIGHT = 720;
+    /** @brief Szerokość tekstury, do której rysowany jest świat w trybie stałej rozdzielczości (--render=fixed). */
+    inline constexpr int INTERNAL_RENDER_WIDTH = 640;
+    /** @brief Wysokość tekstury trybu stałej rozdzielczości (720p, 1080p i 4K to jej całkowite wielokrotności). */
+    inline constexpr int INTERNAL_RENDER_HEIGHT = 360;
     /** @brief Skala sprite'a gracza. */
     inline constexpr float PLAYER_SCALE = 5.0f;
     /** @brief Skala sprite'ów przeszkód. */
@@ -26,14 +30,68 @@ export namespace Config {
     inline constexpr int BAT_FRAME_COUNT = 3;
     /** @brief Liczba klatek animacji pterodaktyla. */
     inline constexpr int PTERODACTYL_FRAME_COUNT = 4;
+    /** @brief Wysokość górnej krawędzi nietoperza nad ziemią (w pikselach). */
+    inline constexpr float BAT_ALTITUDE = 150.f;
+    /** @brief Wysokość górnej krawędzi pterodaktyla nad ziemią (w pikselach). */
+    inline constexpr float PTERODACTYL_ALTITUDE = 260.f;
+    /** @brief Liczba wariantów statycznych przeszkód w każdym tle. */
+    inline constexpr int STATIC_OBSTACLE_VARIANTS = 6;
     /** @brief Liczba klatek animacji pyłu. */
     inline constexpr int DUST_FRAME_COUNT = 5;
     /** @brief Interwał spawnu pyłu (w sekundach). */
     inline constexpr float DUST_SPAWN_INTERVAL = 0.7f;
+    /** @brief Pojemność puli cząsteczek (pył, lądowanie, zderzenia). */
+    inline constexpr int PARTICLE_CAPACITY = 8192;
+    /** @brief Budżet czasu na aktualizację i rysowanie cząsteczek w jednej klatce (w milisekundach). */
+    inline constexpr double PARTICLE_BUDGET_MS = 1.0;
+    /** @brief Ścieżka do pliku z parametrami emiterów cząsteczek. */
+    inline constexpr const char* PARTICLE_CONFIG_FILE = "particles.txt";
+    /** @brief Ścieżka do pliku z przypisaniem klawiszy i przycisków pada do akcji. */
+    inline constexpr const char* CONTROLS_FILE = "controls.txt";
+    /** @brief Pojemność kolejki zdarzeń wejścia (potęga dwójki). */
+    inline constexpr int INPUT_QUEUE_CAPACITY = 64;
+    /** @brief Odstęp między odczytami klawiatury w czasie uśpienia pacera (w sekundach). */
+    inline constexpr double INPUT_SAMPLE_INTERVAL = 0.001;
     /** @brief Minimalna odległość między przeszkodami (w pikselach). */
     inline constexpr float MIN_OBSTACLE_DISTANCE = 200.0f;
     /** @brief Maksymalna odległość między przeszkodami (w pikselach). */
     inline constexpr float MAX_OBSTACLE_DISTANCE = 400.0f;
+    /** @brief Najmniejsza dopuszczalna odległość między przeszkodami niezależnie od poziomu trudności (w pikselach). */
+    inline constexpr float MIN_OBSTACLE_GAP_FLOOR = 150.0f;
+    /** @brief Odległość za prawą krawędzią ekranu, do której wypełniana jest kolejka przeszkód (w pikselach). */
+    inline constexpr float OBSTACLE_SPAWN_MARGIN = 200.0f;
+    /** @brief Pozycja X, po przekroczeniu której przeszkoda jest usuwana (w pikselach). */
+    inline constexpr float OBSTACLE_DESPAWN_X = -200.0f;
+    /** @brief Początkowa prędkość świata - ziemi i przeszkód (piksele/s). */
+    inline constexpr float BASE_WORLD_SPEED = 200.0f;
+    /** @brief Maksymalna prędkość świata (piksele/s). */
+    inline constexpr float MAX_WORLD_SPEED = 5000.0f;
+    /** @brief Mnożnik prędkości świata dla warstwy tła. */
+    inline constexpr float PARALLAX_BG_FACTOR = 0.1f;
+    /** @brief Mnożnik prędkości świata dla warstwy środkowej. */
+    inline constexpr float PARALLAX_MG_FACTOR = 0.2f;
+    /** @brief Mnożnik prędkości świata dla warstwy przedniej. */
+    inline constexpr float PARALLAX_FG_FACTOR = 0.3f;
+    /** @brief Ścieżka do pliku z definicją krzywej trudności. */
+    inline constexpr const char* DIFFICULTY_CURVE_FILE = "difficulty.txt";
+    /** @brief Minimalna wartość alfa piksela uwzględnianego w masce kolizji. */
+    inline constexpr unsigned char COLLISION_ALPHA_THRESHOLD = 128;
+    /** @brief Maksymalne przesunięcie między kolejnymi testami masek w trakcie kroku (w pikselach). */
+    inline constexpr float MASK_SWEEP_STEP = 4.0f;
+    /** @brief Docelowa liczba klatek na sekundę w trybie z ograniczeniem. */
+    inline constexpr int TARGET_FPS = 60;
+    /** @brief Liczba klatek na sekundę w menu bez aktywności użytkownika. */
+    inline constexpr int IDLE_FPS = 10;
+    /** @brief Czas bez wejścia, po którym menu przechodzi w tryb oszczędny (w sekundach). */
+    inline constexpr float IDLE_THROTTLE_DELAY = 3.0f;
+    /** @brief Początkowy zapas czasu przed końcem klatki, w którym pacer przestaje spać i czeka aktywnie (w sekundach). */
+    inline constexpr double PACER_SPIN_MARGIN = 0.002;
+    /** @brief Czas na zadania w tle (np. wczytywanie tekstur) w jednej klatce (w sekundach). */
+    inline constexpr double SCENE_TASK_BUDGET = 0.004;
+    /** @brief Ścieżka do archiwum tekstur (gdy go brak, tekstury są wczytywane z osobnych plików PNG). */
+    inline constexpr const char* ASSET_PACK_FILE = "textures.pak";
+    /** @brief Katalog z teksturami pakowanymi do archiwum. */
+    inline constexpr const char* ASSET_DIRECTORY = "textures";
     /** @brief Czas między zmianami klatek animacji (w sekundach). */
     inline constexpr float ANIMATION_UPDATE_TIME = 1.f / 12.f;
     /** @brief Przyspieszenie grawitacyjne (piksele/s²). */
@@ -42,6 +100,18 @@ export namespace Config {
     inline constexpr float JUMP_VELOCITY = -600.f;
     /** @brief Maksymalna liczba skoków (podwójny skok). */
     inline constexpr int MAX_JUMPS = 2;
+    /** @brief Liczba przeszkód w jednym fragmencie trasy generowanym w tle. */
+    inline constexpr int CHUNK_OBSTACLES = 4;
+    /** @brief Liczba gotowych fragmentów trasy czekających w kolejce (potęga dwójki; mała, bo fragmenty są sprawdzane dla prędkości z chwili generowania). */
+    inline constexpr int CHUNK_QUEUE_CAPACITY = 2;
+    /** @brief Liczba prób wylosowania przeszkody, którą da się przeskoczyć, zanim generator się podda. */
+    inline constexpr int CHUNK_MAX_ATTEMPTS = 64;
+    /** @brief Zapas prędkości, dla którego sprawdzany jest fragment (ułamek prędkości z chwili generowania). */
+    inline constexpr float CHUNK_SPEED_HEADROOM = 0.25f;
+    /** @brief Zapas wysokości przy sprawdzaniu przeskoku nad przeszkodą (w pikselach). */
+    inline constexpr float CHUNK_HEIGHT_MARGIN = 12.f;
+    /** @brief Czas po wylądowaniu, zanim gracz może znów skoczyć (w sekundach). */
+    inline constexpr float CHUNK_LANDING_SLACK = 0.05f;
 
    /** @brief Liczba przycisków w menu głównym. */
     inline constexpr int MENU_BUTTON_COUNT = 5;
@@ -53,14 +123,98 @@ export namespace Config {
     inline constexpr float UI_NUMB_SCALE = 3.5f;
     /** @brief Początkowa liczba żyć gracza. */
     inline constexpr int PLAYER_LIVES = 3;
+    /** @brief Największa liczba graczy sterowanych z klawiatury na jednej planszy (każdy ma własną akcję skoku). */
+    inline constexpr int MAX_LOCAL_PLAYERS = 4;
+    /** @brief Największa liczba wszystkich graczy (ludzi i botów) na jednej planszy. */
+    inline constexpr int MAX_BOARD_PLAYERS = 1024;
+    /** @brief Odstęp między torami kolejnych graczy (w pikselach); przy wielu graczach tory są ciaśniejsze. */
+    inline constexpr float PLAYER_LANE_SPACING = 48.0f;
+    /** @brief Najkrótszy czas do zetknięcia z przeszkodą, przy którym bot skacze (w sekundach). */
+    inline constexpr float BOT_MIN_LEAD = 0.10f;
+    /** @brief Najdłuższy czas do zetknięcia z przeszkodą, przy którym bot skacze (w sekundach). */
+    inline constexpr float BOT_MAX_LEAD = 0.30f;
     /** @brief Szerokość przycisków autoryzacji (w pikselach). */
     inline constexpr float AUTH_BUTTON_WIDTH = 200.0f;
     /** @brief Wysokość przycisków autoryzacji (w pikselach). */
     inline constexpr float AUTH_BUTTON_HEIGHT = 80.0f;
+    /** @brief Maksymalna liczba żądań uwierzytelniania czekających w kolejce wątku roboczego. */
+    inline constexpr int AUTH_MAX_PENDING = 2;
+    /** @brief Minimalny odstęp między kolejnymi żądaniami uwierzytelniania (w milisekundach). */
+    inline constexpr int AUTH_MIN_INTERVAL_MS = 250;
     /** @brief Czas trwania ekranu ładowania (w milisekundach). */
     inline constexpr int LOADING_DURATION_MS = 2000;
     /** @brief Liczba dinozaurów w sklepie. */
     inline constexpr int SHOP_DINO_COUNT = 4;
     /** @brief Czas aktualizacji animacji w sklepie (w sekundach). */
     inline constexpr float SHOP_ANIMATION_UPDATE_TIME = 1.0f / 12.0f;
+    /** @brief Częstotliwość próbkowania miksera dźwięku (Hz). */
+    inline constexpr int AUDIO_SAMPLE_RATE = 44100;
+    /** @brief Liczba głosów miksera efektów (najwięcej jednocześnie brzmiących efektów). */
+    inline constexpr int AUDIO_VOICES = 8;
+    /** @brief Rozmiar jednego z dwóch buforów strumienia efektów (w ramkach; mniejszy - krótsze opóźnienie). */
+    inline constexpr int AUDIO_SFX_FRAMES = 512;
+    /** @brief Rozmiar jednego z dwóch buforów strumienia muzyki (w ramkach). */
+    inline constexpr int AUDIO_STREAM_FRAMES = 4096;
+    /** @brief Odstęp między kolejnymi dekodowaniami porcji muzyki w wątku audio (w milisekundach). */
+    inline constexpr int AUDIO_FEED_INTERVAL_MS = 10;
+    /** @brief Głośność muzyki (0-1). */
+    inline constexpr float MUSIC_VOLUME = 0.4f;
+    /** @brief Głośność efektów (0-1). */
+    inline constexpr float SFX_VOLUME = 0.8f;
+    /** @brief Ścieżka do pliku muzyki. */
+    inline constexpr const char* MUSIC_FILE = "wisdom.mp3";
+    /** @brief Katalog z efektami dźwiękowymi (brakujące efekty są syntetyzowane). */
+    inline constexpr const char* SOUND_DIRECTORY = "sounds";
+    /** @brief Plik z wynikami graczy (nazwa:wynik w każdym wierszu). */
+    inline constexpr const char* SCORES_FILE = "scores.txt";
+    /** @brief Plik z danymi użytkowników (nazwa:hash hasła w każdym wierszu). */
+    inline constexpr const char* USERS_FILE = "users.txt";
+    /** @brief Katalog z najlepszymi przebiegami graczy (duchami), po jednym pliku na gracza. */
+    inline constexpr const char* GHOST_DIRECTORY = "ghosts";
+    /** @brief Odstęp między próbkami wysokości ducha (w sekundach). */
+    inline constexpr float GHOST_SAMPLE_INTERVAL = 0.1f;
+    /** @brief Krok kwantyzacji wysokości ducha (w pikselach). */
+    inline constexpr float GHOST_HEIGHT_STEP = 1.0f;
+    /** @brief Przezroczystość ducha (0-255). */
+    inline constexpr unsigned char GHOST_ALPHA = 96;
+    /** @brief Pamięć rezerwowana na zapis przebiegu przy starcie gry (w bajtach); wystarcza na kilka minut. */
+    inline constexpr int GHOST_RESERVE_BYTES = 4096;
+    /** @brief Plik dziennika zdarzeń rozgrywki (bloki binarne, analizowane przez --analytics-report). */
+    inline constexpr const char* ANALYTICS_FILE = "analytics.bin";
+    /** @brief Liczba zdarzeń w jednym bloku dziennika (pełny blok jest dopisywany do pliku jednym zapisem). */
+    inline constexpr int ANALYTICS_BLOCK_EVENTS = 4096;
+    /** @brief Czas klatki, od którego klatka jest zapisywana w dzienniku jako skok czasu (w milisekundach). */
+    inline constexpr float ANALYTICS_SPIKE_MS = 33.0f;
+    /** @brief Szerokość przedziału histogramów czasu przeżycia i skoków czasu klatki (w sekundach). */
+    inline constexpr float ANALYTICS_BUCKET_SECONDS = 10.0f;
+    /** @brief Liczba przedziałów histogramów (ostatni zbiera wszystkie dłuższe czasy). */
+    inline constexpr int ANALYTICS_BUCKETS = 12;
+    /** @brief Plik ze stanem przerwanej rozgrywki (wznawianej opcją --resume). */
+    inline constexpr const char* SNAPSHOT_FILE = "snapshot.bin";
+    /** @brief Odstęp między zapisami stanu rozgrywki na wypadek awarii (w sekundach). */
+    inline constexpr float SNAPSHOT_INTERVAL = 2.0f;
+    /** @brief Rozmiar porcji czytanej przy dociąganiu nowych rekordów z pliku (w bajtach). */
+    inline constexpr int RECORD_READ_CHUNK = 64 * 1024;
+    /** @brief Ścieżka gniazda lokalnego demona wyników. */
+    inline constexpr const char* SCORE_SOCKET = "dino_scores.sock";
+    /** @brief Najdłuższy czas oczekiwania pętli demona wyników na zdarzenie (w milisekundach). */
+    inline constexpr int SCORE_POLL_MS = 100;
+    /** @brief Limit czasu odbioru odpowiedzi przez klienta demona wyników (w milisekundach). */
+    inline constexpr int SCORE_CLIENT_TIMEOUT_MS = 500;
+    /** @brief Najwięcej nieprzetworzonych żądań i niewysłanych odpowiedzi jednego klienta demona wyników (w bajtach, osobno w każdą stronę). */
+    inline constexpr int SCORE_CLIENT_BUFFER = 1 << 20;
+    /** @brief Rozmiar indeksu rankingu (wyniki od tej wartości w górę dzielą jedno miejsce w drzewie). */
+    inline constexpr int SCORE_INDEX_LIMIT = 1 << 20;
+    /** @brief Największa liczba graczy zwracana przez demona na jedno pytanie TOP. */
+    inline constexpr int SCORE_TOP_MAX = 100;
+    /** @brief Liczba wierszy tablicy wyników. */
+    inline constexpr int LEADERBOARD_ROWS = 10;
+    /** @brief Domyślny plik wyników testów wydajności. */
+    inline constexpr const char* BENCHMARK_FILE = "bench.json";
+    /** @brief Liczba powtórzeń każdego testu wydajności. */
+    inline constexpr int BENCHMARK_REPEATS = 5;
+    /** @brief Minimalny czas jednego powtórzenia testu wydajności (w milisekundach). */
+    inline constexpr int BENCHMARK_REPEAT_MS = 20;
+    /** @brief Domyślny dopuszczalny wzrost czasu operacji przy porównaniu z wynikami bazowymi (w procentach). */
+    inline constexpr double BENCHMARK_THRESHOLD_PERCENT = 10.0;
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 /**
  * @file Controller.ixx
- * @brief Modu definiujcy klas Controller, zarzdzajc gwn ptl gry.
+ * @brief Moduł definiujący klasę Controller, scenę rozgrywki.
  *
- * Klasa Controller odpowiada za renderowanie ta, interfejsu uytkownika i obsug stanu gry.
+ * Klasa Controller odpowiada za renderowanie tła, interfejsu użytkownika i obsługę stanu gry.
+ * Symulacja klatki (plansza, tło, wynik) zapisuje polecenia rysowania do listy w FramePipeline, a render()
+ * tylko wysyła gotową listę - w trybie THREADED symulacja kolejnej klatki biegnie w tym czasie w osobnym wątku.
  */
 module;
 #include "raylib.h"
@@ -10,63 +12,131 @@ module;
 #include <fstream>
 #include <random>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <span>
 export module ControllerModule;
 
 import BoardModule;
 import ResourcesModule;
 import ObstacleFactoryModule;
 import ConfigModule;
+import TelemetryModule;
+import SceneModule;
+import FramePacerModule;
+import DrawListModule;
+import FramePipelineModule;
+import GhostModule;
 
 
 /**
  * @class Controller
- * @brief Klasa zarzdzajca gwn ptl gry i renderowaniem.
+ * @brief Scena rozgrywki: aktualizacja planszy i renderowanie.
  *
- * Odpowiada za inicjalizacj gry, aktualizacj stanu, renderowanie ta i UI oraz zapis wynikw.
+ * Odpowiada za inicjalizację gry, aktualizację stanu, renderowanie tła i UI oraz zapis wyników.
  */
-export class Controller {
+export class Controller : public Scene {
 private:
-	/** @brief Referencja do zasobw gry. */
+	/** @brief Referencja do zasobów gry. */
 	Resources& resources;
 	/** @brief Referencja do planszy gry. */
 	Board& board;
-	/** @brief Nazwa uytkownika. */
+	/** @brief Nazwa użytkownika. */
 	std::string username;
-	/** @brief Szeroko okna gry. */
+	/** @brief Szerokość okna gry. */
 	int windowWidth{};
-	/** @brief Wysoko okna gry. */
+	/** @brief Wysokość okna gry. */
 	int windowHeight{};
-	/** @brief Skala elementw interfejsu uytkownika. */
+	/** @brief Skala elementów interfejsu użytkownika. */
 	float numbScale = Config::UI_NUMB_SCALE;
 
-	/** @brief Pozycja X ta (background). */
+	/** @brief Pozycja X tła (background). */
 	float bgX{};
-	/** @brief Pozycja X warstwy rodkowej (midground). */
+	/** @brief Pozycja X warstwy środkowej (midground). */
 	float mgX{};
 	/** @brief Pozycja X warstwy przedniej (foreground). */
 	float fgX{};
 	/** @brief Pozycja X ziemi. */
 	float groundX{};
-	/** @brief Flaga wskazujca na przegran. */
+	/** @brief Flaga wskazująca na przegraną. */
 	bool gameOver{ false };
-	/** @brief Liczba y gracza. */
+	/** @brief Liczba żyć gracza. */
 	int lives = Config::PLAYER_LIVES; 
-	/** @brief Aktualny wynik gracza. */
+	/** @brief Czas rozgrywki (wynik najlepszego gracza; wpływa na poziom trudności). */
 	float score = 0.0f;
-	/** @brief Flaga wskazujca, czy wynik zosta zapisany. */
+	/** @brief Wyniki graczy z klawiatury (czas, który przebiegli przed zderzeniem). */
+	std::vector<float> playerScores;
+	/** @brief Flaga wskazująca, czy wynik został zapisany. */
 	bool savedScore{ false };
 
-	/** @brief Tekstura ta. */
+	/** @brief Najlepszy przebieg gracza (odtwarzany jako duch). */
+	GhostRun ghost;
+	/** @brief Odtwarzacz ducha. */
+	GhostPlayer ghostPlayer;
+	/** @brief Zapis bieżącego przebiegu. */
+	GhostRecorder ghostRecorder;
+	/** @brief Wysokość ducha nad ziemią w bieżącej klatce (piksele). */
+	float ghostHeight{ 0.f };
+	/** @brief Flaga wskazująca, czy przebieg został już rozpatrzony jako nowy duch. */
+	bool savedGhost{ false };
+	/** @brief Czy rozgrywka jest nagrywana jako duch (tylko gra jednoosobowa z zalogowanym graczem). */
+	bool recordGhost{ false };
+
+	/** @brief Bufor zapisu stanu rozgrywki (rośnie tylko, gdy stan się nie mieści). */
+	std::vector<std::uint8_t> snapshotBuffer;
+	/** @brief Czas od ostatniego zapisu stanu (sekundy). */
+	float snapshotTimer{ 0.f };
+	/** @brief Flaga rozgrywki gracza: tylko ona zapisuje stan gry i trafia do dziennika zdarzeń (testy wydajności nie). */
+	bool persistent{ false };
+
+	/** @brief Tekstura tła. */
 	Texture2D bgTexture{};
-	/** @brief Tekstura warstwy rodkowej. */
+	/** @brief Tekstura warstwy środkowej. */
 	Texture2D mgTexture{};
 	/** @brief Tekstura warstwy przedniej. */
 	Texture2D fgTexture{};
 	/** @brief Tekstura ziemi. */
 	Texture2D groundTexture{};
+	/** @brief Ikona życia. */
+	Texture2D heartIcon{};
+	/** @brief Ikona utraconego życia. */
+	Texture2D lifeLostIcon{};
+	/** @brief Arkusz cyfr wyniku. */
+	Texture2D numbersTexture{};
+
+	/** @brief Publikator stanu gry dla zewnętrznych obserwatorów (pamięć współdzielona). */
+	TelemetryPublisher telemetry;
+	/** @brief Numer ticku od rozpoczęcia gry. */
+	std::uint64_t tick{ 0 };
+	/** @brief Czas bieżącej klatki (sekundy). */
+	float frameTime{ 0.0f };
+	/** @brief Czas aktualizacji symulacji w bieżącej klatce (sekundy). */
+	float updateTime{ 0.0f };
+	/** @brief Czas wysyłania ostatniej klatki (sekundy; zapisywany tylko przez render()). */
+	float drawTime{ 0.0f };
+
+	/**
+	 * @struct FrameInput
+	 * @brief Dane z wątku okna potrzebne symulacji klatki (symulacja nie wywołuje funkcji okna raylib).
+	 */
+	struct FrameInput {
+		/** @brief Czas od poprzedniej klatki (sekundy). */
+		float deltaTime{ 0.0f };
+		/** @brief Logiczna szerokość świata. */
+		int worldWidth{ 0 };
+		/** @brief Czas od uruchomienia programu (sekundy). */
+		double time{ 0.0 };
+		/** @brief Czas wysyłania poprzedniej klatki (sekundy). */
+		float drawTime{ 0.0f };
+	};
+	/** @brief Dane bieżącej klatki (ustawiane przed FramePipeline::kick()). */
+	FrameInput frameInput;
+
+	/** @brief Potok klatki; ostatni składnik, więc jego wątek kończy się przed zniszczeniem stanu, którego używa. */
+	FramePipeline pipeline;
 
 	/**
-	 * @brief Zapisuje wynik gracza do pliku.
+	 * @brief Zapisuje wynik pierwszego gracza (zalogowanego użytkownika) do pliku.
 	 */
 	void saveScore();/* {
 		if (username.empty() || savedScore) return;
@@ -81,170 +151,121 @@ private:
 		}
 	}*/
 
+	/**
+	 * @brief Zapisuje przebieg jako ducha gracza, jeśli pobił poprzedni najlepszy wynik.
+	 */
+	void saveGhost();
+
+	/**
+	 * @brief Zapisuje stan rozgrywki do Config::SNAPSHOT_FILE (plik obok i podmiana).
+	 */
+	void writeSnapshot();
+
 public:
 	/**
 	 * @brief Konstruktor klasy Controller.
-	 * @param res Referencja do zasobw gry.
+	 * @param res Referencja do zasobów gry.
 	 * @param b Referencja do planszy gry.
-	 * @param user Nazwa uytkownika.
-	 * @param width Szeroko okna.
-	 * @param height Wysoko okna.
+	 * @param user Nazwa użytkownika.
+	 * @param width Szerokość okna.
+	 * @param height Wysokość okna.
 	 */
 	Controller(Resources& res, Board& b, const std::string& user, int width, int height)
 		: resources(res), board(b), username(user), windowWidth(width), windowHeight(height) {
 	}
 
 	/**
-	 * @brief Uruchamia gwn ptl gry.
+	 * @brief Losuje tło, przygotowuje planszę i otwiera telemetrię.
+	 * @param scenes Stos scen.
+	 */
+	void enter(SceneManager& scenes) override;
+
+	/**
+	 * @brief Obsługuje wejście i koniec gry (po przegranej ENTER wraca do menu) i zleca symulację klatki.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+	 */
+	void update(SceneManager& scenes, float deltaTime) override;
+
+	/**
+	 * @brief Wysyła listę poleceń rysowania gotowej klatki.
+	 */
+	void render() override;
+
+	/**
+	 * @brief Czeka na koniec symulacji zleconej w poprzedniej klatce.
+	 */
+	void sync() override;
+
+	/**
+	 * @brief Zatrzymuje wątek symulacji.
 	 */
-	void run(); //{
-	//	std::random_device rd;
-	//	std::mt19937 gen(rd());
-	//	std::uniform_int_distribution<> dis(0, 3); 
-	//	int backgroundChoice = dis(gen);
-
-	//	BackgroundType bgType;
-	//	switch (backgroundChoice) {
-	//	case 0: // Pustynia dzienna
-	//		bgTexture = resources.getDesertBackground();
-	//		mgTexture = resources.getDesertMidground();
-	//		fgTexture = resources.getDesertForeground();
-	//		groundTexture = resources.getDesertGround();
-	//		bgType = BackgroundType::DESERT_DAY;
-	//		break;
-	//	case 1: // Pustynia noc
-	//		bgTexture = resources.getDesertNightBackground();
-	//		mgTexture = resources.getDesertNightMidground();
-	//		fgTexture = resources.getDesertNightForeground();
-	//		groundTexture = resources.getDesertNightGround();
-	//		bgType = BackgroundType::DESERT_NIGHT;
-	//		break;
-	//	case 2: // Las za dnia
-	//		bgTexture = resources.getForestBackground();
-	//		mgTexture = resources.getForestMidground();
-	//		fgTexture = resources.getForestForeground();
-	//		groundTexture = resources.getForestGround();
-	//		bgType = BackgroundType::FOREST_DAY;
-	//		break;
-	//	case 3: // Las noc
-	//		bgTexture = resources.getForestNightBackground();
-	//		mgTexture = resources.getForestNightMidground();
-	//		fgTexture = resources.getForestNightForeground();
-	//		groundTexture = resources.getForestNightGround();
-	//		bgType = BackgroundType::FOREST_NIGHT;
-	//		break;
-	//	default:
-	//		bgTexture = resources.getDesertBackground();
-	//		mgTexture = resources.getDesertMidground();
-	//		fgTexture = resources.getDesertForeground();
-	//		bgType = BackgroundType::DESERT_DAY;
-	//		break;
-	//	}
-
-	//	board.setBackgroundType(bgType);
-	//	board.init(resources.getGreenDinoRun(), GetScreenWidth(), GetScreenHeight());
-	//	SetTargetFPS(60);
-
-	//	while (!WindowShouldClose()) {
-	//		float dt = GetFrameTime();
-
-	//		BeginDrawing();
-	//		ClearBackground(BLACK);
-
-	//		scrollBackground(dt, GetScreenWidth(), GetScreenHeight());
-
-	//		if (!gameOver) {
-	//			board.update(dt, windowHeight);
-	//			gameOver = board.checkLoss();
-	//			score += dt;
-	//		}
-
-	//		if (gameOver) {
-	//			std::string gameOverText = "Game Over! Score: " + std::to_string(static_cast<int>(score));
-	//			DrawText(gameOverText.c_str(), windowWidth / 2 - MeasureText(gameOverText.c_str(), 40) / 2, windowHeight / 2, 40, RED);
-	//			if (!savedScore) {
-	//				saveScore();
-	//			}
-	//			DrawText("Press ENTER to return to menu", windowWidth / 2 - MeasureText("Press ENTER to return to menu", 20) / 2, windowHeight / 2 + 50, 20, WHITE);
-	//			if (IsKeyPressed(KEY_ENTER)) {
-	//				gameOver = false;
-	//				break;
-	//			}
-	//		}
-	//		else {
-	//			board.draw();
-	//		}
-
-	//		drawUI();
-
-	//		EndDrawing();
-	//	}
-	//}
+	void exit() override;
+
+	/**
+	 * @brief Włącza zapis stanu gry (snapshot.bin, wznawianie) i dziennik zdarzeń dla tej rozgrywki.
+	 * Ustawiane tylko przez menu przed wejściem do gry; domyślnie wyłączone.
+	 * @param enabled True dla rozgrywki gracza.
+	 */
+	void setPersistent(bool enabled) { persistent = enabled; }
+
+	/** @brief Rozgrywka zawsze działa w pełnym tempie. @return FrameKind::GAMEPLAY. */
+	FrameKind getFrameKind() const override { return FrameKind::GAMEPLAY; }
+
+	/**
+	 * @brief Zapisuje stan rozgrywki (wynik, przesunięcia warstw tła i plansza) do bufora wywołującego.
+	 * Wywoływane między klatkami, gdy symulacja stoi (po sync()).
+	 * @param buffer Bufor.
+	 * @return Liczba zapisanych bajtów (0, jeśli stan się nie zmieścił).
+	 */
+	std::size_t saveSnapshot(std::span<std::uint8_t> buffer) const;
+
+	/**
+	 * @brief Przywraca stan zapisany przez saveSnapshot() (tło sceny musi być tym z zapisu).
+	 * @param data Zapisany stan.
+	 * @return False, jeśli dane są niepoprawne.
+	 */
+	bool restoreSnapshot(std::span<const std::uint8_t> data);
 
 private:
 	/**
-	* @brief Przewija to gry (paralaksa).
+	 * @brief Publikuje stan bieżącego ticku do telemetrii.
+	 * @param frameTime Czas całej klatki (sekundy).
+	 * @param updateTime Czas aktualizacji symulacji (sekundy).
+	 * @param drawTime Czas rysowania (sekundy).
+	 */
+	void publishTelemetry(float frameTime, float updateTime, float drawTime);
+
+	/**
+	 * @brief Symuluje klatkę (tło, plansza, wynik) i zapisuje ją do listy rysowania.
+	 * @param list Pusta lista poleceń klatki.
+	 */
+	void simulate(DrawList& list);
+
+	/**
+	* @brief Przewija tło gry (paralaksa) z prędkością świata pobraną z planszy.
 	* @param dt Czas od ostatniej klatki (w sekundach).
-	* @param windowWidth Szeroko okna.
-	* @param windowHeight Wysoko okna.
 	*/
-	void scrollBackground(float dt, int windowWidth, int windowHeight); //{
-	//	float avgHeight = (bgTexture.height + mgTexture.height + fgTexture.height) / 3.0f;
-	//	float universalScale = static_cast<float>(windowHeight) / avgHeight;
-
-	//	float bgScaledWidth = bgTexture.width * universalScale;
-	//	float mgScaledWidth = mgTexture.width * universalScale;
-	//	float fgScaledWidth = fgTexture.width * universalScale;
-	//	float groundScaledWidth = groundTexture.width * universalScale;
-
-	//	bgX -= 20 * dt;
-	//	mgX -= 40 * dt;
-	//	fgX -= 60 * dt;
-	//	groundX -= 200 * dt;
-
-	//	// resetowanie pozycji gdy tekstura cakowicie wyjdzie poza ekran
-	//	// Uywamy modulo, aby zapewni cigo
-	//	bgX = fmod(bgX, bgScaledWidth);
-	//	if (bgX > 0) bgX -= bgScaledWidth; // Zapewniamy, e pierwsza instancja zaczyna si od lewej krawdzi
-	//	mgX = fmod(mgX, mgScaledWidth);
-	//	if (mgX > 0) mgX -= mgScaledWidth;
-	//	fgX = fmod(fgX, fgScaledWidth);
-	//	if (fgX > 0) fgX -= fgScaledWidth;
-	//	groundX = fmod(groundX, groundScaledWidth);
-	//	if (groundX > 0) groundX -= groundScaledWidth;
-
-	//	auto drawTileableLayer = [&](Texture2D texture, float xPos, float scaledWidth) {
-	//		// Obliczamy, ile instancji tekstury potrzebujemy, aby pokry ekran + jedna dodatkowa
-	//		int numInstances = static_cast<int>(windowWidth / scaledWidth) + 2;
-	//		// Przesunicie pocztkowe, aby pierwsza instancja zaczynaa si poza ekranem
-	//		float startX = xPos;
-	//		for (int i = 0; i < numInstances; ++i) {
-	//			float drawX = startX + i * scaledWidth;
-	//			DrawTextureEx(texture, { drawX, 0.f }, 0.0f, universalScale, WHITE);
-	//		}
-	//		};
-
-	//	auto drawForegroundLayer = [&](Texture2D texture, float xPos, float scaledWidth) {
-	//		int numInstances = static_cast<int>(windowWidth / scaledWidth) + 2;
-	//		float startX = xPos;
-	//		for (int i = 0; i < numInstances; ++i) {
-	//			float drawX = startX + i * scaledWidth;
-	//			float textureHeight = texture.height * universalScale;
-	//			float drawY = windowHeight - textureHeight;
-	//			DrawTextureEx(texture, { drawX, drawY }, 0.0f, universalScale, WHITE);
-	//		}
-	//		};
-
-	//	drawTileableLayer(bgTexture, bgX, bgScaledWidth);
-	//	drawTileableLayer(mgTexture, mgX, mgScaledWidth);
-	//	drawForegroundLayer(fgTexture, fgX, fgScaledWidth);
-	//	drawTileableLayer(groundTexture, groundX, groundScaledWidth);
-	//}
+	void scrollBackground(float dt);
+
+	/**
+	 * @brief Zwraca skalę warstw tła dopasowaną do wysokości okna.
+	 * @return Skala warstw tła.
+	 */
+	float backgroundScale() const;
 
 	/**
-	 * @brief Rysuje interfejs uytkownika (np. wynik, ikony y).
+	 * @brief Zapisuje warstwy tła w bieżących pozycjach do listy rysowania.
+	 * @param list Lista poleceń klatki.
 	 */
-	void drawUI();/* {
+	void drawBackground(DrawList& list) const;
+
+	/**
+	 * @brief Zapisuje interfejs użytkownika do listy rysowania: wiersz z ikoną życia i wynikiem dla każdego
+	 * gracza z klawiatury oraz liczbę botów, które jeszcze biegną.
+	 * @param list Lista poleceń klatki.
+	 */
+	void drawUI(DrawList& list) const;/* {
 		Texture2D lifeFull = resources.getHeartIcon();
 		Texture2D lifeEmpty = resources.getLifeLostIcon();
 
@@ -278,3 +299,8 @@ private:
 		}
 	}*/
 };
+
+/**
+ * @brief Zamawia wznowienie rozgrywki z Config::SNAPSHOT_FILE przy najbliższym wejściu do gry (opcja --resume).
+ */
+export void requestResume();
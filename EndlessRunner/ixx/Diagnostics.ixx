@@ -0,0 +1,120 @@
+﻿/**
+ * @file Diagnostics.ixx
+ * @brief Moduł z trybami diagnostycznymi uruchamianymi z linii poleceń.
+ */
+
+module;
+#include <cstdint>
+#include <string>
+export module DiagnosticsModule;
+
+
+/**
+ * @brief Test obciążeniowy sterownika trudności.
+ *
+ * Uruchamia planszę w ukrytym oknie z krzywą prowadzącą do skrajnych prędkości, z losowymi
+ * skokami czasu klatki, i sprawdza, czy symulacja pozostaje stabilna: pozycje są skończone,
+ * liczba przeszkód ograniczona, odstępy nie spadają poniżej minimum, a koszt ticku nie rośnie.
+ *
+ * @param ticks Liczba ticków symulacji.
+ * @return Kod wyjścia procesu (0 - wszystkie niezmienniki spełnione).
+ */
+export int runDifficultyStress(std::uint32_t ticks = 20000);
+
+/**
+ * @brief Porównanie trybów tempa klatek.
+ *
+ * Rysuje prostą scenę kolejno w każdym trybie (vsync, capped, uncapped), a na końcu symuluje
+ * bezczynne menu. Wypisuje średni czas klatki, jitter i zużycie CPU dla każdego trybu.
+ *
+ * @param secondsPerMode Czas pomiaru jednego trybu (sekundy).
+ * @return Kod wyjścia procesu.
+ */
+export int runPacingBenchmark(float secondsPerMode = 5.0f);
+
+/**
+ * @brief Pomiar kosztu animacji na sprite.
+ *
+ * Porównuje dawną aktualizację (wirtualne update() i licznik w każdym obiekcie) z jednym przebiegiem
+ * AnimationSystem dla klipów prywatnych i współdzielonych, a także sprawdza, czy tempo animacji
+ * nie zależy od liczby klatek na sekundę. Nie wymaga okna.
+ *
+ * @param spriteCount Liczba sprite'ów w pierwszej serii (druga ma ich dziesięć razy więcej).
+ * @param frames Liczba symulowanych klatek w każdej serii.
+ * @return Kod wyjścia procesu.
+ */
+export int runAnimationBenchmark(std::uint32_t spriteCount = 10000, std::uint32_t frames = 1000);
+
+/**
+ * @brief Pomiar kosztu aktualizacji puli cząsteczek.
+ *
+ * Co klatkę wypuszcza serie odłamków, tak aby pula utrzymywała zadaną liczbę żywych cząsteczek,
+ * i mierzy czas ParticleSystem::update() na cząsteczkę oraz na klatkę względem Config::PARTICLE_BUDGET_MS.
+ * Rysowanie wymaga kontekstu graficznego, więc nie jest mierzone i tryb nie otwiera okna.
+ *
+ * @param particleCount Docelowa liczba żywych cząsteczek w pierwszej serii (kolejne mają ich dwa i cztery razy więcej).
+ * @param frames Liczba symulowanych klatek w każdej serii.
+ * @return Kod wyjścia procesu.
+ */
+export int runParticleBenchmark(std::uint32_t particleCount = 2000, std::uint32_t frames = 1000);
+
+/**
+ * @brief Porównanie kosztu klatki rozgrywki w trybie natywnym i w trybie stałej rozdzielczości.
+ *
+ * Dla okien 720p, 1080p i 4K uruchamia scenę rozgrywki bez limitu klatek, najpierw rysując świat
+ * prosto do okna, a potem przez teksturę Config::INTERNAL_RENDER_WIDTH x Config::INTERNAL_RENDER_HEIGHT.
+ * Wypisuje faktyczny rozmiar okna (system może go ograniczyć do rozmiaru ekranu), średni i najdłuższy czas klatki.
+ *
+ * @param secondsPerSize Czas pomiaru jednego rozmiaru w jednym trybie (sekundy).
+ * @return Kod wyjścia procesu.
+ */
+export int runPresentationBenchmark(float secondsPerSize = 3.0f);
+
+/**
+ * @brief Porównanie kosztu klatki rozgrywki z symulacją w wątku okna i w osobnym wątku.
+ * Uruchamia scenę rozgrywki bez limitu klatek najpierw w trybie PipelineMode::SERIAL, a potem THREADED,
+ * w którym symulacja kolejnej klatki nakłada się na wysyłanie poprzedniej. Wypisuje liczbę wątków sprzętowych
+ * (na jednym rdzeniu zysku nie będzie), średni, 99. percentyl i najdłuższy czas klatki.
+ * @param secondsPerMode Czas pomiaru jednego trybu (sekundy).
+ * @return Kod wyjścia procesu.
+ */
+export int runPipelineBenchmark(float secondsPerMode = 5.0f);
+
+/**
+ * @brief Test jednoczesnego zapisu wielu procesów do jednego pliku rekordów.
+ *
+ * Uruchamia writers kopii programu w trybie --storage-writer, które dopisują rekordy do wspólnego pliku
+ * przez RecordLog, i w tym czasie czyta plik przyrostowo. Sprawdza, że żaden wiersz nie jest rozerwany,
+ * rekordy każdego procesu są w kolejności i żadnego nie brakuje.
+ *
+ * @param executable Ścieżka do programu (argv[0]).
+ * @param writers Liczba procesów zapisujących.
+ * @param recordsPerWriter Liczba rekordów dopisywanych przez każdy proces.
+ * @return Kod wyjścia procesu (0 - plik jest spójny).
+ */
+export int runStorageStress(const std::string& executable, int writers = 8, int recordsPerWriter = 2000);
+
+/**
+ * @brief Proces zapisujący testu runStorageStress.
+ * @param path Wspólny plik rekordów.
+ * @param writerId Numer procesu.
+ * @param records Liczba rekordów do dopisania.
+ * @return Kod wyjścia procesu (0 - wszystkie rekordy dopisane).
+ */
+export int runStorageWriter(const std::string& path, int writerId, int records);
+
+/**
+ * @brief Generator obciążenia demona wyników.
+ *
+ * Uruchamia clients wątków, z których każdy ma własne połączenie i w pętli wysyła porcję batch żądań
+ * (jedno zgłoszenie wyniku, jedno pytanie o czołówkę, reszta pytań o miejsce losowego gracza), czekając
+ * na wszystkie odpowiedzi. Test zawsze uruchamia własnego demona na tymczasowym gnieździe i pliku, więc działający
+ * demon gry i jego plik wyników nie są dotykane.
+ * Wypisuje liczbę żądań na sekundę i percentyle czasu wymiany jednej porcji.
+ *
+ * @param clients Liczba jednoczesnych klientów.
+ * @param seconds Czas trwania testu (sekundy).
+ * @param batch Liczba żądań w jednej porcji (co najmniej 2).
+ * @return Kod wyjścia procesu (0 - żadna wymiana się nie powiodła).
+ */
+export int runScoreLoad(int clients = 200, float seconds = 5.0f, int batch = 16);
@@ -0,0 +1,186 @@
+﻿/**
+ * @file Difficulty.ixx
+ * @brief Moduł definiujący sterownik poziomu trudności.
+ *
+ * Krzywa trudności opisuje prędkość świata oraz zakres odstępów między przeszkodami
+ * w funkcji postępu gracza (ważona suma czasu gry i wyniku).
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+export module DifficultyModule;
+
+import ConfigModule;
+
+
+/**
+ * @struct DifficultyKey
+ * @brief Punkt kontrolny krzywej trudności.
+ */
+export struct DifficultyKey {
+    float progress; /**< Postęp, od którego obowiązuje punkt. */
+    float speed;    /**< Prędkość świata (piksele/s). */
+    float minGap;   /**< Minimalny odstęp między przeszkodami (piksele). */
+    float maxGap;   /**< Maksymalny odstęp między przeszkodami (piksele). */
+};
+
+/**
+ * @class DifficultyCurve
+ * @brief Krzywa trudności - posortowana lista punktów kontrolnych interpolowanych liniowo.
+ *
+ * Format pliku (jedna dyrektywa na linię, '#' rozpoczyna komentarz):
+ * @code
+ * time_weight 1.0
+ * score_weight 0.0
+ * key <progress> <speed> <minGap> <maxGap>
+ * @endcode
+ */
+export class DifficultyCurve {
+private:
+    /** @brief Punkty kontrolne posortowane rosnąco po postępie. */
+    std::vector<DifficultyKey> keys;
+    /** @brief Waga czasu gry (sekundy) w wyliczeniu postępu. */
+    float timeWeight{ 1.0f };
+    /** @brief Waga wyniku w wyliczeniu postępu. */
+    float scoreWeight{ 0.0f };
+
+public:
+    /**
+     * @brief Tworzy domyślną krzywą trudności.
+     */
+    DifficultyCurve();
+
+    /**
+     * @brief Wczytuje krzywą z pliku tekstowego.
+     * @param path Ścieżka do pliku.
+     * @return True, jeśli plik zawierał co najmniej jeden poprawny punkt; w przeciwnym razie krzywa się nie zmienia.
+     */
+    bool loadFromFile(const std::string& path);
+
+    /**
+     * @brief Dodaje punkt kontrolny, zachowując porządek i ograniczenia z Config.
+     * @param key Punkt kontrolny.
+     */
+    void addKey(DifficultyKey key);
+
+    /**
+     * @brief Usuwa wszystkie punkty kontrolne (np. przed zbudowaniem własnej krzywej).
+     */
+    void clear();
+
+    /**
+     * @brief Ustawia wagi postępu.
+     * @param time Waga czasu gry.
+     * @param score Waga wyniku.
+     */
+    void setWeights(float time, float score);
+
+    /**
+     * @brief Wylicza postęp na podstawie czasu i wyniku.
+     * @param elapsed Czas gry (sekundy).
+     * @param score Aktualny wynik.
+     * @return Postęp na osi krzywej.
+     */
+    float getProgress(float elapsed, float score) const;
+
+    /**
+     * @brief Wyznacza punkt krzywej, w którym świat przebył podaną drogę od początku gry.
+     *
+     * Wynik rośnie o czas gry, więc postęp przyrasta w stałym tempie (suma wag); prędkość jest liniowa
+     * w czasie na każdym odcinku krzywej, a droga - kwadratowa, więc punkt wychodzi wprost z równania.
+     * @param distance Droga od początku gry (piksele).
+     * @return Interpolowany punkt krzywej.
+     */
+    DifficultyKey sampleAtDistance(double distance) const;
+
+    /** @brief Zwraca punkty kontrolne. @return Stała referencja do wektora punktów. */
+    const std::vector<DifficultyKey>& getKeys() const { return keys; }
+};
+
+/**
+ * @struct DifficultyState
+ * @brief Stan sterownika trudności w zapisie planszy (krzywa pochodzi z konfiguracji i nie jest zapisywana).
+ */
+export struct DifficultyState {
+    std::uint32_t cursor{ 0 }; /**< Indeks bieżącego odcinka krzywej. */
+    float elapsed{ 0.0f };     /**< Czas od rozpoczęcia gry (sekundy). */
+    DifficultyKey current{};   /**< Bieżący punkt krzywej. */
+};
+
+/**
+ * @class Difficulty
+ * @brief Sterownik trudności - wylicza bieżącą prędkość świata i gęstość przeszkód.
+ *
+ * Postęp w trakcie gry tylko rośnie, więc kursor na krzywej przesuwa się wyłącznie do przodu,
+ * a koszt aktualizacji jest stały niezależnie od liczby punktów krzywej.
+ */
+export class Difficulty {
+private:
+    /** @brief Krzywa trudności (niezmienna, współdzielona przez sterowniki z tą samą krzywą). */
+    std::shared_ptr<const DifficultyCurve> curve;
+    /** @brief Indeks punktu, od którego zaczyna się bieżący odcinek krzywej. */
+    std::size_t cursor{ 0 };
+    /** @brief Czas od rozpoczęcia gry (sekundy). */
+    float elapsed{ 0.0f };
+    /** @brief Bieżący stan (interpolowany punkt krzywej). */
+    DifficultyKey current{ 0.0f, Config::BASE_WORLD_SPEED, Config::MIN_OBSTACLE_DISTANCE, Config::MAX_OBSTACLE_DISTANCE };
+
+public:
+    /**
+     * @brief Tworzy sterownik z krzywą domyślną lub wczytaną z Config::DIFFICULTY_CURVE_FILE.
+     *
+     * Plik jest czytany raz na proces, przy pierwszym sterowniku; kolejne (np. tysiące kopii planszy) dzielą krzywą.
+     */
+    Difficulty();
+
+    /**
+     * @brief Zastępuje krzywą trudności i resetuje stan.
+     * @param newCurve Nowa krzywa.
+     */
+    void setCurve(const DifficultyCurve& newCurve);
+
+    /**
+     * @brief Przejmuje krzywą innego sterownika bez kopiowania i bez zmiany stanu (np. dla kopii planszy).
+     * @param other Sterownik z krzywą.
+     */
+    void shareCurve(const Difficulty& other) { curve = other.curve; }
+
+    /** @brief Zwraca krzywą trudności (np. dla generatora trasy). @return Współdzielona krzywa. */
+    const std::shared_ptr<const DifficultyCurve>& getCurve() const { return curve; }
+
+    /**
+     * @brief Przywraca stan z początku gry.
+     */
+    void reset();
+
+    /**
+     * @brief Aktualizuje trudność.
+     * @param deltaTime Czas od ostatniej klatki (w sekundach).
+     * @param score Aktualny wynik gracza.
+     */
+    void update(float deltaTime, float score);
+
+    /** @brief Zwraca stan do zapisu planszy. @return Stan. */
+    DifficultyState getState() const { return { static_cast<std::uint32_t>(cursor), elapsed, current }; }
+
+    /**
+     * @brief Przywraca zapisany stan (kursor jest przycinany do bieżącej krzywej).
+     * @param state Stan.
+     * @return False (bez zmiany stanu), jeśli czas lub punkt krzywej jest ujemny albo nieskończony,
+     *         albo prędkość przekracza Config::MAX_WORLD_SPEED.
+     */
+    bool setState(const DifficultyState& state);
+
+    /** @brief Zwraca prędkość świata. @return Prędkość w pikselach na sekundę. */
+    float getWorldSpeed() const { return current.speed; }
+    /** @brief Zwraca minimalny odstęp między przeszkodami. @return Odstęp w pikselach. */
+    float getMinGap() const { return current.minGap; }
+    /** @brief Zwraca maksymalny odstęp między przeszkodami. @return Odstęp w pikselach. */
+    float getMaxGap() const { return current.maxGap; }
+    /** @brief Zwraca bieżący postęp. @return Postęp na osi krzywej. */
+    float getProgress() const { return current.progress; }
+};
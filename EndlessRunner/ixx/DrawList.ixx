@@ -0,0 +1,100 @@
+﻿/**
+ * @file DrawList.ixx
+ * @brief Moduł listy poleceń rysowania: symulacja zapisuje, co narysować, a etap renderowania wysyła to do raylib.
+ *
+ * Polecenia są prostymi strukturami (uchwyt tekstury, prostokąt źródłowy i docelowy, kolor), więc listę
+ * można zbudować w dowolnym wątku bez dostępu do kontekstu graficznego. Wywołania raylib/rlgl wykonuje
+ * dopiero submit() w wątku okna.
+ */
+
+module;
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+export module DrawListModule;
+
+
+/**
+ * @enum DrawKind
+ * @brief Rodzaj polecenia rysowania.
+ */
+export enum class DrawKind : std::uint8_t {
+    SPRITE, /**< Fragment tekstury w prostokącie docelowym. */
+    TEXT    /**< Tekst domyślną czcionką raylib. */
+};
+
+/**
+ * @struct DrawCommand
+ * @brief Jedno polecenie rysowania.
+ *
+ * Dla tekstu dest.x i dest.y to pozycja, dest.height to rozmiar czcionki, a textOffset wskazuje
+ * początek napisu w buforze tekstów listy.
+ */
+export struct DrawCommand {
+    /** @brief Tekstura (kopiowany uchwyt, nie właściciel). */
+    Texture2D texture{};
+    /** @brief Fragment tekstury (w pikselach tekstury). */
+    Rectangle source{};
+    /** @brief Prostokąt docelowy (we współrzędnych świata). */
+    Rectangle dest{};
+    /** @brief Kolor mnożony przez teksturę. */
+    Color tint{ 255, 255, 255, 255 };
+    /** @brief Rodzaj polecenia. */
+    DrawKind kind{ DrawKind::SPRITE };
+    /** @brief Początek napisu w buforze tekstów (tylko TEXT). */
+    std::uint32_t textOffset{ 0 };
+};
+
+/**
+ * @class DrawList
+ * @brief Lista poleceń rysowania jednej klatki.
+ *
+ * Kolejne polecenia z tą samą teksturą są wysyłane jedną paczką quadów (jedno rlSetTexture i jedno rlBegin),
+ * tak jak wcześniej robił to tylko system cząsteczek.
+ */
+export class DrawList {
+private:
+    /** @brief Polecenia w kolejności rysowania. */
+    std::vector<DrawCommand> commands;
+    /** @brief Napisy poleceń TEXT zakończone zerem. */
+    std::string texts;
+
+public:
+    /**
+     * @brief Usuwa polecenia, zachowując zaalokowaną pamięć.
+     */
+    void clear();
+
+    /**
+     * @brief Dodaje fragment tekstury.
+     * @param texture Tekstura.
+     * @param source Fragment tekstury.
+     * @param dest Prostokąt docelowy.
+     * @param tint Kolor mnożony przez teksturę.
+     */
+    void sprite(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint = Color{ 255, 255, 255, 255 });
+
+    /**
+     * @brief Dodaje napis.
+     * @param value Treść.
+     * @param x Pozycja X.
+     * @param y Pozycja Y.
+     * @param fontSize Rozmiar czcionki.
+     * @param tint Kolor.
+     */
+    void text(std::string_view value, float x, float y, int fontSize, Color tint);
+
+    /** @brief Zwraca liczbę poleceń. @return Liczba poleceń. */
+    std::size_t size() const { return commands.size(); }
+
+    /** @brief Zwraca polecenia (np. do testów). @return Stała referencja do poleceń. */
+    const std::vector<DrawCommand>& getCommands() const { return commands; }
+
+    /**
+     * @brief Wysyła polecenia do raylib (wyłącznie wątek okna, między BeginDrawing a EndDrawing).
+     */
+    void submit() const;
+};
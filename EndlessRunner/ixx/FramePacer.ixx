@@ -0,0 +1,182 @@
+﻿/**
+ * @file FramePacer.ixx
+ * @brief Moduł odpowiedzialny za tempo klatek (vsync, limit z uśpieniem, bez limitu) i oszczędzanie CPU w menu.
+ *
+ * Zastępuje wbudowane oczekiwanie raylib (SetTargetFPS), które zajmuje cały rdzeń aktywnym czekaniem.
+ * Każda pętla ekranu wywołuje endFrame() zaraz po EndDrawing().
+ */
+
+module;
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+export module FramePacerModule;
+
+import ConfigModule;
+
+
+/**
+ * @enum PacingMode
+ * @brief Sposób ograniczania liczby klatek.
+ */
+export enum class PacingMode {
+    VSYNC,    /**< Synchronizacja z odświeżaniem monitora. */
+    CAPPED,   /**< Limit Config::TARGET_FPS: uśpienie, a na końcu krótkie aktywne czekanie. */
+    UNCAPPED  /**< Bez ograniczenia (pomiary wydajności). */
+};
+
+/**
+ * @enum FrameKind
+ * @brief Rodzaj ekranu, który zakończył klatkę.
+ */
+export enum class FrameKind {
+    GAMEPLAY, /**< Rozgrywka i animowane ekrany - zawsze pełne tempo. */
+    MENU      /**< Menu - po chwili bez wejścia tempo spada do Config::IDLE_FPS. */
+};
+
+/**
+ * @struct FrameStats
+ * @brief Statystyki klatek zebrane dla jednego trybu.
+ */
+export struct FrameStats {
+    std::uint64_t frames{ 0 };   /**< Liczba klatek. */
+    double averageMs{ 0.0 };     /**< Średni czas klatki (ms). */
+    double jitterMs{ 0.0 };      /**< Odchylenie standardowe czasu klatki (ms). */
+    double maxMs{ 0.0 };         /**< Najdłuższa klatka (ms). */
+    double cpuPercent{ 0.0 };    /**< Zużycie CPU przez proces względem czasu rzeczywistego (% jednego rdzenia). */
+};
+
+/**
+ * @class FramePacer
+ * @brief Utrzymuje tempo klatek i zbiera statystyki dla każdego trybu.
+ */
+export class FramePacer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Accumulator
+     * @brief Sumy potrzebne do wyliczenia FrameStats.
+     */
+    struct Accumulator {
+        std::uint64_t frames{ 0 };
+        double sum{ 0.0 };
+        double sumSquares{ 0.0 };
+        double max{ 0.0 };
+        double cpuSeconds{ 0.0 };
+    };
+
+    /** @brief Wybrany tryb. */
+    PacingMode mode{ PacingMode::CAPPED };
+    /** @brief Flaga wskazująca, że tryb trzeba zastosować do okna (vsync). */
+    bool modeDirty{ true };
+    /** @brief Chwila, do której ma trwać bieżąca klatka. */
+    Clock::time_point deadline{};
+    /** @brief Koniec poprzedniej klatki. */
+    Clock::time_point lastFrameEnd{};
+    /** @brief Czas procesora na końcu poprzedniej klatki (sekundy). */
+    double lastCpuSeconds{ 0.0 };
+    /** @brief Zapas przed terminem, w którym kończy się uśpienie (dopasowywany do dokładności zegara systemu). */
+    double spinMargin{ Config::PACER_SPIN_MARGIN };
+    /** @brief Czas bez wejścia użytkownika w menu (sekundy). */
+    float idleTime{ 0.0f };
+    /** @brief Flaga trybu oszczędnego w poprzedniej klatce. */
+    bool idle{ false };
+
+    /** @brief Statystyki dla każdego trybu (indeks = PacingMode). */
+    std::array<Accumulator, 3> accumulators{};
+    /** @brief Statystyki klatek w trybie oszczędnym menu. */
+    Accumulator idleAccumulator{};
+
+public:
+    /**
+     * @brief Ustawia tryb ograniczania klatek.
+     * @param newMode Nowy tryb.
+     */
+    void setMode(PacingMode newMode);
+
+    /** @brief Zwraca bieżący tryb. @return Tryb ograniczania klatek. */
+    PacingMode getMode() const { return mode; }
+
+    /** @brief Sprawdza, czy menu jest w trybie oszczędnym. @return True, jeśli ostatnia klatka była zwolniona. */
+    bool isIdle() const { return idle; }
+
+    /**
+     * @brief Kończy klatkę: czeka do terminu zgodnie z trybem i zapisuje statystyki.
+     * @param kind Rodzaj ekranu.
+     */
+    void endFrame(FrameKind kind = FrameKind::GAMEPLAY);
+
+    /**
+     * @brief Zwraca statystyki trybu.
+     * @param statsMode Tryb.
+     * @return Statystyki klatek.
+     */
+    FrameStats getStats(PacingMode statsMode) const;
+
+    /**
+     * @brief Zwraca statystyki klatek w trybie oszczędnym menu.
+     * @return Statystyki klatek.
+     */
+    FrameStats getIdleStats() const;
+
+    /**
+     * @brief Zeruje wszystkie statystyki.
+     */
+    void resetStats();
+
+    /**
+     * @brief Wypisuje statystyki wszystkich trybów na konsolę.
+     */
+    void printReport() const;
+
+private:
+    /**
+     * @brief Sprawdza, czy w tej klatce użytkownik użył klawiatury, myszy lub pada.
+     * @return True, jeśli wykryto wejście.
+     */
+    bool hasInput() const;
+
+    /**
+     * @brief Czeka do podanej chwili: śpi, a ostatnie spinMargin sekund czeka aktywnie.
+     * @param target Chwila końca oczekiwania.
+     */
+    void waitUntil(Clock::time_point target);
+
+    /**
+     * @brief Dodaje klatkę do statystyk.
+     * @param accumulator Statystyki do uzupełnienia.
+     * @param frameSeconds Czas klatki.
+     * @param cpuSeconds Czas procesora w klatce.
+     */
+    static void record(Accumulator& accumulator, double frameSeconds, double cpuSeconds);
+
+    /**
+     * @brief Wylicza statystyki z sum.
+     * @param accumulator Sumy.
+     * @return Statystyki klatek.
+     */
+    static FrameStats summarize(const Accumulator& accumulator);
+};
+
+/**
+ * @brief Zwraca wspólny dla całego procesu pacer klatek.
+ * @return Referencja do pacera.
+ */
+export FramePacer& framePacer();
+
+/**
+ * @brief Zamienia nazwę trybu (vsync, capped, uncapped) na wartość wyliczenia.
+ * @param name Nazwa trybu.
+ * @param out Miejsce na tryb.
+ * @return True, jeśli nazwa jest poprawna.
+ */
+export bool parsePacingMode(std::string_view name, PacingMode& out);
+
+/**
+ * @brief Zwraca nazwę trybu.
+ * @param pacingMode Tryb.
+ * @return Nazwa trybu.
+ */
+export const char* pacingModeName(PacingMode pacingMode);
@@ -0,0 +1,136 @@
+﻿/**
+ * @file FramePipeline.ixx
+ * @brief Moduł potoku klatki: symulacja klatki N+1 w osobnym wątku w czasie wysyłania klatki N do GPU.
+ *
+ * Symulacja zapisuje klatkę do jednej z dwóch list poleceń rysowania, a wątek okna wysyła drugą, gotową
+ * w poprzedniej klatce. Wątki przekazują sobie klatkę dwoma licznikami atomowymi (wait/notify), bez muteksów.
+ * Obraz jest przez to opóźniony o jedną klatkę względem symulacji.
+ */
+
+module;
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <thread>
+export module FramePipelineModule;
+
+import DrawListModule;
+
+
+/**
+ * @enum PipelineMode
+ * @brief Sposób wykonywania symulacji względem rysowania.
+ */
+export enum class PipelineMode {
+    SERIAL,  /**< Symulacja i rysowanie po kolei w wątku okna. */
+    THREADED /**< Symulacja w osobnym wątku, równolegle z wysyłaniem poprzedniej klatki. */
+};
+
+/**
+ * @class FramePipeline
+ * @brief Podwójnie buforowane listy poleceń rysowania z symulacją w wątku roboczym.
+ *
+ * Kolejność w wątku okna: sync() (koniec symulacji poprzedniej klatki), zmiany stanu gry i wejście,
+ * kick() (start symulacji), getPresented()->submit(). Między kick() a sync() wątek okna nie może dotykać
+ * stanu, który czyta lub zmienia symulacja.
+ */
+export class FramePipeline {
+public:
+    /** @brief Symulacja jednej klatki zapisująca polecenia rysowania do pustej listy. */
+    using Simulation = std::function<void(DrawList&)>;
+
+private:
+    /** @brief Dwie listy: jedna zapisywana przez symulację, druga wysyłana przez wątek okna. */
+    std::array<DrawList, 2> lists;
+    /** @brief Symulacja klatki. */
+    Simulation simulate;
+    /** @brief Tryb pracy. */
+    PipelineMode mode{ PipelineMode::SERIAL };
+    /** @brief Wątek symulacji (tylko THREADED). */
+    std::thread worker;
+    /** @brief Numer ostatniej zleconej klatki. */
+    std::atomic<std::uint32_t> requested{ 0 };
+    /** @brief Numer ostatniej ukończonej klatki. */
+    std::atomic<std::uint32_t> completed{ 0 };
+    /** @brief Flaga zakończenia pracy wątku. */
+    std::atomic<bool> stopping{ false };
+    /** @brief Lista do wysłania w bieżącej klatce (nullptr, dopóki żadna nie jest gotowa). */
+    const DrawList* presented{ nullptr };
+    /** @brief Czas symulacji ostatniej ukończonej klatki (czytany po sync()). */
+    float simulationTime{ 0.0f };
+
+    /** @brief Pętla wątku symulacji. */
+    void run();
+    /** @brief Symuluje klatkę do listy i mierzy czas. @param list Lista klatki. */
+    void simulateInto(DrawList& list);
+
+public:
+    FramePipeline() = default;
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    /**
+     * @brief Zatrzymuje poprzednią symulację i zaczyna nową.
+     * @param pipelineMode Tryb pracy.
+     * @param simulation Symulacja klatki (w trybie THREADED wywoływana w wątku roboczym).
+     */
+    void start(PipelineMode pipelineMode, Simulation simulation);
+
+    /**
+     * @brief Czeka na koniec bieżącej klatki i zatrzymuje wątek symulacji.
+     */
+    void stop();
+
+    /**
+     * @brief Zleca symulację kolejnej klatki (w trybie SERIAL wykonuje ją od razu).
+     */
+    void kick();
+
+    /**
+     * @brief Czeka, aż symulacja zleconej klatki się skończy.
+     */
+    void sync();
+
+    /**
+     * @brief Zwraca listę do wysłania w tej klatce: w trybie SERIAL właśnie zasymulowaną, w THREADED poprzednią.
+     * @return Wskaźnik do listy albo nullptr przed pierwszą ukończoną klatką.
+     */
+    const DrawList* getPresented() const { return presented; }
+
+    /** @brief Zwraca tryb pracy. @return Tryb. */
+    PipelineMode getMode() const { return mode; }
+
+    /** @brief Zwraca czas symulacji ostatniej ukończonej klatki (po sync()). @return Czas w sekundach. */
+    float getSimulationTime() const { return simulationTime; }
+};
+
+/**
+ * @brief Ustawia tryb potoku dla kolejnych rozgrywek.
+ * @param mode Tryb.
+ */
+export void setPipelineMode(PipelineMode mode);
+
+/**
+ * @brief Zwraca tryb potoku dla kolejnych rozgrywek.
+ * @return Tryb (domyślnie THREADED, jeśli procesor ma więcej niż jeden rdzeń).
+ */
+export PipelineMode getPipelineMode();
+
+/**
+ * @brief Zamienia nazwę trybu (serial, threaded) na wartość wyliczenia.
+ * @param name Nazwa trybu.
+ * @param out Miejsce na wynik.
+ * @return True, jeśli nazwa jest poprawna.
+ */
+export bool parsePipelineMode(std::string_view name, PipelineMode& out);
+
+/**
+ * @brief Zwraca nazwę trybu.
+ * @param mode Tryb.
+ * @return Nazwa.
+ */
+export const char* pipelineModeName(PipelineMode mode);
@@ -0,0 +1,258 @@
+﻿/**
+ * @file Ghost.ixx
+ * @brief Moduł duchów: zapis najlepszego przebiegu gracza i jego odtwarzanie jako półprzezroczystej postaci.
+ *
+ * Przebieg to ziarno generatora przeszkód, wysokość gracza nad ziemią próbkowana co Config::GHOST_SAMPLE_INTERVAL
+ * i chwile skoków. Wysokość jest kwantyzowana i kodowana jako różnica względem przewidywania (ruch po paraboli
+ * w powietrzu, spoczynek na ziemi); różnice trafiają do strumienia varint (zigzag), a serie zer - jednym wpisem.
+ * Bieg po ziemi i równy lot kosztują więc prawie nic, a minuta gry zajmuje kilkaset bajtów.
+ * Każdy gracz ma jeden plik z najlepszym przebiegiem, więc liczba rozegranych gier nie wpływa na rozmiar danych.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+export module GhostModule;
+
+import ConfigModule;
+
+
+/** @brief Wersja formatu pliku ducha. */
+export inline constexpr std::uint32_t GHOST_VERSION = 1;
+
+/**
+ * @struct GhostHeader
+ * @brief Nagłówek pliku ducha; za nim leży zakodowana trajektoria, a potem zakodowane skoki.
+ */
+export struct GhostHeader {
+    char magic[4];                 /**< Sygnatura "DRGH". */
+    std::uint32_t version;         /**< Wersja formatu (GHOST_VERSION). */
+    std::uint32_t seed;            /**< Ziarno generatora przeszkód. */
+    std::int32_t score;            /**< Wynik przebiegu. */
+    std::uint32_t sampleCount;     /**< Liczba próbek wysokości. */
+    std::uint32_t jumpCount;       /**< Liczba skoków. */
+    std::uint32_t trajectoryBytes; /**< Rozmiar zakodowanej trajektorii. */
+    std::uint32_t jumpBytes;       /**< Rozmiar zakodowanych skoków. */
+    float sampleInterval;          /**< Odstęp próbek (sekundy). */
+    float heightStep;              /**< Krok kwantyzacji wysokości (piksele). */
+    std::int32_t gravityStep;      /**< Przyrost prędkości opadania na próbkę w powietrzu (w krokach wysokości). */
+    std::uint32_t reserved;        /**< Zarezerwowane (0). */
+};
+
+/**
+ * @class GhostRun
+ * @brief Zakodowany przebieg: nagłówek i dane w pamięci.
+ */
+export class GhostRun {
+private:
+    /** @brief Nagłówek. */
+    GhostHeader header{};
+    /** @brief Trajektoria, a za nią skoki. */
+    std::vector<std::uint8_t> data;
+
+public:
+    GhostRun() = default;
+
+    /**
+     * @brief Tworzy przebieg z gotowych danych.
+     * @param runHeader Nagłówek (rozmiary muszą zgadzać się z danymi).
+     * @param encoded Trajektoria, a za nią skoki.
+     */
+    GhostRun(const GhostHeader& runHeader, std::vector<std::uint8_t> encoded);
+
+    /**
+     * @brief Wczytuje przebieg z pliku (brak pliku nie jest zgłaszany - nowy gracz nie ma jeszcze ducha).
+     * @param path Ścieżka do pliku.
+     * @return True, jeśli plik istnieje i ma poprawny format.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Zapisuje przebieg do pliku tymczasowego i podmienia nim plik docelowy.
+     * @param path Ścieżka do pliku (brakujący katalog jest tworzony).
+     * @return True, jeśli zapis się powiódł.
+     */
+    bool save(const std::string& path) const;
+
+    /** @brief Sprawdza, czy przebieg zawiera próbki. @return True, jeśli można go odtworzyć. */
+    bool isEmpty() const { return header.sampleCount == 0; }
+    /** @brief Zwraca nagłówek. @return Stała referencja do nagłówka. */
+    const GhostHeader& getHeader() const { return header; }
+    /** @brief Zwraca zakodowane dane (trajektoria, a za nią skoki). @return Stała referencja do danych. */
+    const std::vector<std::uint8_t>& getData() const { return data; }
+    /** @brief Zwraca ziarno generatora przeszkód. @return Ziarno. */
+    std::uint32_t getSeed() const { return header.seed; }
+    /** @brief Zwraca wynik przebiegu. @return Wynik. */
+    int getScore() const { return header.score; }
+    /** @brief Zwraca czas trwania przebiegu. @return Czas w sekundach. */
+    float getDuration() const { return header.sampleCount * header.sampleInterval; }
+    /** @brief Zwraca rozmiar zakodowanych danych z nagłówkiem. @return Rozmiar w bajtach. */
+    std::size_t getEncodedSize() const { return sizeof(GhostHeader) + data.size(); }
+    /** @brief Zwraca rozmiar tych samych danych zapisanych wprost (float na próbkę i na skok). @return Rozmiar w bajtach. */
+    std::size_t getRawSize() const { return sizeof(GhostHeader) + (static_cast<std::size_t>(header.sampleCount) + header.jumpCount) * sizeof(float); }
+};
+
+/**
+ * @class GhostRecorder
+ * @brief Koduje przebieg w trakcie gry (wątek symulacji).
+ */
+export class GhostRecorder {
+private:
+    /** @brief Zakodowana trajektoria. */
+    std::vector<std::uint8_t> trajectory;
+    /** @brief Zakodowane skoki (różnice czasu w milisekundach). */
+    std::vector<std::uint8_t> jumps;
+    /** @brief Ziarno generatora przeszkód. */
+    std::uint32_t seed{ 0 };
+    /** @brief Czas od początku przebiegu (sekundy). */
+    float elapsed{ 0.f };
+    /** @brief Chwila następnej próbki (sekundy). */
+    float nextSample{ 0.f };
+    /** @brief Wysokość z poprzedniego wywołania record() (piksele). */
+    float lastHeight{ 0.f };
+    /** @brief Ostatnia skwantyzowana próbka. */
+    std::int32_t previous{ 0 };
+    /** @brief Przedostatnia skwantyzowana próbka. */
+    std::int32_t beforePrevious{ 0 };
+    /** @brief Liczba zer czekających na zapis jako seria. */
+    std::uint32_t zeroRun{ 0 };
+    /** @brief Liczba zapisanych próbek. */
+    std::uint32_t samples{ 0 };
+    /** @brief Liczba zapisanych skoków. */
+    std::uint32_t jumpCount{ 0 };
+    /** @brief Chwila ostatniego zapisanego skoku (milisekundy). */
+    std::uint32_t lastJumpMs{ 0 };
+
+    /** @brief Koduje jedną próbkę wysokości. @param height Wysokość nad ziemią (piksele). */
+    void pushSample(float height);
+    /** @brief Zapisuje oczekującą serię zer. */
+    void flushRun();
+
+public:
+    /**
+     * @brief Zaczyna nowy przebieg (zachowuje zaalokowaną pamięć).
+     * @param courseSeed Ziarno generatora przeszkód tego przebiegu.
+     */
+    void begin(std::uint32_t courseSeed);
+
+    /**
+     * @brief Dopisuje krok symulacji.
+     * @param deltaTime Długość kroku (sekundy).
+     * @param height Wysokość gracza nad ziemią na końcu kroku (piksele).
+     * @param totalJumps Liczba skoków od początku przebiegu.
+     */
+    void record(float deltaTime, float height, std::uint32_t totalJumps);
+
+    /**
+     * @brief Kończy przebieg i zwraca go w postaci gotowej do zapisu.
+     * @param score Wynik przebiegu.
+     * @return Zakodowany przebieg.
+     */
+    GhostRun finish(int score);
+
+    /** @brief Zwraca liczbę bajtów zakodowanych do tej pory. @return Rozmiar w bajtach. */
+    std::size_t getEncodedBytes() const { return trajectory.size() + jumps.size(); }
+};
+
+/**
+ * @struct GhostFrame
+ * @brief Stan ducha po kroku odtwarzania.
+ */
+export struct GhostFrame {
+    /** @brief Wysokość nad ziemią (piksele). */
+    float height{ 0.f };
+    /** @brief Liczba skoków rozpoczętych w tym kroku. */
+    std::uint32_t jumps{ 0 };
+    /** @brief True, dopóki przebieg się nie skończył. */
+    bool active{ false };
+};
+
+/**
+ * @class GhostPlayer
+ * @brief Odtwarza przebieg, dekodując go przyrostowo (bez alokacji w trakcie gry).
+ *
+ * Odtwarzacz czyta dane przebiegu przez wskaźnik - przebieg musi istnieć, dopóki trwa odtwarzanie.
+ */
+export class GhostPlayer {
+private:
+    /** @brief Odtwarzany przebieg (nullptr - brak). */
+    const GhostRun* run{ nullptr };
+    /** @brief Pozycja w trajektorii. */
+    const std::uint8_t* cursor{ nullptr };
+    /** @brief Koniec trajektorii. */
+    const std::uint8_t* trajectoryEnd{ nullptr };
+    /** @brief Pozycja w skokach. */
+    const std::uint8_t* jumpCursor{ nullptr };
+    /** @brief Koniec skoków. */
+    const std::uint8_t* jumpEnd{ nullptr };
+    /** @brief Ostatnia zdekodowana próbka. */
+    std::int32_t previous{ 0 };
+    /** @brief Przedostatnia zdekodowana próbka. */
+    std::int32_t beforePrevious{ 0 };
+    /** @brief Pozostała długość bieżącej serii zer. */
+    std::uint32_t zeroRun{ 0 };
+    /** @brief Liczba zdekodowanych próbek. */
+    std::uint32_t decoded{ 0 };
+    /** @brief Czas odtwarzania (sekundy). */
+    float elapsed{ 0.f };
+    /** @brief Chwila następnego skoku (milisekundy). */
+    std::uint32_t nextJumpMs{ 0 };
+    /** @brief Liczba skoków, które zostały do odtworzenia. */
+    std::uint32_t jumpsLeft{ 0 };
+
+    /** @brief Dekoduje kolejną próbkę. @return False na końcu lub przy uszkodzonych danych. */
+    bool decodeNext();
+    /** @brief Czyta chwilę kolejnego skoku. */
+    void readNextJump();
+
+public:
+    /**
+     * @brief Zaczyna odtwarzanie od początku.
+     * @param ghost Przebieg (musi istnieć do końca odtwarzania).
+     */
+    void start(const GhostRun& ghost);
+
+    /**
+     * @brief Kończy odtwarzanie.
+     */
+    void stop();
+
+    /** @brief Sprawdza, czy duch jest odtwarzany. @return True w trakcie odtwarzania. */
+    bool isActive() const { return run != nullptr; }
+
+    /** @brief Zwraca czas odtwarzania. @return Czas w sekundach. */
+    float getTime() const { return elapsed; }
+
+    /**
+     * @brief Przesuwa odtwarzanie o krok symulacji.
+     * @param deltaTime Długość kroku (sekundy).
+     * @return Stan ducha (wysokość interpolowana między próbkami).
+     */
+    GhostFrame advance(float deltaTime);
+};
+
+/**
+ * @brief Zwraca ścieżkę pliku ducha gracza.
+ * @param username Nazwa gracza (znaki spoza liter, cyfr, '-' i '_' są zamieniane na '_').
+ * @return Ścieżka w Config::GHOST_DIRECTORY.
+ */
+export std::string ghostPath(const std::string& username);
+
+/**
+ * @brief Odczytuje sam nagłówek pliku ducha (np. żeby porównać wynik bez wczytywania trajektorii).
+ * @param path Ścieżka do pliku.
+ * @param out Miejsce na nagłówek.
+ * @return True, jeśli plik istnieje i ma poprawny nagłówek.
+ */
+export bool readGhostHeader(const std::string& path, GhostHeader& out);
+
+/**
+ * @brief Włącza lub wyłącza duchy (nagrywanie, odtwarzanie i powtarzanie trasy najlepszego przebiegu).
+ * @param enabled Nowy stan.
+ */
+export void setGhostsEnabled(bool enabled);
+
+/** @brief Sprawdza, czy duchy są włączone. @return True domyślnie. */
+export bool ghostsEnabled();
@@ -0,0 +1,299 @@
+﻿/**
+ * @file Input.ixx
+ * @brief Moduł warstwy wejścia: akcje z przypisanymi klawiszami i przyciskami pada oraz kolejka zdarzeń z czasem.
+ *
+ * raylib odczytuje wejście tylko w EndDrawing(), więc wciśnięcie jest widoczne dopiero na granicy klatki.
+ * W trakcie rozgrywki InputSystem dodatkowo próbkuje klawiaturę w czasie uśpienia pacera (co
+ * Config::INPUT_SAMPLE_INTERVAL) i zapisuje każde wciśnięcie z dokładnym czasem, a symulacja wykonuje skok
+ * w tej chwili wewnątrz kroku. Zdarzenia, których nie da się tak złapać (pad, inne systemy, VSYNC),
+ * trafiają do kolejki z czasem początku klatki; żadne wciśnięcie nie jest gubione ani liczone dwa razy.
+ */
+
+module;
+#include "raylib.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+export module InputModule;
+
+import ConfigModule;
+
+
+/**
+ * @enum InputAction
+ * @brief Akcja gry, do której przypisuje się klawisze i przyciski.
+ */
+export enum class InputAction : std::uint8_t {
+    JUMP,    /**< Skok (pierwszy gracz). */
+    CONFIRM, /**< Zatwierdzenie (np. powrót do menu po przegranej). */
+    BACK,    /**< Powrót do poprzedniego ekranu. */
+    JUMP_2,  /**< Skok drugiego gracza na wspólnej klawiaturze. */
+    JUMP_3,  /**< Skok trzeciego gracza. */
+    JUMP_4,  /**< Skok czwartego gracza. */
+    COUNT    /**< Liczba akcji. */
+};
+
+/**
+ * @enum InputDevice
+ * @brief Urządzenie, z którego pochodzi przypisanie.
+ */
+export enum class InputDevice : std::uint8_t {
+    KEYBOARD, /**< Klawisz (KeyboardKey raylib). */
+    GAMEPAD   /**< Przycisk pierwszego pada (GamepadButton raylib). */
+};
+
+/**
+ * @struct InputBinding
+ * @brief Przypisanie klawisza albo przycisku do akcji.
+ */
+export struct InputBinding {
+    /** @brief Urządzenie. */
+    InputDevice device{ InputDevice::KEYBOARD };
+    /** @brief Kod klawisza albo przycisku raylib. */
+    int code{ 0 };
+};
+
+/**
+ * @struct InputEvent
+ * @brief Wciśnięcie przypisanego klawisza lub przycisku.
+ */
+export struct InputEvent {
+    /** @brief Akcja. */
+    InputAction action{ InputAction::JUMP };
+    /** @brief Chwila wciśnięcia (sekundy, InputSystem::now()). */
+    double time{ 0.0 };
+    /** @brief True, jeśli czas pochodzi z próbkowania między klatkami; false - z granicy klatki. */
+    bool precise{ false };
+};
+
+/**
+ * @struct InputLatencyStats
+ * @brief Statystyki opóźnienia od wciśnięcia do symulacji.
+ *
+ * Czasy liczone są tylko ze zdarzeń z dokładnym czasem - zdarzenie z granicy klatki ma czas beginFrame(),
+ * więc jego opóźnienie wychodziłoby bliskie zeru i zaniżało średnią.
+ */
+export struct InputLatencyStats {
+    std::uint64_t events{ 0 };        /**< Liczba zdarzeń przekazanych symulacji. */
+    std::uint64_t precise{ 0 };       /**< W tym zdarzenia z dokładnym czasem (tylko one wchodzą do czasów poniżej). */
+    double averageMs{ 0.0 };          /**< Średni czas od wciśnięcia do startu symulacji klatki (ms). */
+    double maxMs{ 0.0 };              /**< Najdłuższy czas od wciśnięcia do startu symulacji klatki (ms). */
+    double averageCorrectionMs{ 0.0 };/**< Średnie przesunięcie skoku względem początku kroku symulacji (ms). */
+};
+
+/**
+ * @class InputSystem
+ * @brief Przypisania akcji i kolejka zdarzeń wejścia (wyłącznie wątek okna).
+ */
+export class InputSystem {
+private:
+    /** @brief Największa liczba przypisań jednej akcji. */
+    static constexpr std::size_t MAX_BINDINGS = 4;
+    /** @brief Liczba obsługiwanych kodów klawiszy (KeyboardKey < 512). */
+    static constexpr std::size_t KEY_CODES = 512;
+    /** @brief Pojemność kolejki. */
+    static constexpr std::uint32_t QUEUE_SIZE = Config::INPUT_QUEUE_CAPACITY;
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "INPUT_QUEUE_CAPACITY must be a power of two");
+
+    /**
+     * @struct KeyState
+     * @brief Stan klawisza przypisanego do co najmniej jednej akcji.
+     */
+    struct KeyState {
+        /** @brief Ostatni odczytany stan (próbkowanie). */
+        bool down{ false };
+        /** @brief Liczba wciśnięć złapanych przez próbkowanie, których raylib jeszcze nie zgłosił. */
+        std::uint32_t unmatched{ 0 };
+        /** @brief Numer klatki ostatniego takiego wciśnięcia. */
+        std::uint64_t unmatchedFrame{ 0 };
+    };
+
+    /** @brief Przypisania akcji (indeks = InputAction). */
+    std::array<std::vector<InputBinding>, static_cast<std::size_t>(InputAction::COUNT)> bindings;
+    /** @brief Kody klawiszy przypisanych do akcji, bez powtórzeń. */
+    std::vector<int> boundKeys;
+    /** @brief Stan klawiszy (indeks = kod klawisza). */
+    std::array<KeyState, KEY_CODES> keys{};
+    /** @brief Kolejka zdarzeń. */
+    std::array<InputEvent, QUEUE_SIZE> queue{};
+    /** @brief Indeks zapisu. */
+    std::uint32_t queueHead{ 0 };
+    /** @brief Indeks odczytu. */
+    std::uint32_t queueTail{ 0 };
+    /** @brief Liczba zdarzeń odrzuconych przy pełnej kolejce. */
+    std::uint64_t dropped{ 0 };
+    /** @brief Flaga zbierania zdarzeń (tylko w trakcie rozgrywki). */
+    bool capturing{ false };
+    /** @brief Numer klatki (beginFrame()). */
+    std::uint64_t frame{ 0 };
+
+    /** @brief Suma czasów od wciśnięcia do symulacji zdarzeń z dokładnym czasem (sekundy). */
+    double latencySum{ 0.0 };
+    /** @brief Najdłuższy czas od wciśnięcia do symulacji zdarzenia z dokładnym czasem (sekundy). */
+    double latencyMax{ 0.0 };
+    /** @brief Suma przesunięć zdarzeń z dokładnym czasem względem granicy klatki (sekundy). */
+    double correctionSum{ 0.0 };
+    /** @brief Liczba zdarzeń w statystykach. */
+    std::uint64_t latencyEvents{ 0 };
+    /** @brief Liczba zdarzeń z dokładnym czasem w statystykach. */
+    std::uint64_t latencyPrecise{ 0 };
+
+    /** @brief Dodaje zdarzenia dla wszystkich akcji przypisanych do klawisza. */
+    void pushKey(int key, double time, bool precise);
+    /** @brief Dodaje zdarzenie do kolejki. */
+    void push(const InputEvent& event);
+    /** @brief Sprawdza, czy klawisz jest przypisany do jakiejś akcji. */
+    bool isBound(int key) const;
+    /** @brief Odbudowuje listę boundKeys po zmianie przypisań. */
+    void rebuildKeys();
+    /**
+     * @brief Odczytuje stan przypisanych klawiszy z pominięciem raylib.
+     * @param time Chwila odczytu.
+     * @param record False tylko zapamiętuje stan (np. klawisz trzymany przy starcie rozgrywki nie jest wciśnięciem).
+     */
+    void readKeys(double time, bool record);
+
+public:
+    /**
+     * @brief Tworzy system z domyślnymi przypisaniami.
+     */
+    InputSystem();
+
+    /**
+     * @brief Zwraca bieżący czas zegara zdarzeń.
+     * @return Czas w sekundach (zegar monotoniczny).
+     */
+    static double now();
+
+    /**
+     * @brief Przywraca domyślne przypisania (skok: spacja, strzałka w górę, W, A na padzie; zatwierdzenie: ENTER,
+     * START na padzie; powrót: ESC, B na padzie; skoki kolejnych graczy: prawy SHIFT lub CTRL, L, B).
+     */
+    void resetBindings();
+
+    /**
+     * @brief Wczytuje przypisania z pliku (wiersz: nazwa akcji i nazwy klawiszy, np. "jump SPACE UP PAD_A").
+     * Akcje nieobecne w pliku zachowują domyślne przypisania.
+     * @param path Ścieżka do pliku.
+     * @return False, jeśli pliku nie udało się otworzyć.
+     */
+    bool loadBindings(const std::string& path);
+
+    /**
+     * @brief Zapisuje przypisania do pliku w formacie loadBindings().
+     * @param path Ścieżka do pliku.
+     * @return True, jeśli zapis się powiódł.
+     */
+    bool saveBindings(const std::string& path) const;
+
+    /**
+     * @brief Zastępuje przypisania akcji.
+     * @param action Akcja.
+     * @param actionBindings Nowe przypisania (nadmiarowe ponad MAX_BINDINGS są pomijane).
+     */
+    void setBindings(InputAction action, const std::vector<InputBinding>& actionBindings);
+
+    /**
+     * @brief Zwraca przypisania akcji.
+     * @param action Akcja.
+     * @return Przypisania.
+     */
+    const std::vector<InputBinding>& getBindings(InputAction action) const { return bindings[static_cast<std::size_t>(action)]; }
+
+    /**
+     * @brief Włącza lub wyłącza zbieranie zdarzeń (rozgrywka); wyłączenie czyści kolejkę.
+     * W czasie zbierania InputSystem opróżnia kolejkę klawiszy raylib (GetKeyPressed()).
+     * @param enabled Nowy stan.
+     */
+    void setCapturing(bool enabled);
+
+    /** @brief Sprawdza, czy zdarzenia są zbierane. @return True w trakcie rozgrywki. */
+    bool isCapturing() const { return capturing; }
+
+    /**
+     * @brief Odczytuje klawiaturę z pominięciem raylib i zapisuje nowe wciśnięcia z bieżącym czasem.
+     * Wywoływana przez FramePacer w czasie uśpienia; bez zbierania lub bez wsparcia systemu nic nie robi.
+     */
+    void sample();
+
+    /**
+     * @brief Na początku klatki dopisuje wciśnięcia zgłoszone przez raylib, których nie złapało próbkowanie.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Zdejmuje najstarsze zdarzenie.
+     * @param out Miejsce na zdarzenie.
+     * @return False, jeśli kolejka jest pusta.
+     */
+    bool poll(InputEvent& out);
+
+    /**
+     * @brief Sprawdza, czy akcja została wciśnięta w tej klatce (na granicy klatki, dla ekranów menu).
+     * @param action Akcja.
+     * @return True, jeśli któreś przypisanie zostało wciśnięte.
+     */
+    bool wasPressed(InputAction action) const;
+
+    /**
+     * @brief Zapisuje w statystykach zdarzenie przekazane symulacji (zdarzenie z granicy klatki jest tylko liczone).
+     * @param event Zdarzenie.
+     * @param simulationTime Chwila startu symulacji klatki (InputSystem::now()).
+     * @param correction O ile później niż na początku kroku (tam, gdzie trafia wejście z granicy klatki) zastosowano zdarzenie (sekundy).
+     */
+    void recordLatency(const InputEvent& event, double simulationTime, double correction);
+
+    /** @brief Zwraca statystyki opóźnienia. @return Statystyki. */
+    InputLatencyStats getLatencyStats() const;
+
+    /**
+     * @brief Wypisuje statystyki opóźnienia na konsolę.
+     */
+    void printReport() const;
+};
+
+/**
+ * @brief Zwraca globalny system wejścia.
+ * @return Referencja do systemu wejścia.
+ */
+export InputSystem& input();
+
+/**
+ * @brief Zamienia nazwę akcji (jump, confirm, back, jump2, jump3, jump4) na wartość wyliczenia.
+ * @param name Nazwa akcji.
+ * @param out Miejsce na wynik.
+ * @return True, jeśli nazwa jest poprawna.
+ */
+export bool parseInputAction(std::string_view name, InputAction& out);
+
+/**
+ * @brief Zwraca nazwę akcji.
+ * @param action Akcja.
+ * @return Nazwa.
+ */
+export const char* inputActionName(InputAction action);
+
+/**
+ * @brief Zwraca numer gracza, którego skokiem jest akcja.
+ * @param action Akcja.
+ * @return Indeks gracza (0 dla JUMP) albo -1, jeśli akcja nie jest skokiem.
+ */
+export int jumpActionPlayer(InputAction action);
+
+/**
+ * @brief Zamienia nazwę klawisza lub przycisku (SPACE, A, 7, PAD_A, ...) na przypisanie.
+ * @param name Nazwa.
+ * @param out Miejsce na wynik.
+ * @return True, jeśli nazwa jest poprawna.
+ */
+export bool parseInputBinding(std::string_view name, InputBinding& out);
+
+/**
+ * @brief Zwraca nazwę przypisania w formacie parseInputBinding().
+ * @param binding Przypisanie.
+ * @return Nazwa (pusta, jeśli kod nie ma nazwy).
+ */
+export std::string inputBindingName(const InputBinding& binding);
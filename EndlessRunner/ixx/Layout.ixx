@@ -0,0 +1,121 @@
+﻿/**
+ * @file Layout.ixx
+ * @brief Moduł drzewa układu interfejsu z kotwicami i rozmiarami względnymi.
+ *
+ * Ekrany opisują położenie elementów raz (kotwica w rodzicu, punkt zaczepienia w elemencie, przesunięcie
+ * i rozmiar), a prostokąty są przeliczane tylko po zmianie rozmiaru okna. Rysowanie i testy trafienia
+ * korzystają z zapamiętanych prostokątów, więc koszt klatki w menu nie rośnie z liczbą elementów.
+ */
+
+module;
+#include "raylib.h"
+#include <cstddef>
+#include <vector>
+export module LayoutModule;
+
+
+/**
+ * @struct LayoutSpec
+ * @brief Opis położenia i rozmiaru elementu względem rodzica.
+ *
+ * Rozmiar to size + relativeSize * rozmiar rodzica. Punkt pivot elementu (ułamek jego rozmiaru)
+ * trafia w punkt anchor rodzica (ułamek rozmiaru rodzica), przesunięty o offset.
+ */
+export struct LayoutSpec {
+    /** @brief Punkt zaczepienia w rodzicu (0,0 - lewy górny róg, 1,1 - prawy dolny). */
+    Vector2 anchor{ 0.f, 0.f };
+    /** @brief Punkt elementu umieszczany w kotwicy. */
+    Vector2 pivot{ 0.f, 0.f };
+    /** @brief Przesunięcie od kotwicy (w pikselach). */
+    Vector2 offset{ 0.f, 0.f };
+    /** @brief Stała część rozmiaru (w pikselach). */
+    Vector2 size{ 0.f, 0.f };
+    /** @brief Część rozmiaru zależna od rodzica (ułamek jego szerokości i wysokości). */
+    Vector2 relativeSize{ 0.f, 0.f };
+    /** @brief Proporcje szerokość/wysokość, do których element jest dopasowywany (0 - bez dopasowania). */
+    float aspect{ 0.f };
+    /** @brief Czy element bierze udział w testach trafienia (przyciski). */
+    bool interactive{ false };
+};
+
+/**
+ * @class Layout
+ * @brief Drzewo elementów interfejsu z zapamiętanymi prostokątami.
+ *
+ * Elementy są przechowywane w kolejności dodawania, a rodzic zawsze poprzedza dzieci,
+ * więc przeliczenie to jeden przebieg po tablicy.
+ */
+export class Layout {
+private:
+    /**
+     * @struct Node
+     * @brief Element drzewa.
+     */
+    struct Node {
+        /** @brief Opis położenia. */
+        LayoutSpec spec;
+        /** @brief Indeks rodzica (ROOT dla elementów okna). */
+        int parent;
+        /** @brief Prostokąt wyznaczony przy ostatnim przeliczeniu. */
+        Rectangle rect;
+    };
+
+    /** @brief Elementy drzewa. */
+    std::vector<Node> nodes;
+    /** @brief Szerokość okna z ostatniego przeliczenia (-1 przed pierwszym). */
+    int width{ -1 };
+    /** @brief Wysokość okna z ostatniego przeliczenia. */
+    int height{ -1 };
+    /** @brief Pozycja myszy z ostatniego testu trafienia. */
+    Vector2 lastMouse{ -1.f, -1.f };
+    /** @brief Wynik ostatniego testu trafienia. */
+    int lastHover{ -1 };
+    /** @brief Czy wynik testu trafienia jest aktualny. */
+    bool hoverValid{ false };
+
+public:
+    /** @brief Rodzic elementów położonych względem całego okna. */
+    static constexpr int ROOT = -1;
+
+    /**
+     * @brief Dodaje element do drzewa.
+     * @param spec Opis położenia.
+     * @param parent Indeks rodzica (musi być dodany wcześniej) albo ROOT.
+     * @return Indeks elementu.
+     */
+    int add(const LayoutSpec& spec, int parent = ROOT);
+
+    /**
+     * @brief Przelicza prostokąty, jeśli okno zmieniło rozmiar od ostatniego przeliczenia.
+     * @return True, jeśli prostokąty zostały przeliczone.
+     */
+    bool refresh();
+
+    /**
+     * @brief Przelicza prostokąty dla zadanego rozmiaru, jeśli różni się od poprzedniego.
+     * @param screenWidth Szerokość okna.
+     * @param screenHeight Wysokość okna.
+     * @return True, jeśli prostokąty zostały przeliczone.
+     */
+    bool refresh(int screenWidth, int screenHeight);
+
+    /**
+     * @brief Zwraca prostokąt elementu z ostatniego przeliczenia.
+     * @param id Indeks elementu.
+     * @return Prostokąt w pikselach okna.
+     */
+    const Rectangle& rect(int id) const { return nodes[id].rect; }
+
+    /**
+     * @brief Zwraca element interaktywny pod kursorem.
+     *
+     * Wynik jest zapamiętywany i liczony ponownie tylko po ruchu myszy lub przeliczeniu układu.
+     *
+     * @param mouse Pozycja myszy.
+     * @return Indeks elementu albo -1, jeśli kursor nie wskazuje żadnego.
+     */
+    int hover(Vector2 mouse);
+
+    /** @brief Zwraca liczbę elementów. @return Liczba elementów. */
+    std::size_t getNodeCount() const { return nodes.size(); }
+};
@@ -1,12 +1,14 @@
 /**
  * @file LoadingScreen.ixx
- * @brief Modu definiujcy klas LoadingScreen, obsugujc ekran adowania i uwierzytelniania.
+ * @brief Moduł definiujący sceny ekranu ładowania i uwierzytelniania.
  *
- * Klasa LoadingScreen zarzdza ekranem adowania oraz interfejsem rejestracji i logowania.
+ * LoadingScreen wczytuje tekstury po kawałku w tle i pokazuje rzeczywisty postęp, AuthScreen pozwala wybrać
+ * rejestrację lub logowanie, a CredentialsScreen obsługuje formularz nazwy użytkownika i hasła.
  */
 module;
 #include "raylib.h"
-#include "chrono"
+#include <chrono>
+#include <future>
 #include <string>
 
 export module LoadingScreenModule;
@@ -16,406 +18,222 @@ import BoardModule;
 import ShopModule;
 import AuthModule;
 import ConfigModule;
+import SceneModule;
+import FramePacerModule;
+import LayoutModule;
 
 /**
  * @class LoadingScreen
- * @brief Klasa obsugujca ekran adowania i uwierzytelniania.
+ * @brief Scena ekranu ładowania.
  *
- * Wywietla pasek adowania, a nastpnie interfejs rejestracji lub logowania uytkownika.
+ * Wczytywanie tekstur jest zadaniem w tle SceneManager, więc pasek ładowania jest rysowany w każdej klatce.
+ * Po zakończeniu ładowania scena zastępuje się ekranem uwierzytelniania.
  */
-export class LoadingScreen {
+export class LoadingScreen : public Scene {
 private:
-	/** @brief Tekstura pustego paska adowania. */
+	/** @brief Tekstura pustego paska ładowania. */
 	Texture2D barEmpty;
-	/** @brief Tekstura wypenionego paska adowania. */
+	/** @brief Tekstura wypełnionego paska ładowania. */
 	Texture2D barFill;
-	/** @brief Flaga wskazujca zakoczenie adowania. */
-	bool loadingFinished = false;
+	/** @brief Postęp ładowania w zakresie [0, 1]. */
+	float loadingProgress = 0.0f;
+	/** @brief Czas rozpoczęcia ładowania. */
+	std::chrono::steady_clock::time_point startTime;
+
+	/** @brief Referencja do zasobów gry. */
+	Resources& resources;
+	/** @brief Referencja do planszy gry. */
+	Board& board;
+	/** @brief Referencja do sklepu. */
+	Shop& shop;
 
 public:
 	/**
-	 * @brief Wywietla ekran adowania, a nastpnie ekran uwierzytelniania.
-	 * @param screenWidth Szeroko ekranu.
-	 * @param screenHeight Wysoko ekranu.
-	 * @param resources Referencja do zasobw gry.
-	 * @param board Referencja do planszy gry.
-	 * @param shop Referencja do sklepu.
-	 * @return Nazwa uytkownika po udanym uwierzytelnieniu lub pusty cig.
+	 * @brief Konstruktor klasy LoadingScreen.
+	 * @param res Referencja do zasobów gry.
+	 * @param b Referencja do planszy gry.
+	 * @param s Referencja do sklepu.
 	 */
-	std::string show(int screenWidth, int screenHeight, Resources& resources, Board& board, Shop& shop); //{
-	//	auto startTime = std::chrono::high_resolution_clock::now();
-	//	const int loadingDuration = Config::LOADING_DURATION_MS; 
+	LoadingScreen(Resources& res, Board& b, Shop& s) : resources(res), board(b), shop(s) {}
 
-	//	resources.loadTextures();
-
-	//	barEmpty = resources.getBarEmpty();
-	//	barFill = resources.getBarFill();
-
-	//	shop.init(resources, screenWidth, screenHeight);
-
-	//	while (!loadingFinished && !WindowShouldClose()) {
-	//		screenWidth = GetScreenWidth();
-	//		screenHeight = GetScreenHeight();
-
-	//		auto now = std::chrono::high_resolution_clock::now();
-	//		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
-	//		float loadingProgress = static_cast<float>(duration.count()) / loadingDuration;
-
-	//		if (loadingProgress > 1.f) {
-	//			loadingProgress = 1.f;
-	//			loadingFinished = true;
-	//		}
-
-	//		BeginDrawing();
-	//		DrawTexturePro(
-	//			resources.getLoadingScreenBackground(),
-	//			Rectangle{ 0,0, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
-	//			Rectangle{ 0,0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-	//			Vector2{ 0,0 },
-	//			0.0f,
-	//			WHITE
-	//		);
-
-	//		int barX = screenWidth / 2 - barEmpty.width / 2;
-	//		int barY = screenHeight / 2 + 230;
-
-	//		DrawText("Loading...", screenWidth / 2 - MeasureText("Loading...", 20) / 2, barY - 30, 20, BLACK);
-	//		DrawTexture(barEmpty, barX, barY, BLACK);
-
-	//		Rectangle source = { 0,0, barFill.width * loadingProgress, static_cast<float>(barFill.height) };
-	//		Rectangle dest = { static_cast<float>(barX), static_cast<float>(barY), barFill.width * loadingProgress, static_cast<float>(barFill.height) };
-	//		DrawTexturePro(barFill, source, dest, { 0,0 }, 0.0f, WHITE);
-
-	//		EndDrawing();
-	//	}
-
-	//	//UnloadTexture(barEmpty);
-	//	//UnloadTexture(barFill);
-
-	//	if (loadingFinished) {
-	//		return showAuthTiles(screenWidth, screenHeight, resources, board, shop);
-	//	}
-	//	return "";
-	//}
-
-private:
 	/**
-	 * @brief Wywietla ekran wyboru midzy rejestracj a logowaniem.
-	 * @param screenWidth Szeroko ekranu.
-	 * @param screenHeight Wysoko ekranu.
-	 * @param resources Referencja do zasobw gry.
-	 * @param board Referencja do planszy gry.
-	 * @param shop Referencja do sklepu.
-	 * @return Nazwa uytkownika po udanym uwierzytelnieniu lub pusty cig.
+	 * @brief Wczytuje tekstury ekranu ładowania i zleca wczytanie pozostałych w tle.
+	 * @param scenes Stos scen.
 	 */
-	std::string showAuthTiles(int screenWidth, int screenHeight, Resources& resources, Board& board, Shop& shop); /*{
-		constexpr float btnW = Config::AUTH_BUTTON_WIDTH;
-		constexpr float btnH = Config::AUTH_BUTTON_HEIGHT;
-
-		float xLeft = screenWidth * 0.25f - btnW * 0.5f;
-		float xRight = screenWidth * 0.75f - btnW * 0.5f;
-
-		float btnY = screenHeight * 0.85f - btnH * 0.5f;
-
-		Rectangle signInButton = { xLeft, btnY, btnW, btnH };
-		Rectangle logInButton = { xRight, btnY, btnW, btnH };
-
-		while (!WindowShouldClose()) {
-			Vector2 mouse = GetMousePosition();
-
-			BeginDrawing();
-			ClearBackground(RAYWHITE);
-			DrawTexturePro(
-				resources.getLoadingScreenBackground(),
-				Rectangle{ 0,0, static_cast<float>(resources.getLoadingScreenBackground().width), static_cast<float>(resources.getLoadingScreenBackground().height) },
-				Rectangle{ 0,0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-				Vector2{ 0,0 },
-				0.0f,
-				WHITE
-			);
-
-			Texture2D buttonTex = resources.getButtonTexture();
-			Color signInColor = CheckCollisionPointRec(mouse, signInButton) ? GRAY : WHITE;
-			DrawTexturePro(
-				buttonTex,
-				Rectangle{ 0, 0, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-				signInButton,
-				Vector2{ 0, 0 },
-				0.0f,
-				signInColor
-			);
-			DrawText("Sign In", static_cast<int>(signInButton.x + (signInButton.width - MeasureText("Sign In", 20)) / 2), static_cast<int>(signInButton.y + 30), 20, BLACK);
-
-			Color logInColor = CheckCollisionPointRec(mouse, logInButton) ? GRAY : WHITE;
-			DrawTexturePro(
-				buttonTex,
-				Rectangle{ 0, 0, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-				logInButton,
-				Vector2{ 0, 0 },
-				0.0f,
-				logInColor
-			);
-			DrawText("Log In", static_cast<int>(logInButton.x + (logInButton.width - MeasureText("Log In", 20)) / 2), static_cast<int>(logInButton.y + 30), 20, BLACK);
-
-			if (CheckCollisionPointRec(mouse, signInButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-				std::string username = handleSignIn(screenWidth, screenHeight, resources);
-				if (!username.empty()) {
-					return username;
-				}
-			}
-			if (CheckCollisionPointRec(mouse, logInButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-				std::string username = handleLogIn(screenWidth, screenHeight, resources);
-				if (!username.empty()) {
-					return username;
-				}
-			}
-
-			EndDrawing();
-		}
-		return "";
-	}*/
+	void enter(SceneManager& scenes) override;
 
 	/**
-	* @brief Obsuguje proces rejestracji uytkownika.
-	* @param screenWidth Szeroko ekranu.
-	* @param screenHeight Wysoko ekranu.
-	* @param resources Referencja do zasobw gry.
-	* @return Nazwa uytkownika po udanej rejestracji lub pusty cig.
-	*/
-	std::string handleSignIn(int screenWidth, int screenHeight, Resources& resources);/* {
-		Authorization auth;
-		std::string username, password;
-		std::string errorMessage;
-		bool usernameError = false;
-		bool passwordError = false;
-		bool validInput = false;
-		bool enteringUsername = true;
-		Rectangle submitButton = { static_cast<float>(screenWidth / 2 - 100), static_cast<float>(screenHeight / 2 + 200), 200, 60 };
-
-		while (!WindowShouldClose() && !validInput) {
-			BeginDrawing();
-			DrawTexturePro(
-				resources.getRegistrationBackground(),
-				Rectangle{ 0.f, 0.f, static_cast<float>(resources.getRegistrationBackground().width), static_cast<float>(resources.getRegistrationBackground().height) },
-				Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-				Vector2{ 0.f, 0.f },
-				0.0f,
-				WHITE
-			);
-
-			Color usernameBorder = usernameError ? RED : (enteringUsername ? GREEN : BLACK);
-			DrawText("Enter Username (3-20 chars, alphanumeric):", screenWidth / 2 - 220, screenHeight / 2 - 60, 20, usernameBorder);
-			DrawText(username.c_str(), screenWidth / 2 - 150, screenHeight / 2 - 40, 20, BLACK);
-			DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 - 40, 400, 30, usernameBorder);
-
-			Color passwordBorder = passwordError ? RED : (!enteringUsername ? GREEN : BLACK);
-			DrawText("Enter Password (8+ chars, letters and numbers):", screenWidth / 2 - 220, screenHeight / 2 + 10, 20, passwordBorder);
-			std::string maskedPassword(password.length(), '*');
-			DrawText(maskedPassword.c_str(), screenWidth / 2 - 150, screenHeight / 2 + 40, 20, BLACK);
-			DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 + 40, 400, 30, passwordBorder);
-
-			Texture2D buttonTex = resources.getButtonTexture();
-			Vector2 mouse = GetMousePosition();
-			Color submitColor = CheckCollisionPointRec(mouse, submitButton) ? GRAY : WHITE;
-			DrawTexturePro(
-				buttonTex,
-				Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-				submitButton,
-				Vector2{ 0.f, 0.f },
-				0.0f,
-				submitColor
-			);
-			DrawText("Submit", static_cast<int>(submitButton.x + (submitButton.width - MeasureText("Submit", 20)) / 2), static_cast<int>(submitButton.y + 20), 20, BLACK);
-
-			if (!errorMessage.empty()) {
-				DrawText(errorMessage.c_str(), screenWidth / 2 - MeasureText(errorMessage.c_str(), 20) / 2, screenHeight / 2 + 90, 20, RED);
-			}
-
-			Vector2 mousePos = GetMousePosition();
+	 * @brief Aktualizuje postęp ładowania; po jego zakończeniu przechodzi do ekranu uwierzytelniania.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+	 */
+	void update(SceneManager& scenes, float deltaTime) override;
 
-			int key = GetCharPressed();
-			while (key > 0) {
-				if ((key >= 32) && (key <= 125)) {
-					if (enteringUsername && username.length() < 20) {
-						username += static_cast<char>(key);
-						usernameError = false;
-						errorMessage = "";
-					}
-					else if (!enteringUsername && password.length() < 20) {
-						password += static_cast<char>(key);
-						passwordError = false;
-						errorMessage = "";
-					}
-				}
-				key = GetCharPressed();
-			}
+	/**
+	 * @brief Rysuje tło i pasek ładowania.
+	 */
+	void render() override;
 
-			if (IsKeyPressed(KEY_BACKSPACE)) {
-				if (enteringUsername && !username.empty()) {
-					username.pop_back();
-					usernameError = false;
-					errorMessage = "";
-				}
-				else if (!enteringUsername && !password.empty()) {
-					password.pop_back();
-					passwordError = false;
-					errorMessage = "";
-				}
-			}
+	/**
+	 * @brief Ekranu ładowania nie można opuścić klawiszem ESC.
+	 * @param scenes Stos scen.
+	 */
+	void back(SceneManager& scenes) override {}
 
-			if (IsKeyPressed(KEY_TAB)) {
-				enteringUsername = !enteringUsername;
-			}
+	/**
+	 * @brief Pasek ładowania jest animowany, więc klatki nie są ograniczane jak w menu.
+	 * @return FrameKind::GAMEPLAY.
+	 */
+	FrameKind getFrameKind() const override { return FrameKind::GAMEPLAY; }
+};
 
-			if (IsKeyPressed(KEY_ENTER) || (CheckCollisionPointRec(mousePos, submitButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))) {
-				SignInResult result = auth.signIn(username, password);
-				if (result == SignInResult::SUCCESS) {
-					validInput = true;
-				}
-				else {
-					usernameError = false;
-					passwordError = false;
-					switch (result) {
-					case SignInResult::USERNAME_TAKEN:
-						errorMessage = "Nazwa uzytkownika zajeta";
-						usernameError = true;
-						break;
-					case SignInResult::INVALID_USERNAME:
-						errorMessage = "Niepoprawna nazwa uzytkownika";
-						usernameError = true;
-						break;
-					case SignInResult::INVALID_PASSWORD:
-						errorMessage = "Niepoprawne haslo";
-						passwordError = true;
-						break;
-					}
-				}
-			}
-			DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-			EndDrawing();
-		}
-		return validInput ? username : "";
-	}*/
+/**
+ * @class AuthScreen
+ * @brief Scena wyboru rejestracji lub logowania.
+ */
+export class AuthScreen : public Scene {
+private:
+	/** @brief Układ ekranu (dwa przyciski na 85% wysokości okna). */
+	Layout layout;
+	/** @brief Indeks przycisku rejestracji w układzie. */
+	int signInNode{ Layout::ROOT };
+	/** @brief Indeks przycisku logowania w układzie. */
+	int logInNode{ Layout::ROOT };
+
+	/** @brief Referencja do zasobów gry. */
+	Resources& resources;
+	/** @brief Referencja do planszy gry. */
+	Board& board;
+	/** @brief Referencja do sklepu. */
+	Shop& shop;
 
+public:
 	/**
-	 * @brief Obsuguje proces logowania uytkownika.
-	 * @param screenWidth Szeroko ekranu.
-	 * @param screenHeight Wysoko ekranu.
-	 * @param resources Referencja do zasobw gry.
-	 * @return Nazwa uytkownika po udanym logowaniu lub pusty cig.
+	 * @brief Konstruktor klasy AuthScreen.
+	 * @param res Referencja do zasobów gry.
+	 * @param b Referencja do planszy gry.
+	 * @param s Referencja do sklepu.
 	 */
-	std::string handleLogIn(int screenWidth, int screenHeight, Resources& resources);/* {
-		Authorization auth;
-		std::string username, password;
-		std::string errorMessage;
-		bool usernameError = false;
-		bool passwordError = false;
-		bool loggedIn = false;
-		bool enteringUsername = true;
-		Rectangle submitButton = { static_cast<float>(screenWidth / 2 - 100), static_cast<float>(screenHeight / 2 + 200), 200, 60 };
+	AuthScreen(Resources& res, Board& b, Shop& s);
 
-		while (!WindowShouldClose() && !loggedIn) {
-			BeginDrawing();
-			ClearBackground(RAYWHITE);
-
-			DrawTexturePro(
-				resources.getRegistrationBackground(),
-				Rectangle{ 0.f, 0.f, static_cast<float>(resources.getRegistrationBackground().width), static_cast<float>(resources.getRegistrationBackground().height) },
-				Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-				Vector2{ 0.f, 0.f },
-				0.0f,
-				WHITE
-			);
+	/**
+	 * @brief Otwiera formularz po kliknięciu przycisku.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+	 */
+	void update(SceneManager& scenes, float deltaTime) override;
 
-			Color usernameBorder = usernameError ? RED : (enteringUsername ? GREEN : BLACK);
-			DrawText("Enter Username:", screenWidth / 2 - 100, screenHeight / 2 - 60, 20, usernameBorder);
-			DrawText(username.c_str(), screenWidth / 2 - 150, screenHeight / 2 - 40, 20, BLACK);
-			DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 - 40, 400, 30, usernameBorder);
+	/**
+	 * @brief Rysuje tło i przyciski rejestracji oraz logowania.
+	 */
+	void render() override;
 
+	/**
+	 * @brief Ekran uwierzytelniania jest dnem stosu; ESC nic nie robi (okno zamyka przycisk zamknięcia).
+	 * @param scenes Stos scen.
+	 */
+	void back(SceneManager& scenes) override {}
+};
 
-			Color passwordBorder = passwordError ? RED : (!enteringUsername ? GREEN : BLACK);
-			DrawText("Enter Password:", screenWidth / 2 - 100, screenHeight / 2 + 10, 20, passwordBorder);
-			std::string maskedPassword(password.length(), '*');
-			DrawText(maskedPassword.c_str(), screenWidth / 2 - 150, screenHeight / 2 + 40, 20, BLACK);
-			DrawRectangleLines(screenWidth / 2 - 200, screenHeight / 2 + 40, 400, 30, passwordBorder);
+/**
+ * @class CredentialsScreen
+ * @brief Scena formularza rejestracji lub logowania.
+ *
+ * Dane są sprawdzane przez authWorker() w tle; do czasu odpowiedzi formularz pokazuje wskaźnik oczekiwania
+ * i nie przyjmuje wejścia. Po poprawnym uwierzytelnieniu zastępuje się menu głównym; ESC wraca do ekranu
+ * uwierzytelniania.
+ */
+export class CredentialsScreen : public Scene {
+public:
+	/**
+	 * @enum Mode
+	 * @brief Rodzaj formularza.
+	 */
+	enum class Mode {
+		SIGN_IN, /**< Rejestracja nowego użytkownika. */
+		LOG_IN   /**< Logowanie istniejącego użytkownika. */
+	};
 
-			Texture2D buttonTex = resources.getButtonTexture();
-			Vector2 mouse = GetMousePosition();
-			Color submitColor = CheckCollisionPointRec(mouse, submitButton) ? GRAY : WHITE;
-			DrawTexturePro(
-				buttonTex,
-				Rectangle{ 0.f, 0.f, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-				submitButton,
-				Vector2{ 0.f, 0.f },
-				0.0f,
-				submitColor
-			);
-			DrawText("Submit", static_cast<int>(submitButton.x + (submitButton.width - MeasureText("Submit", 20)) / 2), static_cast<int>(submitButton.y + 20), 20, BLACK);
+private:
+	/** @brief Rodzaj formularza. */
+	Mode mode;
+	/** @brief Oczekujący wynik rejestracji. */
+	std::future<SignInResult> pendingSignIn;
+	/** @brief Oczekujący wynik logowania. */
+	std::future<LogInResult> pendingLogIn;
+	/** @brief Kąt obrotu wskaźnika oczekiwania (w stopniach). */
+	float spinnerAngle = 0.0f;
+	/** @brief Wpisana nazwa użytkownika. */
+	std::string username;
+	/** @brief Wpisane hasło. */
+	std::string password;
+	/** @brief Komunikat błędu. */
+	std::string errorMessage;
+	/** @brief Flaga błędu nazwy użytkownika. */
+	bool usernameError = false;
+	/** @brief Flaga błędu hasła. */
+	bool passwordError = false;
+	/** @brief Flaga wskazująca, które pole jest edytowane. */
+	bool enteringUsername = true;
+	/** @brief Układ formularza. */
+	Layout layout;
+	/** @brief Indeks pola nazwy użytkownika w układzie. */
+	int usernameNode{ Layout::ROOT };
+	/** @brief Indeks pola hasła w układzie. */
+	int passwordNode{ Layout::ROOT };
+	/** @brief Indeks przycisku zatwierdzenia w układzie. */
+	int submitNode{ Layout::ROOT };
+
+	/** @brief Referencja do zasobów gry. */
+	Resources& resources;
+	/** @brief Referencja do planszy gry. */
+	Board& board;
+	/** @brief Referencja do sklepu. */
+	Shop& shop;
 
-			if (!errorMessage.empty()) {
-				DrawText(errorMessage.c_str(), screenWidth / 2 - MeasureText(errorMessage.c_str(), 20) / 2, screenHeight / 2 + 90, 20, RED);
-			}
+public:
+	/**
+	 * @brief Konstruktor klasy CredentialsScreen.
+	 * @param formMode Rodzaj formularza.
+	 * @param res Referencja do zasobów gry.
+	 * @param b Referencja do planszy gry.
+	 * @param s Referencja do sklepu.
+	 */
+	CredentialsScreen(Mode formMode, Resources& res, Board& b, Shop& s);
 
-			Vector2 mousePos = GetMousePosition();
+	/**
+	 * @brief Obsługuje wpisywanie danych i zatwierdzenie formularza.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+	 */
+	void update(SceneManager& scenes, float deltaTime) override;
 
-			int key = GetCharPressed();
-			while (key > 0) {
-				if ((key >= 32) && (key <= 125)) {
-					if (enteringUsername && username.length() < 20) {
-						username += static_cast<char>(key);
-						usernameError = false;
-						errorMessage = "";
-					}
-					else if (!enteringUsername && password.length() < 20) {
-						password += static_cast<char>(key);
-						passwordError = false;
-						errorMessage = "";
-					}
-				}
-				key = GetCharPressed();
-			}
+	/**
+	 * @brief Rysuje formularz.
+	 */
+	void render() override;
 
-			if (IsKeyPressed(KEY_BACKSPACE)) {
-				if (enteringUsername && !username.empty()) {
-					username.pop_back();
-					usernameError = false;
-					errorMessage = "";
-				}
-				else if (!enteringUsername && !password.empty()) {
-					password.pop_back();
-					passwordError = false;
-					errorMessage = "";
-				}
-			}
+	/**
+	 * @brief Wskaźnik oczekiwania jest animowany, więc podczas sprawdzania danych klatki nie są ograniczane.
+	 * @return FrameKind::GAMEPLAY w trakcie oczekiwania, w przeciwnym razie FrameKind::MENU.
+	 */
+	FrameKind getFrameKind() const override { return isWaiting() ? FrameKind::GAMEPLAY : FrameKind::MENU; }
 
-			if (IsKeyPressed(KEY_TAB)) {
-				enteringUsername = !enteringUsername;
-			}
+private:
+	/**
+	 * @brief Sprawdza, czy formularz czeka na wynik z wątku roboczego.
+	 * @return True, jeśli żądanie jest w toku.
+	 */
+	bool isWaiting() const { return pendingSignIn.valid() || pendingLogIn.valid(); }
 
-			if (IsKeyPressed(KEY_ENTER) || (CheckCollisionPointRec(mousePos, submitButton) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON))) {
-				LogInResult result = auth.logIn(username, password);
-				if (result == LogInResult::SUCCESS) {
-					loggedIn = true;
-				}
-				else {
-					usernameError = false;
-					passwordError = false;
-					switch (result) {
-					case LogInResult::USER_NOT_FOUND:
-						errorMessage = "Uzytkownik nieznaleziony";
-						usernameError = true;
-						break;
-					case LogInResult::INCORRECT_PASSWORD:
-						errorMessage = "Niepoprawne haslo";
-						passwordError = true;
-						break;
-					}
-				}
-			}
+	/**
+	 * @brief Zleca rejestrację lub logowanie wątkowi roboczemu.
+	 */
+	void submit();
 
-			DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-			EndDrawing();
-		}
-		return loggedIn ? username : "";
-	}*/
-};
\ No newline at end of file
+	/**
+	 * @brief Odbiera gotowy wynik i ustawia komunikat błędu.
+	 * @return True, jeśli uwierzytelnienie się powiodło.
+	 */
+	bool poll();
+};
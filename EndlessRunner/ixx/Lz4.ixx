@@ -0,0 +1,33 @@
+﻿/**
+ * @file Lz4.ixx
+ * @brief Moduł z kompresją i dekompresją bloków w formacie LZ4.
+ *
+ * Implementacja obejmuje sam format bloku (bez ramki LZ4 i sum kontrolnych) - rozmiar danych
+ * przed kompresją zapisuje wywołujący. Dekompresja sprawdza granice obu buforów, więc uszkodzone dane
+ * kończą się błędem, a nie zapisem poza buforem.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+export module Lz4Module;
+
+
+/**
+ * @brief Kompresuje blok danych.
+ * @param source Dane wejściowe.
+ * @param sourceSize Rozmiar danych wejściowych w bajtach.
+ * @return Skompresowany blok.
+ */
+export std::vector<std::uint8_t> lz4Compress(const std::uint8_t* source, std::size_t sourceSize);
+
+/**
+ * @brief Dekompresuje blok danych.
+ * @param source Skompresowany blok.
+ * @param sourceSize Rozmiar skompresowanego bloku w bajtach.
+ * @param destination Bufor na dane wyjściowe.
+ * @param destinationSize Oczekiwany rozmiar danych po dekompresji.
+ * @return True, jeśli blok był poprawny i zdekompresował się dokładnie do destinationSize bajtów.
+ */
+export bool lz4Decompress(const std::uint8_t* source, std::size_t sourceSize, std::uint8_t* destination, std::size_t destinationSize);
@@ -0,0 +1,60 @@
+﻿/**
+ * @file MappedFile.ixx
+ * @brief Moduł definiujący klasę MappedFile, mapującą plik tylko do odczytu w przestrzeń adresową procesu.
+ *
+ * Ukrywa różnice między POSIX (mmap) a Windows (CreateFileMapping/MapViewOfFile).
+ * windows.h jest dołączany tylko w MappedFile.cpp - interfejs używa typów standardowych, bo importuje go
+ * AssetPack razem z raylib, a nazwy z windows.h (Rectangle, LoadImage, DrawText) kolidują z raylib.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <string>
+export module MappedFileModule;
+
+
+/**
+ * @class MappedFile
+ * @brief Plik zmapowany do pamięci tylko do odczytu.
+ *
+ * Obiekt jest właścicielem mapowania i zwalnia je w destruktorze. System jest informowany,
+ * że plik będzie czytany sekwencyjnie, więc strony są wczytywane z wyprzedzeniem jednym ciągłym odczytem.
+ */
+export class MappedFile {
+private:
+    /** @brief Adres zmapowanego pliku (nullptr, jeśli nie otwarto). */
+    const std::uint8_t* data{ nullptr };
+    /** @brief Rozmiar pliku w bajtach. */
+    std::size_t size{ 0 };
+    /** @brief Uchwyt pliku (deskryptor lub HANDLE). */
+    std::intptr_t fileHandle{ -1 };
+    /** @brief Uchwyt mapowania (tylko Windows). */
+    std::intptr_t mappingHandle{ -1 };
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Mapuje plik do pamięci.
+     * @param path Ścieżka do pliku.
+     * @return True, jeśli plik został zmapowany (pusty plik nie jest mapowany).
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Odmapowuje plik i zamyka uchwyty.
+     */
+    void close();
+
+    /** @brief Zwraca adres zmapowanego pliku. @return Wskaźnik na pierwszy bajt pliku. */
+    const std::uint8_t* get() const { return data; }
+    /** @brief Zwraca rozmiar pliku. @return Rozmiar w bajtach. */
+    std::size_t getSize() const { return size; }
+    /** @brief Sprawdza, czy plik jest zmapowany. @return True, jeśli plik jest dostępny. */
+    bool isOpen() const { return data != nullptr; }
+};
@@ -1,17 +1,21 @@
 /**
  * @file Menu.ixx
- * @brief Modu definiujcy klas Menu, obsugujc menu gwne gry.
+ * @brief Moduł definiujący klasę Menu, obsługującą menu główne gry.
  *
- * Klasa Menu zarzdza interfejsem menu, w tym opcjami gry, leaderboardem i sklepem.
+ * Klasa Menu zarządza interfejsem menu, w tym opcjami gry, leaderboardem i sklepem.
  */
 
 module;
 #include "raylib.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <array>
+#include <map>
+#include <vector>
 export module MenuModule;
 
 import ResourcesModule;
@@ -19,297 +23,186 @@ import BoardModule;
 import ControllerModule;
 import ShopModule;
 import ConfigModule;
+import SceneModule;
+import RetainedLayerModule;
+import LayoutModule;
+import RecordLogModule;
+import ScoreServiceModule;
 
 
 /**
- * @class Menu
- * @brief Klasa obsugujca menu gwne gry.
- *
- * Wywietla przyciski menu, obsuguje leaderboard, sklep i rozpoczcie gry.
+ * @class Leaderboard
+ * @brief Scena tablicy wyników.
  */
-export class Menu {
-	/** @brief Liczba przyciskw w menu. */
-	static constexpr int buttonCount = Config::MENU_BUTTON_COUNT; 
-	/** @brief Etykiety przyciskw menu. */
-	std::array<const char*, buttonCount> labels = { "Start Game", "LeaderBoard", "Shop", "Log Out", "Exit" };
-	/** @brief Prostokty przyciskw menu. */
-	std::array<Rectangle, buttonCount> buttons;
-	/** @brief Indeks wybranego przycisku (-1, jeli brak). */
-	int selected = -1;
-	/** @brief Nazwa uytkownika. */
-	std::string username;
+export class Leaderboard : public Scene {
+	/**
+	 * @struct ScoreEntry
+	 * @brief Struktura przechowująca dane wyniku (nazwa użytkownika i punkty).
+	 */
+	struct ScoreEntry {
+		/** @brief Nazwa użytkownika. */
+		std::string username;
+		/** @brief Wynik użytkownika. */
+		int score;
+	};
 
-	/** @brief Wskanik do zasobw gry. */
-	Resources* resources{ nullptr };
-	/** @brief Wskanik do planszy gry. */
-	Board* board{ nullptr };
-	/** @brief Wskanik do sklepu. */
-	Shop* shop{ nullptr };
+	/** @brief Referencja do zasobów gry. */
+	Resources& resources;
+	/** @brief Najlepsze wyniki posortowane malejąco. */
+	std::vector<ScoreEntry> scores;
+	/** @brief Najlepszy wynik każdego gracza z przeczytanej części pliku. */
+	std::map<std::string, int> bestScores;
+	/** @brief Plik wyników, czytany przyrostowo od ostatniej pozycji. */
+	RecordLog scoresLog{ Config::SCORES_FILE };
+	/** @brief Klient demona wyników (używany, gdy demon działa). */
+	ScoreClient scoreClient;
+	/** @brief Flaga wskazująca, że bieżąca tablica pochodzi od demona, a nie z pliku. */
+	bool daemonScores{ false };
+	/** @brief Tablica wyników narysowana do tekstury. */
+	RetainedLayer layer{ "Leaderboard" };
+	/** @brief Układ tablicy wyników. */
+	Layout layout;
+	/** @brief Indeks ramki tablicy w układzie. */
+	int frameNode{ Layout::ROOT };
 
 public:
 	/**
-	* @brief Ustawia kontekst menu (zasoby, plansza, sklep).
-	* @param res Referencja do zasobw gry.
-	* @param b Referencja do planszy gry.
-	* @param s Referencja do sklepu.
-	*/
-	void setContext(Resources& res, Board& b, Shop& s);/* {
-		resources = &res;
-		board = &b;
-		shop = &s;
-	}*/
+	 * @brief Konstruktor klasy Leaderboard.
+	 * @param res Referencja do zasobów gry.
+	 */
+	explicit Leaderboard(Resources& res);
 
 	/**
-	* @brief Ustawia nazw uytkownika.
-	* @param user Nazwa uytkownika.
-	*/
-	void setUsername(const std::string& user); /*{
-		username = user;
-	}*/
+	 * @brief Dociąga wyniki dopisane do pliku scores.txt od poprzedniego wejścia.
+	 * @param scenes Stos scen.
+	 */
+	void enter(SceneManager& scenes) override;
 
 	/**
-	 * @brief Wywietla menu gwne.
-	 * @param screenWidth Szeroko ekranu.
-	 * @param screenHeight Wysoko ekranu.
+	 * @brief Przelicza układ po zmianie rozmiaru okna; powrót obsługuje klawisz ESC.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
 	 */
-	void showMenu(int screenWidth, int screenHeight); /*{
-		bool menuRunning = true;
-
-		while (!WindowShouldClose() && menuRunning) {
-			screenWidth = GetScreenWidth();
-			screenHeight = GetScreenHeight();
+	void update(SceneManager& scenes, float deltaTime) override { layout.refresh(); }
 
-			for (int i = 0; i < buttonCount; ++i) {
-				buttons[i] = {
-					static_cast<float>(screenWidth / 2 - 100),
-					static_cast<float>(screenHeight / 2 - ((buttonCount * 80) / 2) + i * 80),
-					200.0f,
-					60.0f
-				};
-			}
-
-			Vector2 mouse = GetMousePosition();
-			selected = -1;
-			for (int i = 0; i < buttonCount; ++i) {
-				if (CheckCollisionPointRec(mouse, buttons[i])) {
-					selected = i;
-					if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-						handleClick(i, menuRunning);
-					}
-				}
-			}
-
-			BeginDrawing();
-			ClearBackground(RAYWHITE);
-
-			DrawTexturePro(
-				resources->getMenuBackground(),
-				Rectangle{ 0, 0, static_cast<float>(resources->getMenuBackground().width), static_cast<float>(resources->getMenuBackground().height) },
-				Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-				Vector2{ 0, 0 },
-				0.0f,
-				WHITE
-			);
-
-		
-			Texture2D banner = resources->getBanner();
-			float bannerScale = Config::BANNER_SCALE; 
-			float bannerHeight = banner.height * bannerScale;
-			float bannerX = screenWidth / 2 - ((banner.width * bannerScale) / 2); 
-			float bannerY = Config::BANNER_Y; 
-			DrawTextureEx(banner, { bannerX, bannerY }, 0.0f, bannerScale, WHITE);
-
-			std::string welcomeText = username.empty() ? "Welcome Guest" : "Welcome " + username;
-			int textWidth = MeasureText(welcomeText.c_str(), 30);
-			float textX = (screenWidth - textWidth) / 2.0f; 
-			DrawText(welcomeText.c_str(), static_cast<int>(textX), static_cast<int>(bannerY + (bannerHeight - 45) / 2), 30, BLACK);
-
-			int fontSize = 20;
-			for (int i = 0; i < buttonCount; ++i) {
-				Texture2D buttonTex = resources->getButtonTexture();
-				Color color = (i == selected) ? GRAY : WHITE;
-
-				DrawTexturePro(
-					buttonTex,
-					Rectangle{ 0, 0, static_cast<float>(buttonTex.width), static_cast<float>(buttonTex.height) },
-					buttons[i],
-					Vector2{ 0,0 },
-					0.0f,
-					color
-				);
-
-				int textWidth = MeasureText(labels[i], fontSize);
-				int textX = static_cast<int>(buttons[i].x + (buttons[i].width - textWidth) / 2);
-				int textY = static_cast<int>(buttons[i].y + (buttons[i].height - fontSize) / 2);
-				DrawText(labels[i], textX, textY, fontSize, BLACK);
-			}
-
-			EndDrawing();
-		}
-	}*/
-
-private:
 	/**
-	 * @brief Rozpoczyna now gr.
+	 * @brief Wczytuje od nowa cały plik wyników (od tej chwili przyrostowo czytany jest ten plik).
+	 * @param path Plik z wynikami w formacie nazwa:wynik.
+	 * @return True, jeśli tablica nie jest pusta.
 	 */
-	void newGame(); //{
-	//	if (resources && board && shop) {
-	//		int selectedDino = shop->getSelectedDino();
-	//		int frameCount = shop->getSelectedDinoFrameCount();
+	bool loadScores(const std::string& path);
 
-	//		Texture2D selectedDinoTex;
-	//		switch (selectedDino) {
-	//		case 0: selectedDinoTex = resources->getGreenDinoRun(); break;
-	//		case 1: selectedDinoTex = resources->getBlueDinoRun(); break;
-	//		case 2: selectedDinoTex = resources->getYellowDinoRun(); break;
-	//		case 3: selectedDinoTex = resources->getRedDinoRun(); break;
-	//		default: selectedDinoTex = resources->getGreenDinoRun(); break;
-	//		}
+	/**
+	 * @brief Odświeża tablicę: pyta demona wyników o czołówkę, a gdy demon nie działa,
+	 *        dociąga z pliku wyniki dopisane od poprzedniego odczytu (także przez inne instancje gry).
+	 * @return True, jeśli ranking się zmienił.
+	 */
+	bool refreshScores();
 
-	//		board->setDinoTex(selectedDinoTex);
-	//		board->setDinoFrameCount(frameCount);
-	//		//board->init(selectedDinoTex, GetScreenWidth(), GetScreenHeight());
-	//		Controller controller(*resources, *board, username, GetScreenWidth(), GetScreenHeight());
-	//		controller.run();
-	//	}
-	//}
+	/** @brief Zwraca liczbę graczy na tablicy. @return Liczba wyników. */
+	std::size_t getScoreCount() const { return scores.size(); }
 
 	/**
-	 * @struct ScoreEntry
-	 * @brief Struktura przechowujca dane wyniku (nazwa uytkownika i punkty).
+	 * @brief Rysuje tablicę wyników (z warstwy, przebudowywanej po zmianie rozmiaru okna).
 	 */
-	struct ScoreEntry {
-		/** @brief Nazwa uytkownika. */
-		std::string username;
-		/** @brief Wynik uytkownika. */
-		int score;
-	};
+	void render() override;
 
+private:
 	/**
-	* @brief Wywietla tablic wynikw.
-	* @param screenWidth Szeroko ekranu.
-	* @param screenHeight Wysoko ekranu.
-	*/
-	void showLeaderboard(int screenWidth, int screenHeight);/* {
-		std::map<std::string, int> bestScores;
-		std::ifstream file("scores.txt");
-		if (file.is_open()) {
-			std::string line;
-			while (std::getline(file, line)) {
-				std::istringstream iss(line);
-				std::string user;
-				int score;
-				if (std::getline(iss, user, ':') && (iss >> score)) {
-					if (bestScores.find(user) == bestScores.end() || score > bestScores[user]) {
-						bestScores[user] = score;
-					}
-				}
-			}
-			file.close();
-		}
-
-		std::vector<ScoreEntry> scores;
-		for (const auto& entry : bestScores) {
-			scores.push_back({ entry.first, entry.second });
-		}
-
-		std::sort(scores.begin(), scores.end(),
-			[](const ScoreEntry& a, const ScoreEntry& b) { return a.score > b.score; });
-
-		bool leaderboardRunning = true;
-		while (!WindowShouldClose() && leaderboardRunning) {
-			screenWidth = GetScreenWidth();
-			screenHeight = GetScreenHeight();
-
-			if (IsKeyPressed(KEY_ESCAPE)) {
-				leaderboardRunning = false;
-			}
-
-			BeginDrawing();
-			ClearBackground(RAYWHITE);
-
-			DrawTexturePro(
-				resources->getMenuBackground(),
-				Rectangle{ 0, 0, static_cast<float>(resources->getMenuBackground().width), static_cast<float>(resources->getMenuBackground().height) },
-				Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-				Vector2{ 0, 0 },
-				0.0f,
-				WHITE
-			);
-
-		
-			Texture2D leaderboardFrame = resources->getLeaderboard();
-			float frameScale = std::min(
-				static_cast<float>(screenWidth) / leaderboardFrame.width,
-				static_cast<float>(screenHeight) / leaderboardFrame.height
-			) * 0.8f; 
-			float frameWidth = leaderboardFrame.width * frameScale;
-			float frameHeight = leaderboardFrame.height * frameScale;
-			float frameX = (screenWidth - frameWidth) / 2;
-			float frameY = (screenHeight - frameHeight) / 2;
+	 * @brief Dociąga z pliku wyniki dopisane od poprzedniego odczytu.
+	 * @return True, jeśli ranking się zmienił.
+	 */
+	bool refreshFromLog();
 
-			DrawTextureEx(leaderboardFrame, { frameX, frameY }, 0.0f, frameScale, WHITE);
+	/**
+	 * @brief Rysuje tło, ramkę, wyniki i podpowiedź.
+	 * @return Liczba wywołań rysujących.
+	 */
+	int drawStatic() const;
+};
 
-			DrawText("Leaderboard", static_cast<int>(frameX + (frameWidth - MeasureText("Leaderboard", 40)) / 2),
-				static_cast<int>(frameY + 70), 40, BLACK);
+/**
+ * @class Menu
+ * @brief Scena menu głównego gry.
+ *
+ * Wyświetla przyciski menu i kładzie na stos scen rozgrywkę, leaderboard lub sklep.
+ * Wylogowanie zdejmuje menu ze stosu, odsłaniając ekran uwierzytelniania.
+ */
+export class Menu : public Scene {
+	/** @brief Liczba przycisków w menu. */
+	static constexpr int buttonCount = Config::MENU_BUTTON_COUNT;
+	/** @brief Etykiety przycisków menu. */
+	std::array<const char*, buttonCount> labels = { "Start Game", "LeaderBoard", "Shop", "Log Out", "Exit" };
+	/** @brief Układ menu (baner i kolumna przycisków). */
+	Layout layout;
+	/** @brief Indeks baneru w układzie. */
+	int bannerNode{ Layout::ROOT };
+	/** @brief Indeksy przycisków w układzie. */
+	std::array<int, buttonCount> buttonNodes{};
+	/** @brief Indeks wybranego przycisku (-1, jeśli brak). */
+	int selected = -1;
+	/** @brief Nazwa użytkownika. */
+	std::string username;
 
-			size_t maxScores = std::min(static_cast<size_t>(10), scores.size());
-			float textY = frameY + 120; 
-			for (size_t i = 0; i < maxScores; i++) {
-				std::string entry = std::to_string(i + 1) + ". " + scores[i].username + ": " + std::to_string(scores[i].score);
-				DrawText(entry.c_str(), static_cast<int>(frameX + (frameWidth - MeasureText(entry.c_str(), 30)) / 2),
-					static_cast<int>(textY + i * 40), 30, BLACK);
-			}
+	/** @brief Referencja do zasobów gry. */
+	Resources& resources;
+	/** @brief Referencja do planszy gry. */
+	Board& board;
+	/** @brief Referencja do sklepu. */
+	Shop& shop;
+	/** @brief Statyczna treść menu narysowana do tekstury. */
+	RetainedLayer layer{ "Menu" };
+	/** @brief Tablica wyników; żyje razem z menu, więc przy kolejnych wejściach dociąga tylko nowe wyniki. */
+	Leaderboard leaderboard{ resources };
 
-			DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2,
-				screenHeight - 30, 20, BLACK);
+public:
+	/**
+	* @brief Konstruktor klasy Menu.
+	* @param res Referencja do zasobów gry.
+	* @param b Referencja do planszy gry.
+	* @param s Referencja do sklepu.
+	* @param user Nazwa zalogowanego użytkownika.
+	*/
+	Menu(Resources& res, Board& b, Shop& s, const std::string& user)
+		: username(user), resources(res), board(b), shop(s) {
+		buildLayout();
+	}
 
-			EndDrawing();
-		}
-	}*/
+	/**
+	 * @brief Obsługuje podświetlenie i kliknięcia przycisków.
+	 * @param scenes Stos scen.
+	 * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+	 */
+	void update(SceneManager& scenes, float deltaTime) override;
 
 	/**
-	 * @brief Otwiera sklep.
+	 * @brief Rysuje menu główne (z warstwy, przebudowywanej po zmianie rozmiaru lub podświetlenia).
 	 */
-	void openShop() {
-		if (shop && resources) {
-			shop->show(GetScreenWidth(), GetScreenHeight());
-		}
-	}
+	void render() override;
 
+private:
 	/**
-	 * @brief Wylogowuje uytkownika.
-	 * @param menuRunning Flaga wskazujca, czy menu powinno by nadal aktywne.
+	 * @brief Opisuje położenie baneru i przycisków względem okna.
 	 */
-	void LogOut(bool& menuRunning) const {
-		CloseWindow();
-		menuRunning = false;
-	}
+	void buildLayout();
 
 	/**
-	* @brief Zamyka gr.
-	* @param menuRunning Flaga wskazujca, czy menu powinno by nadal aktywne.
-	*/
-	void exitGame(bool& menuRunning) {
-		resources->unloadTextures();
-		menuRunning = false;
-		CloseWindow();
-		exit(0);
+	 * @brief Rysuje tło, baner, powitanie i przyciski.
+	 * @return Liczba wywołań rysujących.
+	 */
+	int drawStatic() const;
 
-	}
+	/**
+	 * @brief Rozpoczyna nową grę.
+	 * @param scenes Stos scen.
+	 */
+	void newGame(SceneManager& scenes);
 
 	/**
-	 * @brief Obsuguje kliknicie przycisku menu.
-	 * @param index Indeks kliknitego przycisku.
-	 * @param menuRunning Flaga wskazujca, czy menu powinno by nadal aktywne.
+	 * @brief Obsługuje kliknięcie przycisku menu.
+	 * @param scenes Stos scen.
+	 * @param index Indeks klikniętego przycisku.
 	 */
-	void handleClick(int index, bool& menuRunning) {
-		switch (index) {
-		case 0: newGame(); break;
-		case 1: showLeaderboard(GetScreenWidth(), GetScreenHeight()); break;
-		case 2: openShop(); break;
-		case 3: LogOut(menuRunning); break;
-		case 4: exitGame(menuRunning); break;
-		}
-	}
-};
\ No newline at end of file
+	void handleClick(SceneManager& scenes, int index);
+};
+
@@ -1,12 +1,10 @@
 module;
 #include "raylib.h"
 export module NebulaModule;
-import ResourcesModule;
 
 export class Nebula
 {
-	Resources res;
-	Texture2D texture{ res.getNebula() };
+	Texture2D texture{};
 	Vector2 screenPos;
 	//Vector2 worldPos{};
 
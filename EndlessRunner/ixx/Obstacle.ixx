@@ -1,8 +1,8 @@
 /**
  * @file Obstacle.ixx
- * @brief Modu definiujcy klas bazow dla przeszkd w grze.
+ * @brief Moduł definiujący klasę bazową dla przeszkód w grze.
  *
- * Klasa Obstacle dziedziczy po AnimatedSprite i definiuje wsplne zachowanie dla przeszkd.
+ * Klasa Obstacle dziedziczy po AnimatedSprite i definiuje wspólne zachowanie dla przeszkód.
  */
 
 
@@ -11,20 +11,32 @@ module;
 export module ObstacleModule;
 
 import AnimatedSpriteModule;
+import AnimationSystemModule;
+import DrawListModule;
 import ConfigModule;
 
 
+/**
+ * @struct ObstacleState
+ * @brief Stan przeszkody w zapisie planszy (rodzaj przeszkody zapisuje plansza).
+ */
+export struct ObstacleState {
+    float x{ 0.f };        /**< Pozycja X sprite'a. */
+    float y{ 0.f };        /**< Pozycja Y sprite'a. */
+    float velocity{ 0.f }; /**< Prędkość pozioma. */
+};
+
 /**
  * @class Obstacle
- * @brief Klasa bazowa dla przeszkd w grze.
+ * @brief Klasa bazowa dla przeszkód w grze.
  *
- * Odpowiada za ruch w lewo i jest klas abstrakcyjn dla konkretnych przeszkd (np. Bat, Pterodactyl).
+ * Odpowiada za ruch w lewo i jest klasą abstrakcyjną dla konkretnych przeszkód (np. Bat, Pterodactyl).
  */
 export class Obstacle : public AnimatedSprite {
 protected:
 
-    /** @brief Prdko przesuwania przeszkody w lewo (piksele/s). */
-    float velocity{ -200.f }; 
+    /** @brief Prędkość przesuwania przeszkody w lewo (piksele/s). */
+    float velocity{ -Config::BASE_WORLD_SPEED }; 
 
 public:
 
@@ -32,41 +44,69 @@ public:
     virtual ~Obstacle() = default;
 
     /**
-     * @brief Inicjalizuje przeszkod.
+     * @brief Inicjalizuje przeszkodę.
      * @param tex Tekstura przeszkody.
-     * @param startX Pocztkowa pozycja X.
-     * @param startY Pocztkowa pozycja Y.
+     * @param startX Początkowa pozycja X.
+     * @param startY Początkowa pozycja Y.
      * @param scaleFactor Skala przeszkody.
      * @param frameCount Liczba klatek animacji.
-     * @param animUpdateTime Czas midzy zmianami klatek.
+     * @param animUpdateTime Czas między zmianami klatek.
      */
     virtual void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME) override; /*{
         AnimatedSprite::init(tex, startX, startY, scaleFactor, frameCount, animUpdateTime);
     }*/
 
     /**
-    * @brief Aktualizuje stan przeszkody (ruch i animacj).
+    * @brief Przesuwa przeszkodę (animacją zajmuje się AnimationSystem).
     * @param deltaTime Czas od ostatniej klatki (w sekundach).
     */
-    virtual void update(float deltaTime) override;/* {
-        AnimatedSprite::update(deltaTime);
+    virtual void update(float deltaTime);/* {
         screenPos.x += velocity * deltaTime;
     }*/
 
     /**
-    * @brief Rysuje przeszkod na ekranie.
+    * @brief Zapisuje przeszkodę do listy poleceń rysowania.
+    * @param list Lista poleceń klatki.
     */
-    virtual void draw() const override = 0;
+    virtual void draw(DrawList& list) const override = 0;
 
     /**
-     * @brief Zwraca prostokt kolizji przeszkody.
-     * @return Prostokt kolizji w przestrzeni ekranu.
+     * @brief Zwraca prostokąt kolizji przeszkody.
+     * @return Prostokąt kolizji w przestrzeni ekranu.
      */
     virtual Rectangle getCollisionRec() const override = 0;
 
     /**
-     * @brief Zwraca pozycj X przeszkody.
-     * @return Wsprzdna X przeszkody.
+     * @brief Zwraca pozycję X przeszkody.
+     * @return Współrzędna X przeszkody.
      */
     virtual float getPositionX() const; /*{ return screenPos.x; }*/
+
+    /**
+     * @brief Ustawia prędkość przeszkody.
+     * @param newVelocity Prędkość w pikselach na sekundę (ujemna - ruch w lewo).
+     */
+    void setVelocity(float newVelocity);
+
+    /** @brief Zwraca stan przeszkody do zapisu planszy. @return Stan. */
+    ObstacleState getState() const { return { screenPos.x, screenPos.y, velocity }; }
+
+    /**
+     * @brief Przywraca zapisany stan (klatka animacji należy do klipu współdzielonego przez przeszkody z tą samą teksturą).
+     * @param state Stan.
+     */
+    void setState(const ObstacleState& state) {
+        screenPos = { state.x, state.y };
+        velocity = state.velocity;
+    }
+
+protected:
+    /**
+     * @brief Przeszkody z tą samą teksturą mają wspólny klip, więc animują się w jednej fazie.
+     * @param tex Tekstura przeszkody.
+     * @param frameCount Liczba klatek animacji.
+     * @param animUpdateTime Czas między zmianami klatek.
+     * @return Uchwyt do klipu współdzielonego.
+     */
+    AnimationClip makeClip(const Texture2D& tex, int frameCount, float animUpdateTime) override;
 };
\ No newline at end of file
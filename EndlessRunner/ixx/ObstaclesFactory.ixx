@@ -1,43 +1,45 @@
 /**
  * @file ObstacleFactory.ixx
- * @brief Modu definiujcy klas ObstacleFactory, tworzc przeszkody.
+ * @brief Moduł definiujący klasę ObstacleFactory, tworzącą przeszkody.
  *
- * Klasa ObstacleFactory generuje losowe przeszkody na podstawie typu ta gry.
+ * Klasa ObstacleFactory generuje losowe przeszkody na podstawie typu tła gry.
  */
 
 module;
 #include "raylib.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
 export module ObstacleFactoryModule;
 
 import BatModule;
 import PterodactylModule;
 import StaticObstacleModule;
 import ObstacleModule;
+import DrawListModule;
 import ConfigModule;
 import ResourcesModule;
-import <memory>;
-import <random>;
-import <vector>;
 
 
 /**
  * @concept ObstacleType
- * @brief Koncept dla typw przeszkd dziedziczcych po klasie Obstacle.
+ * @brief Koncept dla typów przeszkód dziedziczących po klasie Obstacle.
  *
- * Typy speniajce ten koncept musz dziedziczy po Obstacle oraz implementowa metody `init`, `update`, `draw` i `getCollisionRec` z okrelonymi sygnaturami.
+ * Typy spełniające ten koncept muszą dziedziczyć po Obstacle oraz implementować metody `init`, `update`, `draw` i `getCollisionRec` z określonymi sygnaturami.
  * @tparam T Typ obiektu do sprawdzenia.
  */
 export template<typename T>
-concept ObstacleType = std::derived_from<T, Obstacle>&& requires(T t, const Texture2D& tex, float x, float y, float scale, int frames, float time) {
+concept ObstacleType = std::derived_from<T, Obstacle>&& requires(T t, const Texture2D& tex, float x, float y, float scale, int frames, float time, DrawList& list) {
     { t.init(tex, x, y, scale, frames, time) } -> std::same_as<void>;
     { t.update(0.0f) } -> std::same_as<void>;
-    { t.draw() } -> std::same_as<void>;
+    { t.draw(list) } -> std::same_as<void>;
     { t.getCollisionRec() } -> std::same_as<Rectangle>;
 };
 
 /**
  * @enum BackgroundType
- * @brief Typy ta gry.
+ * @brief Typy tła gry.
  */
 export enum class BackgroundType {
     DESERT_DAY,
@@ -46,24 +48,63 @@ export enum class BackgroundType {
     FOREST_NIGHT
 };
 
+/**
+ * @enum ObstacleKind
+ * @brief Rodzaje przeszkód.
+ */
+export enum class ObstacleKind : std::uint8_t {
+    BAT,
+    PTERODACTYL,
+    STATIC
+};
+
+/**
+ * @struct ObstacleSpec
+ * @brief Opis przeszkody do utworzenia, niezależny od tekstur (można go losować poza wątkiem głównym).
+ */
+export struct ObstacleSpec {
+    /** @brief Rodzaj przeszkody. */
+    ObstacleKind kind{ ObstacleKind::STATIC };
+    /** @brief Indeks statycznej przeszkody w zestawie tła (0 - Config::STATIC_OBSTACLE_VARIANTS - 1). */
+    std::uint8_t variant{ 0 };
+};
+
+/**
+ * @struct ObstacleShape
+ * @brief Obrys nieprzezroczystych pikseli przeszkody (wspólny dla wszystkich klatek).
+ */
+export struct ObstacleShape {
+    /** @brief Odległość obrysu od lewej krawędzi sprite'a (w pikselach). */
+    float left{ 0.f };
+    /** @brief Szerokość obrysu (w pikselach). */
+    float width{ 0.f };
+    /** @brief Wysokość górnej krawędzi obrysu nad ziemią (w pikselach). */
+    float top{ 0.f };
+    /** @brief Wysokość dolnej krawędzi obrysu nad ziemią (w pikselach). */
+    float bottom{ 0.f };
+};
+
+/**
+ * @brief Losuje rodzaj i wariant przeszkody (po 20% nietoperz i pterodaktyl, reszta statyczne).
+ * @param gen Silnik losujący.
+ * @return Opis przeszkody.
+ */
+export ObstacleSpec rollObstacleSpec(std::mt19937& gen);
+
 /**
  * @class ObstacleFactory
- * @brief Klasa odpowiedzialna za tworzenie przeszkd.
+ * @brief Klasa odpowiedzialna za tworzenie przeszkód.
  *
- * Generuje losowe przeszkody (Bat, Pterodactyl, StaticObstacle) z uwzgldnieniem typu ta.
+ * Generuje losowe przeszkody (Bat, Pterodactyl, StaticObstacle) z uwzględnieniem typu tła.
  */
 export class ObstacleFactory {
 private:
-    /** @brief Referencja do zasobw gry. */
+    /** @brief Referencja do zasobów gry. */
     Resources& resources;
     /** @brief Generator liczb losowych. */
     std::random_device rd;
-    /** @brief Silnik losujcy. */
+    /** @brief Silnik losujący. */
     std::mt19937 gen{ rd() };
-    /** @brief Rozkad losujcy prawdopodobiestwo (0-99). */
-    std::uniform_int_distribution<> probabilityDis{ 0, 99 };
-    /** @brief Rozkad losujcy statyczne przeszkody (0-6). */
-    std::uniform_int_distribution<> staticDis{ 0, 6 }; 
 
    
     template<ObstacleType T>
@@ -76,16 +117,16 @@ private:
 public:
     /**
      * @brief Konstruktor klasy ObstacleFactory.
-     * @param res Referencja do zasobw gry.
+     * @param res Referencja do zasobów gry.
      */
     ObstacleFactory(Resources& res) : resources(res) {}
 
     /**
-     * @brief Tworzy now przeszkod.
-     * @param startX Pocztkowa pozycja X.
-     * @param startY Pocztkowa pozycja Y.
-     * @param bgType Typ ta gry.
-     * @return Unikalny wskanik do stworzonej przeszkody.
+     * @brief Tworzy nową przeszkodę.
+     * @param startX Początkowa pozycja X.
+     * @param startY Początkowa pozycja Y.
+     * @param bgType Typ tła gry.
+     * @return Unikalny wskaźnik do stworzonej przeszkody.
      */
     std::unique_ptr<Obstacle> createObstacle(float startX, float startY, BackgroundType bgType); /*{
         int roll = probabilityDis(gen); 
@@ -147,4 +188,30 @@ public:
             return createSpecificObstacle<StaticObstacle>(startX, startY, *selectedTex, 1);
         }
     }*/
+
+    /**
+     * @brief Tworzy przeszkodę według opisu.
+     * @param spec Opis przeszkody.
+     * @param startX Początkowa pozycja X.
+     * @param startY Początkowa pozycja Y.
+     * @param bgType Typ tła gry.
+     * @return Unikalny wskaźnik do stworzonej przeszkody.
+     */
+    std::unique_ptr<Obstacle> createObstacle(const ObstacleSpec& spec, float startX, float startY, BackgroundType bgType);
+
+    /**
+     * @brief Zwraca teksturę przeszkody.
+     * @param spec Opis przeszkody.
+     * @param bgType Typ tła gry.
+     * @return Referencja do tekstury.
+     */
+    const Texture2D& getTexture(const ObstacleSpec& spec, BackgroundType bgType);
+
+    /**
+     * @brief Wyznacza obrys przeszkody z jej maski kolizji (bez maski - cały prostokąt sprite'a).
+     * @param spec Opis przeszkody.
+     * @param bgType Typ tła gry.
+     * @return Obrys względem lewej krawędzi sprite'a i ziemi.
+     */
+    ObstacleShape getShape(const ObstacleSpec& spec, BackgroundType bgType);
 };
\ No newline at end of file
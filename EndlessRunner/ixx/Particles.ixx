@@ -0,0 +1,182 @@
+﻿/**
+ * @file Particles.ixx
+ * @brief Moduł definiujący system cząsteczek (pył biegu, lądowanie, zderzenie).
+ *
+ * Cząsteczki są przechowywane w puli o stałej pojemności w układzie struktura-tablic. Aktualizacja to jeden
+ * przebieg bez rozgałęzień, a rysowanie to jedna paczka czworokątów z jedną teksturą. Parametry emiterów
+ * są wczytywane z pliku tekstowego, więc efekty można stroić bez przebudowy gry.
+ */
+
+module;
+#include "raylib.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+export module ParticlesModule;
+
+import ConfigModule;
+import DrawListModule;
+import SnapshotModule;
+
+
+/**
+ * @enum EmitterKind
+ * @brief Rodzaj emitera cząsteczek.
+ */
+export enum class EmitterKind {
+    RUN_DUST, /**< Pył spod nóg biegnącego gracza. */
+    LANDING,  /**< Chmura pyłu po wylądowaniu. */
+    HIT,      /**< Odłamki przy zderzeniu z przeszkodą. */
+    COUNT     /**< Liczba rodzajów emiterów. */
+};
+
+/**
+ * @struct EmitterConfig
+ * @brief Parametry emitera (jedna linia pliku Config::PARTICLE_CONFIG_FILE).
+ */
+export struct EmitterConfig {
+    int count{ 1 };             /**< Liczba cząsteczek na jedno wywołanie emit(). */
+    float lifetime{ 0.5f };     /**< Czas życia cząsteczki (sekundy). */
+    float speedMin{ 0.f };      /**< Minimalna prędkość początkowa (piksele/s). */
+    float speedMax{ 0.f };      /**< Maksymalna prędkość początkowa (piksele/s). */
+    float angleMin{ 0.f };      /**< Minimalny kąt wyrzutu (stopnie, 0 - w prawo, 90 - w górę). */
+    float angleMax{ 0.f };      /**< Maksymalny kąt wyrzutu (stopnie). */
+    float gravity{ 0.f };       /**< Przyspieszenie pionowe (piksele/s^2, dodatnie - w dół). */
+    float sizeStart{ 1.f };     /**< Rozmiar na początku życia (wielokrotność klatki tekstury). */
+    float sizeEnd{ 1.f };       /**< Rozmiar na końcu życia. */
+    Color color{ WHITE };       /**< Kolor (przezroczystość maleje do zera z wiekiem). */
+};
+
+/**
+ * @class ParticleSystem
+ * @brief Pula cząsteczek o stałej pojemności z emiterami konfigurowanymi z pliku.
+ *
+ * Gdy pula jest pełna, nowe cząsteczki są pomijane. Jeśli aktualizacja i rysowanie przekroczą
+ * Config::PARTICLE_BUDGET_MS, emitery tymczasowo wypuszczają mniej cząsteczek.
+ */
+export class ParticleSystem {
+private:
+    /** @brief Pozycja X środka cząsteczki. */
+    std::vector<float> posX;
+    /** @brief Pozycja Y środka cząsteczki. */
+    std::vector<float> posY;
+    /** @brief Prędkość X. */
+    std::vector<float> velX;
+    /** @brief Prędkość Y. */
+    std::vector<float> velY;
+    /** @brief Przyspieszenie pionowe. */
+    std::vector<float> gravity;
+    /** @brief Wiek cząsteczki jako ułamek czasu życia (1 - koniec). */
+    std::vector<float> age;
+    /** @brief Odwrotność czasu życia. */
+    std::vector<float> inverseLifetime;
+    /** @brief Rozmiar początkowy. */
+    std::vector<float> sizeStart;
+    /** @brief Zmiana rozmiaru w ciągu życia. */
+    std::vector<float> sizeDelta;
+    /** @brief Kolor cząsteczki. */
+    std::vector<Color> color;
+    /** @brief Liczba żywych cząsteczek (zajmują indeksy [0, live)). */
+    std::size_t live{ 0 };
+
+    /** @brief Parametry emiterów. */
+    std::array<EmitterConfig, static_cast<std::size_t>(EmitterKind::COUNT)> emitters;
+    /** @brief Tekstura cząsteczek (arkusz klatek). */
+    Texture2D texture{};
+    /** @brief Liczba klatek w arkuszu; cząsteczka przechodzi przez nie w ciągu życia. */
+    int textureFrames{ 1 };
+    /** @brief Skala klatki tekstury. */
+    float textureScale{ 1.f };
+
+    /** @brief Generator liczb losowych. */
+    std::mt19937 gen{ std::random_device{}() };
+    /** @brief Mnożnik liczby emitowanych cząsteczek (zmniejszany po przekroczeniu budżetu). */
+    float spawnScale{ 1.f };
+    /** @brief Czas ostatniej aktualizacji (ms). */
+    double lastUpdateMs{ 0.0 };
+    /** @brief Czas ostatniego zapisu do listy rysowania (ms). */
+    mutable double lastDrawMs{ 0.0 };
+
+public:
+    /**
+     * @brief Tworzy pulę i ustawia domyślne parametry emiterów.
+     * @param capacity Maksymalna liczba żywych cząsteczek.
+     */
+    explicit ParticleSystem(std::size_t capacity = static_cast<std::size_t>(Config::PARTICLE_CAPACITY));
+
+    /**
+     * @brief Ustawia teksturę cząsteczek.
+     * @param tex Arkusz klatek.
+     * @param frames Liczba klatek w arkuszu.
+     * @param scale Skala klatki.
+     */
+    void setTexture(const Texture2D& tex, int frames, float scale);
+
+    /**
+     * @brief Wczytuje parametry emiterów z pliku.
+     *
+     * Każda linia: nazwa count lifetime speedMin speedMax angleMin angleMax gravity sizeStart sizeEnd r g b a.
+     * Linie puste i zaczynające się od '#' są pomijane, nieznane nazwy zgłaszane.
+     *
+     * @param path Ścieżka pliku.
+     * @return True, jeśli plik został wczytany (w przeciwnym razie zostają bieżące parametry).
+     */
+    bool loadEmitters(const std::string& path);
+
+    /**
+     * @brief Wypuszcza cząsteczki z emitera.
+     * @param kind Rodzaj emitera.
+     * @param x Pozycja X.
+     * @param y Pozycja Y.
+     * @param carryX Prędkość X dodawana do każdej cząsteczki (np. ruch świata).
+     */
+    void emit(EmitterKind kind, float x, float y, float carryX = 0.f);
+
+    /**
+     * @brief Przesuwa wszystkie cząsteczki i usuwa martwe.
+     * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Zapisuje wszystkie cząsteczki do listy rysowania (kolejne polecenia z jedną teksturą idą jedną paczką).
+     * @param list Lista poleceń klatki.
+     */
+    void draw(DrawList& list) const;
+
+    /**
+     * @brief Usuwa wszystkie cząsteczki.
+     */
+    void clear();
+
+    /**
+     * @brief Zapisuje żywe cząsteczki kolumnami (generator losowy nie jest zapisywany - wpływa tylko na wygląd).
+     * @param out Zapis stanu.
+     * @return False, jeśli zabrakło miejsca.
+     */
+    bool saveState(SnapshotWriter& out) const;
+
+    /**
+     * @brief Przywraca cząsteczki zapisane przez saveState().
+     * @param in Odczyt stanu.
+     * @return False, jeśli dane są niepełne lub cząsteczek jest więcej niż pojemność puli.
+     */
+    bool restoreState(SnapshotReader& in);
+
+    /** @brief Zwraca rozmiar stanu zapisywanego przez saveState(). @return Rozmiar w bajtach. */
+    std::size_t getStateBytes() const { return sizeof(std::uint32_t) + sizeof(float) + live * (9 * sizeof(float) + sizeof(Color)); }
+
+    /** @brief Zwraca parametry emitera. @param kind Rodzaj emitera. @return Referencja do parametrów. */
+    EmitterConfig& getEmitter(EmitterKind kind) { return emitters[static_cast<std::size_t>(kind)]; }
+    /** @brief Zwraca liczbę żywych cząsteczek. @return Liczba cząsteczek. */
+    std::size_t getLiveCount() const { return live; }
+    /** @brief Zwraca pojemność puli. @return Maksymalna liczba cząsteczek. */
+    std::size_t getCapacity() const { return posX.size(); }
+    /** @brief Zwraca mnożnik emisji. @return Wartość z zakresu (0, 1]. */
+    float getSpawnScale() const { return spawnScale; }
+    /** @brief Zwraca czas ostatniej aktualizacji. @return Czas w ms. */
+    double getLastUpdateMs() const { return lastUpdateMs; }
+};
@@ -0,0 +1,28 @@
+﻿/**
+ * @file Platform.ixx
+ * @brief Moduł z funkcjami zależnymi od systemu operacyjnego.
+ *
+ * Platform.cpp dołącza windows.h, więc nie może dołączyć raylib.h (nazwy takie jak Rectangle czy CloseWindow
+ * kolidują) - dlatego readKeyAsync() przyjmuje kod klawisza raylib jako int, a nie KeyboardKey.
+ */
+
+module;
+#include <cstdint>
+export module PlatformModule;
+
+
+/**
+ * @brief Zwraca czas procesora zużyty przez proces (wszystkie wątki, tryb użytkownika i jądra).
+ * @return Czas w sekundach lub 0, jeśli system go nie udostępnia.
+ */
+export double processCpuSeconds();
+
+/**
+ * @brief Odczytuje fizyczny stan klawisza z pominięciem kolejki zdarzeń okna.
+ * Działa tylko w Windows i tylko wtedy, gdy okno gry jest na pierwszym planie.
+ * @param keyCode Kod klawisza raylib (KeyboardKey).
+ * @param window Uchwyt okna (GetWindowHandle()).
+ * @param down Miejsce na stan klawisza.
+ * @return False, jeśli odczyt nie jest możliwy (inny system, brak fokusu, klawisz bez odpowiednika).
+ */
+export bool readKeyAsync(int keyCode, std::intptr_t window, bool& down);
@@ -7,13 +7,35 @@
 
 module;
 #include "raylib.h"
+#include <array>
+#include <cstdint>
 #include <iostream>
 export module PlayerModule;
 
 import AnimatedSpriteModule;
 import ConfigModule;
+import DrawListModule;
 
 
+/**
+ * @struct PlayerState
+ * @brief Stan gracza w zapisie planszy (fizyka, zgłoszone skoki i faza animacji biegu).
+ */
+export struct PlayerState {
+    float x{ 0.f };                                    /**< Pozycja X sprite'a. */
+    float y{ 0.f };                                    /**< Pozycja Y sprite'a. */
+    float velocity{ 0.f };                             /**< Prędkość pionowa. */
+    float groundLevel{ 0.f };                          /**< Poziom ziemi. */
+    std::array<float, Config::MAX_JUMPS> jumpOffsets{}; /**< Chwile zgłoszonych skoków. */
+    std::int32_t jumpCount{ 0 };                       /**< Liczba skoków bieżącego lotu. */
+    std::int32_t pendingJumps{ 0 };                    /**< Liczba zgłoszonych skoków. */
+    std::uint32_t jumpsTaken{ 0 };                     /**< Liczba skoków od init(). */
+    float animationPhase{ 0.f };                       /**< Faza animacji biegu. */
+    std::uint8_t inAir{ 0 };                           /**< Flaga lotu. */
+    std::uint8_t silent{ 0 };                          /**< Flaga wyciszenia. */
+    std::uint8_t reserved[2]{};                        /**< Zarezerwowane (0). */
+};
+
 /**
  * @class Player
  * @brief Klasa reprezentująca gracza w grze.
@@ -36,6 +58,20 @@ private:
     const int maxJumps{ Config::MAX_JUMPS };
     /** @brief Poziom ziemi (pozycja Y podstawy). */
     float groundLevel{ 0.f };
+    /** @brief Chwile wciśnięć skoku wewnątrz najbliższego kroku (wejście czyta wątek okna, nie symulacja). */
+    std::array<float, Config::MAX_JUMPS> jumpOffsets{};
+    /** @brief Liczba zgłoszonych skoków w jumpOffsets. */
+    int pendingJumps{ 0 };
+    /** @brief Liczba skoków od init(). */
+    std::uint32_t jumpsTaken{ 0 };
+    /** @brief Flaga wyciszenia dźwięku skoku (boty). */
+    bool silent{ false };
+
+    /**
+     * @brief Przesuwa gracza o odcinek kroku (grawitacja, ruch, lądowanie).
+     * @param deltaTime Długość odcinka (w sekundach).
+     */
+    void integrate(float deltaTime);
 
 public:
     /**
@@ -92,6 +128,46 @@ public:
         }
     }*/
 
+    /**
+    * @brief Zgłasza wciśnięcie skoku; zostanie obsłużone w najbliższej aktualizacji.
+    * Nadmiarowe zgłoszenia (więcej niż Config::MAX_JUMPS na krok) są pomijane.
+    * @param offset Chwila skoku liczona od początku kroku (w sekundach); 0 - na początku, jak wejście z granicy klatki.
+    */
+    void requestJump(float offset = 0.f);
+
+    /**
+    * @brief Wycisza dźwięki gracza (np. setki botów nie zapychają kolejki miksera).
+    * @param enabled True, aby wyciszyć.
+    */
+    void setSilent(bool enabled) { silent = enabled; }
+
+    /** @brief Zwraca stan gracza do zapisu planszy. @return Stan. */
+    PlayerState getState() const;
+
+    /**
+    * @brief Przywraca zapisany stan (gracz musi być zainicjalizowany tą samą teksturą).
+    * @param state Stan.
+    */
+    void setState(const PlayerState& state);
+
+    /** @brief Zwraca prędkość pionową gracza. @return Prędkość w pikselach na sekundę (ujemna - w górę). */
+    float getVerticalVelocity() const { return velocity; }
+
+    /** @brief Zwraca liczbę skoków od init(). @return Liczba skoków. */
+    std::uint32_t getJumpsTaken() const { return jumpsTaken; }
+
+    /** @brief Zwraca wysokość gracza nad ziemią. @return Wysokość w pikselach (0 na ziemi). */
+    float getHeightAboveGround() const { return groundLevel - height * scale - screenPos.y; }
+
+    /**
+    * @brief Zapisuje do listy sylwetkę gracza na innej wysokości (duch najlepszego przebiegu).
+    * @param list Lista poleceń klatki.
+    * @param heightAboveGround Wysokość ducha nad ziemią (w pikselach).
+    * @param time Czas odtwarzania ducha (wybiera klatkę animacji biegu).
+    * @param tint Kolor z przezroczystością.
+    */
+    void drawGhost(DrawList& list, float heightAboveGround, float time, Color tint) const;
+
     /**
     * @brief Sprawdza, czy gracz jest na ziemi.
     * @param windowHeight Wysokość okna gry.
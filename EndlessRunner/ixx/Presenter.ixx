@@ -0,0 +1,109 @@
+﻿/**
+ * @file Presenter.ixx
+ * @brief Moduł odpowiedzialny za wyświetlanie świata gry w oknie (natywnie albo przez stałą teksturę niskiej rozdzielczości).
+ *
+ * W trybie natywnym świat jest rysowany prosto do okna w jego bieżącym rozmiarze, więc koszt wypełniania
+ * rośnie z rozdzielczością. W trybie stałym świat ma zawsze logiczny rozmiar Config::DEFAULT_WINDOW_WIDTH
+ * x Config::DEFAULT_WINDOW_HEIGHT, jest rysowany do tekstury Config::INTERNAL_RENDER_WIDTH
+ * x Config::INTERNAL_RENDER_HEIGHT i powiększany w oknie całkowitą wielokrotnością (próbkowanie najbliższego
+ * sąsiada, czarne pasy na brzegach).
+ */
+
+module;
+#include "raylib.h"
+#include <string_view>
+export module PresenterModule;
+
+import ConfigModule;
+
+
+/**
+ * @enum RenderMode
+ * @brief Sposób rysowania świata gry.
+ */
+export enum class RenderMode {
+    NATIVE, /**< Bezpośrednio do okna w jego rozdzielczości. */
+    FIXED   /**< Do tekstury o stałej rozdzielczości, powiększanej w oknie. */
+};
+
+/**
+ * @class Presenter
+ * @brief Przekierowuje rysowanie świata do tekstury o stałej rozdzielczości i wyświetla ją w oknie.
+ *
+ * Scena rozgrywki rysuje wszystko między begin() a end() we współrzędnych logicznych (getWorldWidth()
+ * x getWorldHeight()); w trybie natywnym obie funkcje nic nie robią.
+ */
+export class Presenter {
+private:
+    /** @brief Wybrany tryb. */
+    RenderMode mode{ RenderMode::NATIVE };
+    /** @brief Tekstura docelowa trybu stałego (id 0, dopóki nie powstanie). */
+    RenderTexture2D target{};
+
+public:
+    Presenter() = default;
+    Presenter(const Presenter&) = delete;
+    Presenter& operator=(const Presenter&) = delete;
+
+    /**
+     * @brief Zwalnia teksturę docelową (o ile okno jeszcze istnieje).
+     */
+    ~Presenter();
+
+    /**
+     * @brief Ustawia tryb rysowania.
+     * @param newMode Nowy tryb.
+     */
+    void setMode(RenderMode newMode) { mode = newMode; }
+
+    /** @brief Zwraca bieżący tryb. @return Tryb rysowania. */
+    RenderMode getMode() const { return mode; }
+
+    /** @brief Zwraca logiczną szerokość świata. @return Szerokość okna (natywnie) albo Config::DEFAULT_WINDOW_WIDTH. */
+    int getWorldWidth() const;
+    /** @brief Zwraca logiczną wysokość świata. @return Wysokość okna (natywnie) albo Config::DEFAULT_WINDOW_HEIGHT. */
+    int getWorldHeight() const;
+
+    /**
+     * @brief Zaczyna rysowanie świata (w trybie stałym do tekstury, ze skalą świat -> tekstura).
+     */
+    void begin();
+
+    /**
+     * @brief Kończy rysowanie świata i w trybie stałym wyświetla teksturę w oknie.
+     */
+    void end();
+
+    /**
+     * @brief Wyznacza prostokąt okna, w którym wyświetlana jest tekstura trybu stałego.
+     *
+     * Powiększenie to największa całkowita wielokrotność mieszcząca się w oknie (w oknie mniejszym niż
+     * tekstura - pomniejszenie z zachowaniem proporcji); prostokąt jest wyśrodkowany.
+     *
+     * @param screenWidth Szerokość okna.
+     * @param screenHeight Wysokość okna.
+     * @return Prostokąt w pikselach okna.
+     */
+    static Rectangle viewport(int screenWidth, int screenHeight);
+};
+
+/**
+ * @brief Zwraca wspólny dla całego procesu obiekt wyświetlania.
+ * @return Referencja do obiektu Presenter.
+ */
+export Presenter& presenter();
+
+/**
+ * @brief Zamienia nazwę trybu (native, fixed) na wartość wyliczenia.
+ * @param name Nazwa trybu.
+ * @param out Miejsce na tryb.
+ * @return True, jeśli nazwa jest poprawna.
+ */
+export bool parseRenderMode(std::string_view name, RenderMode& out);
+
+/**
+ * @brief Zwraca nazwę trybu.
+ * @param renderMode Tryb.
+ * @return Nazwa trybu.
+ */
+export const char* renderModeName(RenderMode renderMode);
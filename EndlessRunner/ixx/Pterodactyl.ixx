@@ -1,6 +1,6 @@
 /**
  * @file Pterodactyl.ixx
- * @brief Modu definiujcy klas Pterodactyl, reprezentujc przeszkod typu pterodaktyl.
+ * @brief Moduł definiujący klasę Pterodactyl, reprezentującą przeszkodę typu pterodaktyl.
  *
  * Klasa Pterodactyl dziedziczy po Obstacle i specjalizuje zachowanie dla pterodaktyla.
  */
@@ -10,24 +10,25 @@ module;
 export module PterodactylModule;
 
 import ObstacleModule;
+import DrawListModule;
 import ConfigModule;
 
 /**
  * @class Pterodactyl
- * @brief Klasa reprezentujca przeszkod typu pterodaktyl.
+ * @brief Klasa reprezentująca przeszkodę typu pterodaktyl.
  *
- * Pterodactyl jest animowan przeszkod, ktra porusza si w lewo i pojawia si na okrelonej wysokoci.
+ * Pterodactyl jest animowaną przeszkodą, która porusza się w lewo i pojawia się na określonej wysokości.
  */
 export class Pterodactyl : public Obstacle {
 public:
     /**
     * @brief Inicjalizuje pterodaktyla.
     * @param tex Tekstura pterodaktyla.
-    * @param startX Pocztkowa pozycja X.
-    * @param startY Pocztkowa pozycja Y (przesunita o 260 pikseli w gr).
+    * @param startX Początkowa pozycja X.
+    * @param startY Początkowa pozycja Y (przesunięta w górę o Config::PTERODACTYL_ALTITUDE).
     * @param scaleFactor Skala animacji.
     * @param frameCount Liczba klatek animacji.
-    * @param animUpdateTime Czas midzy zmianami klatek.
+    * @param animUpdateTime Czas między zmianami klatek.
     */
     void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME) override;/* {
         Obstacle::init(tex, startX, startY - 260.f, scaleFactor, frameCount, animUpdateTime);
@@ -42,15 +43,16 @@ public:
     }*/
 
     /**
-     * @brief Rysuje pterodaktyla na ekranie.
+     * @brief Zapisuje pterodaktyla do listy poleceń rysowania.
+     * @param list Lista poleceń klatki.
      */
-    void draw() const override; /*{
-        AnimatedSprite::draw();
+    void draw(DrawList& list) const override; /*{
+        AnimatedSprite::draw(list);
     }*/
 
     /**
-    * @brief Zwraca prostokt kolizji pterodaktyla.
-    * @return Prostokt kolizji w przestrzeni ekranu.
+    * @brief Zwraca prostokąt kolizji pterodaktyla.
+    * @return Prostokąt kolizji w przestrzeni ekranu.
     */
     Rectangle getCollisionRec() const override; /*{
         return AnimatedSprite::getCollisionRec();
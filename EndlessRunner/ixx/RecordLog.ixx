@@ -0,0 +1,118 @@
+﻿/**
+ * @file RecordLog.ixx
+ * @brief Moduł definiujący klasę RecordLog - plik rekordów tekstowych dopisywanych przez wiele procesów.
+ *
+ * Zapis dopisuje cały rekord jednym wywołaniem systemowym pod blokadą doradczą (POSIX flock, Windows LockFileEx
+ * na bajcie daleko za końcem pliku), więc rekordy z różnych instancji gry nigdy się nie przeplatają. Odczyt
+ * nie bierze blokady: czytelnik pamięta pozycję za ostatnim pełnym wierszem i przy kolejnym wywołaniu
+ * czyta tylko to, co dopisano; niedokończony wiersz zostaje na następny raz.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+export module RecordLogModule;
+
+import ConfigModule;
+
+
+/**
+ * @enum AppendResult
+ * @brief Wynik dopisania rekordu.
+ */
+export enum class AppendResult {
+    WRITTEN,  /**< Rekord dopisany. */
+    REJECTED, /**< Warunek sprawdzany pod blokadą nie został spełniony. */
+    FAILED    /**< Nie udało się otworzyć, zablokować lub zapisać pliku (albo rekord zawiera znak nowej linii). */
+};
+
+/**
+ * @struct ReadResult
+ * @brief Wynik odczytu nowych rekordów.
+ */
+export struct ReadResult {
+    /** @brief Liczba przekazanych rekordów. */
+    std::size_t records{ 0 };
+    /**
+     * @brief True, jeśli plik był krótszy niż zapamiętana pozycja (skrócony, podmieniony lub usunięty).
+     *        Pozycja wraca wtedy na początek, ale nic nie jest przekazywane - wywołujący czyści swój stan
+     *        i wywołuje readNew() ponownie.
+     */
+    bool restarted{ false };
+};
+
+/**
+ * @class RecordLog
+ * @brief Plik rekordów (po jednym w wierszu), bezpieczny przy jednoczesnym dostępie wielu procesów.
+ */
+export class RecordLog {
+private:
+    /** @brief Ścieżka pliku. */
+    std::string path;
+    /** @brief Pozycja za ostatnim przeczytanym pełnym wierszem. */
+    std::uint64_t offset{ 0 };
+
+    /**
+     * @brief Dopisuje gotowy tekst (pełne wiersze) jednym zapisem pod wyłączną blokadą.
+     * @param text Tekst zakończony znakiem nowej linii.
+     * @param precondition Warunek zapisu sprawdzany pod blokadą (pusty - zawsze spełniony).
+     * @return Wynik dopisania.
+     */
+    AppendResult writeLocked(std::string_view text, const std::function<bool()>& precondition);
+
+public:
+    /**
+     * @brief Tworzy dziennik dla pliku (plik powstaje przy pierwszym zapisie).
+     * @param filePath Ścieżka pliku.
+     */
+    explicit RecordLog(std::string filePath);
+
+    /**
+     * @brief Dopisuje rekord na końcu pliku.
+     *
+     * Rekord i znak nowej linii trafiają do pliku jednym zapisem pod wyłączną blokadą. Jeśli podano warunek,
+     * jest on wywoływany już pod blokadą (np. po readNew()), więc żaden inny proces nie dopisze
+     * niczego między sprawdzeniem a zapisem.
+     *
+     * @param record Treść rekordu (bez znaku nowej linii).
+     * @param precondition Warunek zapisu (pusty - zawsze spełniony).
+     * @return Wynik dopisania.
+     */
+    AppendResult append(std::string_view record, const std::function<bool()>& precondition = {});
+
+    /**
+     * @brief Dopisuje kilka rekordów jednym zapisem pod jedną blokadą (pusta lista niczego nie zmienia).
+     * @param records Treści rekordów (bez znaków nowej linii).
+     * @return Wynik dopisania.
+     */
+    AppendResult appendBatch(const std::vector<std::string>& records);
+
+    /**
+     * @brief Dopisuje surowe bajty (np. blok binarny) jednym zapisem pod wyłączną blokadą.
+     * Plik z takimi blokami nie jest plikiem wierszy - readNew() nie ma do niego zastosowania.
+     * @param bytes Dane.
+     * @return Wynik dopisania.
+     */
+    AppendResult appendBytes(std::string_view bytes);
+
+    /**
+     * @brief Przekazuje rekordy dopisane od poprzedniego wywołania (bez blokady).
+     * @param onRecord Funkcja wywoływana dla każdego pełnego wiersza (bez znaku nowej linii).
+     * @return Liczba rekordów i informacja, czy plik trzeba przeczytać od początku.
+     */
+    ReadResult readNew(const std::function<void(std::string_view)>& onRecord);
+
+    /**
+     * @brief Cofa pozycję odczytu na początek pliku.
+     */
+    void rewind() { offset = 0; }
+
+    /** @brief Zwraca ścieżkę pliku. @return Ścieżka. */
+    const std::string& getPath() const { return path; }
+    /** @brief Zwraca pozycję odczytu. @return Liczba przeczytanych bajtów. */
+    std::uint64_t getOffset() const { return offset; }
+};
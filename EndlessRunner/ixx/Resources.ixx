@@ -1,8 +1,8 @@
 /**
  * @file Resources.ixx
- * @brief Modu definiujcy klas Resources, zarzdzajc teksturami gry.
+ * @brief Moduł definiujący klasę Resources, zarządzającą teksturami gry.
  *
- * Klasa Resources odpowiada za adowanie, przechowywanie i udostpnianie tekstur uywanych w grze.
+ * Klasa Resources odpowiada za ładowanie, przechowywanie i udostępnianie tekstur używanych w grze.
  */
 
 module;
@@ -13,15 +13,22 @@ module;
 #include <filesystem>
 #include <ranges>
 #include <concepts>
+#include <chrono>
+#include <cstddef>
+#include <vector>
 
 export module ResourcesModule;
 
+import CollisionMaskModule;
+import ConfigModule;
+import TextureCacheModule;
+
 
 /**
  * @concept TextureType
- * @brief Koncept dla typw tekstur zgodnych z Texture2D.
+ * @brief Koncept dla typów tekstur zgodnych z Texture2D.
  *
- * Typy speniajce ten koncept musz by typu Texture2D oraz posiada pola `id`, `width` i `height` konwertowalne odpowiednio na `unsigned int` i `int`.
+ * Typy spełniające ten koncept muszą być typu Texture2D oraz posiadać pola `id`, `width` i `height` konwertowalne odpowiednio na `unsigned int` i `int`.
  * @tparam T Typ obiektu do sprawdzenia.
  */
 export template<typename T>
@@ -33,34 +40,54 @@ concept TextureType = std::same_as<T, Texture2D>&& requires(T t) {
 
 /**
  * @class Resources
- * @brief Klasa zarzdzajca teksturami gry.
+ * @brief Klasa zarządzająca teksturami gry.
  *
- * Odpowiada za adowanie, przechowywanie i udostpnianie tekstur dla elementw gry, takich jak ta, sprite'y i interfejs uytkownika.
+ * Odpowiada za ładowanie, przechowywanie i udostępnianie tekstur dla elementów gry, takich jak tła, sprite'y i interfejs użytkownika.
  */
 export class Resources {
 private:
-    /** @brief Mapa przechowujca tekstury z kluczami w formacie std::string. */
-    std::unordered_map<std::string, Texture2D> textures;
+    /** @brief Mapa przechowująca uchwyty tekstur z kluczami w formacie std::string. */
+    std::unordered_map<std::string, TextureHandle> textures;
+    /** @brief Maski kolizji sprite'ów, indeksowane identyfikatorem tekstury. */
+    std::unordered_map<unsigned int, CollisionMask> collisionMasks;
+    /** @brief Indeks następnej tekstury do wczytania z manifestu. */
+    std::size_t loadCursor{ 0 };
+    /** @brief Flaga wczytywania tekstur po kawałku. */
+    bool loading{ false };
+    /** @brief Początek wczytywania tekstur. */
+    std::chrono::steady_clock::time_point loadStart{};
+
+    /**
+     * @struct TextureSource
+     * @brief Tekstura do wczytania: klucz i ścieżka pliku.
+     */
+    struct TextureSource {
+        const std::string* key; /**< Klucz tekstury. */
+        const char* path;       /**< Ścieżka do pliku tekstury. */
+    };
+
+    /** @brief Liczba tekstur na początku manifestu potrzebnych ekranowi ładowania. */
+    static constexpr std::size_t LOADING_SCREEN_TEXTURES = 3;
 
     /**
      * @struct TextureKeys
-     * @brief Struktura grupujca klucze tekstur wedug kategorii.
+     * @brief Struktura grupująca klucze tekstur według kategorii.
      */
     struct TextureKeys {
         /**
           * @struct UI
-          * @brief Klucze dla tekstur interfejsu uytkownika.
+          * @brief Klucze dla tekstur interfejsu użytkownika.
           */
         struct UI {
-            inline static const std::string MENU_BG = "menu_background"; /**< To menu gwnego. */
-            inline static const std::string LOADING_SCREEN_BG = "loading_screen_background"; /**< To ekranu adowania. */
-            inline static const std::string BAR_EMPTY = "loading_bar_empty"; /**< Pusty pasek adowania. */
-            inline static const std::string BAR_FULL = "loading_bar_full"; /**< Wypeniony pasek adowania. */
-            inline static const std::string REGISTRATION_BG = "registration"; /**< To ekranu rejestracji. */
-            inline static const std::string SHOP_BG = "shop_background"; /**< To sklepu. */
-            inline static const std::string LEADERBOARD = "leaderboard"; /**< To tablicy wynikw. */
-            inline static const std::string HEART_ICON = "heart_icon"; /**< Ikona ycia. */
-            inline static const std::string LIFE_LOST_ICON = "life_lost_icon"; /**< Ikona utraconego ycia. */
+            inline static const std::string MENU_BG = "menu_background"; /**< Tło menu głównego. */
+            inline static const std::string LOADING_SCREEN_BG = "loading_screen_background"; /**< Tło ekranu ładowania. */
+            inline static const std::string BAR_EMPTY = "loading_bar_empty"; /**< Pusty pasek ładowania. */
+            inline static const std::string BAR_FULL = "loading_bar_full"; /**< Wypełniony pasek ładowania. */
+            inline static const std::string REGISTRATION_BG = "registration"; /**< Tło ekranu rejestracji. */
+            inline static const std::string SHOP_BG = "shop_background"; /**< Tło sklepu. */
+            inline static const std::string LEADERBOARD = "leaderboard"; /**< Tło tablicy wyników. */
+            inline static const std::string HEART_ICON = "heart_icon"; /**< Ikona życia. */
+            inline static const std::string LIFE_LOST_ICON = "life_lost_icon"; /**< Ikona utraconego życia. */
             inline static const std::string NUMBERS = "numbers"; /**< Tekstura cyfr. */
             inline static const std::string BUTTON = "button"; /**< Tekstura przycisku. */
             inline static const std::string BANNER = "banner"; /**< Tekstura baneru. */
@@ -71,174 +98,116 @@ private:
           * @brief Klucze dla tekstur postaci i animacji.
           */
         struct Characters {
-            inline static const std::string DINO_SHADOW = "dino_shadow"; /**< Cie dinozaura. */
-            inline static const std::string DUST_RUN = "dust_run"; /**< Efekt pyu podczas biegu. */
-            inline static const std::string GREEN_DINO_IDLE = "green_dino_idle"; /**< Zielony dinozaur w stanie bezczynnoci. */
-            inline static const std::string BLUE_DINO_IDLE = "blue_dino_idle"; /**< Niebieski dinozaur w stanie bezczynnoci. */
-            inline static const std::string YELLOW_DINO_IDLE = "yellow_dino_idle"; /**< ty dinozaur w stanie bezczynnoci. */
-            inline static const std::string RED_DINO_IDLE = "red_dino_idle"; /**< Czerwony dinozaur w stanie bezczynnoci. */
+            inline static const std::string DINO_SHADOW = "dino_shadow"; /**< Cień dinozaura. */
+            inline static const std::string DUST_RUN = "dust_run"; /**< Efekt pyłu podczas biegu. */
+            inline static const std::string GREEN_DINO_IDLE = "green_dino_idle"; /**< Zielony dinozaur w stanie bezczynności. */
+            inline static const std::string BLUE_DINO_IDLE = "blue_dino_idle"; /**< Niebieski dinozaur w stanie bezczynności. */
+            inline static const std::string YELLOW_DINO_IDLE = "yellow_dino_idle"; /**< Żółty dinozaur w stanie bezczynności. */
+            inline static const std::string RED_DINO_IDLE = "red_dino_idle"; /**< Czerwony dinozaur w stanie bezczynności. */
             inline static const std::string GREEN_DINO_RUN = "green_dino_run"; /**< Zielony dinozaur podczas biegu. */
             inline static const std::string BLUE_DINO_RUN = "blue_dino_run"; /**< Niebieski dinozaur podczas biegu. */
-            inline static const std::string YELLOW_DINO_RUN = "yellow_dino_run"; /**< ty dinozaur podczas biegu. */
+            inline static const std::string YELLOW_DINO_RUN = "yellow_dino_run"; /**< Żółty dinozaur podczas biegu. */
             inline static const std::string RED_DINO_RUN = "red_dino_run"; /**< Czerwony dinozaur podczas biegu. */
-            inline static const std::string NEBULA = "nebula"; /**< Tekstura mgawicy. */
+            inline static const std::string NEBULA = "nebula"; /**< Tekstura mgławicy. */
             inline static const std::string PTERO = "pterosaur"; /**< Tekstura pterodaktyla. */
             inline static const std::string BAT = "bat"; /**< Tekstura nietoperza. */
         };
 
         /**
           * @struct Backgrounds
-          * @brief Klucze dla tekstur ta gry.
+          * @brief Klucze dla tekstur tła gry.
           */
         struct Backgrounds {
-            inline static const std::string GAME_BG = "game_background"; /**< Oglne to gry. */
-            inline static const std::string GAME_MG = "game_midground"; /**< Oglny plan rodkowy gry. */
-            inline static const std::string GAME_FG = "game_foreground"; /**< Oglny plan przedni gry. */
-            inline static const std::string DESERT_BG = "desert_background"; /**< To pustyni za dnia. */
-            inline static const std::string DESERT_MG = "desert_midground"; /**< Plan rodkowy pustyni za dnia. */
+            inline static const std::string GAME_BG = "game_background"; /**< Ogólne tło gry. */
+            inline static const std::string GAME_MG = "game_midground"; /**< Ogólny plan środkowy gry. */
+            inline static const std::string GAME_FG = "game_foreground"; /**< Ogólny plan przedni gry. */
+            inline static const std::string DESERT_BG = "desert_background"; /**< Tło pustyni za dnia. */
+            inline static const std::string DESERT_MG = "desert_midground"; /**< Plan środkowy pustyni za dnia. */
             inline static const std::string DESERT_FG = "desert_foreground"; /**< Plan przedni pustyni za dnia. */
-            inline static const std::string DESERT_GR = "desert_ground"; /**< Podoe pustyni za dnia. */
-            inline static const std::string DESERT_NIGHT_BG = "desert_night_background"; /**< To pustyni w nocy. */
-            inline static const std::string DESERT_NIGHT_MG = "desert_night_midground"; /**< Plan rodkowy pustyni w nocy. */
+            inline static const std::string DESERT_GR = "desert_ground"; /**< Podłoże pustyni za dnia. */
+            inline static const std::string DESERT_NIGHT_BG = "desert_night_background"; /**< Tło pustyni w nocy. */
+            inline static const std::string DESERT_NIGHT_MG = "desert_night_midground"; /**< Plan środkowy pustyni w nocy. */
             inline static const std::string DESERT_NIGHT_FG = "desert_night_foreground"; /**< Plan przedni pustyni w nocy. */
-            inline static const std::string DESERT_NIGHT_GR = "desert_night_ground"; /**< Podoe pustyni w nocy. */
-            inline static const std::string FOREST_BG = "forest_background"; /**< To lasu za dnia. */
-            inline static const std::string FOREST_MG = "forest_midground"; /**< Plan rodkowy lasu za dnia. */
+            inline static const std::string DESERT_NIGHT_GR = "desert_night_ground"; /**< Podłoże pustyni w nocy. */
+            inline static const std::string FOREST_BG = "forest_background"; /**< Tło lasu za dnia. */
+            inline static const std::string FOREST_MG = "forest_midground"; /**< Plan środkowy lasu za dnia. */
             inline static const std::string FOREST_FG = "forest_foreground"; /**< Plan przedni lasu za dnia. */
-            inline static const std::string FOREST_GR = "forest_ground"; /**< Podoe lasu za dnia. */
-            inline static const std::string FOREST_NIGHT_BG = "forest_night_background"; /**< To lasu w nocy. */
-            inline static const std::string FOREST_NIGHT_MG = "forest_night_midground"; /**< Plan rodkowy lasu w nocy. */
+            inline static const std::string FOREST_GR = "forest_ground"; /**< Podłoże lasu za dnia. */
+            inline static const std::string FOREST_NIGHT_BG = "forest_night_background"; /**< Tło lasu w nocy. */
+            inline static const std::string FOREST_NIGHT_MG = "forest_night_midground"; /**< Plan środkowy lasu w nocy. */
             inline static const std::string FOREST_NIGHT_FG = "forest_night_foreground"; /**< Plan przedni lasu w nocy. */
-            inline static const std::string FOREST_NIGHT_GR = "forest_night_ground"; /**< Podoe lasu w nocy. */
+            inline static const std::string FOREST_NIGHT_GR = "forest_night_ground"; /**< Podłoże lasu w nocy. */
         };
 
         /**
           * @struct Obstacles
-          * @brief Klucze dla tekstur przeszkd statycznych.
+          * @brief Klucze dla tekstur przeszkód statycznych.
           */
         struct Obstacles {
-            inline static const std::string SMALL_CACTUS = "small_cactus"; /**< May kaktus. */
-            inline static const std::string BIG_CACTUS = "big_cactus"; /**< Duy kaktus. */
+            inline static const std::string SMALL_CACTUS = "small_cactus"; /**< Mały kaktus. */
+            inline static const std::string BIG_CACTUS = "big_cactus"; /**< Duży kaktus. */
             inline static const std::string SKULLS = "skulls"; /**< Czaszki (pierwszy wariant). */
             inline static const std::string SKULLS2 = "skulls2"; /**< Czaszki (drugi wariant). */
-            inline static const std::string ROCK_D = "rock_d"; /**< Kamie pustynny za dnia. */
-            inline static const std::string BIG_ROCK_D = "big_rock_d"; /**< Duy kamie pustynny za dnia. */
-            inline static const std::string ROCK_D_N = "rock_d_n"; /**< Kamie pustynny w nocy. */
-            inline static const std::string BIG_ROCK_D_N = "big_rock_d_n"; /**< Duy kamie pustynny w nocy. */
-            inline static const std::string ROCK_F = "rock"; /**< Kamie leny. */
-            inline static const std::string BIG_ROCK_F = "big_rock"; /**< Duy kamie leny. */
-            inline static const std::string SMALL_TREE = "small_tree"; /**< Mae drzewo lene. */
-            inline static const std::string BIG_TREE = "big_tree"; /**< Due drzewo lene. */
-            inline static const std::string LOG = "log"; /**< Koda lena. */
-            inline static const std::string SPIKES = "spikes"; /**< Kolce lene. */
-            inline static const std::string SMALL_TREE_N = "small_tree_n"; /**< Mae drzewo lene w nocy. */
-            inline static const std::string BIG_TREE_N = "big_tree_n"; /**< Due drzewo lene w nocy. */
-            inline static const std::string LOG_N = "log_n"; /**< Koda lena w nocy. */
-            inline static const std::string SPIKES_N = "spikes_n"; /**< Kolce lene w nocy. */
+            inline static const std::string ROCK_D = "rock_d"; /**< Kamień pustynny za dnia. */
+            inline static const std::string BIG_ROCK_D = "big_rock_d"; /**< Duży kamień pustynny za dnia. */
+            inline static const std::string ROCK_D_N = "rock_d_n"; /**< Kamień pustynny w nocy. */
+            inline static const std::string BIG_ROCK_D_N = "big_rock_d_n"; /**< Duży kamień pustynny w nocy. */
+            inline static const std::string ROCK_F = "rock"; /**< Kamień leśny. */
+            inline static const std::string BIG_ROCK_F = "big_rock"; /**< Duży kamień leśny. */
+            inline static const std::string SMALL_TREE = "small_tree"; /**< Małe drzewo leśne. */
+            inline static const std::string BIG_TREE = "big_tree"; /**< Duże drzewo leśne. */
+            inline static const std::string LOG = "log"; /**< Kłoda leśna. */
+            inline static const std::string SPIKES = "spikes"; /**< Kolce leśne. */
+            inline static const std::string SMALL_TREE_N = "small_tree_n"; /**< Małe drzewo leśne w nocy. */
+            inline static const std::string BIG_TREE_N = "big_tree_n"; /**< Duże drzewo leśne w nocy. */
+            inline static const std::string LOG_N = "log_n"; /**< Kłoda leśna w nocy. */
+            inline static const std::string SPIKES_N = "spikes_n"; /**< Kolce leśne w nocy. */
         };
     };
 
 public:
     /**
-     * @brief Konstruktor domylny klasy Resources.
+     * @brief Konstruktor domyślny klasy Resources.
      */
     Resources() = default;
 
     /**
-    * @brief aduje tekstur i zapisuje j pod okrelonym kluczem.
-    * @tparam T Typ tekstury (musi spenia koncept TextureType).
-    * @param key Klucz, pod ktrym tekstura bdzie przechowywana.
-    * @param path cieka do pliku tekstury.
+    * @brief Pobiera teksturę z pamięci podręcznej i zapisuje uchwyt pod określonym kluczem.
+    * @tparam T Typ tekstury (musi spełniać koncept TextureType).
+    * @param key Klucz, pod którym tekstura będzie przechowywana.
+    * @param path Ścieżka do pliku tekstury.
     */
     template<TextureType T>
     void loadTexture(const std::string& key, const std::string& path) {
-        if (std::filesystem::exists(path)) {
-            textures[key] = LoadTexture(path.c_str());
-            std::cout << "Loaded texture: " << key << " from " << path
-                << ", ID: " << textures[key].id
-                << ", Width: " << textures[key].width
-                << ", Height: " << textures[key].height << "\n";
-            if (textures[key].id == 0 || textures[key].width == 0 || textures[key].height == 0) {
-                std::cout << "Warning: Texture " << key << " has invalid dimensions, loading fallback!\n";
-                textures[key] = LoadTexture("textures/missing_texture.png");
-            }
-        }
-        else {
-            std::cout << "Texture not found: " << path << ", using missing_texture.png\n";
-            textures[key] = LoadTexture("textures/missing_texture.png");
-            if (textures[key].id == 0 || textures[key].width == 0 || textures[key].height == 0) {
-                std::cout << "Error: Fallback missing_texture.png failed!\n";
-            }
-        }
+        // Pamięć podręczna zwraca już wczytaną teksturę, więc ponowne loadTextures() niczego nie wysyła na GPU.
+        textures[key] = textureCache().acquire(path);
     }
 
     /**
-     * @brief aduje wszystkie tekstury gry z predefiniowanych cieek.
+     * @brief Ładuje wszystkie tekstury gry z predefiniowanych ścieżek.
      */
-    void loadTextures(); /*{
-        loadTexture<Texture2D>(TextureKeys::UI::MENU_BG, "textures/main_menu_background.png");
-        loadTexture<Texture2D>(TextureKeys::UI::LOADING_SCREEN_BG, "textures/loading_screen.png");
-        loadTexture<Texture2D>(TextureKeys::UI::BAR_EMPTY, "textures/barempty.png");
-        loadTexture<Texture2D>(TextureKeys::UI::BAR_FULL, "textures/barfill.png");
-        loadTexture<Texture2D>(TextureKeys::UI::REGISTRATION_BG, "textures/registration_with_table.png");
-        loadTexture<Texture2D>(TextureKeys::UI::SHOP_BG, "textures/shop.png");
-        loadTexture<Texture2D>(TextureKeys::UI::LEADERBOARD, "textures/leaderboard.png");
-        loadTexture<Texture2D>(TextureKeys::UI::HEART_ICON, "textures/life_icon.png");
-        loadTexture<Texture2D>(TextureKeys::UI::LIFE_LOST_ICON, "textures/life_lost_icon.png");
-        loadTexture<Texture2D>(TextureKeys::UI::NUMBERS, "textures/numbers.png");
-        loadTexture<Texture2D>(TextureKeys::UI::BUTTON, "textures/button.png");
-        loadTexture<Texture2D>(TextureKeys::UI::BANNER, "textures/banner4.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::DINO_SHADOW, "textures/Characters/shadow_2.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::DUST_RUN, "textures/Characters/dust.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_IDLE, "textures/Characters/Player 1/p1_idle.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_IDLE, "textures/Characters/Player 2/p2_idle.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_IDLE, "textures/Characters/Player 3/p3_idle.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::RED_DINO_IDLE, "textures/Characters/Player 4/p4_idle.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_RUN, "textures/Characters/Player 1/p1_run.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_RUN, "textures/Characters/Player 2/p2_run.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_RUN, "textures/Characters/Player 3/p3_run.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::RED_DINO_RUN, "textures/Characters/Player 4/p4_run.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::NEBULA, "textures/12_nebula_spritesheet.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::PTERO, "textures/pterosaur_spritesheet.png");
-        loadTexture<Texture2D>(TextureKeys::Characters::BAT, "textures/BatIdleMoving.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_BG, "textures/Desert/bg_1.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_MG, "textures/Desert/bg_2.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_FG, "textures/Desert/bg_3.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_GR, "textures/Desert/ground.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_BG, "textures/Desert/night_bg_1.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_MG, "textures/Desert/night_bg_2.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_FG, "textures/Desert/night_bg_3.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_GR, "textures/Desert/night_ground.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_BG, "textures/Forest/bg_1.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_MG, "textures/Forest/bg_2.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_FG, "textures/Forest/bg_3.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_GR, "textures/Forest/ground.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_BG, "textures/Forest/night_bg_1.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_MG, "textures/Forest/night_bg_2.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_FG, "textures/Forest/night_bg_3.png");
-        loadTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_GR, "textures/Forest/night_ground.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_CACTUS, "textures/Desert/small_cactus.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_CACTUS, "textures/Desert/big_cactus.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SKULLS, "textures/Desert/skulls.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SKULLS2, "textures/Desert/skulls2.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D, "textures/Desert/rock.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D, "textures/Desert/big_rock.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D_N, "textures/Desert/rock_n.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D_N, "textures/Desert/big_rock_n.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::ROCK_F, "textures/Forest/rock_f.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_F, "textures/Forest/big_rock_f.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE, "textures/Forest/small_tree.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE, "textures/Forest/big_tree.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::LOG, "textures/Forest/log.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SPIKES, "textures/Forest/spikes.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE_N, "textures/Forest/small_tree_n.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE_N, "textures/Forest/big_tree_n.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::LOG_N, "textures/Forest/log_n.png");
-        loadTexture<Texture2D>(TextureKeys::Obstacles::SPIKES_N, "textures/Forest/spikes_n.png");
-    }*/
+    void loadTextures();
+
+    /**
+     * @brief Rozpoczyna wczytywanie tekstur po kawałku; od razu wczytuje tylko tekstury ekranu ładowania.
+     */
+    void beginLoading();
+
+    /**
+     * @brief Wczytuje kolejne tekstury w ramach budżetu czasu (zawsze co najmniej jedną).
+     * @param budgetSeconds Budżet czasu (w sekundach).
+     * @return True, jeśli wszystkie tekstury są już wczytane.
+     */
+    bool loadNext(double budgetSeconds);
+
+    /**
+     * @brief Zwraca postęp wczytywania tekstur.
+     * @return Wartość od 0 do 1 (1, gdy nic nie jest wczytywane).
+     */
+    float getLoadingProgress() const;
 
     /**
-     * @brief Zwalnia wszystkie zaadowane tekstury z pamici.
+     * @brief Oddaje uchwyty tekstur; pamięć podręczna zwalnia tekstury, których nikt już nie używa.
      */
     void unloadTextures(); /*{
         for (auto& texture : textures | std::ranges::views::values) {
@@ -246,145 +215,174 @@ public:
         }
     }*/
 
+    /**
+     * @brief Zwraca maskę kolizji arkusza sprite'ów.
+     * @param tex Tekstura arkusza.
+     * @return Wskaźnik na maskę lub nullptr, jeśli dla tej tekstury nie zbudowano maski.
+     */
+    const CollisionMask* getCollisionMask(const Texture2D& tex) const;
+
+private:
+    /**
+     * @brief Zwraca listę wszystkich tekstur gry.
+     * @return Manifest tekstur.
+     */
+    static const std::vector<TextureSource>& manifest();
+
+    /**
+     * @brief Buduje maski kolizji dla tekstur gracza i przeszkód (wywoływane raz, po załadowaniu tekstur).
+     */
+    void buildCollisionMasks();
+
+    /**
+     * @brief Buduje maskę kolizji z kanału alfa tekstury.
+     * @param key Klucz tekstury.
+     * @param scale Skala, z jaką sprite jest rysowany.
+     */
+    void buildCollisionMask(const std::string& key, float scale);
+
+public:
+
 
     /**
-     * @brief Pobiera tekstur na podstawie klucza.
-     * @tparam T Typ tekstury (musi spenia koncept TextureType).
+     * @brief Pobiera teksturę na podstawie klucza.
+     * @tparam T Typ tekstury (musi spełniać koncept TextureType).
      * @param key Klucz tekstury.
-     * @return Referencja do tekstury; jeli klucz nie istnieje, aduje domyln tekstur zastpcz.
+     * @return Referencja do tekstury; jeśli klucz nie istnieje, zwraca wspólną teksturę zastępczą.
      */
     template<TextureType T>
-    T& getTexture(const std::string& key) {
+    const T& getTexture(const std::string& key) {
         auto it = textures.find(key);
         if (it != textures.end()) {
-            return it->second;
+            return it->second.get();
         }
-        textures[key] = LoadTexture("textures/missing_texture.png");
-        return textures[key];
+        TextureHandle& handle = textures[key];
+        handle = textureCache().fallback();
+        return handle.get();
     }
 
-    /** @brief Pobiera tekstur ta menu. @return Referencja do tekstury. */
-    Texture2D& getMenuBackground() { return getTexture<Texture2D>(TextureKeys::UI::MENU_BG); }
-    /** @brief Pobiera tekstur ta sklepu. @return Referencja do tekstury. */
-    Texture2D& getShopBackground() { return getTexture<Texture2D>(TextureKeys::UI::SHOP_BG); }
-    /** @brief Pobiera tekstur ekranu adowania. @return Referencja do tekstury. */
-    Texture2D& getLoadingScreenBackground() { return getTexture<Texture2D>(TextureKeys::UI::LOADING_SCREEN_BG); }
-    /** @brief Pobiera tekstur pustego paska adowania. @return Referencja do tekstury. */
-    Texture2D& getBarEmpty() { return getTexture<Texture2D>(TextureKeys::UI::BAR_EMPTY); }
-    /** @brief Pobiera tekstur penego paska adowania. @return Referencja do tekstury. */
-    Texture2D& getBarFill() { return getTexture<Texture2D>(TextureKeys::UI::BAR_FULL); }
-    /** @brief Pobiera tekstur ta rejestracji. @return Referencja do tekstury. */
-    Texture2D& getRegistrationBackground() { return getTexture<Texture2D>(TextureKeys::UI::REGISTRATION_BG); }
-    /** @brief Pobiera tekstur cienia dinozaura. @return Referencja do tekstury. */
-    Texture2D& getShadowTexture() { return getTexture<Texture2D>(TextureKeys::Characters::DINO_SHADOW); }
-    /** @brief Pobiera tekstur zielonego dinozaura w stanie bezczynnoci. @return Referencja do tekstury. */
-    Texture2D& getGreenIdle() { return getTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_IDLE); }
-    /** @brief Pobiera tekstur niebieskiego dinozaura w stanie bezczynnoci. @return Referencja do tekstury. */
-    Texture2D& getBlueIdle() { return getTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_IDLE); }
-    /** @brief Pobiera tekstur tego dinozaura w stanie bezczynnoci. @return Referencja do tekstury. */
-    Texture2D& getYellowIdle() { return getTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_IDLE); }
-    /** @brief Pobiera tekstur czerwonego dinozaura w stanie bezczynnoci. @return Referencja do tekstury. */
-    Texture2D& getRedIdle() { return getTexture<Texture2D>(TextureKeys::Characters::RED_DINO_IDLE); }
-    /** @brief Pobiera tekstur oglnego ta gry. @return Referencja do tekstury. */
-    Texture2D& getGameBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_BG); }
-    /** @brief Pobiera tekstur oglnego planu rodkowego gry. @return Referencja do tekstury. */
-    Texture2D& getGameMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_MG); }
-    /** @brief Pobiera tekstur oglnego przedniego planu gry. @return Referencja do tekstury. */
-    Texture2D& getGameForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_FG); }
-    /** @brief Pobiera tekstur animacji pyu podczas biegu. @return Referencja do tekstury. */
-    Texture2D& getDustRun() { return getTexture<Texture2D>(TextureKeys::Characters::DUST_RUN); }
-    /** @brief Pobiera tekstur zielonego dinozaura w biegu. @return Referencja do tekstury. */
-    Texture2D& getGreenDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_RUN); }
-    /** @brief Pobiera tekstur niebieskiego dinozaura w biegu. @return Referencja do tekstury. */
-    Texture2D& getBlueDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_RUN); }
-    /** @brief Pobiera tekstur tego dinozaura w biegu. @return Referencja do tekstury. */
-    Texture2D& getYellowDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_RUN); }
-    /** @brief Pobiera tekstur czerwonego dinozaura w biegu. @return Referencja do tekstury. */
-    Texture2D& getRedDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::RED_DINO_RUN); }
-    /** @brief Pobiera tekstur mgawicy. @return Referencja do tekstury. */
-    Texture2D& getNebula() { return getTexture<Texture2D>(TextureKeys::Characters::NEBULA); }
-    /** @brief Pobiera tekstur pterozaura. @return Referencja do tekstury. */
-    Texture2D& getPtero() { return getTexture<Texture2D>(TextureKeys::Characters::PTERO); }
-    /** @brief Pobiera tekstur nietoperza. @return Referencja do tekstury. */
-    Texture2D& getBat() { return getTexture<Texture2D>(TextureKeys::Characters::BAT); }
-    /** @brief Pobiera tekstur ikony ycia. @return Referencja do tekstury. */
-    Texture2D& getHeartIcon() { return getTexture<Texture2D>(TextureKeys::UI::HEART_ICON); }
-    /** @brief Pobiera tekstur ikony utraconego ycia. @return Referencja do tekstury. */
-    Texture2D& getLifeLostIcon() { return getTexture<Texture2D>(TextureKeys::UI::LIFE_LOST_ICON); }
-    /** @brief Pobiera tekstur liczb. @return Referencja do tekstury. */
-    Texture2D& getNumbersTexture() { return getTexture<Texture2D>(TextureKeys::UI::NUMBERS); }
-    /** @brief Pobiera tekstur przycisku. @return Referencja do tekstury. */
-    Texture2D& getButtonTexture() { return getTexture<Texture2D>(TextureKeys::UI::BUTTON); }
-    /** @brief Pobiera tekstur tablicy wynikw. @return Referencja do tekstury. */
-    Texture2D& getLeaderboard() { return getTexture<Texture2D>(TextureKeys::UI::LEADERBOARD); }
-    /** @brief Pobiera tekstur baneru. @return Referencja do tekstury. */
-    Texture2D& getBanner() { return getTexture<Texture2D>(TextureKeys::UI::BANNER); }
-    /** @brief Pobiera tekstur ta pustyni za dnia. @return Referencja do tekstury. */
-    Texture2D& getDesertBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_BG); }
-    /** @brief Pobiera tekstur rodkowego planu pustyni za dnia. @return Referencja do tekstury. */
-    Texture2D& getDesertMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_MG); }
-    /** @brief Pobiera tekstur przedniego planu pustyni za dnia. @return Referencja do tekstury. */
-    Texture2D& getDesertForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_FG); }
-    /** @brief Pobiera tekstur ziemi pustyni za dnia. @return Referencja do tekstury. */
-    Texture2D& getDesertGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_GR); }
-    /** @brief Pobiera tekstur ta lasu za dnia. @return Referencja do tekstury. */
-    Texture2D& getForestBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_BG); }
-    /** @brief Pobiera tekstur rodkowego planu lasu za dnia. @return Referencja do tekstury. */
-    Texture2D& getForestMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_MG); }
-    /** @brief Pobiera tekstur przedniego planu lasu za dnia. @return Referencja do tekstury. */
-    Texture2D& getForestForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_FG); }
-    /** @brief Pobiera tekstur ziemi lasu za dnia. @return Referencja do tekstury. */
-    Texture2D& getForestGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_GR); }
-    /** @brief Pobiera tekstur ta pustyni w nocy. @return Referencja do tekstury. */
-    Texture2D& getDesertNightBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_BG); }
-    /** @brief Pobiera tekstur rodkowego planu pustyni w nocy. @return Referencja do tekstury. */
-    Texture2D& getDesertNightMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_MG); }
-    /** @brief Pobiera tekstur przedniego planu pustyni w nocy. @return Referencja do tekstury. */
-    Texture2D& getDesertNightForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_FG); }
-    /** @brief Pobiera tekstur ziemi pustyni w nocy. @return Referencja do tekstury. */
-    Texture2D& getDesertNightGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_GR); }
-    /** @brief Pobiera tekstur ta lasu w nocy. @return Referencja do tekstury. */
-    Texture2D& getForestNightBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_BG); }
-    /** @brief Pobiera tekstur rodkowego planu lasu w nocy. @return Referencja do tekstury. */
-    Texture2D& getForestNightMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_MG); }
-    /** @brief Pobiera tekstur przedniego planu lasu w nocy. @return Referencja do tekstury. */
-    Texture2D& getForestNightForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_FG); }
-    /** @brief Pobiera tekstur ziemi lasu w nocy. @return Referencja do tekstury. */
-    Texture2D& getForestNightGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_GR); }
-    /** @brief Pobiera tekstur maego kaktusa. @return Referencja do tekstury. */
-    Texture2D& getSmallCactus() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_CACTUS); }
-    /** @brief Pobiera tekstur duego kaktusa. @return Referencja do tekstury. */
-    Texture2D& getBigCactus() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_CACTUS); }
-    /** @brief Pobiera tekstur czaszek (wariant 1). @return Referencja do tekstury. */
-    Texture2D& getSkulls() { return getTexture<Texture2D>(TextureKeys::Obstacles::SKULLS); }
-    /** @brief Pobiera tekstur czaszek (wariant 2). @return Referencja do tekstury. */
-    Texture2D& getSkulls2() { return getTexture<Texture2D>(TextureKeys::Obstacles::SKULLS2); }
-    /** @brief Pobiera tekstur kamienia (pustynia za dnia). @return Referencja do tekstury. */
-    Texture2D& getRockDust() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D); }
-    /** @brief Pobiera tekstur duego kamienia (pustynia za dnia). @return Referencja do tekstury. */
-    Texture2D& getBigRockDust() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D); }
-    /** @brief Pobiera tekstur kamienia (pustynia w nocy). @return Referencja do tekstury. */
-    Texture2D& getRockDustNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D_N); }
-    /** @brief Pobiera tekstur duego kamienia (pustynia w nocy). @return Referencja do tekstury. */
-    Texture2D& getBigRockDustNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D_N); }
-    /** @brief Pobiera tekstur kamienia (las). @return Referencja do tekstury. */
-    Texture2D& getRockForest() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_F); }
-    /** @brief Pobiera tekstur duego kamienia (las). @return Referencja do tekstury. */
-    Texture2D& getBigRockForest() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_F); }
-    /** @brief Pobiera tekstur maego drzewa (las za dnia). @return Referencja do tekstury. */
-    Texture2D& getSmallTree() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE); }
-    /** @brief Pobiera tekstur duego drzewa (las za dnia). @return Referencja do tekstury. */
-    Texture2D& getBigTree() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE); }
-    /** @brief Pobiera tekstur kody (las za dnia). @return Referencja do tekstury. */
-    Texture2D& getLog() { return getTexture<Texture2D>(TextureKeys::Obstacles::LOG); }
-    /** @brief Pobiera tekstur kolcw (las za dnia). @return Referencja do tekstury. */
-    Texture2D& getSpikes() { return getTexture<Texture2D>(TextureKeys::Obstacles::SPIKES); }
-    /** @brief Pobiera tekstur maego drzewa (las w nocy). @return Referencja do tekstury. */
-    Texture2D& getSmallTreeNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE_N); }
-    /** @brief Pobiera tekstur duego drzewa (las w nocy). @return Referencja do tekstury. */
-    Texture2D& getBigTreeNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE_N); }
-    /** @brief Pobiera tekstur kody (las w nocy). @return Referencja do tekstury. */
-    Texture2D& getLogNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::LOG_N); }
-    /** @brief Pobiera tekstur kolcw (las w nocy). @return Referencja do tekstury. */
-    Texture2D& getSpikesNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::SPIKES_N); }
+    /** @brief Pobiera teksturę tła menu. @return Referencja do tekstury. */
+    const Texture2D& getMenuBackground() { return getTexture<Texture2D>(TextureKeys::UI::MENU_BG); }
+    /** @brief Pobiera teksturę tła sklepu. @return Referencja do tekstury. */
+    const Texture2D& getShopBackground() { return getTexture<Texture2D>(TextureKeys::UI::SHOP_BG); }
+    /** @brief Pobiera teksturę ekranu ładowania. @return Referencja do tekstury. */
+    const Texture2D& getLoadingScreenBackground() { return getTexture<Texture2D>(TextureKeys::UI::LOADING_SCREEN_BG); }
+    /** @brief Pobiera teksturę pustego paska ładowania. @return Referencja do tekstury. */
+    const Texture2D& getBarEmpty() { return getTexture<Texture2D>(TextureKeys::UI::BAR_EMPTY); }
+    /** @brief Pobiera teksturę pełnego paska ładowania. @return Referencja do tekstury. */
+    const Texture2D& getBarFill() { return getTexture<Texture2D>(TextureKeys::UI::BAR_FULL); }
+    /** @brief Pobiera teksturę tła rejestracji. @return Referencja do tekstury. */
+    const Texture2D& getRegistrationBackground() { return getTexture<Texture2D>(TextureKeys::UI::REGISTRATION_BG); }
+    /** @brief Pobiera teksturę cienia dinozaura. @return Referencja do tekstury. */
+    const Texture2D& getShadowTexture() { return getTexture<Texture2D>(TextureKeys::Characters::DINO_SHADOW); }
+    /** @brief Pobiera teksturę zielonego dinozaura w stanie bezczynności. @return Referencja do tekstury. */
+    const Texture2D& getGreenIdle() { return getTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_IDLE); }
+    /** @brief Pobiera teksturę niebieskiego dinozaura w stanie bezczynności. @return Referencja do tekstury. */
+    const Texture2D& getBlueIdle() { return getTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_IDLE); }
+    /** @brief Pobiera teksturę żółtego dinozaura w stanie bezczynności. @return Referencja do tekstury. */
+    const Texture2D& getYellowIdle() { return getTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_IDLE); }
+    /** @brief Pobiera teksturę czerwonego dinozaura w stanie bezczynności. @return Referencja do tekstury. */
+    const Texture2D& getRedIdle() { return getTexture<Texture2D>(TextureKeys::Characters::RED_DINO_IDLE); }
+    /** @brief Pobiera teksturę ogólnego tła gry. @return Referencja do tekstury. */
+    const Texture2D& getGameBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_BG); }
+    /** @brief Pobiera teksturę ogólnego planu środkowego gry. @return Referencja do tekstury. */
+    const Texture2D& getGameMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_MG); }
+    /** @brief Pobiera teksturę ogólnego przedniego planu gry. @return Referencja do tekstury. */
+    const Texture2D& getGameForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::GAME_FG); }
+    /** @brief Pobiera teksturę animacji pyłu podczas biegu. @return Referencja do tekstury. */
+    const Texture2D& getDustRun() { return getTexture<Texture2D>(TextureKeys::Characters::DUST_RUN); }
+    /** @brief Pobiera teksturę zielonego dinozaura w biegu. @return Referencja do tekstury. */
+    const Texture2D& getGreenDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::GREEN_DINO_RUN); }
+    /** @brief Pobiera teksturę niebieskiego dinozaura w biegu. @return Referencja do tekstury. */
+    const Texture2D& getBlueDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::BLUE_DINO_RUN); }
+    /** @brief Pobiera teksturę żółtego dinozaura w biegu. @return Referencja do tekstury. */
+    const Texture2D& getYellowDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::YELLOW_DINO_RUN); }
+    /** @brief Pobiera teksturę czerwonego dinozaura w biegu. @return Referencja do tekstury. */
+    const Texture2D& getRedDinoRun() { return getTexture<Texture2D>(TextureKeys::Characters::RED_DINO_RUN); }
+    /** @brief Pobiera teksturę mgławicy. @return Referencja do tekstury. */
+    const Texture2D& getNebula() { return getTexture<Texture2D>(TextureKeys::Characters::NEBULA); }
+    /** @brief Pobiera teksturę pterozaura. @return Referencja do tekstury. */
+    const Texture2D& getPtero() { return getTexture<Texture2D>(TextureKeys::Characters::PTERO); }
+    /** @brief Pobiera teksturę nietoperza. @return Referencja do tekstury. */
+    const Texture2D& getBat() { return getTexture<Texture2D>(TextureKeys::Characters::BAT); }
+    /** @brief Pobiera teksturę ikony życia. @return Referencja do tekstury. */
+    const Texture2D& getHeartIcon() { return getTexture<Texture2D>(TextureKeys::UI::HEART_ICON); }
+    /** @brief Pobiera teksturę ikony utraconego życia. @return Referencja do tekstury. */
+    const Texture2D& getLifeLostIcon() { return getTexture<Texture2D>(TextureKeys::UI::LIFE_LOST_ICON); }
+    /** @brief Pobiera teksturę liczb. @return Referencja do tekstury. */
+    const Texture2D& getNumbersTexture() { return getTexture<Texture2D>(TextureKeys::UI::NUMBERS); }
+    /** @brief Pobiera teksturę przycisku. @return Referencja do tekstury. */
+    const Texture2D& getButtonTexture() { return getTexture<Texture2D>(TextureKeys::UI::BUTTON); }
+    /** @brief Pobiera teksturę tablicy wyników. @return Referencja do tekstury. */
+    const Texture2D& getLeaderboard() { return getTexture<Texture2D>(TextureKeys::UI::LEADERBOARD); }
+    /** @brief Pobiera teksturę baneru. @return Referencja do tekstury. */
+    const Texture2D& getBanner() { return getTexture<Texture2D>(TextureKeys::UI::BANNER); }
+    /** @brief Pobiera teksturę tła pustyni za dnia. @return Referencja do tekstury. */
+    const Texture2D& getDesertBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_BG); }
+    /** @brief Pobiera teksturę środkowego planu pustyni za dnia. @return Referencja do tekstury. */
+    const Texture2D& getDesertMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_MG); }
+    /** @brief Pobiera teksturę przedniego planu pustyni za dnia. @return Referencja do tekstury. */
+    const Texture2D& getDesertForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_FG); }
+    /** @brief Pobiera teksturę ziemi pustyni za dnia. @return Referencja do tekstury. */
+    const Texture2D& getDesertGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_GR); }
+    /** @brief Pobiera teksturę tła lasu za dnia. @return Referencja do tekstury. */
+    const Texture2D& getForestBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_BG); }
+    /** @brief Pobiera teksturę środkowego planu lasu za dnia. @return Referencja do tekstury. */
+    const Texture2D& getForestMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_MG); }
+    /** @brief Pobiera teksturę przedniego planu lasu za dnia. @return Referencja do tekstury. */
+    const Texture2D& getForestForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_FG); }
+    /** @brief Pobiera teksturę ziemi lasu za dnia. @return Referencja do tekstury. */
+    const Texture2D& getForestGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_GR); }
+    /** @brief Pobiera teksturę tła pustyni w nocy. @return Referencja do tekstury. */
+    const Texture2D& getDesertNightBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_BG); }
+    /** @brief Pobiera teksturę środkowego planu pustyni w nocy. @return Referencja do tekstury. */
+    const Texture2D& getDesertNightMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_MG); }
+    /** @brief Pobiera teksturę przedniego planu pustyni w nocy. @return Referencja do tekstury. */
+    const Texture2D& getDesertNightForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_FG); }
+    /** @brief Pobiera teksturę ziemi pustyni w nocy. @return Referencja do tekstury. */
+    const Texture2D& getDesertNightGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::DESERT_NIGHT_GR); }
+    /** @brief Pobiera teksturę tła lasu w nocy. @return Referencja do tekstury. */
+    const Texture2D& getForestNightBackground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_BG); }
+    /** @brief Pobiera teksturę środkowego planu lasu w nocy. @return Referencja do tekstury. */
+    const Texture2D& getForestNightMidground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_MG); }
+    /** @brief Pobiera teksturę przedniego planu lasu w nocy. @return Referencja do tekstury. */
+    const Texture2D& getForestNightForeground() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_FG); }
+    /** @brief Pobiera teksturę ziemi lasu w nocy. @return Referencja do tekstury. */
+    const Texture2D& getForestNightGround() { return getTexture<Texture2D>(TextureKeys::Backgrounds::FOREST_NIGHT_GR); }
+    /** @brief Pobiera teksturę małego kaktusa. @return Referencja do tekstury. */
+    const Texture2D& getSmallCactus() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_CACTUS); }
+    /** @brief Pobiera teksturę dużego kaktusa. @return Referencja do tekstury. */
+    const Texture2D& getBigCactus() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_CACTUS); }
+    /** @brief Pobiera teksturę czaszek (wariant 1). @return Referencja do tekstury. */
+    const Texture2D& getSkulls() { return getTexture<Texture2D>(TextureKeys::Obstacles::SKULLS); }
+    /** @brief Pobiera teksturę czaszek (wariant 2). @return Referencja do tekstury. */
+    const Texture2D& getSkulls2() { return getTexture<Texture2D>(TextureKeys::Obstacles::SKULLS2); }
+    /** @brief Pobiera teksturę kamienia (pustynia za dnia). @return Referencja do tekstury. */
+    const Texture2D& getRockDust() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D); }
+    /** @brief Pobiera teksturę dużego kamienia (pustynia za dnia). @return Referencja do tekstury. */
+    const Texture2D& getBigRockDust() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D); }
+    /** @brief Pobiera teksturę kamienia (pustynia w nocy). @return Referencja do tekstury. */
+    const Texture2D& getRockDustNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_D_N); }
+    /** @brief Pobiera teksturę dużego kamienia (pustynia w nocy). @return Referencja do tekstury. */
+    const Texture2D& getBigRockDustNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_D_N); }
+    /** @brief Pobiera teksturę kamienia (las). @return Referencja do tekstury. */
+    const Texture2D& getRockForest() { return getTexture<Texture2D>(TextureKeys::Obstacles::ROCK_F); }
+    /** @brief Pobiera teksturę dużego kamienia (las). @return Referencja do tekstury. */
+    const Texture2D& getBigRockForest() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_ROCK_F); }
+    /** @brief Pobiera teksturę małego drzewa (las za dnia). @return Referencja do tekstury. */
+    const Texture2D& getSmallTree() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE); }
+    /** @brief Pobiera teksturę dużego drzewa (las za dnia). @return Referencja do tekstury. */
+    const Texture2D& getBigTree() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE); }
+    /** @brief Pobiera teksturę kłody (las za dnia). @return Referencja do tekstury. */
+    const Texture2D& getLog() { return getTexture<Texture2D>(TextureKeys::Obstacles::LOG); }
+    /** @brief Pobiera teksturę kolców (las za dnia). @return Referencja do tekstury. */
+    const Texture2D& getSpikes() { return getTexture<Texture2D>(TextureKeys::Obstacles::SPIKES); }
+    /** @brief Pobiera teksturę małego drzewa (las w nocy). @return Referencja do tekstury. */
+    const Texture2D& getSmallTreeNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::SMALL_TREE_N); }
+    /** @brief Pobiera teksturę dużego drzewa (las w nocy). @return Referencja do tekstury. */
+    const Texture2D& getBigTreeNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::BIG_TREE_N); }
+    /** @brief Pobiera teksturę kłody (las w nocy). @return Referencja do tekstury. */
+    const Texture2D& getLogNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::LOG_N); }
+    /** @brief Pobiera teksturę kolców (las w nocy). @return Referencja do tekstury. */
+    const Texture2D& getSpikesNight() { return getTexture<Texture2D>(TextureKeys::Obstacles::SPIKES_N); }
 };
\ No newline at end of file
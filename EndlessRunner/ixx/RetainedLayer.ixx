@@ -0,0 +1,142 @@
+﻿/**
+ * @file RetainedLayer.ixx
+ * @brief Moduł warstwy rysowanej raz do tekstury i składanej na ekranie w każdej klatce.
+ *
+ * Ekrany menu, tablicy wyników i sklepu zmieniają się tylko przy zmianie rozmiaru okna albo stanu
+ * (podświetlenie, wybór). Ich statyczna część jest rysowana do RenderTexture2D tylko wtedy, a w pozostałych
+ * klatkach na ekran trafia jedna tekstura zamiast kilkunastu wywołań DrawTexturePro/DrawText.
+ */
+
+module;
+#include "raylib.h"
+#include <cstdint>
+#include <map>
+#include <string>
+export module RetainedLayerModule;
+
+
+/**
+ * @struct LayerStats
+ * @brief Liczniki jednej warstwy (sumowane dla wszystkich obiektów o tej samej nazwie).
+ */
+export struct LayerStats {
+    /** @brief Liczba klatek, w których warstwa trafiła na ekran. */
+    std::uint64_t frames{ 0 };
+    /** @brief Liczba ponownych rysowań do tekstury. */
+    std::uint64_t rebuilds{ 0 };
+    /** @brief Wywołania rysujące, które zostałyby wykonane bez warstwy (treść statyczna w każdej klatce). */
+    std::uint64_t uncachedDrawCalls{ 0 };
+    /** @brief Wywołania rysujące z warstwą (przebudowy oraz jedno złożenie na klatkę). */
+    std::uint64_t cachedDrawCalls{ 0 };
+};
+
+/**
+ * @class LayerReport
+ * @brief Zbiera liczniki wszystkich warstw i wypisuje podsumowanie przy zamknięciu gry.
+ */
+export class LayerReport {
+private:
+    /** @brief Liczniki według nazwy warstwy. */
+    std::map<std::string, LayerStats> layers;
+
+public:
+    /**
+     * @brief Zwraca liczniki warstwy (tworzy je przy pierwszym użyciu).
+     * @param name Nazwa warstwy.
+     * @return Referencja do liczników (adres nie zmienia się do końca programu).
+     */
+    LayerStats& get(const std::string& name) { return layers[name]; }
+
+    /**
+     * @brief Wypisuje dla każdej warstwy liczbę klatek, przebudów i średnią liczbę wywołań rysujących na klatkę.
+     */
+    void printReport() const;
+};
+
+/**
+ * @brief Zwraca wspólny raport warstw.
+ * @return Referencja do obiektu LayerReport.
+ */
+export LayerReport& layerReport();
+
+/**
+ * @class RetainedLayer
+ * @brief Tekstura docelowa z treścią statyczną ekranu, przebudowywana tylko po zmianie rozmiaru lub stanu.
+ */
+export class RetainedLayer {
+private:
+    /** @brief Tekstura docelowa (id 0, dopóki nie powstanie). */
+    RenderTexture2D target{};
+    /** @brief Szerokość, dla której zbudowano teksturę. */
+    int width{ 0 };
+    /** @brief Wysokość, dla której zbudowano teksturę. */
+    int height{ 0 };
+    /** @brief Stan ekranu (np. podświetlony przycisk), dla którego zbudowano teksturę. */
+    std::uint64_t stateKey{ 0 };
+    /** @brief Czy zawartość tekstury jest aktualna. */
+    bool valid{ false };
+    /** @brief Liczba wywołań rysujących ostatniej przebudowy (koszt klatki bez warstwy). */
+    int staticDrawCalls{ 0 };
+    /** @brief Liczniki warstwy w raporcie. */
+    LayerStats* stats;
+
+public:
+    /**
+     * @brief Tworzy pustą warstwę; tekstura powstaje przy pierwszym rysowaniu.
+     * @param name Nazwa warstwy w raporcie.
+     */
+    explicit RetainedLayer(const std::string& name) : stats(&layerReport().get(name)) {}
+
+    RetainedLayer(const RetainedLayer&) = delete;
+    RetainedLayer& operator=(const RetainedLayer&) = delete;
+
+    /**
+     * @brief Zwalnia teksturę docelową (o ile okno jeszcze istnieje).
+     */
+    ~RetainedLayer();
+
+    /**
+     * @brief Rysuje warstwę na ekranie, w razie potrzeby najpierw ją przebudowując.
+     *
+     * Funkcja drawStatic jest wywoływana w trybie rysowania do tekstury tylko wtedy, gdy zmienił się
+     * rozmiar, stan albo warstwa została unieważniona. Zwraca liczbę wykonanych wywołań rysujących.
+     *
+     * @param screenWidth Szerokość ekranu.
+     * @param screenHeight Wysokość ekranu.
+     * @param key Stan ekranu, od którego zależy treść warstwy.
+     * @param drawStatic Funkcja rysująca treść statyczną.
+     */
+    template <typename DrawStatic>
+    void render(int screenWidth, int screenHeight, std::uint64_t key, DrawStatic&& drawStatic) {
+        if (!valid || key != stateKey || screenWidth != width || screenHeight != height) {
+            beginRebuild(screenWidth, screenHeight);
+            staticDrawCalls = drawStatic();
+            endRebuild(key);
+        }
+        composite();
+    }
+
+    /**
+     * @brief Wymusza przebudowę przy następnym rysowaniu (np. po zmianie danych ekranu).
+     */
+    void invalidate() { valid = false; }
+
+private:
+    /**
+     * @brief Przygotowuje teksturę o zadanym rozmiarze i rozpoczyna rysowanie do niej.
+     * @param screenWidth Szerokość tekstury.
+     * @param screenHeight Wysokość tekstury.
+     */
+    void beginRebuild(int screenWidth, int screenHeight);
+
+    /**
+     * @brief Kończy rysowanie do tekstury i zapamiętuje stan.
+     * @param key Stan ekranu.
+     */
+    void endRebuild(std::uint64_t key);
+
+    /**
+     * @brief Rysuje teksturę warstwy na ekranie.
+     */
+    void composite();
+};
@@ -0,0 +1,191 @@
+﻿/**
+ * @file Scene.ixx
+ * @brief Moduł definiujący ekrany gry (sceny) i stos scen prowadzony przez jedną główną pętlę.
+ *
+ * Każdy ekran implementuje interfejs Scene zamiast własnej pętli while (!WindowShouldClose()).
+ * SceneManager przesuwa w każdej klatce animacje (AnimationSystem), wywołuje update() i render() sceny na szczycie stosu, wykonuje zadania w tle
+ * (np. wczytywanie tekstur) i kończy klatkę przez FramePacer. Zmiany stosu zgłoszone w trakcie klatki
+ * są wykonywane dopiero po jej zakończeniu, więc żadna klatka nie jest przerywana w połowie.
+ */
+
+module;
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+export module SceneModule;
+
+import ConfigModule;
+import FramePacerModule;
+import AnimationSystemModule;
+
+
+export class SceneManager;
+
+/**
+ * @class Scene
+ * @brief Interfejs ekranu gry.
+ */
+export class Scene {
+public:
+    virtual ~Scene() = default;
+
+    /**
+     * @brief Wywoływana, gdy scena trafia na stos.
+     * @param scenes Stos scen (np. do zlecenia zadań w tle).
+     */
+    virtual void enter(SceneManager& scenes) {}
+
+    /**
+     * @brief Obsługuje wejście i aktualizuje stan sceny.
+     * @param scenes Stos scen (do zmiany ekranu).
+     * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+     */
+    virtual void update(SceneManager& scenes, float deltaTime) = 0;
+
+    /**
+     * @brief Rysuje scenę (między BeginDrawing a EndDrawing).
+     */
+    virtual void render() = 0;
+
+    /**
+     * @brief Wywoływana, gdy scena jest zdejmowana ze stosu.
+     */
+    virtual void exit() {}
+
+    /**
+     * @brief Czeka na pracę sceny w tle, która czyta wspólny stan (np. symulację klatki w osobnym wątku).
+     * Wywoływana na początku klatki, przed zmianami stosu i przesunięciem animacji.
+     */
+    virtual void sync() {}
+
+    /**
+     * @brief Obsługuje klawisz ESC; domyślnie wraca do poprzedniej sceny.
+     * @param scenes Stos scen.
+     */
+    virtual void back(SceneManager& scenes);
+
+    /**
+     * @brief Zwraca rodzaj klatki dla FramePacer.
+     * @return FrameKind::MENU dla ekranów statycznych, FrameKind::GAMEPLAY dla animowanych.
+     */
+    virtual FrameKind getFrameKind() const { return FrameKind::MENU; }
+};
+
+/**
+ * @class SceneManager
+ * @brief Stos scen i główna pętla gry.
+ *
+ * Sceny mogą być własnością stosu (push(std::unique_ptr)) lub należeć do wywołującego (push(Scene&)),
+ * który gwarantuje, że obiekt żyje dłużej niż jego obecność na stosie.
+ */
+export class SceneManager {
+public:
+    /**
+     * @brief Zadanie w tle; otrzymuje budżet czasu (w sekundach) i zwraca true, gdy skończyło pracę.
+     */
+    using Task = std::function<bool(double budgetSeconds)>;
+
+private:
+    /**
+     * @struct Entry
+     * @brief Scena na stosie.
+     */
+    struct Entry {
+        Scene* scene{ nullptr };        /**< Scena. */
+        std::unique_ptr<Scene> owned;   /**< Właściciel sceny (pusty dla scen należących do wywołującego). */
+    };
+
+    /**
+     * @enum Operation
+     * @brief Rodzaj zmiany stosu.
+     */
+    enum class Operation { PUSH, POP, REPLACE, CLEAR };
+
+    /**
+     * @struct Pending
+     * @brief Zmiana stosu czekająca na koniec klatki.
+     */
+    struct Pending {
+        Operation operation;
+        Entry entry;
+    };
+
+    /** @brief Stos scen; aktywna jest ostatnia. */
+    std::vector<Entry> stack;
+    /** @brief Zmiany stosu zgłoszone w bieżącej klatce. */
+    std::vector<Pending> pending;
+    /** @brief Zadania w tle. */
+    std::vector<Task> tasks;
+
+public:
+    SceneManager() = default;
+    ~SceneManager();
+    SceneManager(const SceneManager&) = delete;
+    SceneManager& operator=(const SceneManager&) = delete;
+
+    /**
+     * @brief Kładzie scenę na stos (stos przejmuje ją na własność).
+     * @param scene Nowa scena.
+     */
+    void push(std::unique_ptr<Scene> scene);
+
+    /**
+     * @brief Kładzie na stos scenę należącą do wywołującego.
+     * @param scene Nowa scena.
+     */
+    void push(Scene& scene);
+
+    /**
+     * @brief Zdejmuje aktywną scenę.
+     */
+    void pop();
+
+    /**
+     * @brief Zastępuje aktywną scenę nową.
+     * @param scene Nowa scena.
+     */
+    void replace(std::unique_ptr<Scene> scene);
+
+    /**
+     * @brief Zdejmuje wszystkie sceny, co kończy główną pętlę.
+     */
+    void clear();
+
+    /**
+     * @brief Dodaje zadanie wykonywane po kawałku w kolejnych klatkach, aż zwróci true.
+     * @param task Zadanie.
+     */
+    void addTask(Task task);
+
+    /** @brief Sprawdza, czy na stosie nie ma scen. @return True, jeśli stos jest pusty. */
+    bool isEmpty() const { return stack.empty() && pending.empty(); }
+    /** @brief Zwraca liczbę scen na stosie. @return Liczba scen. */
+    std::size_t getDepth() const { return stack.size(); }
+
+    /**
+     * @brief Główna pętla gry: działa, dopóki na stosie są sceny i okno nie zostało zamknięte.
+     */
+    void run();
+
+    /**
+     * @brief Wykonuje jedną klatkę (zaległe zmiany stosu, aktualizacja, zadania w tle, rysowanie, tempo klatek).
+     */
+    void frame();
+
+private:
+    /**
+     * @brief Wykonuje zadania w tle w ramach budżetu Config::SCENE_TASK_BUDGET.
+     */
+    void runTasks();
+
+    /**
+     * @brief Wykonuje zmiany stosu zgłoszone w trakcie klatki.
+     */
+    void applyPending();
+
+    /**
+     * @brief Zdejmuje aktywną scenę od razu.
+     */
+    void popNow();
+};
@@ -0,0 +1,392 @@
+﻿/**
+ * @file ScoreService.ixx
+ * @brief Moduł lokalnej usługi wyników: indeks rankingu w pamięci, demon i klient gniazda Unix.
+ *
+ * Jeden demon na komputer jest właścicielem tablicy wyników: przy starcie wczytuje plik wyników, każde
+ * zgłoszenie dopisuje do niego (RecordLog) i odpowiada na pytania o najlepszych graczy i miejsce gracza
+ * z indeksu w pamięci. Instancje gry łączą się przez gniazdo domeny Unix (w Windows AF_UNIX, od Windows 10 1803)
+ * i wysyłają kilka żądań naraz, zanim odczytają odpowiedzi.
+ *
+ * Protokół: każda ramka to [u16 długość][u8 kod][dane], liczby w kolejności little-endian.
+ * Żądania: SUBMIT [u8 n][nazwa][i32 wynik], TOP [u16 k], RANK [u8 n][nazwa].
+ * Odpowiedzi przychodzą w kolejności żądań; kod odpowiedzi to 0 (sukces), 1 (błędne żądanie) lub 2 (wynik
+ * nie został zapisany w pliku), a dane (tylko przy sukcesie) to:
+ * SUBMIT [u32 miejsce], TOP [u16 liczba]([u8 n][nazwa][i32 wynik])*, RANK [u32 miejsce][i32 wynik].
+ */
+
+module;
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+export module ScoreServiceModule;
+
+import ConfigModule;
+import RecordLogModule;
+
+
+/**
+ * @enum ScoreOp
+ * @brief Kod żądania protokołu usługi wyników.
+ */
+export enum class ScoreOp : std::uint8_t {
+    SUBMIT = 1, /**< Zgłoszenie wyniku gracza. */
+    TOP = 2,    /**< Pobranie k najlepszych graczy. */
+    RANK = 3    /**< Pobranie miejsca i najlepszego wyniku gracza. */
+};
+
+/**
+ * @enum SubmitResult
+ * @brief Wynik zgłoszenia wyniku do demona.
+ */
+export enum class SubmitResult {
+    STORED,   /**< Demon zapisał wynik w pliku. */
+    REJECTED, /**< Demon odmówił (np. nie zapisał pliku) - wyniku nie ma w pliku. */
+    UNSENT,   /**< Brak połączenia albo żądanie nie zostało wysłane - demon go nie zna. */
+    UNKNOWN   /**< Żądanie wysłano, ale odpowiedź nie nadeszła - demon mógł już zapisać wynik. */
+};
+
+/**
+ * @struct RankedScore
+ * @brief Najlepszy wynik gracza na tablicy.
+ */
+export struct RankedScore {
+    /** @brief Nazwa gracza. */
+    std::string username;
+    /** @brief Najlepszy wynik gracza. */
+    int score{ 0 };
+
+    bool operator==(const RankedScore&) const = default;
+};
+
+/**
+ * @struct ScoreResponse
+ * @brief Odpowiedź demona na jedno żądanie.
+ */
+export struct ScoreResponse {
+    /** @brief Kod żądania, na które odpowiedziano. */
+    ScoreOp op{ ScoreOp::SUBMIT };
+    /** @brief False, jeśli demon odrzucił żądanie jako błędne. */
+    bool ok{ false };
+    /** @brief Miejsce gracza (od 1; 0 - gracz nieznany) dla SUBMIT i RANK. */
+    std::uint32_t rank{ 0 };
+    /** @brief Najlepszy wynik gracza dla RANK. */
+    int score{ 0 };
+    /** @brief Najlepsi gracze dla TOP. */
+    std::vector<RankedScore> entries;
+};
+
+/**
+ * @class ScoreIndex
+ * @brief Indeks najlepszych wyników graczy w pamięci.
+ *
+ * Najlepsze wyniki są trzymane w mapie, ranking w zbiorze uporządkowanym (k najlepszych to początek zbioru),
+ * a liczby graczy dla każdej wartości wyniku w drzewie Fenwicka, więc miejsce gracza liczy się w O(log n).
+ * Wyniki spoza zakresu [0, limit) są przycinane tylko w drzewie - mapa i zbiór trzymają dokładne wartości.
+ */
+export class ScoreIndex {
+private:
+    /** @brief Najlepszy wynik każdego gracza. */
+    std::unordered_map<std::string, int> best;
+    /**
+     * @struct RankOrder
+     * @brief Porządek rankingu: malejąco po wyniku, przy remisie alfabetycznie.
+     */
+    struct RankOrder {
+        bool operator()(const std::pair<int, std::string>& a, const std::pair<int, std::string>& b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+
+    /** @brief Ranking (pary wynik, nazwa). */
+    std::set<std::pair<int, std::string>, RankOrder> ordered;
+    /** @brief Drzewo Fenwicka liczby graczy o danym (przyciętym) wyniku. */
+    std::vector<std::uint32_t> counts;
+
+    /** @brief Przycina wynik do zakresu drzewa. @param score Wynik. @return Indeks w drzewie. */
+    std::size_t bucket(int score) const;
+    /** @brief Dodaje delta do licznika wyniku. @param score Wynik. @param delta Zmiana licznika. */
+    void addCount(int score, int delta);
+    /** @brief Liczy graczy o wyniku nie większym niż score. @param score Wynik. @return Liczba graczy. */
+    std::uint32_t countUpTo(int score) const;
+
+public:
+    /**
+     * @brief Tworzy pusty indeks.
+     * @param limit Rozmiar drzewa Fenwicka (wyniki od limit w górę dzielą ostatni przedział).
+     */
+    explicit ScoreIndex(int limit = Config::SCORE_INDEX_LIMIT);
+
+    /**
+     * @brief Zgłasza wynik gracza (liczy się tylko najlepszy).
+     * @param username Nazwa gracza.
+     * @param score Wynik.
+     * @return True, jeśli najlepszy wynik gracza się zmienił.
+     */
+    bool submit(const std::string& username, int score);
+
+    /**
+     * @brief Zwraca k najlepszych graczy.
+     * @param k Liczba graczy.
+     * @return Gracze od najlepszego.
+     */
+    std::vector<RankedScore> top(std::size_t k) const;
+
+    /**
+     * @brief Zwraca miejsce gracza (1 + liczba graczy z lepszym wynikiem).
+     * @param username Nazwa gracza.
+     * @param score Miejsce na najlepszy wynik gracza (może być nullptr).
+     * @return Miejsce od 1; 0, jeśli gracz nie ma wyniku.
+     */
+    std::uint32_t rank(const std::string& username, int* score = nullptr) const;
+
+    /**
+     * @brief Usuwa gracza z indeksu (np. aby cofnąć zgłoszenie, którego nie udało się zapisać).
+     * @param username Nazwa gracza.
+     * @return False, jeśli gracz nie miał wyniku.
+     */
+    bool erase(const std::string& username);
+
+    /** @brief Zwraca liczbę graczy. @return Liczba graczy z wynikiem. */
+    std::size_t size() const { return best.size(); }
+};
+
+/**
+ * @class ScoreServer
+ * @brief Demon tablicy wyników: jednowątkowa pętla poll() obsługująca wielu klientów bez blokowania.
+ *
+ * W każdym obiegu pętli demon czyta wszystko, co przyszło, odpowiada na wszystkie pełne ramki, dopisuje
+ * zgłoszenia z całego obiegu jednym zapisem do pliku wyników i dopiero potem wysyła odpowiedzi. Jeśli zapis
+ * się nie uda, zmiany indeksu z tego obiegu są cofane, a zgłoszenia dostają kod 2 - gra zapisuje wtedy wynik sama.
+ * Na końcu obiegu dociąga z pliku wiersze dopisane przez gry działające bez demona.
+ */
+export class ScoreServer {
+private:
+    /**
+     * @struct Connection
+     * @brief Stan połączenia z klientem.
+     */
+    struct Connection {
+        /** @brief Gniazdo klienta. */
+        std::intptr_t socket{ -1 };
+        /** @brief Odebrane, jeszcze nieprzetworzone bajty. */
+        std::string in;
+        /** @brief Odpowiedzi czekające na wysłanie. */
+        std::string out;
+        /** @brief Bajty z in, na które odpowiedziano w bieżącym obiegu pętli. */
+        std::size_t answeredIn{ 0 };
+        /** @brief Rozmiar out przed odpowiedziami z bieżącego obiegu pętli. */
+        std::size_t answeredOut{ 0 };
+        /** @brief Flaga wskazująca, że połączenie zostało zamknięte. */
+        bool closed{ false };
+    };
+
+    /** @brief Indeks wyników. */
+    ScoreIndex index;
+    /** @brief Plik wyników. */
+    RecordLog log;
+    /** @brief Ścieżka gniazda. */
+    std::string socketPath;
+    /** @brief Gniazdo nasłuchujące (-1, jeśli demon nie działa). */
+    std::intptr_t listener{ -1 };
+    /** @brief Połączenia klientów. */
+    std::vector<Connection> connections;
+    /** @brief Wszystkie przyjęte zgłoszenia z bieżącego obiegu pętli (także gorsze od najlepszego), czekające na dopisanie do pliku. */
+    std::vector<std::string> pendingRecords;
+    /**
+     * @struct IndexUndo
+     * @brief Poprzedni najlepszy wynik gracza, przywracany, gdy zgłoszenia nie udało się zapisać.
+     */
+    struct IndexUndo {
+        /** @brief Nazwa gracza. */
+        std::string username;
+        /** @brief Flaga wskazująca, że gracz miał wcześniej wynik. */
+        bool known{ false };
+        /** @brief Poprzedni najlepszy wynik. */
+        int score{ 0 };
+    };
+    /** @brief Zmiany indeksu z bieżącego obiegu pętli (w kolejności zgłoszeń). */
+    std::vector<IndexUndo> pendingUndo;
+    /** @brief Liczba obsłużonych żądań. */
+    std::uint64_t requests{ 0 };
+    /** @brief Liczba porcji żądań (odczytów, z których powstała co najmniej jedna odpowiedź). */
+    std::uint64_t batches{ 0 };
+    /** @brief Liczba przyjętych połączeń. */
+    std::uint64_t accepted{ 0 };
+    /** @brief Liczba klientów rozłączonych za przekroczenie Config::SCORE_CLIENT_BUFFER (w którąkolwiek stronę). */
+    std::uint64_t dropped{ 0 };
+
+    /** @brief Przyjmuje oczekujące połączenia. */
+    void acceptClients();
+    /** @brief Odbiera dane klienta. @param connection Połączenie. */
+    void receive(Connection& connection);
+    /**
+     * @brief Odpowiada na pełne ramki odebrane od klienta (bez usuwania ich z bufora wejściowego).
+     * @param connection Połączenie.
+     * @param stored False, jeśli zgłoszenia z tego obiegu nie trafiły do pliku (odpowiedź z kodem 2).
+     */
+    void answer(Connection& connection, bool stored);
+    /** @brief Wysyła tyle odpowiedzi, ile przyjmie gniazdo. @param connection Połączenie. */
+    void transmit(Connection& connection);
+    /**
+     * @brief Obsługuje jedno żądanie.
+     * @param frame Treść ramki (bez długości).
+     * @param out Bufor odpowiedzi.
+     * @param stored False, jeśli zgłoszeń nie da się zapisać (SUBMIT nie zmienia wtedy indeksu).
+     */
+    void respond(std::string_view frame, std::string& out, bool stored);
+    /** @brief Cofa zmiany indeksu z bieżącego obiegu pętli. */
+    void rollback();
+    /** @brief Dociąga z pliku wyniki dopisane od poprzedniego odczytu. */
+    void readLog();
+
+public:
+    /**
+     * @brief Tworzy demona dla pliku wyników.
+     * @param scoresPath Plik wyników (nazwa:wynik w każdym wierszu).
+     */
+    explicit ScoreServer(std::string scoresPath = Config::SCORES_FILE);
+    ~ScoreServer();
+
+    ScoreServer(const ScoreServer&) = delete;
+    ScoreServer& operator=(const ScoreServer&) = delete;
+
+    /**
+     * @brief Wczytuje plik wyników i zaczyna nasłuchiwać na gnieździe.
+     *
+     * Jeśli pod ścieżką działa już inny demon, start się nie udaje; pozostałość po zakończonym demonie jest usuwana.
+     *
+     * @param path Ścieżka gniazda.
+     * @return True, jeśli demon nasłuchuje.
+     */
+    bool start(const std::string& path = Config::SCORE_SOCKET);
+
+    /**
+     * @brief Obsługuje klientów, dopóki flaga running jest ustawiona.
+     * @param running Flaga pracy (sprawdzana co Config::SCORE_POLL_MS).
+     */
+    void serve(const std::atomic<bool>& running);
+
+    /**
+     * @brief Zamyka połączenia i gniazdo nasłuchujące oraz usuwa plik gniazda.
+     */
+    void stop();
+
+    /** @brief Zwraca indeks wyników. @return Indeks. */
+    const ScoreIndex& getIndex() const { return index; }
+    /** @brief Zwraca liczbę obsłużonych żądań. @return Liczba żądań. */
+    std::uint64_t getRequests() const { return requests; }
+    /** @brief Zwraca liczbę porcji żądań. @return Liczba porcji. */
+    std::uint64_t getBatches() const { return batches; }
+    /** @brief Zwraca liczbę przyjętych połączeń. @return Liczba połączeń. */
+    std::uint64_t getAccepted() const { return accepted; }
+    /** @brief Zwraca liczbę klientów rozłączonych za zbyt dużo danych. @return Liczba klientów. */
+    std::uint64_t getDropped() const { return dropped; }
+};
+
+/**
+ * @class ScoreClient
+ * @brief Klient demona wyników.
+ *
+ * Żądania dodane przez queue*() są wysyłane razem przez flush(), który potem odbiera wszystkie odpowiedzi,
+ * więc porcja żądań kosztuje jedną wymianę z demonem. Odbiór ma limit czasu Config::SCORE_CLIENT_TIMEOUT_MS,
+ * aby gra nie zawisła na nieodpowiadającym demonie; po błędzie połączenie jest zamykane.
+ */
+export class ScoreClient {
+private:
+    /** @brief Ścieżka gniazda. */
+    std::string socketPath;
+    /** @brief Gniazdo (-1, jeśli brak połączenia). */
+    std::intptr_t socket{ -1 };
+    /** @brief Zakodowane żądania czekające na wysłanie. */
+    std::string out;
+    /** @brief Kody żądań czekających na odpowiedź. */
+    std::vector<ScoreOp> pending;
+    /** @brief Czy ostatni flush() wysłał całą porcję (demon mógł ją obsłużyć, nawet jeśli odpowiedź nie nadeszła). */
+    bool sent{ false };
+
+public:
+    /**
+     * @brief Tworzy klienta (bez łączenia).
+     * @param path Ścieżka gniazda demona.
+     */
+    explicit ScoreClient(std::string path = Config::SCORE_SOCKET);
+    ~ScoreClient();
+
+    ScoreClient(const ScoreClient&) = delete;
+    ScoreClient& operator=(const ScoreClient&) = delete;
+
+    /**
+     * @brief Łączy się z demonem (jeśli jeszcze nie połączono).
+     * @return True, jeśli połączenie jest otwarte.
+     */
+    bool connect();
+
+    /** @brief Zamyka połączenie i porzuca niewysłane żądania. */
+    void close();
+
+    /** @brief Sprawdza, czy połączenie jest otwarte. @return True, jeśli połączono. */
+    bool isConnected() const { return socket != -1; }
+
+    /**
+     * @brief Dodaje zgłoszenie wyniku do porcji.
+     * @param username Nazwa gracza (najwyżej 255 bajtów).
+     * @param score Wynik.
+     * @return False, jeśli nazwa jest za długa.
+     */
+    bool queueSubmit(std::string_view username, int score);
+
+    /**
+     * @brief Dodaje pytanie o najlepszych graczy do porcji.
+     * @param k Liczba graczy (demon zwraca najwyżej Config::SCORE_TOP_MAX).
+     */
+    void queueTop(std::uint16_t k);
+
+    /**
+     * @brief Dodaje pytanie o miejsce gracza do porcji.
+     * @param username Nazwa gracza (najwyżej 255 bajtów).
+     * @return False, jeśli nazwa jest za długa.
+     */
+    bool queueRank(std::string_view username);
+
+    /** @brief Zwraca liczbę żądań w porcji. @return Liczba żądań. */
+    std::size_t getPendingCount() const { return pending.size(); }
+
+    /**
+     * @brief Wysyła porcję żądań i odbiera odpowiedzi (w kolejności żądań).
+     * @param responses Miejsce na odpowiedzi (czyszczone).
+     * @return True, jeśli odebrano odpowiedzi na wszystkie żądania.
+     */
+    bool flush(std::vector<ScoreResponse>& responses);
+
+    /**
+     * @brief Zgłasza wynik gracza (jedna wymiana z demonem).
+     * @param username Nazwa gracza.
+     * @param score Wynik.
+     * @param rank Miejsce na miejsce gracza po zgłoszeniu (może być nullptr).
+     * @return Wynik zgłoszenia; tylko po UNSENT i REJECTED wiadomo, że wyniku nie zapisano.
+     */
+    SubmitResult submit(std::string_view username, int score, std::uint32_t* rank = nullptr);
+
+    /**
+     * @brief Pobiera k najlepszych graczy (jedna wymiana z demonem).
+     * @param k Liczba graczy.
+     * @param entries Miejsce na graczy od najlepszego.
+     * @return True, jeśli demon odpowiedział.
+     */
+    bool top(std::uint16_t k, std::vector<RankedScore>& entries);
+};
+
+/**
+ * @brief Tryb demona: obsługuje tablicę wyników do przerwania (Ctrl+C), potem wypisuje statystyki.
+ * @param socketPath Ścieżka gniazda.
+ * @param scoresPath Plik wyników.
+ * @return Kod wyjścia procesu (1, jeśli demon nie wystartował).
+ */
+export int runScoreDaemon(const std::string& socketPath = Config::SCORE_SOCKET,
+    const std::string& scoresPath = Config::SCORES_FILE);
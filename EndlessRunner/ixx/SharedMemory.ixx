@@ -0,0 +1,82 @@
+﻿/**
+ * @file SharedMemory.ixx
+ * @brief Moduł definiujący klasę SharedMemory, opakowującą nazwany segment pamięci współdzielonej.
+ *
+ * Ukrywa różnice między POSIX (shm_open/mmap) a Windows (CreateFileMapping/MapViewOfFile).
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <string>
+export module SharedMemoryModule;
+
+
+/**
+ * @class SharedMemory
+ * @brief Nazwany segment pamięci współdzielonej zmapowany w przestrzeń adresową procesu.
+ *
+ * Obiekt jest właścicielem mapowania i zwalnia je w destruktorze. Segment ma jednego twórcę (create nie
+ * otwiera istniejącego) i tylko on usuwa nazwę przy zamknięciu, dzięki czemu nie zostaje ona w systemie
+ * po zakończeniu gry, a pozostali nie tracą jej w trakcie pracy. W POSIX twórca trzyma blokadę flock
+ * segmentu do zamknięcia; segment bez blokady został po awarii gry i create() zastępuje go nowym
+ * (w Windows segment znika razem z ostatnim uchwytem). Segment otwarty przez open() jest tylko do odczytu.
+ */
+export class SharedMemory {
+private:
+    /** @brief Nazwa segmentu (bez prefiksu systemowego). */
+    std::string name;
+    /** @brief Adres zmapowanego segmentu (nullptr, jeśli nie otwarto). */
+    void* data{ nullptr };
+    /** @brief Rozmiar segmentu w bajtach. */
+    std::size_t size{ 0 };
+    /** @brief Flaga wskazująca, czy segment został utworzony przez ten obiekt. */
+    bool owner{ false };
+    /** @brief Uchwyt systemowy (deskryptor pliku lub HANDLE). */
+    std::intptr_t handle{ -1 };
+
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /**
+     * @brief Tworzy nowy segment do zapisu.
+     * @param segmentName Nazwa segmentu.
+     * @param bytes Rozmiar segmentu w bajtach.
+     * @return True, jeśli segment został utworzony i zmapowany; false także wtedy, gdy segment ma żywego twórcę.
+     */
+    bool create(const std::string& segmentName, std::size_t bytes);
+
+    /**
+     * @brief Otwiera istniejący segment utworzony przez inny proces (tylko do odczytu).
+     * @param segmentName Nazwa segmentu.
+     * @param bytes Oczekiwany rozmiar segmentu w bajtach.
+     * @return True, jeśli segment został zmapowany.
+     */
+    bool open(const std::string& segmentName, std::size_t bytes);
+
+    /**
+     * @brief Odmapowuje segment i zamyka uchwyt.
+     */
+    void close();
+
+    /** @brief Zwraca adres zmapowanego segmentu (po open() nie wolno przez niego pisać). @return Wskaźnik na początek segmentu. */
+    void* get() const { return data; }
+    /** @brief Zwraca rozmiar segmentu. @return Rozmiar w bajtach. */
+    std::size_t getSize() const { return size; }
+    /** @brief Sprawdza, czy segment jest zmapowany. @return True, jeśli segment jest dostępny. */
+    bool isOpen() const { return data != nullptr; }
+
+private:
+    /**
+     * @brief Wspólna implementacja create/open.
+     * @param segmentName Nazwa segmentu.
+     * @param bytes Rozmiar segmentu.
+     * @param createNew True, aby utworzyć segment do zapisu; false - otworzyć istniejący do odczytu.
+     * @return True, jeśli segment został zmapowany.
+     */
+    bool map(const std::string& segmentName, std::size_t bytes, bool createNew);
+};
@@ -1,68 +1,86 @@
 /**
  * @file Shop.ixx
- * @brief Modu definiujcy klas Shop, obsugujc wybr dinozaurw.
+ * @brief Moduł definiujący klasę Shop, obsługującą wybór dinozaurów.
  *
- * Klasa Shop pozwala graczowi wybra dinozaura do gry.
+ * Klasa Shop pozwala graczowi wybrać dinozaura do gry.
  */
 
 module;
 #include "raylib.h"
 #include <array>
+#include <cstdint>
 #include <string>
 export module ShopModule;
 
 import ResourcesModule;
 import ConfigModule;
+import SceneModule;
+import AnimationSystemModule;
+import RetainedLayerModule;
+import LayoutModule;
 
 
 /**
  * @class Shop
- * @brief Klasa obsugujca interfejs sklepu w grze.
+ * @brief Klasa obsługująca interfejs sklepu w grze.
  *
- * Wywietla dostpne dinozaury i pozwala na ich wybr.
+ * Wyświetla dostępne dinozaury i pozwala na ich wybór. Sklep jest sceną należącą do main - wybór dinozaura
+ * przetrwa zamknięcie sklepu.
  */
-export class Shop
+export class Shop : public Scene
 {
 private:
-    /** @brief Liczba dinozaurw w sklepie. */
+    /** @brief Liczba dinozaurów w sklepie. */
     static constexpr int DinoCount{ Config::SHOP_DINO_COUNT }; 
-    /** @brief Tekstury dinozaurw. */
+    /** @brief Tekstury dinozaurów. */
     Texture2D dinos[DinoCount];
-    /** @brief Prostokty klikalnych obszarw dinozaurw. */
+    /** @brief Prostokąty klikalnych obszarów dinozaurów (kopiowane z układu po zmianie rozmiaru okna). */
     Rectangle dinoRecs[DinoCount];
-    /** @brief Tekstura ta sklepu. */
+    /** @brief Prostokąty, w których rysowane są dinozaury. */
+    Rectangle dinoDests[DinoCount];
+    /** @brief Układ sklepu (kolumny dinozaurów). */
+    Layout layout;
+    /** @brief Indeksy kolumn dinozaurów w układzie. */
+    std::array<int, DinoCount> dinoNodes{};
+    /** @brief Tekstura tła sklepu. */
     Texture2D background;
-    /** @brief Obiekt zasobw gry. */
-    Resources resources;
-    /** @brief Bazowe skale dla kadego dinozaura. */
+    /** @brief Wskaźnik na zasoby gry (współdzielone, bez kopiowania tekstur). */
+    Resources* resources{ nullptr };
+    /** @brief Bazowe skale dla każdego dinozaura. */
     std::array<float, DinoCount> baseScales{ 6.0f, 7.5f, 8.5f, 7.0f };
-    /** @brief Szerokoci klatek animacji dinozaurw. */
+    /** @brief Szerokości klatek animacji dinozaurów. */
     std::array<float, DinoCount> frameWidths;
-    /** @brief Wysokoci klatek animacji dinozaurw. */
+    /** @brief Wysokości klatek animacji dinozaurów. */
     std::array<float, DinoCount> frameHeights;
-    /** @brief Liczby klatek animacji dla kadego dinozaura. */
+    /** @brief Liczby klatek animacji dla każdego dinozaura. */
     std::array<int, DinoCount> frameCounts{ 6, 4, 4, 6 };
 
-    /** @brief Aktualna klatka animacji. */
-    int frame{ 0 };
-    /** @brief Czas od ostatniej zmiany klatki. */
-    float runningTime{ 0 };
-    /** @brief Czas midzy zmianami klatek. */
-    float updateTime{ Config::SHOP_ANIMATION_UPDATE_TIME }; 
+    /** @brief Wspólny klip animacji wszystkich dinozaurów (4 klatki w pętli). */
+    AnimationClip clip;
     /** @brief Indeks wybranego dinozaura. */
     int selectedDinoIndex{ 0 };
+    /** @brief Tło, ramka wyboru i podpowiedź narysowane do tekstury (dinozaury są animowane i rysowane na wierzchu). */
+    RetainedLayer layer{ "Shop" };
 
-    /** @brief Pocztkowa szeroko ekranu (dla skalowania). */
+    /** @brief Początkowa szerokość ekranu (dla skalowania). */
     int initialScreenWidth{ 0 };
-    /** @brief Pocztkowa wysoko ekranu (dla skalowania). */
+    /** @brief Początkowa wysokość ekranu (dla skalowania). */
     int initialScreenHeight{ 0 };
+    /** @brief Bieżąca szerokość ekranu. */
+    int currentScreenWidth{ 0 };
+    /** @brief Bieżąca wysokość ekranu. */
+    int currentScreenHeight{ 0 };
+    /** @brief Skala pozioma względem początkowego rozmiaru ekranu. */
+    float widthScale{ 1.0f };
+    /** @brief Skala pionowa względem początkowego rozmiaru ekranu. */
+    float heightScale{ 1.0f };
 
 public:
     /**
     * @brief Inicjalizuje sklep.
-    * @param res Referencja do zasobw gry.
-    * @param screenWidth Szeroko ekranu.
-    * @param screenHeight Wysoko ekranu.
+    * @param res Referencja do zasobów gry.
+    * @param screenWidth Szerokość ekranu.
+    * @param screenHeight Wysokość ekranu.
     */
     void init(Resources& res, int screenWidth, int screenHeight);
     /*{
@@ -82,87 +100,36 @@ public:
     }*/
 
     /**
-     * @brief Wywietla interfejs sklepu.
-     * @param screenWidth Szeroko ekranu.
-     * @param screenHeight Wysoko ekranu.
+     * @brief Zaczyna animację dinozaurów od pierwszej klatki.
+     * @param scenes Stos scen.
      */
-    void show(int screenWidth, int screenHeight);/* {
-        runningTime = 0;
-        frame = 0;
-
-        while (!WindowShouldClose()) {
-            float deltaTime = GetFrameTime();
-            runningTime += deltaTime;
-            if (runningTime >= updateTime) {
-                runningTime = 0;
-                frame++;
-                if (frame > 3) frame = 0;
-            }
-
-            if (IsKeyPressed(KEY_ESCAPE)) return;
-          
-            screenWidth = GetScreenWidth();
-            screenHeight = GetScreenHeight();
-
-            float widthScale = static_cast<float>(screenWidth) / initialScreenWidth;
-            float heightScale = static_cast<float>(screenHeight) / initialScreenHeight;
-
-           
-            for (int i{ 0 }; i < DinoCount; i++) {
-                dinoRecs[i] = Rectangle{
-                    static_cast<float>(i * screenWidth / DinoCount),
-                    static_cast<float>(screenHeight * 0.65f - 110.f * heightScale),
-                    static_cast<float>(screenWidth / DinoCount),
-                    220.f * heightScale
-                };
-            }
-
-            Vector2 mouse = GetMousePosition();
-            for (int i{ 0 }; i < DinoCount; i++) {
-                if (CheckCollisionPointRec(mouse, dinoRecs[i])) {
-                    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                        selectedDinoIndex = i;
-                    }
-                }
-            }
-
-            BeginDrawing();
-            ClearBackground(RAYWHITE);
-
-            DrawTexturePro(
-                resources.getShopBackground(),
-                Rectangle{ 0, 0, static_cast<float>(resources.getShopBackground().width), static_cast<float>(resources.getShopBackground().height) },
-                Rectangle{ 0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight) },
-                Vector2{ 0, 0 },
-                0.0f,
-                WHITE
-            );
-
-            for (int i = 0; i < DinoCount; i++) {
-                float currentScale = baseScales[i] * (widthScale + heightScale) / 2.0f;
-
-                Rectangle dest = {
-                    dinoRecs[i].x + (dinoRecs[i].width - frameWidths[i] * currentScale) / 2,
-                    screenHeight * 0.85f - frameHeights[i] * currentScale,
-                    frameWidths[i] * currentScale,
-                    frameHeights[i] * currentScale
-                };
-
-                Rectangle source = { frame * frameWidths[i], 0.0f, frameWidths[i], frameHeights[i] };
-
-                DrawTexturePro(dinos[i], source, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
-
-                if (i == selectedDinoIndex) {
-                    Rectangle selectionFrame = dinoRecs[i];
-                    selectionFrame.y += 50.f * heightScale; 
-                    DrawRectangleLinesEx(selectionFrame, 4.f * widthScale, GREEN);
-                }
-            }
-
-            DrawText("Press ESC to return", screenWidth / 2 - MeasureText("Press ESC to return", 20) / 2, screenHeight - 30, 20, BLACK);
-            EndDrawing();
-        }
-    }*/
+    void enter(SceneManager& scenes) override;
+
+    /**
+     * @brief Aktualizuje animację i obsługuje wybór dinozaura.
+     * @param scenes Stos scen.
+     * @param deltaTime Czas od poprzedniej klatki (w sekundach).
+     */
+    void update(SceneManager& scenes, float deltaTime) override;
+
+    /**
+     * @brief Rysuje interfejs sklepu.
+     */
+    void render() override;
+
+private:
+    /**
+     * @brief Wyznacza skale i prostokąty dinozaurów z przeliczonego układu.
+     */
+    void applyLayout();
+
+    /**
+     * @brief Rysuje tło, ramkę wybranego dinozaura i podpowiedź.
+     * @return Liczba wywołań rysujących.
+     */
+    int drawStatic() const;
+
+public:
 
     /**
      * @brief Zwraca indeks wybranego dinozaura.
@@ -174,7 +141,7 @@ public:
 
 
     /**
-     * @brief Zwraca liczb klatek animacji wybranego dinozaura.
+     * @brief Zwraca liczbę klatek animacji wybranego dinozaura.
      * @return Liczba klatek animacji.
      */
     int getSelectedDinoFrameCount() const;/* {
@@ -0,0 +1,139 @@
+﻿/**
+ * @file Snapshot.ixx
+ * @brief Moduł zapisu stanu symulacji do bufora bajtów (pauza, wznowienie po awarii, kopie planszy dla botów).
+ *
+ * Stan to ciąg struktur o stałym rozmiarze i tablic takich struktur, kopiowanych memcpy do bufora podanego
+ * przez wywołującego. Zapis nie alokuje pamięci: brak miejsca ustawia flagę błędu, a dalsze zapisy są pomijane.
+ * Odczyt sprawdza granice bufora tak samo. Format jest binarny i zależy od platformy (kolejność bajtów,
+ * rozmiary typów) - służy do wznowienia gry na tym samym komputerze, a nie do wymiany plików.
+ */
+
+module;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+export module SnapshotModule;
+
+
+/** @brief Wersja formatu stanu (zmieniana przy każdej zmianie struktur zapisywanych w stanie). */
+export inline constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+
+/**
+ * @struct SnapshotHeader
+ * @brief Nagłówek zapisanego stanu gry; za nim leży stan sceny gry, a potem planszy.
+ */
+export struct SnapshotHeader {
+    char magic[4];          /**< Sygnatura "DRSN". */
+    std::uint32_t version;  /**< Wersja formatu (SNAPSHOT_VERSION). */
+    std::uint32_t bytes;    /**< Rozmiar stanu razem z nagłówkiem. */
+    std::uint32_t reserved; /**< Zarezerwowane (0). */
+};
+
+/**
+ * @class SnapshotWriter
+ * @brief Zapisuje struktury o stałym rozmiarze do bufora podanego przez wywołującego.
+ */
+export class SnapshotWriter {
+private:
+    /** @brief Początek bufora. */
+    std::uint8_t* data{ nullptr };
+    /** @brief Pojemność bufora. */
+    std::size_t capacity{ 0 };
+    /** @brief Liczba zapisanych bajtów. */
+    std::size_t used{ 0 };
+    /** @brief Flaga braku miejsca. */
+    bool overflow{ false };
+
+public:
+    /** @brief Tworzy zapis do bufora. @param buffer Bufor (musi istnieć do końca zapisu). */
+    explicit SnapshotWriter(std::span<std::uint8_t> buffer) : data(buffer.data()), capacity(buffer.size()) {}
+
+    /**
+     * @brief Dopisuje tablicę struktur.
+     * @param values Początek tablicy.
+     * @param count Liczba elementów.
+     * @return False, jeśli zabrakło miejsca (wtedy i przy każdym kolejnym zapisie).
+     */
+    template<typename T>
+    bool writeArray(const T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot records must be trivially copyable");
+        const std::size_t bytes = count * sizeof(T);
+        if (overflow || bytes > capacity - used) {
+            overflow = true;
+            return false;
+        }
+        if (bytes > 0) {
+            std::memcpy(data + used, values, bytes);
+        }
+        used += bytes;
+        return true;
+    }
+
+    /** @brief Dopisuje strukturę. @param value Struktura. @return False, jeśli zabrakło miejsca. */
+    template<typename T>
+    bool write(const T& value) { return writeArray(&value, 1); }
+
+    /**
+     * @brief Zwraca wskaźnik do zapisanych już bajtów (np. żeby uzupełnić nagłówek po zapisie całości).
+     * @param offset Pozycja w buforze.
+     * @return Wskaźnik do bufora.
+     */
+    std::uint8_t* at(std::size_t offset) { return data + offset; }
+
+    /** @brief Zwraca liczbę zapisanych bajtów. @return Rozmiar w bajtach. */
+    std::size_t size() const { return used; }
+    /** @brief Sprawdza, czy wszystkie zapisy się zmieściły. @return True bez przepełnienia. */
+    bool ok() const { return !overflow; }
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Czyta struktury o stałym rozmiarze z bufora.
+ */
+export class SnapshotReader {
+private:
+    /** @brief Początek bufora. */
+    const std::uint8_t* data{ nullptr };
+    /** @brief Rozmiar bufora. */
+    std::size_t size{ 0 };
+    /** @brief Liczba przeczytanych bajtów. */
+    std::size_t used{ 0 };
+    /** @brief Flaga odczytu poza buforem. */
+    bool overflow{ false };
+
+public:
+    /** @brief Tworzy odczyt z bufora. @param buffer Bufor (musi istnieć do końca odczytu). */
+    explicit SnapshotReader(std::span<const std::uint8_t> buffer) : data(buffer.data()), size(buffer.size()) {}
+
+    /**
+     * @brief Czyta tablicę struktur.
+     * @param values Miejsce na elementy.
+     * @param count Liczba elementów.
+     * @return False, jeśli dane się skończyły (wtedy i przy każdym kolejnym odczycie).
+     */
+    template<typename T>
+    bool readArray(T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot records must be trivially copyable");
+        if (overflow || count > remaining() / sizeof(T)) {
+            overflow = true;
+            return false;
+        }
+        const std::size_t bytes = count * sizeof(T);
+        if (bytes > 0) {
+            std::memcpy(values, data + used, bytes);
+        }
+        used += bytes;
+        return true;
+    }
+
+    /** @brief Czyta strukturę. @param value Miejsce na strukturę. @return False, jeśli dane się skończyły. */
+    template<typename T>
+    bool read(T& value) { return readArray(&value, 1); }
+
+    /** @brief Zwraca liczbę bajtów do końca danych. @return Rozmiar w bajtach. */
+    std::size_t remaining() const { return size - used; }
+    /** @brief Sprawdza, czy wszystkie odczyty się powiodły. @return True bez wyjścia poza dane. */
+    bool ok() const { return !overflow; }
+};
@@ -1,40 +1,41 @@
 /**
  * @file StaticObstacle.ixx
- * @brief Modu definiujcy klas StaticObstacle, reprezentujc statyczne przeszkody.
+ * @brief Moduł definiujący klasę StaticObstacle, reprezentującą statyczne przeszkody.
  *
- * Klasa StaticObstacle dziedziczy po Obstacle i obsuguje przeszkody bez animacji.
+ * Klasa StaticObstacle dziedziczy po Obstacle i obsługuje przeszkody bez animacji.
  */
 module;
 #include "raylib.h"
 export module StaticObstacleModule;
 
 import ObstacleModule;
+import DrawListModule;
 import ConfigModule;
 
 /**
  * @class StaticObstacle
- * @brief Klasa reprezentujca statyczn przeszkod w grze.
+ * @brief Klasa reprezentująca statyczną przeszkodę w grze.
  *
- * Przeszkody statyczne (np. kaktusy, drzewa) poruszaj si w lewo bez animacji.
+ * Przeszkody statyczne (np. kaktusy, drzewa) poruszają się w lewo bez animacji.
  */
 export class StaticObstacle : public Obstacle {
 public:
 
     /**
-     * @brief Inicjalizuje statyczn przeszkod.
+     * @brief Inicjalizuje statyczną przeszkodę.
      * @param tex Tekstura przeszkody.
-     * @param startX Pocztkowa pozycja X.
-     * @param startY Pocztkowa pozycja Y (przesunita w gr o wysoko tekstury).
+     * @param startX Początkowa pozycja X.
+     * @param startY Początkowa pozycja Y (przesunięta w górę o wysokość tekstury).
      * @param scaleFactor Skala przeszkody.
      * @param frameCount Liczba klatek (zawsze 1 dla statycznych).
-     * @param animUpdateTime Czas midzy zmianami klatek (nieuywany).
+     * @param animUpdateTime Czas między zmianami klatek (nieużywany).
      */
     void init(const Texture2D& tex, float startX, float startY, float scaleFactor, int frameCount, float animUpdateTime = Config::ANIMATION_UPDATE_TIME) override;/* {
         Obstacle::init(tex, startX, startY - tex.height * scaleFactor, scaleFactor, 1, animUpdateTime); 
     }*/
 
     /**
-     * @brief Aktualizuje pozycj przeszkody.
+     * @brief Aktualizuje pozycję przeszkody.
      * @param deltaTime Czas od ostatniej klatki (w sekundach).
      */
     void update(float deltaTime) override; /*{
@@ -43,9 +44,10 @@ public:
 
 
     /**
-    * @brief Rysuje przeszkod na ekranie.
+    * @brief Zapisuje przeszkodę do listy poleceń rysowania.
+    * @param list Lista poleceń klatki.
     */
-    void draw() const override;/* {
+    void draw(DrawList& list) const override;/* {
         Rectangle source{ 0.f, 0.f, width, height };
         Rectangle dest{ screenPos.x, screenPos.y, width * scale, height * scale };
         DrawTexturePro(texture, source, dest, { 0.f, 0.f }, 0.f, WHITE);
@@ -53,8 +55,8 @@ public:
 
 
     /**
-    * @brief Zwraca prostokt kolizji przeszkody.
-    * @return Prostokt kolizji w przestrzeni ekranu.
+    * @brief Zwraca prostokąt kolizji przeszkody.
+    * @return Prostokąt kolizji w przestrzeni ekranu.
     */
     Rectangle getCollisionRec() const override;/* {
         return Rectangle{
@@ -0,0 +1,183 @@
+﻿/**
+ * @file Telemetry.ixx
+ * @brief Moduł udostępniający stan rozgrywki na żywo przez pamięć współdzieloną.
+ *
+ * Zawiera bufor pierścieniowy z jednym piszącym (gra) i dowolną liczbą czytelników (np. panel kiosku)
+ * oraz prosty czytnik konsolowy. Sloty są chronione licznikiem sekwencji (seqlock), więc czytelnik
+ * nigdy nie blokuje pętli renderowania - w razie kolizji z zapisem po prostu ponawia odczyt.
+ */
+
+module;
+#include <atomic>
+#include <cstdint>
+#include <string>
+export module TelemetryModule;
+
+import SharedMemoryModule;
+
+
+/**
+ * @namespace TelemetryConfig
+ * @brief Stałe opisujące układ segmentu telemetrii.
+ */
+export namespace TelemetryConfig {
+    /** @brief Nazwa segmentu pamięci współdzielonej. */
+    inline constexpr const char* SEGMENT_NAME = "dino_rush_telemetry";
+    /** @brief Sygnatura nagłówka ("DRTL"). */
+    inline constexpr std::uint32_t MAGIC = 0x4C545244u;
+    /** @brief Wersja formatu; zmieniana przy każdej zmianie układu struktur. */
+    inline constexpr std::uint32_t VERSION = 2;
+    /** @brief Liczba slotów w buforze pierścieniowym (potęga dwójki). */
+    inline constexpr std::uint32_t SLOT_COUNT = 64;
+    /** @brief Maksymalna liczba przeszkód zapisywanych w jednej klatce. */
+    inline constexpr std::uint32_t MAX_OBSTACLES = 16;
+}
+
+/**
+ * @struct TelemetryObstacle
+ * @brief Prostokąt kolizji pojedynczej przeszkody.
+ */
+export struct TelemetryObstacle {
+    float x;      /**< Pozycja X (piksele). */
+    float y;      /**< Pozycja Y (piksele). */
+    float width;  /**< Szerokość (piksele). */
+    float height; /**< Wysokość (piksele). */
+};
+
+/**
+ * @struct TelemetryFrame
+ * @brief Migawka stanu gry publikowana w każdym ticku.
+ *
+ * Struktura jest POD, dzięki czemu można ją kopiować wprost do i z pamięci współdzielonej.
+ */
+export struct TelemetryFrame {
+    std::uint64_t tick;           /**< Numer ticku od rozpoczęcia gry. */
+    double time;                  /**< Czas od startu gry (sekundy). */
+    float score;                  /**< Aktualny wynik. */
+    std::int32_t lives;           /**< Liczba żyć. */
+    std::int32_t gameOver;        /**< 1, jeśli gra się zakończyła. */
+    float playerX;                /**< Pozycja X gracza. */
+    float playerY;                /**< Pozycja Y gracza. */
+    float frameTime;              /**< Czas całej klatki (sekundy). */
+    float updateTime;             /**< Czas aktualizacji symulacji (sekundy). */
+    float drawTime;               /**< Czas rysowania (sekundy). */
+    std::uint32_t obstacleCount;  /**< Liczba przeszkód w tablicy obstacles. */
+    TelemetryObstacle obstacles[TelemetryConfig::MAX_OBSTACLES]; /**< Przeszkody na planszy. */
+};
+
+/**
+ * @struct TelemetrySlot
+ * @brief Slot bufora pierścieniowego z licznikiem sekwencji.
+ *
+ * Nieparzysta wartość sequence oznacza zapis w toku.
+ */
+struct TelemetrySlot {
+    std::atomic<std::uint32_t> sequence;
+    std::uint64_t index;          /**< Indeks zapisu (writeIndex) klatki w slocie - wykrywa okrążenie czytnika. */
+    TelemetryFrame frame;
+};
+
+/**
+ * @struct TelemetryHeader
+ * @brief Nagłówek segmentu telemetrii.
+ */
+struct TelemetryHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t slotSize;
+    /** @brief Liczba opublikowanych klatek (indeks następnego zapisu). */
+    std::atomic<std::uint64_t> writeIndex;
+    /** @brief Suma czasów publikacji (nanosekundy) - do pomiaru narzutu. */
+    std::atomic<std::uint64_t> publishNanos;
+    /** @brief Najdłuższa publikacja (nanosekundy). */
+    std::atomic<std::uint64_t> publishNanosMax;
+};
+
+/**
+ * @struct TelemetryLayout
+ * @brief Pełny układ segmentu: nagłówek i sloty.
+ */
+struct TelemetryLayout {
+    TelemetryHeader header;
+    TelemetrySlot slots[TelemetryConfig::SLOT_COUNT];
+};
+
+/**
+ * @class TelemetryPublisher
+ * @brief Strona zapisująca (gra). Publikacja nie alokuje pamięci i nie czeka na czytelników.
+ */
+export class TelemetryPublisher {
+private:
+    /** @brief Segment pamięci współdzielonej. */
+    SharedMemory memory;
+    /** @brief Zmapowany układ segmentu (nullptr, jeśli telemetria jest wyłączona). */
+    TelemetryLayout* layout{ nullptr };
+
+public:
+    /**
+     * @brief Tworzy segment telemetrii.
+     * @return True, jeśli segment jest gotowy do zapisu.
+     */
+    bool open();
+
+    /**
+     * @brief Publikuje klatkę w następnym slocie bufora.
+     * @param frame Stan gry do opublikowania.
+     */
+    void publish(const TelemetryFrame& frame);
+
+    /** @brief Sprawdza, czy telemetria jest aktywna. @return True, jeśli segment jest otwarty. */
+    bool isOpen() const { return layout != nullptr; }
+};
+
+/**
+ * @class TelemetryReader
+ * @brief Strona czytająca. Nigdy nie blokuje piszącego; utracone klatki są zliczane.
+ */
+export class TelemetryReader {
+private:
+    /** @brief Segment pamięci współdzielonej. */
+    SharedMemory memory;
+    /** @brief Zmapowany układ segmentu. */
+    const TelemetryLayout* layout{ nullptr };
+    /** @brief Indeks następnej klatki do odczytu. */
+    std::uint64_t cursor{ 0 };
+    /** @brief Liczba klatek nadpisanych zanim zdążono je odczytać. */
+    std::uint64_t dropped{ 0 };
+
+public:
+    /**
+     * @brief Otwiera segment utworzony przez grę.
+     * @return True, jeśli segment istnieje i ma zgodną wersję.
+     */
+    bool open();
+
+    /**
+     * @brief Odczytuje następną klatkę, jeśli jest dostępna.
+     * @param out Miejsce na odczytaną klatkę.
+     * @return True, jeśli odczytano spójną klatkę.
+     */
+    bool poll(TelemetryFrame& out);
+
+    /** @brief Sprawdza, czy segment jest otwarty. @return True, jeśli czytnik jest podłączony. */
+    bool isOpen() const { return layout != nullptr; }
+
+    /** @brief Zwraca liczbę utraconych klatek. @return Liczba klatek. */
+    std::uint64_t getDropped() const { return dropped; }
+
+    /**
+     * @brief Zwraca średni czas publikacji zmierzony przez grę.
+     * @return Średni czas w nanosekundach.
+     */
+    double getAveragePublishNanos() const;
+
+    /** @brief Zwraca najdłuższy czas publikacji. @return Czas w nanosekundach. */
+    std::uint64_t getMaxPublishNanos() const;
+};
+
+/**
+ * @brief Czytnik konsolowy: wypisuje strumień telemetrii i narzut publikacji.
+ * @return Kod wyjścia procesu.
+ */
+export int runTelemetryReader();
@@ -0,0 +1,198 @@
+﻿/**
+ * @file TextureCache.ixx
+ * @brief Moduł definiujący wspólną dla procesu pamięć podręczną tekstur.
+ *
+ * Tekstury są indeksowane znormalizowaną ścieżką pliku i wydawane jako uchwyty z licznikiem referencji.
+ * Ponowne żądanie tej samej ścieżki nie wczytuje pliku drugi raz, a wszystkie brakujące pliki
+ * dzielą jedną teksturę zastępczą. Jeśli podłączono archiwum tekstur, piksele pochodzą z niego,
+ * a osobne pliki PNG są używane tylko dla tekstur, których archiwum nie zawiera.
+ */
+
+module;
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+export module TextureCacheModule;
+
+import AssetPackModule;
+import ConfigModule;
+
+
+/**
+ * @struct TextureEntry
+ * @brief Tekstura przechowywana w pamięci podręcznej.
+ */
+export struct TextureEntry {
+    std::string path;        /**< Znormalizowana ścieżka pliku. */
+    Texture2D texture{};     /**< Tekstura na GPU. */
+    std::uint32_t refs{ 0 }; /**< Liczba żywych uchwytów. */
+    std::size_t bytes{ 0 };  /**< Rozmiar danych tekstury na GPU (bajty). */
+    bool fallback{ false };  /**< Flaga tekstury zastępczej. */
+    Image image{};           /**< Obraz w pamięci RAM (tylko w trybie bez okna, zamiast tekstury na GPU). */
+};
+
+/**
+ * @class TextureHandle
+ * @brief Uchwyt do tekstury z pamięci podręcznej; kopiowanie zwiększa licznik referencji.
+ *
+ * Gdy zniknie ostatni uchwyt, tekstura jest zwalniana z GPU.
+ */
+export class TextureHandle {
+private:
+    /** @brief Wpis pamięci podręcznej (nullptr dla pustego uchwytu). */
+    TextureEntry* entry{ nullptr };
+
+public:
+    TextureHandle() = default;
+
+    /**
+     * @brief Tworzy uchwyt i zwiększa licznik referencji wpisu.
+     * @param textureEntry Wpis pamięci podręcznej.
+     */
+    explicit TextureHandle(TextureEntry* textureEntry);
+
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(const TextureHandle& other);
+    TextureHandle& operator=(TextureHandle&& other) noexcept;
+    ~TextureHandle();
+
+    /**
+     * @brief Zwraca teksturę.
+     * @return Referencja do tekstury (pusta tekstura dla pustego uchwytu).
+     */
+    const Texture2D& get() const;
+
+    /** @brief Sprawdza, czy uchwyt wskazuje teksturę. @return True, jeśli uchwyt nie jest pusty. */
+    bool isValid() const { return entry != nullptr; }
+    /** @brief Sprawdza, czy to tekstura zastępcza. @return True dla tekstury zastępczej. */
+    bool isFallback() const { return entry != nullptr && entry->fallback; }
+
+    /**
+     * @brief Zwraca obraz tekstury w pamięci RAM.
+     * @return Referencja do obrazu (pusty obraz poza trybem bez okna).
+     */
+    const Image& getImage() const;
+
+    /**
+     * @brief Zwalnia uchwyt.
+     */
+    void reset();
+};
+
+/**
+ * @class TextureCache
+ * @brief Pamięć podręczna tekstur indeksowana ścieżką pliku.
+ */
+export class TextureCache {
+private:
+    /** @brief Wpisy indeksowane znormalizowaną ścieżką (węzły mapy mają stałe adresy). */
+    std::unordered_map<std::string, TextureEntry> entries;
+    /** @brief Liczba żądań obsłużonych bez wczytywania pliku. */
+    std::uint64_t hits{ 0 };
+    /** @brief Liczba wczytanych plików. */
+    std::uint64_t misses{ 0 };
+    /** @brief Liczba tekstur wczytanych z archiwum. */
+    std::uint64_t packLoads{ 0 };
+    /** @brief Łączny czas wczytywania tekstur (sekundy). */
+    double loadSeconds{ 0.0 };
+    /** @brief Łączny rozmiar żywych tekstur na GPU (bajty). */
+    std::size_t gpuBytes{ 0 };
+    /** @brief Czy tekstury zostają w RAM jako obrazy (bez okna i kontekstu OpenGL). */
+    bool headless{ false };
+    /** @brief Ostatni identyfikator nadany teksturze w trybie bez okna. */
+    unsigned int headlessIds{ 0 };
+    /** @brief Podłączone archiwum tekstur. */
+    AssetPack pack;
+    /** @brief Czy przy podłączaniu archiwum porównywać wpisy z plikami PNG (tryb deweloperski). */
+    bool checkPackSources{ false };
+
+public:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /**
+     * @brief Podłącza archiwum tekstur (wywołanie dla już podłączonego archiwum nic nie robi).
+     * @param path Ścieżka do archiwum.
+     * @return True, jeśli archiwum jest podłączone.
+     */
+    bool mountPack(const std::string& path);
+
+    /**
+     * @brief Włącza tryb deweloperski: zmienione od zbudowania archiwum pliki PNG mają pierwszeństwo przed nim.
+     *        Trzeba go ustawić przed mountPack().
+     * @param enabled True, aby sprawdzać pliki źródłowe archiwum.
+     */
+    void setPackSourceCheck(bool enabled) { checkPackSources = enabled; }
+
+    /** @brief Sprawdza, czy podłączono archiwum. @return True, jeśli tekstury są wczytywane z archiwum. */
+    bool hasPack() const { return pack.isOpen(); }
+
+    /**
+     * @brief Włącza tryb bez okna (testy wydajności, serwery): pliki są dekodowane do obrazów w RAM,
+     *        a tekstury dostają tylko identyfikator i wymiary. Trzeba go ustawić przed pierwszym acquire().
+     * @param enabled True, aby nie wysyłać tekstur na GPU.
+     */
+    void setHeadless(bool enabled) { headless = enabled; }
+
+    /** @brief Sprawdza, czy działa tryb bez okna. @return True w trybie bez okna. */
+    bool isHeadless() const { return headless; }
+
+    /**
+     * @brief Zwraca uchwyt do tekstury, wczytując ją tylko wtedy, gdy nie ma jej w pamięci.
+     * @param path Ścieżka do pliku tekstury.
+     * @return Uchwyt do tekstury lub do tekstury zastępczej, jeśli pliku nie da się wczytać.
+     */
+    TextureHandle acquire(const std::string& path);
+
+    /**
+     * @brief Zwraca uchwyt do wspólnej tekstury zastępczej.
+     * @return Uchwyt do tekstury zastępczej.
+     */
+    TextureHandle fallback();
+
+    /**
+     * @brief Zmniejsza licznik referencji; wywoływane przez TextureHandle.
+     * @param entry Wpis pamięci podręcznej.
+     */
+    void release(TextureEntry* entry);
+
+    /** @brief Zwraca liczbę tekstur na GPU. @return Liczba tekstur. */
+    std::size_t getResidentCount() const { return entries.size(); }
+    /** @brief Zwraca rozmiar tekstur na GPU. @return Rozmiar w bajtach. */
+    std::size_t getGpuBytes() const { return gpuBytes; }
+    /** @brief Zwraca liczbę trafień. @return Liczba żądań bez wczytywania. */
+    std::uint64_t getHits() const { return hits; }
+    /** @brief Zwraca liczbę wczytań. @return Liczba wczytanych plików. */
+    std::uint64_t getMisses() const { return misses; }
+
+    /**
+     * @brief Wypisuje stan pamięci podręcznej na konsolę.
+     */
+    void printReport() const;
+
+private:
+    /**
+     * @brief Sprawdza, czy teksturę da się wczytać z archiwum lub z pliku.
+     * @param key Znormalizowana ścieżka.
+     * @return True, jeśli tekstura jest dostępna.
+     */
+    bool isAvailable(const std::string& key) const;
+
+    /**
+     * @brief Wczytuje teksturę (z archiwum lub z pliku) do nowego wpisu.
+     * @param key Znormalizowana ścieżka.
+     * @param isFallback Flaga tekstury zastępczej.
+     * @return Wpis lub nullptr, jeśli wczytanie się nie powiodło.
+     */
+    TextureEntry* load(const std::string& key, bool isFallback);
+};
+
+/**
+ * @brief Zwraca wspólną dla całego procesu pamięć podręczną tekstur.
+ * @return Referencja do pamięci podręcznej.
+ */
+export TextureCache& textureCache();
@@ -1,37 +1,199 @@
 #include "raylib.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 import MenuModule;
 import LoadingScreenModule;
 import ResourcesModule;
 import BoardModule;
 import ShopModule;
 import ConfigModule;
+import TelemetryModule;
+import DiagnosticsModule;
+import FramePacerModule;
+import TextureCacheModule;
+import AssetPackModule;
+import SceneModule;
+import AuthModule;
+import RetainedLayerModule;
+import PresenterModule;
+import AudioModule;
+import BenchmarkModule;
+import ScoreServiceModule;
+import FramePipelineModule;
+import InputModule;
+import GhostModule;
+import AnalyticsModule;
+import ControllerModule;
 
-int main() {
-
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string_view(argv[1]) == "--telemetry") {
+        return runTelemetryReader();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--stress-difficulty") {
+        return runDifficultyStress();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--pacing-bench") {
+        return runPacingBenchmark();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--anim-bench") {
+        return runAnimationBenchmark();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--particle-bench") {
+        return runParticleBenchmark();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--present-bench") {
+        return runPresentationBenchmark();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--pipeline-bench") {
+        return runPipelineBenchmark();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--storage-stress") {
+        return runStorageStress(argv[0]);
+    }
+    if (argc > 4 && std::string_view(argv[1]) == "--storage-writer") {
+        return runStorageWriter(argv[2], std::atoi(argv[3]), std::atoi(argv[4]));
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--score-daemon") {
+        return runScoreDaemon();
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--score-load") {
+        int clients = argc > 2 ? std::atoi(argv[2]) : 200;
+        float seconds = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 5.0f;
+        int batch = argc > 4 ? std::atoi(argv[4]) : 16;
+        return runScoreLoad(clients, seconds, batch);
+    }
+    if (argc > 1 && (std::string_view(argv[1]) == "--bench" || std::string_view(argv[1]) == "--bench-compare")) {
+        return runBenchmarkCommand(argc, argv);
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--analytics-report") {
+        return runAnalyticsReport(argc > 2 ? argv[2] : Config::ANALYTICS_FILE);
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--pack-assets") {
+        bool compress = argc > 2 && std::string_view(argv[2]) == "--lz4";
+        return packAssets(Config::ASSET_DIRECTORY, Config::ASSET_PACK_FILE, compress) ? 0 : 1;
+    }
+    input().loadBindings(Config::CONTROLS_FILE);
+    bool nullAudio = false;
+    int humanPlayers = 1;
+    int botPlayers = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--audio=null") {
+            nullAudio = true;
+        }
+        else if (arg == "--ghost=off") {
+            setGhostsEnabled(false);
+        }
+        else if (arg == "--analytics=off") {
+            analytics().setEnabled(false);
+        }
+        else if (arg == "--dev-assets") {
+            // Edytowane pliki PNG są widoczne w grze bez przebudowy archiwum (kosztem sprawdzenia każdego pliku).
+            textureCache().setPackSourceCheck(true);
+        }
+        else if (arg == "--resume") {
+            // Pierwsza gra startuje z zapisanego stanu zamiast od początku trasy.
+            requestResume();
+        }
+        else if (arg.starts_with("--players=")) {
+            // Gracze na wspólnej klawiaturze skaczą akcjami jump, jump2, jump3 i jump4.
+            humanPlayers = std::atoi(std::string(arg.substr(10)).c_str());
+            if (humanPlayers < 1 || humanPlayers > Config::MAX_LOCAL_PLAYERS) {
+                std::cout << "Players must be between 1 and " << Config::MAX_LOCAL_PLAYERS << ", using 1\n";
+                humanPlayers = 1;
+            }
+        }
+        else if (arg.starts_with("--bots=")) {
+            botPlayers = std::max(0, std::atoi(std::string(arg.substr(7)).c_str()));
+        }
+        else if (arg.starts_with("--pacing=")) {
+            PacingMode mode;
+            if (parsePacingMode(arg.substr(9), mode)) {
+                framePacer().setMode(mode);
+            }
+            else {
+                std::cout << "Unknown pacing mode: " << arg.substr(9) << " (vsync, capped, uncapped)\n";
+            }
+        }
+        else if (arg.starts_with("--render=")) {
+            RenderMode mode;
+            if (parseRenderMode(arg.substr(9), mode)) {
+                presenter().setMode(mode);
+            }
+            else {
+                std::cout << "Unknown render mode: " << arg.substr(9) << " (native, fixed)\n";
+            }
+        }
+        else if (arg.starts_with("--pipeline=")) {
+            PipelineMode mode;
+            if (parsePipelineMode(arg.substr(11), mode)) {
+                setPipelineMode(mode);
+            }
+            else {
+                std::cout << "Unknown pipeline mode: " << arg.substr(11) << " (serial, threaded)\n";
+            }
+        }
+        else if (arg.starts_with("--bind=")) {
+            // --bind=jump:SPACE,PAD_A - nowe przypisania zapisujemy, żeby obowiązywały też w kolejnych uruchomieniach.
+            const std::string_view value = arg.substr(7);
+            const std::size_t colon = value.find(':');
+            InputAction action;
+            if (colon == std::string_view::npos || !parseInputAction(value.substr(0, colon), action)) {
+                std::cout << "Unknown action in " << arg << " (jump, confirm, back, jump2, jump3, jump4)\n";
+                continue;
+            }
+            std::vector<InputBinding> bindings;
+            std::string_view keys = value.substr(colon + 1);
+            while (!keys.empty()) {
+                const std::size_t comma = keys.find(',');
+                const std::string_view key = keys.substr(0, comma);
+                InputBinding binding;
+                if (parseInputBinding(key, binding)) {
+                    bindings.push_back(binding);
+                }
+                else {
+                    std::cout << "Unknown key: " << key << "\n";
+                }
+                keys = comma == std::string_view::npos ? std::string_view{} : keys.substr(comma + 1);
+            }
+            if (!bindings.empty()) {
+                input().setBindings(action, bindings);
+                input().saveBindings(Config::CONTROLS_FILE);
+            }
+        }
+    }
 
     const int screenWidth = Config::DEFAULT_WINDOW_WIDTH;
     const int screenHeight = Config::DEFAULT_WINDOW_HEIGHT;
 
     SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     InitWindow(screenWidth, screenHeight, "Dino Rush");
+    audio().start(nullAudio);
 
     Resources resources;
     Board board(resources);
+    board.setPlayers(humanPlayers, botPlayers);
     Shop shop;
 
-    LoadingScreen loader;
-    std::string username;
-
-    while (!WindowShouldClose()) {
-        username = loader.show(screenWidth, screenHeight, resources, board, shop);
-        if (!username.empty()) {
-            Menu menu;
-            menu.setContext(resources, board, shop);
-            menu.setUsername(username);
-            menu.showMenu(static_cast<int>(screenWidth), static_cast<int>(screenHeight));
-        }
-    }
+    SceneManager scenes;
+    scenes.push(std::make_unique<LoadingScreen>(resources, board, shop));
+    scenes.run();
 
+    framePacer().printReport();
+    resources.unloadTextures();
+    textureCache().printReport();
+    authWorker().printReport();
+    layerReport().printReport();
+    audio().printReport();
+    input().printReport();
+    analytics().flush();
+    analytics().printReport();
+    audio().stop();
     CloseWindow();
     return 0;
 }
\ No newline at end of file